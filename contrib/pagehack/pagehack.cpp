@@ -5311,6 +5311,12 @@ static bool ParseUndoRecord(UndoRecPtr urp, bool forward = false)
                     uint16 suffixlen = *suffixlen_ptr;
                     fprintf(stdout, "SUFFIXLEN %u ", suffixlen);
                 }
+
+                if (flags & UREC_INPLACE_UPDATE_XOR_DELTA) {
+                    uint16* nranges_ptr = (uint16 *)(cur_undodata_ptr);
+                    cur_undodata_ptr += sizeof(uint16);
+                    fprintf(stdout, "DELTA RANGES %u ", *nranges_ptr);
+                }
                 diskTuple.xid = (ShortTransactionId)InvalidTransactionId;
             } else {
                 Assert(urec->rawdata_.len >= (int)SizeOfUHeapDiskTupleHeaderExceptXid);
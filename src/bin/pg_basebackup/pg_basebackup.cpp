@@ -37,6 +37,7 @@
 #include "receivelog.h"
 #include "streamutil.h"
 #include "gs_tar_const.h"
+#include "replication/incremental_backup.h"
 #include "bin/elog.h"
 #include "lib/string.h"
 #include "PageCompression.h"
@@ -46,6 +47,9 @@
 #include "fetchmot.h"
 #endif
 
+#define INCREMENTAL_LABEL_FILE "backup_label"
+#define INCREMENTAL_CONTROL_FILE "global/pg_control"
+
 typedef struct TablespaceListCell {
     struct TablespaceListCell* next;
     char old_dir[MAXPGPATH];
@@ -76,6 +80,9 @@ int compresslevel = 0;
 bool includewal = true;
 bool streamwal = true;
 bool fastcheckpoint = false;
+char *incremental_lsn = NULL;       /* take an incremental backup since this location */
+char *apply_incremental_dir = NULL; /* merge this incremental backup into basedir */
+int parallel_jobs = 1;              /* connections sending the backup */
 logstreamer_param *g_childParam = NULL;
 
 extern char **tblspaceDirectory;
@@ -99,6 +106,12 @@ static int bgpipe[2] = {-1, -1};
 /* Handle to child process */
 static pid_t bgchild = -1;
 
+/* Helper processes receiving their share of a parallel backup */
+#define MAX_PARALLEL_JOBS 32
+static pid_t parallel_children[MAX_PARALLEL_JOBS];
+static int n_parallel_children = 0;
+static bool is_parallel_helper = false;
+
 /* End position for xlog streaming, empty string if unknown yet */
 static XLogRecPtr xlogendptr;
 
@@ -245,9 +258,14 @@ static void usage(void)
              "                         include required WAL files with specified method\n"));
     printf(_("  -z, --gzip             compress tar output\n"));
     printf(_("  -Z, --compress=0-9     compress tar output with given compression level\n"));
+    printf(_("      --incremental=LSN  only send relation blocks changed since LSN, the START WAL\n"
+             "                         LOCATION of the prior backup\n"));
+    printf(_("      --apply-incremental=DIRECTORY\n"
+             "                         merge plain incremental backup in DIRECTORY into -D\n"));
     printf(_("\nGeneral options:\n"));
     printf(_("  -c, --checkpoint=fast|spread\n"
              "                         set fast or spread checkpointing\n"));
+    printf(_("  -j, --jobs=NUM         use this many connections to send the backup\n"));
     printf(_("  -l, --label=LABEL      set backup label\n"));
     printf(_("  -P, --progress         show progress information\n"));
     printf(_("  -v, --verbose          output verbose messages\n"));
@@ -484,6 +502,92 @@ static void StartLogStreamer(const char *startpos, uint32 timeline, char *syside
 #endif
 }
 
+/*
+ * Body of a helper process of a parallel backup: attach to the backup the
+ * main connection started at startpos and unpack the relation files the
+ * server hands to this stream.
+ */
+static int ParallelBackupHelperMain(const char *startpos)
+{
+    char command[MAXPGPATH];
+    PGresult *res = NULL;
+    int i;
+
+    is_parallel_helper = true;
+    /* never touch the main connection inherited from the parent */
+    conn = GetConnection();
+    if (conn == NULL) {
+        return 1;
+    }
+
+    int rc = snprintf_s(command, sizeof(command), sizeof(command) - 1, "BASE_BACKUP PARALLEL_WORKER '%s'", startpos);
+    securec_check_ss_c(rc, "", "");
+    if (PQsendQuery(conn, command) == 0) {
+        pg_log(stderr, _("%s: could not send replication command \"%s\": %s"), progname, "BASE_BACKUP",
+            PQerrorMessage(conn));
+        return 1;
+    }
+
+    res = PQgetResult(conn);
+    if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) < 1) {
+        pg_log(stderr, _("%s: could not get backup header: %s"), progname, PQerrorMessage(conn));
+        return 1;
+    }
+    for (i = 0; i < PQntuples(res); i++) {
+        ReceiveAndUnpackTarFile(conn, res, i);
+    }
+    PQclear(res);
+
+    res = PQgetResult(conn);
+    if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+        pg_log(stderr, _("%s: final receive failed: %s"), progname, PQerrorMessage(conn));
+        return 1;
+    }
+    PQclear(res);
+    PQfinish(conn);
+    conn = NULL;
+    return 0;
+}
+
+/*
+ * Start the helper processes of a parallel backup. Each opens its own
+ * connection, so the main one keeps streaming undisturbed.
+ */
+static void StartParallelBackupHelpers(const char *startpos)
+{
+    for (int i = 1; i < parallel_jobs; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            /* in child process */
+            exit(ParallelBackupHelperMain(startpos));
+        } else if (pid < 0) {
+            fprintf(stderr, _("%s: could not create background process: %s\n"), progname, strerror(errno));
+            disconnect_and_exit(1);
+        }
+        parallel_children[n_parallel_children++] = pid;
+    }
+}
+
+static void WaitParallelBackupHelpers(void)
+{
+    bool failed = false;
+
+    for (int i = 0; i < n_parallel_children; i++) {
+        int status = 0;
+        if (waitpid(parallel_children[i], &status, 0) == -1) {
+            pg_log(stderr, _("%s: could not wait for child process: %s\n"), progname, strerror(errno));
+            failed = true;
+        } else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            pg_log(stderr, _("%s: parallel backup helper process %d failed\n"), progname, (int)parallel_children[i]);
+            failed = true;
+        }
+    }
+    n_parallel_children = 0;
+    if (failed) {
+        disconnect_and_exit(1);
+    }
+}
+
 /*
  * Verify that the given directory exists and is empty. If it does not
  * exist, it is created. If it exists but is not empty, an error will
@@ -990,8 +1094,8 @@ static void ReceiveAndUnpackTarFile(PGconn *conn, PGresult *res, int rownum)
                          * by the wal receiver process. So just ignore creation
                          * failures on related directories.
                          */
-                        if (!((pg_str_endswith(filename, "/pg_xlog") || pg_str_endswith(filename, "/archive_status")) &&
-                                errno == EEXIST)) {
+                        if (!((pg_str_endswith(filename, "/pg_xlog") || pg_str_endswith(filename, "/archive_status") ||
+                                parallel_jobs > 1) && errno == EEXIST)) {
                             pg_log(stderr,
                                 _("%s: could not create directory \"%s\": %s\n"),
                                 progname,
@@ -1057,6 +1161,18 @@ static void ReceiveAndUnpackTarFile(PGconn *conn, PGresult *res, int rownum)
             /*
              * regular file
              */
+            if (is_parallel_helper) {
+                /* helper streams carry no directory entries, the main stream may not have created it yet */
+                char parentdir[MAXPGPATH];
+                errorno = strncpy_s(parentdir, MAXPGPATH, filename, MAXPGPATH - 1);
+                securec_check_c(errorno, "", "");
+                get_parent_directory(parentdir);
+                if (pg_mkdir_p(parentdir, S_IRWXU) == -1 && errno != EEXIST) {
+                    pg_log(stderr, _("%s: could not create directory \"%s\": %s\n"), progname, parentdir,
+                        strerror(errno));
+                    disconnect_and_exit(1);
+                }
+            }
             file = fopen(filename, IsCompressedFile(filename, strlen(filename)) ? "wb+" : "wb");
             if (NULL == file) {
                 pg_log(stderr, _("%s: could not create file \"%s\": %s\n"), progname, filename, strerror(errno));
@@ -1182,10 +1298,17 @@ static void BaseBackup(void)
      */
     PQescapeStringConn(conn, escaped_label, label, sizeof(escaped_label), &i);
     rc = snprintf_s(current_path, sizeof(current_path), sizeof(current_path) - 1,
-        "BASE_BACKUP LABEL '%s' %s %s %s %s %s", escaped_label, showprogress ? "PROGRESS" : "",
+        "BASE_BACKUP LABEL '%s' %s %s %s %s %s %s%s%s", escaped_label, showprogress ? "PROGRESS" : "",
         includewal && !streamwal ? "WAL" : "", fastcheckpoint ? "FAST" : "", includewal ? "NOWAIT" : "",
-        format == 't' ? "TABLESPACE_MAP" : "");
+        format == 't' ? "TABLESPACE_MAP" : "", incremental_lsn != NULL ? "INCREMENTAL '" : "",
+        incremental_lsn != NULL ? incremental_lsn : "", incremental_lsn != NULL ? "'" : "");
     securec_check_ss_c(rc, "", "");
+    if (parallel_jobs > 1) {
+        size_t cmdlen = strlen(current_path);
+        rc = snprintf_s(current_path + cmdlen, sizeof(current_path) - cmdlen, sizeof(current_path) - cmdlen - 1,
+            " PARALLEL %d", parallel_jobs);
+        securec_check_ss_c(rc, "", "");
+    }
 
     if (PQsendQuery(conn, current_path) == 0) {
         pg_log(stderr, _("%s: could not send replication command \"%s\": %s"), progname, "BASE_BACKUP",
@@ -1333,6 +1456,11 @@ static void BaseBackup(void)
         StartLogStreamer((const char *)xlogstart, timeline, sysidentifier);
     }
 
+    /* helpers need the password too, start them before it is cleared */
+    if (parallel_jobs > 1) {
+        StartParallelBackupHelpers((const char *)xlogstart);
+    }
+
     ClearAndFreePasswd();
     /* free sysidentifier after use */
     PQfreemem(sysidentifier);
@@ -1478,6 +1606,9 @@ static void BaseBackup(void)
 #endif
     }
 
+    /* the server ends the backup only after the helpers are done, so they have all exited or are about to */
+    WaitParallelBackupHelpers();
+
     TABLESPACE_LIST_RELEASE();
 
     PQfinish(conn);
@@ -1901,6 +2032,309 @@ static int GsTar(int argc, char** argv)
     return 0;
 }
 
+static void CopyBackupFile(const char *src, const char *dst)
+{
+    char buf[BLCKSZ];
+    ssize_t cnt;
+
+    int srcfd = open(src, O_RDONLY | PG_BINARY, 0);
+    if (srcfd < 0) {
+        pg_log(stderr, _("%s: could not open file \"%s\": %s\n"), progname, src, strerror(errno));
+        exit(1);
+    }
+    int dstfd = open(dst, O_WRONLY | O_CREAT | O_TRUNC | PG_BINARY, S_IRUSR | S_IWUSR);
+    if (dstfd < 0) {
+        pg_log(stderr, _("%s: could not create file \"%s\": %s\n"), progname, dst, strerror(errno));
+        exit(1);
+    }
+    while ((cnt = read(srcfd, buf, sizeof(buf))) > 0) {
+        if (write(dstfd, buf, cnt) != cnt) {
+            pg_log(stderr, _("%s: could not write file \"%s\": %s\n"), progname, dst, strerror(errno));
+            exit(1);
+        }
+    }
+    if (cnt < 0) {
+        pg_log(stderr, _("%s: could not read file \"%s\": %s\n"), progname, src, strerror(errno));
+        exit(1);
+    }
+    if (fsync(dstfd) != 0) {
+        pg_log(stderr, _("%s: could not fsync file \"%s\": %s\n"), progname, dst, strerror(errno));
+        exit(1);
+    }
+    close(srcfd);
+    close(dstfd);
+}
+
+static void ReadIncrementalFile(int fd, const char *path, void *buf, size_t len)
+{
+    if (read(fd, buf, len) != (ssize_t)len) {
+        pg_log(stderr, _("%s: could not read incremental file \"%s\": %s\n"), progname, path,
+            errno != 0 ? strerror(errno) : "unexpected end of file");
+        exit(1);
+    }
+}
+
+/*
+ * Patch one relation segment of the prior backup with the changed blocks
+ * carried by an INCREMENTAL.<name> member, see replication/incremental_backup.h.
+ */
+static void ApplyIncrementalFile(const char *incpath, const char *target)
+{
+    IncrementalFileHeader header;
+    char page[BLCKSZ];
+
+    int incfd = open(incpath, O_RDONLY | PG_BINARY, 0);
+    if (incfd < 0) {
+        pg_log(stderr, _("%s: could not open file \"%s\": %s\n"), progname, incpath, strerror(errno));
+        exit(1);
+    }
+    errno = 0;
+    ReadIncrementalFile(incfd, incpath, &header, sizeof(header));
+    if (header.magic != INCREMENTAL_MAGIC || header.nblocks > header.truncBlocks) {
+        pg_log(stderr, _("%s: file \"%s\" is not a valid incremental file\n"), progname, incpath);
+        exit(1);
+    }
+
+    /*
+     * A relation created after the incremental backup started has no changed
+     * blocks yet, and is absent from the prior backup. Create it with its
+     * recorded length and leave the contents to WAL replay, which starts with
+     * a full page image or an init record for each of its pages.
+     */
+    int fd = open(target, O_RDWR | PG_BINARY, 0);
+    if (fd < 0 && errno == ENOENT && header.nblocks == 0) {
+        fd = open(target, O_RDWR | O_CREAT | O_EXCL | PG_BINARY, S_IRUSR | S_IWUSR);
+    } else if (fd < 0 && errno == ENOENT) {
+        pg_log(stderr, _("%s: incremental file \"%s\" has no counterpart \"%s\" in the prior backup\n"),
+            progname, incpath, target);
+        exit(1);
+    }
+    if (fd < 0) {
+        pg_log(stderr, _("%s: could not open file \"%s\": %s\n"), progname, target, strerror(errno));
+        exit(1);
+    }
+    if (ftruncate(fd, (off_t)header.truncBlocks * BLCKSZ) != 0) {
+        pg_log(stderr, _("%s: could not truncate file \"%s\": %s\n"), progname, target, strerror(errno));
+        exit(1);
+    }
+
+    if (header.nblocks > 0) {
+        BlockNumber *blocks = (BlockNumber *)xmalloc0(header.nblocks * sizeof(BlockNumber));
+        ReadIncrementalFile(incfd, incpath, blocks, header.nblocks * sizeof(BlockNumber));
+        for (uint32 i = 0; i < header.nblocks; i++) {
+            if (blocks[i] >= header.truncBlocks) {
+                pg_log(stderr, _("%s: file \"%s\" is not a valid incremental file\n"), progname, incpath);
+                exit(1);
+            }
+            ReadIncrementalFile(incfd, incpath, page, BLCKSZ);
+            if (pwrite(fd, page, BLCKSZ, (off_t)blocks[i] * BLCKSZ) != BLCKSZ) {
+                pg_log(stderr, _("%s: could not write file \"%s\": %s\n"), progname, target, strerror(errno));
+                exit(1);
+            }
+        }
+        free(blocks);
+    }
+
+    if (fsync(fd) != 0) {
+        pg_log(stderr, _("%s: could not fsync file \"%s\": %s\n"), progname, target, strerror(errno));
+        exit(1);
+    }
+    close(fd);
+    close(incfd);
+}
+
+/*
+ * Walk an incremental backup and bring the matching directory of the prior
+ * backup up to date: INCREMENTAL.<name> members patch <name>, everything else
+ * is copied over.
+ */
+static void ApplyIncrementalDir(const char *incdir, const char *targetdir)
+{
+    DIR *dir = opendir(incdir);
+    struct dirent *de = NULL;
+    char incpath[MAXPGPATH];
+    char target[MAXPGPATH];
+    struct stat st;
+    int rc;
+
+    if (dir == NULL) {
+        pg_log(stderr, _("%s: could not open directory \"%s\": %s\n"), progname, incdir, strerror(errno));
+        exit(1);
+    }
+    while ((de = readdir(dir)) != NULL) {
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0) {
+            continue;
+        }
+        rc = snprintf_s(incpath, MAXPGPATH, MAXPGPATH - 1, "%s/%s", incdir, de->d_name);
+        securec_check_ss_c(rc, "", "");
+        /* follow pg_tblspc links into the tablespace directories */
+        if (stat(incpath, &st) != 0) {
+            pg_log(stderr, _("%s: could not stat file \"%s\": %s\n"), progname, incpath, strerror(errno));
+            exit(1);
+        }
+
+        if (S_ISREG(st.st_mode) && strncmp(de->d_name, INCREMENTAL_PREFIX, INCREMENTAL_PREFIX_LEN) == 0) {
+            rc = snprintf_s(target, MAXPGPATH, MAXPGPATH - 1, "%s/%s", targetdir,
+                de->d_name + INCREMENTAL_PREFIX_LEN);
+            securec_check_ss_c(rc, "", "");
+            ApplyIncrementalFile(incpath, target);
+            continue;
+        }
+
+        rc = snprintf_s(target, MAXPGPATH, MAXPGPATH - 1, "%s/%s", targetdir, de->d_name);
+        securec_check_ss_c(rc, "", "");
+        if (S_ISDIR(st.st_mode)) {
+            if (mkdir(target, S_IRWXU) != 0 && errno != EEXIST) {
+                pg_log(stderr, _("%s: could not create directory \"%s\": %s\n"), progname, target, strerror(errno));
+                exit(1);
+            }
+            ApplyIncrementalDir(incpath, target);
+        } else if (S_ISREG(st.st_mode)) {
+            CopyBackupFile(incpath, target);
+        }
+    }
+    closedir(dir);
+}
+
+/*
+ * An incremental backup lists every file of the data directory, so relation
+ * files of the prior backup that are in it neither whole nor as INCREMENTAL.*
+ * were dropped in between.
+ */
+static void RemoveDroppedFiles(const char *incdir, const char *targetdir)
+{
+    DIR *dir = opendir(targetdir);
+    struct dirent *de = NULL;
+    char incpath[MAXPGPATH];
+    char target[MAXPGPATH];
+    struct stat st;
+    int rc;
+
+    if (dir == NULL) {
+        pg_log(stderr, _("%s: could not open directory \"%s\": %s\n"), progname, targetdir, strerror(errno));
+        exit(1);
+    }
+    while ((de = readdir(dir)) != NULL) {
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0) {
+            continue;
+        }
+        rc = snprintf_s(target, MAXPGPATH, MAXPGPATH - 1, "%s/%s", targetdir, de->d_name);
+        securec_check_ss_c(rc, "", "");
+        rc = snprintf_s(incpath, MAXPGPATH, MAXPGPATH - 1, "%s/%s", incdir, de->d_name);
+        securec_check_ss_c(rc, "", "");
+        if (stat(target, &st) != 0) {
+            continue;
+        }
+
+        if (S_ISDIR(st.st_mode)) {
+            if (access(incpath, F_OK) == 0) {
+                RemoveDroppedFiles(incpath, target);
+            } else if (!rmtree(target, true)) {
+                pg_log(stderr, _("%s: could not remove directory \"%s\"\n"), progname, target);
+                exit(1);
+            }
+            continue;
+        }
+        if (access(incpath, F_OK) == 0) {
+            continue;
+        }
+        rc = snprintf_s(incpath, MAXPGPATH, MAXPGPATH - 1, "%s/%s%s", incdir, INCREMENTAL_PREFIX, de->d_name);
+        securec_check_ss_c(rc, "", "");
+        if (access(incpath, F_OK) != 0 && unlink(target) != 0) {
+            pg_log(stderr, _("%s: could not remove file \"%s\": %s\n"), progname, target, strerror(errno));
+            exit(1);
+        }
+    }
+    closedir(dir);
+}
+
+/*
+ * Find the location on the line of dir/backup_label starting with tag.
+ */
+static bool ReadBackupLabelLocation(const char *dir, const char *tag, XLogRecPtr *location)
+{
+    char path[MAXPGPATH];
+    char line[MAXPGPATH];
+    size_t taglen = strlen(tag);
+    bool found = false;
+    int rc;
+
+    rc = snprintf_s(path, MAXPGPATH, MAXPGPATH - 1, "%s/%s", dir, INCREMENTAL_LABEL_FILE);
+    securec_check_ss_c(rc, "", "");
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        return false;
+    }
+    while (!found && fgets(line, sizeof(line), fp) != NULL) {
+        uint32 hi = 0;
+        uint32 lo = 0;
+        if (strncmp(line, tag, taglen) == 0 && sscanf_s(line + taglen, "%X/%X", &hi, &lo) == 2) {
+            *location = (((uint64)hi) << 32) | lo;
+            found = true;
+        }
+    }
+    fclose(fp);
+    return found;
+}
+
+/*
+ * The incremental backup only holds the blocks changed since its start
+ * location, so it can only be merged into the backup taken there.
+ */
+static void CheckIncrementalBase(const char *incdir, const char *targetdir)
+{
+    XLogRecPtr incStart = InvalidXLogRecPtr;
+    XLogRecPtr priorStart = InvalidXLogRecPtr;
+
+    if (!ReadBackupLabelLocation(incdir, INCREMENTAL_LABEL_LINE, &incStart)) {
+        pg_log(stderr, _("%s: \"%s\" is not an incremental backup\n"), progname, incdir);
+        exit(1);
+    }
+    if (!ReadBackupLabelLocation(targetdir, "START WAL LOCATION: ", &priorStart)) {
+        pg_log(stderr, _("%s: could not find the start location of the prior backup in \"%s/%s\"\n"), progname,
+            targetdir, INCREMENTAL_LABEL_FILE);
+        exit(1);
+    }
+    if (incStart != priorStart) {
+        pg_log(stderr, _("%s: incremental backup \"%s\" starts at %X/%X, but the prior backup \"%s\" was taken at "
+            "%X/%X\n"), progname, incdir, (uint32)(incStart >> 32), (uint32)incStart, targetdir,
+            (uint32)(priorStart >> 32), (uint32)priorStart);
+        exit(1);
+    }
+}
+
+/*
+ * Merge a plain format incremental backup into the prior backup in basedir,
+ * which then matches a full backup taken at the same time as the incremental
+ * one. The WAL of the incremental backup is needed to make it consistent.
+ */
+static void ApplyIncrementalBackup(const char *incdir, const char *targetdir)
+{
+    static const char *const relationDirs[] = {"base", "global", "pg_tblspc"};
+    char incpath[MAXPGPATH];
+    char target[MAXPGPATH];
+    int rc;
+
+    rc = snprintf_s(incpath, MAXPGPATH, MAXPGPATH - 1, "%s/%s", incdir, INCREMENTAL_CONTROL_FILE);
+    securec_check_ss_c(rc, "", "");
+    if (access(incpath, F_OK) != 0) {
+        pg_log(stderr, _("%s: \"%s\" is not a plain format backup\n"), progname, incdir);
+        exit(1);
+    }
+    CheckIncrementalBase(incdir, targetdir);
+
+    for (size_t i = 0; i < lengthof(relationDirs); i++) {
+        rc = snprintf_s(incpath, MAXPGPATH, MAXPGPATH - 1, "%s/%s", incdir, relationDirs[i]);
+        securec_check_ss_c(rc, "", "");
+        rc = snprintf_s(target, MAXPGPATH, MAXPGPATH - 1, "%s/%s", targetdir, relationDirs[i]);
+        securec_check_ss_c(rc, "", "");
+        if (access(incpath, F_OK) == 0 && access(target, F_OK) == 0) {
+            RemoveDroppedFiles(incpath, target);
+        }
+    }
+    ApplyIncrementalDir(incdir, targetdir);
+}
+
 static int GsBaseBackup(int argc, char** argv)
 {
     static struct option long_options[] = {{"help", no_argument, NULL, '?'},
@@ -1923,6 +2357,9 @@ static int GsBaseBackup(int argc, char** argv)
                                            {"rw-timeout", required_argument, NULL, 't'},
                                            {"verbose", no_argument, NULL, 'v'},
                                            {"progress", no_argument, NULL, 'P'},
+                                           {"incremental", required_argument, NULL, 1},
+                                           {"apply-incremental", required_argument, NULL, 2},
+                                           {"jobs", required_argument, NULL, 'j'},
                                            {NULL, 0, NULL, 0}};
     int c = 0, option_index = 0;
     GS_FREE(progname);
@@ -1939,7 +2376,7 @@ static int GsBaseBackup(int argc, char** argv)
         }
     }
 
-    char optstring[] = "D:l:c:h:p:U:s:X:F:T:Z:t:wWvPxz";
+    char optstring[] = "D:l:c:h:p:U:s:X:F:T:Z:t:j:wWvPxz";
     /* check if a required_argument option has a void argument */
     int i;
     for (i = 0; i < argc; i++) {
@@ -1979,7 +2416,7 @@ static int GsBaseBackup(int argc, char** argv)
         }
     }
 
-    while ((c = getopt_long(argc, argv, "D:l:c:h:p:U:s:X:F:T:Z:t:wWvPxz", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "D:l:c:h:p:U:s:X:F:T:Z:t:j:wWvPxz", long_options, &option_index)) != -1) {
         switch (c) {
             case 'D': {
                 GS_FREE(basedir);
@@ -2107,6 +2544,38 @@ static int GsBaseBackup(int argc, char** argv)
             case 'P':
                 showprogress = true;
                 break;
+            case 'j':
+                check_env_value_c(optarg);
+                parallel_jobs = atoi(optarg);
+                if (parallel_jobs < 1 || parallel_jobs > MAX_PARALLEL_JOBS) {
+                    fprintf(stderr, _("%s: invalid number of parallel jobs \"%s\", must be 1 .. %d\n"), progname,
+                        optarg, MAX_PARALLEL_JOBS);
+                    exit(1);
+                }
+                break;
+            case 1: {
+                uint32 hi = 0;
+                uint32 lo = 0;
+                check_env_value_c(optarg);
+                if (sscanf_s(optarg, "%X/%X", &hi, &lo) != 2 || (hi == 0 && lo == 0)) {
+                    fprintf(stderr, _("%s: invalid incremental start location \"%s\"\n"), progname, optarg);
+                    exit(1);
+                }
+                GS_FREE(incremental_lsn);
+                incremental_lsn = xstrdup(optarg);
+                break;
+            }
+            case 2: {
+                GS_FREE(apply_incremental_dir);
+                check_env_value_c(optarg);
+                char realDir[PATH_MAX] = {0};
+                if (realpath(optarg, realDir) == nullptr) {
+                    pg_log(stderr, _("%s: realpath dir \"%s\" failed: %m\n"), progname, optarg);
+                    exit(1);
+                }
+                apply_incremental_dir = xstrdup(realDir);
+                break;
+            }
             default:
 
                 /*
@@ -2118,6 +2587,20 @@ static int GsBaseBackup(int argc, char** argv)
         }
     }
 
+    /* Merging an incremental backup needs no server */
+    if (apply_incremental_dir != NULL) {
+        if (basedir == NULL) {
+            fprintf(stderr, _("%s: no target directory specified\n"), progname);
+            fprintf(stderr, _("Try \"%s --help\" for more information.\n"), progname);
+            exit(1);
+        }
+        ApplyIncrementalBackup(apply_incremental_dir, basedir);
+        pg_log(stderr, _("%s: incremental backup \"%s\" applied to \"%s\"\n"), progname, apply_incremental_dir,
+            basedir);
+        free_basebackup();
+        return 0;
+    }
+
     /* If port is not specified by using -p, obtain the port through environment variables */
     if (dbport == NULL) {
         char *value = NULL;
@@ -2166,6 +2649,13 @@ static int GsBaseBackup(int argc, char** argv)
         exit(1);
     }
 
+    if (parallel_jobs > 1 && (format != 'p' || showprogress || incremental_lsn != NULL)) {
+        fprintf(stderr, _("%s: parallel jobs can only be used for plain mode full backups without progress\n"),
+            progname);
+        fprintf(stderr, _("Try \"%s --help\" for more information.\n"), progname);
+        exit(1);
+    }
+
 #ifndef HAVE_LIBZ
     if (compresslevel != 0) {
         fprintf(stderr, _("%s: this build does not support compression\n"), progname);
@@ -2198,5 +2688,7 @@ static void free_basebackup()
     }
     GS_FREE(dbhost);
     GS_FREE(dbport);
+    GS_FREE(incremental_lsn);
+    GS_FREE(apply_incremental_dir);
     GS_FREE(dbuser);
 }
@@ -245,6 +245,7 @@ const uint32 USTORE_UPGRADE_VERSION = 92368;
 const uint32 PACKAGE_ENHANCEMENT = 92444;
 const uint32 SUBSCRIPTION_VERSION = 92580;
 const uint32 SUBSCRIPTION_BINARY_VERSION_NUM = 92656;
+const uint32 SUBSCRIPTION_STREAMING_VERSION_NUM = 92905;
 const uint32 B_DUMP_TRIGGER_VERSION_NUM = 92843;
 const uint32 EVENT_VERSION = 92844;
 const uint32 EVENT_TRIGGER_VERSION_NUM = 92845;
@@ -4558,6 +4559,7 @@ void getSubscriptions(Archive *fout)
     int i_subsynccommit;
     int i_subpublications;
     int i_subbinary;
+    int i_substream;
     int i;
     int ntups;
 
@@ -4580,9 +4582,15 @@ void getSubscriptions(Archive *fout)
         "s.subsynccommit, s.subpublications, \n", username_subquery);
 
     if (GetVersionNum(fout) >= SUBSCRIPTION_BINARY_VERSION_NUM) {
-        appendPQExpBuffer(query, " s.subbinary\n");
+        appendPQExpBuffer(query, " s.subbinary,\n");
     } else {
-        appendPQExpBuffer(query, " false AS subbinary\n");
+        appendPQExpBuffer(query, " false AS subbinary,\n");
+    }
+
+    if (GetVersionNum(fout) >= SUBSCRIPTION_STREAMING_VERSION_NUM) {
+        appendPQExpBuffer(query, " s.substream\n");
+    } else {
+        appendPQExpBuffer(query, " false AS substream\n");
     }
 
     appendPQExpBuffer(query, "FROM pg_catalog.pg_subscription s "
@@ -4607,6 +4615,7 @@ void getSubscriptions(Archive *fout)
     i_subsynccommit = PQfnumber(res, "subsynccommit");
     i_subpublications = PQfnumber(res, "subpublications");
     i_subbinary = PQfnumber(res, "subbinary");
+    i_substream = PQfnumber(res, "substream");
 
     subinfo = (SubscriptionInfo *)pg_malloc(ntups * sizeof(SubscriptionInfo));
 
@@ -4626,6 +4635,7 @@ void getSubscriptions(Archive *fout)
         subinfo[i].subsynccommit = gs_strdup(PQgetvalue(res, i, i_subsynccommit));
         subinfo[i].subpublications = gs_strdup(PQgetvalue(res, i, i_subpublications));
         subinfo[i].subbinary = gs_strdup(PQgetvalue(res, i, i_subbinary));
+        subinfo[i].substream = gs_strdup(PQgetvalue(res, i, i_substream));
 
         if (strlen(subinfo[i].rolname) == 0) {
             write_msg(NULL, "WARNING: owner of subscription \"%s\" appears to be invalid\n", subinfo[i].dobj.name);
@@ -4696,6 +4706,10 @@ static void dumpSubscription(Archive *fout, const SubscriptionInfo *subinfo)
         appendPQExpBuffer(query, ", binary = true");
     }
 
+    if (strcmp(subinfo->substream, "t") == 0) {
+        appendPQExpBuffer(query, ", streaming = true");
+    }
+
     if (strcmp(subinfo->subsynccommit, "off") != 0) {
         appendPQExpBuffer(query, ", synchronous_commit = %s", fmtId(subinfo->subsynccommit));
     }
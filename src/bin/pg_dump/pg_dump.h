@@ -534,6 +534,7 @@ typedef struct _SubscriptionInfo {
     char *subsynccommit;
     char *subpublications;
     char *subbinary;
+    char *substream;
 } SubscriptionInfo;
 
 /* global decls */
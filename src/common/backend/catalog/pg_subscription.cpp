@@ -103,6 +103,13 @@ Subscription *GetSubscription(Oid subid, bool missing_ok)
         sub->binary = DatumGetBool(datum);
     }
 
+    datum = SysCacheGetAttr(SUBSCRIPTIONOID, tup, Anum_pg_subscription_substream, &isnull);
+    if (unlikely(isnull)) {
+        sub->stream = false;
+    } else {
+        sub->stream = DatumGetBool(datum);
+    }
+
     ReleaseSysCache(tup);
 
     return sub;
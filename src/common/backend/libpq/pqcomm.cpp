@@ -137,6 +137,7 @@ int internal_putbytes(const char* s, size_t len);
 
 /* Internal functions */
 static int internal_flush(void);
+static int internal_flush_buffer(const char* buf, int* start, int* end);
 static void pq_set_nonblocking(bool nonblocking);
 static void pq_disk_generate_checking_header(
     const char* src_data, StringInfo dest_data, uint32 data_len, uint32 seq_num);
@@ -1549,6 +1550,24 @@ int pq_getmessage(StringInfo s, int maxlen)
     return 0;
 }
 
+/* walsenders on the comm proxy send through libnet_flush, which only knows the send buffer */
+static inline bool UseLibnetFlush(void)
+{
+    return t_thrd.walsender_cxt.ep_fd != -1 && g_comm_proxy_config.s_send_xlog_mode == CommSendXlogWaitIn;
+}
+
+/*
+ * Whether internal_putbytes may hand large data to the socket without
+ * going through the send buffer.  Not while results are being spilled to
+ * the temp file, which is filled from the buffer, nor on the libnet path;
+ * libcomm connections keep getting at most a bufferful per send.
+ */
+static inline bool pq_can_send_direct(void)
+{
+    return !pq_disk_is_temp_file_enabled() && !UseLibnetFlush() && !StreamThreadAmI() &&
+           !u_sess->proc_cxt.MyProcPort->is_logic_conn;
+}
+
 /* --------------------------------
  *		pq_putbytes		- send bytes to connection (not flushed until pq_flush)
  *
@@ -1597,6 +1616,31 @@ int internal_putbytes(const char* s, size_t len)
                 }
             }
         }
+
+        /*
+         * If nothing is pending and the data would fill the buffer anyway,
+         * send it straight from the caller's memory instead of copying it
+         * through the buffer a bufferful at a time.  A large message that
+         * arrives behind pending data tops up the buffer first, so that part
+         * still goes out with the data ahead of it, and the rest is sent
+         * directly.
+         */
+        if (len >= (size_t)t_thrd.libpq_cxt.PqSendBufferSize &&
+            t_thrd.libpq_cxt.PqSendStart == t_thrd.libpq_cxt.PqSendPointer && pq_can_send_direct()) {
+            size_t chunk = Min(len, (size_t)MaxAllocSize);
+            int start = 0;
+            int end = (int)chunk;
+
+            StmtRetrySetFileExceededFlag(); /* once flush data to frontend, can not retry this query anymore */
+            pq_set_nonblocking(false);
+            if (internal_flush_buffer(s, &start, &end)) {
+                return EOF;
+            }
+            s += chunk;
+            len -= chunk;
+            continue;
+        }
+
         amount = t_thrd.libpq_cxt.PqSendBufferSize - t_thrd.libpq_cxt.PqSendPointer;
         if (amount > len) {
             amount = len;
@@ -1695,15 +1739,29 @@ static void SetConnectionLostFlag()
  */
 int internal_flush(void)
 {
-    if ((t_thrd.walsender_cxt.ep_fd != -1 && g_comm_proxy_config.s_send_xlog_mode == CommSendXlogWaitIn)) {
+    if (UseLibnetFlush()) {
         return libnet_flush();
     }
 
+    return internal_flush_buffer(t_thrd.libpq_cxt.PqSendBuffer, &t_thrd.libpq_cxt.PqSendStart,
+        &t_thrd.libpq_cxt.PqSendPointer);
+}
+
+/* --------------------------------
+ *		internal_flush_buffer - send buf[*start .. *end)
+ *
+ * *start is advanced past what was sent; both are reset to 0 once all of
+ * it is out, or when the data is dropped because the connection failed.
+ * Returns as internal_flush does.
+ * --------------------------------
+ */
+static int internal_flush_buffer(const char* buf, int* start, int* end)
+{
     static THR_LOCAL int last_reported_send_errno = 0;
 
     errno_t ret;
-    char* bufptr = t_thrd.libpq_cxt.PqSendBuffer + t_thrd.libpq_cxt.PqSendStart;
-    char* bufend = t_thrd.libpq_cxt.PqSendBuffer + t_thrd.libpq_cxt.PqSendPointer;
+    const char* bufptr = buf + *start;
+    const char* bufend = buf + *end;
     char connTimeInfoStr[INITIAL_EXPBUFFER_SIZE] = {'\0'};
     WaitState oldStatus = pgstat_report_waitstatus(STATE_WAIT_UNDEFINED, true);
 
@@ -1735,7 +1793,7 @@ int internal_flush(void)
     while (bufptr < bufend) {
         int r;
 
-        r = secure_write(u_sess->proc_cxt.MyProcPort, bufptr, bufend - bufptr);
+        r = secure_write(u_sess->proc_cxt.MyProcPort, (void*)bufptr, bufend - bufptr);
         if (unlikely(r == 0 && (StreamThreadAmI() == true || u_sess->proc_cxt.MyProcPort->is_logic_conn))) {
             /* Stop query when cancel happend */
             if (t_thrd.int_cxt.QueryCancelPending) {
@@ -1791,7 +1849,7 @@ int internal_flush(void)
              * flag that'll cause the next CHECK_FOR_INTERRUPTS to terminate
              * the connection.
              */
-            t_thrd.libpq_cxt.PqSendStart = t_thrd.libpq_cxt.PqSendPointer = 0;
+            *start = *end = 0;
             SetConnectionLostFlag();
             (void)pgstat_report_waitstatus(oldStatus);
             return EOF;
@@ -1799,10 +1857,10 @@ int internal_flush(void)
 
         last_reported_send_errno = 0; /* reset after any successful send */
         bufptr += r;
-        t_thrd.libpq_cxt.PqSendStart += r;
+        *start += r;
     }
 
-    t_thrd.libpq_cxt.PqSendStart = t_thrd.libpq_cxt.PqSendPointer = 0;
+    *start = *end = 0;
     (void)pgstat_report_waitstatus(oldStatus);
     return 0;
 }
@@ -1988,22 +2046,26 @@ bool pq_is_send_pending(void)
  */
 int pq_putmessage(char msgtype, const char* s, size_t len)
 {
+    char header[1 + sizeof(uint32)];
+    size_t headerlen = 0;
+
     if (t_thrd.libpq_cxt.DoingCopyOut || t_thrd.libpq_cxt.PqCommBusy) {
         return 0;
     }
     t_thrd.libpq_cxt.PqCommBusy = true;
     if (msgtype) {
-        if (internal_putbytes(&msgtype, 1)) {
-            goto fail;
-        }
+        header[headerlen++] = msgtype;
     }
     if (PG_PROTOCOL_MAJOR(FrontendProtocol) >= 3) {
         uint32 n32;
 
         n32 = htonl((uint32)(len + 4));
-        if (internal_putbytes((char*)&n32, 4)) {
-            goto fail;
-        }
+        errno_t rc = memcpy_s(header + headerlen, sizeof(header) - headerlen, &n32, sizeof(n32));
+        securec_check(rc, "\0", "\0");
+        headerlen += sizeof(n32);
+    }
+    if (headerlen > 0 && internal_putbytes(header, headerlen)) {
+        goto fail;
     }
     if (internal_putbytes(s, len)) {
         goto fail;
@@ -32,6 +32,7 @@
 #include "tcop/utility.h"
 #endif
 #include "storage/predicate_internals.h"
+#include "storage/proc.h"
 #include "utils/builtins.h"
 #include "utils/fmgroids.h"
 #include "access/heapam.h"
@@ -509,6 +510,75 @@ Datum pg_lock_status(PG_FUNCTION_ARGS)
     SRF_RETURN_DONE(funcctx);
 }
 
+/* Number of columns in gs_stat_fastpath_locks() output */
+#define NUM_FASTPATH_STAT_COLUMNS 5
+
+/*
+ * gs_stat_fastpath_locks - one row per backend with its fast-path lock
+ * counters: slots in use now, relation locks granted through the fast path,
+ * eligible locks that found their slot group full and went to the main lock
+ * table instead, and fast-path locks of other backends it moved to the main
+ * lock table when taking a strong lock.
+ */
+Datum gs_stat_fastpath_locks(PG_FUNCTION_ARGS)
+{
+    ReturnSetInfo* rsinfo = (ReturnSetInfo*)fcinfo->resultinfo;
+    TupleDesc tupdesc;
+    Tuplestorestate* tupstore = NULL;
+    MemoryContext oldcontext;
+
+    if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+            errmsg("set-valued function called in context that cannot accept a set")));
+    if (!(rsinfo->allowedModes & SFRM_Materialize))
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+            errmsg("materialize mode required, but it is not allowed in this context")));
+    if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+        ereport(ERROR, (errcode(ERRCODE_DATATYPE_MISMATCH), errmsg("return type must be a row type")));
+
+    oldcontext = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+    tupstore = tuplestore_begin_heap(true, false, u_sess->attr.attr_memory.work_mem);
+    rsinfo->returnMode = SFRM_Materialize;
+    rsinfo->setResult = tupstore;
+    rsinfo->setDesc = tupdesc;
+    (void)MemoryContextSwitchTo(oldcontext);
+
+    for (uint32 i = 0; i < g_instance.proc_base->allNonPreparedProcCount; i++) {
+        PGPROC* proc = g_instance.proc_base_all_procs[i];
+        Datum values[NUM_FASTPATH_STAT_COLUMNS];
+        bool nulls[NUM_FASTPATH_STAT_COLUMNS] = {false};
+        ThreadId pid;
+        int32 used = 0;
+        uint64 grants;
+        uint64 groupFull;
+        uint64 transferred;
+
+        LWLockAcquire(proc->backendLock, LW_SHARED);
+        pid = proc->pid;
+        for (uint32 f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+            if (FAST_PATH_GET_BITS(proc, f) != 0)
+                used++;
+        }
+        grants = proc->fpGrants;
+        groupFull = proc->fpGroupFull;
+        transferred = proc->fpTransferred;
+        LWLockRelease(proc->backendLock);
+
+        if (pid == 0)
+            continue;
+
+        values[ARR_0] = Int64GetDatum((int64)pid);
+        values[ARR_1] = Int32GetDatum(used);
+        values[ARR_2] = Int64GetDatum((int64)grants);
+        values[ARR_3] = Int64GetDatum((int64)groupFull);
+        values[ARR_4] = Int64GetDatum((int64)transferred);
+        tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+    }
+    tuplestore_donestoring(tupstore);
+
+    return (Datum)0;
+}
+
 /*
  * Functions for manipulating advisory locks
  *
@@ -42,6 +42,7 @@
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "utils/acl.h"
+#include "utils/array.h"
 #include "utils/builtins.h"
 #include "utils/globalplancache.h"
 #include "utils/inet.h"
@@ -398,7 +399,8 @@ static const char* WaitStateDesc[] = {
     "gtm set consistency point",     // STATE_GTM_SET_CONSISTENCY_POINT
     "wait sync bgworkers",           // STATE_WAIT_SYNC_BGWORKERS
     "stanby read recovery conflict", // STATE_STANDBY_READ_RECOVERY_CONFLICT
-    "standby get snapshot"           // STATE_STANDBY_GET_SNAPSHOT
+    "standby get snapshot",          // STATE_STANDBY_GET_SNAPSHOT
+    "wait wal replay"                // STATE_WAIT_XLOG_REPLAY
 };
 
 // description for WaitStatePhase enums.
@@ -13850,6 +13852,83 @@ Datum local_redo_time_count(PG_FUNCTION_ARGS)
     return (Datum)0;
 }
 
+/*
+ * Block prefetch of the extreme RTO lookahead stage, one row per pipeline.
+ * prefetch_depth is how many bytes of WAL the lookahead has read past the
+ * replayed position.
+ */
+Datum local_redo_prefetch_stat(PG_FUNCTION_ARGS)
+{
+    TupleDesc tupdesc;
+    Tuplestorestate *tupstore = BuildTupleResult(fcinfo, &tupdesc);
+    const uint32 redo_prefetch_cols = 5;
+    Datum values[redo_prefetch_cols];
+    bool nulls[redo_prefetch_cols] = {false};
+    RedoWorkerStatsData worker[MAX_RECOVERY_THREAD_NUM] = {0};
+    uint32 workerNum = 0;
+
+    if (IsExtremeRedo()) {
+        GetRedoWorkerStatistic(&workerNum, worker, (uint32)MAX_RECOVERY_THREAD_NUM);
+    }
+
+    XLogRecPtr replayed = g_instance.comm_cxt.predo_cxt.redoPf.last_replayed_end_ptr;
+    for (uint32 i = 0; i < workerNum; ++i) {
+        uint32 k = 0;
+        values[k++] = Int32GetDatum(worker[i].id);
+        values[k++] = Int64GetDatum(worker[i].prefetch_count);
+        values[k++] = Int64GetDatum(worker[i].prefetch_skip_count);
+        values[k++] = Int64GetDatum(worker[i].prefetch_ptr);
+        values[k++] = Int64GetDatum((worker[i].prefetch_ptr > replayed) ? (worker[i].prefetch_ptr - replayed) : 0);
+        tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+    }
+
+    tuplestore_donestoring(tupstore);
+    return (Datum)0;
+}
+
+static Datum redo_queue_hist_datum(const uint64 *hist)
+{
+    Datum buckets[REDO_QUEUE_HIST_BUCKETS];
+
+    for (uint32 i = 0; i < REDO_QUEUE_HIST_BUCKETS; ++i) {
+        buckets[i] = Int64GetDatum(hist[i]);
+    }
+    return PointerGetDatum(
+        construct_array(buckets, REDO_QUEUE_HIST_BUCKETS, INT8OID, sizeof(int64), FLOAT8PASSBYVAL, 'd'));
+}
+
+/*
+ * Log2 histograms of the extreme RTO queues, summed per pipeline: queue depth
+ * seen by each put (0, 1, 2-3, ... 64+ items), consumer sleeps on an empty
+ * queue and producer stalls on a full one (under 16us, 16-31us, ... 1024us+).
+ */
+Datum local_redo_queue_stat(PG_FUNCTION_ARGS)
+{
+    TupleDesc tupdesc;
+    Tuplestorestate *tupstore = BuildTupleResult(fcinfo, &tupdesc);
+    const uint32 redo_queue_cols = 4;
+    Datum values[redo_queue_cols];
+    bool nulls[redo_queue_cols] = {false};
+    RedoWorkerStatsData worker[MAX_RECOVERY_THREAD_NUM] = {0};
+    uint32 workerNum = 0;
+
+    if (IsExtremeRedo()) {
+        GetRedoWorkerStatistic(&workerNum, worker, (uint32)MAX_RECOVERY_THREAD_NUM);
+    }
+
+    for (uint32 i = 0; i < workerNum; ++i) {
+        uint32 k = 0;
+        values[k++] = Int32GetDatum(worker[i].id);
+        values[k++] = redo_queue_hist_datum(worker[i].queue_depth_hist);
+        values[k++] = redo_queue_hist_datum(worker[i].queue_idle_wait_hist);
+        values[k++] = redo_queue_hist_datum(worker[i].queue_full_wait_hist);
+        tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+    }
+
+    tuplestore_donestoring(tupstore);
+    return (Datum)0;
+}
+
 Datum local_xlog_redo_statics(PG_FUNCTION_ARGS)
 {
     TupleDesc tupdesc;
@@ -21,6 +21,7 @@
 #include "access/ustore/undo/knl_uundoapi.h"
 #include "access/ustore/undo/knl_uundotxn.h"
 #include "access/ustore/undo/knl_uundozone.h"
+#include "access/ustore/knl_undoworker.h"
 #include "access/ubtree.h"
 #include "access/redo_statistic.h"
 #include "access/xlog.h"
@@ -69,6 +70,7 @@
 const int STAT_USTORE_BUFF_SIZE = 10240;
 const int STAT_UNDO_COLS = 10;
 const int STAT_UNDO_BUFFER_SIZE = 500;
+const int STAT_UNDO_ROLLBACK_COLS = 7;
 const uint TOP_USED_ZONE_NUM = 3;
 const float FORCE_RECYCLE_PERCENT = 0.8;
 const int UNDO_SLOT_FILE_MAXSIZE = 1024 * 32;
@@ -93,6 +95,7 @@ const int TYPE_SLOT_SPACE = 3;
 
 /* ustore stat */
 extern Datum gs_stat_ustore(PG_FUNCTION_ARGS);
+extern Datum gs_stat_undo_rollback(PG_FUNCTION_ARGS);
 extern void CheckUser(const char *fName);
 extern char *ParsePage(char *path, int64 blocknum, char *relation_type, bool read_memory, bool dumpUndo = false);
 
@@ -755,6 +758,70 @@ Datum gs_stat_undo(PG_FUNCTION_ARGS)
 #endif
 }
 
+/*
+ * Progress of the asynchronous rollbacks being applied by undo workers, one
+ * row per part of a split rollback request.
+ */
+Datum gs_stat_undo_rollback(PG_FUNCTION_ARGS)
+{
+#ifdef ENABLE_MULTIPLE_NODES
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("unsupported view in multiple nodes mode.")));
+    PG_RETURN_VOID();
+#else
+    ReturnSetInfo *rsinfo = (ReturnSetInfo *)fcinfo->resultinfo;
+    TupleDesc tupDesc;
+    Tuplestorestate *tupstore = NULL;
+    MemoryContext per_query_ctx;
+    MemoryContext oldcontext;
+    int actualUndoWorkers = Min(g_instance.attr.attr_storage.max_undo_workers, MAX_UNDO_WORKERS);
+
+    if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo)) {
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+            errmsg("set-valued function called in context that cannot accept a set")));
+        PG_RETURN_VOID();
+    }
+    if (!(rsinfo->allowedModes & SFRM_Materialize)) {
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+            errmsg("materialize mode required, but it is not allowed in this context")));
+        PG_RETURN_VOID();
+    }
+    if (get_call_result_type(fcinfo, NULL, &tupDesc) != TYPEFUNC_COMPOSITE) {
+        elog(ERROR, "return type must be a row type");
+        PG_RETURN_VOID();
+    }
+    per_query_ctx = rsinfo->econtext->ecxt_per_query_memory;
+    oldcontext = MemoryContextSwitchTo(per_query_ctx);
+    tupstore = tuplestore_begin_heap(true, false, u_sess->attr.attr_memory.work_mem);
+    rsinfo->returnMode = SFRM_Materialize;
+    rsinfo->setResult = tupstore;
+    rsinfo->setDesc = tupDesc;
+    MemoryContextSwitchTo(oldcontext);
+
+    for (int i = 0; i < actualUndoWorkers; i++) {
+        volatile UndoWorkerItem *item = &t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i];
+        ThreadId pid = item->pid;
+        TransactionId xid = item->xid;
+        bool nulls[STAT_UNDO_ROLLBACK_COLS] = {false};
+        Datum values[STAT_UNDO_ROLLBACK_COLS];
+
+        /* slots not handed to a worker yet have an invalid pid */
+        if (!TransactionIdIsValid(xid) || pid == 0 || pid == (ThreadId)(-1)) {
+            continue;
+        }
+        values[ARR_0] = Int64GetDatum((int64)pid);
+        values[ARR_1] = TransactionIdGetDatum(xid);
+        values[ARR_2] = Int32GetDatum(item->partIdx + 1);
+        values[ARR_3] = Int32GetDatum(Max(item->nparts, 1));
+        values[ARR_4] = Int64GetDatum((int64)item->undoRecords);
+        values[ARR_5] = Int64GetDatum((int64)item->undoBlocks);
+        values[ARR_6] = TimestampTzGetDatum(item->rollbackStartTime);
+        tuplestore_putvalues(tupstore, tupDesc, values, nulls);
+    }
+    tuplestore_donestoring(tupstore);
+    PG_RETURN_VOID();
+#endif
+}
+
 #ifndef ENABLE_MULTIPLE_NODES
 static uint64 UndoSize(UndoSpaceType type)
 {
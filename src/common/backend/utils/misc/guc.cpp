@@ -300,6 +300,7 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "search_path",
     "percentile",
     "default_tablespace",
+    "default_toast_compression",
     "temp_tablespaces",
     "check_function_bodies",
     "default_transaction_isolation",
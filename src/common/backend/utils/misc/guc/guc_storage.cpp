@@ -32,6 +32,7 @@
 #include "access/cbmparsexlog.h"
 #include "access/gin.h"
 #include "access/gtm.h"
+#include "access/toast_compression.h"
 #include "pgxc/pgxc.h"
 #include "access/transam.h"
 #include "access/twophase.h"
@@ -250,6 +251,8 @@ static void InitStorageConfigureNamesEnum();
 
 static bool check_logical_decode_options_default(char** newval, void** extra, GucSource source);
 static void assign_logical_decode_options_default(const char* newval, void* extra);
+static bool check_standby_read_lsn(char** newval, void** extra, GucSource source);
+static void assign_standby_read_lsn(const char* newval, void* extra);
 
 static const struct config_enum_entry resource_track_log_options[] = {
     {"summary", SUMMARY, false},
@@ -290,6 +293,20 @@ static const struct config_enum_entry repl_auth_mode_options[] = {
     {NULL, 0, false}
 };
 
+static const struct config_enum_entry default_toast_compression_options[] = {
+    {"pglz", TOAST_PGLZ_COMPRESSION_ID, false},
+    {"lz4", TOAST_LZ4_COMPRESSION_ID, false},
+    {"zstd", TOAST_ZSTD_COMPRESSION_ID, false},
+    {NULL, 0, false}
+};
+
+static const struct config_enum_entry wal_receiver_compression_options[] = {
+    {"off", WAL_COMPRESSION_NONE, false},
+    {"lz4", WAL_COMPRESSION_LZ4, false},
+    {"zstd", WAL_COMPRESSION_ZSTD, false},
+    {NULL, 0, false}
+};
+
 /*
  * Although only "on", "off", "remote_write", and "local" are documented, we
  * accept all the likely variants of "on" and "off".
@@ -1195,6 +1212,17 @@ static void InitStorageConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"recovery_prefetch",
+            PGC_SIGHUP,
+            NODE_ALL,
+            RESOURCES_RECOVERY,
+            gettext_noop("Prefetches blocks referenced in the WAL ahead of extreme RTO redo."),
+            NULL},
+            &u_sess->attr.attr_storage.recovery_prefetch,
+            false,
+            NULL,
+            NULL,
+            NULL},
         /* End-of-list marker */
         {{NULL,
             (GucContext)0,
@@ -1293,6 +1321,32 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+        {{"clog_buffers",
+            PGC_POSTMASTER,
+            NODE_ALL,
+            RESOURCES_MEM,
+            gettext_noop("Sets the number of CLOG buffers in each CLOG partition."),
+            gettext_noop("0 derives it from shared_buffers.")},
+            &g_instance.attr.attr_storage.clog_buffers,
+            0,
+            0,
+            16384,
+            NULL,
+            NULL,
+            NULL},
+        {{"csnlog_buffers",
+            PGC_POSTMASTER,
+            NODE_ALL,
+            RESOURCES_MEM,
+            gettext_noop("Sets the number of CSNLOG buffers in each CSNLOG partition."),
+            gettext_noop("0 derives it from shared_buffers.")},
+            &g_instance.attr.attr_storage.csnlog_buffers,
+            0,
+            0,
+            16384,
+            NULL,
+            NULL,
+            NULL},
         {{"vacuum_gtt_defer_check_age",
             PGC_USERSET,
             NODE_SINGLENODE,
@@ -1409,6 +1463,20 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+        {{"standby_read_lsn_timeout",
+            PGC_USERSET,
+            NODE_ALL,
+            REPLICATION_STANDBY,
+            gettext_noop("Sets the maximum time a query on a hot standby waits for standby_read_lsn to be replayed."),
+            gettext_noop("The query fails when the time is up, 0 fails it at once."),
+            GUC_UNIT_MS},
+            &u_sess->attr.attr_storage.standby_read_lsn_timeout,
+            10 * 1000,
+            0,
+            INT_MAX,
+            NULL,
+            NULL,
+            NULL},
 
 #ifndef ENABLE_MULTIPLE_NODES
         {{"recovery_min_apply_delay",
@@ -2206,6 +2274,19 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+        {{"lwlock_max_spins",
+            PGC_SIGHUP,
+            NODE_ALL,
+            LOCK_MANAGEMENT,
+            gettext_noop("Sets the maximum number of times a busy LWLock is polled before sleeping on it."),
+            gettext_noop("The number adapts per lock tranche up to this limit. 0 disables spinning.")},
+            &g_instance.attr.attr_storage.lwlock_max_spins,
+            1000,
+            0,
+            10000,
+            NULL,
+            NULL,
+            NULL},
         {{"wal_keep_segments",
             PGC_SIGHUP,
             NODE_ALL,
@@ -2487,6 +2568,47 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+        {{"max_parallel_apply_workers_per_subscription",
+            PGC_SIGHUP,
+            NODE_SINGLENODE,
+            REPLICATION,
+            gettext_noop("Maximum number of parallel apply workers per subscription."),
+            gettext_noop("0 applies remote transactions serially in the apply worker. "
+                         "Takes effect when the apply worker restarts.")},
+            &u_sess->attr.attr_storage.max_parallel_apply_workers_per_subscription,
+            0,
+            0,
+            MAX_BACKENDS,
+            NULL,
+            NULL,
+            NULL},
+        {{"max_parallel_sync_workers_per_table",
+            PGC_SIGHUP,
+            NODE_SINGLENODE,
+            REPLICATION,
+            gettext_noop("Maximum number of workers helping a table synchronization worker copy a large table."),
+            gettext_noop("0 copies every table with its table synchronization worker alone.")},
+            &u_sess->attr.attr_storage.max_parallel_sync_workers_per_table,
+            0,
+            0,
+            MAX_BACKENDS,
+            NULL,
+            NULL,
+            NULL},
+        {{"min_parallel_sync_table_size",
+            PGC_SIGHUP,
+            NODE_SINGLENODE,
+            REPLICATION,
+            gettext_noop("Sets the minimum size on the publisher of a table copied by parallel sync workers."),
+            NULL,
+            GUC_UNIT_KB},
+            &u_sess->attr.attr_storage.min_parallel_sync_table_size,
+            1024 * 1024,
+            0,
+            INT_MAX,
+            NULL,
+            NULL,
+            NULL},
 
         {{"recovery_time_target",
             PGC_SIGHUP,
@@ -3350,6 +3472,19 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+        {{"max_undo_workers_per_rollback",
+            PGC_SIGHUP,
+            NODE_SINGLENODE,
+            RESOURCES_DISK,
+            gettext_noop("Sets the maximum number of undo workers that apply one asynchronous rollback."),
+            NULL},
+            &u_sess->attr.attr_storage.max_undo_workers_per_rollback,
+            1,
+            1,
+            MAX_UNDO_APPLY_PARTS,
+            NULL,
+            NULL,
+            NULL},
         {{"undo_zone_count",
             PGC_POSTMASTER,
             NODE_ALL,
@@ -4467,6 +4602,18 @@ static void InitStorageConfigureNamesString()
             check_logical_decode_options_default,
             assign_logical_decode_options_default,
             NULL},
+        {{"standby_read_lsn",
+            PGC_USERSET,
+            NODE_ALL,
+            REPLICATION_STANDBY,
+            gettext_noop("Sets the WAL location a hot standby must have replayed before the next snapshot is taken."),
+            gettext_noop("Pass the commit location returned by the primary to read your own writes on a standby."),
+            GUC_NOT_IN_SAMPLE},
+            &u_sess->attr.attr_storage.standby_read_lsn,
+            "",
+            check_standby_read_lsn,
+            assign_standby_read_lsn,
+            NULL},
         {{"ss_dss_vg_name",
             PGC_POSTMASTER,
             NODE_SINGLENODE,
@@ -4683,6 +4830,30 @@ static void InitStorageConfigureNamesEnum()
             NULL,
             NULL,
             NULL},
+        {{"default_toast_compression",
+            PGC_USERSET,
+            NODE_ALL,
+            CLIENT_CONN_STATEMENT,
+            gettext_noop("Sets the default compression method for compressible values."),
+            gettext_noop("Columns with a compression method set by ALTER TABLE ... SET COMPRESSION use that one.")},
+            &u_sess->attr.attr_storage.default_toast_compression,
+            TOAST_PGLZ_COMPRESSION_ID,
+            default_toast_compression_options,
+            NULL,
+            NULL,
+            NULL},
+        {{"wal_receiver_compression",
+            PGC_SIGHUP,
+            NODE_ALL,
+            REPLICATION_STANDBY,
+            gettext_noop("Sets the compression the standby asks for when streaming WAL from its primary."),
+            gettext_noop("Takes effect when the WAL receiver connects again.")},
+            &u_sess->attr.attr_storage.wal_receiver_compression,
+            WAL_COMPRESSION_NONE,
+            wal_receiver_compression_options,
+            NULL,
+            NULL,
+            NULL},
 #ifndef ENABLE_MULTIPLE_NODES
         {{"dcf_log_file_permission",
             PGC_POSTMASTER,
@@ -6266,3 +6437,28 @@ static void assign_logical_decode_options_default(const char* newval, void* extr
     u_sess->attr.attr_storage.logical_decode_options_default = extra;
 }
 
+static bool check_standby_read_lsn(char** newval, void** extra, GucSource source)
+{
+    uint32 hi = 0;
+    uint32 lo = 0;
+    int len = 0;
+    XLogRecPtr* lsn = NULL;
+
+    if (*newval != NULL && (*newval)[0] != '\0' &&
+        (sscanf_s(*newval, "%X/%X%n", &hi, &lo, &len) != 2 || (*newval)[len] != '\0')) {
+        GUC_check_errdetail("standby_read_lsn must be a WAL location like \"0/3000060\".");
+        return false;
+    }
+
+    lsn = (XLogRecPtr*)MemoryContextAlloc(SESS_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_CBB), sizeof(XLogRecPtr));
+    *lsn = (((uint64)hi) << 32) | lo;
+    *extra = lsn;
+    return true;
+}
+
+/* arm the wait in GetTransactionSnapshot(), every SET arms it again */
+static void assign_standby_read_lsn(const char* newval, void* extra)
+{
+    u_sess->utils_cxt.standbyReadLSN = *(XLogRecPtr*)extra;
+}
+
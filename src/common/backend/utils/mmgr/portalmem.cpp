@@ -636,7 +636,6 @@ void PortalDrop(Portal portal, bool isTopCommit)
     if (ENABLE_GPC && portal->copyCxt)
         MemoryContextDelete(portal->copyCxt);
 
-    u_sess->parser_cxt.param_message = NULL;
     if (IS_PGXC_COORDINATOR && !IsConnFromCoord()) {
         u_sess->parser_cxt.param_info = NULL;
     }
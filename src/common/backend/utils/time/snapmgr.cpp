@@ -48,6 +48,7 @@
 #include "access/transam.h"
 #include "access/twophase.h"
 #include "access/xact.h"
+#include "access/xlog.h"
 #include "catalog/pg_type.h"
 #include "funcapi.h"
 #include "miscadmin.h"
@@ -489,6 +490,18 @@ Snapshot GetTransactionSnapshot(bool force_local_snapshot)
         return u_sess->utils_cxt.HistoricSnapshot;
     }
 
+    /*
+     * read-your-writes on hot standby, wait for redo to pass standby_read_lsn.
+     * The wait is disarmed first, so a timeout or cancel does not make every
+     * later snapshot of the session wait again; SET it again to retry.
+     */
+    if (!XLogRecPtrIsInvalid(u_sess->utils_cxt.standbyReadLSN)) {
+        XLogRecPtr waitLSN = u_sess->utils_cxt.standbyReadLSN;
+
+        u_sess->utils_cxt.standbyReadLSN = InvalidXLogRecPtr;
+        WaitForXLogReplay(waitLSN, u_sess->attr.attr_storage.standby_read_lsn_timeout);
+    }
+
     /* First call in transaction? */
     if (!u_sess->utils_cxt.FirstSnapshotSet) {
         Assert(u_sess->utils_cxt.RegisteredSnapshots == 0);
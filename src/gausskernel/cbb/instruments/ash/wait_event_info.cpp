@@ -30,7 +30,7 @@ typedef struct EventInfo {
     char* type;
     char* event;
 } EventInfo;
-#define WAIT_EVENT_SIZE 257
+#define WAIT_EVENT_SIZE 259
 struct EventInfo waitEventInfo[WAIT_EVENT_SIZE] = {
     {"none", "STATUS", "none"},
     {"LWLock", "STATUS", "acquire lwlock"},
@@ -134,6 +134,8 @@ struct EventInfo waitEventInfo[WAIT_EVENT_SIZE] = {
     {"Clog", "IO_EVENT", "SLRURead"},
     {"Clog", "IO_EVENT", "SLRUSync"},
     {"Clog", "IO_EVENT", "SLRUWrite"},
+    {"Clog", "IO_EVENT", "CLOGRead"},
+    {"CSN", "IO_EVENT", "CSNLOGRead"},
     {"Timelinehistory", "IO_EVENT", "TimelineHistoryRead"},
     {"Timelinehistory", "IO_EVENT", "TimelineHistorySync"},
     {"Timelinehistory", "IO_EVENT", "TimelineHistoryWrite"},
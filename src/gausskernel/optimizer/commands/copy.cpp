@@ -41,6 +41,7 @@
 #endif
 #include "catalog/storage_gtt.h"
 #include "commands/copy.h"
+#include "commands/copy_scan.h"
 #include "commands/defrem.h"
 #include "commands/trigger.h"
 #include "commands/copypartition.h"
@@ -55,6 +56,7 @@
 #include "optimizer/planner.h"
 #include "optimizer/streamplan.h"
 #include "parser/parse_relation.h"
+#include "postmaster/bgworker.h"
 #ifdef PGXC
 #include "optimizer/pgxcship.h"
 #include "pgxc/pgxc.h"
@@ -1845,6 +1847,17 @@ void ProcessCopyOptions(CopyState cstate, bool is_from, List* options)
             if (cstate->skip < 0) {
                 ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("SKIP %ld should be >= 0", cstate->skip)));
             }
+        } else if (strcmp(defel->defname, "parallel") == 0) {
+            int64 nworkers;
+
+            if (cstate->parallel_workers > 0)
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("conflicting or redundant options")));
+            nworkers = defGetInt64(defel);
+            if (nworkers < 1 || nworkers > MAX_COPY_PARALLEL_WORKERS)
+                ereport(ERROR,
+                    (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                        errmsg("PARALLEL %ld must be between 1 and %d", nworkers, MAX_COPY_PARALLEL_WORKERS)));
+            cstate->parallel_workers = (int)nworkers;
         } else if (pg_strcasecmp((defel->defname), "sequence") == 0) {
             cstate->sequence_col_list = (List*)(defel->arg);
         } else if (pg_strcasecmp((defel->defname), "filler") == 0) {
@@ -2041,6 +2054,9 @@ void ProcessCopyOptions(CopyState cstate, bool is_from, List* options)
     if (cstate->eol_type == EOL_UD && IS_BINARY(cstate))
         ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("can not specify EOL in BINARY mode")));
 
+    if (!is_from && cstate->parallel_workers > 0)
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("COPY parallel only available using COPY FROM")));
+
     if (!is_from && force_fix_width != 0)
         ereport(ERROR,
             (errcode(ERRCODE_SYNTAX_ERROR),
@@ -4108,6 +4124,669 @@ void HeapAddToBulk(CopyFromBulk bulk, Tuple tup, bool needCopy)
     AddToBulk<false>(bulk, tuple, needCopy);
 }
 
+/*
+ * Parallel COPY FROM.
+ *
+ * The leader keeps reading the input with CopyReadLine, so line splitting,
+ * CSV quoting, the end-of-copy marker and encoding conversion stay serial,
+ * and packs whole lines into chunks that bgworkers pick up from a ring of
+ * shared slots.  Each worker parses its chunks with a private copy of the
+ * COPY state and loads them through its own multi-insert buffers and bulk
+ * insert strategy, inside the leader's transaction.  A chunk remembers the
+ * number of its first input line, so errors still point at the right line.
+ */
+#define COPY_PARALLEL_CHUNK_SIZE (64 * 1024)
+#define COPY_PARALLEL_SLOTS_PER_WORKER 4
+#define COPY_PARALLEL_WAIT_US 1000L
+#define COPY_PARALLEL_START_TIMEOUT_US ((long)BGWORKER_STATUS_DURLIMIT * BGWORKER_LOOP_SLEEP_TIME)
+#define COPY_PARALLEL_ERROR_LEN BGWORKER_MAX_ERROR_LEN
+
+typedef enum CopyChunkState {
+    COPY_CHUNK_FREE,  /* the leader may fill it */
+    COPY_CHUNK_READY, /* filled, waiting for a worker */
+    COPY_CHUNK_BUSY   /* being loaded by a worker */
+} CopyChunkState;
+
+typedef struct CopyParallelChunk {
+    CopyChunkState state;
+    uint32 firstLine; /* input line number of the first line */
+    int nlines;
+    int len;          /* bytes used in data */
+    int size;         /* bytes allocated for data */
+    char* data;       /* nlines of (int32 length, line bytes) */
+} CopyParallelChunk;
+
+typedef struct CopyParallelShared {
+    /* set up by the leader, read-only afterwards */
+    Oid relid;
+    CopyState leader; /* parsing options are read from the leader's state */
+    CommandId mycid;
+    int hiOptions;
+    int nslots;
+    CopyParallelChunk* slots;
+
+    /* mutex protects the fields below and the state of every slot */
+    slock_t mutex;
+    int nattached;     /* workers that have entered CopyParallelWorkerMain */
+    int nextTake;      /* next slot to hand out, in fill order */
+    bool eof;          /* the leader has published its last chunk */
+    bool errorClaimed; /* a worker is recording its error */
+    bool failed;       /* the error fields below are complete */
+    uint64 processed;
+
+    uint32 errorLine;
+    bool errorHasAttval;
+    char errorAttname[NAMEDATALEN];
+    char errorAttval[COPY_PARALLEL_ERROR_LEN];
+    char errorLineData[COPY_PARALLEL_ERROR_LEN];
+} CopyParallelShared;
+
+typedef struct CopyParallelWorker {
+    CopyParallelShared* shared;
+    CopyState cstate; /* worker's private COPY state, NULL until set up */
+} CopyParallelWorker;
+
+/*
+ * Only plain text/CSV loads into an ordinary heap table are parallelized;
+ * every other case keeps the serial path, which handles it as before.
+ * Per-row AFTER triggers (including foreign keys) and auto-increment need
+ * the leader's session state, and local or global temp tables live in
+ * session-private buffers.
+ */
+static bool CopyFromParallelEligible(CopyState cstate, ResultRelInfo* resultRelInfo, bool useHeapMultiInsert)
+{
+    Relation rel = cstate->rel;
+
+    if (!useHeapMultiInsert || !IS_SINGLE_NODE)
+        return false;
+
+    if (!(IS_TEXT(cstate) || IS_CSV(cstate)) || cstate->readlineFunc != CopyReadLineText ||
+        cstate->mode != MODE_INVALID || cstate->is_load_copy || cstate->log_errors || cstate->logErrorsData ||
+        cstate->compatible_illegal_chars || cstate->trans_expr_list != NIL || cstate->when != NIL ||
+        cstate->sequence_col_list != NIL || cstate->filler_col_list != NIL || cstate->constant_col_list != NIL)
+        return false;
+
+    if (!RelationIsAstoreFormat(rel) || RelationIsColStore(rel) || RelationIsTsStore(rel) ||
+        RELATION_IS_PARTITIONED(rel) || RELATION_OWN_BUCKET(rel) || RelationIsSegmentTable(rel) ||
+        RelationUsesLocalBuffers(rel) || RELATION_IS_GLOBAL_TEMP(rel) || rel->rd_isblockchain || RelHasAutoInc(rel))
+        return false;
+
+    if (resultRelInfo->ri_TrigDesc != NULL && resultRelInfo->ri_TrigDesc->trig_insert_after_row)
+        return false;
+
+    return true;
+}
+
+/*
+ * Read the next input line into line_buf, skipping the header and SKIP lines
+ * the way NextCopyFromRawFields does.  Returns false at end of input.
+ */
+static bool CopyParallelReadLine(CopyState cstate)
+{
+    /* on input just throw the header line away */
+    if (cstate->cur_lineno == 0 && cstate->header_line) {
+        cstate->cur_lineno++;
+        if (CopyReadLine(cstate))
+            return false;
+    }
+
+    while (cstate->skiprows < cstate->skip) {
+        cstate->cur_lineno++;
+        if (CopyReadLine(cstate))
+            return false;
+        cstate->skiprows++;
+    }
+
+    cstate->cur_lineno++;
+
+    /* EOF at start of line means we're done, see NextCopyFromRawFields */
+    if (CopyReadLine(cstate) && cstate->line_buf.len == 0)
+        return false;
+    return true;
+}
+
+/*
+ * Fill a free chunk with lines until it reaches COPY_PARALLEL_CHUNK_SIZE.
+ * The buffer grows so that a single long line always fits.  Returns true
+ * once the input is exhausted; the chunk may still hold lines then.
+ */
+static bool CopyParallelFillChunk(CopyState cstate, CopyParallelChunk* chunk)
+{
+    errno_t rc;
+
+    chunk->nlines = 0;
+    chunk->len = 0;
+
+    while (chunk->len < COPY_PARALLEL_CHUNK_SIZE) {
+        int32 linelen;
+        int need;
+
+        if (!CopyParallelReadLine(cstate))
+            return true;
+
+        linelen = cstate->line_buf.len;
+        need = chunk->len + (int)sizeof(int32) + linelen;
+        if (need > chunk->size) {
+            int newsize = Max(need, COPY_PARALLEL_CHUNK_SIZE + (int)sizeof(int32));
+
+            if (chunk->data == NULL)
+                chunk->data = (char*)MemoryContextAlloc(INSTANCE_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_STORAGE), newsize);
+            else
+                chunk->data = (char*)repalloc(chunk->data, newsize);
+            chunk->size = newsize;
+        }
+
+        if (chunk->nlines == 0)
+            chunk->firstLine = cstate->cur_lineno;
+
+        rc = memcpy_s(chunk->data + chunk->len, chunk->size - chunk->len, &linelen, sizeof(int32));
+        securec_check(rc, "\0", "\0");
+        chunk->len += sizeof(int32);
+        if (linelen > 0) {
+            rc = memcpy_s(chunk->data + chunk->len, chunk->size - chunk->len, cstate->line_buf.data, linelen);
+            securec_check(rc, "\0", "\0");
+            chunk->len += linelen;
+        }
+        chunk->nlines++;
+    }
+
+    return false;
+}
+
+/*
+ * Wait until the leader may refill the given slot.  Returns false if a worker
+ * failed and the leader should stop feeding input.
+ */
+static bool CopyParallelWaitFreeChunk(CopyParallelShared* shared, CopyParallelChunk* chunk)
+{
+    long waited = 0;
+
+    for (;;) {
+        CopyChunkState state;
+        bool failed = false;
+        int nattached;
+
+        SpinLockAcquire(&shared->mutex);
+        state = chunk->state;
+        failed = shared->errorClaimed;
+        nattached = shared->nattached;
+        SpinLockRelease(&shared->mutex);
+
+        if (failed)
+            return false;
+        if (state == COPY_CHUNK_FREE)
+            return true;
+
+        /* workers that never got going can't drain the ring */
+        if (nattached == 0 && waited >= COPY_PARALLEL_START_TIMEOUT_US)
+            ereport(ERROR,
+                (errcode(ERRCODE_INSUFFICIENT_RESOURCES),
+                    errmsg("parallel COPY workers did not start in %ld seconds", waited / USECS_PER_SEC)));
+
+        CHECK_FOR_INTERRUPTS();
+        pg_usleep(COPY_PARALLEL_WAIT_US);
+        waited += COPY_PARALLEL_WAIT_US;
+    }
+}
+
+/*
+ * Runs first on the leader's error context stack.  When a worker failed, make
+ * the leader's COPY state describe the worker's failing line, so that the
+ * rethrown error gets the same context as a serial COPY would report.
+ */
+static void CopyParallelLeaderErrorCallback(void* arg)
+{
+    CopyParallelShared* shared = (CopyParallelShared*)arg;
+    CopyState cstate = shared->leader;
+    bool failed = false;
+
+    SpinLockAcquire(&shared->mutex);
+    failed = shared->failed;
+    SpinLockRelease(&shared->mutex);
+
+    if (!failed || shared->errorLine == 0)
+        return;
+
+    cstate->cur_lineno = shared->errorLine;
+    resetStringInfo(&cstate->line_buf);
+    appendStringInfoString(&cstate->line_buf, shared->errorLineData);
+    cstate->line_buf_converted = true;
+    cstate->cur_attname =
+        (shared->errorAttname[0] != '\0') ? MemoryContextStrdup(cstate->copycontext, shared->errorAttname) : NULL;
+    cstate->cur_attval =
+        shared->errorHasAttval ? MemoryContextStrdup(cstate->copycontext, shared->errorAttval) : NULL;
+}
+
+static void CopyParallelSaveString(char* dst, int dstlen, const char* src)
+{
+    int len = pg_mbcliplen(src, strlen(src), dstlen - 1);
+    errno_t rc;
+
+    if (len > 0) {
+        rc = memcpy_s(dst, dstlen, src, len);
+        securec_check(rc, "\0", "\0");
+    }
+    dst[len] = '\0';
+}
+
+/*
+ * Error context callback of a worker.  Adds the usual COPY context to the
+ * worker's own log entry and, for the first error of the whole load, records
+ * where it happened for the leader.
+ */
+static void CopyParallelWorkerErrorCallback(void* arg)
+{
+    CopyParallelWorker* worker = (CopyParallelWorker*)arg;
+    CopyParallelShared* shared = worker->shared;
+    CopyState cstate = worker->cstate;
+    ErrorData* edata = &t_thrd.log_cxt.errordata[t_thrd.log_cxt.errordata_stack_depth];
+    bool first = false;
+
+    if (cstate != NULL)
+        CopyFromErrorCallback(cstate);
+
+    if (edata->elevel < ERROR)
+        return;
+
+    SpinLockAcquire(&shared->mutex);
+    first = !shared->errorClaimed;
+    shared->errorClaimed = true;
+    SpinLockRelease(&shared->mutex);
+
+    if (!first)
+        return;
+
+    if (cstate != NULL) {
+        shared->errorLine = cstate->cur_lineno;
+        CopyParallelSaveString(shared->errorLineData, COPY_PARALLEL_ERROR_LEN, cstate->line_buf.data);
+        if (cstate->cur_attname != NULL)
+            CopyParallelSaveString(shared->errorAttname, NAMEDATALEN, cstate->cur_attname);
+        if (cstate->cur_attval != NULL) {
+            CopyParallelSaveString(shared->errorAttval, COPY_PARALLEL_ERROR_LEN, cstate->cur_attval);
+            shared->errorHasAttval = true;
+        }
+    }
+
+    SpinLockAcquire(&shared->mutex);
+    shared->failed = true;
+    SpinLockRelease(&shared->mutex);
+}
+
+/*
+ * Chunk-backed readlineFunc of a worker.  The line comes without its
+ * terminator, so append the '\n' CopyReadLine strips for EOL_NL.
+ */
+static bool CopyReadLineFromChunk(CopyState cstate)
+{
+    stringinfo_ptr chunk = &cstate->inBuffer;
+    int32 linelen;
+    errno_t rc;
+
+    if (chunk->cursor >= chunk->len)
+        return true;
+
+    rc = memcpy_s(&linelen, sizeof(int32), chunk->data + chunk->cursor, sizeof(int32));
+    securec_check(rc, "\0", "\0");
+    chunk->cursor += sizeof(int32);
+
+    appendBinaryStringInfo(&cstate->line_buf, chunk->data + chunk->cursor, linelen);
+    appendStringInfoCharMacro(&cstate->line_buf, '\n');
+    chunk->cursor += linelen;
+    return false;
+}
+
+/*
+ * Build a worker's COPY state from the leader's.  Parsing options and the
+ * read-only per-column arrays are shared; everything the parser writes to,
+ * and the function and expression state, is private to the worker.
+ */
+static CopyState CopyParallelWorkerBeginState(CopyState leader, Relation rel)
+{
+    TupleDesc tupDesc = RelationGetDescr(rel);
+    FormData_pg_attribute* attr = tupDesc->attrs;
+    int natts = tupDesc->natts;
+    CopyState cstate = (CopyState)palloc(sizeof(CopyStateData));
+    MemoryContext oldcontext;
+    Oid in_func_oid;
+    Oid typioparam;
+    errno_t rc;
+
+    rc = memcpy_s(cstate, sizeof(CopyStateData), leader, sizeof(CopyStateData));
+    securec_check(rc, "\0", "\0");
+
+    cstate->copycontext = AllocSetContextCreate(CurrentMemoryContext,
+        "COPY worker",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE);
+    oldcontext = MemoryContextSwitchTo(cstate->copycontext);
+
+    cstate->rel = rel;
+    cstate->copy_dest = COPY_FILE;
+    cstate->copy_file = NULL;
+    cstate->fe_msgbuf = NULL;
+    cstate->fe_eof = false;
+    cstate->eol_type = EOL_NL;
+    cstate->need_transcoding = false;
+    cstate->header_line = false;
+    cstate->skip = 0;
+    cstate->skiprows = 0;
+    cstate->cur_lineno = 0;
+    cstate->cur_attname = NULL;
+    cstate->cur_attval = NULL;
+    cstate->illegal_chars_error = NIL;
+    cstate->pcState = NULL;
+    cstate->readlineFunc = CopyReadLineFromChunk;
+    cstate->inBuffer.reset();
+
+    initStringInfo(&cstate->attribute_buf);
+    initStringInfo(&cstate->sequence_buf);
+    initStringInfo(&cstate->line_buf);
+    initStringInfo(&cstate->fieldBuf);
+    cstate->line_buf_converted = false;
+    cstate->raw_buf = NULL;
+    cstate->raw_buf_index = cstate->raw_buf_len = 0;
+    cstate_fields_buffer_init(cstate);
+
+    cstate->in_functions = (FmgrInfo*)palloc0(natts * sizeof(FmgrInfo));
+    cstate->in_convert_funcs = (FmgrInfo*)palloc0(natts * sizeof(FmgrInfo));
+    for (int i = 0; i < natts; i++) {
+        if (attr[i].attisdropped)
+            continue;
+        getTypeInputInfo(attr[i].atttypid, &in_func_oid, &typioparam);
+        fmgr_info(in_func_oid, &cstate->in_functions[i]);
+        construct_conversion_fmgr_info(
+            GetDatabaseEncoding(), cstate->attr_encodings[i], (void*)&cstate->in_convert_funcs[i]);
+    }
+
+    cstate->defexprs = (ExprState**)palloc0(natts * sizeof(ExprState*));
+    for (int i = 0; i < cstate->num_defaults; i++) {
+        Expr* defexpr = (Expr*)build_column_default(rel, cstate->defmap[i] + 1);
+
+        Assert(defexpr != NULL);
+        defexpr = expression_planner(defexpr);
+        cstate->defexprs[i] = ExecInitExpr(defexpr, NULL);
+    }
+
+    (void)MemoryContextSwitchTo(oldcontext);
+    return cstate;
+}
+
+/* Hand out the next published chunk, or NULL when there is no more work. */
+static CopyParallelChunk* CopyParallelTakeChunk(CopyParallelShared* shared)
+{
+    for (;;) {
+        CopyParallelChunk* chunk = NULL;
+        bool finished = false;
+
+        SpinLockAcquire(&shared->mutex);
+        if (shared->errorClaimed) {
+            finished = true;
+        } else if (shared->slots[shared->nextTake].state == COPY_CHUNK_READY) {
+            chunk = &shared->slots[shared->nextTake];
+            chunk->state = COPY_CHUNK_BUSY;
+            shared->nextTake = (shared->nextTake + 1) % shared->nslots;
+        } else if (shared->eof) {
+            finished = true;
+        }
+        SpinLockRelease(&shared->mutex);
+
+        if (chunk != NULL || finished)
+            return chunk;
+
+        CHECK_FOR_INTERRUPTS();
+        pg_usleep(COPY_PARALLEL_WAIT_US);
+    }
+}
+
+/*
+ * Parse and insert chunks until the leader runs dry.  This is the multi-insert
+ * branch of CopyFrom for a non-partitioned heap, with a private executor
+ * state, bulk insert state and CopyFromManager.
+ */
+static uint64 CopyParallelWorkerLoad(CopyParallelWorker* worker)
+{
+    CopyParallelShared* shared = worker->shared;
+    CopyState cstate = worker->cstate;
+    Relation rel = cstate->rel;
+    TupleDesc tupDesc = RelationGetDescr(rel);
+    EState* estate = CreateExecutorState();
+    ResultRelInfo* resultRelInfo = NULL;
+    ExprContext* econtext = NULL;
+    TupleTableSlot* myslot = NULL;
+    MemoryContext oldcontext = CurrentMemoryContext;
+    BulkInsertState bistate;
+    CopyFromManager mgr;
+    CopyParallelChunk* chunk = NULL;
+    Datum* values = NULL;
+    bool* nulls = NULL;
+    bool resetPerTupCxt = false;
+    uint64 processed = 0;
+
+    resultRelInfo = makeNode(ResultRelInfo);
+    InitResultRelInfo(resultRelInfo, rel, 1, 0);
+    ExecOpenIndices(resultRelInfo, false);
+
+    estate->es_result_relations = resultRelInfo;
+    estate->es_num_result_relations = 1;
+    estate->es_result_relation_info = resultRelInfo;
+    estate->es_range_table = cstate->range_table;
+
+    myslot = ExecInitExtraTupleSlot(estate, rel->rd_tam_ops);
+    ExecSetSlotDescriptor(myslot, tupDesc);
+
+    values = (Datum*)palloc(tupDesc->natts * sizeof(Datum));
+    nulls = (bool*)palloc(tupDesc->natts * sizeof(bool));
+
+    bistate = GetBulkInsertState();
+    econtext = GetPerTupleExprContext(estate);
+    mgr = initCopyFromManager(cstate->copycontext, rel);
+    cstate->pcState = New(cstate->copycontext) PageCompress(rel, cstate->copycontext);
+
+    while ((chunk = CopyParallelTakeChunk(shared)) != NULL) {
+        cstate->inBuffer.set(chunk->data, chunk->len);
+        cstate->cur_lineno = chunk->firstLine - 1;
+
+        for (;;) {
+            Tuple tuple;
+            Oid loaded_oid = InvalidOid;
+            CopyFromBulk bulk = NULL;
+            bool toFlush = false;
+
+            CHECK_FOR_INTERRUPTS();
+
+            if (resetPerTupCxt) {
+                ResetPerTupleExprContext(estate);
+                resetPerTupCxt = false;
+            }
+            (void)MemoryContextSwitchTo(GetPerTupleMemoryContext(estate));
+
+            if (!NextCopyFrom(cstate, econtext, values, nulls, &loaded_oid))
+                break;
+
+            tuple = (Tuple)tableam_tops_form_tuple(tupDesc, values, nulls, rel->rd_tam_ops);
+            if (loaded_oid != InvalidOid)
+                HeapTupleSetOid((HeapTuple)tuple, loaded_oid);
+
+            (void)MemoryContextSwitchTo(oldcontext);
+            (void)ExecStoreTuple(tuple, myslot, InvalidBuffer, false);
+
+            if (tupDesc->constr != NULL && tupDesc->constr->has_generated_stored) {
+                ExecComputeStoredGenerated(resultRelInfo, estate, myslot, tuple, CMD_INSERT);
+                tuple = myslot->tts_tuple;
+            }
+            if (tupDesc->constr != NULL)
+                ExecConstraints(resultRelInfo, myslot, estate, true);
+
+            bulk = findBulk(mgr, RelationGetRelid(rel), InvalidBktId, &toFlush);
+            Assert(!toFlush);
+            tableam_tops_add_to_bulk(rel, bulk, tuple, false);
+            if (isBulkFull(bulk)) {
+                resetPerTupCxt = CopyFromChunkInsert<false>(cstate, estate, bulk, mgr, cstate->pcState,
+                    shared->mycid, shared->hiOptions, resultRelInfo, myslot, bistate);
+            }
+            processed++;
+        }
+
+        (void)MemoryContextSwitchTo(oldcontext);
+
+        SpinLockAcquire(&shared->mutex);
+        chunk->state = COPY_CHUNK_FREE;
+        SpinLockRelease(&shared->mutex);
+    }
+
+    if (mgr->bulk->numTuples > 0) {
+        mgr->LastFlush = true;
+        (void)CopyFromChunkInsert<false>(cstate, estate, mgr->bulk, mgr, cstate->pcState, shared->mycid,
+            shared->hiOptions, resultRelInfo, myslot, bistate);
+    }
+
+    FreeBulkInsertState(bistate);
+    deinitCopyFromManager(mgr);
+    delete cstate->pcState;
+    cstate->pcState = NULL;
+
+    pfree_ext(values);
+    pfree_ext(nulls);
+
+    ExecResetTupleTable(estate->es_tupleTable, false);
+    ExecCloseIndices(resultRelInfo);
+    FreeExecutorState(estate);
+
+    return processed;
+}
+
+static void CopyParallelWorkerMain(const BgWorkerContext* bwc)
+{
+    CopyParallelShared* shared = (CopyParallelShared*)bwc->bgshared;
+    CopyParallelWorker worker;
+    ErrorContextCallback errcallback;
+    Relation rel;
+    uint64 processed;
+
+    worker.shared = shared;
+    worker.cstate = NULL;
+
+    /* Installed first, so the leader learns about any error of ours */
+    errcallback.callback = CopyParallelWorkerErrorCallback;
+    errcallback.arg = (void*)&worker;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    SpinLockAcquire(&shared->mutex);
+    shared->nattached++;
+    SpinLockRelease(&shared->mutex);
+
+    /* The leader holds RowExclusiveLock and we are in its lock group */
+    rel = heap_open(shared->relid, NoLock);
+    worker.cstate = CopyParallelWorkerBeginState(shared->leader, rel);
+
+    processed = CopyParallelWorkerLoad(&worker);
+
+    SpinLockAcquire(&shared->mutex);
+    shared->processed += processed;
+    SpinLockRelease(&shared->mutex);
+
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+    MemoryContextDelete(worker.cstate->copycontext);
+    heap_close(rel, NoLock);
+}
+
+static void CopyParallelCleanup(const BgWorkerContext* bwc)
+{
+    CopyParallelShared* shared = (CopyParallelShared*)bwc->bgshared;
+
+    for (int i = 0; i < shared->nslots; i++)
+        pfree_ext(shared->slots[i].data);
+    pfree_ext(shared->slots);
+}
+
+/*
+ * Load the whole input with PARALLEL workers.  Returns false, having read no
+ * input, when no worker could be launched; the caller then copies serially.
+ */
+static bool CopyFromParallel(CopyState cstate, CommandId mycid, int hi_options, uint64* processed)
+{
+    CopyParallelShared* shared = NULL;
+    ErrorContextCallback errcallback;
+    int nworkers = cstate->parallel_workers;
+    int nlaunched;
+
+    /* workers insert under the leader's xid, so it has to exist by now */
+    (void)GetCurrentTransactionId();
+
+    shared = (CopyParallelShared*)MemoryContextAllocZero(
+        INSTANCE_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_STORAGE), sizeof(CopyParallelShared));
+    shared->relid = RelationGetRelid(cstate->rel);
+    shared->leader = cstate;
+    shared->mycid = mycid;
+    shared->hiOptions = hi_options;
+    shared->nslots = nworkers * COPY_PARALLEL_SLOTS_PER_WORKER;
+    shared->slots = (CopyParallelChunk*)MemoryContextAllocZero(
+        INSTANCE_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_STORAGE), shared->nslots * sizeof(CopyParallelChunk));
+    SpinLockInit(&shared->mutex);
+
+    nlaunched = LaunchBackgroundWorkers(nworkers, shared, CopyParallelWorkerMain, CopyParallelCleanup);
+    if (nlaunched == 0) {
+        pfree_ext(shared->slots);
+        pfree_ext(shared);
+        return false;
+    }
+    ereport(DEBUG1,
+        (errmsg("COPY %s launched %d of %d parallel workers", RelationGetRelationName(cstate->rel), nlaunched,
+            nworkers)));
+
+    errcallback.callback = CopyParallelLeaderErrorCallback;
+    errcallback.arg = (void*)shared;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    PG_TRY();
+    {
+        int head = 0;
+        bool done = false;
+
+        while (!done) {
+            CopyParallelChunk* chunk = &shared->slots[head];
+
+            if (!CopyParallelWaitFreeChunk(shared, chunk))
+                break;
+
+            done = CopyParallelFillChunk(cstate, chunk);
+
+            SpinLockAcquire(&shared->mutex);
+            if (chunk->nlines > 0)
+                chunk->state = COPY_CHUNK_READY;
+            shared->eof = done;
+            SpinLockRelease(&shared->mutex);
+
+            head = (head + 1) % shared->nslots;
+        }
+
+        /* rethrows a worker's error, with its line through errcallback */
+        BgworkerListWaitFinish(&nlaunched);
+        pg_memory_barrier();
+
+        if (shared->errorClaimed)
+            ereport(ERROR,
+                (errcode(ERRCODE_IN_FAILED_SQL_TRANSACTION), errmsg("Background worker failed during parallel COPY.")));
+        *processed = shared->processed;
+    }
+    PG_CATCH();
+    {
+        /* shared goes away with the workers */
+        t_thrd.log_cxt.error_context_stack = errcallback.previous;
+        BgworkerListSyncQuit();
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+    BgworkerListSyncQuit();
+
+    return true;
+}
+
 /*
  * Copy FROM file to relation.
  */
@@ -4144,6 +4823,7 @@ uint64 CopyFrom(CopyState cstate)
     bool needflush = false;
     bool isForeignTbl = false; /* Whether this foreign table support COPY */
     bool rel_isblockchain = false;
+    bool copiedInParallel = false;
     int hash_colno = -1;
     Assert(cstate->rel);
 
@@ -4356,6 +5036,15 @@ uint64 CopyFrom(CopyState cstate)
         LockRelFileNode(cstate->rel->rd_node, RowExclusiveLock);
     }
 
+    /*
+     * With PARALLEL, bgworkers parse and multi-insert the input; the serial
+     * loop below is skipped unless the target or the options rule that out
+     * or no worker could be launched.
+     */
+    if (cstate->parallel_workers > 1 && CopyFromParallelEligible(cstate, resultRelInfo, useHeapMultiInsert)) {
+        copiedInParallel = CopyFromParallel(cstate, mycid, hi_options, &processed);
+    }
+
     // Copy support ColStore
     //
     CStorePartitionInsert* cstorePartitionInsert = NULL;
@@ -4409,7 +5098,7 @@ uint64 CopyFrom(CopyState cstate)
     }
 #endif   /* ENABLE_MULTIPLE_NODES */
 
-    for (;;) {
+    while (!copiedInParallel) {
         TupleTableSlot* slot = NULL;
         bool skip_tuple = false;
         Oid loaded_oid = InvalidOid;
@@ -6901,6 +7590,7 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
     bool last_was_esc = false;
     char quotec = '\0';
     char escapec = '\0';
+    CopyScanSet scanset;
 
     if (csv_mode) {
         quotec = cstate->quote[0];
@@ -6913,6 +7603,23 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
 
     mblen_str[1] = '\0';
 
+    /*
+     * Every byte the loop below reacts to.  High-bit bytes only matter when
+     * a multibyte character may carry ASCII in its trailing bytes.
+     */
+    CopyScanInit(&scanset, cstate->encoding_embeds_ascii || cstate->file_encoding == PG_GBK ||
+                               cstate->file_encoding == PG_GB18030);
+    CopyScanAddChar(&scanset, '\n');
+    CopyScanAddChar(&scanset, '\r');
+    CopyScanAddChar(&scanset, '\\');
+    if (cstate->eol_type == EOL_UD) {
+        CopyScanAddChar(&scanset, cstate->eol[0]);
+    }
+    if (csv_mode) {
+        CopyScanAddChar(&scanset, quotec);
+        CopyScanAddChar(&scanset, escapec);
+    }
+
     /*
      * The objective of this loop is to transfer the entire next input line
      * into line_buf.  Hence, we only care for detecting newlines (\r and/or
@@ -6940,6 +7647,7 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
 
     for (;;) {
         int prev_raw_ptr;
+        int plain_len;
         char c;
         char sec = '\0';
 
@@ -6976,6 +7684,20 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
             need_data = false;
         }
 
+        /*
+         * Step over the run of bytes none of the tests below would react to.
+         * They are plain data whatever the quoting state; all they change is
+         * that we are no longer at the start of the line or after an escape.
+         */
+        plain_len = CopyScanPlain(&scanset, copy_raw_buf + raw_buf_ptr, copy_buf_len - raw_buf_ptr);
+        if (plain_len > 0) {
+            raw_buf_ptr += plain_len;
+            first_char_in_line = false;
+            last_was_esc = false;
+            if (raw_buf_ptr >= copy_buf_len)
+                continue;
+        }
+
         /* OK to fetch a character */
         prev_raw_ptr = raw_buf_ptr;
         c = copy_raw_buf[raw_buf_ptr++];
@@ -7335,6 +8057,25 @@ void cstate_fields_buffer_init(CopyState cstate)
     cstate->raw_fields = (char**)palloc(nfields * sizeof(char*));
 }
 
+/*
+ * Copy the run of bytes at *cur_ptr that are not in "set" to *output_ptr in
+ * one go, advancing both.  The attribute splitters call this before looking
+ * at each character, so that only structural bytes go through their byte
+ * loops.  The caller has made output_ptr's buffer as large as the line.
+ */
+static inline void CopyFieldCopyPlain(const CopyScanSet* set, char** cur_ptr, const char* line_end_ptr,
+    char** output_ptr)
+{
+    int plain_len = CopyScanPlain(set, *cur_ptr, line_end_ptr - *cur_ptr);
+
+    if (plain_len > 0) {
+        errno_t rc = memcpy_s(*output_ptr, plain_len, *cur_ptr, plain_len);
+        securec_check(rc, "\0", "\0");
+        *output_ptr += plain_len;
+        *cur_ptr += plain_len;
+    }
+}
+
 /*
  * @Description: Parse the current line into separate attributes (fields),
  *   performing de-escaping as needed.
@@ -7372,6 +8113,7 @@ static int CopyReadAttributesTextT(CopyState cstate)
     int numattrs = list_length(cstate->attnumlist);
     int proc_col_num = 0;
     int max_filler_index = numattrs + list_length(cstate->filler_col_list);
+    CopyScanSet fieldscan;
 
     /*
      * We need a special case for zero-column tables: check that the input
@@ -7407,6 +8149,13 @@ static int CopyReadAttributesTextT(CopyState cstate)
     line_begin_ptr = cstate->line_buf.data;
     line_end_ptr = cstate->line_buf.data + cstate->line_buf.len;
 
+    /* bytes the field scan below does more with than copy to output */
+    CopyScanInit(&fieldscan, PG_GBK == GetDatabaseEncoding());
+    CopyScanAddChar(&fieldscan, delimc);
+    if (!cstate->without_escaping) {
+        CopyScanAddChar(&fieldscan, '\\');
+    }
+
     /* Outer loop iterates over fields */
     fieldno = 0;
     for (;;) {
@@ -7457,6 +8206,7 @@ static int CopyReadAttributesTextT(CopyState cstate)
         for (;;) {
             char c;
 
+            CopyFieldCopyPlain(&fieldscan, &cur_ptr, line_end_ptr, &output_ptr);
             end_ptr = cur_ptr;
             if (cur_ptr >= line_end_ptr) {
                 break;
@@ -7697,6 +8447,8 @@ static int CopyReadAttributesCSVT(CopyState cstate)
     int numattrs = list_length(cstate->attnumlist);
     int proc_col_num = 0;
     int max_filler_index = numattrs + list_length(cstate->filler_col_list);
+    CopyScanSet unquotedscan;
+    CopyScanSet quotedscan;
 
     /*
      * We need a special case for zero-column tables: check that the input
@@ -7732,6 +8484,14 @@ static int CopyReadAttributesCSVT(CopyState cstate)
     line_begin_ptr = cstate->line_buf.data;
     line_end_ptr = cstate->line_buf.data + cstate->line_buf.len;
 
+    /* bytes the two field scan loops below do more with than copy to output */
+    CopyScanInit(&unquotedscan, false);
+    CopyScanAddChar(&unquotedscan, delimc);
+    CopyScanAddChar(&unquotedscan, quotec);
+    CopyScanInit(&quotedscan, false);
+    CopyScanAddChar(&quotedscan, quotec);
+    CopyScanAddChar(&quotedscan, escapec);
+
     /* Outer loop iterates over fields */
     fieldno = 0;
     for (;;) {
@@ -7785,6 +8545,10 @@ static int CopyReadAttributesCSVT(CopyState cstate)
 
             /* Not in quote */
             for (;;) {
+                /* after a quoted part gs_load rejects whatever follows, see below */
+                if (!(cstate->is_load_copy && saw_quote)) {
+                    CopyFieldCopyPlain(&unquotedscan, &cur_ptr, line_end_ptr, &output_ptr);
+                }
                 end_ptr = cur_ptr;
                 if (cur_ptr >= line_end_ptr) {
                     goto endfield;
@@ -7814,6 +8578,7 @@ static int CopyReadAttributesCSVT(CopyState cstate)
 
             /* In quote */
             for (;;) {
+                CopyFieldCopyPlain(&quotedscan, &cur_ptr, line_end_ptr, &output_ptr);
                 end_ptr = cur_ptr;
                 if (cur_ptr >= line_end_ptr)
                     ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("unterminated CSV quoted field")));
@@ -1285,6 +1285,16 @@ ObjectAddress DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId,
                 (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                     errmsg("Could not create cross-bucket index for non-hashbucket table.")));
         }
+        /* only MOT builds its index trees by itself */
+#ifdef ENABLE_MOT
+        if (is_contain_tree_flavor(stmt->options) && !isMOTFromTblOid(RelationGetRelid(rel))) {
+#else
+        if (is_contain_tree_flavor(stmt->options)) {
+#endif
+            ereport(ERROR,
+                (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                    errmsg("Option \"tree_flavor\" is only supported for MOT indexes.")));
+        }
         /* Set the page split method */
         if (RelationIsIndexsplitMethodInsertpt(index_relopts)) {
             indexsplitMethod = INDEXSPLIT_NO_INSERTPT;
@@ -66,7 +66,7 @@ static bool CheckPublicationsExistOnPublisher(List *publications);
  */
 static void parse_subscription_options(const List *options, char **conninfo, List **publications, bool *enabled_given,
     bool *enabled, bool *slot_name_given, char **slot_name, char **synchronous_commit, bool *binary_given, bool *binary,
-    bool *copy_data_given, bool *copy_data, bool *connect_given, bool *connect)
+    bool *streaming_given, bool *streaming, bool *copy_data_given, bool *copy_data, bool *connect_given, bool *connect)
 {
     ListCell *lc;
 
@@ -90,6 +90,10 @@ static void parse_subscription_options(const List *options, char **conninfo, Lis
         *binary_given = false;
         *binary = false;
     }
+    if (streaming) {
+        *streaming_given = false;
+        *streaming = false;
+    }
 
     if (copy_data) {
         *copy_data_given = false;
@@ -157,6 +161,15 @@ static void parse_subscription_options(const List *options, char **conninfo, Lis
 
             *binary_given = true;
             *binary = defGetBoolean(defel);
+        } else if (strcmp(defel->defname, "streaming") == 0 && streaming) {
+            if (*streaming_given) {
+                ereport(ERROR,
+                        (errcode(ERRCODE_SYNTAX_ERROR),
+                         errmsg("conflicting or redundant options")));
+            }
+
+            *streaming_given = true;
+            *streaming = defGetBoolean(defel);
         } else if (strcmp(defel->defname, "copy_data") == 0 && copy_data) {
             if (*copy_data_given) {
                 ereport(ERROR,
@@ -458,6 +471,8 @@ ObjectAddress CreateSubscription(CreateSubscriptionStmt *stmt, bool isTopLevel)
     bool slotname_given;
     bool binary;
     bool binary_given;
+    bool streaming;
+    bool streaming_given;
     bool copy_data;
     bool copy_data_given;
     bool connect;
@@ -471,7 +486,8 @@ ObjectAddress CreateSubscription(CreateSubscriptionStmt *stmt, bool isTopLevel)
      * Connection and publication should not be specified here.
      */
     parse_subscription_options(stmt->options, NULL, NULL, &enabled_given, &enabled, &slotname_given, &slotname,
-        &synchronous_commit, &binary_given, &binary, &copy_data_given, &copy_data, &connect_given, &connect);
+        &synchronous_commit, &binary_given, &binary, &streaming_given, &streaming, &copy_data_given, &copy_data,
+        &connect_given, &connect);
 
     /*
      * Since creating a replication slot is not transactional, rolling back
@@ -515,6 +531,7 @@ ObjectAddress CreateSubscription(CreateSubscriptionStmt *stmt, bool isTopLevel)
     values[Anum_pg_subscription_subowner - 1] = ObjectIdGetDatum(owner);
     values[Anum_pg_subscription_subenabled - 1] = BoolGetDatum(enabled);
     values[Anum_pg_subscription_subbinary - 1] = BoolGetDatum(binary);
+    values[Anum_pg_subscription_substream - 1] = BoolGetDatum(streaming);
 
     /* encrypt conninfo */
     char *encryptConninfo = EncryptOrDecryptConninfo(stmt->conninfo, 'E');
@@ -797,6 +814,8 @@ ObjectAddress AlterSubscription(AlterSubscriptionStmt *stmt, bool isTopLevel)
     bool enabled = false;
     bool binary_given = false;
     bool binary = false;
+    bool streaming_given = false;
+    bool streaming = false;
     char *synchronous_commit = NULL;
     char *conninfo = NULL;
     char *slot_name = NULL;
@@ -838,9 +857,10 @@ ObjectAddress AlterSubscription(AlterSubscriptionStmt *stmt, bool isTopLevel)
     /* Parse options. */
     if (!stmt->refresh) {
         parse_subscription_options(stmt->options, &conninfo, &publications, &enabled_given, &enabled, &slotname_given,
-            &slot_name, &synchronous_commit, &binary_given, &binary, NULL, NULL, NULL, NULL);
+            &slot_name, &synchronous_commit, &binary_given, &binary, &streaming_given, &streaming, NULL, NULL, NULL,
+            NULL);
     } else {
-        parse_subscription_options(stmt->options, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+        parse_subscription_options(stmt->options, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
             &copy_data_given, &copy_data, NULL, NULL);
 
         PreventTransactionChain(isTopLevel, "ALTER SUBSCRIPTION ... REFRESH");
@@ -915,6 +935,10 @@ ObjectAddress AlterSubscription(AlterSubscriptionStmt *stmt, bool isTopLevel)
         values[Anum_pg_subscription_subbinary - 1] = BoolGetDatum(binary);
         replaces[Anum_pg_subscription_subbinary - 1] = true;
     }
+    if (streaming_given) {
+        values[Anum_pg_subscription_substream - 1] = BoolGetDatum(streaming);
+        replaces[Anum_pg_subscription_substream - 1] = true;
+    }
     if (publications != NIL) {
         values[Anum_pg_subscription_subpublications - 1] = publicationListToArray(publications);
         replaces[Anum_pg_subscription_subpublications - 1] = true;
@@ -26,6 +26,7 @@
 #include "access/reloptions.h"
 #include "access/relscan.h"
 #include "access/sysattr.h"
+#include "access/toast_compression.h"
 #include "access/transam.h"
 #include "access/tuptoaster.h"
 #include "access/visibilitymap.h"
@@ -12960,6 +12961,32 @@ static void ATExecDeleteStatistics(Relation rel, Node* def, LOCKMODE lockmode)
     }
 }
 
+/*
+ * The compression method is consulted only when toasting row-store tuples,
+ * so reject it where it would silently have no effect.
+ */
+static void CheckToastCompressionOption(Relation rel, Form_pg_attribute attr, List* options)
+{
+    ListCell* cell = NULL;
+
+    foreach (cell, options) {
+        DefElem* def = (DefElem*)lfirst(cell);
+
+        if (pg_strcasecmp(def->defname, TOAST_COMPRESSION_OPTION) != 0)
+            continue;
+        if ((rel->rd_rel->relkind != RELKIND_RELATION && rel->rd_rel->relkind != RELKIND_MATVIEW) ||
+            RelationIsColStore(rel))
+            ereport(ERROR,
+                (errcode(ERRCODE_WRONG_OBJECT_TYPE),
+                    errmsg("cannot set compression method of \"%s\"", RelationGetRelationName(rel)),
+                    errdetail("Compression methods apply to columns of row-store tables only.")));
+        if (attr->attlen != -1)
+            ereport(ERROR,
+                (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                    errmsg("column data type %s does not support compression", format_type_be(attr->atttypid))));
+    }
+}
+
 static ObjectAddress ATExecSetOptions(Relation rel, const char* colName, Node* options, bool isReset, LOCKMODE lockmode)
 {
     Relation attrelation;
@@ -12990,6 +13017,9 @@ static ObjectAddress ATExecSetOptions(Relation rel, const char* colName, Node* o
 
     Assert(IsA(options, List));
     ForbidToSetOptionsForAttribute((List*)options);
+    if (!isReset) {
+        CheckToastCompressionOption(rel, attrtuple, (List*)options);
+    }
 
     /* Generate new proposed attoptions (text array) */
     datum = SysCacheGetAttr(ATTNAME, tuple, Anum_pg_attribute_attoptions, &isnull);
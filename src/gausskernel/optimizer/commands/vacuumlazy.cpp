@@ -58,6 +58,7 @@
 #include "pgstat.h"
 #include "portability/instr_time.h"
 #include "postmaster/autovacuum.h"
+#include "postmaster/bgworker.h"
 #include "postmaster/bgwriter.h"
 #include "storage/buf/bufmgr.h"
 #include "storage/freespace.h"
@@ -126,6 +127,25 @@ typedef struct ValPrefetch {
     bool init; /* whether the prefetch list inited done or not */
 } ValPrefetch;
 
+/*
+ * State of one parallel index vacuuming pass.  Workers are threads of this
+ * process, so they read the leader's dead tuple array in place; each index
+ * is opened by OID and vacuumed by whoever takes it first.
+ */
+typedef struct LVParallelIndexShared {
+    /* set up by the leader, read-only afterwards */
+    const LVRelStats* vacrelstats;
+    int nindexes;
+    Oid* indexOids;
+
+    /* mutex protects nextIndex, every other slot belongs to its taker */
+    slock_t mutex;
+    int nextIndex;
+    bool* hasStats;                /* stats[i] is valid */
+    bool* byWorker;                /* index i was vacuumed by a worker */
+    IndexBulkDeleteResult* stats;  /* result of index i, kept across passes */
+} LVParallelIndexShared;
+
 /* A few variables that don't seem worth passing around as parameters */
 static THR_LOCAL int elevel = -1;
 
@@ -155,6 +175,8 @@ static int cbi_vac_cmp_itemptr(const void* left, const void* right);
 static int vac_cmp_itemptr(const void* left, const void* right);
 extern void vacuum_log_cleanup_info(Relation rel, LVRelStats* vacrelstats);
 static bool HeapPageCheckForUsedLinePointer(Page page);
+static void lazy_vacuum_all_indexes(Relation onerel, Relation* Irel, IndexBulkDeleteResult** indstats, int nindexes,
+    LVRelStats* vacrelstats, bool skip_cross_bucket);
 
 /*
  *	lazy_vacuum_rel() -- perform LAZY VACUUM for one heap relation
@@ -973,7 +995,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
     BlockNumber nblocks, blkno;
     HeapTupleData tuple;
     char* relname = NULL;
-    BlockNumber empty_pages, vacuumed_pages;
+    BlockNumber empty_pages, vacuumed_pages, eager_frozen_pages;
     double num_tuples, tups_vacuumed, nkeep, nunused;
     IndexBulkDeleteResult** indstats;
     int i;
@@ -991,7 +1013,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
     relname = RelationGetRelationName(onerel);
     ereport(elevel, (errmsg("vacuuming \"%s.%s\"", get_namespace_name(RelationGetNamespace(onerel)), relname)));
 
-    empty_pages = vacuumed_pages = 0;
+    empty_pages = vacuumed_pages = eager_frozen_pages = 0;
     num_tuples = tups_vacuumed = nkeep = nunused = 0;
 
     indstats = (IndexBulkDeleteResult**)palloc0(nindexes * sizeof(IndexBulkDeleteResult*));
@@ -1072,8 +1094,12 @@ static IndexBulkDeleteResult** lazy_scan_heap(
         int prev_dead_count;
         OffsetNumber invalid[MaxOffsetNumber];
         OffsetNumber frozen[MaxOffsetNumber];
+        OffsetNumber live[MaxOffsetNumber];
         int ninvalid = 0;
         int nfrozen;
+        int nlive;
+        int npruned;
+        TransactionId freeze_cutoff;
         Size freespace;
         bool all_visible_according_to_vm = false;
         bool all_visible = false;
@@ -1139,10 +1165,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
             vacuum_log_cleanup_info(onerel, vacrelstats);
 
             /* Remove index entries */
-            for (i = 0; i < nindexes; i++) {
-                vacuum_log_cleanup_info(Irel[i], vacrelstats);
-                lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats, vac_strategy);
-            }
+            lazy_vacuum_all_indexes(onerel, Irel, indstats, nindexes, vacrelstats, false);
             /* Remove tuples from heap */
             lazy_vacuum_all_heap(onerel, vacrelstats);
 
@@ -1307,8 +1330,9 @@ static IndexBulkDeleteResult** lazy_scan_heap(
          *
          * We count tuples removed by the pruning step as removed by VACUUM.
          */
-        tups_vacuumed +=
+        npruned =
             heap_page_prune(onerel, buf, u_sess->cmd_cxt.OldestXmin, false, &vacrelstats->latestRemovedXid, true);
+        tups_vacuumed += npruned;
         /*
          * Now scan the page to collect vacuumable items and check for tuples
          * requiring freezing.
@@ -1316,6 +1340,8 @@ static IndexBulkDeleteResult** lazy_scan_heap(
         all_visible = true;
         has_dead_tuples = false;
         nfrozen = 0;
+        nlive = 0;
+        freeze_cutoff = u_sess->cmd_cxt.FreezeLimit;
         changedMultiXid = false;
         hastup = false;
         prev_dead_count = vacrelstats->num_dead_tuples;
@@ -1464,6 +1490,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
             } else {
                 num_tuples += 1;
                 hastup = true;
+                live[nlive++] = offnum;
 
                 /*
                  * Each non-removable tuple must be checked to see if it needs
@@ -1475,6 +1502,54 @@ static IndexBulkDeleteResult** lazy_scan_heap(
             }
         } /* scan along page */
 
+        /*
+         * If this page is going to be dirtied and WAL-logged anyway, and every
+         * tuple left on it is visible to everyone, freeze the whole page now.
+         * That costs little more than the freeze record we are about to
+         * write, where waiting for FreezeLimit would make some later
+         * anti-wraparound vacuum read and dirty the page all over again.
+         *
+         * The cutoff is just past the newest xmin on the page rather than
+         * OldestXmin: it freezes the same tuples, but the standby only has
+         * to cancel queries that could still see that xmin as running.  It
+         * never goes below FreezeLimit, so tuples frozen above stay frozen.
+         *
+         * Redo refreezes the logged items with the logged cutoff, so every
+         * live tuple is passed through heap_freeze_tuple() with the cutoff we
+         * log, including those already frozen with FreezeLimit above; both
+         * lists are in offset order.
+         */
+        if (all_visible && nlive > 0 && (nfrozen > 0 || npruned > 0)) {
+            int nalready = nfrozen;
+            int j = 0;
+
+            if (TransactionIdIsNormal(visibility_cutoff_xid)) {
+                freeze_cutoff = visibility_cutoff_xid;
+                TransactionIdAdvance(freeze_cutoff);
+                if (TransactionIdPrecedes(freeze_cutoff, u_sess->cmd_cxt.FreezeLimit))
+                    freeze_cutoff = u_sess->cmd_cxt.FreezeLimit;
+            }
+            nfrozen = 0;
+            for (i = 0; i < nlive; i++) {
+                ItemId itemid = PageGetItemId(page, live[i]);
+                bool already = (j < nalready && frozen[j] == live[i]);
+
+                if (already)
+                    j++;
+
+                ItemPointerSet(&(tuple.t_self), blkno, live[i]);
+                tuple.t_data = (HeapTupleHeader)PageGetItem(page, itemid);
+                tuple.t_len = ItemIdGetLength(itemid);
+                HeapTupleCopyBaseFromPage(&tuple, page);
+                if (heap_freeze_tuple(&tuple, freeze_cutoff, u_sess->cmd_cxt.MultiXactFrzLimit, &changedMultiXid) ||
+                    already)
+                    frozen[nfrozen++] = live[i];
+            }
+            Assert(j == nalready);
+            if (nfrozen > nalready)
+                eager_frozen_pages++;
+        }
+
         /*
          * If we froze any tuples, mark the buffer dirty, and write a WAL
          * record recording the changes.  We must log the changes to be
@@ -1486,7 +1561,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
             if (RelationNeedsWAL(onerel)) {
                 XLogRecPtr recptr;
 
-                recptr = log_heap_freeze(onerel, buf, u_sess->cmd_cxt.FreezeLimit,
+                recptr = log_heap_freeze(onerel, buf, freeze_cutoff,
                                          changedMultiXid ?  u_sess->cmd_cxt.MultiXactFrzLimit : InvalidMultiXactId,
                                          frozen, nfrozen);
                 PageSetLSN(page, recptr);
@@ -1632,12 +1707,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
         vacuum_log_cleanup_info(onerel, vacrelstats);
 
         /* Remove index entries */
-        for (i = 0; i < nindexes; i++) {
-            if (!RelationIsCrossBucketIndex(Irel[i])) {
-                vacuum_log_cleanup_info(Irel[i], vacrelstats);
-                lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats, vac_strategy);
-            }
-        }
+        lazy_vacuum_all_indexes(onerel, Irel, indstats, nindexes, vacrelstats, true);
         vacrelstats->num_index_scans++;
     }
 
@@ -1663,6 +1733,11 @@ static IndexBulkDeleteResult** lazy_scan_heap(
                 RelationGetRelationName(onerel),
                 tups_vacuumed,
                 vacuumed_pages)));
+    if (eager_frozen_pages)
+        ereport(elevel,
+            (errmsg("\"%s\": froze all row versions in %u pages that were being modified anyway",
+                RelationGetRelationName(onerel),
+                eager_frozen_pages)));
     /* If use vacuum verbose, send messages to client, otherwise log detail result */
     ereport(elevel, (errmodule(MOD_VACUUM),
         errmsg("\"%s\": found %.0f removable, %.0f nonremovable row versions in %u out of %u pages",
@@ -1898,6 +1973,187 @@ void lazy_vacuum_index(Relation indrel, IndexBulkDeleteResult **stats, const LVR
     gstrace_exit(GS_TRC_ID_lazy_vacuum_index);
 }
 
+/*
+ * Number of workers that may help the leader with an index pass of onerel.
+ * Like parallel index builds this is opt-in through the parallel_workers
+ * reloption.  Autovacuum and relations whose indexes the workers can't open
+ * on their own by OID keep the serial path.
+ */
+static int lazy_parallel_index_workers(Relation onerel, Relation* Irel, int nindexes)
+{
+    int nworkers;
+
+    if (nindexes < 2 || !IS_SINGLE_NODE || IsAutoVacuumWorkerProcess() || !ActiveSnapshotSet())
+        return 0;
+
+    if (RelationIsPartition(onerel) || RELATION_OWN_BUCKET(onerel) || RelationUsesLocalBuffers(onerel) ||
+        RELATION_IS_GLOBAL_TEMP(onerel))
+        return 0;
+
+    for (int i = 0; i < nindexes; i++) {
+        if (RelationIsCrossBucketIndex(Irel[i]) || RelationIsGlobalIndex(Irel[i]))
+            return 0;
+    }
+
+    nworkers = Min(RelationGetParallelWorkers(onerel, 0), nindexes - 1);
+    return Min(nworkers, g_max_worker_processes);
+}
+
+/*
+ * Vacuum the indexes handed out by shared until none is left.  Used by the
+ * leader and the workers alike; the result of each index goes back to its
+ * slot, as a worker's own memory goes away with it.
+ */
+static void lazy_parallel_vacuum_indexes(LVParallelIndexShared* shared, bool isWorker, BufferAccessStrategy strategy)
+{
+    for (;;) {
+        IndexBulkDeleteResult* stats = NULL;
+        Relation indrel;
+        int idx;
+
+        SpinLockAcquire(&shared->mutex);
+        idx = shared->nextIndex++;
+        SpinLockRelease(&shared->mutex);
+
+        if (idx >= shared->nindexes)
+            break;
+
+        if (shared->hasStats[idx]) {
+            stats = (IndexBulkDeleteResult*)palloc(sizeof(IndexBulkDeleteResult));
+            *stats = shared->stats[idx];
+        }
+
+        /* The leader holds RowExclusiveLock and we are in its lock group */
+        indrel = index_open(shared->indexOids[idx], NoLock);
+        lazy_vacuum_index(indrel, &stats, shared->vacrelstats, strategy);
+        index_close(indrel, NoLock);
+
+        if (stats != NULL) {
+            shared->stats[idx] = *stats;
+            shared->hasStats[idx] = true;
+            pfree(stats);
+        }
+        shared->byWorker[idx] = isWorker;
+    }
+}
+
+static void lazy_parallel_index_main(const BgWorkerContext* bwc)
+{
+    LVParallelIndexShared* shared = (LVParallelIndexShared*)bwc->bgshared;
+
+    /* VERBOSE output can't reach the client from here, the leader reports */
+    elevel = DEBUG2;
+    lazy_parallel_vacuum_indexes(shared, true, GetAccessStrategy(BAS_VACUUM));
+}
+
+static void lazy_parallel_index_free(LVParallelIndexShared* shared)
+{
+    pfree_ext(shared->indexOids);
+    pfree_ext(shared->hasStats);
+    pfree_ext(shared->byWorker);
+    pfree_ext(shared->stats);
+}
+
+static void lazy_parallel_index_cleanup(const BgWorkerContext* bwc)
+{
+    lazy_parallel_index_free((LVParallelIndexShared*)bwc->bgshared);
+}
+
+/*
+ * Vacuum the indexes with the help of nworkers background workers.  Returns
+ * false, having done nothing, when no worker could be launched.
+ */
+static bool lazy_vacuum_indexes_parallel(Relation* Irel, IndexBulkDeleteResult** indstats, int nindexes,
+    LVRelStats* vacrelstats, int nworkers)
+{
+    MemoryContext cxt = INSTANCE_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_STORAGE);
+    LVParallelIndexShared* shared = NULL;
+    int nlaunched;
+    int i;
+
+    shared = (LVParallelIndexShared*)MemoryContextAllocZero(cxt, sizeof(LVParallelIndexShared));
+    shared->vacrelstats = vacrelstats;
+    shared->nindexes = nindexes;
+    shared->indexOids = (Oid*)MemoryContextAllocZero(cxt, nindexes * sizeof(Oid));
+    shared->hasStats = (bool*)MemoryContextAllocZero(cxt, nindexes * sizeof(bool));
+    shared->byWorker = (bool*)MemoryContextAllocZero(cxt, nindexes * sizeof(bool));
+    shared->stats = (IndexBulkDeleteResult*)MemoryContextAllocZero(cxt, nindexes * sizeof(IndexBulkDeleteResult));
+    SpinLockInit(&shared->mutex);
+    for (i = 0; i < nindexes; i++) {
+        shared->indexOids[i] = RelationGetRelid(Irel[i]);
+        if (indstats[i] != NULL) {
+            shared->stats[i] = *indstats[i];
+            shared->hasStats[i] = true;
+        }
+    }
+
+    nlaunched = LaunchBackgroundWorkers(nworkers, shared, lazy_parallel_index_main, lazy_parallel_index_cleanup);
+    if (nlaunched == 0) {
+        lazy_parallel_index_free(shared);
+        pfree_ext(shared);
+        return false;
+    }
+    ereport(DEBUG1, (errmsg("vacuum of %d indexes launched %d of %d parallel workers", nindexes, nlaunched,
+        nworkers)));
+
+    PG_TRY();
+    {
+        lazy_parallel_vacuum_indexes(shared, false, vac_strategy);
+
+        /* rethrows a worker's error */
+        BgworkerListWaitFinish(&nlaunched);
+        pg_memory_barrier();
+    }
+    PG_CATCH();
+    {
+        /* shared goes away with the workers */
+        BgworkerListSyncQuit();
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+
+    for (i = 0; i < nindexes; i++) {
+        if (!shared->hasStats[i])
+            continue;
+        if (indstats[i] == NULL)
+            indstats[i] = (IndexBulkDeleteResult*)palloc0(sizeof(IndexBulkDeleteResult));
+        *indstats[i] = shared->stats[i];
+        if (shared->byWorker[i])
+            ereport(elevel,
+                (errmsg("scanned index \"%s\" to remove %d row versions",
+                    RelationGetRelationName(Irel[i]),
+                    vacrelstats->num_dead_tuples),
+                    errdetail("Index was vacuumed by a parallel worker.")));
+    }
+
+    BgworkerListSyncQuit();
+    return true;
+}
+
+/*
+ * Remove the index entries pointing to the dead tuples collected so far from
+ * every index of onerel, in parallel if the relation asks for it.
+ */
+static void lazy_vacuum_all_indexes(Relation onerel, Relation* Irel, IndexBulkDeleteResult** indstats, int nindexes,
+    LVRelStats* vacrelstats, bool skip_cross_bucket)
+{
+    int nworkers = lazy_parallel_index_workers(onerel, Irel, nindexes);
+    int i;
+
+    for (i = 0; i < nindexes; i++) {
+        if (!skip_cross_bucket || !RelationIsCrossBucketIndex(Irel[i]))
+            vacuum_log_cleanup_info(Irel[i], vacrelstats);
+    }
+
+    if (nworkers > 0 && lazy_vacuum_indexes_parallel(Irel, indstats, nindexes, vacrelstats, nworkers))
+        return;
+
+    for (i = 0; i < nindexes; i++) {
+        if (!skip_cross_bucket || !RelationIsCrossBucketIndex(Irel[i]))
+            lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats, vac_strategy);
+    }
+}
+
 /*
  *	lazy_cleanup_index() -- do post-vacuum cleanup for one index relation.
  */
@@ -4474,6 +4474,12 @@ const char* pgstat_get_wait_io(WaitEventIO w)
         case WAIT_EVENT_SLRU_WRITE:
             event_name = "SLRUWrite";
             break;
+        case WAIT_EVENT_CLOG_READ:
+            event_name = "CLOGRead";
+            break;
+        case WAIT_EVENT_CSNLOG_READ:
+            event_name = "CSNLOGRead";
+            break;
         case WAIT_EVENT_TWOPHASE_FILE_READ:
             event_name = "TwophaseFileRead";
             break;
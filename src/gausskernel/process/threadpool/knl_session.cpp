@@ -271,7 +271,6 @@ static void knl_u_parser_init(knl_u_parser_context* parser_cxt)
     parser_cxt->hint_warning = NIL;
     parser_cxt->opr_cache_hash = NULL;
     parser_cxt->param_info = NULL;
-    parser_cxt->param_message = NULL;
     parser_cxt->ddl_pbe_context = NULL;
     parser_cxt->in_package_function_compile = false;
     parser_cxt->isCreateFuncOrProc = false;
@@ -459,6 +458,7 @@ static void knl_u_utils_init(knl_u_utils_context* utils_cxt)
     utils_cxt->FirstSnapshotSet = false;
     utils_cxt->FirstXactSnapshot = NULL;
     utils_cxt->exportedSnapshots = NIL;
+    utils_cxt->standbyReadLSN = InvalidXLogRecPtr;
     utils_cxt->g_output_version = 1;
     utils_cxt->XactIsoLevel = 0;
 
@@ -712,6 +712,12 @@ static void knl_t_basebackup_init(knl_t_basebackup_context* basebackup_cxt)
     int rc = memset_s(basebackup_cxt->g_xlog_location, MAXPGPATH, 0, MAXPGPATH);
     securec_check(rc, "\0", "\0");
     basebackup_cxt->buf_block = NULL;
+    basebackup_cxt->incremental_blocks = NULL;
+    basebackup_cxt->send_spcnode = InvalidOid;
+    basebackup_cxt->incremental_blocks_sent = 0;
+    basebackup_cxt->incremental_blocks_skipped = 0;
+    basebackup_cxt->parallel_backup_id = 0;
+    basebackup_cxt->parallel_backup_start = InvalidXLogRecPtr;
 }
 
 static void knl_t_datarcvwriter_init(knl_t_datarcvwriter_context* datarcvwriter_cxt)
@@ -731,6 +737,14 @@ static void knl_t_libwalreceiver_init(knl_t_libwalreceiver_context* libwalreceiv
     libwalreceiver_cxt->shared_storage_buf = NULL;
     libwalreceiver_cxt->shared_storage_read_buf = NULL;
     libwalreceiver_cxt->decompressBuf = NULL;
+    libwalreceiver_cxt->walCompression = 0;
+    libwalreceiver_cxt->walDecompressStream = NULL;
+    libwalreceiver_cxt->walDecompressDict = NULL;
+    libwalreceiver_cxt->walDecompressDictSize = 0;
+    libwalreceiver_cxt->walDecompressReady = false;
+    libwalreceiver_cxt->walDecompressRawBytes = 0;
+    libwalreceiver_cxt->walDecompressBytes = 0;
+    libwalreceiver_cxt->walDecompressTime = 0;
     libwalreceiver_cxt->xlogreader = NULL;
 }
 
@@ -1077,6 +1091,11 @@ static void KnlTApplyWorkerInit(knl_t_apply_worker_context* applyWorkerCxt)
     applyWorkerCxt->messageContext = NULL;
     applyWorkerCxt->logicalRepRelMapContext = NULL;
     applyWorkerCxt->applyContext = NULL;
+    applyWorkerCxt->parallelApplyGroup = NULL;
+    applyWorkerCxt->parallelSyncGroup = NULL;
+    applyWorkerCxt->inStreamedTransaction = false;
+    applyWorkerCxt->streamXid = InvalidTransactionId;
+    applyWorkerCxt->streamXacts = NULL;
 }
 
 static void KnlTPublicationInit(knl_t_publication_context* publicationCxt)
@@ -1494,6 +1513,14 @@ static void knl_t_walsender_init(knl_t_walsender_context* walsender_cxt)
     walsender_cxt->advancePrimaryConn = NULL;
     walsender_cxt->xlogReadBuf = NULL;
     walsender_cxt->compressBuf = NULL;
+    walsender_cxt->walCompression = 0;
+    walsender_cxt->walCompressStream = NULL;
+    walsender_cxt->walCompressDict = NULL;
+    walsender_cxt->walCompressReset = true;
+    walsender_cxt->walCompressSegNo = 0;
+    walsender_cxt->walCompressRawBytes = 0;
+    walsender_cxt->walCompressBytes = 0;
+    walsender_cxt->walCompressTime = 0;
     walsender_cxt->ep_fd = -1;
     walsender_cxt->datafd = -1;
     walsender_cxt->is_obsmode = false;
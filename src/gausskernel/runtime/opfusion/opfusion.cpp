@@ -179,6 +179,7 @@ void OpFusion::InitLocals(MemoryContext context)
     m_local.m_optype = NONE_FUSION;
     m_local.m_resOwner = NULL;
     m_local.m_has_init_param = false;
+    m_local.m_paramIO = NULL;
 }
 
 /* clear local variables before global it */
@@ -803,6 +804,10 @@ void OpFusion::updatePreAllocParamter(StringInfo input_message)
     if (unlikely(num_params != m_global->m_paramNum)) {
         ereport(ERROR, (errcode(ERRCODE_UNDEFINED_PSTATEMENT), errmsg("unmatched parameter number")));
     }
+    if (num_params > 0 && m_local.m_paramIO == NULL) {
+        m_local.m_paramIO =
+            (OpFusionParamIO *)MemoryContextAllocZero(m_local.m_localContext, num_params * sizeof(OpFusionParamIO));
+    }
     (void)MemoryContextSwitchTo(m_local.m_tmpContext);
     if (num_params > 0) {
         for (paramno = 0; paramno < num_params; paramno++) {
@@ -861,13 +866,26 @@ void OpFusion::updatePreAllocParamter(StringInfo input_message)
                 pformat = 0; /* default = text */
             }
 
+            /*
+             * Keep the I/O functions of built-in types for the next bind of
+             * this statement, one per format so that switching formats never
+             * rebuilds them; user-defined ones may be replaced meanwhile, so
+             * they are looked up again into the per-bind context.
+             */
+            OpFusionParamIO *paramIO = &m_local.m_paramIO[paramno];
+            bool cacheIO = (ptype < FirstNormalObjectId);
+
             if (pformat == 0) {
                 /* text mode */
                 Oid typinput;
-                Oid typioparam;
                 char *pstring = NULL;
 
-                getTypeInputInfo(ptype, &typinput, &typioparam);
+                if (!paramIO->valid[0]) {
+                    getTypeInputInfo(ptype, &typinput, &paramIO->ioparam[0]);
+                    fmgr_info_cxt(typinput, &paramIO->func[0],
+                        cacheIO ? m_local.m_localContext : m_local.m_tmpContext);
+                    paramIO->valid[0] = cacheIO;
+                }
 
                 /*
                  * We have to do encoding conversion before calling the
@@ -879,7 +897,7 @@ void OpFusion::updatePreAllocParamter(StringInfo input_message)
                     pstring = pg_client_to_server(pbuf.data, plength);
                 }
 
-                pval = OidInputFunctionCall(typinput, pstring, typioparam, -1);
+                pval = InputFunctionCall(&paramIO->func[0], pstring, paramIO->ioparam[0], -1);
 
                 /* Free result of encoding conversion, if any */
                 if (pstring != NULL && pstring != pbuf.data) {
@@ -888,13 +906,17 @@ void OpFusion::updatePreAllocParamter(StringInfo input_message)
             } else if (pformat == 1) {
                 /* binary mode */
                 Oid typreceive;
-                Oid typioparam;
                 StringInfo bufptr;
 
                 /*
                  * Call the parameter type's binary input converter
                  */
-                getTypeBinaryInputInfo(ptype, &typreceive, &typioparam);
+                if (!paramIO->valid[1]) {
+                    getTypeBinaryInputInfo(ptype, &typreceive, &paramIO->ioparam[1]);
+                    fmgr_info_cxt(typreceive, &paramIO->func[1],
+                        cacheIO ? m_local.m_localContext : m_local.m_tmpContext);
+                    paramIO->valid[1] = cacheIO;
+                }
 
                 if (isNull) {
                     bufptr = NULL;
@@ -902,7 +924,7 @@ void OpFusion::updatePreAllocParamter(StringInfo input_message)
                     bufptr = &pbuf;
                 }
 
-                pval = OidReceiveFunctionCall(typreceive, bufptr, typioparam, -1);
+                pval = ReceiveFunctionCall(&paramIO->func[1], bufptr, paramIO->ioparam[1], -1);
 
                 /* Trouble if it didn't eat the whole buffer */
                 if (!isNull && pbuf.cursor != pbuf.len) {
@@ -22,6 +22,7 @@
 #include "access/nbtree.h"
 #include "access/reloptions.h"
 #include "access/spgist.h"
+#include "access/toast_compression.h"
 #include "catalog/pg_ts_parser.h"
 #include "catalog/pg_type.h"
 #include "commands/defrem.h"
@@ -65,7 +66,9 @@
 /* value check functions for reloptions */
 static void ValidateStrOptOrientation(const char *val);
 static void  ValidateStrOptIndexsplit(const char *val);
+static void ValidateStrOptTreeFlavor(const char *val);
 static void ValidateStrOptCompression(const char *val);
+static void ValidateStrOptToastCompression(const char *val);
 static void ValidateStrOptTableAccessMethod(const char* val);
 static void ValidateStrOptTTL(const char *val);
 static void ValidateStrOptPeriod(const char *val);
@@ -339,6 +342,13 @@ static relopt_string stringRelOpts[] = {
         ValidateStrOptIndexsplit,
         INDEXSPLIT_OPT_INSERTPT,
     },
+    {
+        {"tree_flavor", "Index tree of a MOT index: masstree or art", RELOPT_KIND_BTREE},
+        0,
+        true,
+        ValidateStrOptTreeFlavor,
+        NULL,
+    },
     {
         { "ttl", "time to live for timeseries data management", RELOPT_KIND_HEAP },
         9,
@@ -525,6 +535,14 @@ static relopt_string stringRelOpts[] = {
         validateViewSecurityOption,
         NULL
     },
+    {
+        { TOAST_COMPRESSION_OPTION, "Compression method for values of this column: pglz, lz4 or zstd.",
+          RELOPT_KIND_ATTRIBUTE },
+        0,
+        true,
+        ValidateStrOptToastCompression,
+        NULL
+    },
     /* list terminator */
     {{NULL}}
 };
@@ -1954,6 +1972,7 @@ bytea *default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
         { "internal_mask", RELOPT_TYPE_INT, offsetof(StdRdOptions, internalMask) },
         { "orientation", RELOPT_TYPE_STRING, offsetof(StdRdOptions, orientation) },
         { "indexsplit", RELOPT_TYPE_STRING, offsetof(StdRdOptions, indexsplit) },
+        { "tree_flavor", RELOPT_TYPE_STRING, offsetof(StdRdOptions, tree_flavor) },
         { "compression", RELOPT_TYPE_STRING, offsetof(StdRdOptions, compression) },
         { "storage_type", RELOPT_TYPE_STRING, offsetof(StdRdOptions, storage_type) },
         { "ttl", RELOPT_TYPE_STRING, offsetof(StdRdOptions, ttl) },
@@ -2116,7 +2135,8 @@ bytea *attribute_reloptions(Datum reloptions, bool validate)
     int numoptions;
     static const relopt_parse_elt tab[] = {
         { "n_distinct", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct) },
-        { "n_distinct_inherited", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct_inherited) }
+        { "n_distinct_inherited", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct_inherited) },
+        { TOAST_COMPRESSION_OPTION, RELOPT_TYPE_STRING, offsetof(AttributeOpts, toast_compression) }
     };
 
     options = parseRelOptions(reloptions, validate, RELOPT_KIND_ATTRIBUTE, &numoptions);
@@ -2200,6 +2220,21 @@ static void ValidateStrOptIndexsplit(const char *val)
     }
 }
 
+/*
+ * Brief        : Check the tree_flavor option Validity.
+ * Input        : val, the tree_flavor option value.
+ * Output       : None.
+ * Return Value : None.
+ * Notes        : None.
+ */
+static void ValidateStrOptTreeFlavor(const char *val)
+{
+    if (pg_strcasecmp(val, TREE_FLAVOR_OPT_MASSTREE) != 0 && pg_strcasecmp(val, TREE_FLAVOR_OPT_ART) != 0) {
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("Invalid string for \"TREE_FLAVOR\" option"),
+            errdetail("Valid string are \"masstree\", \"art\".")));
+    }
+}
+
 /*
  * Brief        : Check the TTL option Validity.
  * Input        : val, the version option value.
@@ -2425,6 +2460,14 @@ static void ValidateStrOptCompression(const char *val)
                            "\"lz4\" for dfs table.")));
 }
 
+static void ValidateStrOptToastCompression(const char *val)
+{
+    if (CompressionNameToId(val) == TOAST_INVALID_COMPRESSION_ID)
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("invalid compression method \"%s\"", val),
+                 errdetail("Valid compression methods are \"pglz\", \"lz4\" and \"zstd\".")));
+}
+
 /*
  * Brief        : Validates the Table Access Method reloption for a table type
  * Input        : val, Table Access Method value.
@@ -2724,7 +2767,7 @@ void ForbidOutUsersToSetInnerOptions(List *userOptions)
 void ForbidUserToSetDefinedIndexOptions(Relation rel, List *options)
 {
     /* the following option must be in tab[] of default_reloptions(). */
-    static const char *unchangedOpt[] = {"crossbucket", "storage_type"};
+    static const char *unchangedOpt[] = {"crossbucket", "storage_type", "tree_flavor"};
 
     int firstInvalidOpt = -1;
     if (FindInvalidOption(options, unchangedOpt, lengthof(unchangedOpt), &firstInvalidOpt)) {
@@ -3002,6 +3045,18 @@ bool is_contain_crossbucket(List *defList)
     return false;
 }
 
+bool is_contain_tree_flavor(List *defList)
+{
+    ListCell *lc = NULL;
+    foreach (lc, defList) {
+        DefElem* def = (DefElem*)lfirst(lc);
+        if (pg_strcasecmp(def->defname, "tree_flavor") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool is_cstore_option(char relkind, Datum reloptions)
 {
     StdRdOptions* std_opt = (StdRdOptions*)heap_reloptions(relkind, reloptions, false);
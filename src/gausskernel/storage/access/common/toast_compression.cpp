@@ -0,0 +1,251 @@
+/* -------------------------------------------------------------------------
+ *
+ * toast_compression.cpp
+ *	  Functions for toast compression.
+ *
+ * Values are compressed with pglz, lz4 or zstd.  The method is picked per
+ * column through the toast_compression attribute option (ALTER TABLE ...
+ * ALTER COLUMN ... SET COMPRESSION), falling back to the
+ * default_toast_compression setting, and recorded in the compressed varlena
+ * itself so that readers never need to know where a value came from.
+ *
+ * Portions Copyright (c) 2021, openGauss Contributors
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/common/toast_compression.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "lz4.h"
+#include "zstd.h"
+
+#include "access/toast_compression.h"
+#include "catalog/catalog.h"
+#include "miscadmin.h"
+#include "utils/attoptcache.h"
+#include "utils/pg_lzcompress.h"
+#include "utils/rel.h"
+
+/* size of the header in front of the compressed bytes */
+#define TOAST_COMPRESS_HDRSZ ((int32)offsetof(varattrib_4b, va_compressed.va_data))
+
+/*
+ * TOAST values are compressed one at a time on the insert path, so favour
+ * speed over ratio like lz4 does; zstd level 1 still beats pglz on both.
+ */
+#define TOAST_ZSTD_LEVEL 1
+
+/* zstd contexts are costly to set up, so each thread keeps one of each */
+static THR_LOCAL ZSTD_CCtx* toast_zstd_cctx = NULL;
+static THR_LOCAL ZSTD_DCtx* toast_zstd_dctx = NULL;
+
+ToastCompressionId CompressionNameToId(const char* name)
+{
+    if (pg_strcasecmp(name, "pglz") == 0) {
+        return TOAST_PGLZ_COMPRESSION_ID;
+    } else if (pg_strcasecmp(name, "lz4") == 0) {
+        return TOAST_LZ4_COMPRESSION_ID;
+    } else if (pg_strcasecmp(name, "zstd") == 0) {
+        return TOAST_ZSTD_COMPRESSION_ID;
+    }
+    return TOAST_INVALID_COMPRESSION_ID;
+}
+
+const char* CompressionIdToName(ToastCompressionId cmid)
+{
+    switch (cmid) {
+        case TOAST_PGLZ_COMPRESSION_ID:
+            return "pglz";
+        case TOAST_LZ4_COMPRESSION_ID:
+            return "lz4";
+        case TOAST_ZSTD_COMPRESSION_ID:
+            return "zstd";
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("invalid compression method id %d", (int)cmid)));
+    }
+    return NULL; /* keep compiler quiet */
+}
+
+ToastCompressionId GetDefaultToastCompression(void)
+{
+    return (ToastCompressionId)u_sess->attr.attr_storage.default_toast_compression;
+}
+
+/*
+ * Compression method for values of column attnum of rel.
+ *
+ * Catalogs always use the default: they are toasted during bootstrap and
+ * underneath catcache lookups, where going through attoptcache could recurse.
+ * Partitions and buckets carry the options of the table they belong to.
+ */
+ToastCompressionId GetAttributeToastCompression(Relation rel, int attnum)
+{
+    ToastCompressionId cmid = GetDefaultToastCompression();
+    AttributeOpts* aopts = NULL;
+    Oid attrelid;
+
+    if (IsBootstrapProcessingMode() || IsCatalogRelation(rel)) {
+        return cmid;
+    }
+
+    if (OidIsValid(rel->grandparentId)) {
+        attrelid = rel->grandparentId;
+    } else if (OidIsValid(rel->parentId)) {
+        attrelid = rel->parentId;
+    } else {
+        attrelid = RelationGetRelid(rel);
+    }
+
+    aopts = get_attribute_options(attrelid, attnum);
+    if (aopts != NULL) {
+        if (aopts->toast_compression != 0) {
+            ToastCompressionId colcmid = CompressionNameToId((char*)aopts + aopts->toast_compression);
+
+            /* validated when it was set */
+            Assert(colcmid != TOAST_INVALID_COMPRESSION_ID);
+            if (colcmid != TOAST_INVALID_COMPRESSION_ID) {
+                cmid = colcmid;
+            }
+        }
+        pfree(aopts);
+    }
+    return cmid;
+}
+
+static struct varlena* pglz_compress_datum(const char* source, int32 valsize)
+{
+    struct varlena* tmp = (struct varlena*)palloc(PGLZ_MAX_OUTPUT(valsize));
+
+    if (!pglz_compress(source, valsize, (PGLZ_Header*)tmp, PGLZ_strategy_default)) {
+        pfree(tmp);
+        return NULL;
+    }
+    return tmp;
+}
+
+static struct varlena* lz4_compress_datum(const char* source, int32 valsize)
+{
+    int32 maxlen = LZ4_compressBound(valsize);
+    struct varlena* tmp = (struct varlena*)palloc(maxlen + TOAST_COMPRESS_HDRSZ);
+    int32 len = LZ4_compress_default(source, (char*)tmp + TOAST_COMPRESS_HDRSZ, valsize, maxlen);
+
+    if (len <= 0) {
+        ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR), errmsg("lz4 compression failed")));
+    }
+    if (len >= valsize) {
+        pfree(tmp);
+        return NULL;
+    }
+    SET_VARSIZE_COMPRESSED(tmp, len + TOAST_COMPRESS_HDRSZ);
+    TOAST_COMPRESS_SET_SIZE_AND_METHOD(tmp, valsize, TOAST_LZ4_COMPRESSION_ID);
+    return tmp;
+}
+
+static struct varlena* zstd_compress_datum(const char* source, int32 valsize)
+{
+    size_t maxlen = ZSTD_compressBound(valsize);
+    struct varlena* tmp = NULL;
+    size_t len;
+
+    if (toast_zstd_cctx == NULL) {
+        toast_zstd_cctx = ZSTD_createCCtx();
+        if (toast_zstd_cctx == NULL) {
+            ereport(ERROR, (errcode(ERRCODE_OUT_OF_MEMORY), errmsg("out of memory creating zstd context")));
+        }
+    }
+
+    tmp = (struct varlena*)palloc(maxlen + TOAST_COMPRESS_HDRSZ);
+    len = ZSTD_compressCCtx(toast_zstd_cctx, (char*)tmp + TOAST_COMPRESS_HDRSZ, maxlen, source, valsize,
+        TOAST_ZSTD_LEVEL);
+    if (ZSTD_isError(len)) {
+        ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR), errmsg("zstd compression failed: %s", ZSTD_getErrorName(len))));
+    }
+    if (len >= (size_t)valsize) {
+        pfree(tmp);
+        return NULL;
+    }
+    SET_VARSIZE_COMPRESSED(tmp, len + TOAST_COMPRESS_HDRSZ);
+    TOAST_COMPRESS_SET_SIZE_AND_METHOD(tmp, valsize, TOAST_ZSTD_COMPRESSION_ID);
+    return tmp;
+}
+
+/*
+ * Compress the data of a plain or short varlena with the given method.
+ * Returns NULL if the method could not shrink it.
+ */
+struct varlena* toast_compress_with_method(struct varlena* value, ToastCompressionId cmid)
+{
+    const char* source = VARDATA_ANY(value);
+    int32 valsize = VARSIZE_ANY_EXHDR(value);
+
+    switch (cmid) {
+        case TOAST_PGLZ_COMPRESSION_ID:
+            return pglz_compress_datum(source, valsize);
+        case TOAST_LZ4_COMPRESSION_ID:
+            return lz4_compress_datum(source, valsize);
+        case TOAST_ZSTD_COMPRESSION_ID:
+            return zstd_compress_datum(source, valsize);
+        default:
+            ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR), errmsg("invalid compression method id %d", (int)cmid)));
+    }
+    return NULL; /* keep compiler quiet */
+}
+
+/*
+ * Decompress an inline-compressed varlena into result, which must have room
+ * for VARRAWSIZE_4B_C(attr) + VARHDRSZ bytes.
+ */
+void toast_decompress_datum_into(const struct varlena* attr, struct varlena* result)
+{
+    int32 rawsize = VARRAWSIZE_4B_C(attr);
+    const char* source = (const char*)attr + TOAST_COMPRESS_HDRSZ;
+    int32 srclen = VARSIZE_4B(attr) - TOAST_COMPRESS_HDRSZ;
+
+    switch (TOAST_COMPRESS_METHOD(attr)) {
+        case TOAST_PGLZ_COMPRESSION_ID:
+            (void)pglz_decompress((const PGLZ_Header*)attr, VARDATA(result));
+            break;
+        case TOAST_LZ4_COMPRESSION_ID: {
+            int len = LZ4_decompress_safe(source, VARDATA(result), srclen, rawsize);
+
+            if (len != rawsize) {
+                ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("compressed lz4 data is corrupt")));
+            }
+            break;
+        }
+        case TOAST_ZSTD_COMPRESSION_ID: {
+            size_t len;
+
+            if (toast_zstd_dctx == NULL) {
+                toast_zstd_dctx = ZSTD_createDCtx();
+                if (toast_zstd_dctx == NULL) {
+                    ereport(ERROR, (errcode(ERRCODE_OUT_OF_MEMORY), errmsg("out of memory creating zstd context")));
+                }
+            }
+            len = ZSTD_decompressDCtx(toast_zstd_dctx, VARDATA(result), rawsize, source, srclen);
+            if (ZSTD_isError(len) || len != (size_t)rawsize) {
+                ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("compressed zstd data is corrupt")));
+            }
+            break;
+        }
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED),
+                errmsg("invalid compression method id %d", (int)TOAST_COMPRESS_METHOD(attr))));
+    }
+    SET_VARSIZE(result, rawsize + VARHDRSZ);
+}
+
+/*
+ * Decompress an inline-compressed varlena into a palloc'd plain one.
+ */
+struct varlena* toast_decompress_datum(const struct varlena* attr)
+{
+    struct varlena* result = (struct varlena*)palloc(VARRAWSIZE_4B_C(attr) + VARHDRSZ);
+
+    toast_decompress_datum_into(attr, result);
+    return result;
+}
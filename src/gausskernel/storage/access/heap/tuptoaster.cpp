@@ -126,15 +126,14 @@ struct varlena *heap_tuple_untoast_attr(struct varlena *attr, ScalarVector *arr)
         attr = toast_fetch_datum(attr);
         /* If it's compressed, decompress it */
         if (VARATT_IS_COMPRESSED(attr)) {
-            PGLZ_Header *tmp = (PGLZ_Header *)attr;
+            struct varlena *tmp = attr;
 
             if (arr == NULL) {
-                attr = (struct varlena *)palloc(PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
+                attr = (struct varlena *)palloc(VARRAWSIZE_4B_C(tmp) + VARHDRSZ);
             } else {
-                attr = (struct varlena *)arr->m_buf->Allocate(tmp->rawsize + VARHDRSZ);
+                attr = (struct varlena *)arr->m_buf->Allocate(VARRAWSIZE_4B_C(tmp) + VARHDRSZ);
             }
-            SET_VARSIZE(attr, PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
-            pglz_decompress(tmp, VARDATA(attr));
+            toast_decompress_datum_into(tmp, attr);
             pfree(tmp);
         }
     } else if (VARATT_IS_EXTERNAL_INDIRECT(attr)) {
@@ -150,15 +149,14 @@ struct varlena *heap_tuple_untoast_attr(struct varlena *attr, ScalarVector *arr)
         /*
          * This is a compressed value inside of the main tuple
          */
-        PGLZ_Header *tmp = (PGLZ_Header *)attr;
+        struct varlena *tmp = attr;
 
         if (arr == NULL) {
-            attr = (struct varlena *)palloc(PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
+            attr = (struct varlena *)palloc(VARRAWSIZE_4B_C(tmp) + VARHDRSZ);
         } else {
-            attr = (struct varlena *)arr->m_buf->Allocate(tmp->rawsize + VARHDRSZ);
+            attr = (struct varlena *)arr->m_buf->Allocate(VARRAWSIZE_4B_C(tmp) + VARHDRSZ);
         }
-        SET_VARSIZE(attr, PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
-        pglz_decompress(tmp, VARDATA(attr));
+        toast_decompress_datum_into(tmp, attr);
     } else if (VARATT_IS_SHORT(attr) && !VARATT_IS_HUGE_TOAST_POINTER(attr)) {
         /*
          * This is a short-header varlena --- convert to 4-byte header format
@@ -223,14 +221,11 @@ struct varlena *heap_tuple_untoast_attr_slice(struct varlena *attr, int64 slice_
     }
 
     if (VARATT_IS_COMPRESSED(preslice)) {
-        PGLZ_Header *tmp = (PGLZ_Header *)preslice;
-        Size size = PGLZ_RAW_SIZE(tmp) + VARHDRSZ;
+        struct varlena *tmp = preslice;
 
-        preslice = (struct varlena *)palloc(size);
-        SET_VARSIZE(preslice, size);
-        pglz_decompress(tmp, VARDATA(preslice));
+        preslice = toast_decompress_datum(tmp);
 
-        if (tmp != (PGLZ_Header *)attr)
+        if (tmp != attr)
             pfree(tmp);
     }
 
@@ -795,7 +790,7 @@ HeapTuple toast_insert_or_update(Relation rel, HeapTuple newtup, HeapTuple oldtu
         i = biggest_attno;
         if (att[i].attstorage == 'x') {
             old_value = toast_values[i];
-            new_value = toast_compress_datum(old_value);
+            new_value = toast_compress_datum(old_value, GetAttributeToastCompression(rel, i + 1));
             if (DatumGetPointer(new_value) != NULL) {
                 /* successful compression */
                 if (toast_free[i]) {
@@ -929,7 +924,7 @@ HeapTuple toast_insert_or_update(Relation rel, HeapTuple newtup, HeapTuple oldtu
          */
         i = biggest_attno;
         old_value = toast_values[i];
-        new_value = toast_compress_datum(old_value);
+        new_value = toast_compress_datum(old_value, GetAttributeToastCompression(rel, i + 1));
         if (DatumGetPointer(new_value) != NULL) {
             /* successful compression */
             if (toast_free[i]) {
@@ -1907,7 +1902,7 @@ text *text_catenate_huge(text *t1, text *t2, Oid toastOid)
  *	copying them.  But we can't handle external or compressed datums.
  * ----------
  */
-Datum toast_compress_datum(Datum value)
+Datum toast_compress_datum(Datum value, ToastCompressionId cmid)
 {
     struct varlena *tmp = NULL;
     int32 valsize = VARSIZE_ANY_EXHDR(DatumGetPointer(value));
@@ -1917,14 +1912,18 @@ Datum toast_compress_datum(Datum value)
 
     /*
      * No point in wasting a palloc cycle if value size is out of the allowed
-     * range for compression
+     * range for compression.  The pglz limits apply to every method so that
+     * switching methods does not change which values get compressed.
      */
     if (valsize < PGLZ_strategy_default->min_input_size || valsize > PGLZ_strategy_default->max_input_size)
         return PointerGetDatum(NULL);
 
-    tmp = (struct varlena *)palloc(PGLZ_MAX_OUTPUT(valsize));
+    if (cmid == TOAST_INVALID_COMPRESSION_ID)
+        cmid = GetDefaultToastCompression();
+
+    tmp = toast_compress_with_method((struct varlena *)DatumGetPointer(value), cmid);
     /*
-     * We recheck the actual size even if pglz_compress() reports success,
+     * We recheck the actual size even if the compressor reports success,
      * because it might be satisfied with having saved as little as one byte
      * in the compressed data --- which could turn into a net loss once you
      * consider header and alignment padding.  Worst case, the compressed
@@ -1933,13 +1932,13 @@ Datum toast_compress_datum(Datum value)
      * only one header byte and no padding if the value is short enough.  So
      * we insist on a savings of more than 2 bytes to ensure we have a gain.
      */
-    if (pglz_compress(VARDATA_ANY(DatumGetPointer(value)), valsize, (PGLZ_Header *)tmp, PGLZ_strategy_default) &&
-        VARSIZE(tmp) < (uint32)(valsize - 2)) {
+    if (tmp != NULL && VARSIZE(tmp) < (uint32)(valsize - 2)) {
         /* successful compression */
         return PointerGetDatum(tmp);
     } else {
         /* incompressible data */
-        pfree(tmp);
+        if (tmp != NULL)
+            pfree(tmp);
         return PointerGetDatum(NULL);
     }
 }
@@ -303,6 +303,10 @@ void UHeapDesc(StringInfo buf, XLogReaderState *record)
                     xorCurxlogptr += sizeof(uint16);
                     appendStringInfo(buf, "suffixlen %u ", *suffixlenPtr);
                 }
+                if (flags & UREC_INPLACE_UPDATE_XOR_DELTA) {
+                    uint16 *nrangesPtr = (uint16 *)(xorCurxlogptr);
+                    appendStringInfo(buf, "delta ranges %u ", *nrangesPtr);
+                }
             } else {
                 if (XLogRecGetInfo(record) & XLOG_UHEAP_INIT_PAGE) {
                     TransactionId *xidBase = (TransactionId *)currLogPtr;
@@ -636,10 +636,13 @@ CLogXidStatus CLogGetStatus(TransactionId xid, XLogRecPtr *lsn)
  * for example, on a 64-core server, the maximum number of CLOG requests that
  * can be simultaneously in flight will be even larger.  But that will
  * apparently require more than just changing the formula, so for now we take
- * the easy way out.
+ * the easy way out.  Setting clog_buffers overrides the formula.
  */
 Size CLOGShmemBuffers(void)
 {
+    if (g_instance.attr.attr_storage.clog_buffers > 0) {
+        return (Size)g_instance.attr.attr_storage.clog_buffers;
+    }
     return (Size)Min(256, Max(4, g_instance.attr.attr_storage.NBuffers / 512));
 }
 
@@ -673,6 +676,7 @@ void CLOGShmemInit(void)
         securec_check_ss(rc, "", "");
         SimpleLruInit(ClogCtl(i), name, (int)LWTRANCHE_CLOG_CTL, (int)CLOGShmemBuffers(), CLOG_LSNS_PER_PAGE,
                       CBufMappingPartitionLockByIndex(i), CLOGDIR);
+        ClogCtl(i)->read_wait_event = WAIT_EVENT_CLOG_READ;
     }
 }
 
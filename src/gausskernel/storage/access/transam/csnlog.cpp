@@ -46,6 +46,7 @@
 #include "miscadmin.h"
 #include "pgxc/pgxc.h"
 #include "pg_trace.h"
+#include "pgstat.h"
 #include "utils/snapmgr.h"
 #include "storage/barrier.h"
 #include "storage/procarray.h"
@@ -438,6 +439,30 @@ static CommitSeqNo InternalGetCommitSeqNo(TransactionId xid)
     return csn;
 }
 
+/**
+ * @Description: Look up a committed CSN without taking the partition lock.
+ * A committed CSN is final, so it can be read optimistically; anything else
+ * may still change and has to be read under the lock.
+ * @in xid -  the transaction id
+ * @out csn -  the committed csn of the input transaction
+ * @return -  true if csn was set
+ */
+static inline bool TryGetCommittedSeqNo(TransactionId xid, CommitSeqNo *csn)
+{
+    int64 pageno = TransactionIdToCSNPage(xid);
+    int entryno = TransactionIdToCSNPgIndex(xid);
+    uint64 value;
+
+    if (!TransactionIdIsNormal(xid) ||
+        !SimpleLruReadEntry_NoLock(CsnlogCtl(pageno), pageno, entryno * (int)sizeof(CommitSeqNo), &value) ||
+        !COMMITSEQNO_IS_COMMITTED(value)) {
+        return false;
+    }
+
+    *csn = value;
+    return true;
+}
+
 /**
  * @Description: Interrogate the CSN of a transaction in the CSN log.
  * @in xid -  the transaction id
@@ -448,6 +473,10 @@ CommitSeqNo CSNLogGetCommitSeqNo(TransactionId xid)
     int64 pageno = TransactionIdToCSNPage(xid);
     CommitSeqNo csn;
 
+    if (TryGetCommittedSeqNo(xid, &csn)) {
+        return csn;
+    }
+
     CSN_LWLOCK_ACQUIRE(pageno, LW_SHARED);
     csn = InternalGetCommitSeqNo(xid);
     CSN_LWLOCK_RELEASE(pageno);
@@ -465,6 +494,11 @@ CommitSeqNo CSNLogGetNestCommitSeqNo(TransactionId xid)
     int64 pageno = TransactionIdToCSNPage(xid);
     CommitSeqNo csn;
 
+    /* a committed subtransaction carries its own csn, no need to walk up */
+    if (TryGetCommittedSeqNo(xid, &csn)) {
+        return csn;
+    }
+
     CSN_LWLOCK_ACQUIRE(pageno, LW_SHARED);
     csn = RecursiveGetCommitSeqNo(xid);
     CSN_LWLOCK_RELEASE(pageno);
@@ -539,6 +573,9 @@ static CommitSeqNo RecursiveGetCommitSeqNo(TransactionId xid)
  */
 Size CSNLOGShmemBuffers(void)
 {
+    if (g_instance.attr.attr_storage.csnlog_buffers > 0) {
+        return (Size)g_instance.attr.attr_storage.csnlog_buffers;
+    }
     return Min(256, Max(BATCH_SIZE, g_instance.attr.attr_storage.NBuffers / 512));
 }
 
@@ -577,6 +614,7 @@ void CSNLOGShmemInit(void)
         securec_check_ss(rc, "\0", "\0");
         SimpleLruInit(CsnlogCtl(i), name, LWTRANCHE_CSNLOG_CTL, CSNLOGShmemBuffers(), 0,
                       CSNBufMappingPartitionLockByIndex(i), CSNLOGDIR, i);
+        CsnlogCtl(i)->read_wait_event = WAIT_EVENT_CSNLOG_READ;
     }
 }
 
@@ -2097,6 +2097,7 @@ RedoWaitInfo redo_get_io_event(int32 event_id)
 
 void redo_get_worker_statistic(uint32 *realNum, RedoWorkerStatsData *worker, uint32 workerLen)
 {
+    StaticAssertStmt(REDO_QUEUE_HIST_BUCKETS == SPSC_QUEUE_HIST_BUCKETS, "queue histogram size mismatch");
     PageRedoWorker *redoWorker = NULL;
     SpinLockAcquire(&(g_instance.comm_cxt.predo_cxt.destroy_lock));
     if (g_dispatcher == NULL) {
@@ -2111,6 +2112,19 @@ void redo_get_worker_statistic(uint32 *realNum, RedoWorkerStatsData *worker, uin
         worker[i].queue_usage = SPSCGetQueueCount(redoWorker->queue);
         worker[i].queue_max_usage = (uint32)(pg_atomic_read_u32(&((redoWorker->queue)->maxUsage)));
         worker[i].redo_rec_count = (uint32)(pg_atomic_read_u64(&((redoWorker->queue)->totalCnt)));
+        worker[i].prefetch_count = pg_atomic_read_u64(&redoWorker->prefetchCount);
+        worker[i].prefetch_skip_count = pg_atomic_read_u64(&redoWorker->prefetchSkipCount);
+        worker[i].prefetch_ptr = pg_atomic_read_u64(&redoWorker->prefetchLsn);
+
+        PageRedoPipeline *line = &g_dispatcher->pageLines[i];
+        SPSCGetQueueHistogram(line->batchThd->queue, worker[i].queue_depth_hist, worker[i].queue_idle_wait_hist,
+                              worker[i].queue_full_wait_hist);
+        SPSCGetQueueHistogram(line->managerThd->queue, worker[i].queue_depth_hist, worker[i].queue_idle_wait_hist,
+                              worker[i].queue_full_wait_hist);
+        for (uint32 j = 0; j < line->redoThdNum; j++) {
+            SPSCGetQueueHistogram(line->redoThd[j]->queue, worker[i].queue_depth_hist,
+                                  worker[i].queue_idle_wait_hist, worker[i].queue_full_wait_hist);
+        }
     }
     SpinLockRelease(&(g_instance.comm_cxt.predo_cxt.destroy_lock));
 }
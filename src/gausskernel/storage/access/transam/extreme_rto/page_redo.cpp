@@ -49,6 +49,7 @@
 #include "storage/freespace.h"
 #include "storage/smgr/smgr.h"
 #include "storage/smgr/relfilenode_hash.h"
+#include "storage/page_compression.h"
 #include "storage/standby.h"
 #include "storage/pmsignal.h"
 #include "utils/guc.h"
@@ -111,6 +112,9 @@ RedoItem g_cleanInvalidPageMark;
 
 static const int PAGE_REDO_WORKER_ARG = 3;
 static const int REDO_SLEEP_50US = 50;
+/* blocks the batch redo thread remembers having prefetched, a power of 2 */
+static const uint32 REDO_PREFETCH_RECENT_NUM = 1024;
+static const uint32 REDO_DISTRIBUTE_BATCH_NUM = 32;
 static const int REDO_SLEEP_100US = 100;
 
 static void ApplySinglePageRecord(RedoItem *);
@@ -230,6 +234,10 @@ PageRedoWorker *CreateWorker(uint32 id)
     worker->parseManager.parsebuffers = NULL;
     worker->remoteReadPageNum = 0;
     worker->badPageHashTbl = BadBlockHashTblCreate();
+    worker->prefetchRecent = NULL;
+    pg_atomic_init_u64(&worker->prefetchCount, 0);
+    pg_atomic_init_u64(&worker->prefetchSkipCount, 0);
+    pg_atomic_init_u64(&worker->prefetchLsn, InvalidXLogRecPtr);
     return worker;
 }
 
@@ -487,6 +495,101 @@ void SubRefRecord(void *rec)
     }
 }
 
+/*
+ * Close the files the lookahead stage opened for relations this record
+ * drops, so that they are not held open after the page redo workers unlink
+ * them.  Records dropping relations are dispatched to every batch redo
+ * thread, ahead of the workers that apply them.
+ */
+static void BatchRedoPrefetchCloseDropped(XLogReaderState *record)
+{
+    int nrels = 0;
+    ColFileNode *xnodes = NULL;
+    bool compress = false;
+
+    if (IsDataBaseDrop(record) || IsTableSpaceDrop(record)) {
+        smgrcloseall();
+        return;
+    }
+    if (XLogRecGetRmid(record) != RM_XACT_ID) {
+        return;
+    }
+
+    XactGetRelFiles(record, &xnodes, &nrels, &compress);
+    for (int i = 0; i < nrels; i++) {
+        ColFileNode node;
+        RelFileNodeBackend rbnode;
+        if (compress) {
+            ColFileNodeFullCopy(&node, xnodes + i);
+        } else {
+            ColFileNodeCopy(&node, ((ColFileNodeRel *)xnodes) + i);
+        }
+        rbnode.node = node.filenode;
+        rbnode.backend = InvalidBackendId;
+        smgrclosenode(rbnode);
+    }
+}
+
+/*
+ * Lookahead stage of the pipeline: the batch redo thread asks the kernel to
+ * read the blocks a record references before the page redo workers, two
+ * queues further down, get to apply it.  Blocks restored from a full-page
+ * image or initialized by redo are never read, and blocks that are in shared
+ * buffers already or were prefetched recently are skipped.
+ */
+static void BatchRedoPrefetchBlocks(XLogReaderState *record)
+{
+    PageRedoWorker *worker = g_redoWorker;
+    uint64 issued = 0;
+    uint64 skipped = 0;
+
+    /* also with prefetch off, for files opened before it was turned off */
+    BatchRedoPrefetchCloseDropped(record);
+    if (!u_sess->attr.attr_storage.recovery_prefetch) {
+        return;
+    }
+
+    if (worker->prefetchRecent == NULL) {
+        worker->prefetchRecent = (BufferTag *)palloc0(sizeof(BufferTag) * REDO_PREFETCH_RECENT_NUM);
+    }
+
+    for (int i = 0; i <= record->max_block_id; i++) {
+        DecodedBkpBlock *block = &record->blocks[i];
+        BufferTag tag;
+
+        if (!block->in_use) {
+            continue;
+        }
+        if (block->has_image || (block->flags & BKPBLOCK_WILL_INIT) || IsSegmentFileNode(block->rnode) ||
+            IS_COMPRESSED_RNODE(block->rnode, block->forknum)) {
+            skipped++;
+            continue;
+        }
+
+        INIT_BUFFERTAG(tag, block->rnode, block->forknum, block->blkno);
+        BufferTag *recent = &worker->prefetchRecent[BufTableHashCode(&tag) & (REDO_PREFETCH_RECENT_NUM - 1)];
+        if (BUFFERTAGS_EQUAL(*recent, tag)) {
+            skipped++;
+            continue;
+        }
+        *recent = tag;
+
+        if (PrefetchBufferWithoutRelcache(block->rnode, block->forknum, block->blkno)) {
+            issued++;
+        } else {
+            skipped++;
+        }
+    }
+
+    if (issued > 0) {
+        (void)pg_atomic_add_fetch_u64(&worker->prefetchCount, issued);
+    }
+    if (skipped > 0) {
+        (void)pg_atomic_add_fetch_u64(&worker->prefetchSkipCount, skipped);
+    }
+    pg_atomic_write_u64(&worker->prefetchLsn, record->EndRecPtr);
+}
+
 bool BatchRedoParseItemAndDispatch(RedoItem *item)
 {
     uint32 blockNum = 0;
@@ -572,6 +675,7 @@ bool BatchRedoDistributeItems(void **eleArry, uint32 eleNum)
             UpdateRecordGlobals(item, g_redoWorker->standbyState);
             CountAndGetRedoTime(g_redoWorker->timeCostList[TIME_COST_STEP_3],
                 g_redoWorker->timeCostList[TIME_COST_STEP_4]);
+            BatchRedoPrefetchBlocks(&item->record);
             do {
                 parsecomplete = BatchRedoParseItemAndDispatch(item);
                 RedoInterruptCallBack();
@@ -606,6 +710,14 @@ void BatchRedoMain()
         GetRedoStartTime(g_redoWorker->timeCostList[TIME_COST_STEP_1]);
     }
 
+    uint64 prefetched = pg_atomic_read_u64(&g_redoWorker->prefetchCount);
+    uint64 prefetchSkipped = pg_atomic_read_u64(&g_redoWorker->prefetchSkipCount);
+    if (prefetched + prefetchSkipped > 0) {
+        ereport(LOG, (errmodule(MOD_REDO), errcode(ERRCODE_LOG),
+                      errmsg("batch redo worker id %u prefetched %lu blocks, skipped %lu block references",
+                             g_redoWorker->id, prefetched, prefetchSkipped)));
+    }
+
     RedoThrdWaitForExit(g_redoWorker);
     XLogParseBufferDestoryFunc(&(g_redoWorker->parseManager));
 }
@@ -646,16 +758,30 @@ void RedoPageManagerDistributeBlockRecord(HTAB *redoItemHash, XLogRecParseState
     HASH_SEQ_STATUS status;
     RedoItemHashEntry *redoItemEntry = NULL;
     HTAB *curMap = redoItemHash;
+    void *batch[MAX_REDO_WORKERS_PER_PARSE][REDO_DISTRIBUTE_BATCH_NUM];
+    uint32 batchNum[MAX_REDO_WORKERS_PER_PARSE] = {0};
+    Assert(WorkerNumPerMng <= MAX_REDO_WORKERS_PER_PARSE);
     hash_seq_init(&status, curMap);
 
+    /* hand the items over in batches, so each worker queue is published and woken once per batch */
     while ((redoItemEntry = (RedoItemHashEntry *)hash_seq_search(&status)) != NULL) {
         uint32 workId = GetWorkerId(&redoItemEntry->redoItemTag, WorkerNumPerMng);
-        AddPageRedoItem(myRedoLine->redoThd[workId], redoItemEntry->head);
+        batch[workId][batchNum[workId]++] = redoItemEntry->head;
+        if (batchNum[workId] == REDO_DISTRIBUTE_BATCH_NUM) {
+            AddPageRedoItems(myRedoLine->redoThd[workId], batch[workId], batchNum[workId]);
+            batchNum[workId] = 0;
+        }
 
         if (hash_search(curMap, (void *)&redoItemEntry->redoItemTag, HASH_REMOVE, NULL) == NULL)
             ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("hash table corrupted")));
     }
 
+    for (uint32 i = 0; i < WorkerNumPerMng; ++i) {
+        if (batchNum[i] > 0) {
+            AddPageRedoItems(myRedoLine->redoThd[i], batch[i], batchNum[i]);
+        }
+    }
+
     if (parsestate != NULL) {
         RedoPageManagerDistributeToAllOneBlock(parsestate);
     }
@@ -2669,6 +2795,12 @@ void AddPageRedoItem(PageRedoWorker *worker, void *item)
     SPSCBlockingQueuePut(worker->queue, item);
 }
 
+/* Run from the page redo manager thread. */
+void AddPageRedoItems(PageRedoWorker *worker, void **items, uint32 num)
+{
+    SPSCBlockingQueuePutN(worker->queue, items, num);
+}
+
 /* Run from the dispatcher thread. */
 bool SendPageRedoEndMark(PageRedoWorker *worker)
 {
@@ -36,8 +36,18 @@
 
 #include "access/extreme_rto/posix_semaphore.h"
 
+/* sem_clockwait() appeared in glibc 2.30 */
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 30)
+#define HAVE_SEM_CLOCKWAIT
+#endif
+#endif
+
 namespace extreme_rto {
 
+static const long USECS_PER_SEC = 1000000L;
+static const long NSECS_PER_USEC = 1000L;
+
 /*
  * PosixSemaphoreInit
  *   -- Initialize a semaphore with the specified initial value.  The
@@ -89,6 +99,63 @@ void PosixSemaphoreWait(PosixSemaphore *sem)
         ereport(FATAL, (errmodule(MOD_REDO), errcode(ERRCODE_LOG), errmsg("sem_wait failed: %m")));
 }
 
+/* Set *ts to timeoutUs microseconds from now on the given clock. */
+static void PosixSemaphoreDeadline(clockid_t clock, long timeoutUs, struct timespec *ts)
+{
+    if (clock_gettime(clock, ts) != 0)
+        ereport(FATAL, (errmodule(MOD_REDO), errcode(ERRCODE_LOG), errmsg("clock_gettime failed: %m")));
+    ts->tv_sec += timeoutUs / USECS_PER_SEC;
+    ts->tv_nsec += (timeoutUs % USECS_PER_SEC) * NSECS_PER_USEC;
+    if (ts->tv_nsec >= USECS_PER_SEC * NSECS_PER_USEC) {
+        ts->tv_sec++;
+        ts->tv_nsec -= USECS_PER_SEC * NSECS_PER_USEC;
+    }
+}
+
+/*
+ * PosixSemaphoreTimedWait
+ *   -- Decrement a semaphore, blocking at most timeoutUs microseconds.
+ *
+ *      The deadline is taken on CLOCK_MONOTONIC, so that a step of the wall
+ *      clock neither stretches nor cuts short the wait.  Without
+ *      sem_clockwait(), sem_timedwait() is given what is left of it as a
+ *      CLOCK_REALTIME deadline, and called again if it times out early.
+ *
+ * @in  sem       - The semaphore to decrement.
+ * @in  timeoutUs - The maximum time to wait, in microseconds.
+ * @return true if the semaphore was decremented, false on timeout or signal.
+ */
+bool PosixSemaphoreTimedWait(PosixSemaphore *sem, long timeoutUs)
+{
+    struct timespec deadline;
+
+    PosixSemaphoreDeadline(CLOCK_MONOTONIC, timeoutUs, &deadline);
+#ifdef HAVE_SEM_CLOCKWAIT
+    if (sem_clockwait(&sem->semaphore, CLOCK_MONOTONIC, &deadline) == 0)
+        return true;
+#else
+    for (;;) {
+        struct timespec now;
+        struct timespec realDeadline;
+        long leftUs;
+
+        if (clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+            ereport(FATAL, (errmodule(MOD_REDO), errcode(ERRCODE_LOG), errmsg("clock_gettime failed: %m")));
+        leftUs = (deadline.tv_sec - now.tv_sec) * USECS_PER_SEC + (deadline.tv_nsec - now.tv_nsec) / NSECS_PER_USEC;
+        if (leftUs <= 0)
+            return false;
+        PosixSemaphoreDeadline(CLOCK_REALTIME, leftUs, &realDeadline);
+        if (sem_timedwait(&sem->semaphore, &realDeadline) == 0)
+            return true;
+        if (errno != ETIMEDOUT)
+            break;
+    }
+#endif
+    if (errno != ETIMEDOUT && errno != EINTR)
+        ereport(FATAL, (errmodule(MOD_REDO), errcode(ERRCODE_LOG), errmsg("sem_timedwait failed: %m")));
+    return false;
+}
+
 /*
  * PosixSemaphorePost
  *   -- Increment a semaphore.
@@ -21,6 +21,11 @@
  *      This structure is limited to Single-Producer/Single-Consumer, so the
  *      internal data can be accesses without locks.
  *
+ *      An empty queue is waited on by spinning for an adaptive number of
+ *      rounds and then sleeping on a semaphore with a short timeout.  The
+ *      producer only posts the semaphore when the consumer has announced it
+ *      is going to sleep, so a busy pipeline never makes a system call.
+ *
  * IDENTIFICATION
  *    src/gausskernel/storage/access/transam/extreme_rto/spsc_blocking_queue.cpp
  *
@@ -33,6 +38,8 @@
 #include "knl/knl_variable.h"
 #include "utils/atomic.h"
 #include "utils/palloc.h"
+#include "utils/timestamp.h"
+#include "storage/lock/s_lock.h"
 
 #include "access/extreme_rto/spsc_blocking_queue.h"
 #include "access/extreme_rto/page_redo.h"
@@ -50,6 +57,10 @@ namespace extreme_rto {
 const uint32 MAX_REDO_QUE_TAKE_DELAY = 200; /* 100 us */
 const uint32 MAX_REDO_QUE_IDEL_TAKE_DELAY = 1000;
 const uint32 SLEEP_COUNT_QUE_TAKE = 0xFFF;
+const uint32 MIN_SPIN_COUNT_QUE_TAKE = 0x3F;
+const uint32 MAX_SPIN_COUNT_QUE_TAKE = 0xFFFF;
+const uint32 SPIN_COUNT_QUE_TAKE_STEP = 0x100;
+const uint32 QUE_WAIT_HIST_UNIT = 16; /* us */
 
 const int QUEUE_CAPACITY_MIN_LIMIT = 2;
 
@@ -73,24 +84,73 @@ SPSCBlockingQueue *SPSCBlockingQueueCreate(uint32 capacity, CallBackFunc func)
     queue->maxUsage = 0;
     queue->totalCnt = 0;
     queue->callBackFunc = func;
+    queue->spinLimit = SLEEP_COUNT_QUE_TAKE;
+    pg_atomic_init_u32(&queue->consumerWaiting, 0);
+    PosixSemaphoreInit(&queue->wakeup, 0);
     return queue;
 }
 
 void SPSCBlockingQueueDestroy(SPSCBlockingQueue *queue)
 {
+    PosixSemaphoreDestroy(&queue->wakeup);
     pfree(queue);
 }
 
-bool SPSCBlockingQueuePut(SPSCBlockingQueue *queue, void *element)
+static inline void SPSCHistAdd(pg_atomic_uint64 *hist, uint64 value)
+{
+    uint32 bucket = 0;
+    while (value != 0 && bucket < SPSC_QUEUE_HIST_BUCKETS - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    /* every histogram has a single writer, no need for atomic increment */
+    pg_atomic_write_u64(&hist[bucket], pg_atomic_read_u64(&hist[bucket]) + 1);
+}
+
+/* Wait until n slots are free, return the tail observed. Run from the producer. */
+static uint32 SPSCBlockingQueueWaitSpace(SPSCBlockingQueue *queue, uint32 head, uint32 n)
 {
-    uint32 head = pg_atomic_read_u32(&queue->writeHead);
     uint32 tail = pg_atomic_read_u32(&queue->readTail);
-    while (SPACE(head, tail, queue->mask) == 0) {
+    if (SPACE(head, tail, queue->mask) >= n) {
+        return tail;
+    }
+
+    TimestampTz start = GetCurrentTimestamp();
+    do {
         if (queue->callBackFunc != NULL) {
             queue->callBackFunc();
         }
         tail = pg_atomic_read_u32(&queue->readTail);
+    } while (SPACE(head, tail, queue->mask) < n);
+    SPSCHistAdd(queue->fullWaitHist, (uint64)(GetCurrentTimestamp() - start) / QUE_WAIT_HIST_UNIT);
+    return tail;
+}
+
+/* Make elements written before head visible and wake the consumer if it sleeps. */
+static inline void SPSCBlockingQueuePublish(SPSCBlockingQueue *queue, uint32 head)
+{
+    /* Make sure the index is updated after the buffer has been written. */
+    pg_write_barrier();
+
+    pg_atomic_write_u32(&queue->writeHead, head);
+
+    /*
+     * Pairs with the barrier in SPSCBlockingQueueSleep(): either the consumer
+     * sees the new head before sleeping, or we see it announced the sleep.
+     */
+    pg_memory_barrier();
+    if (pg_atomic_read_u32(&queue->consumerWaiting) != 0) {
+        uint32 expected = 1;
+        if (pg_atomic_compare_exchange_u32(&queue->consumerWaiting, &expected, 0)) {
+            PosixSemaphorePost(&queue->wakeup);
+        }
     }
+}
+
+bool SPSCBlockingQueuePut(SPSCBlockingQueue *queue, void *element)
+{
+    uint32 head = pg_atomic_read_u32(&queue->writeHead);
+    uint32 tail = SPSCBlockingQueueWaitSpace(queue, head, 1);
 
     /*
      * Make sure the following write to the buffer happens after the read
@@ -104,16 +164,43 @@ bool SPSCBlockingQueuePut(SPSCBlockingQueue *queue, void *element)
     if (tmpCnt > queue->maxUsage) {
         pg_atomic_write_u32(&queue->maxUsage, tmpCnt);
     }
+    SPSCHistAdd(queue->depthHist, tmpCnt);
 
     queue->buffer[head] = element;
 
-    /* Make sure the index is updated after the buffer has been written. */
-    pg_write_barrier();
-
-    pg_atomic_write_u32(&queue->writeHead, (head + 1) & queue->mask);
+    SPSCBlockingQueuePublish(queue, (head + 1) & queue->mask);
     return true;
 }
 
+/*
+ * Put n elements and publish them with a single head update, so the consumer
+ * is woken at most once for the whole batch.
+ */
+void SPSCBlockingQueuePutN(SPSCBlockingQueue *queue, void **elements, uint32 n)
+{
+    while (n > 0) {
+        uint32 batch = Min(n, queue->capacity - 1);
+        uint32 head = pg_atomic_read_u32(&queue->writeHead);
+        uint32 tail = SPSCBlockingQueueWaitSpace(queue, head, batch);
+
+        /* See SPSCBlockingQueuePut() */
+        pg_memory_barrier();
+        uint32 tmpCnt = COUNT(head, tail, queue->mask);
+        if (tmpCnt + batch > queue->maxUsage) {
+            pg_atomic_write_u32(&queue->maxUsage, tmpCnt + batch);
+        }
+        SPSCHistAdd(queue->depthHist, tmpCnt);
+
+        for (uint32 i = 0; i < batch; i++) {
+            queue->buffer[(head + i) & queue->mask] = elements[i];
+        }
+
+        SPSCBlockingQueuePublish(queue, (head + batch) & queue->mask);
+        elements += batch;
+        n -= batch;
+    }
+}
+
 uint32 SPSCGetQueueCount(SPSCBlockingQueue *queue)
 {
     uint32 head = pg_atomic_read_u32(&queue->writeHead);
@@ -121,31 +208,68 @@ uint32 SPSCGetQueueCount(SPSCBlockingQueue *queue)
     return (COUNT(head, tail, queue->mask));
 }
 
-void *SPSCBlockingQueueTake(SPSCBlockingQueue *queue)
+/*
+ * Sleep until the producer publishes an element or the timeout expires.
+ * Run from the consumer.
+ */
+static void SPSCBlockingQueueSleep(SPSCBlockingQueue *queue, uint32 tail)
 {
-    uint32 head;
-    uint32 tail;
+    long sleeptime = t_thrd.page_redo_cxt.sleep_long ? MAX_REDO_QUE_IDEL_TAKE_DELAY : MAX_REDO_QUE_TAKE_DELAY;
+
+    pg_atomic_write_u32(&queue->consumerWaiting, 1);
+    /* Pairs with the barrier in SPSCBlockingQueuePublish(). */
+    pg_memory_barrier();
+    if (COUNT(pg_atomic_read_u32(&queue->writeHead), tail, queue->mask) == 0) {
+        TimestampTz start = GetCurrentTimestamp();
+        (void)PosixSemaphoreTimedWait(&queue->wakeup, sleeptime);
+        SPSCHistAdd(queue->idleWaitHist, (uint64)(GetCurrentTimestamp() - start) / QUE_WAIT_HIST_UNIT);
+    }
+    pg_atomic_write_u32(&queue->consumerWaiting, 0);
+}
+
+/*
+ * Wait until the queue is not empty, return the head observed.  The number of
+ * spins before sleeping adapts like spins_per_delay of s_lock: it grows while
+ * elements keep arriving during the spin and shrinks when we end up sleeping.
+ */
+static uint32 SPSCBlockingQueueWaitElement(SPSCBlockingQueue *queue, uint32 tail)
+{
+    uint32 head = pg_atomic_read_u32(&queue->writeHead);
+    if (COUNT(head, tail, queue->mask) != 0) {
+        t_thrd.page_redo_cxt.sleep_long = false;
+        return head;
+    }
+
     uint32 count = 0;
-    long sleeptime;
-    tail = pg_atomic_read_u32(&queue->readTail);
-    head = pg_atomic_read_u32(&queue->writeHead);
-    while (COUNT(head, tail, queue->mask) == 0) {
-        ++count;
-        /* here we sleep, let the cpu to do other important work */
-        if ((count & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
-            if (t_thrd.page_redo_cxt.sleep_long)
-                sleeptime = MAX_REDO_QUE_IDEL_TAKE_DELAY;
-            else
-                sleeptime = MAX_REDO_QUE_TAKE_DELAY;
-            pg_usleep(sleeptime);
+    bool slept = false;
+    do {
+        if (++count >= queue->spinLimit) {
+            SPSCBlockingQueueSleep(queue, tail);
+            slept = true;
+            count = 0;
+        } else {
+            SPIN_DELAY();
         }
         if (queue->callBackFunc != NULL) {
             queue->callBackFunc();
         }
         head = pg_atomic_read_u32(&queue->writeHead);
-    }
+    } while (COUNT(head, tail, queue->mask) == 0);
 
+    if (slept) {
+        queue->spinLimit = Max(queue->spinLimit >> 1, MIN_SPIN_COUNT_QUE_TAKE);
+    } else {
+        queue->spinLimit = Min(queue->spinLimit + SPIN_COUNT_QUE_TAKE_STEP, MAX_SPIN_COUNT_QUE_TAKE);
+    }
     t_thrd.page_redo_cxt.sleep_long = false;
+    return head;
+}
+
+void *SPSCBlockingQueueTake(SPSCBlockingQueue *queue)
+{
+    uint32 tail;
+    tail = pg_atomic_read_u32(&queue->readTail);
+    (void)SPSCBlockingQueueWaitElement(queue, tail);
     /* Make sure the buffer is read after the index. */
     pg_read_barrier();
 
@@ -162,27 +286,9 @@ bool SPSCBlockingQueueGetAll(SPSCBlockingQueue *queue, void ***eleArry, uint32 *
 {
     uint32 head;
     uint32 tail;
-    uint32 count = 0;
-    long sleeptime;
 
     tail = pg_atomic_read_u32(&queue->readTail);
-    head = pg_atomic_read_u32(&queue->writeHead);
-    while (COUNT(head, tail, queue->mask) == 0) {
-        ++count;
-        /* here we sleep, let the cpu to do other important work */
-        if ((count & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
-            if (t_thrd.page_redo_cxt.sleep_long)
-                sleeptime = MAX_REDO_QUE_IDEL_TAKE_DELAY;
-            else
-                sleeptime = MAX_REDO_QUE_TAKE_DELAY;
-            pg_usleep(sleeptime);
-        }
-        if (queue->callBackFunc != NULL) {
-            queue->callBackFunc();
-        }
-        head = pg_atomic_read_u32(&queue->writeHead);
-    }
-    t_thrd.page_redo_cxt.sleep_long = false;
+    head = SPSCBlockingQueueWaitElement(queue, tail);
     /* Make sure the buffer is read after the index. */
     pg_read_barrier();
     head = head & (queue->mask);
@@ -231,28 +337,9 @@ bool SPSCBlockingQueueIsEmpty(SPSCBlockingQueue *queue)
 
 void *SPSCBlockingQueueTop(SPSCBlockingQueue *queue)
 {
-    uint32 head;
     uint32 tail;
-    uint32 count = 0;
-    long sleeptime;
     tail = pg_atomic_read_u32(&queue->readTail);
-    head = pg_atomic_read_u32(&queue->writeHead);
-    while (COUNT(head, tail, queue->mask) == 0) {
-        ++count;
-        /* here we sleep, let the cpu to do other important work */
-        if ((count & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
-            if (t_thrd.page_redo_cxt.sleep_long)
-                sleeptime = MAX_REDO_QUE_IDEL_TAKE_DELAY;
-            else
-                sleeptime = MAX_REDO_QUE_TAKE_DELAY;
-            pg_usleep(sleeptime);
-        }
-        if (queue->callBackFunc != NULL) {
-            queue->callBackFunc();
-        }
-        head = pg_atomic_read_u32(&queue->writeHead);
-    }
-    t_thrd.page_redo_cxt.sleep_long = false;
+    (void)SPSCBlockingQueueWaitElement(queue, tail);
     pg_read_barrier();
     void *elem = queue->buffer[tail];
     return elem;
@@ -276,6 +363,16 @@ void SPSCBlockingQueuePop(SPSCBlockingQueue *queue)
     pg_atomic_write_u32(&queue->readTail, (tail + 1) & queue->mask);
 }
 
+/* Add the histograms of the queue to the given arrays of SPSC_QUEUE_HIST_BUCKETS. */
+void SPSCGetQueueHistogram(SPSCBlockingQueue *queue, uint64 *depthHist, uint64 *idleWaitHist, uint64 *fullWaitHist)
+{
+    for (uint32 i = 0; i < SPSC_QUEUE_HIST_BUCKETS; i++) {
+        depthHist[i] += pg_atomic_read_u64(&queue->depthHist[i]);
+        idleWaitHist[i] += pg_atomic_read_u64(&queue->idleWaitHist[i]);
+        fullWaitHist[i] += pg_atomic_read_u64(&queue->fullWaitHist[i]);
+    }
+}
+
 void DumpQueue(const SPSCBlockingQueue *queue)
 {
     ereport(LOG, (errmodule(MOD_REDO), errcode(ERRCODE_LOG),
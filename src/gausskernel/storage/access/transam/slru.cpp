@@ -58,6 +58,7 @@
 #include "access/transam.h"
 #include "access/xlog.h"
 #include "access/csnlog.h"
+#include "storage/barrier.h"
 #include "storage/smgr/fd.h"
 #include "storage/shmem.h"
 #include "miscadmin.h"
@@ -116,19 +117,81 @@ static bool SlruPhysicalWritePage(SlruCtl ctl, int64 pageno, int slotno, SlruFlu
 static void SlruReportIOError(SlruCtl ctl, int64 pageno, TransactionId xid);
 static int SlruSelectLRUPage(SlruCtl ctl, int64 pageno);
 
+#define SlruSlotHint(shared, pageno) ((shared)->page_slot_hint[(uint64)(pageno) % (uint64)(shared)->num_slots])
+
+/*
+ * Bracket giving slotno a new page, see page_generation.  Control lock must
+ * be held exclusively.  A change abandoned by an error leaves the generation
+ * odd, so the next one only has to move it on.
+ */
+static inline void SlruBeginSlotChange(SlruShared shared, int slotno)
+{
+    shared->page_generation[slotno] += (shared->page_generation[slotno] & 1) ? 2 : 1;
+    pg_write_barrier();
+}
+
+static inline void SlruEndSlotChange(SlruShared shared, int slotno)
+{
+    pg_write_barrier();
+    shared->page_generation[slotno]++;
+}
+
+/*
+ * Bank pageno has to live in.  Partitioned SLRUs such as CLOG only hold every
+ * n-th page in each partition, so the page number is hashed rather than taken
+ * modulo num_banks, which would leave most banks unused.
+ */
+static inline int SlruPageBank(SlruShared shared, int64 pageno)
+{
+    return (int)((((uint64)pageno * UINT64CONST(0x9E3779B97F4A7C15)) >> 32) % (uint64)shared->num_banks);
+}
+
+/* First slot of bank, and the one past its last slot */
+static inline int SlruBankStart(SlruShared shared, int bank)
+{
+    return (int)((int64)bank * shared->num_slots / shared->num_banks);
+}
+
+static inline int SlruBankEnd(SlruShared shared, int bank)
+{
+    return SlruBankStart(shared, bank + 1);
+}
+
+/*
+ * Return the slot holding pageno in any state but EMPTY, or -1 if there is
+ * none.  The hinted slot is tried before scanning the page's bank.
+ *
+ * Control lock must be held, shared is enough.
+ */
+static inline int SlruLookupSlot(SlruShared shared, int64 pageno)
+{
+    int slotno = SlruSlotHint(shared, pageno);
+    int bank = SlruPageBank(shared, pageno);
+    int bankEnd = SlruBankEnd(shared, bank);
+
+    if (shared->page_number[slotno] == pageno && shared->page_status[slotno] != SLRU_PAGE_EMPTY)
+        return slotno;
+
+    for (slotno = SlruBankStart(shared, bank); slotno < bankEnd; slotno++) {
+        if (shared->page_number[slotno] == pageno && shared->page_status[slotno] != SLRU_PAGE_EMPTY) {
+            SlruSlotHint(shared, pageno) = slotno;
+            return slotno;
+        }
+    }
+    return -1;
+}
+
 static inline int execSimpleLruReadPageReadOnly(SlruCtl ctl, int64 pageno, TransactionId xid)
 {
     SlruShared shared = ctl->shared;
     int slotno;
 
     /* See if page is already in a buffer */
-    for (slotno = 0; slotno < shared->num_slots; slotno++) {
-        if (shared->page_number[slotno] == pageno && shared->page_status[slotno] != SLRU_PAGE_EMPTY &&
-            shared->page_status[slotno] != SLRU_PAGE_READ_IN_PROGRESS) {
-            /* See comments for SlruRecentlyUsed macro */
-            SlruRecentlyUsed(shared, slotno);
-            return slotno;
-        }
+    slotno = SlruLookupSlot(shared, pageno);
+    if (slotno >= 0 && shared->page_status[slotno] != SLRU_PAGE_READ_IN_PROGRESS) {
+        /* See comments for SlruRecentlyUsed macro */
+        SlruRecentlyUsed(shared, slotno);
+        return slotno;
     }
     /* No luck, so switch to normal exclusive lock and do regular read */
     LWLockRelease(shared->control_lock);
@@ -149,6 +212,8 @@ Size SimpleLruShmemSize(int nslots, int nlsns)
     sz += MAXALIGN(nslots * sizeof(int64));          /* page_number[] */
     sz += MAXALIGN(nslots * sizeof(int));            /* page_lru_count[] */
     sz += MAXALIGN(nslots * sizeof(LWLock *));       /* buffer_locks[] */
+    sz += MAXALIGN(nslots * sizeof(uint64));         /* page_generation[] */
+    sz += MAXALIGN(nslots * sizeof(int));            /* page_slot_hint[] */
 
     if (nlsns > 0)
         sz += MAXALIGN(nslots * nlsns * sizeof(XLogRecPtr)); /* group_lsn[] */
@@ -178,6 +243,7 @@ void SimpleLruInit(SlruCtl ctl, const char *name, int trancheId, int nslots, int
 
         shared->control_lock = ctllock;
         shared->num_slots = nslots;
+        shared->num_banks = Max(nslots / SLRU_BANK_SIZE, 1);
         shared->lsn_groups_per_page = nlsns;
         shared->cur_lru_count = 0;
         shared->force_check_first_xid = false;
@@ -197,6 +263,10 @@ void SimpleLruInit(SlruCtl ctl, const char *name, int trancheId, int nslots, int
         offset += MAXALIGN(nslots * sizeof(int));
         shared->buffer_locks = (LWLock **)(ptr + offset);
         offset += MAXALIGN(nslots * sizeof(LWLock *));
+        shared->page_generation = (uint64 *)(ptr + offset);
+        offset += MAXALIGN(nslots * sizeof(uint64));
+        shared->page_slot_hint = (int *)(ptr + offset);
+        offset += MAXALIGN(nslots * sizeof(int));
 
         if (nlsns > 0) {
             shared->group_lsn = (XLogRecPtr *)(ptr + offset);
@@ -211,6 +281,8 @@ void SimpleLruInit(SlruCtl ctl, const char *name, int trancheId, int nslots, int
             shared->page_dirty[slotno] = false;
             shared->page_lru_count[slotno] = 0;
             shared->buffer_locks[slotno] = LWLockAssign(trancheId);
+            shared->page_generation[slotno] = 0;
+            shared->page_slot_hint[slotno] = slotno;
             ptr += BLCKSZ;
         }
     } else
@@ -222,6 +294,7 @@ void SimpleLruInit(SlruCtl ctl, const char *name, int trancheId, int nslots, int
      */
     ctl->shared = shared;
     ctl->do_fsync = true; /* default behavior */
+    ctl->read_wait_event = WAIT_EVENT_SLRU_READ;
     rc = strncpy_s(ctl->dir, sizeof(ctl->dir), subdir, strlen(subdir));
     securec_check(rc, "\0", "\0");
 }
@@ -277,9 +350,11 @@ int SimpleLruZeroPage(SlruCtl ctl, int64 pageno, bool *pBZeroPage)
                      errhint("Try it again.")));
 
         /* Mark the slot as containing this page */
+        SlruBeginSlotChange(shared, slotno);
         shared->page_number[slotno] = pageno;
         shared->page_status[slotno] = SLRU_PAGE_VALID;
         shared->page_dirty[slotno] = true;
+        SlruSlotHint(shared, pageno) = slotno;
         SlruRecentlyUsed(shared, slotno);
 
         /* Set the buffer to zeroes */
@@ -288,6 +363,7 @@ int SimpleLruZeroPage(SlruCtl ctl, int64 pageno, bool *pBZeroPage)
 
         /* Set the LSNs for this new page to zero */
         SimpleLruZeroLSNs(ctl, slotno);
+        SlruEndSlotChange(shared, slotno);
 
         /* Assume this page is now the latest active page */
         shared->latest_page_number = pageno;
@@ -415,9 +491,11 @@ int SimpleLruReadPage(SlruCtl ctl, int64 pageno, bool write_ok, TransactionId xi
                                shared->page_status[slotno], shared->page_dirty[slotno], xid)));
 
         /* Mark the slot read-busy */
+        SlruBeginSlotChange(shared, slotno);
         shared->page_number[slotno] = pageno;
         shared->page_status[slotno] = SLRU_PAGE_READ_IN_PROGRESS;
         shared->page_dirty[slotno] = false;
+        SlruSlotHint(shared, pageno) = slotno;
 
         /* Acquire per-buffer lock (cannot deadlock, see notes at top) */
         (void)LWLockAcquire(shared->buffer_locks[slotno], LW_EXCLUSIVE);
@@ -447,6 +525,7 @@ int SimpleLruReadPage(SlruCtl ctl, int64 pageno, bool write_ok, TransactionId xi
                                shared->page_dirty[slotno], xid)));
 
         shared->page_status[slotno] = ok ? SLRU_PAGE_VALID : SLRU_PAGE_EMPTY;
+        SlruEndSlotChange(shared, slotno);
 
         LWLockRelease(shared->buffer_locks[slotno]);
 
@@ -497,6 +576,44 @@ int SimpleLruReadPage_ReadOnly_Locked(SlruCtl ctl, int64 pageno, TransactionId x
     return execSimpleLruReadPageReadOnly(ctl, pageno, xid);
 }
 
+/*
+ * Read the 8-byte entry at byte offset of page pageno without the control
+ * lock.  Only the slot hinted for the page is looked at.  Returns false if
+ * the page is not there or the slot changed pages meanwhile; the caller must
+ * then go through SimpleLruReadPage_ReadOnly.
+ *
+ * Entries may be updated in place under a shared control lock, so the value
+ * read is only meaningful for entries that do not change any more once they
+ * reach their final state, such as committed CSNs.
+ */
+bool SimpleLruReadEntry_NoLock(SlruCtl ctl, int64 pageno, int offset, uint64 *value)
+{
+    SlruShared shared = ctl->shared;
+    int slotno = SlruSlotHint(shared, pageno);
+    uint64 generation = shared->page_generation[slotno];
+
+    Assert(offset >= 0 && offset <= BLCKSZ - (int)sizeof(uint64) && offset % sizeof(uint64) == 0);
+
+    /* odd means the slot is being given a new page */
+    if (generation & 1)
+        return false;
+    pg_read_barrier();
+
+    if (shared->page_number[slotno] != pageno || (shared->page_status[slotno] != SLRU_PAGE_VALID &&
+                                                  shared->page_status[slotno] != SLRU_PAGE_WRITE_IN_PROGRESS))
+        return false;
+
+    *value = *(volatile uint64 *)(shared->page_buffer[slotno] + offset);
+    pg_read_barrier();
+
+    if (shared->page_generation[slotno] != generation)
+        return false;
+
+    /* See comments for SlruRecentlyUsed macro */
+    SlruRecentlyUsed(shared, slotno);
+    return true;
+}
+
 /*
  * Write a page from a shared buffer, if necessary.
  * Does nothing if the specified slot is not dirty.
@@ -705,7 +822,7 @@ static bool SlruPhysicalReadPage(SlruCtl ctl, int64 pageno, int slotno)
     }
 
     errno = 0;
-    pgstat_report_waitevent(WAIT_EVENT_SLRU_READ);
+    pgstat_report_waitevent(ctl->read_wait_event);
     if (pread(fd, shared->page_buffer[slotno], BLCKSZ, (off_t)offset) != BLCKSZ) {
         pgstat_report_waitevent(WAIT_EVENT_END);
         if (!t_thrd.xlog_cxt.InRecovery) {
@@ -1007,14 +1124,17 @@ static int SlruSelectLRUPage(SlruCtl ctl, int64 pageno)
         int best_invalid_slot = 0;        /* keep compiler quiet */
         int best_invalid_delta = -1;
         int64 best_invalid_page_number = 0; /* keep compiler quiet */
+        int bank = SlruPageBank(shared, pageno);
+        int bankEnd = SlruBankEnd(shared, bank);
 
         /* See if page already has a buffer assigned */
-        for (slotno = 0; slotno < shared->num_slots; slotno++) {
-            if (shared->page_number[slotno] == pageno && shared->page_status[slotno] != SLRU_PAGE_EMPTY)
-                return slotno;
-        }
+        slotno = SlruLookupSlot(shared, pageno);
+        if (slotno >= 0)
+            return slotno;
 
         /*
+         * Only the slots of the page's bank are candidates.
+         *
          * If we find any EMPTY slot, just select that one. Else choose a
          * victim page to replace.	We normally take the least recently used
          * valid page, but we will never take the slot containing
@@ -1042,7 +1162,7 @@ static int SlruSelectLRUPage(SlruCtl ctl, int64 pageno)
          * multiple pages with the same lru_count.
          */
         cur_count = (shared->cur_lru_count)++;
-        for (slotno = 0; slotno < shared->num_slots; slotno++) {
+        for (slotno = SlruBankStart(shared, bank); slotno < bankEnd; slotno++) {
             int this_delta;
             int64 this_page_number;
 
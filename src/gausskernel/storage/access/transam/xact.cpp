@@ -855,8 +855,15 @@ static void AssignTransactionId(TransactionState s)
 
         /*
          * ensure this test matches similar one in RecoverPreparedTransactions()
+         *
+         * A decoder streaming in-progress transactions needs every subxact to
+         * be known as a child of its toplevel before its first change is
+         * decoded, so report the assignment right away while one is active.
+         * The decoder only streams toplevel xids assigned after it showed up,
+         * and ours was, if the flag was set when we got our subxid.
          */
-        if (t_thrd.xact_cxt.nUnreportedXids >= PGPROC_MAX_CACHED_SUBXIDS || log_unknown_top) {
+        if (t_thrd.xact_cxt.nUnreportedXids >= PGPROC_MAX_CACHED_SUBXIDS || log_unknown_top ||
+            (XLogLogicalInfoActive() && ReplicationSlotsStreaming())) {
             xl_xact_assignment xlrec;
 
             /*
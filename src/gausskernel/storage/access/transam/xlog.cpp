@@ -6389,6 +6389,7 @@ void XLOGShmemInit(void)
     SpinLockInit(&t_thrd.shemem_ptr_cxt.XLogCtl->Insert.insertpos_lck);
 #endif
     SpinLockInit(&t_thrd.shemem_ptr_cxt.XLogCtl->info_lck);
+    pg_atomic_init_u64(&t_thrd.shemem_ptr_cxt.XLogCtl->minReplayWaitLSN, PG_UINT64_MAX);
     InitSharedLatch(&t_thrd.shemem_ptr_cxt.XLogCtl->recoveryWakeupLatch);
     InitSharedLatch(&t_thrd.shemem_ptr_cxt.XLogCtl->dataRecoveryLatch);
 
@@ -13859,7 +13860,7 @@ bool check_roach_start_backup(const char *slotName)
     return true;
 }
 
-static void CollectTableSpace(DIR *tblspcdir, List **tablespaces, StringInfo tblspc_mapfbuf, bool infotbssize)
+void CollectTableSpace(DIR *tblspcdir, List **tablespaces, StringInfo tblspc_mapfbuf, bool infotbssize)
 {
     struct dirent *de = NULL;
     tablespaceinfo *ti = NULL;
@@ -15883,6 +15884,51 @@ XLogRecPtr GetXLogReplayRecPtr(TimeLineID *targetTLI, XLogRecPtr *ReplayReadPtr)
     return recptr;
 }
 
+/* Lower XLogCtl->minReplayWaitLSN to lsn, unless it is lower already. */
+static void LowerMinReplayWaitLSN(XLogRecPtr lsn)
+{
+    XLogCtlData *xlogctl = t_thrd.shemem_ptr_cxt.XLogCtl;
+    uint64 curMin = pg_atomic_read_u64(&xlogctl->minReplayWaitLSN);
+
+    while (XLByteLT(lsn, curMin)) {
+        if (pg_atomic_compare_exchange_u64(&xlogctl->minReplayWaitLSN, &curMin, lsn)) {
+            break;
+        }
+    }
+}
+
+/*
+ * Set the latch of every backend in WaitForXLogReplay() whose target has been
+ * replayed, and recompute the lowest target still waited for.  The common case
+ * of nobody waiting costs a single atomic read.
+ */
+static void WakeupXLogReplayWaiters(XLogRecPtr endRecPtr)
+{
+    XLogCtlData *xlogctl = t_thrd.shemem_ptr_cxt.XLogCtl;
+    XLogRecPtr newMin = PG_UINT64_MAX;
+
+    if (XLByteLT(endRecPtr, pg_atomic_read_u64(&xlogctl->minReplayWaitLSN))) {
+        return;
+    }
+
+    /* waiters registering from now on lower the minimum again themselves */
+    (void)pg_atomic_exchange_u64(&xlogctl->minReplayWaitLSN, PG_UINT64_MAX);
+    for (uint32 i = 0; i < g_instance.proc_base->allProcCount; i++) {
+        volatile PGPROC *proc = g_instance.proc_base->allProcs[i];
+        XLogRecPtr waitLSN = proc->replayWaitLSN;
+
+        if (XLogRecPtrIsInvalid(waitLSN)) {
+            continue;
+        }
+        if (XLByteLE(waitLSN, endRecPtr)) {
+            SetLatch(&proc->procLatch);
+        } else {
+            newMin = Min(newMin, waitLSN);
+        }
+    }
+    LowerMinReplayWaitLSN(newMin);
+}
+
 void SetXLogReplayRecPtr(XLogRecPtr readRecPtr, XLogRecPtr endRecPtr)
 {
     bool isUpdated = false;
@@ -15898,6 +15944,7 @@ void SetXLogReplayRecPtr(XLogRecPtr readRecPtr, XLogRecPtr endRecPtr)
     SpinLockRelease(&xlogctl->info_lck);
     if (isUpdated) {
         RedoSpeedDiag(readRecPtr, endRecPtr);
+        WakeupXLogReplayWaiters(endRecPtr);
     }
     update_dirty_page_queue_rec_lsn(readRecPtr);
 #ifndef ENABLE_MULTIPLE_NODES
@@ -15911,6 +15958,74 @@ void SetXLogReplayRecPtr(XLogRecPtr readRecPtr, XLogRecPtr endRecPtr)
 #endif
 }
 
+/*
+ * Wait until redo on this hot standby has replayed WAL up to targetLSN, so a
+ * snapshot taken afterwards sees everything committed on the primary before
+ * it.  The redo thread advancing the replay position sets our latch, we poll
+ * only to notice promotion.  Raises an error if targetLSN is not reached
+ * within timeoutMs, so the client can run the query on the primary instead.
+ */
+void WaitForXLogReplay(XLogRecPtr targetLSN, int timeoutMs)
+{
+    const long recheckMs = 1000;
+    XLogRecPtr replayed = GetXLogReplayRecPtr(NULL);
+
+    if (XLByteLE(targetLSN, replayed) || !RecoveryInProgress()) {
+        return;
+    }
+
+    TimestampTz deadline = TimestampTzPlusMilliseconds(GetCurrentTimestamp(), timeoutMs);
+    WaitState oldStatus = pgstat_report_waitstatus(STATE_WAIT_XLOG_REPLAY);
+
+    PG_TRY();
+    {
+        for (;;) {
+            long secs;
+            int usecs;
+
+            ResetLatch(&t_thrd.proc->procLatch);
+
+            /* pairs with the read of minReplayWaitLSN in WakeupXLogReplayWaiters */
+            t_thrd.proc->replayWaitLSN = targetLSN;
+            pg_memory_barrier();
+            LowerMinReplayWaitLSN(targetLSN);
+
+            replayed = GetXLogReplayRecPtr(NULL);
+            if (XLByteLE(targetLSN, replayed) || !RecoveryInProgress()) {
+                break;
+            }
+
+            TimestampDifference(GetCurrentTimestamp(), deadline, &secs, &usecs);
+            long remainingMs = secs * MSECS_PER_SEC + usecs / USECS_PER_MSEC;
+            if (remainingMs <= 0) {
+                ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+                    errmsg("timed out waiting for replay of WAL up to %X/%X",
+                        (uint32)(targetLSN >> 32), (uint32)targetLSN),
+                    errdetail("WAL has been replayed up to %X/%X.", (uint32)(replayed >> 32), (uint32)replayed),
+                    errhint("Run the query on the primary, or increase standby_read_lsn_timeout.")));
+            }
+
+            int rc = WaitLatch(&t_thrd.proc->procLatch, WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
+                Min(remainingMs, recheckMs));
+            if (rc & WL_POSTMASTER_DEATH) {
+                ereport(FATAL, (errcode(ERRCODE_ADMIN_SHUTDOWN),
+                    errmsg("terminating connection due to unexpected postmaster exit")));
+            }
+            CHECK_FOR_INTERRUPTS();
+        }
+    }
+    PG_CATCH();
+    {
+        t_thrd.proc->replayWaitLSN = InvalidXLogRecPtr;
+        (void)pgstat_report_waitstatus(oldStatus);
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+
+    t_thrd.proc->replayWaitLSN = InvalidXLogRecPtr;
+    (void)pgstat_report_waitstatus(oldStatus);
+}
+
 void DumpXlogCtl()
 {
     ereport(LOG,
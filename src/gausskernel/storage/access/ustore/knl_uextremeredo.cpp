@@ -67,6 +67,7 @@ struct UpdateRedoTuples {
 struct UpdateRedoAffixLens {
     uint16 prefixlen;
     uint16 suffixlen;
+    char *delta; /* changed ranges of an inplace update, see UHeapComputeDeltaRanges */
 };
 
 static UHeapDiskTuple GetUHeapDiskTupleFromRedoData(char *data, Size *datalen,
@@ -741,6 +742,9 @@ Size UHeapXlogUpdateOperatorNewpage(UpdateRedoBuffers* buffers, void *recorddata
             xorCurxlogptr += sizeof(uint16);
             affixLens->suffixlen = *suffixlenPtr;
         }
+        if (flags & UREC_INPLACE_UPDATE_XOR_DELTA) {
+            affixLens->delta = xorCurxlogptr;
+        }
     } else {
         Size initPageXtraInfo = 0;
         if (isinit) {
@@ -803,7 +807,8 @@ Size UHeapXlogUpdateOperatorNewpage(UpdateRedoBuffers* buffers, void *recorddata
      * old tuple, and the data stored in the WAL record.
      */
 
-    bool onlyCopyDelta = (inplaceUpdate && oldtup->disk_tuple->t_hoff == xlhdr.t_hoff &&
+    bool copyDeltaRanges = (inplaceUpdate && (xlrec->flags & XLZ_UPDATE_DELTA_FROM_OLD) != 0);
+    bool onlyCopyDelta = copyDeltaRanges || (inplaceUpdate && oldtup->disk_tuple->t_hoff == xlhdr.t_hoff &&
         (newlen == oldtup->disk_tuple_size) && !blockInplaceUpdate);
     uint32 bitmaplen = 0;
     uint32 deltalen = 0;
@@ -814,7 +819,15 @@ Size UHeapXlogUpdateOperatorNewpage(UpdateRedoBuffers* buffers, void *recorddata
         newp = (char *)newtup + SizeOfUHeapDiskTupleData;
     }
 
-    if (affixLens->prefixlen > 0) {
+    if (copyDeltaRanges) {
+        /* bitmap [+ padding] [+ oid], then the new bytes of the changed ranges */
+        Assert(affixLens->delta != NULL && oldtup->disk_tuple->t_hoff == xlhdr.t_hoff);
+        bitmaplen = xlhdr.t_hoff - SizeOfUHeapDiskTupleData;
+        bitmapData = recdata;
+        deltaData = recdata + bitmaplen;
+        recdata = recdataEnd;
+        newlen = oldtup->disk_tuple_size;
+    } else if (affixLens->prefixlen > 0) {
         int len;
 
         /* copy bitmap [+ padding] [+ oid] from WAL record */
@@ -915,14 +928,19 @@ Size UHeapXlogUpdateOperatorNewpage(UpdateRedoBuffers* buffers, void *recorddata
         RowPtrChangeLen(rp, newlen);
         if (onlyCopyDelta) {
             // only copy delta
-            if (affixLens->prefixlen > 0) {
+            if (affixLens->prefixlen > 0 || copyDeltaRanges) {
                 if (bitmaplen > 0) {
                     rc = memcpy_s((char *)oldtup->disk_tuple->data, bitmaplen, bitmapData, bitmaplen);
                     securec_check(rc, "\0", "\0");
                 }
             }
 
-            if (deltalen > 0) {
+            if (copyDeltaRanges) {
+                int datalen = oldtup->disk_tuple_size - oldtup->disk_tuple->t_hoff;
+                (void)UHeapApplyDeltaRanges((char *)oldtup->disk_tuple + oldtup->disk_tuple->t_hoff +
+                    affixLens->prefixlen, datalen - affixLens->prefixlen - affixLens->suffixlen,
+                    affixLens->delta, &deltaData);
+            } else if (deltalen > 0) {
                 rc = memcpy_s((char *)oldtup->disk_tuple->data + bitmaplen + affixLens->prefixlen, deltalen, deltaData,
                     deltalen);
                 securec_check(rc, "\0", "\0");
@@ -1367,7 +1385,7 @@ static void UHeapXlogUpdateBlock(XLogBlockHead *blockhead, XLogBlockDataParse *b
     TransactionId recordxid = XLogBlockHeadGetXid(blockhead);
     bool sameBlock = false;
     XLogRedoAction action;
-    UpdateRedoAffixLens affixLens = {0, 0};
+    UpdateRedoAffixLens affixLens = {0, 0, NULL};
     UHeapTupleData oldtup;
     Size freespace = 0;
     action = XLogCheckBlockDataRedoAction(datadecode, bufferinfo);
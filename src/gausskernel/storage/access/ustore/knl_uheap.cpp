@@ -51,8 +51,8 @@ static void LogUHeapInsert(UHeapWALInfo *walinfo, Relation rel, bool isToast = f
 static void LogUPageExtendTDSlots(Buffer buf, uint8 currTDSlots, uint8 numExtended);
 static void LogUHeapDelete(UHeapWALInfo *walinfo);
 static void LogUHeapUpdate(UHeapWALInfo *oldTupWalinfo, UHeapWALInfo *newTupWalinfo, bool isInplaceUpdate,
-    int undoXorDeltaSize, char *xlogXorDelta, uint16 xorPrefixlen, uint16 xorSurfixlen, Relation rel,
-    bool isBlockInplaceUpdate);
+    int undoXorDeltaSize, char *xlogXorDelta, uint16 xorPrefixlen, uint16 xorSurfixlen,
+    const UHeapDeltaRange *xorDeltaRanges, int nXorDeltaRanges, Relation rel, bool isBlockInplaceUpdate);
 static void LogUHeapMultiInsert(UHeapMultiInsertWALInfo *multiWalinfo, bool skipUndo, char *scratch,
     UndoRecPtr *urpvec, _in_ URecVector *urecvec);
 static bool UHeapWait(Relation relation, Buffer buffer, UHeapTuple utuple, LockTupleMode mode, LockWaitPolicy waitPolicy,
@@ -2381,6 +2381,92 @@ void PutLinkUpdateTuple(Page page, Item item, RowPtr *lp, Size size)
     return;
 }
 
+/*
+ * UHeapComputeDeltaRanges - find the byte ranges that differ between two
+ * equally long stretches of tuple data.
+ *
+ * Unchanged gaps too short to pay for another range header are folded into
+ * the surrounding range.  Returns the number of ranges and sets *encodedSize
+ * to the size of the encoding (range count, then each range header followed
+ * by its bytes), or returns 0 if that would not be smaller than len.
+ */
+int UHeapComputeDeltaRanges(const char *oldp, const char *newp, int len, UHeapDeltaRange *ranges,
+    int *encodedSize)
+{
+    int nranges = 0;
+    int size = sizeof(uint16);
+    int pos = 0;
+
+    while (pos < len) {
+        if (oldp[pos] == newp[pos]) {
+            pos++;
+            continue;
+        }
+
+        int start = pos;
+        int end = pos + 1;
+        for (pos = end; pos < len && pos - end <= (int)sizeof(UHeapDeltaRange); pos++) {
+            if (oldp[pos] != newp[pos]) {
+                end = pos + 1;
+            }
+        }
+
+        if (nranges == UHEAP_DELTA_MAX_RANGES) {
+            return 0;
+        }
+        ranges[nranges].off = (uint16)start;
+        ranges[nranges].len = (uint16)(end - start);
+        nranges++;
+        size += sizeof(UHeapDeltaRange) + end - start;
+    }
+
+    if (nranges == 0 || size >= len) {
+        return 0;
+    }
+    *encodedSize = size;
+    return nranges;
+}
+
+/*
+ * UHeapApplyDeltaRanges - overwrite the changed ranges of dst, which already
+ * holds the unchanged bytes, using an encoding built from
+ * UHeapComputeDeltaRanges.
+ *
+ * The bytes are taken from the encoding itself, or from *data if data is not
+ * NULL, in which case *data is advanced past them.  Returns the end of the
+ * encoding.
+ */
+char *UHeapApplyDeltaRanges(char *dst, int len, char *delta, char **data)
+{
+    uint16 nranges = 0;
+    UHeapDeltaRange range;
+    errno_t rc = memcpy_s(&nranges, sizeof(uint16), delta, sizeof(uint16));
+    securec_check(rc, "\0", "\0");
+    delta += sizeof(uint16);
+
+    for (int i = 0; i < nranges; i++) {
+        rc = memcpy_s(&range, sizeof(UHeapDeltaRange), delta, sizeof(UHeapDeltaRange));
+        securec_check(rc, "\0", "\0");
+        delta += sizeof(UHeapDeltaRange);
+
+        if (range.off + range.len > len) {
+            ereport(PANIC, (errmodule(MOD_USTORE), errmsg(
+                "delta range (%u, %u) exceeds tuple data length %d.", range.off, range.len, len)));
+        }
+
+        char *src = delta;
+        delta += range.len;
+        if (data != NULL) {
+            src = *data;
+            *data += range.len;
+        }
+        rc = memcpy_s(dst + range.off, len - range.off, src, range.len);
+        securec_check(rc, "\0", "\0");
+    }
+
+    return delta;
+}
+
 /*
  * UHeapUpdate - update a tuple
  *
@@ -3004,6 +3090,9 @@ check_tup_satisfies_update:
     uint16 prefixlen = 0;
     uint16 suffixlen = 0;
     uint8 xorDeltaFlags = 0;
+    UHeapDeltaRange deltaRanges[UHEAP_DELTA_MAX_RANGES];
+    int nDeltaRanges = 0;
+    int deltaSize = 0;
     char *oldp = (char *)oldtup.disk_tuple + oldtup.disk_tuple->t_hoff;
     char *newp = (char *)uheaptup->disk_tuple + uheaptup->disk_tuple->t_hoff;
     int oldlen = oldtup.disk_tuple_size - oldtup.disk_tuple->t_hoff;
@@ -3047,12 +3136,28 @@ check_tup_satisfies_update:
             undoXorDeltaSize += sizeof(uint16);
         if (suffixlen > 0)
             undoXorDeltaSize += sizeof(uint16);
+
+        /*
+         * If the changes between prefix and suffix are scattered, keep only
+         * the changed ranges of the old tuple.
+         */
+        if (oldlen == newlen) {
+            nDeltaRanges = UHeapComputeDeltaRanges(oldp + prefixlen, newp + prefixlen,
+                oldlen - prefixlen - suffixlen, deltaRanges, &deltaSize);
+            if (nDeltaRanges > 0) {
+                xorDeltaFlags |= UREC_INPLACE_UPDATE_XOR_DELTA;
+            }
+        }
     }
 
     /* The first sizeof(uint8) is space for t_hoff and the second sizeof(uint8) is space for prefix and suffix flag
      */
     undoXorDeltaSize += sizeof(uint8) + oldtup.disk_tuple->t_hoff - OffsetTdId + sizeof(uint8);
-    undoXorDeltaSize += oldlen - prefixlen - suffixlen;
+    if (nDeltaRanges > 0) {
+        undoXorDeltaSize += deltaSize;
+    } else {
+        undoXorDeltaSize += oldlen - prefixlen - suffixlen;
+    }
 
     urecptr = UHeapPrepareUndoUpdate(relOid, partitionOid, RelationGetRelFileNode(relation), 
         RelationGetRnodeSpace(relation), persistence, buffer, newbuf,
@@ -3128,7 +3233,17 @@ check_tup_satisfies_update:
         }
 
         /* Do a XOR delta between the end of prefixlen and start of suffixlen */
-        appendBinaryStringInfo(undorec->Rawdata(), oldp + prefixlen, oldlen - prefixlen - suffixlen);
+        if (nDeltaRanges > 0) {
+            uint16 nranges = (uint16)nDeltaRanges;
+            appendBinaryStringInfo(undorec->Rawdata(), (char *)&nranges, sizeof(uint16));
+            for (int i = 0; i < nDeltaRanges; i++) {
+                appendBinaryStringInfo(undorec->Rawdata(), (char *)&deltaRanges[i], sizeof(UHeapDeltaRange));
+                appendBinaryStringInfo(undorec->Rawdata(), oldp + prefixlen + deltaRanges[i].off,
+                    deltaRanges[i].len);
+            }
+        } else {
+            appendBinaryStringInfo(undorec->Rawdata(), oldp + prefixlen, oldlen - prefixlen - suffixlen);
+        }
 
         xlogXorDelta = (char *)palloc(undoXorDeltaSize);
         errno_t rc = memcpy_s(xlogXorDelta, undoXorDeltaSize, undorec->Rawdata()->data, undoXorDeltaSize);
@@ -3290,7 +3405,7 @@ check_tup_satisfies_update:
         Assert(oldupWalInfo.hZone != NULL);
 
         LogUHeapUpdate(&oldupWalInfo, &newupWalInfo, useInplaceUpdate, undoXorDeltaSize, xlogXorDelta, prefixlen,
-            suffixlen, relation, useLinkUpdate);
+            suffixlen, deltaRanges, nDeltaRanges, relation, useLinkUpdate);
     }
 
     undo::FinishUndoMeta(persistence);
@@ -3377,9 +3492,21 @@ void UHeapMultiInsert(Relation relation, UHeapTuple *tuples, int ntuples, Comman
 
     /* Toast and set header data in all the tuples */
     uheaptuples = (UHeapTupleData **)palloc(ntuples * sizeof(UHeapTuple));
+    uint64 tupleBytes = 0;
     for (i = 0; i < ntuples; i++) {
         tuples[i] = UHeapPrepareInsert(relation, tuples[i], 0);
         uheaptuples[i] = tuples[i];
+        tupleBytes += SHORTALIGN(uheaptuples[i]->disk_tuple_size) + sizeof(RowPtr);
+    }
+
+    /*
+     * Every page we fill produces one UNDO_MULTI_INSERT record per offset
+     * range. Extend the undo log for the whole batch up front instead of
+     * creating undo segments one at a time between page inserts.
+     */
+    if (!skipUndo) {
+        uint64 npages = tupleBytes / (BLCKSZ - saveFreeSpace - SizeOfUHeapPageHeaderData) + 1;
+        undo::ReserveUndoSpace(persistence, npages * UNDO_MULTI_INSERT_RECORD_MAXSIZE);
     }
 
     /*
@@ -4861,8 +4988,8 @@ static void LogUHeapDelete(UHeapWALInfo *walinfo)
 }
 
 static void LogUHeapUpdate(UHeapWALInfo *oldTupWalinfo, UHeapWALInfo *newTupWalinfo, bool isInplaceUpdate,
-    int undoXorDeltaSize, char *xlogXorDelta, uint16 xorPrefixlen, uint16 xorSurfixlen, Relation rel,
-    bool isLinkUpdate)
+    int undoXorDeltaSize, char *xlogXorDelta, uint16 xorPrefixlen, uint16 xorSurfixlen,
+    const UHeapDeltaRange *xorDeltaRanges, int nXorDeltaRanges, Relation rel, bool isLinkUpdate)
 {
     char *oldp = NULL;
     char *newp = NULL;
@@ -4874,6 +5001,8 @@ static void LogUHeapUpdate(UHeapWALInfo *oldTupWalinfo, UHeapWALInfo *newTupWali
     uint8 info = XLOG_UHEAP_UPDATE;
     uint16 prefixlen = 0;
     uint16 suffixlen = 0;
+    int nDeltaRanges = 0;
+    char *deltaData = NULL;
     UHeapTuple difftup = NULL;
     UHeapDiskTuple oldTup = NULL;
     UHeapTuple inplaceTup = NULL;
@@ -4938,6 +5067,7 @@ static void LogUHeapUpdate(UHeapWALInfo *oldTupWalinfo, UHeapWALInfo *newTupWali
         if (isInplaceUpdate) {
             prefixlen = xorPrefixlen;
             suffixlen = xorSurfixlen;
+            nDeltaRanges = nXorDeltaRanges;
         } else {
             int minlen = Min(oldlen, newlen);
 
@@ -4992,6 +5122,10 @@ static void LogUHeapUpdate(UHeapWALInfo *oldTupWalinfo, UHeapWALInfo *newTupWali
         xlrec.flags |= XLZ_UPDATE_SUFFIX_FROM_OLD;
     }
 
+    if (nDeltaRanges > 0) {
+        xlrec.flags |= XLZ_UPDATE_DELTA_FROM_OLD;
+    }
+
     if (RelationIsLogicallyLogged(rel)) {
         xlrec.flags |= XLOG_UHEAP_CONTAINS_OLD_HEADER;
     }
@@ -5130,7 +5264,30 @@ static void LogUHeapUpdate(UHeapWALInfo *oldTupWalinfo, UHeapWALInfo *newTupWali
      * The 'data' doesn't include the common prefix or suffix.
      */
     XLogRegisterBufData(0, (char *)&newXlhdr, SizeOfUHeapHeader);
-    if (prefixlen == 0) {
+    if (nDeltaRanges > 0) {
+        /*
+         * The changed ranges are already in the undo delta above, so only
+         * their new bytes are needed; everything else comes from the old
+         * tuple on the page.
+         */
+        if (difftup->disk_tuple->t_hoff - SizeOfUHeapDiskTupleData > 0) {
+            XLogRegisterBufData(0, ((char *)difftup->disk_tuple) + SizeOfUHeapDiskTupleData,
+                difftup->disk_tuple->t_hoff - SizeOfUHeapDiskTupleData);
+        }
+        int deltaDataLen = 0;
+        for (int i = 0; i < nDeltaRanges; i++) {
+            deltaDataLen += xorDeltaRanges[i].len;
+        }
+        deltaData = (char *)palloc(deltaDataLen);
+        char *deltaPtr = deltaData;
+        for (int i = 0; i < nDeltaRanges; i++) {
+            errno_t rc = memcpy_s(deltaPtr, deltaDataLen - (deltaPtr - deltaData),
+                newp + prefixlen + xorDeltaRanges[i].off, xorDeltaRanges[i].len);
+            securec_check(rc, "\0", "\0");
+            deltaPtr += xorDeltaRanges[i].len;
+        }
+        XLogRegisterBufData(0, deltaData, deltaDataLen);
+    } else if (prefixlen == 0) {
         XLogRegisterBufData(0, ((char *)difftup->disk_tuple) + SizeOfUHeapDiskTupleData,
             difftup->disk_tuple_size - SizeOfUHeapDiskTupleData - suffixlen);
     } else {
@@ -5154,6 +5311,10 @@ static void LogUHeapUpdate(UHeapWALInfo *oldTupWalinfo, UHeapWALInfo *newTupWali
 
     recptr = XLogInsert(RM_UHEAP_ID, info);
 
+    if (deltaData != NULL) {
+        pfree(deltaData);
+    }
+
     if (newTupWalinfo->buffer != oldTupWalinfo->buffer) {
         PageSetLSN(BufferGetPage(newTupWalinfo->buffer), recptr);
     }
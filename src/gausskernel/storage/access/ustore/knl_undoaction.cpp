@@ -19,6 +19,7 @@
 #include "access/heapam.h"
 #include "access/ustore/knl_uheap.h"
 #include "access/ustore/knl_undorequest.h"
+#include "access/ustore/knl_undoworker.h"
 #include "access/ustore/knl_uredo.h"
 #include "access/ustore/knl_uvisibility.h"
 #include "access/ustore/undo/knl_uundozone.h"
@@ -51,9 +52,12 @@ static int GetUndoApplySize()
  * fromUrecptr - undo record pointer from where to start applying undo action.
  * toUrecptr   - undo record pointer upto which point apply undo action.
  * isTopTxn    - true if rollback is for top transaction.
+ * partIdx     - part of the rollback to apply when it is split across nparts
+ *               undo workers, see UndoApplyPartOwnsBlock. With nparts > 1 the
+ *               caller marks the rollback finished once all parts are done.
  */
 void ExecuteUndoActions(TransactionId fullXid, UndoRecPtr fromUrecptr, UndoRecPtr toUrecptr,
-    UndoSlotPtr slotPtr, bool isTopTxn)
+    UndoSlotPtr slotPtr, bool isTopTxn, int partIdx, int nparts)
 {
     Assert(toUrecptr != INVALID_UNDO_REC_PTR && fromUrecptr != INVALID_UNDO_REC_PTR);
     Assert(slotPtr != INVALID_UNDO_REC_PTR);
@@ -98,6 +102,9 @@ void ExecuteUndoActions(TransactionId fullXid, UndoRecPtr fromUrecptr, UndoRecPt
     int preRetCode = 0;
     Oid preReloid = InvalidOid;
     Oid prePartitionoid = InvalidOid;
+    uint64 appliedRecords = 0;
+    uint64 appliedBlocks = 0;
+    bool reportProgress = IsUndoWorkerProcess();
     do {
         bool containsFullChain = false;
         int startIndex = 0;
@@ -139,9 +146,13 @@ void ExecuteUndoActions(TransactionId fullXid, UndoRecPtr fromUrecptr, UndoRecPt
 
             if (currRelfilenode != InvalidOid && (currTablespace != uur->Tablespace() ||
                 currRelfilenode != uur->Relfilenode() || currBlkno != uur->Blkno())) {
-                preRetCode = RmgrTable[RM_UHEAP_ID].rm_undo(urecvec, startIndex, i - 1, fullXid,
-                    currReloid, currPartitionoid, currBlkno, containsFullChain,
-                    preRetCode, &preReloid, &prePartitionoid);
+                if (UndoApplyPartOwnsBlock(currRelfilenode, currBlkno, partIdx, nparts)) {
+                    preRetCode = RmgrTable[RM_UHEAP_ID].rm_undo(urecvec, startIndex, i - 1, fullXid,
+                        currReloid, currPartitionoid, currBlkno, containsFullChain,
+                        preRetCode, &preReloid, &prePartitionoid);
+                    appliedRecords += (uint64)(i - startIndex);
+                    appliedBlocks++;
+                }
                 startIndex = i;
             }
             currReloid = uur->Reloid();
@@ -152,13 +163,23 @@ void ExecuteUndoActions(TransactionId fullXid, UndoRecPtr fromUrecptr, UndoRecPt
         }
 
         /* Apply the remaining ones */
-        preRetCode = RmgrTable[RM_UHEAP_ID].rm_undo(urecvec, startIndex, i - 1, fullXid, currReloid, currPartitionoid,
-            currBlkno, containsFullChain, preRetCode, &preReloid, &prePartitionoid);
+        if (UndoApplyPartOwnsBlock(currRelfilenode, currBlkno, partIdx, nparts)) {
+            preRetCode = RmgrTable[RM_UHEAP_ID].rm_undo(urecvec, startIndex, i - 1, fullXid, currReloid,
+                currPartitionoid, currBlkno, containsFullChain, preRetCode, &preReloid, &prePartitionoid);
+            appliedRecords += (uint64)(i - startIndex);
+            appliedBlocks++;
+        }
 
         DELETE_EX(urecvec);
+
+        if (reportProgress) {
+            UndoWorkerReportProgress(appliedRecords, appliedBlocks);
+            /* an undo worker can be cancelled between batches, its part is then retried */
+            CHECK_FOR_INTERRUPTS();
+        }
     } while (true);
 
-    if (isTopTxn) {
+    if (isTopTxn && nparts <= 1) {
         undo::UpdateRollbackFinish(slotPtr);
     }
 }
@@ -745,9 +766,15 @@ static UHeapDiskTuple CopyTupleFromUndoRecord(UndoRecord *undorecord, Buffer buf
                 suffixlen = *suffixlen_ptr;
             }
 
+            int newlen = rp->len - diskTuple->t_hoff;
+            int oldlen = undoData->len - read_size - subxid_size + prefixlen + suffixlen;
+            if (flags & UREC_INPLACE_UPDATE_XOR_DELTA) {
+                /* only the changed ranges were saved, the length did not change */
+                oldlen = newlen;
+            }
+
             char *cur_old_disktuple_ptr = NULL;
-            char *old_disktuple =
-                (char *)palloc(undoData->len - read_size - subxid_size + prefixlen + suffixlen + t_hoff);
+            char *old_disktuple = (char *)palloc(oldlen + t_hoff);
             rc = memcpy_s(old_disktuple + OffsetTdId, t_hoff - OffsetTdId, undoData->data + sizeof(uint8),
                 t_hoff - OffsetTdId);
             securec_check(rc, "", "");
@@ -763,11 +790,14 @@ static UHeapDiskTuple CopyTupleFromUndoRecord(UndoRecord *undorecord, Buffer buf
 
             char *newp = (char *)diskTuple + diskTuple->t_hoff + prefixlen;
             char *cur_undo_data_p = undoData->data + read_size;
-            int oldlen = undoData->len - read_size - subxid_size + prefixlen + suffixlen;
-            int newlen = rp->len - diskTuple->t_hoff;
             int oldDataLen = oldlen - prefixlen - suffixlen;
 
-            if (oldDataLen > 0) {
+            if (flags & UREC_INPLACE_UPDATE_XOR_DELTA) {
+                rc = memcpy_s(cur_old_disktuple_ptr, oldDataLen, newp, oldDataLen);
+                securec_check(rc, "", "");
+                (void)UHeapApplyDeltaRanges(cur_old_disktuple_ptr, oldDataLen, cur_undo_data_p, NULL);
+                cur_old_disktuple_ptr += (oldDataLen);
+            } else if (oldDataLen > 0) {
                 rc = memcpy_s(cur_old_disktuple_ptr, oldDataLen, cur_undo_data_p, oldDataLen);
                 securec_check(rc, "", "");
                 cur_old_disktuple_ptr += (oldDataLen);
@@ -95,7 +95,8 @@ static void UndolauncherSigtermHandler(SIGNAL_ARGS)
 
 static bool UndoLauncherGetWork(UndoWorkInfo work, int *idx)
 {
-    RollbackRequestsHashEntry *entry = GetNextRollbackRequest();
+    int partIdx = 0;
+    RollbackRequestsHashEntry *entry = GetNextRollbackRequest(&partIdx);
     int actualUndoWorkers = Min(g_instance.attr.attr_storage.max_undo_workers, MAX_UNDO_WORKERS);
 
     if (entry == NULL) {
@@ -106,7 +107,8 @@ static bool UndoLauncherGetWork(UndoWorkInfo work, int *idx)
         if (*idx == -1 && !TransactionIdIsValid(t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].xid)) {
             *idx = i;
         }
-        if (t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].xid == entry->xid) {
+        if (t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].xid == entry->xid &&
+            t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].partIdx == partIdx) {
             return false;
         }
     }
@@ -116,6 +118,8 @@ static bool UndoLauncherGetWork(UndoWorkInfo work, int *idx)
     work->endUndoPtr = entry->endUndoPtr;
     work->dbid = entry->dbid;
     work->slotPtr = entry->slotPtr;
+    work->partIdx = partIdx;
+    work->nparts = entry->nparts;
     return true;
 }
 
@@ -150,6 +154,10 @@ static void StartUndoWorker(UndoWorkInfo work, int idx)
 
     t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[idx].xid = work->xid;
     t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[idx].startUndoPtr = work->startUndoPtr;
+    t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[idx].partIdx = work->partIdx;
+    t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[idx].nparts = work->nparts;
+    t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[idx].undoRecords = 0;
+    t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[idx].undoBlocks = 0;
 
     do {
         bool hit10s = (retryTimes % maxRetryTimes == 0);
@@ -192,6 +200,10 @@ void UndoWorkerShmemInit(void)
             t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].pid = InvalidPid;
             t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].startUndoPtr = INVALID_UNDO_REC_PTR;
             t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].rollbackStartTime = (TimestampTz)0;
+            t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].partIdx = 0;
+            t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].nparts = 0;
+            t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].undoRecords = 0;
+            t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].undoBlocks = 0;
         }
     }
 }
@@ -63,6 +63,26 @@ bool IsRollbackRequestHashFull()
     return result;
 }
 
+/*
+ * Decide how many undo workers apply a rollback request. Requests are only
+ * split when their undo is large enough for the extra undo reads to pay off.
+ */
+static int GetRollbackRequestParts(UndoRecPtr fromAddr, UndoRecPtr toAddr)
+{
+    int maxParts = Min(u_sess->attr.attr_storage.max_undo_workers_per_rollback,
+        Min(g_instance.attr.attr_storage.max_undo_workers, MAX_UNDO_APPLY_PARTS));
+    if (maxParts <= 1) {
+        return 1;
+    }
+
+    uint64 undoSize = UNDO_APPLY_PART_MIN_SIZE * (uint64)maxParts;
+    if (UNDO_PTR_GET_ZONE_ID(fromAddr) == UNDO_PTR_GET_ZONE_ID(toAddr) && fromAddr >= toAddr) {
+        undoSize = UNDO_PTR_GET_OFFSET(fromAddr) - UNDO_PTR_GET_OFFSET(toAddr);
+    }
+    uint64 nparts = undoSize / UNDO_APPLY_PART_MIN_SIZE + 1;
+    return (int)Min(nparts, (uint64)maxParts);
+}
+
 bool AddRollbackRequest(TransactionId xid, UndoRecPtr fromAddr, UndoRecPtr toAddr, Oid dbid, UndoSlotPtr slotPtr)
 {
     bool found = false;
@@ -89,6 +109,9 @@ bool AddRollbackRequest(TransactionId xid, UndoRecPtr fromAddr, UndoRecPtr toAdd
         entry->dbid = dbid;
         entry->slotPtr = slotPtr;
         entry->launched = false;
+        entry->nparts = GetRollbackRequestParts(fromAddr, toAddr);
+        entry->partsLaunched = 0;
+        entry->partsDone = 0;
     }
 
     /* Wake up the Undo Launcher */
@@ -120,7 +143,7 @@ bool RemoveRollbackRequest(TransactionId xid, UndoRecPtr startAddr, ThreadId pid
     return true;
 }
 
-void ReportFailedRollbackRequest(TransactionId xid, UndoRecPtr fromAddr, UndoRecPtr toAddr, Oid dbid)
+void ReportFailedRollbackRequest(TransactionId xid, UndoRecPtr fromAddr, UndoRecPtr toAddr, Oid dbid, int partIdx)
 {
     bool found = false;
     RollbackRequestsHashEntry *entry = NULL;
@@ -128,7 +151,7 @@ void ReportFailedRollbackRequest(TransactionId xid, UndoRecPtr fromAddr, UndoRec
     key.xid = xid;
     key.startUndoPtr = fromAddr;
 
-    LWLockAcquire(RollbackReqHashLock, LW_SHARED);
+    LWLockAcquire(RollbackReqHashLock, LW_EXCLUSIVE);
 
     entry = (RollbackRequestsHashEntry *)hash_search(t_thrd.rollback_requests_cxt.rollback_requests_hash, &key,
         HASH_ENTER, &found);
@@ -137,9 +160,10 @@ void ReportFailedRollbackRequest(TransactionId xid, UndoRecPtr fromAddr, UndoRec
     Assert(found == true);
     Assert(entry->endUndoPtr == toAddr);
     Assert(entry->dbid == dbid);
-    Assert(entry->launched == true);
+    Assert((entry->partsLaunched & (1U << partIdx)) != 0);
 
-    /* Allow Undo launcher to pick this up for a retry */
+    /* Allow Undo launcher to pick this part up for a retry */
+    entry->partsLaunched &= ~(1U << partIdx);
     entry->launched = false;
 
     /* Wake up the Undo Launcher */
@@ -148,12 +172,42 @@ void ReportFailedRollbackRequest(TransactionId xid, UndoRecPtr fromAddr, UndoRec
     LWLockRelease(RollbackReqHashLock);
 }
 
-RollbackRequestsHashEntry *GetNextRollbackRequest()
+/*
+ * Mark one part of a rollback request as applied. Returns true if this was the
+ * last outstanding part, in which case the caller finishes the rollback.
+ */
+bool FinishRollbackRequestPart(TransactionId xid, UndoRecPtr startAddr, int partIdx)
+{
+    bool found = false;
+    bool finished = false;
+    RollbackRequestsHashEntry *entry = NULL;
+    RollbackRequestsHashKey key;
+    key.xid = xid;
+    key.startUndoPtr = startAddr;
+
+    LWLockAcquire(RollbackReqHashLock, LW_EXCLUSIVE);
+    entry = (RollbackRequestsHashEntry *)hash_search(t_thrd.rollback_requests_cxt.rollback_requests_hash, &key,
+        HASH_FIND, &found);
+    if (found) {
+        entry->partsDone |= (1U << partIdx);
+        finished = (entry->partsDone == ((1U << entry->nparts) - 1));
+    }
+    LWLockRelease(RollbackReqHashLock);
+
+    return finished;
+}
+
+/*
+ * Pick a rollback request with a part that no undo worker is applying yet,
+ * and mark that part, returned in *partIdx, as launched.
+ */
+RollbackRequestsHashEntry *GetNextRollbackRequest(int *partIdx)
 {
     RollbackRequestsHashEntry *entry = NULL;
     HASH_SEQ_STATUS hashSeq;
 
-    LWLockAcquire(RollbackReqHashLock, LW_SHARED);
+    /* Exclusive, we mark the picked part as launched. */
+    LWLockAcquire(RollbackReqHashLock, LW_EXCLUSIVE);
     hash_seq_init(&hashSeq, t_thrd.rollback_requests_cxt.rollback_requests_hash);
     hashSeq.curBucket = t_thrd.rollback_requests_cxt.next_bucket_for_scan;
     hashSeq.curEntry = NULL;
@@ -174,7 +228,15 @@ RollbackRequestsHashEntry *GetNextRollbackRequest()
         t_thrd.rollback_requests_cxt.next_bucket_for_scan = 0;
     } else {
         t_thrd.rollback_requests_cxt.next_bucket_for_scan = hashSeq.curBucket;
-        entry->launched = true;
+        uint32 allParts = (1U << entry->nparts) - 1;
+        uint32 pendingParts = allParts & ~(entry->partsLaunched | entry->partsDone);
+        Assert(pendingParts != 0);
+        *partIdx = 0;
+        while ((pendingParts & (1U << *partIdx)) == 0) {
+            (*partIdx)++;
+        }
+        entry->partsLaunched |= (1U << *partIdx);
+        entry->launched = ((entry->partsLaunched | entry->partsDone) == allParts);
         hash_seq_term(&hashSeq);
     }
 
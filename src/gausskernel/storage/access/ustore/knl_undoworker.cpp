@@ -98,6 +98,7 @@ static void UndoworkerSigtermHandler(SIGNAL_ARGS)
 static void UndoWorkerFreeInfo(int code, Datum arg)
 {
     int idx = -1;
+    int partIdx = 0;
     bool found = false;
     ThreadId pid = gs_thread_self();
     RollbackRequestsHashKey key;
@@ -110,10 +111,15 @@ static void UndoWorkerFreeInfo(int code, Datum arg)
             idx = i;
             key.xid = t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].xid;
             key.startUndoPtr = t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].startUndoPtr;
+            partIdx = t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].partIdx;
             t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].pid = InvalidPid;
             t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].xid = InvalidTransactionId;
             t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].startUndoPtr = INVALID_UNDO_REC_PTR;
             t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].rollbackStartTime = (TimestampTz)0;
+            t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].partIdx = 0;
+            t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].nparts = 0;
+            t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].undoRecords = 0;
+            t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].undoBlocks = 0;
             break;
         }
     }
@@ -122,7 +128,8 @@ static void UndoWorkerFreeInfo(int code, Datum arg)
         LWLockAcquire(RollbackReqHashLock, LW_EXCLUSIVE);
         entry = (RollbackRequestsHashEntry *)hash_search(t_thrd.rollback_requests_cxt.rollback_requests_hash, &key,
             HASH_FIND, &found);
-        if (found) {
+        if (found && (entry->partsDone & (1U << partIdx)) == 0) {
+            entry->partsLaunched &= ~(1U << partIdx);
             entry->launched = false;
         }
         LWLockRelease(RollbackReqHashLock);
@@ -139,6 +146,25 @@ static void UndoWorkerGetWork(UndoWorkInfo undowork)
     securec_check(rc, "\0", "\0");
 }
 
+/*
+ * Record how far the rollback got in our undo_worker_status slot, so that a
+ * long running rollback can be watched part by part in gs_stat_undo_rollback().
+ */
+void UndoWorkerReportProgress(uint64 undoRecords, uint64 undoBlocks)
+{
+    ThreadId pid = gs_thread_self();
+    int actualUndoWorkers = Min(g_instance.attr.attr_storage.max_undo_workers, MAX_UNDO_WORKERS);
+
+    for (int i = 0; i < actualUndoWorkers; i++) {
+        volatile UndoWorkerItem *item = &t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i];
+        if (item->pid == pid) {
+            item->undoRecords = undoRecords;
+            item->undoBlocks = undoBlocks;
+            break;
+        }
+    }
+}
+
 static void UndoPerformWork(UndoWorkInfo undowork)
 {
     bool error = false;
@@ -148,11 +174,11 @@ static void UndoPerformWork(UndoWorkInfo undowork)
     StartTransactionCommand();
     PG_TRY();
     {
-        elog(LOG, "UndoWorker: Performing Rollback for xid:%ld, undo:(%ld -> %ld)", undowork->xid,
-            undowork->startUndoPtr, undowork->endUndoPtr);
+        elog(LOG, "UndoWorker: Performing Rollback for xid:%ld, undo:(%ld -> %ld), part %d/%d", undowork->xid,
+            undowork->startUndoPtr, undowork->endUndoPtr, undowork->partIdx + 1, undowork->nparts);
         ExecuteUndoActions(undowork->xid, undowork->startUndoPtr, /* last undorecord created in the txn */
             undowork->endUndoPtr,                                 /* first undorecord created in the txn */
-            undowork->slotPtr, true);
+            undowork->slotPtr, true, undowork->partIdx, undowork->nparts);
     }
     PG_CATCH();
     {
@@ -163,7 +189,8 @@ static void UndoPerformWork(UndoWorkInfo undowork)
             "TransactionId: %ld, latest urp: %ld, first urp: %lu, last urp %lu, dbid: %d",
             undowork->xid, undowork->startUndoPtr, undowork->endUndoPtr, undowork->startUndoPtr, undowork->dbid);
 
-        ReportFailedRollbackRequest(undowork->xid, undowork->startUndoPtr, undowork->endUndoPtr, undowork->dbid);
+        ReportFailedRollbackRequest(undowork->xid, undowork->startUndoPtr, undowork->endUndoPtr, undowork->dbid,
+            undowork->partIdx);
 
         /* Prevent interrupts while cleaning up. */
         HOLD_INTERRUPTS();
@@ -183,10 +210,24 @@ static void UndoPerformWork(UndoWorkInfo undowork)
     }
     PG_END_TRY();
 
-    if (!error) {
+    if (error) {
+        return;
+    }
+    CommitTransactionCommand();
+
+    /*
+     * The last part to finish marks the rollback of the whole transaction as
+     * done; a single-part request has already done so in ExecuteUndoActions.
+     */
+    if (!FinishRollbackRequestPart(undowork->xid, undowork->startUndoPtr, undowork->partIdx)) {
+        return;
+    }
+    if (undowork->nparts > 1) {
+        StartTransactionCommand();
+        undo::UpdateRollbackFinish(undowork->slotPtr);
         CommitTransactionCommand();
-        RemoveRollbackRequest(undowork->xid, undowork->startUndoPtr, gs_thread_self());
     }
+    RemoveRollbackRequest(undowork->xid, undowork->startUndoPtr, gs_thread_self());
 }
 
 bool IsUndoWorkerProcess(void)
@@ -299,7 +340,8 @@ NON_EXEC_STATIC void UndoWorkerMain()
     UndoWorkerGetWork(&undowork);
     
     for (int i = 0; i < actualUndoWorkers; i++) {
-        if (TransactionIdEquals(t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].xid, undowork.xid)) {
+        if (TransactionIdEquals(t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].xid, undowork.xid) &&
+            t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].partIdx == undowork.partIdx) {
             t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].pid = gs_thread_self();
             t_thrd.undolauncher_cxt.UndoWorkerShmem->undo_worker_status[i].rollbackStartTime = GetCurrentTimestamp();
             break;
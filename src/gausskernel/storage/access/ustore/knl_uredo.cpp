@@ -59,6 +59,7 @@ struct UpdateRedoTuples {
 struct UpdateRedoAffixLens {
     uint16 prefixlen;
     uint16 suffixlen;
+    char *delta; /* changed ranges of an inplace update, see UHeapComputeDeltaRanges */
 };
 
 static UHeapDiskTuple GetUHeapDiskTupleFromRedoData(char *data, Size *datalen,
@@ -795,6 +796,9 @@ static void GetXidbaseAndAffixLensFromUpdateRedo(char *curxlogptr, XLogReaderSta
             xorCurxlogptr += sizeof(uint16);
             affixLens->suffixlen = *suffixlenPtr;
         }
+        if (flags & UREC_INPLACE_UPDATE_XOR_DELTA) {
+            affixLens->delta = xorCurxlogptr;
+        }
     }
 }
 
@@ -1127,7 +1131,29 @@ static uint32 GetUHeapDiskTupleFromUpdateNewRedoData(XLogReaderState *record, Up
      * old tuple, and the data stored in the WAL record.
      */
     char *newp = (char *)tuples->newtup + SizeOfUHeapDiskTupleData;
-    if (affixLens->prefixlen > 0) {
+    uint32 newlen = SizeOfUHeapDiskTupleData + tuplen + affixLens->prefixlen + affixLens->suffixlen;
+    if (xlrec->flags & XLZ_UPDATE_DELTA_FROM_OLD) {
+        /*
+         * Only the changed ranges were logged: take the whole data from the
+         * old tuple and patch them in.
+         */
+        UHeapDiskTuple olddisktup = tuples->oldtup->disk_tuple;
+        int datalen = tuples->oldtup->disk_tuple_size - olddisktup->t_hoff;
+        int len = xlhdr.t_hoff - SizeOfUHeapDiskTupleData;
+
+        Assert(affixLens->delta != NULL);
+        if (len > 0) {
+            rc = memcpy_s(newp, tuplen, recdata, len);
+            securec_check(rc, "\0", "\0");
+            recdata += len;
+            newp += len;
+        }
+        rc = memcpy_s(newp, datalen, (char *)olddisktup + olddisktup->t_hoff, datalen);
+        securec_check(rc, "\0", "\0");
+        (void)UHeapApplyDeltaRanges(newp + affixLens->prefixlen,
+            datalen - affixLens->prefixlen - affixLens->suffixlen, affixLens->delta, &recdata);
+        newlen = xlhdr.t_hoff + datalen;
+    } else if (affixLens->prefixlen > 0) {
         int len;
 
         /* copy bitmap [+ padding] [+ oid] from WAL record */
@@ -1167,14 +1193,13 @@ static uint32 GetUHeapDiskTupleFromUpdateNewRedoData(XLogReaderState *record, Up
     Assert(recdata == recdataEnd);
 
     /* copy suffix from old tuple */
-    if (affixLens->suffixlen > 0) {
+    if (affixLens->suffixlen > 0 && !(xlrec->flags & XLZ_UPDATE_DELTA_FROM_OLD)) {
         rc = memcpy_s(newp, affixLens->suffixlen,
             (char *)tuples->oldtup->disk_tuple + tuples->oldtup->disk_tuple_size - affixLens->suffixlen,
             affixLens->suffixlen);
         securec_check(rc, "\0", "\0");
     }
 
-    uint32 newlen = SizeOfUHeapDiskTupleData + tuplen + affixLens->prefixlen + affixLens->suffixlen;
     UHeapTupleHeaderSetTDSlot(tuples->newtup, xlhdr.td_id);
     tuples->newtup->xid = (ShortTransactionId)FrozenTransactionId;
     tuples->newtup->flag2 = xlhdr.flag2;
@@ -1271,7 +1296,7 @@ static void UHeapXlogUpdate(XLogReaderState *record)
     UpdateRedoTuples tuples;
     XLogRedoAction oldaction, newaction;
     TupleBuffer tbuf;
-    UpdateRedoAffixLens affixLens = {0, 0};
+    UpdateRedoAffixLens affixLens = {0, 0, NULL};
     uint32 newlen = 0;
     Size freespace = 0;
     bool sameBlock = false;
@@ -40,14 +40,14 @@
 
 static void UHeapToastDeleteDatum(Relation rel, Datum value, int options);
 static Datum UHeapToastSaveDatum(Relation rel, Datum value, struct varlena *oldexternal, int options);
-static Datum UHeapToastCompressDatum(Datum value);
+static Datum UHeapToastCompressDatum(Relation rel, int attnum, Datum value);
 static bool UHeapToastIdValueIdExists(Oid toastrelid, Oid valueid, int2 bucketid);
 static bool UHeapToastRelValueidExists(Relation toastrel, Oid valueid);
 static Oid UHeapGetNewOidWithIndex(Relation relation, Oid indexId, AttrNumber oidcolumn);
 
-static Datum UHeapToastCompressDatum(Datum value)
+static Datum UHeapToastCompressDatum(Relation rel, int attnum, Datum value)
 {
-    return toast_compress_datum(value);
+    return toast_compress_datum(value, GetAttributeToastCompression(rel, attnum));
 }
 
 Oid UHeapGetNewOidWithIndex(Relation relation, Oid indexId, AttrNumber oidcolumn)
@@ -344,7 +344,7 @@ UHeapTuple UHeapToastInsertOrUpdate(Relation relation, UHeapTuple newtup, UHeapT
         i = biggestAttno;
         if (((TupleDescAttr(tupleDesc, i)))->attstorage == 'x') {
             oldValue = toastValues[i];
-            newValue = UHeapToastCompressDatum(oldValue);
+            newValue = UHeapToastCompressDatum(relation, i + 1, oldValue);
             if (DatumGetPointer(newValue) != NULL) {
                 /* successful compression */
                 if (toastFree[i])
@@ -470,7 +470,7 @@ UHeapTuple UHeapToastInsertOrUpdate(Relation relation, UHeapTuple newtup, UHeapT
          */
         i = biggestAttno;
         oldValue = toastValues[i];
-        newValue = UHeapToastCompressDatum(oldValue);
+        newValue = UHeapToastCompressDatum(relation, i + 1, oldValue);
         if (DatumGetPointer(newValue) != NULL) {
             /* successful compression */
             if (toastFree[i])
@@ -576,6 +576,17 @@ UndoTraversalState FetchUndoRecord(__inout UndoRecord *urec, _in_ SatisfyUndoRec
     return UNDO_TRAVERSAL_COMPLETE;
 }
 
+void PrefetchUndoRecord(_in_ UndoRecPtr urp)
+{
+    if (u_sess->storage_cxt.target_prefetch_pages <= 0 || !IS_VALID_UNDO_REC_PTR(urp)) {
+        return;
+    }
+
+    RelFileNode rnode;
+    UNDO_PTR_ASSIGN_REL_FILE_NODE(rnode, urp, UNDO_DB_OID);
+    (void)PrefetchBufferWithoutRelcache(rnode, UNDO_FORKNUM, UNDO_PTR_GET_BLOCK_NUM(urp));
+}
+
 bool InplaceSatisfyUndoRecord(_in_ UndoRecord *urec, _in_ BlockNumber blkno, _in_ OffsetNumber offset,
     _in_ TransactionId xid)
 {
@@ -25,9 +25,47 @@
 #include "utils/elog.h"
 
 namespace {
-void PrefetchUndoPages(UndoRecPtr urp, int prefetchTarget, int *prefetchPages, 
-    BlockNumber startBlk, BlockNumber endBlk, UndoPersistence upersistence)
+/*
+ * PrefetchUndoPages
+ *
+ * Issue prefetch requests for the undo blocks a backward scan from currUrp
+ * towards endUrp is about to read, keeping up to prefetchTarget blocks ahead
+ * of the scan. *prefetchUrp remembers the lowest block prefetched so far.
+ */
+void PrefetchUndoPages(UndoRecPtr currUrp, UndoRecPtr endUrp, int prefetchTarget, UndoRecPtr *prefetchUrp)
 {
+    int zid = UNDO_PTR_GET_ZONE_ID(currUrp);
+    BlockNumber currBlk = UNDO_PTR_GET_BLOCK_NUM(currUrp);
+    BlockNumber endBlk;
+    BlockNumber blk = currBlk;
+
+    /*
+     * The transaction may have switched zones, in which case we only know
+     * that the segment of the current record is still there.
+     */
+    if (UNDO_PTR_GET_ZONE_ID(endUrp) == zid && endUrp <= currUrp) {
+        endBlk = UNDO_PTR_GET_BLOCK_NUM(endUrp);
+    } else {
+        endBlk = currBlk - currBlk % UNDOSEG_SIZE;
+    }
+
+    if (IS_VALID_UNDO_REC_PTR(*prefetchUrp) && UNDO_PTR_GET_ZONE_ID(*prefetchUrp) == zid &&
+        UNDO_PTR_GET_BLOCK_NUM(*prefetchUrp) < currBlk) {
+        blk = UNDO_PTR_GET_BLOCK_NUM(*prefetchUrp);
+    }
+
+    /* Still enough blocks in flight. */
+    if ((int)(currBlk - blk) >= prefetchTarget / 2) {
+        return;
+    }
+
+    RelFileNode rnode;
+    UNDO_PTR_ASSIGN_REL_FILE_NODE(rnode, currUrp, UNDO_DB_OID);
+    while (blk > endBlk && (int)(currBlk - blk) < prefetchTarget) {
+        blk--;
+        (void)PrefetchBufferWithoutRelcache(rnode, UNDO_FORKNUM, blk);
+    }
+    *prefetchUrp = MAKE_UNDO_PTR(zid, (UndoLogOffset)blk * BLCKSZ);
 }
 
 /*
@@ -440,13 +478,11 @@ static bool LoadUndoRecordRange(UndoRecord *urec, Buffer *buffer)
 URecVector* FetchUndoRecordRange(    __inout UndoRecPtr *startUrp,
     _in_ UndoRecPtr endUrp, _in_ int maxUndoApplySize, _in_ bool onePage)
 {
-    BlockNumber startBlk = InvalidBlockNumber;
-    BlockNumber endBlk = InvalidBlockNumber;
     static const int urecSize = 1024;
     int totalSize = sizeof(URecVector);
     TransactionId xid = InvalidTransactionId;
     int prefetchTarget = onePage ? 0 : u_sess->storage_cxt.target_prefetch_pages;
-    int prefetchPages = 0;
+    UndoRecPtr prefetchUrp = INVALID_UNDO_REC_PTR;
     Buffer buffer = InvalidBuffer;
     UndoRecPtr currUrp = *startUrp;
     UndoRecPtr prevUrp = INVALID_UNDO_REC_PTR;
@@ -457,19 +493,11 @@ URecVector* FetchUndoRecordRange(    __inout UndoRecPtr *startUrp,
     urecvec->Initialize(urecSize, false);
 
     do {
-        startBlk = UNDO_PTR_GET_BLOCK_NUM(currUrp);
-        endBlk = UNDO_PTR_GET_BLOCK_NUM(endUrp);
-
         VerifyMemoryContext();
         UndoRecord *urec = New(CurrentMemoryContext) UndoRecord();
         urec->SetUrp(currUrp);
         urec->SetMemoryContext(CurrentMemoryContext);
 
-        /* Get Undo Persistence. Stored in the variable upersistence */
-        int zoneId = UNDO_PTR_GET_ZONE_ID(currUrp);
-        DECLARE_NODE_COUNT();
-        GET_UPERSISTENCE_BY_ZONEID(zoneId, nodeCount);
-
         // If next undo record pointer to be fetched is not on the same block
         // then release the old buffer.
         if (!IS_VALID_UNDO_REC_PTR(prevUrp) || UNDO_PTR_GET_ZONE_ID(prevUrp) != UNDO_PTR_GET_ZONE_ID(currUrp) ||
@@ -486,9 +514,8 @@ URecVector* FetchUndoRecordRange(    __inout UndoRecPtr *startUrp,
             urec->SetBuff(buffer);
         }
 
-        if (prefetchPages < prefetchTarget / 2) {
-            PrefetchUndoPages(currUrp, prefetchTarget, &prefetchPages, 
-                startBlk, endBlk, upersistence);
+        if (prefetchTarget > 0) {
+            PrefetchUndoPages(currUrp, endUrp, prefetchTarget, &prefetchUrp);
         }
 
         if (!LoadUndoRecordRange(urec, &buffer)) {
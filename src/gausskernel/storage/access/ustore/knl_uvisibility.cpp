@@ -1968,7 +1968,14 @@ static UndoTraversalState GetTupleFromUndoRecord(UndoRecPtr urecPtr, Transaction
             suffixlen = *suffixlenPtr;
         }
 
-        char *oldDisktuple = (char *)palloc0(urecPayload->len - readSize - subxidSize + prefixlen + suffixlen + tHoff);
+        int newlen = (*tuple)->disk_tuple_size - diskTuple->t_hoff;
+        int oldlen = urecPayload->len - readSize - subxidSize + prefixlen + suffixlen;
+        if (flags & UREC_INPLACE_UPDATE_XOR_DELTA) {
+            /* only the changed ranges were saved, the length did not change */
+            oldlen = newlen;
+        }
+
+        char *oldDisktuple = (char *)palloc0(oldlen + tHoff);
         errno_t rc = memcpy_s(oldDisktuple + OffsetTdId, tHoff - OffsetTdId, urecPayload->data + sizeof(uint8),
             tHoff - OffsetTdId);
         securec_check_c(rc, "\0", "\0");
@@ -1984,11 +1991,14 @@ static UndoTraversalState GetTupleFromUndoRecord(UndoRecPtr urecPtr, Transaction
 
         char *newp = (char *)diskTuple + diskTuple->t_hoff + prefixlen;
         char *curUndoDataP = urecPayload->data + readSize;
-        int oldlen = urecPayload->len - readSize - subxidSize + prefixlen + suffixlen;
-        int newlen = (*tuple)->disk_tuple_size - diskTuple->t_hoff;
         int oldDataLen = oldlen - prefixlen - suffixlen;
 
-        if (oldDataLen > 0) {
+        if (flags & UREC_INPLACE_UPDATE_XOR_DELTA) {
+            rc = memcpy_s(curOldDisktuplePtr, oldDataLen, newp, oldDataLen);
+            securec_check_c(rc, "\0", "\0");
+            (void)UHeapApplyDeltaRanges(curOldDisktuplePtr, oldDataLen, curUndoDataP, NULL);
+            curOldDisktuplePtr += (oldDataLen);
+        } else if (oldDataLen > 0) {
             rc = memcpy_s(curOldDisktuplePtr, oldDataLen, curUndoDataP, oldDataLen);
             securec_check_c(rc, "\0", "\0");
             curOldDisktuplePtr += (oldDataLen);
@@ -2184,6 +2194,16 @@ static bool GetTupleFromUndo(UndoRecPtr urecAdd, UHeapTuple currentTuple, UHeapT
             UHeapUpdateTDInfo(uinfo.td_slot, buffer, offnum, &uinfo);
         }
 
+        /*
+         * Long-running readers usually need the next older version as well;
+         * get its undo block on the way while we check this one, unless it
+         * is the block we have just read.
+         */
+        if (UNDO_PTR_GET_ZONE_ID(uinfo.urec_add) != UNDO_PTR_GET_ZONE_ID(urecAdd) ||
+            UNDO_PTR_GET_BLOCK_NUM(uinfo.urec_add) != UNDO_PTR_GET_BLOCK_NUM(urecAdd)) {
+            PrefetchUndoRecord(uinfo.urec_add);
+        }
+
         UTupleTidOp op = UHeapTidOpFromInfomask(hdr.flag);
 
         /* can't further operate on deleted or non-inplace-updated tuple */
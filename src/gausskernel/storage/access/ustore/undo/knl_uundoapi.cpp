@@ -115,6 +115,34 @@ UndoRecPtr AllocateUndoSpace(TransactionId xid, UndoPersistence upersistence, ui
     return urecptr;
 }
 
+/*
+ * Pre-extend the undo log of the current zone for a bulk operation which is
+ * about to generate roughly size bytes of undo, e.g. a multi-insert or COPY
+ * into a ustore table. The extension is capped at UNDO_RESERVE_MAX_SEGMENTS
+ * segments so that a bad estimate cannot eat into the undo space limit.
+ */
+void ReserveUndoSpace(UndoPersistence upersistence, uint64 size)
+{
+    if (t_thrd.xlog_cxt.InRecovery || !g_instance.attr.attr_storage.enable_ustore) {
+        return;
+    }
+    int zid = t_thrd.undo_cxt.zids[upersistence];
+    if (zid == INVALID_ZONE_ID) {
+        return;
+    }
+    UndoZone *uzone = UndoZoneGroup::GetUndoZone(zid, false);
+    size = Min(size, (uint64)UNDO_RESERVE_MAX_SEGMENTS * UNDO_LOG_SEGMENT_SIZE);
+    /* Nothing to extend if the batch won't fit into what is left of the zone */
+    if (uzone == NULL || uzone->CheckNeedSwitch(size)) {
+        return;
+    }
+    if (uzone->ReserveSpace(size)) {
+        ereport(DEBUG1, (errmodule(MOD_UNDO),
+            errmsg(UNDOFORMAT("zone %d reserve undo space %lu from %lu."),
+                zid, size, uzone->GetInsertURecPtr())));
+    }
+}
+
 UndoRecPtr AdvanceUndoPtr(UndoRecPtr undoPtr, uint64 size)
 {
     UndoLogOffset oldInsert = UNDO_PTR_GET_OFFSET(undoPtr);
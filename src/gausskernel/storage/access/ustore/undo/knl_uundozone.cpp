@@ -65,7 +65,7 @@ UndoZone::UndoZone()
     slotSpace_.SetTail(0);
 }
 
-bool UndoZone::CheckNeedSwitch(UndoRecordSize size)
+bool UndoZone::CheckNeedSwitch(uint64 size)
 {
     UndoLogOffset newInsert = UNDO_LOG_OFFSET_PLUS_USABLE_BYTES(insertURecPtr_, size);
     if (unlikely(newInsert > UNDO_LOG_MAX_SIZE)) {
@@ -164,31 +164,59 @@ TransactionSlot *UndoZone::AllocTransactionSlot(UndoSlotPtr slotPtr, Transaction
     return slot;
 }
 
+void UndoZone::ExtendSpace(UndoLogOffset newInsert)
+{
+    undoSpace_.LockSpace();
+    UndoRecPtr prevTail = MAKE_UNDO_PTR(zid_, undoSpace_.Tail());
+    undoSpace_.ExtendUndoLog(zid_, newInsert + UNDO_LOG_SEGMENT_SIZE -
+        newInsert % UNDO_LOG_SEGMENT_SIZE, UNDO_DB_OID);
+    if (pLevel_ == UNDO_PERMANENT) {
+        START_CRIT_SECTION();
+        undoSpace_.MarkDirty();
+        XlogUndoExtend undoExtend;
+        undoExtend.prevtail = prevTail;
+        undoExtend.tail = MAKE_UNDO_PTR(zid_, undoSpace_.Tail());
+        XLogRecPtr lsn = WriteUndoXlog(&undoExtend, XLOG_UNDO_EXTEND);
+        undoSpace_.SetLSN(lsn);
+        END_CRIT_SECTION();
+    }
+    undoSpace_.UnlockSpace();
+}
+
 UndoRecPtr UndoZone::AllocateSpace(uint64 size)
 {
     UndoLogOffset oldInsert = insertURecPtr_;
     UndoLogOffset newInsert = UNDO_LOG_OFFSET_PLUS_USABLE_BYTES(oldInsert, size);
     Assert(newInsert % UNDO_LOG_SEGMENT_SIZE != 0);
     if (unlikely(newInsert > undoSpace_.Tail())) {
-        undoSpace_.LockSpace();
-        UndoRecPtr prevTail = MAKE_UNDO_PTR(zid_, undoSpace_.Tail());
-        undoSpace_.ExtendUndoLog(zid_, newInsert + UNDO_LOG_SEGMENT_SIZE -
-            newInsert % UNDO_LOG_SEGMENT_SIZE, UNDO_DB_OID);
-        if (pLevel_ == UNDO_PERMANENT) {
-            START_CRIT_SECTION();
-            undoSpace_.MarkDirty();
-            XlogUndoExtend undoExtend;
-            undoExtend.prevtail = prevTail;
-            undoExtend.tail = MAKE_UNDO_PTR(zid_, undoSpace_.Tail());
-            XLogRecPtr lsn = WriteUndoXlog(&undoExtend, XLOG_UNDO_EXTEND);
-            undoSpace_.SetLSN(lsn);
-            END_CRIT_SECTION();
-        }
-        undoSpace_.UnlockSpace();
+        ExtendSpace(newInsert);
     }
     return MAKE_UNDO_PTR(zid_, oldInsert);
 }
 
+/*
+ * Extend the undo log ahead of time so that the next size bytes of undo can be
+ * allocated without creating segments one by one. Used by bulk loaders, which
+ * know roughly how much undo they will generate. Returns false if nothing was
+ * reserved; the regular allocation path then extends the log on demand.
+ */
+bool UndoZone::ReserveSpace(uint64 size)
+{
+    UndoLogOffset newInsert = UNDO_LOG_OFFSET_PLUS_USABLE_BYTES(insertURecPtr_, size);
+    if (newInsert <= undoSpace_.Tail() || newInsert > UNDO_LOG_MAX_SIZE) {
+        return false;
+    }
+
+    uint64 needBlocks = (newInsert - undoSpace_.Tail()) / BLCKSZ + UNDOSEG_SIZE;
+    uint64 usedBlocks = (uint64)pg_atomic_read_u32(&g_instance.undo_cxt.undoTotalSize) +
+        (uint64)g_instance.undo_cxt.undoMetaSize;
+    if (usedBlocks + needBlocks >= (uint64)u_sess->attr.attr_storage.undo_space_limit_size) {
+        return false;
+    }
+    ExtendSpace(newInsert);
+    return true;
+}
+
 UndoSlotPtr UndoZone::AllocateSlotSpace(void)
 {
     UndoSlotOffset oldInsert = allocateTSlotPtr_;
@@ -429,6 +429,46 @@ void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum)
 #endif /* USE_PREFETCH && USE_POSIX_FADVISE */
 }
 
+/*
+ * PrefetchBufferWithoutRelcache -- like PrefetchBuffer, but for blocks that
+ *		have no relcache entry at hand, such as undo log blocks and blocks
+ *		referenced by WAL records during redo.
+ *
+ * The undo segment holding the block may already have been recycled; the undo
+ * smgr ignores prefetch requests for missing segments, so callers need not
+ * hold off undo discard while prefetching.  In recovery, md ignores requests
+ * for files that are missing or not yet extended the same way.
+ *
+ * Returns true if a read was initiated, false if the block is in shared
+ * buffers already.
+ */
+bool PrefetchBufferWithoutRelcache(const RelFileNode &rnode, ForkNumber forkNum, BlockNumber blockNum)
+{
+#if defined(USE_PREFETCH) && defined(USE_POSIX_FADVISE)
+    Assert(BlockNumberIsValid(blockNum));
+
+    BufferTag new_tag;
+    uint32 new_hash;
+    LWLock *new_partition_lock;
+    int buf_id;
+
+    INIT_BUFFERTAG(new_tag, rnode, forkNum, blockNum);
+    new_hash = BufTableHashCode(&new_tag);
+    new_partition_lock = BufMappingPartitionLock(new_hash);
+
+    (void)LWLockAcquire(new_partition_lock, LW_SHARED);
+    buf_id = BufTableLookup(&new_tag, new_hash);
+    LWLockRelease(new_partition_lock);
+
+    if (buf_id < 0) {
+        SMgrRelation smgr = smgropen(rnode, InvalidBackendId);
+        smgrprefetch(smgr, forkNum, blockNum);
+        return true;
+    }
+#endif /* USE_PREFETCH && USE_POSIX_FADVISE */
+    return false;
+}
+
 /*
  * @Description: ConditionalStartBufferIO: conditionally begin and Asynchronous Prefetch or
  * WriteBack I/O on this buffer.
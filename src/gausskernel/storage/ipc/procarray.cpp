@@ -4541,6 +4541,25 @@ static volatile snapxid_t* g_snap_current = NULL;
  */
 static volatile snapxid_t* g_snap_next = NULL;
 
+/*
+ * bumped after g_snap_current moves to a newly computed snapshot
+ */
+static volatile uint64 g_snap_version = 0;
+
+/*
+ * A copy of the last snapshot this thread took from the ring buffer.  While
+ * g_snap_version has not moved no transaction has ended since, so the copy is
+ * still the current snapshot and can be handed out again without pinning its
+ * slot, which would otherwise bounce the slot's refcount between all readers.
+ */
+typedef struct SnapXidCache {
+    bool valid;
+    uint64 version;
+    snapxid_t snap;
+} SnapXidCache;
+
+static THR_LOCAL SnapXidCache t_snap_cache = {false, 0, {0}};
+
 /*
  * Report shared-memory space needed by CreateSharedRingBuffer.
  */
@@ -4664,6 +4683,7 @@ static void SetNextSnapXid()
     if (g_snap_buffer != NULL) {
         g_snap_current = g_snap_next;
         pg_write_barrier();
+        g_snap_version++;
         g_snap_assigned = true;
         snapxid_t* ret = (snapxid_t*)g_snap_current;
         size_t idx = SNAPXID_INDEX(ret);
@@ -4735,35 +4755,15 @@ public:
 };
 #endif
 
-Snapshot GetLocalSnapshotData(Snapshot snapshot)
+/*
+ * fill snapshot and the session's xmin horizons from a ring buffer snapshot
+ */
+static void SetSnapshotFromSnapXid(Snapshot snapshot, const snapxid_t* snapxid)
 {
-    /* if first here, fallback to original code */
-    if (!g_snap_assigned || (g_snap_buffer == NULL)) {
-        ereport(DEBUG1, (errmsg("Falling back to origin GetSnapshotData: not assigned yet or during shutdown\n")));
-        return NULL;
-    }
-    pg_read_barrier();
-    HOLD_INTERRUPTS();
-    /* 1. increase ref-count of current snapshot in ring buffer */
-    snapxid_t* snapxid = GetCurrentSnapXid();
-
-#ifdef USE_ASSERT_CHECKING
-    AutoSnapId snapid;
-#endif
-
-    /* save use_data for release */
-    snapshot->user_data = snapxid;
-
-    /* 2. copy from pre-computed snapshot arrays into return param snapshot */
     snapshot->takenDuringRecovery = snapxid->takenDuringRecovery;
 
     TransactionId replication_slot_xmin = g_instance.proc_array_idx->replication_slot_xmin;
 
-    if (!TransactionIdIsValid(t_thrd.pgxact->xmin)) {
-        t_thrd.pgxact->xmin = u_sess->utils_cxt.TransactionXmin = snapxid->xmin;
-        t_thrd.pgxact->handle = GetCurrentTransactionHandleIfAny();
-    }
-
     if (TransactionIdPrecedes(snapxid->localxmin, (uint64)u_sess->attr.attr_storage.vacuum_defer_cleanup_age)) {
         u_sess->utils_cxt.RecentGlobalXmin = FirstNormalTransactionId;
     } else {
@@ -4791,6 +4791,88 @@ Snapshot GetLocalSnapshotData(Snapshot snapshot)
     snapshot->copied = false;
     /* Non-catalog tables can be vacuumed if older than this xid */
     u_sess->utils_cxt.RecentGlobalDataXmin = u_sess->utils_cxt.RecentGlobalXmin;
+}
+
+/*
+ * Hand out the snapshot cached by the last GetLocalSnapshotData call of this
+ * thread if no newer one has been published since.  Returns false if the
+ * caller has to take it from the ring buffer.
+ */
+static bool GetCachedLocalSnapshotData(Snapshot snapshot)
+{
+    uint64 version = g_snap_version;
+
+    pg_read_barrier();
+    if (!t_snap_cache.valid || t_snap_cache.version != version) {
+        return false;
+    }
+
+    if (!TransactionIdIsValid(t_thrd.pgxact->xmin)) {
+        t_thrd.pgxact->xmin = u_sess->utils_cxt.TransactionXmin = t_snap_cache.snap.xmin;
+
+        /*
+         * Nothing pins the cached slot, so a snapshot computed from now on
+         * must see our xmin in the proc array.  The one being computed right
+         * now starts from the current xmin, which is ours as long as the
+         * version did not move; otherwise withdraw and go the slow way.
+         */
+        pg_memory_barrier();
+        if (g_snap_version != version) {
+            t_thrd.pgxact->xmin = u_sess->utils_cxt.TransactionXmin = InvalidTransactionId;
+            t_snap_cache.valid = false;
+            return false;
+        }
+        t_thrd.pgxact->handle = GetCurrentTransactionHandleIfAny();
+    }
+
+    SetSnapshotFromSnapXid(snapshot, &t_snap_cache.snap);
+    snapshot->user_data = NULL;
+    return true;
+}
+
+Snapshot GetLocalSnapshotData(Snapshot snapshot)
+{
+    /* if first here, fallback to original code */
+    if (!g_snap_assigned || (g_snap_buffer == NULL)) {
+        ereport(DEBUG1, (errmsg("Falling back to origin GetSnapshotData: not assigned yet or during shutdown\n")));
+        return NULL;
+    }
+
+    /* no transaction ended since our last snapshot, reuse it */
+    if (GetCachedLocalSnapshotData(snapshot)) {
+        return snapshot;
+    }
+
+    uint64 version = g_snap_version;
+    pg_read_barrier();
+    HOLD_INTERRUPTS();
+    /* 1. increase ref-count of current snapshot in ring buffer */
+    snapxid_t* snapxid = GetCurrentSnapXid();
+
+#ifdef USE_ASSERT_CHECKING
+    AutoSnapId snapid;
+#endif
+
+    /* save use_data for release */
+    snapshot->user_data = snapxid;
+
+    if (!TransactionIdIsValid(t_thrd.pgxact->xmin)) {
+        t_thrd.pgxact->xmin = u_sess->utils_cxt.TransactionXmin = snapxid->xmin;
+        t_thrd.pgxact->handle = GetCurrentTransactionHandleIfAny();
+    }
+
+    /* 2. copy from pre-computed snapshot arrays into return param snapshot */
+    SetSnapshotFromSnapXid(snapshot, snapxid);
+
+    /* 3. remember it for the next call, unless a newer one came in meanwhile */
+    t_snap_cache.snap.xmin = snapxid->xmin;
+    t_snap_cache.snap.xmax = snapxid->xmax;
+    t_snap_cache.snap.snapshotcsn = snapxid->snapshotcsn;
+    t_snap_cache.snap.localxmin = snapxid->localxmin;
+    t_snap_cache.snap.takenDuringRecovery = snapxid->takenDuringRecovery;
+    pg_read_barrier();
+    t_snap_cache.version = version;
+    t_snap_cache.valid = (g_snap_version == version);
 
     ReleaseSnapXid(snapxid);
     snapshot->user_data = NULL;
@@ -816,6 +816,10 @@ static LockAcquireResult LockAcquireExtendedXC(const LOCKTAG *locktag, LOCKMODE
         else {
             FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
             acquired = FastPathGrantRelationLock(tag, lockmode);
+            if (acquired)
+                t_thrd.proc->fpGrants++;
+            else
+                t_thrd.proc->fpGroupFull++;
         }
 
         LWLockRelease(t_thrd.proc->backendLock);
@@ -1309,7 +1313,14 @@ int LockCheckConflicts(LockMethod lockMethodTable, LOCKMODE lockmode, LOCK *lock
     myLocks = proclock->holdMask;
     otherLocks = 0;
 
-    bool inLockGroup = (proclock->groupLeader != t_thrd.proc || t_thrd.proc->lockGroupLeader != NULL);
+    /*
+     * Relation extension locks still conflict inside a lock group: parallel
+     * COPY workers extend the same relation, and letting them in together
+     * would hand out the same new block twice.  Holders never wait for other
+     * heavyweight locks, so this can't make the group deadlock on itself.
+     */
+    bool inLockGroup = (proclock->groupLeader != t_thrd.proc || t_thrd.proc->lockGroupLeader != NULL) &&
+        (lock->tag.locktag_type != LOCKTAG_RELATION_EXTEND);
     for (i = 1; i <= numLockModes; i++) {
         int myHolding = (myLocks & LOCKBIT_ON((unsigned int)i)) ? 1 : 0;
 
@@ -2458,6 +2469,24 @@ void LockReassignCurrentOwner(void)
     }
 }
 
+/*
+ * FastPathSlotRange
+ *		Set [*first, *end) to the fast-path slots the lock on tag may use.
+ */
+static inline void FastPathSlotRange(const FastPathTag &tag, uint32 *first, uint32 *end)
+{
+    uint32 ngroups = FP_LOCK_GROUPS_PER_BACKEND;
+    uint32 group = 0;
+
+    if (ngroups > 1) {
+        /* partitions of one table have consecutive oids, keep them apart */
+        group = (tag.relid * 0x9E3779B1U + tag.partitionid) % ngroups;
+    }
+
+    *first = group * FP_LOCK_SLOTS_PER_GROUP;
+    *end = (group == ngroups - 1) ? FP_LOCK_SLOTS_PER_BACKEND : *first + FP_LOCK_SLOTS_PER_GROUP;
+}
+
 /*
  * FastPathGrantRelationLock
  *		Grant lock using per-backend fast-path array, if there is space.
@@ -2465,10 +2494,14 @@ void LockReassignCurrentOwner(void)
 static bool FastPathGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
 {
     uint32 f;
+    uint32 first;
+    uint32 end;
     uint32 unused_slot = FP_LOCK_SLOTS_PER_BACKEND;
 
+    FastPathSlotRange(tag, &first, &end);
+
     /* Scan for existing entry for this relid, remembering empty slot. */
-    for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+    for (f = first; f < end; f++) {
         if (FAST_PATH_GET_BITS(t_thrd.proc, f) == 0)
             unused_slot = f;
         else if (FAST_PATH_TAG_EQUALS(t_thrd.proc->fpRelId[f], tag)) {
@@ -2498,20 +2531,37 @@ static bool FastPathGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
 static bool FastPathUnGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
 {
     uint32 f;
-    bool result = false;
+    uint32 first;
+    uint32 end;
 
-    t_thrd.storage_cxt.FastPathLocalUseCount = 0;
-    for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+    FastPathSlotRange(tag, &first, &end);
+
+    for (f = first; f < end; f++) {
         if (FAST_PATH_TAG_EQUALS(t_thrd.proc->fpRelId[f], tag) && FAST_PATH_CHECK_LOCKMODE(t_thrd.proc, f, lockmode)) {
-            Assert(!result);
             FAST_PATH_CLEAR_LOCKMODE(t_thrd.proc, f, lockmode);
-            result = true;
-            /* we continue iterating so as to update FastPathLocalUseCount */
+
+            /*
+             * Slots emptied by FastPathTransferRelationLocks in other backends
+             * are never counted out, so the count can be too high.  That
+             * matters once it reaches FP_LOCK_SLOTS_PER_BACKEND, since
+             * LockAcquireExtended then stops trying the fast path at all;
+             * recount in that case, and otherwise just count this slot out.
+             */
+            if (FAST_PATH_GET_BITS(t_thrd.proc, f) == 0 && t_thrd.storage_cxt.FastPathLocalUseCount > 0)
+                --t_thrd.storage_cxt.FastPathLocalUseCount;
+            if ((uint32)t_thrd.storage_cxt.FastPathLocalUseCount + 1 >= FP_LOCK_SLOTS_PER_BACKEND) {
+                uint32 used = 0;
+
+                for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+                    if (FAST_PATH_GET_BITS(t_thrd.proc, f) != 0)
+                        used++;
+                }
+                t_thrd.storage_cxt.FastPathLocalUseCount = (int)used;
+            }
+            return true;
         }
-        if (FAST_PATH_GET_BITS(t_thrd.proc, f) != 0)
-            ++t_thrd.storage_cxt.FastPathLocalUseCount;
     }
-    return result;
+    return false;
 }
 
 /*
@@ -2533,13 +2583,19 @@ static bool FastPathTransferRelationLocks(LockMethod lockMethodTable, const LOCK
      * outstanding fast-path locks held by prepared transactions are
      * transferred to the main lock table.
      */
+    uint32 first;
+    uint32 end;
+    uint64 transferred = 0;
+
+    FastPathSlotRange(tag, &first, &end);
+
     for (i = 0; i < g_instance.proc_base->allNonPreparedProcCount; i++) {
         PGPROC *proc = g_instance.proc_base_all_procs[i];
         uint32 f;
 
         LWLockAcquire(proc->backendLock, LW_EXCLUSIVE);
 
-        for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+        for (f = first; f < end; f++) {
             uint32 lockmode;
 
             /* Look for an allocated slot matching the given relid. */
@@ -2561,6 +2617,7 @@ static bool FastPathTransferRelationLocks(LockMethod lockMethodTable, const LOCK
                 }
                 GrantLock(proclock->tag.myLock, proclock, lockmode);
                 FAST_PATH_CLEAR_LOCKMODE(proc, f, lockmode);
+                transferred++;
             }
             LWLockRelease(partitionLock);
 
@@ -2569,6 +2626,12 @@ static bool FastPathTransferRelationLocks(LockMethod lockMethodTable, const LOCK
         }
         LWLockRelease(proc->backendLock);
     }
+
+    if (transferred > 0) {
+        LWLockAcquire(t_thrd.proc->backendLock, LW_EXCLUSIVE);
+        t_thrd.proc->fpTransferred += transferred;
+        LWLockRelease(t_thrd.proc->backendLock);
+    }
     return true;
 }
 
@@ -2585,10 +2648,14 @@ static PROCLOCK *FastPathGetRelationLockEntry(LOCALLOCK *locallock)
     LWLock *partitionLock = LockHashPartitionLock(locallock->hashcode);
     FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
     uint32 f;
+    uint32 first;
+    uint32 end;
+
+    FastPathSlotRange(tag, &first, &end);
 
     LWLockAcquire(t_thrd.proc->backendLock, LW_EXCLUSIVE);
 
-    for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+    for (f = first; f < end; f++) {
         uint32 lockmode;
 
         /* Look for an allocated slot matching the given relid. */
@@ -2708,6 +2775,10 @@ VirtualTransactionId *GetLockConflicts(const LOCKTAG *locktag, LOCKMODE lockmode
         int i;
         FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
         VirtualTransactionId vxid;
+        uint32 first;
+        uint32 end;
+
+        FastPathSlotRange(tag, &first, &end);
 
         /*
          * Iterate over relevant PGPROCs.  Anything held by a prepared
@@ -2729,7 +2800,7 @@ VirtualTransactionId *GetLockConflicts(const LOCKTAG *locktag, LOCKMODE lockmode
 
             LWLockAcquire(proc->backendLock, LW_SHARED);
 
-            for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+            for (f = first; f < end; f++) {
                 uint32 lockmask;
 
                 /* Look for an allocated slot matching the given relid. */
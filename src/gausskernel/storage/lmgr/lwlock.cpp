@@ -115,6 +115,25 @@
 
 #define LWLOCK_TRANCHE_SIZE 128
 
+/*
+ * Bounds of the number of times LWLockAcquire polls a busy lock before it
+ * queues itself and sleeps, see LWLockSpinAcquire.  The upper bound is the
+ * lwlock_max_spins GUC.
+ */
+#define MIN_LWLOCK_SPINS 10
+#define DEFAULT_LWLOCK_SPINS 100
+#define LWLOCK_SPINS_STEP 20
+
+/* online CPUs, 0 until first needed; spinning is pointless on a single CPU */
+static volatile int lwlock_spin_cpus = 0;
+
+/*
+ * Current spin budget of each built-in tranche, 0 until first used.  Shared
+ * by all threads and updated without locking; a lost update only makes the
+ * budget adapt a little slower.
+ */
+static volatile uint16 lwlock_tranche_spins[LWTRANCHE_NATIVE_TRANCHE_NUM];
+
 const char **LWLockTrancheArray = NULL;
 int LWLockTranchesAllocated = 0;
 
@@ -216,6 +235,7 @@ typedef struct lwlock_stats {
     int block_count;
     int dequeue_self_count;
     int spin_delay_count;
+    int spin_acquire_count;
 } lwlock_stats;
 
 static HTAB *lwlock_stats_htab;
@@ -304,13 +324,14 @@ static void print_lwlock_stats(int code, Datum arg)
 
     while ((lwstats = (lwlock_stats*)hash_seq_search(&scan)) != NULL) {
         fprintf(stderr,
-                "PID %d lwlock %s: shacq %d exacq %d blk %d spindelay %d dequeue self %d\n",
+                "PID %d lwlock %s: shacq %d exacq %d blk %d spindelay %d spinacq %d dequeue self %d\n",
                 t_thrd.proc_cxt.MyProcPid,
                 LWLockTrancheArray[lwstats->key.tranche]->name,
                 lwstats->sh_acquire_count,
                 lwstats->ex_acquire_count,
                 lwstats->block_count,
                 lwstats->spin_delay_count,
+                lwstats->spin_acquire_count,
                 lwstats->dequeue_self_count);
     }
 
@@ -342,6 +363,7 @@ static lwlock_stats *get_lwlock_stats_entry(LWLock *lock)
         lwstats->block_count = 0;
         lwstats->dequeue_self_count = 0;
         lwstats->spin_delay_count = 0;
+        lwstats->spin_acquire_count = 0;
     }
     return lwstats;
 }
@@ -898,6 +920,87 @@ static bool LWLockAttemptLock(LWLock *lock, LWLockMode mode)
     }
 }
 
+/* Store a new spin budget, without dirtying the shared cache line if unchanged. */
+static inline void LWLockSetSpins(uint16 tranche, int budget, int new_budget)
+{
+    if (new_budget != budget || lwlock_tranche_spins[tranche] != budget) {
+        lwlock_tranche_spins[tranche] = (uint16)new_budget;
+    }
+}
+
+/*
+ * Poll a lock we just failed to get for a while before going to sleep on it.
+ * Most LWLocks are held for a few hundred instructions, and queueing plus a
+ * semaphore round trip costs far more than that.  Returns true if we got the
+ * lock.
+ *
+ * The number of polls adapts per tranche: getting the lock by spinning
+ * raises the budget by LWLOCK_SPINS_STEP, having to sleep anyway cuts a
+ * quarter of it.  The budget thus settles where spinning pays off, roughly
+ * 80 * p / (1 - p) polls for a success rate p, instead of sticking at the
+ * maximum as soon as most spins succeed.  Tranches whose locks are held
+ * across I/O drop to the minimum within a few sleeps.  Only built-in tranches
+ * are tracked.
+ *
+ * We do not spin when lwlock_max_spins is 0, on a single CPU where the holder
+ * cannot run while we poll, or when others already sleep on the lock: it is
+ * contended beyond what a short spin can absorb, and the lock should go to
+ * the queued waiters rather than to a newcomer.
+ */
+static bool LWLockSpinAcquire(LWLock *lock, LWLockMode mode)
+{
+    uint16 tranche = lock->tranche;
+    int max_spins = g_instance.attr.attr_storage.lwlock_max_spins;
+    int budget;
+
+    if (tranche >= LWTRANCHE_NATIVE_TRANCHE_NUM || max_spins == 0) {
+        return false;
+    }
+
+    if (lwlock_spin_cpus == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        lwlock_spin_cpus = Max((int)sysconf(_SC_NPROCESSORS_ONLN), 1);
+#else
+        lwlock_spin_cpus = 2;
+#endif
+    }
+    if (lwlock_spin_cpus == 1) {
+        return false;
+    }
+
+    budget = lwlock_tranche_spins[tranche];
+    if (budget == 0) {
+        budget = DEFAULT_LWLOCK_SPINS;
+    }
+    budget = Min(budget, max_spins);
+
+    for (int spins = 0; spins < budget; spins++) {
+        uint32 state;
+        bool lock_free = false;
+
+        SPIN_DELAY();
+
+        /* only go for the cache line exclusively when it looks worthwhile */
+        state = pg_atomic_read_u32(&lock->state);
+        if (state & LW_FLAG_HAS_WAITERS) {
+            return false;
+        }
+        if (mode == LW_EXCLUSIVE) {
+            lock_free = ((state & LW_LOCK_MASK) == 0);
+        } else {
+            lock_free = ((state & LW_VAL_EXCLUSIVE) == 0);
+        }
+
+        if (lock_free && !LWLockAttemptLock(lock, mode)) {
+            LWLockSetSpins(tranche, budget, Min(budget + LWLOCK_SPINS_STEP, max_spins));
+            return true;
+        }
+    }
+
+    LWLockSetSpins(tranche, budget, Max(budget - budget / 4, Min(MIN_LWLOCK_SPINS, max_spins)));
+    return false;
+}
+
 /*
  * Lock the LWLock's wait list against concurrent activity.
  *
@@ -1343,6 +1446,15 @@ bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid)
             break; /* got the lock */
         }
 
+        /* the holder may be about to release it, spin before the first sleep */
+        if (result && LWLockSpinAcquire(lock, mode)) {
+            LOG_LWDEBUG("LWLockAcquire", lock, "acquired after spinning");
+#ifdef LWLOCK_STATS
+            lwstats->spin_acquire_count++;
+#endif
+            break;
+        }
+
         instr_stmt_report_lock(LWLOCK_WAIT_START, mode, NULL, lock->tranche);
         pgstat_report_waitevent(PG_WAIT_LWLOCK | lock->tranche);
         /*
@@ -836,6 +836,9 @@ void InitProcess(void)
     t_thrd.proc->fpVXIDLock = false;
     t_thrd.proc->fpLocalTransactionId = InvalidLocalTransactionId;
     FAST_PATH_SET_LOCKBITS_ZERO(t_thrd.proc);
+    t_thrd.proc->fpGrants = 0;
+    t_thrd.proc->fpGroupFull = 0;
+    t_thrd.proc->fpTransferred = 0;
     t_thrd.proc->commitCSN = 0;
     t_thrd.pgxact->handle = InvalidTransactionHandle;
     t_thrd.pgxact->xid = InvalidTransactionId;
@@ -890,6 +893,7 @@ void InitProcess(void)
     t_thrd.proc->syncRepInCompleteQueue = false;
     t_thrd.proc->syncSetConfirmedLSN = 0;
     SHMQueueElemInit(&(t_thrd.proc->syncRepLinks));
+    t_thrd.proc->replayWaitLSN = InvalidXLogRecPtr;
 
     /* Initialize fields for data sync rep */
     t_thrd.proc->waitDataSyncPoint.queueid = 0;
@@ -1100,6 +1104,9 @@ void InitAuxiliaryProcess(void)
     t_thrd.proc->lxid = InvalidLocalTransactionId;
     t_thrd.proc->fpVXIDLock = false;
     t_thrd.proc->fpLocalTransactionId = InvalidLocalTransactionId;
+    t_thrd.proc->fpGrants = 0;
+    t_thrd.proc->fpGroupFull = 0;
+    t_thrd.proc->fpTransferred = 0;
     t_thrd.pgxact->handle = InvalidTransactionHandle;
     t_thrd.pgxact->xid = InvalidTransactionId;
     t_thrd.pgxact->next_xid = InvalidTransactionId;
@@ -0,0 +1,1618 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * art_index.cpp
+ *    Primary index implementation using an Adaptive Radix Tree with optimistic lock coupling.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/storage/index/art_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "art_index.h"
+#include "mot_engine.h"
+#include "mot_atomic_ops.h"
+#include "object_pool_compact.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(ArtPrimaryIndex, Storage);
+
+/** @var Version bit of a node that was unlinked from the tree. */
+static constexpr uint64_t ART_OBSOLETE_BIT = 0x1;
+
+/** @var Version bit of a node locked for writing. */
+static constexpr uint64_t ART_LOCKED_BIT = 0x2;
+
+/** @var Number of prefix bytes stored in a node. Longer prefixes are completed from any leaf below the node. */
+static constexpr uint32_t ART_MAX_STORED_PREFIX = 8;
+
+/** @var Number of children in a node with up to 48 children. */
+static constexpr uint32_t ART_NODE48_CAPACITY = 48;
+
+/** @var Number of children in a node with 256 children. */
+static constexpr uint32_t ART_NODE256_CAPACITY = 256;
+
+/** @var Scan result codes. */
+static constexpr int ART_SCAN_CONTINUE = 0;
+static constexpr int ART_SCAN_FULL = 1;
+static constexpr int ART_SCAN_RESTART = 2;
+
+struct ArtPrimaryIndex::ArtLeaf {
+    /** @var The primary sentinel mapped to the key. */
+    Sentinel* m_sentinel;
+
+    /** @var The full key (index key length bytes). */
+    uint8_t m_key[0];
+};
+
+struct ArtPrimaryIndex::ArtNode {
+    /** @var Version word: incremented on every modification, also holding the lock and obsolete bits. */
+    std::atomic<uint64_t> m_version;
+
+    /** @var Length of the compressed path of the node (only the first bytes are stored). */
+    uint32_t m_prefixCount;
+
+    /** @var Number of children. */
+    uint16_t m_count;
+
+    /** @var Node type. */
+    ArtNodeType m_type;
+
+    /** @var The first bytes of the compressed path. */
+    uint8_t m_prefix[ART_MAX_STORED_PREFIX];
+
+    explicit ArtNode(ArtNodeType type) : m_version(0), m_prefixCount(0), m_count(0), m_type(type)
+    {}
+
+    // tagged child pointers: leafs are marked by the lowest bit
+    static inline bool IsLeaf(const ArtNode* node)
+    {
+        return ((reinterpret_cast<uintptr_t>(node) & 1) != 0);
+    }
+
+    static inline ArtLeaf* ToLeaf(const ArtNode* node)
+    {
+        return reinterpret_cast<ArtLeaf*>(reinterpret_cast<uintptr_t>(node) & ~static_cast<uintptr_t>(1));
+    }
+
+    static inline ArtNode* FromLeaf(const ArtLeaf* leaf)
+    {
+        return reinterpret_cast<ArtNode*>(reinterpret_cast<uintptr_t>(leaf) | 1);
+    }
+
+    // optimistic lock coupling
+    inline uint64_t ReadLockOrRestart(bool& restart) const
+    {
+        uint64_t version = m_version.load(std::memory_order_acquire);
+        while ((version & ART_LOCKED_BIT) != 0) {
+            PAUSE;
+            version = m_version.load(std::memory_order_acquire);
+        }
+        if ((version & ART_OBSOLETE_BIT) != 0) {
+            restart = true;
+        }
+        return version;
+    }
+
+    inline void ReadUnlockOrRestart(uint64_t version, bool& restart) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (version != m_version.load(std::memory_order_relaxed)) {
+            restart = true;
+        }
+    }
+
+    inline void UpgradeToWriteLockOrRestart(uint64_t& version, bool& restart)
+    {
+        if (m_version.compare_exchange_strong(version, version + ART_LOCKED_BIT, std::memory_order_acquire)) {
+            version += ART_LOCKED_BIT;
+        } else {
+            restart = true;
+        }
+    }
+
+    inline void WriteLockOrRestart(bool& restart)
+    {
+        uint64_t version = ReadLockOrRestart(restart);
+        if (!restart) {
+            UpgradeToWriteLockOrRestart(version, restart);
+        }
+    }
+
+    inline void WriteUnlock()
+    {
+        (void)m_version.fetch_add(ART_LOCKED_BIT, std::memory_order_release);
+    }
+
+    inline void WriteUnlockObsolete()
+    {
+        (void)m_version.fetch_add(ART_LOCKED_BIT | ART_OBSOLETE_BIT, std::memory_order_release);
+    }
+
+    // compressed path
+    inline void SetPrefix(const uint8_t* prefix, uint32_t prefixCount)
+    {
+        uint32_t storedCount = std::min(prefixCount, ART_MAX_STORED_PREFIX);
+        if (storedCount > 0) {
+            errno_t erc = memcpy_s(m_prefix, ART_MAX_STORED_PREFIX, prefix, storedCount);
+            securec_check(erc, "\0", "\0");
+        }
+        m_prefixCount = prefixCount;
+    }
+
+    /** @brief Prepends the prefix of a removed parent node and the key byte that led to this node. */
+    inline void AddPrefixBefore(const ArtNode* node, uint8_t key)
+    {
+        errno_t erc;
+        uint32_t copyCount = std::min(ART_MAX_STORED_PREFIX, node->m_prefixCount + 1);
+        uint32_t keepCount = std::min(m_prefixCount, ART_MAX_STORED_PREFIX - copyCount);
+        if (keepCount > 0) {
+            erc = memmove_s(m_prefix + copyCount, ART_MAX_STORED_PREFIX - copyCount, m_prefix, keepCount);
+            securec_check(erc, "\0", "\0");
+        }
+        uint32_t parentCount = std::min(copyCount, node->m_prefixCount);
+        if (parentCount > 0) {
+            erc = memcpy_s(m_prefix, ART_MAX_STORED_PREFIX, node->m_prefix, parentCount);
+            securec_check(erc, "\0", "\0");
+        }
+        if (node->m_prefixCount < ART_MAX_STORED_PREFIX) {
+            m_prefix[copyCount - 1] = key;
+        }
+        m_prefixCount += node->m_prefixCount + 1;
+    }
+
+    /**
+     * @brief Optimistically compares the stored prefix with a key and advances the level past the prefix.
+     * Prefix bytes that are not stored in the node are verified later against the leaf.
+     */
+    inline bool CheckPrefix(const uint8_t* key, uint32_t& level, uint32_t keyLength, bool& restart) const
+    {
+        uint32_t prefixCount = m_prefixCount;
+        if (level + prefixCount >= keyLength) {
+            // torn read of a concurrently modified node
+            restart = true;
+            return false;
+        }
+        uint32_t storedCount = std::min(prefixCount, ART_MAX_STORED_PREFIX);
+        for (uint32_t i = 0; i < storedCount; ++i) {
+            if (m_prefix[i] != key[level + i]) {
+                return false;
+            }
+        }
+        level += prefixCount;
+        return true;
+    }
+
+    // children access, dispatched according to the node type
+    inline ArtNode* FindChild(uint8_t key) const;
+    inline ArtNode* GetNextChild(uint32_t from, bool forward, uint8_t& childKey) const;
+    inline ArtNode* GetAnyChild() const;
+    inline ArtNode* GetSecondChild(uint8_t key, uint8_t& childKey) const;
+    inline void InsertChild(uint8_t key, ArtNode* child);
+    inline void RemoveChild(uint8_t key);
+    inline void ChangeChild(uint8_t key, ArtNode* child);
+    inline void CopyChildrenTo(ArtNode* dest) const;
+    inline bool IsFull() const;
+    inline bool IsUnderfull() const;
+
+    /** @brief Retrieves any leaf below the node, used to complete prefixes longer than the stored bytes. */
+    ArtLeaf* GetAnyLeaf(bool& restart) const
+    {
+        const ArtNode* node = this;
+        while (true) {
+            uint64_t version = node->ReadLockOrRestart(restart);
+            if (restart) {
+                return nullptr;
+            }
+            ArtNode* child = node->GetAnyChild();
+            node->ReadUnlockOrRestart(version, restart);
+            if (restart) {
+                return nullptr;
+            }
+            if (child == nullptr) {
+                // only the root may be empty, and it has no prefix
+                restart = true;
+                return nullptr;
+            }
+            if (IsLeaf(child)) {
+                return ToLeaf(child);
+            }
+            node = child;
+        }
+    }
+};
+
+template <uint32_t CAPACITY>
+struct ArtPrimaryIndex::ArtSortedNode : public ArtPrimaryIndex::ArtNode {
+    /** @var Key bytes of the children in ascending order. */
+    uint8_t m_keys[CAPACITY];
+
+    /** @var Children matching the key bytes. */
+    std::atomic<ArtNode*> m_children[CAPACITY];
+
+    ArtSortedNode() : ArtNode(CAPACITY == 4 ? ArtNodeType::ART_NODE_4 : ArtNodeType::ART_NODE_16)
+    {
+        for (uint32_t i = 0; i < CAPACITY; ++i) {
+            m_keys[i] = 0;
+            m_children[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    inline uint32_t Count() const
+    {
+        // guard against torn reads, the caller validates the node version
+        return std::min(static_cast<uint32_t>(m_count), CAPACITY);
+    }
+
+    inline ArtNode* FindChild(uint8_t key) const
+    {
+        uint32_t count = Count();
+        for (uint32_t i = 0; i < count; ++i) {
+            if (m_keys[i] == key) {
+                return m_children[i].load(std::memory_order_acquire);
+            }
+        }
+        return nullptr;
+    }
+
+    inline ArtNode* GetNextChild(uint32_t from, bool forward, uint8_t& childKey) const
+    {
+        uint32_t count = Count();
+        if (forward) {
+            for (uint32_t i = 0; i < count; ++i) {
+                if (m_keys[i] >= from) {
+                    childKey = m_keys[i];
+                    return m_children[i].load(std::memory_order_acquire);
+                }
+            }
+        } else {
+            for (uint32_t i = count; i > 0; --i) {
+                if (m_keys[i - 1] <= from) {
+                    childKey = m_keys[i - 1];
+                    return m_children[i - 1].load(std::memory_order_acquire);
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    inline ArtNode* GetAnyChild() const
+    {
+        ArtNode* anyChild = nullptr;
+        uint32_t count = Count();
+        for (uint32_t i = 0; i < count; ++i) {
+            ArtNode* child = m_children[i].load(std::memory_order_acquire);
+            if (IsLeaf(child)) {
+                return child;
+            }
+            if (anyChild == nullptr) {
+                anyChild = child;
+            }
+        }
+        return anyChild;
+    }
+
+    inline ArtNode* GetSecondChild(uint8_t key, uint8_t& childKey) const
+    {
+        uint32_t count = Count();
+        for (uint32_t i = 0; i < count; ++i) {
+            if (m_keys[i] != key) {
+                childKey = m_keys[i];
+                return m_children[i].load(std::memory_order_acquire);
+            }
+        }
+        return nullptr;
+    }
+
+    inline void InsertChild(uint8_t key, ArtNode* child)
+    {
+        MOT_ASSERT(m_count < CAPACITY);
+        uint32_t pos = 0;
+        while (pos < m_count && m_keys[pos] < key) {
+            ++pos;
+        }
+        for (uint32_t i = m_count; i > pos; --i) {
+            m_keys[i] = m_keys[i - 1];
+            m_children[i].store(m_children[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        m_keys[pos] = key;
+        m_children[pos].store(child, std::memory_order_release);
+        ++m_count;
+    }
+
+    inline void RemoveChild(uint8_t key)
+    {
+        for (uint32_t pos = 0; pos < m_count; ++pos) {
+            if (m_keys[pos] == key) {
+                for (uint32_t i = pos + 1; i < m_count; ++i) {
+                    m_keys[i - 1] = m_keys[i];
+                    m_children[i - 1].store(m_children[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+                --m_count;
+                m_children[m_count].store(nullptr, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    inline void ChangeChild(uint8_t key, ArtNode* child)
+    {
+        for (uint32_t i = 0; i < m_count; ++i) {
+            if (m_keys[i] == key) {
+                m_children[i].store(child, std::memory_order_release);
+                return;
+            }
+        }
+        MOT_ASSERT(false);
+    }
+
+    inline void CopyChildrenTo(ArtNode* dest) const
+    {
+        for (uint32_t i = 0; i < m_count; ++i) {
+            dest->InsertChild(m_keys[i], m_children[i].load(std::memory_order_relaxed));
+        }
+    }
+};
+
+struct ArtPrimaryIndex::ArtNode48 : public ArtPrimaryIndex::ArtNode {
+    /** @var Position of the child of each key byte, or ART_NODE48_CAPACITY if there is no such child. */
+    uint8_t m_childIndex[ART_NODE256_CAPACITY];
+
+    /** @var Unordered children. */
+    std::atomic<ArtNode*> m_children[ART_NODE48_CAPACITY];
+
+    ArtNode48() : ArtNode(ArtNodeType::ART_NODE_48)
+    {
+        errno_t erc = memset_s(m_childIndex, sizeof(m_childIndex), ART_NODE48_CAPACITY, sizeof(m_childIndex));
+        securec_check(erc, "\0", "\0");
+        for (uint32_t i = 0; i < ART_NODE48_CAPACITY; ++i) {
+            m_children[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    inline ArtNode* GetChildAt(uint32_t key) const
+    {
+        uint8_t pos = m_childIndex[key];
+        return (pos < ART_NODE48_CAPACITY) ? m_children[pos].load(std::memory_order_acquire) : nullptr;
+    }
+
+    inline ArtNode* FindChild(uint8_t key) const
+    {
+        return GetChildAt(key);
+    }
+
+    inline ArtNode* GetNextChild(uint32_t from, bool forward, uint8_t& childKey) const
+    {
+        if (forward) {
+            for (uint32_t key = from; key < ART_NODE256_CAPACITY; ++key) {
+                ArtNode* child = GetChildAt(key);
+                if (child != nullptr) {
+                    childKey = static_cast<uint8_t>(key);
+                    return child;
+                }
+            }
+        } else {
+            for (uint32_t key = from + 1; key > 0; --key) {
+                ArtNode* child = GetChildAt(key - 1);
+                if (child != nullptr) {
+                    childKey = static_cast<uint8_t>(key - 1);
+                    return child;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    inline ArtNode* GetAnyChild() const
+    {
+        ArtNode* anyChild = nullptr;
+        for (uint32_t i = 0; i < ART_NODE48_CAPACITY; ++i) {
+            ArtNode* child = m_children[i].load(std::memory_order_acquire);
+            if (child != nullptr) {
+                if (IsLeaf(child)) {
+                    return child;
+                }
+                if (anyChild == nullptr) {
+                    anyChild = child;
+                }
+            }
+        }
+        return anyChild;
+    }
+
+    inline void InsertChild(uint8_t key, ArtNode* child)
+    {
+        MOT_ASSERT(m_count < ART_NODE48_CAPACITY);
+        uint32_t pos = m_count;
+        if (m_children[pos].load(std::memory_order_relaxed) != nullptr) {
+            // slots are not compacted on removal
+            pos = 0;
+            while (m_children[pos].load(std::memory_order_relaxed) != nullptr) {
+                ++pos;
+            }
+        }
+        m_children[pos].store(child, std::memory_order_release);
+        m_childIndex[key] = static_cast<uint8_t>(pos);
+        ++m_count;
+    }
+
+    inline void RemoveChild(uint8_t key)
+    {
+        uint8_t pos = m_childIndex[key];
+        MOT_ASSERT(pos < ART_NODE48_CAPACITY);
+        m_childIndex[key] = ART_NODE48_CAPACITY;
+        m_children[pos].store(nullptr, std::memory_order_relaxed);
+        --m_count;
+    }
+
+    inline void ChangeChild(uint8_t key, ArtNode* child)
+    {
+        uint8_t pos = m_childIndex[key];
+        MOT_ASSERT(pos < ART_NODE48_CAPACITY);
+        m_children[pos].store(child, std::memory_order_release);
+    }
+
+    inline void CopyChildrenTo(ArtNode* dest) const
+    {
+        for (uint32_t key = 0; key < ART_NODE256_CAPACITY; ++key) {
+            uint8_t pos = m_childIndex[key];
+            if (pos < ART_NODE48_CAPACITY) {
+                dest->InsertChild(static_cast<uint8_t>(key), m_children[pos].load(std::memory_order_relaxed));
+            }
+        }
+    }
+};
+
+struct ArtPrimaryIndex::ArtNode256 : public ArtPrimaryIndex::ArtNode {
+    /** @var Children indexed by their key byte. */
+    std::atomic<ArtNode*> m_children[ART_NODE256_CAPACITY];
+
+    ArtNode256() : ArtNode(ArtNodeType::ART_NODE_256)
+    {
+        for (uint32_t i = 0; i < ART_NODE256_CAPACITY; ++i) {
+            m_children[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    inline ArtNode* FindChild(uint8_t key) const
+    {
+        return m_children[key].load(std::memory_order_acquire);
+    }
+
+    inline ArtNode* GetNextChild(uint32_t from, bool forward, uint8_t& childKey) const
+    {
+        if (forward) {
+            for (uint32_t key = from; key < ART_NODE256_CAPACITY; ++key) {
+                ArtNode* child = m_children[key].load(std::memory_order_acquire);
+                if (child != nullptr) {
+                    childKey = static_cast<uint8_t>(key);
+                    return child;
+                }
+            }
+        } else {
+            for (uint32_t key = from + 1; key > 0; --key) {
+                ArtNode* child = m_children[key - 1].load(std::memory_order_acquire);
+                if (child != nullptr) {
+                    childKey = static_cast<uint8_t>(key - 1);
+                    return child;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    inline ArtNode* GetAnyChild() const
+    {
+        ArtNode* anyChild = nullptr;
+        for (uint32_t key = 0; key < ART_NODE256_CAPACITY; ++key) {
+            ArtNode* child = m_children[key].load(std::memory_order_acquire);
+            if (child != nullptr) {
+                if (IsLeaf(child)) {
+                    return child;
+                }
+                if (anyChild == nullptr) {
+                    anyChild = child;
+                }
+            }
+        }
+        return anyChild;
+    }
+
+    inline void InsertChild(uint8_t key, ArtNode* child)
+    {
+        m_children[key].store(child, std::memory_order_release);
+        ++m_count;
+    }
+
+    inline void RemoveChild(uint8_t key)
+    {
+        m_children[key].store(nullptr, std::memory_order_relaxed);
+        --m_count;
+    }
+
+    inline void ChangeChild(uint8_t key, ArtNode* child)
+    {
+        m_children[key].store(child, std::memory_order_release);
+    }
+
+    inline void CopyChildrenTo(ArtNode* dest) const
+    {
+        for (uint32_t key = 0; key < ART_NODE256_CAPACITY; ++key) {
+            ArtNode* child = m_children[key].load(std::memory_order_relaxed);
+            if (child != nullptr) {
+                dest->InsertChild(static_cast<uint8_t>(key), child);
+            }
+        }
+    }
+};
+
+#define ART_NODE_DISPATCH(node, call)                                          \
+    switch ((node)->m_type) {                                                  \
+        case ArtNodeType::ART_NODE_4:                                          \
+            return static_cast<ArtNode4*>(node)->call;                         \
+        case ArtNodeType::ART_NODE_16:                                         \
+            return static_cast<ArtNode16*>(node)->call;                        \
+        case ArtNodeType::ART_NODE_48:                                         \
+            return static_cast<ArtNode48*>(node)->call;                        \
+        case ArtNodeType::ART_NODE_256:                                        \
+        default:                                                               \
+            return static_cast<ArtNode256*>(node)->call;                       \
+    }
+
+#define ART_CONST_NODE_DISPATCH(node, call)                                    \
+    switch ((node)->m_type) {                                                  \
+        case ArtNodeType::ART_NODE_4:                                          \
+            return static_cast<const ArtNode4*>(node)->call;                   \
+        case ArtNodeType::ART_NODE_16:                                         \
+            return static_cast<const ArtNode16*>(node)->call;                  \
+        case ArtNodeType::ART_NODE_48:                                         \
+            return static_cast<const ArtNode48*>(node)->call;                  \
+        case ArtNodeType::ART_NODE_256:                                        \
+        default:                                                               \
+            return static_cast<const ArtNode256*>(node)->call;                 \
+    }
+
+inline ArtPrimaryIndex::ArtNode* ArtPrimaryIndex::ArtNode::FindChild(uint8_t key) const
+{
+    ART_CONST_NODE_DISPATCH(this, FindChild(key))
+}
+
+inline ArtPrimaryIndex::ArtNode* ArtPrimaryIndex::ArtNode::GetNextChild(
+    uint32_t from, bool forward, uint8_t& childKey) const
+{
+    ART_CONST_NODE_DISPATCH(this, GetNextChild(from, forward, childKey))
+}
+
+inline ArtPrimaryIndex::ArtNode* ArtPrimaryIndex::ArtNode::GetAnyChild() const
+{
+    ART_CONST_NODE_DISPATCH(this, GetAnyChild())
+}
+
+inline ArtPrimaryIndex::ArtNode* ArtPrimaryIndex::ArtNode::GetSecondChild(uint8_t key, uint8_t& childKey) const
+{
+    MOT_ASSERT(m_type == ArtNodeType::ART_NODE_4);
+    return static_cast<const ArtNode4*>(this)->GetSecondChild(key, childKey);
+}
+
+inline void ArtPrimaryIndex::ArtNode::InsertChild(uint8_t key, ArtNode* child)
+{
+    ART_NODE_DISPATCH(this, InsertChild(key, child))
+}
+
+inline void ArtPrimaryIndex::ArtNode::RemoveChild(uint8_t key)
+{
+    ART_NODE_DISPATCH(this, RemoveChild(key))
+}
+
+inline void ArtPrimaryIndex::ArtNode::ChangeChild(uint8_t key, ArtNode* child)
+{
+    ART_NODE_DISPATCH(this, ChangeChild(key, child))
+}
+
+inline void ArtPrimaryIndex::ArtNode::CopyChildrenTo(ArtNode* dest) const
+{
+    ART_CONST_NODE_DISPATCH(this, CopyChildrenTo(dest))
+}
+
+inline bool ArtPrimaryIndex::ArtNode::IsFull() const
+{
+    switch (m_type) {
+        case ArtNodeType::ART_NODE_4:
+            return (m_count == 4);
+        case ArtNodeType::ART_NODE_16:
+            return (m_count == 16);
+        case ArtNodeType::ART_NODE_48:
+            return (m_count == ART_NODE48_CAPACITY);
+        case ArtNodeType::ART_NODE_256:
+        default:
+            return false;
+    }
+}
+
+inline bool ArtPrimaryIndex::ArtNode::IsUnderfull() const
+{
+    // the thresholds leave room for the child being removed in the next smaller node type
+    switch (m_type) {
+        case ArtNodeType::ART_NODE_16:
+            return (m_count <= 3);
+        case ArtNodeType::ART_NODE_48:
+            return (m_count <= 12);
+        case ArtNodeType::ART_NODE_256:
+            return (m_count <= 37);
+        case ArtNodeType::ART_NODE_4:
+        default:
+            return false;
+    }
+}
+
+static inline ArtPrimaryIndex::ArtNodeType GrowNodeType(ArtPrimaryIndex::ArtNodeType type)
+{
+    return (type == ArtPrimaryIndex::ArtNodeType::ART_NODE_4)    ? ArtPrimaryIndex::ArtNodeType::ART_NODE_16
+           : (type == ArtPrimaryIndex::ArtNodeType::ART_NODE_16) ? ArtPrimaryIndex::ArtNodeType::ART_NODE_48
+                                                                 : ArtPrimaryIndex::ArtNodeType::ART_NODE_256;
+}
+
+static inline ArtPrimaryIndex::ArtNodeType ShrinkNodeType(ArtPrimaryIndex::ArtNodeType type)
+{
+    return (type == ArtPrimaryIndex::ArtNodeType::ART_NODE_256)  ? ArtPrimaryIndex::ArtNodeType::ART_NODE_48
+           : (type == ArtPrimaryIndex::ArtNodeType::ART_NODE_48) ? ArtPrimaryIndex::ArtNodeType::ART_NODE_16
+                                                                 : ArtPrimaryIndex::ArtNodeType::ART_NODE_4;
+}
+
+struct ArtPrimaryIndex::ArtScanContext {
+    /** @var The normalized scan bound. */
+    uint8_t m_bound[MAX_KEY_SIZE];
+
+    /** @var Specifies whether an entry equal to the bound is collected. */
+    bool m_inclusive;
+
+    /** @var Scan direction. */
+    bool m_forward;
+
+    /** @var Output keys. */
+    uint8_t* m_keys;
+
+    /** @var Output sentinels. */
+    Sentinel** m_sentinels;
+
+    /** @var Maximum number of entries to collect. */
+    uint32_t m_capacity;
+
+    /** @var Number of collected entries. */
+    uint32_t m_count;
+};
+
+uint32_t ArtPrimaryIndex::DeallocateFromPoolCallBack(void* gcElement, void* oper, void* aux)
+{
+    LimboElement* elem = reinterpret_cast<LimboElement*>(gcElement);
+    GC_OPERATION_TYPE gcOperType = (*(GC_OPERATION_TYPE*)oper);
+    // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+    ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)elem->m_objectPtr;
+
+    if (gcOperType != GC_OPERATION_TYPE::GC_OPER_DROP_INDEX) {
+        localPoolPtr->Release(elem->m_objectPool);
+    }
+    return localPoolPtr->m_size;
+}
+
+bool ArtPrimaryIndex::InitPools()
+{
+    m_node4Pool = ObjAllocInterface::GetObjPool(sizeof(ArtNode4), false, CACHE_LINE_SIZE);
+    if (!m_node4Pool) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create node4 pool");
+        return false;  // safe cleanup in DestroyPools()
+    }
+
+    m_node16Pool = ObjAllocInterface::GetObjPool(sizeof(ArtNode16), false, CACHE_LINE_SIZE);
+    if (!m_node16Pool) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create node16 pool");
+        return false;  // safe cleanup in DestroyPools()
+    }
+
+    m_node48Pool = ObjAllocInterface::GetObjPool(sizeof(ArtNode48), false, CACHE_LINE_SIZE);
+    if (!m_node48Pool) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create node48 pool");
+        return false;  // safe cleanup in DestroyPools()
+    }
+
+    m_node256Pool = ObjAllocInterface::GetObjPool(sizeof(ArtNode256), false, CACHE_LINE_SIZE);
+    if (!m_node256Pool) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create node256 pool");
+        return false;  // safe cleanup in DestroyPools()
+    }
+
+    m_leafsPool = ObjAllocInterface::GetObjPool(sizeof(ArtLeaf) + m_keyLength, false);
+    if (!m_leafsPool) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create leaf pool");
+        return false;  // safe cleanup in DestroyPools()
+    }
+
+    return true;
+}
+
+void ArtPrimaryIndex::DestroyPools()
+{
+    if (m_node4Pool) {
+        ObjAllocInterface::FreeObjPool(&m_node4Pool);
+        m_node4Pool = NULL;
+    }
+    if (m_node16Pool) {
+        ObjAllocInterface::FreeObjPool(&m_node16Pool);
+        m_node16Pool = NULL;
+    }
+    if (m_node48Pool) {
+        ObjAllocInterface::FreeObjPool(&m_node48Pool);
+        m_node48Pool = NULL;
+    }
+    if (m_node256Pool) {
+        ObjAllocInterface::FreeObjPool(&m_node256Pool);
+        m_node256Pool = NULL;
+    }
+    if (m_leafsPool) {
+        ObjAllocInterface::FreeObjPool(&m_leafsPool);
+        m_leafsPool = NULL;
+    }
+}
+
+RC ArtPrimaryIndex::IndexInitImpl(void** args)
+{
+    if (!InitPools()) {
+        DestroyPools();
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to initialize ART pools");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    m_root = AllocNode(ArtNodeType::ART_NODE_256, nullptr, 0);
+    if (m_root == nullptr) {
+        DestroyPools();
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to allocate ART root node");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    m_initialized = true;
+    return RC_OK;
+}
+
+ObjAllocInterface* ArtPrimaryIndex::GetNodePool(ArtNodeType type) const
+{
+    switch (type) {
+        case ArtNodeType::ART_NODE_4:
+            return m_node4Pool;
+        case ArtNodeType::ART_NODE_16:
+            return m_node16Pool;
+        case ArtNodeType::ART_NODE_48:
+            return m_node48Pool;
+        case ArtNodeType::ART_NODE_256:
+        default:
+            return m_node256Pool;
+    }
+}
+
+ArtPrimaryIndex::ArtNode* ArtPrimaryIndex::AllocNode(ArtNodeType type, const uint8_t* prefix, uint32_t prefixCount)
+{
+    void* buf = GetNodePool(type)->Alloc();
+    if (buf == nullptr) {
+        return nullptr;
+    }
+
+    ArtNode* node = nullptr;
+    switch (type) {
+        case ArtNodeType::ART_NODE_4:
+            node = new (buf) ArtNode4();
+            break;
+        case ArtNodeType::ART_NODE_16:
+            node = new (buf) ArtNode16();
+            break;
+        case ArtNodeType::ART_NODE_48:
+            node = new (buf) ArtNode48();
+            break;
+        case ArtNodeType::ART_NODE_256:
+        default:
+            node = new (buf) ArtNode256();
+            break;
+    }
+    node->SetPrefix(prefix, prefixCount);
+    return node;
+}
+
+ArtPrimaryIndex::ArtLeaf* ArtPrimaryIndex::AllocLeaf(const uint8_t* key, Sentinel* sentinel)
+{
+    ArtLeaf* leaf = static_cast<ArtLeaf*>(m_leafsPool->Alloc());
+    if (leaf == nullptr) {
+        return nullptr;
+    }
+    leaf->m_sentinel = sentinel;
+    errno_t erc = memcpy_s(leaf->m_key, m_keyLength, key, m_keyLength);
+    securec_check(erc, "\0", "\0");
+    return leaf;
+}
+
+void ArtPrimaryIndex::RetireNode(ArtNode* node)
+{
+    ObjAllocInterface* pool = GetNodePool(node->m_type);
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    MOT_ASSERT(gcSession);
+    if (gcSession != nullptr) {
+        // concurrent readers may still traverse the node until the current epoch ends
+        gcSession->GcRecordObject(
+            GC_QUEUE_TYPE::GENERIC_QUEUE, GetIndexId(), (void*)pool, node, DeallocateFromPoolCallBack, pool->m_size);
+    } else {
+        pool->Release(node);
+    }
+}
+
+void ArtPrimaryIndex::RetireLeaf(ArtLeaf* leaf)
+{
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    MOT_ASSERT(gcSession);
+    if (gcSession != nullptr) {
+        gcSession->GcRecordObject(GC_QUEUE_TYPE::GENERIC_QUEUE,
+            GetIndexId(),
+            (void*)m_leafsPool,
+            leaf,
+            DeallocateFromPoolCallBack,
+            m_leafsPool->m_size);
+    } else {
+        m_leafsPool->Release(leaf);
+    }
+}
+
+int ArtPrimaryIndex::NormalizeKey(const Key* key, uint8_t* buf) const
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint32_t keyLength = key->GetKeyLength();
+    errno_t erc;
+
+    if (keyLength < m_keyLength) {
+        // a shorter search key precedes all the keys it is a prefix of
+        if (keyLength > 0) {
+            erc = memcpy_s(buf, MAX_KEY_SIZE, keyBuf, keyLength);
+            securec_check(erc, "\0", "\0");
+        }
+        erc = memset_s(buf + keyLength, MAX_KEY_SIZE - keyLength, 0, m_keyLength - keyLength);
+        securec_check(erc, "\0", "\0");
+        return -1;
+    }
+
+    erc = memcpy_s(buf, MAX_KEY_SIZE, keyBuf, m_keyLength);
+    securec_check(erc, "\0", "\0");
+    // trailing padding (e.g. of aligned search keys) is not part of the key
+    for (uint32_t i = m_keyLength; i < keyLength; ++i) {
+        if (keyBuf[i] != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+bool ArtPrimaryIndex::CheckPrefixPessimistic(ArtNode* node, const uint8_t* key, uint32_t& level,
+    uint8_t& nonMatchingKey, uint8_t* nonMatchingPrefix, bool& restart) const
+{
+    uint32_t prefixCount = node->m_prefixCount;
+    if (prefixCount == 0) {
+        return true;
+    }
+    if (level + prefixCount >= m_keyLength) {
+        // torn read of a concurrently modified node
+        restart = true;
+        return true;
+    }
+
+    uint32_t prevLevel = level;
+    const ArtLeaf* anyLeaf = nullptr;
+    for (uint32_t i = 0; i < prefixCount; ++i) {
+        if (i == ART_MAX_STORED_PREFIX) {
+            anyLeaf = node->GetAnyLeaf(restart);
+            if (restart) {
+                return true;
+            }
+        }
+        uint8_t curKey = (i < ART_MAX_STORED_PREFIX) ? node->m_prefix[i] : anyLeaf->m_key[level];
+        if (curKey != key[level]) {
+            nonMatchingKey = curKey;
+            uint32_t remainingCount = 0;
+            errno_t erc;
+            if (prefixCount > ART_MAX_STORED_PREFIX) {
+                if (anyLeaf == nullptr) {
+                    anyLeaf = node->GetAnyLeaf(restart);
+                    if (restart) {
+                        return true;
+                    }
+                }
+                remainingCount = std::min(prefixCount - (level - prevLevel) - 1, ART_MAX_STORED_PREFIX);
+                if (remainingCount > 0) {
+                    erc = memcpy_s(
+                        nonMatchingPrefix, ART_MAX_STORED_PREFIX, anyLeaf->m_key + level + 1, remainingCount);
+                    securec_check(erc, "\0", "\0");
+                }
+            } else {
+                remainingCount = prefixCount - i - 1;
+                if (remainingCount > 0) {
+                    erc = memcpy_s(nonMatchingPrefix, ART_MAX_STORED_PREFIX, node->m_prefix + i + 1, remainingCount);
+                    securec_check(erc, "\0", "\0");
+                }
+            }
+            return false;
+        }
+        ++level;
+    }
+    return true;
+}
+
+ArtPrimaryIndex::ArtLeaf* ArtPrimaryIndex::TryLookup(const uint8_t* key, bool& restart) const
+{
+    ArtNode* node = m_root;
+    uint64_t version = node->ReadLockOrRestart(restart);
+    if (restart) {
+        return nullptr;
+    }
+
+    uint32_t level = 0;
+    while (true) {
+        if (!node->CheckPrefix(key, level, m_keyLength, restart)) {
+            if (!restart) {
+                node->ReadUnlockOrRestart(version, restart);
+            }
+            return nullptr;
+        }
+
+        ArtNode* child = node->FindChild(key[level]);
+        node->ReadUnlockOrRestart(version, restart);
+        if (restart || child == nullptr) {
+            return nullptr;
+        }
+
+        if (ArtNode::IsLeaf(child)) {
+            // leafs are immutable, a validated pointer is enough
+            ArtLeaf* leaf = ArtNode::ToLeaf(child);
+            return (memcmp(leaf->m_key, key, m_keyLength) == 0) ? leaf : nullptr;
+        }
+
+        uint64_t childVersion = child->ReadLockOrRestart(restart);
+        if (restart) {
+            return nullptr;
+        }
+        node->ReadUnlockOrRestart(version, restart);
+        if (restart) {
+            return nullptr;
+        }
+        node = child;
+        version = childVersion;
+        ++level;
+    }
+}
+
+Sentinel* ArtPrimaryIndex::TryInsert(const uint8_t* key, ArtLeaf* leaf, bool& inserted, bool& restart)
+{
+    ArtNode* node = nullptr;
+    ArtNode* nextNode = m_root;
+    ArtNode* parent = nullptr;
+    uint64_t parentVersion = 0;
+    uint8_t parentKey = 0;
+    uint8_t nodeKey = 0;
+    uint32_t level = 0;
+
+    inserted = false;
+    while (true) {
+        parent = node;
+        parentKey = nodeKey;
+        node = nextNode;
+        uint64_t version = node->ReadLockOrRestart(restart);
+        if (restart) {
+            return nullptr;
+        }
+
+        uint32_t nextLevel = level;
+        uint8_t nonMatchingKey = 0;
+        uint8_t remainingPrefix[ART_MAX_STORED_PREFIX];
+        bool match = CheckPrefixPessimistic(node, key, nextLevel, nonMatchingKey, remainingPrefix, restart);
+        if (restart) {
+            return nullptr;
+        }
+        if (!match) {
+            // the key diverges inside the compressed path: split the path with a new node
+            MOT_ASSERT(parent != nullptr);
+            parent->UpgradeToWriteLockOrRestart(parentVersion, restart);
+            if (restart) {
+                return nullptr;
+            }
+            node->UpgradeToWriteLockOrRestart(version, restart);
+            if (restart) {
+                parent->WriteUnlock();
+                return nullptr;
+            }
+            uint32_t matchCount = nextLevel - level;
+            ArtNode* newNode = AllocNode(ArtNodeType::ART_NODE_4, node->m_prefix, matchCount);
+            if (newNode == nullptr) {
+                node->WriteUnlock();
+                parent->WriteUnlock();
+                return nullptr;
+            }
+            newNode->InsertChild(key[nextLevel], ArtNode::FromLeaf(leaf));
+            newNode->InsertChild(nonMatchingKey, node);
+            parent->ChangeChild(parentKey, newNode);
+            parent->WriteUnlock();
+
+            node->SetPrefix(remainingPrefix, node->m_prefixCount - (matchCount + 1));
+            node->WriteUnlock();
+            inserted = true;
+            return nullptr;
+        }
+
+        level = nextLevel;
+        nodeKey = key[level];
+        nextNode = node->FindChild(nodeKey);
+        node->ReadUnlockOrRestart(version, restart);
+        if (restart) {
+            return nullptr;
+        }
+
+        if (nextNode == nullptr) {
+            if (InsertAndUnlock(
+                    node, version, parent, parentVersion, parentKey, nodeKey, ArtNode::FromLeaf(leaf), restart)) {
+                inserted = !restart;
+            }
+            return nullptr;
+        }
+
+        if (parent != nullptr) {
+            parent->ReadUnlockOrRestart(parentVersion, restart);
+            if (restart) {
+                return nullptr;
+            }
+        }
+
+        if (ArtNode::IsLeaf(nextNode)) {
+            node->UpgradeToWriteLockOrRestart(version, restart);
+            if (restart) {
+                return nullptr;
+            }
+            // all the bytes up to this level were already matched along the path
+            ArtLeaf* existing = ArtNode::ToLeaf(nextNode);
+            ++level;
+            uint32_t prefixCount = 0;
+            while ((level + prefixCount < m_keyLength) &&
+                   (existing->m_key[level + prefixCount] == key[level + prefixCount])) {
+                ++prefixCount;
+            }
+            if (level + prefixCount == m_keyLength) {
+                // key mapping already exists
+                node->WriteUnlock();
+                return existing->m_sentinel;
+            }
+            ArtNode* newNode = AllocNode(ArtNodeType::ART_NODE_4, key + level, prefixCount);
+            if (newNode == nullptr) {
+                node->WriteUnlock();
+                return nullptr;
+            }
+            newNode->InsertChild(key[level + prefixCount], ArtNode::FromLeaf(leaf));
+            newNode->InsertChild(existing->m_key[level + prefixCount], nextNode);
+            node->ChangeChild(nodeKey, newNode);
+            node->WriteUnlock();
+            inserted = true;
+            return nullptr;
+        }
+
+        ++level;
+        parentVersion = version;
+    }
+}
+
+bool ArtPrimaryIndex::InsertAndUnlock(ArtNode* node, uint64_t version, ArtNode* parent, uint64_t parentVersion,
+    uint8_t parentKey, uint8_t key, ArtNode* child, bool& restart)
+{
+    if (!node->IsFull()) {
+        if (parent != nullptr) {
+            parent->ReadUnlockOrRestart(parentVersion, restart);
+            if (restart) {
+                return true;
+            }
+        }
+        node->UpgradeToWriteLockOrRestart(version, restart);
+        if (restart) {
+            return true;
+        }
+        node->InsertChild(key, child);
+        node->WriteUnlock();
+        return true;
+    }
+
+    // replace the full node with a larger one
+    MOT_ASSERT(parent != nullptr);
+    parent->UpgradeToWriteLockOrRestart(parentVersion, restart);
+    if (restart) {
+        return true;
+    }
+    node->UpgradeToWriteLockOrRestart(version, restart);
+    if (restart) {
+        parent->WriteUnlock();
+        return true;
+    }
+    ArtNode* bigNode = AllocNode(GrowNodeType(node->m_type), node->m_prefix, node->m_prefixCount);
+    if (bigNode == nullptr) {
+        node->WriteUnlock();
+        parent->WriteUnlock();
+        return false;
+    }
+    node->CopyChildrenTo(bigNode);
+    bigNode->InsertChild(key, child);
+    parent->ChangeChild(parentKey, bigNode);
+    parent->WriteUnlock();
+
+    node->WriteUnlockObsolete();
+    RetireNode(node);
+    return true;
+}
+
+Sentinel* ArtPrimaryIndex::TryRemove(const uint8_t* key, bool& restart)
+{
+    ArtNode* node = nullptr;
+    ArtNode* nextNode = m_root;
+    ArtNode* parent = nullptr;
+    uint64_t parentVersion = 0;
+    uint8_t parentKey = 0;
+    uint8_t nodeKey = 0;
+    uint32_t level = 0;
+
+    while (true) {
+        parent = node;
+        parentKey = nodeKey;
+        node = nextNode;
+        uint64_t version = node->ReadLockOrRestart(restart);
+        if (restart) {
+            return nullptr;
+        }
+
+        if (!node->CheckPrefix(key, level, m_keyLength, restart)) {
+            if (!restart) {
+                node->ReadUnlockOrRestart(version, restart);
+            }
+            return nullptr;
+        }
+
+        nodeKey = key[level];
+        nextNode = node->FindChild(nodeKey);
+        node->ReadUnlockOrRestart(version, restart);
+        if (restart || nextNode == nullptr) {
+            return nullptr;
+        }
+
+        if (ArtNode::IsLeaf(nextNode)) {
+            ArtLeaf* leaf = ArtNode::ToLeaf(nextNode);
+            if (memcmp(leaf->m_key, key, m_keyLength) != 0) {
+                return nullptr;
+            }
+
+            if (parent != nullptr && node->m_type == ArtNodeType::ART_NODE_4 && node->m_count == 2) {
+                // the node is left with a single child: link that child directly to the parent
+                parent->UpgradeToWriteLockOrRestart(parentVersion, restart);
+                if (restart) {
+                    return nullptr;
+                }
+                node->UpgradeToWriteLockOrRestart(version, restart);
+                if (restart) {
+                    parent->WriteUnlock();
+                    return nullptr;
+                }
+                uint8_t secondKey = 0;
+                ArtNode* secondNode = node->GetSecondChild(nodeKey, secondKey);
+                if (!ArtNode::IsLeaf(secondNode)) {
+                    secondNode->WriteLockOrRestart(restart);
+                    if (restart) {
+                        node->WriteUnlock();
+                        parent->WriteUnlock();
+                        return nullptr;
+                    }
+                    secondNode->AddPrefixBefore(node, secondKey);
+                }
+                parent->ChangeChild(parentKey, secondNode);
+                parent->WriteUnlock();
+                if (!ArtNode::IsLeaf(secondNode)) {
+                    secondNode->WriteUnlock();
+                }
+                node->WriteUnlockObsolete();
+                RetireNode(node);
+            } else {
+                RemoveAndUnlock(node, version, parent, parentVersion, parentKey, nodeKey, restart);
+                if (restart) {
+                    return nullptr;
+                }
+            }
+
+            Sentinel* sentinel = leaf->m_sentinel;
+            RetireLeaf(leaf);
+            return sentinel;
+        }
+
+        ++level;
+        parentVersion = version;
+    }
+}
+
+void ArtPrimaryIndex::RemoveAndUnlock(ArtNode* node, uint64_t version, ArtNode* parent, uint64_t parentVersion,
+    uint8_t parentKey, uint8_t key, bool& restart)
+{
+    if (parent == nullptr || !node->IsUnderfull()) {
+        if (parent != nullptr) {
+            parent->ReadUnlockOrRestart(parentVersion, restart);
+            if (restart) {
+                return;
+            }
+        }
+        node->UpgradeToWriteLockOrRestart(version, restart);
+        if (restart) {
+            return;
+        }
+        node->RemoveChild(key);
+        node->WriteUnlock();
+        return;
+    }
+
+    // replace the underfull node with a smaller one
+    parent->UpgradeToWriteLockOrRestart(parentVersion, restart);
+    if (restart) {
+        return;
+    }
+    node->UpgradeToWriteLockOrRestart(version, restart);
+    if (restart) {
+        parent->WriteUnlock();
+        return;
+    }
+    ArtNode* smallNode = AllocNode(ShrinkNodeType(node->m_type), node->m_prefix, node->m_prefixCount);
+    if (smallNode == nullptr) {
+        // shrinking is only an optimization, keep the current node
+        parent->WriteUnlock();
+        node->RemoveChild(key);
+        node->WriteUnlock();
+        return;
+    }
+    node->CopyChildrenTo(smallNode);
+    smallNode->RemoveChild(key);
+    parent->ChangeChild(parentKey, smallNode);
+    parent->WriteUnlock();
+
+    node->WriteUnlockObsolete();
+    RetireNode(node);
+}
+
+Sentinel* ArtPrimaryIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    uint8_t keyBuf[MAX_KEY_SIZE];
+    (void)NormalizeKey(key, keyBuf);
+
+    inserted = false;
+    ArtLeaf* leaf = AllocLeaf(keyBuf, sentinel);
+    if (leaf == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Insert", "Failed to allocate ART leaf");
+        return nullptr;
+    }
+
+    Sentinel* result = nullptr;
+    bool restart = false;
+    do {
+        restart = false;
+        result = TryInsert(keyBuf, leaf, inserted, restart);
+    } while (restart);
+
+    if (!inserted) {
+        // the leaf was never published
+        m_leafsPool->Release(leaf);
+        if (result == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Insert", "Failed to allocate ART node");
+        }
+    }
+
+    return result;
+}
+
+Sentinel* ArtPrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    uint8_t keyBuf[MAX_KEY_SIZE];
+    if (NormalizeKey(key, keyBuf) != 0) {
+        return nullptr;
+    }
+
+    ArtLeaf* leaf = nullptr;
+    bool restart = false;
+    do {
+        restart = false;
+        leaf = TryLookup(keyBuf, restart);
+    } while (restart);
+
+    return (leaf != nullptr) ? leaf->m_sentinel : nullptr;
+}
+
+Sentinel* ArtPrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    uint8_t keyBuf[MAX_KEY_SIZE];
+    if (NormalizeKey(key, keyBuf) != 0) {
+        return nullptr;
+    }
+
+    Sentinel* sentinel = nullptr;
+    bool restart = false;
+    do {
+        restart = false;
+        sentinel = TryRemove(keyBuf, restart);
+    } while (restart);
+
+    return sentinel;
+}
+
+int ArtPrimaryIndex::ScanNode(ArtNode* node, uint64_t version, uint32_t level, bool bounded, ArtScanContext& ctx) const
+{
+    bool restart = false;
+    uint32_t prefixCount = node->m_prefixCount;
+    if (level + prefixCount >= m_keyLength) {
+        return ART_SCAN_RESTART;
+    }
+
+    if (bounded && prefixCount > 0) {
+        // compare the whole compressed path with the bound
+        int cmp = 0;
+        const ArtLeaf* anyLeaf = nullptr;
+        for (uint32_t i = 0; i < prefixCount && cmp == 0; ++i) {
+            if (i == ART_MAX_STORED_PREFIX) {
+                anyLeaf = node->GetAnyLeaf(restart);
+                if (restart) {
+                    return ART_SCAN_RESTART;
+                }
+            }
+            uint8_t prefixByte = (i < ART_MAX_STORED_PREFIX) ? node->m_prefix[i] : anyLeaf->m_key[level + i];
+            cmp = static_cast<int>(prefixByte) - static_cast<int>(ctx.m_bound[level + i]);
+        }
+        node->ReadUnlockOrRestart(version, restart);
+        if (restart) {
+            return ART_SCAN_RESTART;
+        }
+        if (cmp != 0) {
+            if ((cmp > 0) != ctx.m_forward) {
+                // the whole sub-tree precedes the bound in scan order
+                return ART_SCAN_CONTINUE;
+            }
+            bounded = false;
+        }
+    }
+    level += prefixCount;
+
+    uint32_t from = bounded ? ctx.m_bound[level] : (ctx.m_forward ? 0 : (ART_NODE256_CAPACITY - 1));
+    while (true) {
+        uint8_t childKey = 0;
+        ArtNode* child = node->GetNextChild(from, ctx.m_forward, childKey);
+        node->ReadUnlockOrRestart(version, restart);
+        if (restart) {
+            return ART_SCAN_RESTART;
+        }
+        if (child == nullptr) {
+            return ART_SCAN_CONTINUE;
+        }
+
+        bool childBounded = bounded && (childKey == ctx.m_bound[level]);
+        if (ArtNode::IsLeaf(child)) {
+            ArtLeaf* leaf = ArtNode::ToLeaf(child);
+            bool collect = true;
+            if (childBounded) {
+                int cmp = memcmp(leaf->m_key, ctx.m_bound, m_keyLength);
+                if (!ctx.m_forward) {
+                    cmp = -cmp;
+                }
+                collect = (cmp > 0) || (cmp == 0 && ctx.m_inclusive);
+            }
+            if (collect) {
+                errno_t erc = memcpy_s(ctx.m_keys + ctx.m_count * m_keyLength, m_keyLength, leaf->m_key, m_keyLength);
+                securec_check(erc, "\0", "\0");
+                ctx.m_sentinels[ctx.m_count] = leaf->m_sentinel;
+                if (++ctx.m_count == ctx.m_capacity) {
+                    return ART_SCAN_FULL;
+                }
+            }
+        } else {
+            uint64_t childVersion = child->ReadLockOrRestart(restart);
+            if (restart) {
+                return ART_SCAN_RESTART;
+            }
+            node->ReadUnlockOrRestart(version, restart);
+            if (restart) {
+                return ART_SCAN_RESTART;
+            }
+            int res = ScanNode(child, childVersion, level + 1, childBounded, ctx);
+            if (res != ART_SCAN_CONTINUE) {
+                return res;
+            }
+        }
+
+        if (ctx.m_forward) {
+            if (childKey == ART_NODE256_CAPACITY - 1) {
+                return ART_SCAN_CONTINUE;
+            }
+            from = childKey + 1;
+        } else {
+            if (childKey == 0) {
+                return ART_SCAN_CONTINUE;
+            }
+            from = childKey - 1;
+        }
+    }
+}
+
+uint32_t ArtPrimaryIndex::Scan(
+    const uint8_t* bound, bool inclusive, bool forward, uint8_t* keys, Sentinel** sentinels, uint32_t capacity) const
+{
+    ArtScanContext ctx;
+    ctx.m_inclusive = inclusive;
+    ctx.m_forward = forward;
+    ctx.m_keys = keys;
+    ctx.m_sentinels = sentinels;
+    ctx.m_capacity = capacity;
+    ctx.m_count = 0;
+
+    bool bounded = (bound != nullptr);
+    if (bounded) {
+        errno_t erc = memcpy_s(ctx.m_bound, MAX_KEY_SIZE, bound, m_keyLength);
+        securec_check(erc, "\0", "\0");
+    }
+
+    while (true) {
+        bool restart = false;
+        uint64_t version = m_root->ReadLockOrRestart(restart);
+        if (!restart && ScanNode(m_root, version, 0, bounded, ctx) != ART_SCAN_RESTART) {
+            break;
+        }
+        // concurrent modification: resume right after the last collected entry
+        if (ctx.m_count > 0) {
+            errno_t erc =
+                memcpy_s(ctx.m_bound, MAX_KEY_SIZE, keys + (ctx.m_count - 1) * m_keyLength, m_keyLength);
+            securec_check(erc, "\0", "\0");
+            ctx.m_inclusive = false;
+            bounded = true;
+        }
+    }
+
+    return ctx.m_count;
+}
+
+uint64_t ArtPrimaryIndex::GetIndexSize(uint64_t& netTotal)
+{
+    ObjAllocInterface* pools[] = {m_node4Pool, m_node16Pool, m_node48Pool, m_node256Pool, m_leafsPool};
+    const char* poolNames[] = {"Node4 Pool", "Node16 Pool", "Node48 Pool", "Node256 Pool", "Leafs Pool"};
+    PoolStatsSt stats;
+
+    uint64_t res = Index::GetIndexSize(netTotal);
+
+    for (uint32_t i = 0; i < sizeof(pools) / sizeof(pools[0]); ++i) {
+        errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+        securec_check(erc, "\0", "\0");
+        stats.m_type = PoolStatsT::POOL_STATS_ALL;
+        pools[i]->GetStats(stats);
+        pools[i]->PrintStats(stats, poolNames[i], LogLevel::LL_INFO);
+        res += stats.m_poolCount * stats.m_poolGrossSize;
+        netTotal += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+    }
+
+    MOT_LOG_INFO("ART Index %s memory size - Gross: %lu, NetTotal: %lu", m_name.c_str(), res, netTotal);
+    return res;
+}
+
+void ArtPrimaryIndex::ClearThreadMemoryCache()
+{
+    Index::ClearThreadMemoryCache();
+    ObjAllocInterface* pools[] = {m_node4Pool, m_node16Pool, m_node48Pool, m_node256Pool, m_leafsPool};
+    for (uint32_t i = 0; i < sizeof(pools) / sizeof(pools[0]); ++i) {
+        if (pools[i] != nullptr) {
+            pools[i]->ClearThreadCache();
+        }
+    }
+}
+
+void ArtPrimaryIndex::ClearFreeCache()
+{
+    Index::ClearFreeCache();
+    ObjAllocInterface* pools[] = {m_node4Pool, m_node16Pool, m_node48Pool, m_node256Pool, m_leafsPool};
+    for (uint32_t i = 0; i < sizeof(pools) / sizeof(pools[0]); ++i) {
+        if (pools[i] != nullptr) {
+            pools[i]->ClearFreeCache();
+        }
+    }
+}
+
+void ArtPrimaryIndex::Compact(Table* table, uint32_t pid)
+{
+    Index::Compact(table, pid);
+
+    ObjAllocInterface* pools[] = {m_node4Pool, m_node16Pool, m_node48Pool, m_node256Pool, m_leafsPool};
+    const char* poolNames[] = {"node4 pool", "node16 pool", "node48 pool", "node256 pool", "leafs pool"};
+    char prefix[256];
+    for (uint32_t i = 0; i < sizeof(pools) / sizeof(pools[0]); ++i) {
+        errno_t erc =
+            snprintf_s(prefix, sizeof(prefix), sizeof(prefix) - 1, "%s(%s)", m_name.c_str(), poolNames[i]);
+        securec_check_ss(erc, "\0", "\0");
+        prefix[erc] = 0;
+        CompactHandler ch(pools[i], prefix);
+        ch.StartCompaction(CompactTypeT::COMPACT_SIMPLE);
+        ch.EndCompaction();
+    }
+}
+
+// Iterator API
+IndexIterator* ArtPrimaryIndex::Begin(uint32_t pid, bool passive) const
+{
+    ArtIterator<IteratorType::ITERATOR_TYPE_FORWARD>* itr =
+        new (std::nothrow) ArtIterator<IteratorType::ITERATOR_TYPE_FORWARD>(this);
+    if (!itr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create forward iterator");
+        return nullptr;
+    }
+    (void)itr->Seek(nullptr, true);
+    return itr;
+}
+
+IndexIterator* ArtPrimaryIndex::ReverseBegin(uint32_t pid) const
+{
+    ArtIterator<IteratorType::ITERATOR_TYPE_REVERSE>* itr =
+        new (std::nothrow) ArtIterator<IteratorType::ITERATOR_TYPE_REVERSE>(this);
+    if (!itr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create reverse iterator");
+        return nullptr;
+    }
+    (void)itr->Seek(nullptr, true);
+    return itr;
+}
+
+IndexIterator* ArtPrimaryIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    uint8_t bound[MAX_KEY_SIZE];
+    int cmp = NormalizeKey(key, bound);
+    bool inclusive = forward ? (cmp < 0 || (cmp == 0 && matchKey)) : (cmp > 0 || (cmp == 0 && matchKey));
+    bool exactFirst = false;
+    IndexIterator* itr = nullptr;
+
+    if (forward) {
+        ArtIterator<IteratorType::ITERATOR_TYPE_FORWARD>* fwdItr =
+            new (std::nothrow) ArtIterator<IteratorType::ITERATOR_TYPE_FORWARD>(this);
+        if (!fwdItr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create forward iterator");
+            return nullptr;
+        }
+        exactFirst = fwdItr->Seek(bound, inclusive);
+        itr = fwdItr;
+    } else {
+        ArtIterator<IteratorType::ITERATOR_TYPE_REVERSE>* revItr =
+            new (std::nothrow) ArtIterator<IteratorType::ITERATOR_TYPE_REVERSE>(this);
+        if (!revItr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create reverse iterator");
+            return nullptr;
+        }
+        exactFirst = revItr->Seek(bound, inclusive);
+        itr = revItr;
+    }
+
+    // report an exact match regardless of matchKey
+    if (cmp != 0) {
+        found = false;
+    } else if (inclusive) {
+        found = exactFirst;
+    } else {
+        bool restart = false;
+        do {
+            restart = false;
+            found = (TryLookup(bound, restart) != nullptr);
+        } while (restart);
+    }
+
+    return itr;
+}
+}  // namespace MOT
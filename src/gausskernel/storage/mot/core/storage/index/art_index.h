@@ -0,0 +1,499 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * art_index.h
+ *    Primary index implementation using an Adaptive Radix Tree with optimistic lock coupling.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/storage/index/art_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef ART_PRIMARY_INDEX_H
+#define ART_PRIMARY_INDEX_H
+
+#include "index.h"
+#include "index_base.h"
+#include "utilities.h"
+#include "mot_engine.h"
+
+namespace MOT {
+/**
+ * @class ArtPrimaryIndex.
+ * @brief Primary index implementation using an Adaptive Radix Tree (ART). Inner nodes adapt their
+ * fan-out (4, 16, 48 or 256 children) to the number of children they actually hold, and common key
+ * prefixes are compressed into the inner nodes. Concurrency is handled by optimistic lock coupling:
+ * readers never write to shared memory and only validate node version words, while writers lock at
+ * most the two nodes they modify. Replaced nodes and removed leaves are reclaimed through the GC.
+ * @note All keys of the index are stored with the same length, so no key is a prefix of another.
+ */
+class ArtPrimaryIndex : public Index {
+public:
+    /** @enum Node types of the adaptive radix tree. */
+    enum class ArtNodeType : uint8_t { ART_NODE_4, ART_NODE_16, ART_NODE_48, ART_NODE_256 };
+
+private:
+    /** @brief Inner node header (defined in art_index.cpp). */
+    struct ArtNode;
+
+    /** @brief Inner node with up to 4 or 16 children sorted by their key byte. */
+    template <uint32_t CAPACITY>
+    struct ArtSortedNode;
+
+    /** @typedef Inner node with up to 4 children. */
+    typedef ArtSortedNode<4> ArtNode4;
+
+    /** @typedef Inner node with up to 16 children. */
+    typedef ArtSortedNode<16> ArtNode16;
+
+    /** @brief Inner node with up to 48 children. */
+    struct ArtNode48;
+
+    /** @brief Inner node with up to 256 children. */
+    struct ArtNode256;
+
+    /** @brief Leaf holding the full key and the primary sentinel. */
+    struct ArtLeaf;
+
+    /** @brief Range scan state. */
+    struct ArtScanContext;
+
+    /** @var Size in bytes of the key buffer of a scan batch. */
+    static constexpr uint32_t ART_SCAN_BATCH_BYTES = 2048;
+
+    /** @var Maximum number of entries in a scan batch. */
+    static constexpr uint32_t ART_SCAN_BATCH_MAX = 64;
+
+    /**
+     * @class ArtIterator<IT>
+     * @brief An index iterator implementation for a primary ART index. The iterator fetches batches of
+     * consecutive entries from the tree. Each batch is collected in a single traversal and the next batch
+     * is looked up again from the root, starting right after the last returned key.
+     * @tparam IteratorType (Direction).
+     */
+    template <IteratorType IT>
+    class ArtIterator : public IndexIterator {
+    public:
+        /**
+         * @brief Constructor.
+         * @param index The iterated index.
+         */
+        explicit ArtIterator(const ArtPrimaryIndex* index)
+            : IndexIterator(IT, true),  // always bidirectional
+              m_index(index),
+              m_capacity(ART_SCAN_BATCH_BYTES / index->GetKeyLength()),
+              m_count(0),
+              m_pos(0),
+              m_exhausted(true),
+              m_valid(false),
+              m_currentKey(index->GetKeyLength())
+        {
+            if (m_capacity > ART_SCAN_BATCH_MAX) {
+                m_capacity = ART_SCAN_BATCH_MAX;
+            }
+        }
+
+        /**
+         * @brief Destructor.
+         */
+        ~ArtIterator() override
+        {
+            m_index = nullptr;
+        }
+
+        /**
+         * @brief Queries whether this iterator is valid. Iterator is said to be valid if it still
+         * points to a valid index items and it has not been invalidated due to concurrent modification.
+         * @return True if the iterator is valid.
+         */
+        bool IsValid() const override
+        {
+            return m_valid;
+        }
+
+        /**
+         * @brief Invalidates the iterator such that subsequent calls to isValid() return false.
+         */
+        void Invalidate() override
+        {
+            m_valid = false;
+        }
+
+        /**
+         * @brief Performs any implementation-specific cleanup.
+         */
+        void Destroy() override
+        {}
+
+        /**
+         * @brief Retrieves the key of the currently iterated item.
+         * @return A pointer to the key of the currently iterated item.
+         */
+        const void* GetKey() const override
+        {
+            return m_valid ? &m_currentKey : nullptr;
+        }
+
+        /**
+         * @brief Retrieves the row of the currently iterated item.
+         * @return A pointer to the row of the currently iterated item.
+         */
+        Row* GetRow() const override
+        {
+            return GetPrimarySentinel()->GetData();
+        }
+
+        /**
+         * @brief Retrieves the currently iterated primary sentinel.
+         * @return The primary sentinel.
+         */
+        Sentinel* GetPrimarySentinel() const override
+        {
+            return m_sentinels[m_pos];
+        }
+
+        /**
+         * @brief Moves forwards the iterator to the next item.
+         */
+        void Next() override
+        {
+            if (!m_valid) {
+                return;
+            }
+            if (++m_pos == m_count) {
+                if (m_exhausted) {
+                    m_valid = false;
+                    return;
+                }
+                // current key still holds the last entry of the batch
+                m_count =
+                    m_index->Scan(m_currentKey.GetKeyBuf(), false, IsForward(), m_keys, m_sentinels, m_capacity);
+                m_exhausted = (m_count < m_capacity);
+                m_pos = 0;
+                if (m_count == 0) {
+                    m_valid = false;
+                    return;
+                }
+            }
+            SetCurrentKey();
+        }
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Does not supported yet.
+         */
+        void Prev() override
+        {
+            MOT_ASSERT(false);
+        }
+
+        /**
+         * @brief Queries whether this index iterator equals to another index iterator.
+         * @param rhs The index iterator with which to compare this iterator.
+         * @return True if iterators point to the same index item, otherwise false.
+         */
+        bool Equals(const IndexIterator* rhs) const override
+        {
+            const ArtIterator* other = static_cast<const ArtIterator*>(rhs);
+            if (!m_valid || !other->m_valid) {
+                return (m_valid == other->m_valid);
+            }
+            return GetPrimarySentinel() == other->GetPrimarySentinel();
+        }
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         * @param serializeFunc The serialization function.
+         * @param buff The buffer into which the iterator is to be serialized.
+         */
+        void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const override
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         * @param deserializeFunc The deserialization function.
+         * @param buff The buffer from which the iterator is to be deserialized.
+         */
+        void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff) override
+        {}
+
+        /**
+         * @brief Positions the iterator on the first entry following the search bound.
+         * @param bound The normalized search bound or null to start from the first (last) entry.
+         * @param inclusive Specifies whether an entry equal to the bound should be returned.
+         * @return True if an entry equal to the search bound was found.
+         */
+        bool Seek(const uint8_t* bound, bool inclusive)
+        {
+            m_count = m_index->Scan(bound, inclusive, IsForward(), m_keys, m_sentinels, m_capacity);
+            m_exhausted = (m_count < m_capacity);
+            m_pos = 0;
+            m_valid = (m_count > 0);
+            if (!m_valid) {
+                return false;
+            }
+            SetCurrentKey();
+            return (bound != nullptr && memcmp(m_keys, bound, m_index->GetKeyLength()) == 0);
+        }
+
+    private:
+        inline bool IsForward() const
+        {
+            return (IT == IteratorType::ITERATOR_TYPE_FORWARD);
+        }
+
+        inline void SetCurrentKey()
+        {
+            m_currentKey.CpKey(m_keys + m_pos * m_index->GetKeyLength(), m_index->GetKeyLength());
+        }
+
+        /** @var The iterated index. */
+        const ArtPrimaryIndex* m_index;
+
+        /** @var The number of entries that fit in a batch. */
+        uint32_t m_capacity;
+
+        /** @var The number of entries in the current batch. */
+        uint32_t m_count;
+
+        /** @var The position of the current entry in the batch. */
+        uint32_t m_pos;
+
+        /** @var Specifies whether the tree has no entries past the current batch. */
+        bool m_exhausted;
+
+        /** @var Specifies whether the iterator points to a valid entry. */
+        bool m_valid;
+
+        /** @var The key of the current entry. */
+        MaxKey m_currentKey;
+
+        /** @var The primary sentinels of the current batch. */
+        Sentinel* m_sentinels[ART_SCAN_BATCH_MAX];
+
+        /** @var The keys of the current batch. */
+        uint8_t m_keys[ART_SCAN_BATCH_BYTES];
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    ArtPrimaryIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_TREE),
+          m_root(nullptr),
+          m_node4Pool(nullptr),
+          m_node16Pool(nullptr),
+          m_node48Pool(nullptr),
+          m_node256Pool(nullptr),
+          m_leafsPool(nullptr),
+          m_initialized(false)
+    {}
+
+    /**
+     * @brief Destructor.
+     */
+    ~ArtPrimaryIndex() override
+    {
+        if (m_initialized) {
+            m_initialized = false;
+            DestroyPools();
+        }
+        m_root = nullptr;
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    uint64_t GetIndexSize(uint64_t& netTotal) override;
+
+    /**
+     * @brief Retrieves the number of rows stored in the index. This may be an estimation.
+     * @detail Not implemented.
+     * @return The number of rows stored in the index.
+     */
+    uint64_t GetSize() const override
+    {
+        return 0;
+    }
+
+    /**
+     * @brief Clears object pool thread level cache
+     */
+    void ClearThreadMemoryCache() override;
+
+    /**
+     * @brief Clears object pool level cache
+     */
+    void ClearFreeCache() override;
+
+    void Compact(Table* table, uint32_t pid) override;
+
+    /**
+     * @brief Destroy all memory pools and init index again.
+     */
+    RC ReInitIndex(bool isDrop) override
+    {
+        m_initialized = false;
+        DestroyPools();
+
+        // the root node was allocated from the node pools (not valid anymore)
+        m_root = nullptr;
+
+        if (isDrop) {
+            return RC_OK;
+        } else {
+            return IndexInitImpl(NULL);
+        }
+    }
+
+    // Iterator API
+    IndexIterator* Begin(uint32_t pid, bool passive) const override;
+
+    IndexIterator* ReverseBegin(uint32_t pid) const override;
+
+    IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const override;
+
+    /**
+     * @brief Static callback function for deallocate memory from pools.
+     * @param pool Pool to deallocate from.
+     * @param ptr Pointer to allocated memory.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateFromPoolCallBack(void* gcElement, void* oper, void* aux);
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    RC IndexInitImpl(void** args) override;
+
+    Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid) override;
+
+    Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const override;
+
+    Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid) override;
+
+private:
+    /** @var The root node (a node with 256 children that is never replaced). */
+    ArtNode* m_root;
+
+    /** @var Memory pool for nodes with 4 children. */
+    ObjAllocInterface* m_node4Pool;
+
+    /** @var Memory pool for nodes with 16 children. */
+    ObjAllocInterface* m_node16Pool;
+
+    /** @var Memory pool for nodes with 48 children. */
+    ObjAllocInterface* m_node48Pool;
+
+    /** @var Memory pool for nodes with 256 children. */
+    ObjAllocInterface* m_node256Pool;
+
+    /** @var Memory pool for leafs. */
+    ObjAllocInterface* m_leafsPool;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    /**
+     * @brief Init ART memory pools.
+     * @return True if succeeded otherwise false.
+     * @note In case of failure it is the responsibility of the caller to call @ref DestroyPools().
+     */
+    bool InitPools();
+
+    /**
+     * @brief Destroy ART memory pools.
+     */
+    void DestroyPools();
+
+    /**
+     * @brief Copies a key into a buffer of exactly the index key length.
+     * @param key The key to normalize.
+     * @param[out] buf The resulting key buffer (MAX_KEY_SIZE bytes).
+     * @return Negative if the original key is shorter and precedes the normalized key, positive if the
+     * original key is longer and follows the normalized key, zero if both denote the same key.
+     */
+    int NormalizeKey(const Key* key, uint8_t* buf) const;
+
+    /**
+     * @brief Collects consecutive index entries in iteration order.
+     * @param bound The normalized scan bound or null to start from the first (last) entry.
+     * @param inclusive Specifies whether an entry equal to the bound should be collected.
+     * @param forward Specifies the scan direction.
+     * @param[out] keys Receives the keys of the collected entries.
+     * @param[out] sentinels Receives the primary sentinels of the collected entries.
+     * @param capacity The maximum number of entries to collect.
+     * @return The number of collected entries.
+     */
+    uint32_t Scan(const uint8_t* bound, bool inclusive, bool forward, uint8_t* keys, Sentinel** sentinels,
+        uint32_t capacity) const;
+
+    /** @brief Recursive helper for @ref Scan(). */
+    int ScanNode(ArtNode* node, uint64_t version, uint32_t level, bool bounded, ArtScanContext& ctx) const;
+
+    /** @brief Searches for a key, returns its leaf or null. Sets restart on a concurrent modification. */
+    ArtLeaf* TryLookup(const uint8_t* key, bool& restart) const;
+
+    /**
+     * @brief Inserts a leaf, or returns the sentinel already mapped to its key. Sets restart on a concurrent
+     * modification. Returns null without setting inserted if a node could not be allocated.
+     */
+    Sentinel* TryInsert(const uint8_t* key, ArtLeaf* leaf, bool& inserted, bool& restart);
+
+    /** @brief Removes a key, returns its sentinel or null. Sets restart on a concurrent modification. */
+    Sentinel* TryRemove(const uint8_t* key, bool& restart);
+
+    /** @brief Compares the prefix of a node with a key, possibly reading the remainder from a leaf. */
+    bool CheckPrefixPessimistic(ArtNode* node, const uint8_t* key, uint32_t& level, uint8_t& nonMatchingKey,
+        uint8_t* nonMatchingPrefix, bool& restart) const;
+
+    /** @brief Adds a child to a node, replacing the node with a larger one if it is full. */
+    bool InsertAndUnlock(ArtNode* node, uint64_t version, ArtNode* parent, uint64_t parentVersion,
+        uint8_t parentKey, uint8_t key, ArtNode* child, bool& restart);
+
+    /** @brief Removes a child from a node, replacing the node with a smaller one if it is underfull. */
+    void RemoveAndUnlock(ArtNode* node, uint64_t version, ArtNode* parent, uint64_t parentVersion,
+        uint8_t parentKey, uint8_t key, bool& restart);
+
+    /** @brief Allocates an inner node. */
+    ArtNode* AllocNode(ArtNodeType type, const uint8_t* prefix, uint32_t prefixCount);
+
+    /** @brief Allocates a leaf. */
+    ArtLeaf* AllocLeaf(const uint8_t* key, Sentinel* sentinel);
+
+    /** @brief Hands an unlinked inner node over to the GC. */
+    void RetireNode(ArtNode* node);
+
+    /** @brief Hands an unlinked leaf over to the GC. */
+    void RetireLeaf(ArtLeaf* leaf);
+
+    /** @brief Retrieves the pool of an inner node type. */
+    ObjAllocInterface* GetNodePool(ArtNodeType type) const;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* ART_PRIMARY_INDEX_H */
@@ -590,7 +590,7 @@ uint64_t Index::GetIndexSize(uint64_t& netTotal)
 Index* Index::CloneEmpty()
 {
     Index* clonedIndex =
-        IndexFactory::CreateIndex(m_indexOrder, m_indexingMethod, GetGlobalConfiguration().m_indexTreeFlavor);
+        IndexFactory::CreateIndex(m_indexOrder, m_indexingMethod, m_indexTreeFlavor);
     if (clonedIndex == nullptr) {
         // error could not allocate memory for new index
         MOT_REPORT_ERROR(MOT_ERROR_OOM, "Clone Index", "Failed to allocate index object");
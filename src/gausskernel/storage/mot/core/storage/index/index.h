@@ -804,6 +804,16 @@ public:
         return m_unique;
     }
 
+    inline void SetTreeFlavor(IndexTreeFlavor flavor)
+    {
+        m_indexTreeFlavor = flavor;
+    }
+
+    inline IndexTreeFlavor GetTreeFlavor() const
+    {
+        return m_indexTreeFlavor;
+    }
+
     RC Truncate(bool isDrop);
 
     virtual void Compact(Table* table, uint32_t pid);
@@ -892,6 +902,9 @@ protected:
     uint8_t* m_colBitmap = nullptr;
     bool m_unique = true;
 
+    /** @var The tree flavor the index was created with. */
+    IndexTreeFlavor m_indexTreeFlavor = DEFAULT_TREE_FLAVOR;
+
     ObjAllocInterface* m_keyPool;
     ObjAllocInterface* m_sentinelPool;
     ObjAllocInterface* m_sSentinelVersionPool;
@@ -30,6 +30,8 @@ const char* IndexTreeFlavorToString(const IndexTreeFlavor& indexTreeFlavor)
     switch (indexTreeFlavor) {
         case IndexTreeFlavor::INDEX_TREE_FLAVOR_MASSTREE:
             return "MasstreeFlavor";
+        case IndexTreeFlavor::INDEX_TREE_FLAVOR_ART:
+            return "ArtFlavor";
         default:
             return "InvalidFlavor";
     }
@@ -49,6 +49,11 @@ enum class IndexTreeFlavor : uint8_t {
      */
     INDEX_TREE_FLAVOR_MASSTREE,
 
+    /**
+     * @var Denotes an Adaptive Radix Tree (with optimistic lock coupling) tree index flavor.
+     */
+    INDEX_TREE_FLAVOR_ART,
+
     /**
      * @var Denotes a Invalid tree index flavor.
      */
@@ -67,6 +72,10 @@ inline IndexTreeFlavor IndexTreeFlavorFromString(const char* flavor)
         return IndexTreeFlavor::INDEX_TREE_FLAVOR_MASSTREE;
     }
 
+    if (strcmp(flavor, "ArtFlavor") == 0) {
+        return IndexTreeFlavor::INDEX_TREE_FLAVOR_ART;
+    }
+
     return IndexTreeFlavor::INDEX_TREE_FLAVOR_INVALID;
 }
 
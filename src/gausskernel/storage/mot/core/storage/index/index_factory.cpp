@@ -24,6 +24,7 @@
 
 #include "index_factory.h"
 #include "masstree_index.h"
+#include "art_index.h"
 #include "utilities.h"
 
 namespace MOT {
@@ -99,6 +100,11 @@ Index* IndexFactory::CreatePrimaryTreeIndex(IndexTreeFlavor flavor)
             result = new (std::nothrow) MasstreePrimaryIndex();
             break;
 
+        case IndexTreeFlavor::INDEX_TREE_FLAVOR_ART:
+            MOT_LOG_DEBUG("Creating ART index.");
+            result = new (std::nothrow) ArtPrimaryIndex();
+            break;
+
         default:
             MOT_REPORT_ERROR(MOT_ERROR_INVALID_ARG,
                 "Create Primary Tree Index",
@@ -113,6 +119,8 @@ Index* IndexFactory::CreatePrimaryTreeIndex(IndexTreeFlavor flavor)
             "Failed to allocate primary index of flavor %u (%s): out of memory",
             flavor,
             IndexTreeFlavorToString(flavor));
+    } else {
+        result->SetTreeFlavor(flavor);
     }
 
     return result;
@@ -1061,7 +1061,8 @@ size_t Table::SerializeItemSize(MOT::Index* index) const
                  SerializablePOD<uint32_t>::SerializeSize(index->m_numTableFields) +
                  SerializablePOD<bool>::SerializeSize(index->m_fake) +
                  SerializableARR<uint16_t, MAX_KEY_COLUMNS>::SerializeSize(index->m_lengthKeyFields) +
-                 SerializableARR<int16_t, MAX_KEY_COLUMNS>::SerializeSize(index->m_columnKeyFields);
+                 SerializableARR<int16_t, MAX_KEY_COLUMNS>::SerializeSize(index->m_columnKeyFields) +
+                 SerializablePOD<IndexTreeFlavor>::SerializeSize(index->m_indexTreeFlavor);
     return ret;
 }
 
@@ -1085,6 +1086,7 @@ char* Table::SerializeItem(char* dataOut, MOT::Index* index) const
     dataOut = SerializablePOD<bool>::Serialize(dataOut, index->m_fake);
     dataOut = SerializableARR<uint16_t, MAX_KEY_COLUMNS>::Serialize(dataOut, index->m_lengthKeyFields);
     dataOut = SerializableARR<int16_t, MAX_KEY_COLUMNS>::Serialize(dataOut, index->m_columnKeyFields);
+    dataOut = SerializablePOD<IndexTreeFlavor>::Serialize(dataOut, index->m_indexTreeFlavor);
     return dataOut;
 }
 
@@ -1148,6 +1150,12 @@ char* Table::DeserializeMeta(char* dataIn, CommonIndexMeta& meta, uint32_t metaV
     dataIn = SerializablePOD<bool>::Deserialize(dataIn, meta.m_fake);
     dataIn = SerializableARR<uint16_t, MAX_KEY_COLUMNS>::Deserialize(dataIn, meta.m_lengthKeyFields);
     dataIn = SerializableARR<int16_t, MAX_KEY_COLUMNS>::Deserialize(dataIn, meta.m_columnKeyFields);
+    if (metaVersion >= MetadataProtoVersion::METADATA_VER_IDX_FLAVOR) {
+        dataIn = SerializablePOD<IndexTreeFlavor>::Deserialize(dataIn, meta.m_indexTreeFlavor);
+    } else {
+        // indexes of older versions were created with the configured flavor
+        meta.m_indexTreeFlavor = GetGlobalConfiguration().m_indexTreeFlavor;
+    }
     MOT_LOG_DEBUG("%s: %s keyLen: %d Unique: %u", __func__, meta.m_name.c_str(), meta.m_keyLength, meta.m_unique);
     return dataIn;
 }
@@ -1160,7 +1168,7 @@ RC Table::CreateIndexFromMeta(CommonIndexMeta& meta, bool primary, uint32_t tid,
 
     MOT_LOG_DEBUG("%s: %s (%s)", __func__, meta.m_name.c_str(), primary ? "primary" : "secondary");
     if (meta.m_indexingMethod == IndexingMethod::INDEXING_METHOD_TREE) {
-        flavor = GetGlobalConfiguration().m_indexTreeFlavor;
+        flavor = meta.m_indexTreeFlavor;
     }
 
     ix = IndexFactory::CreateIndex(meta.m_indexOrder, meta.m_indexingMethod, flavor);
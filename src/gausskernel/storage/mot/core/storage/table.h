@@ -75,7 +75,8 @@ enum MetadataProtoVersion : uint32_t {
     METADATA_VER_IDX_KEY_LEN = 4,
     METADATA_VER_IDX_COL_UPD = 5,
     METADATA_VER_MVCC = 6,
-    METADATA_VER_CURR = METADATA_VER_MVCC
+    METADATA_VER_IDX_FLAVOR = 7,  // Per index tree flavor
+    METADATA_VER_CURR = METADATA_VER_IDX_FLAVOR
 };
 
 /**
@@ -448,6 +449,33 @@ public:
         return m_tableExId;
     }
 
+    inline uint64_t GetMetadataVer() const
+    {
+        return m_metadataVer;
+    }
+
+    /**
+     * @brief Records that a committed change of this table belongs to the given checkpoint snapshot.
+     * @param snapshotSeq The sequence number of the first checkpoint snapshot containing the change.
+     */
+    inline void SetCheckpointModifiedSeq(uint64_t snapshotSeq)
+    {
+        uint64_t curr = m_checkpointModifiedSeq.load(std::memory_order_relaxed);
+        while (curr < snapshotSeq) {
+            if (m_checkpointModifiedSeq.compare_exchange_weak(curr, snapshotSeq)) {
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Retrieves the highest checkpoint snapshot sequence number that contains a change of this table.
+     */
+    inline uint64_t GetCheckpointModifiedSeq() const
+    {
+        return m_checkpointModifiedSeq.load();
+    }
+
     /**
      * @brief Retrieves the length of the key in the primary index.
      * @return The primary index key length.
@@ -839,6 +867,8 @@ public:
         uint16_t m_lengthKeyFields[MAX_KEY_COLUMNS];
 
         int16_t m_columnKeyFields[MAX_KEY_COLUMNS];
+
+        IndexTreeFlavor m_indexTreeFlavor;
     };
 
     /**
@@ -1045,6 +1075,9 @@ private:
 
     uint32_t m_rowCount = 0;
 
+    /** @var Highest checkpoint snapshot sequence number for which a change of this table was committed. */
+    std::atomic<uint64_t> m_checkpointModifiedSeq{0};
+
     DECLARE_CLASS_LOGGER();
 };
 
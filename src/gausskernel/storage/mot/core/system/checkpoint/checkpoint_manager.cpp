@@ -58,7 +58,11 @@ CheckpointManager::CheckpointManager()
       m_lastReplayLsn(0),
       m_workingDir(""),
       m_inProcessTxnsLsn(0),
-      m_numSerializedEntries(0)
+      m_numSerializedEntries(0),
+      m_snapshotSeq(1),
+      m_inProgressSnapshotSeq(0),
+      m_prevSnapshotSeq(0),
+      m_prevWorkingDir("")
 {}
 
 bool CheckpointManager::Initialize()
@@ -377,6 +381,8 @@ void CheckpointManager::MoveToNextPhase()
     m_cntBit = !m_cntBit;
 
     if (m_phase == CheckpointPhase::CAPTURE) {
+        // transactions that start commit from now on are not part of the current snapshot
+        m_snapshotSeq = m_snapshotSeq + 1;
         if (m_redoLogHandler != nullptr) {
             // hold the redo log lock to avoid inserting additional entries to the
             // log. Once snapshot is taken, this lock will be released in SnapshotReady().
@@ -456,6 +462,10 @@ void CheckpointManager::ApplyWrite(TxnManager* txnMan, Row* origRow, const Acces
     PrimarySentinel* s = static_cast<PrimarySentinel*>(origRow->GetPrimarySentinel());
     MOT_ASSERT(s != nullptr);
 
+    // Transactions that started commit before CAPTURE phase belong to the current snapshot, the rest to
+    // the next one. The snapshot sequence number can not advance while this transaction is committing.
+    s->GetIndex()->GetTable()->SetCheckpointModifiedSeq(m_snapshotSeq);
+
     bool statusBit = s->GetStableStatus();
     switch (startPhase) {
         case REST:
@@ -509,6 +519,8 @@ void CheckpointManager::FillTasksQueue()
     GetTableManager()->AddTablesToList(m_tasksList);
     m_numCpTasks = m_tasksList.size();
     m_mapfileInfo.clear();
+    m_tablesDataInfo.clear();
+    m_inProgressSnapshotSeq = m_snapshotSeq;
     MOT_LOG_DEBUG("CheckpointManager::fillTasksQueue:: got %d tasks", m_tasksList.size());
 }
 
@@ -539,6 +551,7 @@ void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
             MOT_LOG_DEBUG("TaskDone %lu: %u %u segs", m_inProgressId, entry->m_tableId, numSegs);
             std::lock_guard<std::mutex> guard(m_tasksMutex);
             m_mapfileInfo.push_back(entry);
+            m_tablesDataInfo[entry->m_tableId] = {table->GetTableExId(), table->GetMetadataVer(), numSegs};
             m_finishedTasks.push_back(table);
         } else {
             OnError(CheckpointWorkerPool::ErrCodes::MEMORY, "Failed to allocate map file entry", nullptr);
@@ -552,6 +565,34 @@ void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
     }
 }
 
+bool CheckpointManager::GetReusableTableData(Table* table, std::string& prevDir, uint32_t& maxSegId)
+{
+    // In the standby, transactions may start commit in RESOLVE phase and still be committing during
+    // CAPTURE phase, so table changes can not be tracked reliably. Always write the full table there.
+    if (!GetGlobalConfiguration().m_checkpointReuseUnchangedTables || MOTEngine::GetInstance()->IsRecovering()) {
+        return false;
+    }
+
+    // Only the snapshot that immediately follows the last completed one can share its data files
+    if (m_prevSnapshotSeq == 0 || m_prevSnapshotSeq + 1 != m_inProgressSnapshotSeq) {
+        return false;
+    }
+
+    if (table->GetCheckpointModifiedSeq() >= m_inProgressSnapshotSeq) {
+        return false;
+    }
+
+    auto it = m_prevTablesDataInfo.find(table->GetTableId());
+    if (it == m_prevTablesDataInfo.end() || it->second.m_exId != table->GetTableExId() ||
+        it->second.m_metadataVer != table->GetMetadataVer()) {
+        return false;
+    }
+
+    prevDir = m_prevWorkingDir;
+    maxSegId = it->second.m_maxSegId;
+    return true;
+}
+
 void CheckpointManager::CompleteCheckpoint()
 {
     CheckpointControlFile* ctrlFile = CheckpointControlFile::GetCtrlFile();
@@ -593,6 +634,12 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    // The data files of this checkpoint may be reused by the next one
+    m_prevTablesDataInfo.swap(m_tablesDataInfo);
+    m_tablesDataInfo.clear();
+    m_prevSnapshotSeq = m_inProgressSnapshotSeq;
+    m_prevWorkingDir = m_workingDir;
+
     RemoveOldCheckpoints(m_inProgressId);
     MOT_LOG_INFO("MOT checkpoint [%lu:%lu:%lu] completed", m_inProgressId, GetLsn(), GetLastReplayLsn());
 }
@@ -28,6 +28,7 @@
 #include <atomic>
 #include <iostream>
 #include <pthread.h>
+#include <unordered_map>
 #include "rw_lock.h"
 #include "global.h"
 #include "txn.h"
@@ -138,6 +139,16 @@ public:
         return m_tasksList;
     }
 
+    /**
+     * @brief Checks whether the data files of a table in the previous checkpoint can be reused
+     * by the current checkpoint, i.e. no change of the table was committed since then.
+     * @param table The table's pointer.
+     * @param prevDir The returned directory of the previous checkpoint.
+     * @param maxSegId The returned maximum segment id of the table in the previous checkpoint.
+     * @return Boolean value denoting whether the data files can be reused.
+     */
+    bool GetReusableTableData(Table* table, std::string& prevDir, uint32_t& maxSegId) override;
+
     /**
      * @brief Checkpoint task error callback
      * @param errCode The error's code.
@@ -219,6 +230,12 @@ public:
         uint32_t m_maxSegId;
     };
 
+    struct TableDataInfo {
+        uint64_t m_exId;
+        uint64_t m_metadataVer;
+        uint32_t m_maxSegId;
+    };
+
 private:
     RwLock m_lock;
 
@@ -299,6 +316,22 @@ private:
     // this lock guards gs_ctl checkpoint fetching
     pthread_rwlock_t m_fetchLock;
 
+    // Sequence number of the next checkpoint snapshot, advanced when moving to CAPTURE phase
+    volatile uint64_t m_snapshotSeq;
+
+    // Sequence number of the current (in-progress) checkpoint snapshot
+    uint64_t m_inProgressSnapshotSeq;
+
+    // Sequence number of the snapshot of the last checkpoint completed by this process (0 if none)
+    uint64_t m_prevSnapshotSeq;
+
+    // Directory of the last checkpoint completed by this process
+    std::string m_prevWorkingDir;
+
+    // Data files information of the tables in the current and in the last completed checkpoint
+    std::unordered_map<uint32_t, TableDataInfo> m_tablesDataInfo;
+    std::unordered_map<uint32_t, TableDataInfo> m_prevTablesDataInfo;
+
     CheckpointPhase GetPhase() const
     {
         return m_phase;
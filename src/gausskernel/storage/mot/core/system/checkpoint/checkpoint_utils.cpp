@@ -121,6 +121,19 @@ bool SeekFile(int fd, off64_t offset)
     return (rc != -1);
 }
 
+bool LinkFile(const std::string& srcFileName, const std::string& dstFileName)
+{
+    if (link(srcFileName.c_str(), dstFileName.c_str()) == -1) {
+        MOT_LOG_WARN("Failed to link file %s to %s, error %d:%s",
+            srcFileName.c_str(),
+            dstFileName.c_str(),
+            errno,
+            gs_strerror(errno));
+        return false;
+    }
+    return true;
+}
+
 bool GetWorkingDir(std::string& dir)
 {
     dir.clear();
@@ -133,6 +133,14 @@ int FlushFile(int fd);
  */
 bool SeekFile(int fd, off64_t offset);
 
+/**
+ * @brief A wrapper function that creates a hard link to an existing file.
+ * @param srcFileName The existing file.
+ * @param dstFileName The new link name.
+ * @return Boolean value denoting success or failure.
+ */
+bool LinkFile(const std::string& srcFileName, const std::string& dstFileName);
+
 /**
  * @brief Frees a row's stable version row.
  * @param row The row which stable version needs to be freed.
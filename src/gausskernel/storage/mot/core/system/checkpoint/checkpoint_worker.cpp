@@ -87,6 +87,11 @@ CheckpointWorkerPool::~CheckpointWorkerPool()
 
 bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd, uint64_t transactionId)
 {
+    if (buffer == nullptr) {
+        // the row is already contained in the data files reused from the previous checkpoint
+        return true;
+    }
+
     MaxKey key;
     Key* primaryKey = &key;
     Index* index = row->GetTable()->GetPrimaryIndex();
@@ -361,7 +366,19 @@ void CheckpointWorkerPool::WorkerFunc(uint32_t workerId)
                 uint64_t numOps = 0;
                 (void)clock_gettime(CLOCK_MONOTONIC, &start);
 
-                errCode = WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps);
+                std::string prevDir;
+                uint32_t prevMaxSegId = 0;
+                bool reuseData = m_cpManager.GetReusableTableData(table, prevDir, prevMaxSegId) &&
+                                 LinkTableDataFiles(tableId, prevDir, prevMaxSegId);
+
+                errCode = WriteTableDataFile(table,
+                    reuseData ? nullptr : &buffer,
+                    deletedList,
+                    gcSession,
+                    threadId,
+                    reuseData,
+                    maxSegId,
+                    numOps);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to write table data file for table %u, "
                                   "error: %u",
@@ -373,6 +390,10 @@ void CheckpointWorkerPool::WorkerFunc(uint32_t workerId)
                     break;
                 }
 
+                if (reuseData) {
+                    maxSegId = prevMaxSegId;
+                }
+
                 taskSucceeded = true;
                 (void)clock_gettime(CLOCK_MONOTONIC, &end);
                 /*
@@ -381,10 +402,11 @@ void CheckpointWorkerPool::WorkerFunc(uint32_t workerId)
                  */
                 uint64_t deltaUs = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
                 MOT_LOG_DEBUG(
-                    "CheckpointWorkerPool::WorkerFunc: Checkpoint of table %u completed in %luus, (%lu elements)",
+                    "CheckpointWorkerPool::WorkerFunc: Checkpoint of table %u completed in %luus, (%lu elements%s)",
                     tableId,
                     deltaUs,
-                    numOps);
+                    numOps,
+                    reuseData ? ", reused" : "");
             } while (0);
 
             m_cpManager.TaskDone(table, maxSegId, taskSucceeded);
@@ -543,8 +565,35 @@ bool CheckpointWorkerPool::KeepIterating(
     return it->IsValid();
 }
 
+bool CheckpointWorkerPool::LinkTableDataFiles(uint32_t tableId, const std::string& prevDir, uint32_t maxSegId)
+{
+    std::string srcFileName;
+    std::string dstFileName;
+    for (uint32_t seg = 0; seg <= maxSegId; seg++) {
+        CheckpointUtils::MakeCpFilename(tableId, srcFileName, prevDir, seg);
+        CheckpointUtils::MakeCpFilename(tableId, dstFileName, m_cpManager.GetWorkingDir(), seg);
+        if (!CheckpointUtils::LinkFile(srcFileName, dstFileName)) {
+            // Remove the links created so far, the data files are going to be written instead. Data files are
+            // not truncated when opened, so a leftover link would overwrite the previous checkpoint's file.
+            for (uint32_t i = 0; i < seg; i++) {
+                CheckpointUtils::MakeCpFilename(tableId, dstFileName, m_cpManager.GetWorkingDir(), i);
+                if (unlink(dstFileName.c_str()) != 0) {
+                    MOT_LOG_ERROR("CheckpointWorkerPool::LinkTableDataFiles: failed to remove link %s, error %d:%s",
+                        dstFileName.c_str(),
+                        errno,
+                        gs_strerror(errno));
+                    m_cpManager.OnError(ErrCodes::FILE_IO, "Failed to remove data file link ", dstFileName.c_str());
+                }
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
 CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* table, Buffer* buffer,
-    DeletePair* deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps)
+    DeletePair* deletedList, GcManager* gcSession, uint16_t threadId, bool reuseData, uint32_t& maxSegId,
+    uint64_t& numOps)
 {
     uint32_t tableId = table->GetTableId();
     uint64_t exId = table->GetTableExId();
@@ -575,7 +624,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
         return ErrCodes::INDEX;
     }
 
-    if (!BeginFile(fd, tableId, maxSegId, exId)) {
+    if (!reuseData && !BeginFile(fd, tableId, maxSegId, exId)) {
         MOT_LOG_ERROR(
             "CheckpointWorkerPool::WriteTableDataFile: failed to create data file %u for table %u", maxSegId, tableId);
         delete it;
@@ -606,7 +655,9 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             deletedList[deletedListLocation].second = deletedVersion;
             deletedListLocation++;
         }
-        if (ckptStatus == 1) {
+        if (ckptStatus == 1 && reuseData) {
+            numOps++;
+        } else if (ckptStatus == 1) {
             currFileOps++;
             curSegLen += table->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader);
             if (curSegLen >= m_checkpointSegsize) {
@@ -672,6 +723,10 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
         return errCode;
     }
 
+    if (reuseData) {
+        return ErrCodes::SUCCESS;
+    }
+
     if (!FlushBuffer(fd, buffer)) {
         MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDataFile: failed to write remaining buffer data (%u bytes) to "
                       "data file %u for table %u",
@@ -71,6 +71,14 @@ public:
      */
     virtual std::list<Table*>& GetTasksList() = 0;
 
+    /**
+     * @brief Checks whether the table's data files of the previous checkpoint can be reused.
+     * @param table The table's pointer.
+     * @param prevDir The returned directory of the previous checkpoint.
+     * @param maxSegId The returned maximum segment id of the table in the previous checkpoint.
+     */
+    virtual bool GetReusableTableData(Table* table, std::string& prevDir, uint32_t& maxSegId) = 0;
+
     /**
      * @brief returns the current NA bit.
      */
@@ -179,12 +187,23 @@ private:
      * @param deletedList Array to collect the sentinels deleted rows to be cleaned.
      * @param gcSession GC manager object.
      * @param threadId The thread id.
+     * @param reuseData Indicates that the data files were linked from the previous checkpoint, so the rows
+     * are only processed for the checkpoint state and not written.
      * @param maxSegId The maximum segment ID of the table.
      * @param numOps The number of rows written.
      * @return Returns the error code of type ErrCodes.
      */
     ErrCodes WriteTableDataFile(Table* table, Buffer* buffer, DeletePair* deletedList, GcManager* gcSession,
-        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps);
+        uint16_t threadId, bool reuseData, uint32_t& maxSegId, uint64_t& numOps);
+
+    /**
+     * @brief Links the table data files of the previous checkpoint into the current checkpoint directory.
+     * @param tableId The table id.
+     * @param prevDir The directory of the previous checkpoint.
+     * @param maxSegId The maximum segment ID of the table in the previous checkpoint.
+     * @return Boolean value denoting success or failure. On failure no link is left behind.
+     */
+    bool LinkTableDataFiles(uint32_t tableId, const std::string& prevDir, uint32_t maxSegId);
 
     /* @brief Checks whether we should continue to iterate on a table.
      * Recreates the iterator when the number of iterations exceeds a threshold.
@@ -66,6 +66,7 @@ constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_WORKERS;
+constexpr bool MOTConfiguration::DEFAULT_CHECKPOINT_REUSE_UNCHANGED_TABLES;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_RECOVERY_WORKERS;
@@ -471,6 +472,7 @@ MOTConfiguration::MOTConfiguration()
       m_checkpointDir(DEFAULT_CHECKPOINT_DIR),
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
+      m_checkpointReuseUnchangedTables(DEFAULT_CHECKPOINT_REUSE_UNCHANGED_TABLES),
       m_recoveryMode(DEFAULT_RECOVERY_MODE),
       m_parallelRecoveryWorkers(DEFAULT_PARALLEL_RECOVERY_WORKERS),
       m_parallelRecoveryQueueSize(DEFAULT_PARALLEL_RECOVERY_QUEUE_SIZE),
@@ -584,6 +586,7 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseString(name, "checkpoint_dir", value, &m_checkpointDir)) {
     } else if (ParseUint64(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
+    } else if (ParseBool(name, "checkpoint_reuse_unchanged_tables", value, &m_checkpointReuseUnchangedTables)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
     } else if (ParseRecoveryMode(name, "recovery_mode", value, &m_recoveryMode)) {
     } else if (ParseUint32(name, "parallel_recovery_workers", value, &m_parallelRecoveryWorkers)) {
@@ -988,6 +991,9 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_WORKERS,
         MIN_CHECKPOINT_WORKERS,
         MAX_CHECKPOINT_WORKERS);
+    UPDATE_BOOL_CFG(m_checkpointReuseUnchangedTables,
+        "checkpoint_reuse_unchanged_tables",
+        DEFAULT_CHECKPOINT_REUSE_UNCHANGED_TABLES);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers,
@@ -1107,7 +1113,10 @@ void MOTConfiguration::LoadConfig()
     if (m_loadExtraParams) {
         UPDATE_BOOL_CFG(
             m_allowIndexOnNullableColumn, "allow_index_on_nullable_column", DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN);
-        UPDATE_USER_CFG(m_indexTreeFlavor, "index_tree_flavor", DEFAULT_INDEX_TREE_FLAVOR);
+    }
+    UPDATE_USER_CFG(m_indexTreeFlavor, "index_tree_flavor", DEFAULT_INDEX_TREE_FLAVOR);
+    if (m_indexTreeFlavor == IndexTreeFlavor::INDEX_TREE_FLAVOR_ART) {
+        MOT_LOG_WARN("Index tree flavor ArtFlavor is experimental, new indexes use it by default");
     }
 
     // general configuration
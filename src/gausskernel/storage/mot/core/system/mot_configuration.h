@@ -170,6 +170,9 @@ public:
     /** @var number of worker threads to spawn to perform checkpoint. */
     uint32_t m_checkpointWorkers;
 
+    /** @var Reuse the previous checkpoint data files of tables that were not modified since then. */
+    bool m_checkpointReuseUnchangedTables;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -474,6 +477,9 @@ public:
     static constexpr uint32_t MIN_CHECKPOINT_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_WORKERS = 1024;
 
+    /** @var Default reuse of unchanged tables data files in checkpoint. */
+    static constexpr bool DEFAULT_CHECKPOINT_REUSE_UNCHANGED_TABLES = false;
+
     /** ------------------ Default Recovery Configuration ------------ */
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
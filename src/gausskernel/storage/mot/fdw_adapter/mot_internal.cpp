@@ -39,8 +39,10 @@
 #include "executor/executor.h"
 #include "storage/ipc.h"
 #include "commands/dbcommands.h"
+#include "commands/defrem.h"
 #include "knl/knl_session.h"
 #include "utils/date.h"
+#include "utils/rel_gs.h"
 
 #include "mot_internal.h"
 #include "mot_fdw_helpers.h"
@@ -905,6 +907,22 @@ static void ValidateCreateIndex(IndexStmt* stmt, MOT::Table* table, MOT::TxnMana
     }
 }
 
+static MOT::IndexTreeFlavor GetIndexTreeFlavor(IndexStmt* stmt)
+{
+    // The tree_flavor option of the index overrides the configured default, the value was validated already
+    ListCell* lc = nullptr;
+    foreach (lc, stmt->options) {
+        DefElem* def = (DefElem*)lfirst(lc);
+        if (pg_strcasecmp(def->defname, "tree_flavor") == 0) {
+            if (pg_strcasecmp(defGetString(def), TREE_FLAVOR_OPT_ART) == 0) {
+                return MOT::IndexTreeFlavor::INDEX_TREE_FLAVOR_ART;
+            }
+            return MOT::IndexTreeFlavor::INDEX_TREE_FLAVOR_MASSTREE;
+        }
+    }
+    return MOT::GetGlobalConfiguration().m_indexTreeFlavor;
+}
+
 MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
 {
     MOT::RC res;
@@ -944,9 +962,9 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
     MOT::Index* index = nullptr;
     MOT::IndexOrder index_order = MOT::IndexOrder::INDEX_ORDER_SECONDARY;
 
-    // Use the default index tree flavor from configuration file
+    // Use the index tree flavor of the index, or the default one from configuration file
     MOT::IndexingMethod indexing_method = MOT::IndexingMethod::INDEXING_METHOD_TREE;
-    MOT::IndexTreeFlavor flavor = MOT::GetGlobalConfiguration().m_indexTreeFlavor;
+    MOT::IndexTreeFlavor flavor = GetIndexTreeFlavor(stmt);
 
     // check if we have primary and delete previous definition
     if (stmt->primary) {
@@ -19,7 +19,9 @@
 
 #include "access/xlog_internal.h" /* for pg_start/stop_backup */
 #include "access/cbmparsexlog.h"
+#include "access/hash.h"
 #include "catalog/catalog.h"
+#include "catalog/pg_tablespace.h"
 #include "catalog/pg_type.h"
 #include "gs_thread.h"
 #include "lib/stringinfo.h"
@@ -28,6 +30,7 @@
 #include "nodes/pg_list.h"
 #include "replication/basebackup.h"
 #include "replication/dcf_data.h"
+#include "replication/incremental_backup.h"
 #include "replication/walsender.h"
 #include "replication/walsender_private.h"
 #include "replication/slot.h"
@@ -67,8 +70,39 @@ typedef struct {
     bool isCopySecureFiles;
     bool isCopyUpgradeFile;
     bool isObsmode;
+    XLogRecPtr incrementalLsn; /* send only blocks changed since this location */
+    int parallel;                 /* number of streams sending this backup, 0 if one */
+    XLogRecPtr parallelWorkerLsn; /* start location of the backup to help sending */
 } basebackup_options;
 
+/*
+ * Blocks of one relation fork changed since the start location of an
+ * incremental backup, as reported by the changed block map.
+ */
+typedef struct IncrementalRelKey {
+    Oid spcNode;
+    Oid dbNode;
+    Oid relNode;
+    ForkNumber forkNum;
+} IncrementalRelKey;
+
+typedef struct IncrementalRelEntry {
+    IncrementalRelKey key;
+    uint8 changeType;
+    BlockNumber truncBlockNum;
+    uint32 nblocks;
+    BlockNumber *blocks; /* sorted ascending */
+} IncrementalRelEntry;
+
+/* how long to wait for the changed block map to catch up with the backup start */
+#define INCREMENTAL_CBM_TRACK_TIMEOUT (600 * 1000)
+
+/* parallel base backup, see ParallelBackupCtl */
+#define MAX_PARALLEL_BACKUP_STREAMS 32
+#define PARALLEL_BACKUP_MAIN_ID 1
+#define PARALLEL_BACKUP_ATTACH_TIMEOUT (600 * 1000) /* ms */
+#define PARALLEL_BACKUP_POLL_INTERVAL 100000L       /* us */
+
 #define BUILD_PATH_LEN 2560 /* (MAXPGPATH*2 + 512) */
 const int FILE_NAME_MAX_LEN = 1024;
 const int MATCH_ONE = 1;
@@ -78,6 +112,7 @@ const int MATCH_FOUR = 4;
 const int MATCH_FIVE = 5;
 const int MATCH_SIX = 6;
 const int MATCH_SEVEN = 7;
+const Oid SEGMENT_PHYSICAL_RELNODE_MAX = 5;
 
 /*
  * Size of each block sent into the tar stream for larger files.
@@ -115,6 +150,13 @@ static void perform_base_backup(basebackup_options *opt, DIR *tblspcdir);
 static void parse_basebackup_options(List *options, basebackup_options *opt);
 static int CompareWalFileNames(const void* a, const void* b);
 static void SendXlogRecPtrResult(XLogRecPtr ptr, unsigned long long consensusPaxosIdx = 0);
+static void BuildIncrementalBlockMap(XLogRecPtr incrementalLsn, XLogRecPtr backupStartPtr);
+static bool SendIncrementalFile(char *readfilename, char *tarfilename, struct stat *statbuf, int64 *size);
+static void RegisterParallelBackup(int nhelpers, XLogRecPtr startptr);
+static void ReleaseParallelBackup(bool aborted);
+static void WaitParallelBackupHelpers(void);
+static bool ParallelBackupClaimFile(const char *tarfilename);
+static void PerformParallelBackupWorker(basebackup_options *opt, DIR *tblspcdir);
 
 static void send_xlog_location();
 static void send_xlog_header(const char *linkpath);
@@ -247,6 +289,8 @@ static void send_xlog_location()
  */
 static void base_backup_cleanup(int code, Datum arg)
 {
+    t_thrd.basebackup_cxt.incremental_blocks = NULL;
+    ReleaseParallelBackup(true);
     do_pg_abort_backup();
 }
 
@@ -410,6 +454,8 @@ static void perform_base_backup(basebackup_options *opt, DIR *tblspcdir)
             do_pg_start_backup(opt->label, opt->fastcheckpoint, &labelfile, tblspcdir, &tblspc_map_file, &tablespaces,
             opt->progress, opt->sendtblspcmapfile);
     }
+    /* changed blocks are collected up to the checkpoint the backup starts from */
+    XLogRecPtr backupStartPtr = startptr;
     if (opt->isObsmode) {
         t_thrd.walsender_cxt.is_obsmode = true;
     }
@@ -450,12 +496,37 @@ static void perform_base_backup(basebackup_options *opt, DIR *tblspcdir)
     if (startSegNo <= lastRemovedSegno) {
         startptr = (lastRemovedSegno + 1) * XLogSegSize;
     }
-    SendXlogRecPtrResult(startptr);
 
     PG_ENSURE_ERROR_CLEANUP(base_backup_cleanup, (Datum)0);
+    /* helper streams identify the backup by the start location the client gets */
+    if (opt->parallel > 0) {
+        RegisterParallelBackup(opt->parallel - 1, startptr);
+    }
+    SendXlogRecPtrResult(startptr);
+
+    if (!XLogRecPtrIsInvalid(opt->incrementalLsn)) {
+        StringInfoData incLabel;
+
+        BuildIncrementalBlockMap(opt->incrementalLsn, backupStartPtr);
+        /* gs_basebackup checks this against the prior backup before merging */
+        initStringInfo(&incLabel);
+        appendStringInfo(&incLabel, "%s" INCREMENTAL_LABEL_LINE "%X/%X\n", labelfile,
+                         (uint32)(opt->incrementalLsn >> 32), (uint32)opt->incrementalLsn);
+        labelfile = incLabel.data;
+    }
     SendTableSpaceForBackup(opt, tablespaces, labelfile, tblspc_map_file);
+    if (opt->parallel > 0) {
+        ReleaseParallelBackup(false);
+    }
     PG_END_ENSURE_ERROR_CLEANUP(base_backup_cleanup, (Datum)0);
 
+    if (t_thrd.basebackup_cxt.incremental_blocks != NULL) {
+        ereport(LOG, (errmsg("incremental base backup since %X/%X sent %lu changed blocks and skipped %lu unchanged "
+                             "blocks", (uint32)(opt->incrementalLsn >> 32), (uint32)opt->incrementalLsn,
+                             t_thrd.basebackup_cxt.incremental_blocks_sent,
+                             t_thrd.basebackup_cxt.incremental_blocks_skipped)));
+    }
+
     if (opt->isBuildFromStandby) {
         endptr = StandbyDoStopBackup(labelfile);
     } else {
@@ -750,6 +821,9 @@ static void parse_basebackup_options(List *options, basebackup_options *opt)
     bool o_iscopyupgradefile = false;
     bool o_tablespace_map = false;
     bool o_isobsmode = false;
+    bool o_incremental = false;
+    bool o_parallel = false;
+    bool o_parallel_worker = false;
     errno_t rc = memset_s(opt, sizeof(*opt), 0, sizeof(*opt));
     securec_check(rc, "", "");
     foreach (lopt, options) {
@@ -809,12 +883,68 @@ static void parse_basebackup_options(List *options, basebackup_options *opt)
             }
             opt->isCopyUpgradeFile = true;
             o_iscopyupgradefile = true;
+        } else if (strcmp(defel->defname, "incremental") == 0) {
+            uint32 hi = 0;
+            uint32 lo = 0;
+            if (o_incremental) {
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("duplicate option \"%s\"", defel->defname)));
+            }
+            if (sscanf_s(strVal(defel->arg), "%X/%X", &hi, &lo) != 2) {
+                ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                                errmsg("could not parse incremental start location \"%s\"", strVal(defel->arg))));
+            }
+            opt->incrementalLsn = (((uint64)hi) << 32) | lo;
+            if (XLogRecPtrIsInvalid(opt->incrementalLsn)) {
+                ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                                errmsg("invalid incremental start location \"%s\"", strVal(defel->arg))));
+            }
+            o_incremental = true;
+        } else if (strcmp(defel->defname, "parallel") == 0) {
+            if (o_parallel) {
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("duplicate option \"%s\"", defel->defname)));
+            }
+            opt->parallel = intVal(defel->arg);
+            if (opt->parallel < 1 || opt->parallel > MAX_PARALLEL_BACKUP_STREAMS) {
+                ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                                errmsg("%d is outside the valid range for parallel base backup streams (1 .. %d)",
+                                       opt->parallel, MAX_PARALLEL_BACKUP_STREAMS)));
+            }
+            if (opt->parallel == 1) {
+                opt->parallel = 0;
+            }
+            o_parallel = true;
+        } else if (strcmp(defel->defname, "parallel_worker") == 0) {
+            uint32 hi = 0;
+            uint32 lo = 0;
+            if (o_parallel_worker) {
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("duplicate option \"%s\"", defel->defname)));
+            }
+            if (sscanf_s(strVal(defel->arg), "%X/%X", &hi, &lo) != 2) {
+                ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                                errmsg("could not parse parallel base backup start location \"%s\"",
+                                       strVal(defel->arg))));
+            }
+            opt->parallelWorkerLsn = (((uint64)hi) << 32) | lo;
+            o_parallel_worker = true;
         } else {
             ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("option \"%s\" not recognized", defel->defname)));
         }
     }
     if (opt->label == NULL)
         opt->label = "base backup";
+    if (o_incremental && (opt->isBuildFromStandby || ENABLE_DSS)) {
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                        errmsg("incremental base backup can only be taken from a primary on local storage")));
+    }
+    if ((opt->parallel > 0 || o_parallel_worker) && (o_incremental || ENABLE_DSS)) {
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                        errmsg("parallel base backup does not support incremental backups or shared storage")));
+    }
+    if (o_parallel_worker && (opt->parallel > 0 || opt->includewal || opt->isBuildFromStandby ||
+        opt->sendtblspcmapfile || opt->isCopySecureFiles)) {
+        ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR),
+                        errmsg("PARALLEL_WORKER cannot be combined with options starting a base backup")));
+    }
 }
 
 /*
@@ -875,10 +1005,22 @@ void SendBaseBackup(BaseBackupCmd *cmd)
         return;
     }
 
+    /* a helper stream of a parallel backup only sends its share of the relation files */
+    if (!XLogRecPtrIsInvalid(opt.parallelWorkerLsn)) {
+        PerformParallelBackupWorker(&opt, dir);
+        FreeDir(dir);
+        MemoryContextSwitchTo(old_context);
+        MemoryContextDelete(backup_context);
+        return;
+    }
+
     /* read xlog location ,if xlog is a link ,send the link to client */
     send_xlog_location();
 
+    /* the changed block map lives in backup_context, never reuse one from an earlier backup */
+    t_thrd.basebackup_cxt.incremental_blocks = NULL;
     perform_base_backup(&opt, dir);
+    t_thrd.basebackup_cxt.incremental_blocks = NULL;
 
     FreeDir(dir);
 
@@ -1350,10 +1492,17 @@ static bool IsDCFPath(const char *pathname)
 static int64 SendRealFile(bool sizeOnly, char* pathbuf, int basepathlen, struct stat* statbuf)
 {
     int64 size = 0;
+    if (!sizeOnly && !ParallelBackupClaimFile(pathbuf + basepathlen + 1)) {
+        return size;
+    }
     // we must ensure the page integrity when in IncrementalCheckpoint
     if (!sizeOnly && g_instance.attr.attr_storage.enableIncrementalCheckpoint &&
         IsCompressedFile(pathbuf, strlen(pathbuf))) {
         SendCompressedFile(pathbuf, basepathlen, (*statbuf), true, &size);
+    } else if (!sizeOnly && t_thrd.basebackup_cxt.incremental_blocks != NULL &&
+        !IsCompressedFile(pathbuf, strlen(pathbuf)) &&
+        SendIncrementalFile(pathbuf, pathbuf + basepathlen + 1, statbuf, &size)) {
+        /* only the changed blocks of this relation segment were sent */
     } else {
         bool sent = false;
         if (!sizeOnly) {
@@ -1924,6 +2073,8 @@ static void SendTableSpaceForBackup(basebackup_options* opt, List* tablespaces,
         if (iterti->path == NULL)
             sendFileWithContent(BACKUP_LABEL_FILE, labelfile);
 
+        t_thrd.basebackup_cxt.send_spcnode = (iterti->path != NULL) ? atooid(iterti->oid) : InvalidOid;
+
         /*
          * if the tblspc created in datadir , the files under tblspc do not send,
          * and send them as normal under datadir,
@@ -1944,7 +2095,15 @@ static void SendTableSpaceForBackup(basebackup_options* opt, List* tablespaces,
                     sendDir(dssdir, 1, false, tablespaces, true);
                 }
         }
-        
+
+        /*
+         * pg_control tells the client the backup is complete, so every helper
+         * stream must have sent its relation files before it goes out.
+         */
+        if (iterti->path == NULL && opt->parallel > 0) {
+            WaitParallelBackupHelpers();
+        }
+
         /* In the main tar, include pg_control last. */
         if (iterti->path == NULL) {
             struct stat statbuf;
@@ -2164,6 +2323,541 @@ static void SendCompressedFile(char* readFileName, int basePathLen, struct stat&
  * Returns true if the file was successfully sent, false if 'missing_ok',
  * and the file did not exist.
  */
+static int IncrementalBlockCmp(const void *a, const void *b)
+{
+    BlockNumber blkA = *(const BlockNumber *)a;
+    BlockNumber blkB = *(const BlockNumber *)b;
+
+    if (blkA == blkB) {
+        return 0;
+    }
+    return (blkA < blkB) ? -1 : 1;
+}
+
+/*
+ * Collect the blocks changed between incrementalLsn and the checkpoint this
+ * backup starts from out of the changed block map. Anything changed later is
+ * covered by the WAL shipped with the backup.
+ */
+static void BuildIncrementalBlockMap(XLogRecPtr incrementalLsn, XLogRecPtr backupStartPtr)
+{
+    HASHCTL ctl;
+    errno_t rc;
+
+    if (XLByteLT(backupStartPtr, incrementalLsn)) {
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                        errmsg("incremental start location %X/%X is beyond the backup start location %X/%X",
+                               (uint32)(incrementalLsn >> 32), (uint32)incrementalLsn,
+                               (uint32)(backupStartPtr >> 32), (uint32)backupStartPtr)));
+    }
+
+    if (XLogRecPtrIsInvalid(ForceTrackCBMOnce(backupStartPtr, INCREMENTAL_CBM_TRACK_TIMEOUT, true, false))) {
+        ereport(ERROR, (errcode(ERRCODE_CONNECTION_TIMED_OUT),
+                        errmsg("timeout while tracking changed blocks up to %X/%X for incremental backup",
+                               (uint32)(backupStartPtr >> 32), (uint32)backupStartPtr)));
+    }
+
+    LWLockAcquire(CBMParseXlogLock, LW_SHARED);
+    CBMArray *cbmArray = CBMGetMergedArray(incrementalLsn, backupStartPtr);
+    LWLockRelease(CBMParseXlogLock);
+
+    rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+    securec_check(rc, "", "");
+    ctl.keysize = sizeof(IncrementalRelKey);
+    ctl.entrysize = sizeof(IncrementalRelEntry);
+    ctl.hcxt = CurrentMemoryContext;
+    HTAB *relTab = hash_create("incremental backup block map", Max(cbmArray->arrayLength, 64), &ctl,
+                               HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
+    for (long i = 0; i < cbmArray->arrayLength; i++) {
+        CBMArrayEntry *cbmEntry = &cbmArray->arrayEntry[i];
+        IncrementalRelKey key;
+        bool found = false;
+
+        /* segment-page storage is always sent whole */
+        if (IsSegmentFileNode(cbmEntry->cbmTag.rNode)) {
+            continue;
+        }
+
+        rc = memset_s(&key, sizeof(key), 0, sizeof(key));
+        securec_check(rc, "", "");
+        key.spcNode = cbmEntry->cbmTag.rNode.spcNode;
+        key.dbNode = cbmEntry->cbmTag.rNode.dbNode;
+        key.relNode = cbmEntry->cbmTag.rNode.relNode;
+        key.forkNum = cbmEntry->cbmTag.forkNum;
+
+        IncrementalRelEntry *entry = (IncrementalRelEntry *)hash_search(relTab, &key, HASH_ENTER, &found);
+        if (found) {
+            /* the same file reached under two tags, don't try to merge them */
+            entry->changeType |= PAGETYPE_CREATE;
+            continue;
+        }
+        entry->changeType = cbmEntry->changeType;
+        entry->truncBlockNum = cbmEntry->truncBlockNum;
+        entry->nblocks = cbmEntry->totalBlockNum;
+        entry->blocks = NULL;
+        if (entry->nblocks > 0) {
+            Size len = (Size)entry->nblocks * sizeof(BlockNumber);
+            entry->blocks = (BlockNumber *)palloc_huge(CurrentMemoryContext, len);
+            rc = memcpy_s(entry->blocks, len, cbmEntry->changedBlock, len);
+            securec_check(rc, "", "");
+            qsort(entry->blocks, entry->nblocks, sizeof(BlockNumber), IncrementalBlockCmp);
+        }
+    }
+
+    ereport(LOG, (errmsg("incremental base backup tracks %ld changed relation forks between %X/%X and %X/%X",
+                         hash_get_num_entries(relTab), (uint32)(incrementalLsn >> 32), (uint32)incrementalLsn,
+                         (uint32)(backupStartPtr >> 32), (uint32)backupStartPtr)));
+
+    FreeCBMArray(cbmArray);
+    t_thrd.basebackup_cxt.incremental_blocks = relTab;
+    t_thrd.basebackup_cxt.incremental_blocks_sent = 0;
+    t_thrd.basebackup_cxt.incremental_blocks_skipped = 0;
+}
+
+/*
+ * Work out which relation fork and segment a tar member is, for the plain
+ * relation files an incremental backup can send block-wise. FSM and BCM forks
+ * are not fully WAL-logged and the first relfilenodes of a database belong to
+ * segment-page storage, so those are left to be sent whole.
+ */
+static bool IncrementalRelFileKey(const char *tarfilename, IncrementalRelKey *key, int *segNo)
+{
+    char name[MAXPGPATH];
+    unsigned int dbNode = 0;
+    char *p = NULL;
+    errno_t rc = memset_s(key, sizeof(*key), 0, sizeof(*key));
+    securec_check(rc, "", "");
+
+    if (sscanf_s(tarfilename, "base/%u/%s", &dbNode, name, sizeof(name)) == MATCH_TWO) {
+        key->spcNode = DEFAULTTABLESPACE_OID;
+    } else if (sscanf_s(tarfilename, "global/%s", name, sizeof(name)) == MATCH_ONE) {
+        key->spcNode = GLOBALTABLESPACE_OID;
+    } else if (OidIsValid(t_thrd.basebackup_cxt.send_spcnode) &&
+               sscanf_s(tarfilename, "%*[^/]/%u/%s", &dbNode, name, sizeof(name)) == MATCH_TWO) {
+        key->spcNode = t_thrd.basebackup_cxt.send_spcnode;
+    } else {
+        return false;
+    }
+    key->dbNode = dbNode;
+
+    if (!isdigit((unsigned char)name[0])) {
+        return false;
+    }
+    key->relNode = (Oid)strtoul(name, &p, 10);
+    /* segment-page storage data files, see IsSegmentPhysicalRelNode() */
+    if (key->relNode <= SEGMENT_PHYSICAL_RELNODE_MAX) {
+        return false;
+    }
+
+    key->forkNum = MAIN_FORKNUM;
+    if (*p == '_') {
+        ForkNumber forkNum;
+        int forkChars = forkname_chars(p + 1, &forkNum);
+        if (forkChars == 0 || (forkNum != VISIBILITYMAP_FORKNUM && forkNum != INIT_FORKNUM)) {
+            return false;
+        }
+        key->forkNum = forkNum;
+        p += forkChars + 1;
+    }
+
+    *segNo = 0;
+    if (*p == '.') {
+        char *segEnd = NULL;
+        if (!isdigit((unsigned char)p[1])) {
+            return false;
+        }
+        *segNo = (int)strtol(p + 1, &segEnd, 10);
+        p = segEnd;
+    }
+    return *p == '\0';
+}
+
+/*
+ * A relation file has to be sent whole if it, its database or its tablespace
+ * was created or dropped within the incremental range.
+ */
+static IncrementalRelEntry *IncrementalLookup(const IncrementalRelKey *key, bool *sendWhole)
+{
+    HTAB *relTab = t_thrd.basebackup_cxt.incremental_blocks;
+    IncrementalRelKey parent;
+    IncrementalRelEntry *entry = NULL;
+
+    *sendWhole = false;
+    parent = *key;
+    parent.relNode = InvalidOid;
+    parent.forkNum = MAIN_FORKNUM;
+    entry = (IncrementalRelEntry *)hash_search(relTab, &parent, HASH_FIND, NULL);
+    if (entry != NULL && (entry->changeType & (PAGETYPE_CREATE | PAGETYPE_DROP))) {
+        *sendWhole = true;
+        return NULL;
+    }
+    parent.dbNode = InvalidOid;
+    entry = (IncrementalRelEntry *)hash_search(relTab, &parent, HASH_FIND, NULL);
+    if (entry != NULL && (entry->changeType & (PAGETYPE_CREATE | PAGETYPE_DROP))) {
+        *sendWhole = true;
+        return NULL;
+    }
+
+    entry = (IncrementalRelEntry *)hash_search(relTab, key, HASH_FIND, NULL);
+    if (entry != NULL && (entry->changeType & (PAGETYPE_CREATE | PAGETYPE_DROP))) {
+        *sendWhole = true;
+        return NULL;
+    }
+    return entry;
+}
+
+/*
+ * Send a relation segment of an incremental backup as "INCREMENTAL.<name>",
+ * carrying only the blocks changed since the incremental start location, see
+ * replication/incremental_backup.h. Returns false if the file has to be sent
+ * whole instead.
+ */
+static bool SendIncrementalFile(char *readfilename, char *tarfilename, struct stat *statbuf, int64 *size)
+{
+    IncrementalRelKey key;
+    IncrementalFileHeader header;
+    char incname[MAXPGPATH];
+    struct stat incstat;
+    int segNo = 0;
+    bool sendWhole = false;
+    errno_t rc;
+
+    if (!IncrementalRelFileKey(tarfilename, &key, &segNo)) {
+        return false;
+    }
+    IncrementalRelEntry *entry = IncrementalLookup(&key, &sendWhole);
+    if (sendWhole) {
+        return false;
+    }
+
+    BlockNumber fileBlocks = (BlockNumber)(statbuf->st_size / BLCKSZ);
+    BlockNumber segStart = (BlockNumber)segNo * RELSEG_SIZE;
+    BlockNumber *blocks = (BlockNumber *)palloc(Max(fileBlocks, 1) * sizeof(BlockNumber));
+    uint32 nblocks = 0;
+
+    if (entry != NULL) {
+        /* blocks beyond a truncation point may hold anything now, resend all of them */
+        BlockNumber truncFrom = fileBlocks;
+        if ((entry->changeType & PAGETYPE_TRUNCATE) && BlockNumberIsValid(entry->truncBlockNum) &&
+            entry->truncBlockNum < segStart + fileBlocks) {
+            truncFrom = (entry->truncBlockNum > segStart) ? entry->truncBlockNum - segStart : 0;
+        }
+        for (uint32 i = 0; i < entry->nblocks; i++) {
+            BlockNumber blkno = entry->blocks[i];
+            if (blkno < segStart || (i > 0 && blkno == entry->blocks[i - 1])) {
+                continue;
+            }
+            if (blkno - segStart >= truncFrom) {
+                break;
+            }
+            blocks[nblocks++] = blkno - segStart;
+        }
+        for (BlockNumber blkno = truncFrom; blkno < fileBlocks; blkno++) {
+            blocks[nblocks++] = blkno;
+        }
+    }
+
+    /* nothing to save, the plain file is smaller */
+    if (nblocks == fileBlocks && fileBlocks > 0) {
+        pfree(blocks);
+        return false;
+    }
+
+    SendFilePreInit();
+    FILE *fp = SizeCheckAndAllocate(readfilename, *statbuf, true);
+    if (fp == NULL) {
+        pfree(blocks);
+        /* the file went away while scanning, it's no error */
+        return true;
+    }
+
+    const char *base = last_dir_separator(tarfilename);
+    int dirlen = (base == NULL) ? 0 : (int)(base - tarfilename) + 1;
+    rc = snprintf_s(incname, sizeof(incname), sizeof(incname) - 1, "%.*s%s%s", dirlen, tarfilename,
+                    INCREMENTAL_PREFIX, tarfilename + dirlen);
+    securec_check_ss(rc, "", "");
+
+    header.magic = INCREMENTAL_MAGIC;
+    header.nblocks = nblocks;
+    header.truncBlocks = fileBlocks;
+    header.reserved = 0;
+
+    pgoff_t len = (pgoff_t)sizeof(header) + (pgoff_t)nblocks * (sizeof(BlockNumber) + BLCKSZ);
+    incstat = *statbuf;
+    incstat.st_size = len;
+    _tarWriteHeader(incname, NULL, &incstat);
+
+    (void)pq_putmessage_noblock('d', (char *)&header, sizeof(header));
+    if (nblocks > 0) {
+        (void)pq_putmessage_noblock('d', (char *)blocks, nblocks * sizeof(BlockNumber));
+    }
+
+    for (uint32 i = 0; i < nblocks; i++) {
+        size_t cnt = 0;
+        if (t_thrd.walsender_cxt.walsender_ready_to_stop) {
+            ereport(ERROR, (errcode_for_file_access(), errmsg("base backup receive stop message, aborting backup")));
+        }
+        if (fseeko(fp, (off_t)blocks[i] * BLCKSZ, SEEK_SET) == 0) {
+            cnt = fread(t_thrd.basebackup_cxt.buf_block, 1, BLCKSZ, fp);
+        }
+        if (cnt != BLCKSZ) {
+            if (ferror(fp)) {
+                ereport(ERROR, (errcode_for_file_access(), errmsg("could not read file \"%s\": %m", readfilename)));
+            }
+            /* truncated while we were sending it, WAL replay recreates the block */
+            rc = memset_s(t_thrd.basebackup_cxt.buf_block + cnt, BLCKSZ - cnt, 0, BLCKSZ - cnt);
+            securec_check(rc, "", "");
+        }
+        if (pq_putmessage_noblock('d', t_thrd.basebackup_cxt.buf_block, BLCKSZ)) {
+            ereport(ERROR, (errcode_for_file_access(), errmsg("base backup could not send data, aborting backup")));
+        }
+    }
+
+    /* Pad to 512 byte boundary, per tar format requirements */
+    size_t pad = ((len + 511) & ~511) - len;
+    if (pad > 0) {
+        rc = memset_s(t_thrd.basebackup_cxt.buf_block, pad, 0, pad);
+        securec_check(rc, "", "");
+        (void)pq_putmessage_noblock('d', t_thrd.basebackup_cxt.buf_block, pad);
+    }
+
+    t_thrd.basebackup_cxt.incremental_blocks_sent += nblocks;
+    t_thrd.basebackup_cxt.incremental_blocks_skipped += fileBlocks - nblocks;
+    SEND_DIR_ADD_SIZE(*size, incstat);
+
+    (void)FreeFile(fp);
+    pfree(blocks);
+    return true;
+}
+
+/*
+ * Make the shared parallel backup control describe the backup this main
+ * stream is sending, so that helper streams can attach to it.
+ */
+static void RegisterParallelBackup(int nhelpers, XLogRecPtr startptr)
+{
+    volatile ParallelBackupCtl *ctl = &t_thrd.walsender_cxt.WalSndCtl->parallelBackup;
+
+    SpinLockAcquire(&ctl->mutex);
+    if (ctl->inUse) {
+        SpinLockRelease(&ctl->mutex);
+        ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+                        errmsg("another parallel base backup is in progress")));
+    }
+    ctl->inUse = true;
+    ctl->startptr = InvalidXLogRecPtr;
+    SpinLockRelease(&ctl->mutex);
+    t_thrd.basebackup_cxt.parallel_backup_id = PARALLEL_BACKUP_MAIN_ID;
+    t_thrd.basebackup_cxt.parallel_backup_start = startptr;
+
+    for (int i = 0; i < PARALLEL_BACKUP_BUCKETS; i++) {
+        pg_atomic_write_u32(&t_thrd.walsender_cxt.WalSndCtl->parallelBackup.owner[i], 0);
+    }
+
+    SpinLockAcquire(&ctl->mutex);
+    ctl->nhelpers = nhelpers;
+    ctl->attached = 0;
+    ctl->finished = 0;
+    ctl->failed = false;
+    ctl->startptr = startptr;
+    SpinLockRelease(&ctl->mutex);
+}
+
+/*
+ * Detach the main stream from the shared parallel backup control. When the
+ * main stream is aborting, mark the backup failed so that helper streams
+ * still sending their share stop at their next file instead of finishing a
+ * backup nobody will use.
+ */
+static void ReleaseParallelBackup(bool aborted)
+{
+    volatile ParallelBackupCtl *ctl = &t_thrd.walsender_cxt.WalSndCtl->parallelBackup;
+
+    if (t_thrd.basebackup_cxt.parallel_backup_id != PARALLEL_BACKUP_MAIN_ID) {
+        return;
+    }
+    SpinLockAcquire(&ctl->mutex);
+    if (aborted) {
+        ctl->failed = true;
+    }
+    ctl->inUse = false;
+    ctl->startptr = InvalidXLogRecPtr;
+    SpinLockRelease(&ctl->mutex);
+    t_thrd.basebackup_cxt.parallel_backup_id = 0;
+    t_thrd.basebackup_cxt.parallel_backup_start = InvalidXLogRecPtr;
+}
+
+/*
+ * The main tar may only send pg_control once every helper stream has sent
+ * its share of the files, so the main stream waits here before that.
+ */
+static void WaitParallelBackupHelpers(void)
+{
+    volatile ParallelBackupCtl *ctl = &t_thrd.walsender_cxt.WalSndCtl->parallelBackup;
+    TimestampTz waitStart = GetCurrentTimestamp();
+
+    for (;;) {
+        int nhelpers;
+        int attached;
+        int finished;
+        bool failed = false;
+
+        SpinLockAcquire(&ctl->mutex);
+        nhelpers = ctl->nhelpers;
+        attached = ctl->attached;
+        finished = ctl->finished;
+        failed = ctl->failed;
+        SpinLockRelease(&ctl->mutex);
+
+        if (failed) {
+            ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+                            errmsg("a helper stream of the parallel base backup failed, aborting backup")));
+        }
+        if (finished >= nhelpers) {
+            break;
+        }
+        if (attached < nhelpers &&
+            TimestampDifferenceExceeds(waitStart, GetCurrentTimestamp(), PARALLEL_BACKUP_ATTACH_TIMEOUT)) {
+            ereport(ERROR, (errcode(ERRCODE_CONNECTION_TIMED_OUT),
+                            errmsg("only %d of %d helper streams attached to the parallel base backup", attached,
+                                   nhelpers)));
+        }
+        if (!PostmasterIsAlive()) {
+            ereport(ERROR, (errcode_for_file_access(), errmsg("Postmaster exited, aborting active base backup")));
+        }
+        if (t_thrd.walsender_cxt.walsender_shutdown_requested || t_thrd.walsender_cxt.walsender_ready_to_stop) {
+            ereport(ERROR, (errcode_for_file_access(), errmsg("shutdown requested, aborting active base backup")));
+        }
+        CHECK_FOR_INTERRUPTS();
+        pg_usleep(PARALLEL_BACKUP_POLL_INTERVAL);
+    }
+}
+
+/*
+ * Relation files are shared out between the streams of a parallel backup;
+ * all other files, directories and links go through the main stream only.
+ */
+static bool ParallelBackupClaimFile(const char *tarfilename)
+{
+    volatile ParallelBackupCtl *ctl = &t_thrd.walsender_cxt.WalSndCtl->parallelBackup;
+    int self = t_thrd.basebackup_cxt.parallel_backup_id;
+    const char *name = last_dir_separator(tarfilename);
+
+    if (self == 0) {
+        return true;
+    }
+
+    name = (name == NULL) ? tarfilename : name + 1;
+    if (!isdigit((unsigned char)*name) ||
+        !(strncmp(tarfilename, "base/", strlen("base/")) == 0 ||
+          strncmp(tarfilename, "global/", strlen("global/")) == 0 ||
+          OidIsValid(t_thrd.basebackup_cxt.send_spcnode))) {
+        return self == PARALLEL_BACKUP_MAIN_ID;
+    }
+
+    if (self != PARALLEL_BACKUP_MAIN_ID) {
+        bool aborted = false;
+        SpinLockAcquire(&ctl->mutex);
+        aborted = ctl->failed || ctl->startptr != t_thrd.basebackup_cxt.parallel_backup_start;
+        SpinLockRelease(&ctl->mutex);
+        if (aborted) {
+            ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+                            errmsg("parallel base backup was aborted")));
+        }
+    }
+
+    uint32 bucket = DatumGetUInt32(hash_any((const unsigned char *)tarfilename, strlen(tarfilename))) %
+                    PARALLEL_BACKUP_BUCKETS;
+    uint32 owner = 0;
+    if (pg_atomic_compare_exchange_u32(&t_thrd.walsender_cxt.WalSndCtl->parallelBackup.owner[bucket], &owner,
+                                       (uint32)self)) {
+        return true;
+    }
+    return owner == (uint32)self;
+}
+
+static void parallel_backup_worker_cleanup(int code, Datum arg)
+{
+    volatile ParallelBackupCtl *ctl = &t_thrd.walsender_cxt.WalSndCtl->parallelBackup;
+
+    SpinLockAcquire(&ctl->mutex);
+    if (ctl->startptr == t_thrd.basebackup_cxt.parallel_backup_start) {
+        ctl->failed = true;
+    }
+    SpinLockRelease(&ctl->mutex);
+    t_thrd.basebackup_cxt.parallel_backup_id = 0;
+    t_thrd.basebackup_cxt.parallel_backup_start = InvalidXLogRecPtr;
+}
+
+/*
+ * Send this helper stream's share of a parallel base backup started by
+ * another walsender: one tar stream per tablespace, holding just the
+ * relation files it claims.
+ */
+static void PerformParallelBackupWorker(basebackup_options *opt, DIR *tblspcdir)
+{
+    volatile ParallelBackupCtl *ctl = &t_thrd.walsender_cxt.WalSndCtl->parallelBackup;
+    List *tablespaces = NIL;
+    StringInfoData tblspcMap;
+    ListCell *lc = NULL;
+    bool attached = false;
+
+    SpinLockAcquire(&ctl->mutex);
+    if (ctl->inUse && ctl->startptr == opt->parallelWorkerLsn && !ctl->failed &&
+        ctl->attached < ctl->nhelpers) {
+        /* the main stream is PARALLEL_BACKUP_MAIN_ID, helpers follow it */
+        t_thrd.basebackup_cxt.parallel_backup_id = PARALLEL_BACKUP_MAIN_ID + 1 + ctl->attached;
+        ctl->attached++;
+        attached = true;
+    }
+    SpinLockRelease(&ctl->mutex);
+    if (!attached) {
+        ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+                        errmsg("no parallel base backup starting at %X/%X is waiting for helper streams",
+                               (uint32)(opt->parallelWorkerLsn >> 32), (uint32)opt->parallelWorkerLsn)));
+    }
+    t_thrd.basebackup_cxt.parallel_backup_start = opt->parallelWorkerLsn;
+
+    PG_ENSURE_ERROR_CLEANUP(parallel_backup_worker_cleanup, (Datum)0);
+    {
+        initStringInfo(&tblspcMap);
+        CollectTableSpace(tblspcdir, &tablespaces, &tblspcMap, false);
+        tablespaceinfo *ti = (tablespaceinfo *)palloc0(sizeof(tablespaceinfo));
+        ti->size = -1;
+        tablespaces = lappend(tablespaces, ti);
+
+        SendBackupHeader(tablespaces);
+        foreach (lc, tablespaces) {
+            tablespaceinfo *iterti = (tablespaceinfo *)lfirst(lc);
+            StringInfoData buf;
+
+            /* Send CopyOutResponse message */
+            pq_beginmessage(&buf, 'H');
+            pq_sendbyte(&buf, 0);  /* overall format */
+            pq_sendint16(&buf, 0); /* natts */
+            pq_endmessage_noblock(&buf);
+
+            t_thrd.basebackup_cxt.send_spcnode = (iterti->path != NULL) ? atooid(iterti->oid) : InvalidOid;
+            if (iterti->path != NULL) {
+                sendTablespace(iterti->path, false);
+            } else {
+                sendDir(".", 1, false, tablespaces, true);
+            }
+            pq_putemptymessage_noblock('c'); /* CopyDone */
+        }
+    }
+    PG_END_ENSURE_ERROR_CLEANUP(parallel_backup_worker_cleanup, (Datum)0);
+
+    SpinLockAcquire(&ctl->mutex);
+    if (ctl->startptr == opt->parallelWorkerLsn) {
+        ctl->finished++;
+    }
+    SpinLockRelease(&ctl->mutex);
+    t_thrd.basebackup_cxt.parallel_backup_id = 0;
+    t_thrd.basebackup_cxt.parallel_backup_start = InvalidXLogRecPtr;
+}
+
 static bool sendFile(char *readfilename, char *tarfilename, struct stat *statbuf, bool missing_ok)
 {
     FILE *fp = NULL;
@@ -2308,6 +3002,12 @@ static void _tarWriteHeader(const char *filename, const char *linktarget, struct
     char h[BUILD_PATH_LEN];
     errno_t rc = EOK;
     int nRet = 0;
+
+    /* directories and links are left to the main stream, helpers only send files */
+    if (t_thrd.basebackup_cxt.parallel_backup_id > PARALLEL_BACKUP_MAIN_ID &&
+        (linktarget != NULL || S_ISDIR(statbuf->st_mode))) {
+        return;
+    }
     /*
      * Note: most of the fields in a tar header are not supposed to be
      * null-terminated.  We use sprintf, which will write a null after the
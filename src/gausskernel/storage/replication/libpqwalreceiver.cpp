@@ -270,8 +270,17 @@ void StartRemoteStreaming(const LibpqrcvConnectParam *options)
             appendStringInfoString(&cmd, ", usesnapshot 'true'");
         }
 
+        if (options->streaming) {
+            appendStringInfoString(&cmd, ", streaming 'on'");
+        }
+
         appendStringInfoChar(&cmd, ')');
+    } else if (options->compression != WAL_COMPRESSION_NONE) {
+        appendStringInfo(&cmd, " (compression '%s')",
+            (options->compression == WAL_COMPRESSION_LZ4) ? "lz4" : "zstd");
     }
+    t_thrd.libwalreceiver_cxt.walCompression = options->logical ? WAL_COMPRESSION_NONE : options->compression;
+    t_thrd.libwalreceiver_cxt.walDecompressReady = false;
 
     PGresult *res = libpqrcv_PQexec(cmd.data);
     pfree(cmd.data);
@@ -1100,6 +1109,7 @@ retry:
     options.slotname = slotname;
     options.startpoint = *startpoint;
     options.logical = false;
+    options.compression = u_sess->attr.attr_storage.wal_receiver_compression;
     StartRemoteStreaming(&options);
 
     ereport(LOG,
@@ -60,6 +60,7 @@ static const int DEFAULT_NAPTIME_PER_CYCLE = 180000L;
 
 static const int wal_retrieve_retry_interval = 5000;
 static const int PG_STAT_GET_SUBSCRIPTION_COLS = 8;
+static const int PG_STAT_GET_PARALLEL_APPLY_COLS = 9;
 static const int WAIT_SUB_WORKER_ATTACH_CYCLE = 50000L; /* 50ms */
 static const int WAIT_SUB_WORKER_ATTACH_TIMEOUT = 1000000L; /* 1s */
 
@@ -69,6 +70,7 @@ static void logicalrep_worker_onexit(int code, Datum arg);
 static void logicalrep_worker_detach(void);
 
 Datum pg_stat_get_subscription(PG_FUNCTION_ARGS);
+Datum pg_stat_get_parallel_apply(PG_FUNCTION_ARGS);
 
 
 /*
@@ -169,6 +171,10 @@ LogicalRepWorker *logicalrep_worker_find(Oid subid, Oid relid, bool only_running
     /* Search for attached worker for a given subscription id. */
     for (i = 0; i < g_instance.attr.attr_storage.max_logical_replication_workers; i++) {
         LogicalRepWorker *w = &t_thrd.applylauncher_cxt.applyLauncherShm->workers[i];
+        /* parallel apply and sync workers come and go with their leader, never look them up */
+        if (w->applyGroup != NULL || w->syncGroup != NULL) {
+            continue;
+        }
         if (w->subid == subid && w->relid == relid && (!only_running || w->proc)) {
             res = w;
             break;
@@ -224,6 +230,9 @@ static void WaitForReplicationWorkerAttach()
             worker->subid = InvalidOid;
             worker->proc = NULL;
             worker->workerLaunchTime = 0;
+            worker->applyGroup = NULL;
+            worker->applyGroupIdx = -1;
+            worker->syncGroup = NULL;
             t_thrd.applylauncher_cxt.applyLauncherShm->startingWorker = NULL;
         }
         LWLockRelease(LogicalRepWorkerLock);
@@ -233,11 +242,22 @@ static void WaitForReplicationWorkerAttach()
 
 /*
  * Start new apply background worker.
+ *
+ * applyGroup is the parallel apply group of the calling leader apply worker
+ * when starting one of its parallel apply workers, NULL otherwise. Likewise,
+ * syncGroup is that of the calling table sync worker when starting a worker
+ * to help it copy the table.
+ *
+ * Returns true if the worker started and attached to its slot.
  */
-void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid)
+bool logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid,
+    ParallelApplyGroup *applyGroup, int applyGroupIdx, ParallelSyncGroup *syncGroup)
 {
     int slot;
     LogicalRepWorker *worker = NULL;
+    uint16 generation;
+    bool started = false;
+    errno_t rc;
 
     ereport(DEBUG1, (errmsg("starting logical replication worker for subscription \"%s\"", subname)));
 
@@ -266,7 +286,7 @@ void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid user
         ereport(WARNING,
             (errcode(ERRCODE_CONFIGURATION_LIMIT_EXCEEDED), errmsg("out of logical replication worker slots"),
             errhint("You might need to increase max_logical_replication_workers.")));
-        return;
+        return false;
     }
 
     /* Prepare the worker info. */
@@ -285,12 +305,23 @@ void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid user
     worker->reply_lsn = InvalidXLogRecPtr;
     TIMESTAMP_NOBEGIN(worker->reply_time);
     worker->workerLaunchTime = GetCurrentTimestamp();
+    worker->applyGroup = applyGroup;
+    worker->applyGroupIdx = applyGroupIdx;
+    rc = memset_s(&worker->applyStats, sizeof(ParallelApplyStats), 0, sizeof(ParallelApplyStats));
+    securec_check(rc, "", "");
+    worker->syncGroup = syncGroup;
+    generation = worker->generation;
 
     t_thrd.applylauncher_cxt.applyLauncherShm->startingWorker = worker;
     LWLockRelease(LogicalRepWorkerLock);
 
     SendPostmasterSignal(PMSIGNAL_START_APPLY_WORKER);
     WaitForReplicationWorkerAttach();
+
+    (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+    started = (worker->generation == generation && worker->proc != NULL);
+    LWLockRelease(LogicalRepWorkerLock);
+    return started;
 }
 
 /*
@@ -458,6 +489,9 @@ static void logicalrep_worker_detach(void)
     t_thrd.applyworker_cxt.curWorker->subid = InvalidOid;
     t_thrd.applyworker_cxt.curWorker->proc = NULL;
     t_thrd.applyworker_cxt.curWorker->workerLaunchTime = 0;
+    t_thrd.applyworker_cxt.curWorker->applyGroup = NULL;
+    t_thrd.applyworker_cxt.curWorker->applyGroupIdx = -1;
+    t_thrd.applyworker_cxt.curWorker->syncGroup = NULL;
 
     LWLockRelease(LogicalRepWorkerLock);
 }
@@ -593,6 +627,7 @@ void ApplyLauncherShmemInit(void)
             rc = memset_s(worker, sizeof(LogicalRepWorker), 0, sizeof(LogicalRepWorker));
             securec_check(rc, "", "");
             SpinLockInit(&worker->relmutex);
+            worker->applyGroupIdx = -1;
         }
     }
 }
@@ -789,8 +824,8 @@ void ApplyLauncherMain()
              */
             foreach(lc, pendingSubList) {
                 Subscription *readyToLaunchSub = (Subscription*)lfirst(lc);
-                logicalrep_worker_launch(readyToLaunchSub->dbid, readyToLaunchSub->oid,
-                    readyToLaunchSub->name, readyToLaunchSub->owner, InvalidOid);
+                (void)logicalrep_worker_launch(readyToLaunchSub->dbid, readyToLaunchSub->oid,
+                    readyToLaunchSub->name, readyToLaunchSub->owner, InvalidOid, NULL, -1, NULL);
                 last_start_time = now;
                 wait_time = wal_retrieve_retry_interval;
             }
@@ -953,3 +988,82 @@ Datum pg_stat_get_subscription(PG_FUNCTION_ARGS)
 
     return (Datum)0;
 }
+
+/*
+ * Returns the counters of the parallel apply workers of the subscriptions.
+ */
+Datum pg_stat_get_parallel_apply(PG_FUNCTION_ARGS)
+{
+    Oid subid = PG_ARGISNULL(0) ? InvalidOid : PG_GETARG_OID(0);
+    ReturnSetInfo *rsinfo = (ReturnSetInfo *)fcinfo->resultinfo;
+    TupleDesc tupdesc;
+    Tuplestorestate *tupstore;
+    MemoryContext per_query_ctx;
+    MemoryContext oldcontext;
+
+    /* check to see if caller supports us returning a tuplestore */
+    if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+            errmsg("set-valued function called in context that cannot accept a set")));
+    if (!(rsinfo->allowedModes & SFRM_Materialize))
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("materialize mode required, but it is not "
+            "allowed in this context")));
+
+    /* Build a tuple descriptor for our result type */
+    if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+        elog(ERROR, "return type must be a row type");
+
+    per_query_ctx = rsinfo->econtext->ecxt_per_query_memory;
+    oldcontext = MemoryContextSwitchTo(per_query_ctx);
+
+    tupstore = tuplestore_begin_heap(true, false, u_sess->attr.attr_memory.work_mem);
+    rsinfo->returnMode = SFRM_Materialize;
+    rsinfo->setResult = tupstore;
+    rsinfo->setDesc = tupdesc;
+
+    MemoryContextSwitchTo(oldcontext);
+
+    (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+
+    for (int i = 0; i < g_instance.attr.attr_storage.max_logical_replication_workers; i++) {
+        Datum values[PG_STAT_GET_PARALLEL_APPLY_COLS];
+        bool nulls[PG_STAT_GET_PARALLEL_APPLY_COLS];
+        LogicalRepWorker worker;
+        int rc;
+        int idx = 0;
+
+        rc = memcpy_s(&worker, sizeof(LogicalRepWorker),
+            &t_thrd.applylauncher_cxt.applyLauncherShm->workers[i], sizeof(LogicalRepWorker));
+        securec_check(rc, "", "");
+        if (!worker.proc || worker.proc->pid == 0 || worker.applyGroup == NULL)
+            continue;
+
+        if (OidIsValid(subid) && worker.subid != subid)
+            continue;
+
+        rc = memset_s(nulls, sizeof(nulls), 0, sizeof(nulls));
+        securec_check(rc, "", "");
+
+        values[idx++] = ObjectIdGetDatum(worker.subid);
+        values[idx++] = Int32GetDatum(worker.proc->pid);
+        values[idx++] = Int32GetDatum(worker.applyGroupIdx);
+        values[idx++] = Int64GetDatum((int64)worker.applyStats.txns);
+        values[idx++] = Int64GetDatum((int64)worker.applyStats.depWaits);
+        values[idx++] = Int64GetDatum((int64)worker.applyStats.depWaitTime);
+        values[idx++] = Int64GetDatum((int64)worker.applyStats.orderWaitTime);
+        values[idx++] = Int64GetDatum((int64)worker.applyStats.retries);
+        if (worker.applyStats.txns == 0)
+            nulls[idx++] = true;
+        else
+            values[idx++] = Int64GetDatum(worker.applyStats.lag);
+
+        tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+    }
+
+    LWLockRelease(LogicalRepWorkerLock);
+
+    /* clean up and return the tuplestore */
+    tuplestore_donestoring(tupstore);
+
+    return (Datum)0;
+}
@@ -79,6 +79,12 @@ static void prepare_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
 
 static void change_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, Relation relation,
                               ReorderBufferChange *change);
+static void stream_start_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
+static void stream_stop_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
+static void stream_abort_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
+static void stream_commit_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
+static void stream_change_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, Relation relation,
+                                     ReorderBufferChange *change);
 static void parallel_change_cb_wrapper(ParallelReorderBuffer *cache, ReorderBufferTXN *txn, Relation relation,
     ParallelReorderBufferChange *change);
 
@@ -143,6 +149,14 @@ static LogicalDecodingContext *StartupDecodingContext(List *output_plugin_option
     if (!fast_forward)
         LoadOutputPlugin(&ctx->callbacks, NameStr(slot->data.plugin));
 
+    /*
+     * Streaming needs all stream callbacks; the plugin may still turn it off
+     * in its startup callback if the client did not ask for it.
+     */
+    ctx->streaming = !fast_forward && ctx->callbacks.stream_start_cb != NULL &&
+        ctx->callbacks.stream_stop_cb != NULL && ctx->callbacks.stream_abort_cb != NULL &&
+        ctx->callbacks.stream_commit_cb != NULL && ctx->callbacks.stream_change_cb != NULL;
+
     /*
      * Now that the slot's xmin has been set, we can announce ourselves as a
      * logical decoding backend which doesn't need to be checked individually
@@ -171,6 +185,11 @@ static LogicalDecodingContext *StartupDecodingContext(List *output_plugin_option
     ctx->reorder->begin = begin_cb_wrapper;
     ctx->reorder->apply_change = change_cb_wrapper;
     ctx->reorder->commit = commit_cb_wrapper;
+    ctx->reorder->stream_start = stream_start_cb_wrapper;
+    ctx->reorder->stream_stop = stream_stop_cb_wrapper;
+    ctx->reorder->stream_abort = stream_abort_cb_wrapper;
+    ctx->reorder->stream_commit = stream_commit_cb_wrapper;
+    ctx->reorder->stream_change = stream_change_cb_wrapper;
 
     ctx->out = makeStringInfo();
     ctx->prepare_write = prepare_write;
@@ -512,6 +531,17 @@ LogicalDecodingContext *CreateDecodingContext(XLogRecPtr start_lsn, List *output
         startup_cb_wrapper(ctx, &ctx->options, false);
     (void)MemoryContextSwitchTo(old_context);
 
+    /*
+     * Backends only log subxact assignments right away while some slot is
+     * marked streaming, so transactions that got their xid before that may
+     * have subxacts we cannot attribute to them yet. Never stream those.
+     * Reading nextXid takes XidGenLock, which orders it after the mark.
+     */
+    if (ctx->streaming) {
+        ReplicationSlotMarkStreaming();
+        ctx->reorder->stream_min_xid = ReadNewTransactionId();
+    }
+
     ereport(LOG, (errmodule(MOD_LOGICAL_DECODE),
         errmsg("starting logical decoding for slot %s", NameStr(slot->data.name)),
         errdetail("streaming transactions committing after %X/%X, reading WAL from %X/%X",
@@ -994,6 +1024,155 @@ static void change_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, Relat
     t_thrd.log_cxt.error_context_stack = errcallback.previous;
 }
 
+static void stream_start_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+    Assert(ctx->streaming);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_start";
+    state.report_location = txn->first_lsn;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = txn->first_lsn;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_start_cb(ctx, txn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_stop_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+    Assert(ctx->streaming);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_stop";
+    state.report_location = InvalidXLogRecPtr;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state, keeping the location of the last streamed change */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_stop_cb(ctx, txn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_abort_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+    Assert(ctx->streaming);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_abort";
+    state.report_location = txn->final_lsn; /* beginning of abort record */
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = txn->final_lsn;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_abort_cb(ctx, txn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_commit_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogRecPtr commit_lsn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+    Assert(ctx->streaming);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_commit";
+    state.report_location = txn->final_lsn; /* beginning of commit record */
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = txn->end_lsn; /* points to the end of the record */
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_commit_cb(ctx, txn, commit_lsn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_change_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, Relation relation,
+                                     ReorderBufferChange *change)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+    Assert(ctx->streaming);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_change";
+    state.report_location = change->lsn;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = change->lsn;
+
+    ctx->callbacks.stream_change_cb(ctx, txn, relation, change);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
 bool filter_by_origin_cb_wrapper(LogicalDecodingContext *ctx, RepOriginId origin_id)
 {
     LogicalErrorCallbackState state;
@@ -982,8 +982,12 @@ static void ReplicationOriginExitCleanup(int code, Datum arg)
  * Obviously only one such cached origin can exist per process and the current
  * cached value can only be set again after the previous value is torn down
  * with replorigin_session_reset().
+ *
+ * If acquiredBy is not 0, the origin must already be acquired by that thread
+ * and is shared with it; parallel apply workers use this to advance the
+ * origin of their leader apply worker.
  */
-void replorigin_session_setup(RepOriginId node)
+void replorigin_session_setup(RepOriginId node, ThreadId acquiredBy)
 {
     int i;
     int free_slot = -1;
@@ -1019,16 +1023,23 @@ void replorigin_session_setup(RepOriginId node)
         if (curstate->roident != node)
             continue;
 
-        else if (curstate->acquired_by != 0) {
-            ereport(ERROR, (errcode(ERRCODE_OBJECT_IN_USE), errmsg(
-                "replication identifier %d is already active for PID %lu", curstate->roident, curstate->acquired_by)));
+        else if (curstate->acquired_by != acquiredBy) {
+            if (acquiredBy == 0) {
+                ereport(ERROR, (errcode(ERRCODE_OBJECT_IN_USE), errmsg("replication identifier %d is already "
+                    "active for PID %lu", curstate->roident, curstate->acquired_by)));
+            }
+            ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE), errmsg("could not find replication "
+                "identifier %d acquired by PID %lu", curstate->roident, acquiredBy)));
         }
 
         /* ok, found slot */
         u_sess->reporigin_cxt.curRepState = curstate;
     }
 
-    if (u_sess->reporigin_cxt.curRepState == NULL && free_slot == -1)
+    if (u_sess->reporigin_cxt.curRepState == NULL && acquiredBy != 0)
+        ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+            errmsg("could not find replication identifier %d acquired by PID %lu", node, acquiredBy)));
+    else if (u_sess->reporigin_cxt.curRepState == NULL && free_slot == -1)
         ereport(ERROR, (errcode(ERRCODE_CONFIGURATION_LIMIT_EXCEEDED),
             errmsg("could not find free replication state slot for replication origin with OID %u", node),
             errhint("Increase max_replication_slots and try again.")));
@@ -1042,7 +1053,8 @@ void replorigin_session_setup(RepOriginId node)
 
     Assert(u_sess->reporigin_cxt.curRepState->roident != InvalidRepOriginId);
 
-    u_sess->reporigin_cxt.curRepState->acquired_by = t_thrd.proc_cxt.MyProcPid;
+    if (acquiredBy == 0)
+        u_sess->reporigin_cxt.curRepState->acquired_by = t_thrd.proc_cxt.MyProcPid;
 
     LWLockRelease(ReplicationOriginLock);
 
@@ -1070,7 +1082,9 @@ static void replorigin_session_reset(void)
 
     LWLockAcquire(ReplicationOriginLock, LW_EXCLUSIVE);
 
-    u_sess->reporigin_cxt.curRepState->acquired_by = 0;
+    /* a shared origin stays acquired by the thread that set it up first */
+    if (u_sess->reporigin_cxt.curRepState->acquired_by == t_thrd.proc_cxt.MyProcPid)
+        u_sess->reporigin_cxt.curRepState->acquired_by = 0;
     cv = &u_sess->reporigin_cxt.curRepState->orginCV;
     mutex = &u_sess->reporigin_cxt.curRepState->originMutex;
     u_sess->reporigin_cxt.curRepState = NULL;
@@ -1206,7 +1220,7 @@ Datum pg_replication_origin_session_setup(PG_FUNCTION_ARGS)
 
     name = text_to_cstring((text *)DatumGetPointer(PG_GETARG_DATUM(0)));
     origin = replorigin_by_name(name, false);
-    replorigin_session_setup(origin);
+    replorigin_session_setup(origin, 0);
 
     u_sess->reporigin_cxt.originId = origin;
 
@@ -0,0 +1,928 @@
+/* ---------------------------------------------------------------------------------------
+ *
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * parallel_apply.cpp
+ *      Parallel apply of the transactions received by a subscription.
+ *
+ *      The leader apply worker buffers the changes of every remote transaction
+ *      and, at COMMIT, hands the transaction to one of its parallel apply
+ *      workers.  Each change is tagged with a hash of the replica identity key
+ *      of the row it touches; a transaction does not start before the last
+ *      earlier transaction touching one of its keys has committed.  Changes
+ *      whose key can't be determined make the transaction a barrier that runs
+ *      alone.
+ *
+ *      Parallel apply workers share the leader's replication origin and commit
+ *      strictly in remote commit order, so the origin progress and the flush
+ *      positions reported to the publisher stay exactly what serial apply
+ *      would produce.  A transaction that ran ahead of an earlier one and
+ *      failed, or that holds locks an earlier transaction waits on, is rolled
+ *      back and applied again once it is its turn to commit.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/replication/logical/parallel_apply.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "miscadmin.h"
+#include "pgstat.h"
+
+#include "access/hash.h"
+#include "access/xact.h"
+
+#include "libpq/pqformat.h"
+
+#include "replication/logicalproto.h"
+#include "replication/logicalrelation.h"
+#include "replication/origin.h"
+#include "replication/worker_internal.h"
+
+#include "storage/barrier.h"
+#include "storage/ipc.h"
+#include "storage/proc.h"
+
+#include "utils/atomic.h"
+#include "utils/hashutils.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+#include "utils/timestamp.h"
+
+/* Larger transactions are applied by the leader itself. */
+static const int PARALLEL_APPLY_MAX_TXN_BYTES = 16 * 1024 * 1024;
+/* Bound on the change data handed over but not yet applied. */
+static const uint64 PARALLEL_APPLY_MAX_PENDING_BYTES = 64 * 1024 * 1024;
+/* Bound on the transactions handed over but not yet committed, per worker. */
+static const uint64 PARALLEL_APPLY_TXNS_PER_WORKER = 16;
+/* Transactions touching more rows don't track them and run alone. */
+static const int PARALLEL_APPLY_MAX_TXN_KEYS = 10000;
+/* Forget the keys of committed transactions beyond this many. */
+static const long PARALLEL_APPLY_MAX_KEYS = 65536;
+static const long PARALLEL_APPLY_NAPTIME = 10L;       /* 10ms */
+static const long PARALLEL_APPLY_IDLE_NAPTIME = 1000L; /* 1s */
+static const int PARALLEL_APPLY_STOP_TIMEOUT = 10000; /* 10s */
+
+typedef struct ParallelApplyTxn {
+    struct ParallelApplyTxn *next;         /* next in the queue of the worker */
+    struct ParallelApplyTxn *inflightNext; /* next in the leader's in-flight list */
+    bool isRelation;                       /* RELATION message for every worker */
+    uint64 seq;                            /* position in remote commit order, from 1 */
+    uint64 waitSeq;                        /* don't start before this one committed */
+    int workerIdx;
+    int size;
+    XLogRecPtr finalLsn;
+    XLogRecPtr endLsn;
+    CommitSeqNo csn;
+    TimestampTz commitTime;
+    XLogRecPtr localEnd; /* set by the worker at commit */
+    /* protocol messages as repeated (int length, message) */
+    StringInfoData msgs;
+} ParallelApplyTxn;
+
+typedef struct ParallelApplyMember {
+    ParallelApplyGroup *group;
+    int idx;
+
+    /* protected by the group mutex */
+    PGPROC *proc;
+    ParallelApplyTxn *head;
+    ParallelApplyTxn *tail;
+    uint64 curSeq; /* transaction being applied, 0 if none */
+
+    /* maintained by the leader only */
+    int pending;
+} ParallelApplyMember;
+
+struct ParallelApplyGroup {
+    MemoryContext context;
+    slock_t mutex;
+    PGPROC *leaderProc;
+    ThreadId leaderPid;
+    pg_atomic_uint64 committedSeq;
+    pg_atomic_uint64 pendingBytes;
+    volatile bool shutdown;
+    volatile bool failed;
+    int maxWorkers;
+
+    /* maintained by the leader only */
+    int nworkers;
+    HTAB *keyHash;
+    ParallelApplyTxn *curTxn;
+    uint32 *curKeys;
+    int nkeys;
+    int maxkeys;
+    bool curBarrier;
+    uint64 lastSeq;
+    uint64 lastBarrierSeq;
+    ParallelApplyTxn *inflightHead;
+    ParallelApplyTxn *inflightTail;
+
+    ParallelApplyMember members[FLEXIBLE_ARRAY_MEMBER];
+};
+
+typedef struct ParallelApplyKeyEntry {
+    uint32 key;
+    uint64 seq; /* last transaction touching the key */
+} ParallelApplyKeyEntry;
+
+static void parallel_apply_leader_wait(ParallelApplyGroup *group)
+{
+    int rc = WaitLatch(&t_thrd.proc->procLatch, WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
+                       PARALLEL_APPLY_NAPTIME);
+    /* emergency bailout if postmaster has died */
+    if (rc & WL_POSTMASTER_DEATH)
+        proc_exit(1);
+
+    ResetLatch(&t_thrd.proc->procLatch);
+    CHECK_FOR_INTERRUPTS();
+
+    if (group->failed)
+        ereport(ERROR, (errmsg("logical replication parallel apply worker for subscription \"%s\" exited "
+            "unexpectedly", t_thrd.applyworker_cxt.mySubscription->name)));
+}
+
+static void parallel_apply_worker_wait(ParallelApplyGroup *group, long timeout)
+{
+    int rc = WaitLatch(&t_thrd.proc->procLatch, WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH, timeout);
+    /* emergency bailout if postmaster has died */
+    if (rc & WL_POSTMASTER_DEATH)
+        proc_exit(1);
+
+    ResetLatch(&t_thrd.proc->procLatch);
+    CHECK_FOR_INTERRUPTS();
+
+    /* The leader restarts the whole group once anybody fails. */
+    if (group->shutdown || group->failed)
+        proc_exit(0);
+}
+
+static void parallel_apply_enqueue(ParallelApplyMember *member, ParallelApplyTxn *txn)
+{
+    ParallelApplyGroup *group = member->group;
+    PGPROC *proc = NULL;
+
+    txn->next = NULL;
+    SpinLockAcquire(&group->mutex);
+    if (member->tail != NULL)
+        member->tail->next = txn;
+    else
+        member->head = txn;
+    member->tail = txn;
+    proc = member->proc;
+    SpinLockRelease(&group->mutex);
+
+    if (proc != NULL)
+        SetLatch(&proc->procLatch);
+}
+
+/*
+ * Leader side.
+ */
+
+static void ParallelApplyLeaderOnExit(int code, Datum arg)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.parallelApplyGroup;
+    ApplyLauncherShmStruct *shm = t_thrd.applylauncher_cxt.applyLauncherShm;
+    int waited = 0;
+
+    if (group == NULL)
+        return;
+
+    SpinLockAcquire(&group->mutex);
+    group->shutdown = true;
+    SpinLockRelease(&group->mutex);
+
+    /*
+     * The group memory can't go away while a parallel apply worker might still
+     * look at it, including one that is still starting up.
+     */
+    for (;;) {
+        int alive = 0;
+
+        (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+        for (int i = 0; i < g_instance.attr.attr_storage.max_logical_replication_workers; i++) {
+            LogicalRepWorker *worker = &shm->workers[i];
+
+            if (worker->applyGroup != group)
+                continue;
+            alive++;
+            if (worker->proc != NULL && waited % MSECS_PER_SEC == 0)
+                (void)gs_signal_send(worker->proc->pid, SIGTERM);
+        }
+        LWLockRelease(LogicalRepWorkerLock);
+
+        if (alive == 0)
+            break;
+
+        if (waited >= PARALLEL_APPLY_STOP_TIMEOUT) {
+            ereport(WARNING, (errmsg("%d logical replication parallel apply workers did not exit in time", alive)));
+            t_thrd.applyworker_cxt.parallelApplyGroup = NULL;
+            return;
+        }
+
+        pg_usleep(PARALLEL_APPLY_NAPTIME * USECS_PER_MSEC);
+        waited += PARALLEL_APPLY_NAPTIME;
+    }
+
+    MemoryContextDelete(group->context);
+    t_thrd.applyworker_cxt.parallelApplyGroup = NULL;
+}
+
+/*
+ * Start the parallel apply workers of this leader apply worker, if configured.
+ *
+ * Transactions are applied by the leader itself when none could be started.
+ */
+void ParallelApplyStart(void)
+{
+    int maxWorkers = u_sess->attr.attr_storage.max_parallel_apply_workers_per_subscription;
+    LogicalRepWorker *leader = t_thrd.applyworker_cxt.curWorker;
+    Subscription *sub = t_thrd.applyworker_cxt.mySubscription;
+    ParallelApplyGroup *group = NULL;
+    MemoryContext context;
+    HASHCTL ctl;
+    int i;
+
+    if (maxWorkers <= 0 || AM_TABLESYNC_WORKER || t_thrd.applyworker_cxt.parallelApplyGroup != NULL)
+        return;
+
+    context = AllocSetContextCreate(g_instance.instance_context, "ParallelApplyGroup", ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE, SHARED_CONTEXT);
+    group = (ParallelApplyGroup *)MemoryContextAllocZero(context,
+        offsetof(ParallelApplyGroup, members) + maxWorkers * sizeof(ParallelApplyMember));
+    group->context = context;
+    SpinLockInit(&group->mutex);
+    group->leaderProc = t_thrd.proc;
+    group->leaderPid = t_thrd.proc_cxt.MyProcPid;
+    pg_atomic_init_u64(&group->committedSeq, 0);
+    pg_atomic_init_u64(&group->pendingBytes, 0);
+    group->maxWorkers = maxWorkers;
+    for (i = 0; i < maxWorkers; i++) {
+        group->members[i].group = group;
+        group->members[i].idx = i;
+    }
+
+    errno_t rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+    securec_check(rc, "", "");
+    ctl.keysize = sizeof(uint32);
+    ctl.entrysize = sizeof(ParallelApplyKeyEntry);
+    ctl.hcxt = t_thrd.applyworker_cxt.applyContext;
+    group->keyHash = hash_create("logical replication parallel apply keys", 1024, &ctl,
+                                 HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
+    t_thrd.applyworker_cxt.parallelApplyGroup = group;
+    on_shmem_exit(ParallelApplyLeaderOnExit, (Datum)0);
+
+    for (i = 0; i < maxWorkers; i++) {
+        if (!logicalrep_worker_launch(leader->dbid, sub->oid, sub->name, leader->userid, InvalidOid, group, i, NULL))
+            break;
+    }
+    group->nworkers = i;
+
+    if (group->nworkers == 0) {
+        hash_destroy(group->keyHash);
+        ParallelApplyLeaderOnExit(0, (Datum)0);
+        ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" could not start parallel "
+            "apply workers, applying serially", sub->name)));
+        return;
+    }
+
+    ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" started %d parallel apply workers",
+        sub->name, group->nworkers)));
+}
+
+bool ParallelApplyInTxn(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.parallelApplyGroup;
+
+    return group != NULL && group->curTxn != NULL;
+}
+
+/*
+ * Start buffering a remote transaction.
+ */
+void ParallelApplyBeginTxn(XLogRecPtr finalLsn, CommitSeqNo csn)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.parallelApplyGroup;
+    ParallelApplyTxn *txn = NULL;
+    MemoryContext oldctx;
+
+    Assert(group->curTxn == NULL);
+
+    oldctx = MemoryContextSwitchTo(group->context);
+    txn = (ParallelApplyTxn *)palloc0(sizeof(ParallelApplyTxn));
+    initStringInfo(&txn->msgs);
+    MemoryContextSwitchTo(oldctx);
+
+    txn->finalLsn = finalLsn;
+    txn->csn = csn;
+    group->curTxn = txn;
+    group->nkeys = 0;
+    group->curBarrier = false;
+}
+
+/*
+ * Hash the replica identity key of a row, false if it can't be determined.
+ */
+static bool parallel_apply_row_key(LogicalRepRelation *remoterel, LogicalRepTupleData *tup, uint32 *key)
+{
+    uint32 hashkey = DatumGetUInt32(hash_uint32(remoterel->remoteid));
+    int attnum = -1;
+
+    while ((attnum = bms_next_member(remoterel->attkeys, attnum)) >= 0) {
+        if (attnum >= tup->ncols || tup->colstatus[attnum] == LOGICALREP_COLUMN_UNCHANGED)
+            return false;
+
+        if (tup->colstatus[attnum] == LOGICALREP_COLUMN_NULL) {
+            hashkey = hash_combine(hashkey, 0);
+        } else {
+            StringInfo value = &tup->colvalues[attnum];
+            hashkey = hash_combine(hashkey, DatumGetUInt32(hash_any((unsigned char *)value->data, value->len)));
+        }
+    }
+
+    *key = hashkey;
+    return true;
+}
+
+static void parallel_apply_add_key(ParallelApplyGroup *group, LogicalRepRelation *remoterel,
+    LogicalRepTupleData *tup)
+{
+    uint32 key;
+
+    if (group->curBarrier)
+        return;
+
+    if (remoterel == NULL || group->nkeys >= PARALLEL_APPLY_MAX_TXN_KEYS ||
+        !parallel_apply_row_key(remoterel, tup, &key)) {
+        group->curBarrier = true;
+        return;
+    }
+
+    if (group->nkeys == group->maxkeys) {
+        group->maxkeys = (group->maxkeys == 0) ? 64 : group->maxkeys * 2;
+        if (group->curKeys == NULL)
+            group->curKeys = (uint32 *)MemoryContextAlloc(t_thrd.applyworker_cxt.applyContext,
+                                                          group->maxkeys * sizeof(uint32));
+        else
+            group->curKeys = (uint32 *)repalloc(group->curKeys, group->maxkeys * sizeof(uint32));
+    }
+    group->curKeys[group->nkeys++] = key;
+}
+
+/*
+ * Buffer an INSERT, UPDATE or DELETE message of the current transaction.
+ *
+ * Returns false if the transaction grew too large to be buffered, the caller
+ * then applies it serially.
+ */
+bool ParallelApplyAddChange(StringInfo s)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.parallelApplyGroup;
+    ParallelApplyTxn *txn = group->curTxn;
+    StringInfoData msg = *s;
+    LogicalRepTupleData oldtup;
+    LogicalRepTupleData newtup;
+    LogicalRepRelId relid;
+    bool hasOld = false;
+    int len = s->len;
+
+    if ((Size)txn->msgs.len + sizeof(int) + (Size)len > (Size)PARALLEL_APPLY_MAX_TXN_BYTES)
+        return false;
+
+    /* The action byte was consumed already, read the rest on a copy. */
+    if (!group->curBarrier) {
+        switch (s->data[0]) {
+            case 'I':
+                relid = logicalrep_read_insert(&msg, &newtup);
+                parallel_apply_add_key(group, logicalrep_get_remoterel(relid), &newtup);
+                break;
+            case 'U':
+                relid = logicalrep_read_update(&msg, &hasOld, &oldtup, &newtup);
+                if (hasOld)
+                    parallel_apply_add_key(group, logicalrep_get_remoterel(relid), &oldtup);
+                parallel_apply_add_key(group, logicalrep_get_remoterel(relid), &newtup);
+                break;
+            case 'D':
+                relid = logicalrep_read_delete(&msg, &oldtup);
+                parallel_apply_add_key(group, logicalrep_get_remoterel(relid), &oldtup);
+                break;
+            default:
+                group->curBarrier = true;
+                break;
+        }
+    }
+
+    appendBinaryStringInfo(&txn->msgs, (const char *)&len, sizeof(int));
+    appendBinaryStringInfo(&txn->msgs, s->data, len);
+    return true;
+}
+
+/*
+ * Send a RELATION message to every parallel apply worker, each keeps its own
+ * relation map.
+ */
+void ParallelApplyAddRelation(StringInfo s)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.parallelApplyGroup;
+
+    for (int i = 0; i < group->nworkers; i++) {
+        ParallelApplyTxn *item = (ParallelApplyTxn *)MemoryContextAllocZero(group->context,
+                                                                            sizeof(ParallelApplyTxn));
+        MemoryContext oldctx = MemoryContextSwitchTo(group->context);
+
+        item->isRelation = true;
+        item->workerIdx = i;
+        initStringInfo(&item->msgs);
+        appendBinaryStringInfo(&item->msgs, s->data, s->len);
+        MemoryContextSwitchTo(oldctx);
+
+        parallel_apply_enqueue(&group->members[i], item);
+    }
+}
+
+static uint64 parallel_apply_wait_seq(ParallelApplyGroup *group, uint64 seq)
+{
+    uint64 committed = pg_atomic_read_u64(&group->committedSeq);
+    uint64 waitSeq = 0;
+
+    if (group->curBarrier) {
+        group->lastBarrierSeq = seq;
+        return seq - 1;
+    }
+
+    for (int i = 0; i < group->nkeys; i++) {
+        bool found = false;
+        ParallelApplyKeyEntry *entry = (ParallelApplyKeyEntry *)hash_search(group->keyHash, &group->curKeys[i],
+                                                                            HASH_ENTER, &found);
+        if (found && entry->seq > waitSeq && entry->seq != seq)
+            waitSeq = entry->seq;
+        entry->seq = seq;
+    }
+
+    if (group->lastBarrierSeq > waitSeq)
+        waitSeq = group->lastBarrierSeq;
+
+    if (hash_get_num_entries(group->keyHash) > PARALLEL_APPLY_MAX_KEYS) {
+        HASH_SEQ_STATUS status;
+        ParallelApplyKeyEntry *entry = NULL;
+
+        hash_seq_init(&status, group->keyHash);
+        while ((entry = (ParallelApplyKeyEntry *)hash_seq_search(&status)) != NULL) {
+            if (entry->seq <= committed)
+                (void)hash_search(group->keyHash, &entry->key, HASH_REMOVE, NULL);
+        }
+    }
+
+    return (waitSeq > committed) ? waitSeq : 0;
+}
+
+/*
+ * Hand the current transaction over to a parallel apply worker.
+ */
+void ParallelApplyCommitTxn(XLogRecPtr endLsn, TimestampTz commitTime)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.parallelApplyGroup;
+    ParallelApplyTxn *txn = group->curTxn;
+    ParallelApplyTxn *cur = NULL;
+    int idx = -1;
+
+    group->curTxn = NULL;
+
+    /* Nothing to apply, e.g. all changes were filtered out. */
+    if (txn->msgs.len == 0) {
+        pfree(txn->msgs.data);
+        pfree(txn);
+        return;
+    }
+
+    txn->seq = ++group->lastSeq;
+    txn->waitSeq = parallel_apply_wait_seq(group, txn->seq);
+    txn->endLsn = endLsn;
+    txn->commitTime = commitTime;
+    txn->localEnd = InvalidXLogRecPtr;
+    txn->size = txn->msgs.len;
+
+    /* Don't run too far ahead of the parallel apply workers. */
+    while (group->lastSeq - pg_atomic_read_u64(&group->committedSeq) >
+           PARALLEL_APPLY_TXNS_PER_WORKER * (uint64)group->nworkers ||
+           (pg_atomic_read_u64(&group->pendingBytes) > 0 &&
+           pg_atomic_read_u64(&group->pendingBytes) + (uint64)txn->size > PARALLEL_APPLY_MAX_PENDING_BYTES))
+        parallel_apply_leader_wait(group);
+
+    /*
+     * A dependent transaction goes to the worker of the transaction it waits
+     * for, it would just block another worker otherwise.
+     */
+    if (txn->waitSeq != 0) {
+        for (cur = group->inflightHead; cur != NULL; cur = cur->inflightNext) {
+            if (cur->seq == txn->waitSeq) {
+                idx = cur->workerIdx;
+                break;
+            }
+        }
+    }
+    if (idx < 0) {
+        idx = 0;
+        for (int i = 1; i < group->nworkers; i++) {
+            if (group->members[i].pending < group->members[idx].pending)
+                idx = i;
+        }
+    }
+
+    txn->workerIdx = idx;
+    group->members[idx].pending++;
+    txn->inflightNext = NULL;
+    if (group->inflightTail != NULL)
+        group->inflightTail->inflightNext = txn;
+    else
+        group->inflightHead = txn;
+    group->inflightTail = txn;
+
+    (void)pg_atomic_fetch_add_u64(&group->pendingBytes, (uint64)txn->size);
+    parallel_apply_enqueue(&group->members[idx], txn);
+}
+
+/*
+ * Stop buffering the current transaction and apply what was buffered so far
+ * here.  The caller made sure the parallel apply workers are done.
+ */
+void ParallelApplySerializeTxn(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.parallelApplyGroup;
+    ParallelApplyTxn *txn = group->curTxn;
+    int offset = 0;
+
+    group->curTxn = NULL;
+
+    ereport(DEBUG1, (errmsg("logical replication transaction finishing at %X/%X is too large for parallel apply",
+        (uint32)(txn->finalLsn >> 32), (uint32)txn->finalLsn)));
+
+    while (offset < txn->msgs.len) {
+        int len;
+        errno_t rc = memcpy_s(&len, sizeof(int), txn->msgs.data + offset, sizeof(int));
+        securec_check(rc, "", "");
+        offset += sizeof(int);
+        ApplyWorkerDispatchMessage(txn->msgs.data + offset, len);
+        offset += len;
+    }
+
+    pfree(txn->msgs.data);
+    pfree(txn);
+}
+
+/*
+ * Get the next transaction committed by the parallel apply workers, in commit
+ * order, that changed anything locally.
+ */
+bool ParallelApplyPopCommitted(XLogRecPtr *remoteEnd, XLogRecPtr *localEnd)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.parallelApplyGroup;
+    ParallelApplyTxn *txn = NULL;
+    uint64 committed;
+
+    if (group == NULL)
+        return false;
+
+    if (group->failed)
+        ereport(ERROR, (errmsg("logical replication parallel apply worker for subscription \"%s\" exited "
+            "unexpectedly", t_thrd.applyworker_cxt.mySubscription->name)));
+
+    committed = pg_atomic_read_u64(&group->committedSeq);
+    pg_read_barrier();
+
+    while ((txn = group->inflightHead) != NULL && txn->seq <= committed) {
+        bool changed = !XLogRecPtrIsInvalid(txn->localEnd);
+
+        group->inflightHead = txn->inflightNext;
+        if (group->inflightHead == NULL)
+            group->inflightTail = NULL;
+        group->members[txn->workerIdx].pending--;
+
+        *remoteEnd = txn->endLsn;
+        *localEnd = txn->localEnd;
+        pfree(txn);
+
+        if (changed)
+            return true;
+    }
+
+    return false;
+}
+
+bool ParallelApplyHasPending(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.parallelApplyGroup;
+
+    return group != NULL && group->inflightHead != NULL;
+}
+
+/*
+ * Wait until the parallel apply workers committed every transaction handed
+ * over to them.
+ */
+void ParallelApplyWaitAll(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.parallelApplyGroup;
+
+    if (group == NULL)
+        return;
+
+    while (pg_atomic_read_u64(&group->committedSeq) < group->lastSeq)
+        parallel_apply_leader_wait(group);
+}
+
+/*
+ * Parallel apply worker side.
+ */
+
+static void ParallelApplyWorkerOnExit(int code, Datum arg)
+{
+    ParallelApplyMember *member = (ParallelApplyMember *)DatumGetPointer(arg);
+    ParallelApplyGroup *group = member->group;
+
+    SpinLockAcquire(&group->mutex);
+    member->proc = NULL;
+    if (!group->shutdown)
+        group->failed = true;
+    SpinLockRelease(&group->mutex);
+
+    SetLatch(&group->leaderProc->procLatch);
+}
+
+static ParallelApplyTxn *parallel_apply_dequeue(ParallelApplyGroup *group, ParallelApplyMember *member)
+{
+    for (;;) {
+        ParallelApplyTxn *txn = NULL;
+
+        SpinLockAcquire(&group->mutex);
+        txn = member->head;
+        if (txn != NULL) {
+            member->head = txn->next;
+            if (member->head == NULL)
+                member->tail = NULL;
+            if (!txn->isRelation)
+                member->curSeq = txn->seq;
+        }
+        SpinLockRelease(&group->mutex);
+
+        if (txn != NULL)
+            return txn;
+
+        parallel_apply_worker_wait(group, PARALLEL_APPLY_IDLE_NAPTIME);
+
+        if (t_thrd.applyworker_cxt.got_SIGHUP) {
+            t_thrd.applyworker_cxt.got_SIGHUP = false;
+            ProcessConfigFile(PGC_SIGHUP);
+        }
+    }
+}
+
+/*
+ * Does an earlier transaction, maybe waiting for a lock we hold, wait for a
+ * lock?
+ */
+static bool parallel_apply_earlier_waiting(ParallelApplyGroup *group, uint64 seq)
+{
+    bool waiting = false;
+
+    SpinLockAcquire(&group->mutex);
+    for (int i = 0; i < group->maxWorkers && !waiting; i++) {
+        ParallelApplyMember *other = &group->members[i];
+
+        if (other->proc != NULL && other->curSeq != 0 && other->curSeq < seq && other->proc->waitLock != NULL)
+            waiting = true;
+    }
+    SpinLockRelease(&group->mutex);
+
+    return waiting;
+}
+
+/*
+ * Wait until all earlier transactions committed.
+ *
+ * Returns false if we should rather roll back, an earlier transaction might be
+ * waiting for our locks.
+ */
+static bool parallel_apply_wait_turn(ParallelApplyGroup *group, uint64 seq, bool giveWay)
+{
+    TimestampTz start;
+
+    if (pg_atomic_read_u64(&group->committedSeq) == seq - 1)
+        return true;
+
+    start = GetCurrentTimestamp();
+    while (pg_atomic_read_u64(&group->committedSeq) != seq - 1) {
+        if (giveWay && TimestampDifferenceExceeds(start, GetCurrentTimestamp(),
+            u_sess->attr.attr_storage.DeadlockTimeout) && parallel_apply_earlier_waiting(group, seq))
+            return false;
+
+        parallel_apply_worker_wait(group, PARALLEL_APPLY_NAPTIME);
+    }
+
+    t_thrd.applyworker_cxt.curWorker->applyStats.orderWaitTime +=
+        (uint64)((GetCurrentTimestamp() - start) / USECS_PER_MSEC);
+    return true;
+}
+
+static void parallel_apply_replay(ParallelApplyTxn *txn)
+{
+    int offset = 0;
+
+    t_thrd.applyworker_cxt.inRemoteTransaction = true;
+    t_thrd.applyworker_cxt.remoteFinalLsn = txn->finalLsn;
+    t_thrd.applyworker_cxt.curRemoteCsn = txn->csn;
+
+    pgstat_report_activity(STATE_RUNNING, NULL);
+
+    while (offset < txn->msgs.len) {
+        int len;
+        errno_t rc = memcpy_s(&len, sizeof(int), txn->msgs.data + offset, sizeof(int));
+        securec_check(rc, "", "");
+        offset += sizeof(int);
+
+        MemoryContextSwitchTo(t_thrd.applyworker_cxt.messageContext);
+        ApplyWorkerDispatchMessage(txn->msgs.data + offset, len);
+        MemoryContextReset(t_thrd.applyworker_cxt.messageContext);
+        offset += len;
+    }
+}
+
+/*
+ * Errors of a transaction that started before its predecessors committed may
+ * just be due to their changes missing, and deadlocks may be due to the commit
+ * order we enforce, so try again in order.
+ */
+static bool parallel_apply_can_retry(ErrorData *edata, bool inOrder)
+{
+    if (edata->elevel > ERROR || edata->sqlerrcode == ERRCODE_QUERY_CANCELED ||
+        edata->sqlerrcode == ERRCODE_ADMIN_SHUTDOWN)
+        return false;
+
+    return !inOrder || edata->sqlerrcode == ERRCODE_T_R_DEADLOCK_DETECTED ||
+        edata->sqlerrcode == ERRCODE_T_R_SERIALIZATION_FAILURE;
+}
+
+static void parallel_apply_txn(ParallelApplyGroup *group, ParallelApplyMember *member, ParallelApplyTxn *txn)
+{
+    uint64 seq = txn->seq;
+    XLogRecPtr endLsn = txn->endLsn;
+    TimestampTz commitTime = txn->commitTime;
+    TimestampTz now;
+    volatile ParallelApplyStats *stats = &t_thrd.applyworker_cxt.curWorker->applyStats;
+
+    if (pg_atomic_read_u64(&group->committedSeq) < txn->waitSeq) {
+        TimestampTz start = GetCurrentTimestamp();
+
+        stats->depWaits++;
+        while (pg_atomic_read_u64(&group->committedSeq) < txn->waitSeq)
+            parallel_apply_worker_wait(group, PARALLEL_APPLY_NAPTIME);
+        stats->depWaitTime += (uint64)((GetCurrentTimestamp() - start) / USECS_PER_MSEC);
+    }
+
+    for (;;) {
+        volatile bool inOrder = (pg_atomic_read_u64(&group->committedSeq) == seq - 1);
+        volatile bool retry = false;
+
+        PG_TRY();
+        {
+            parallel_apply_replay(txn);
+            retry = !parallel_apply_wait_turn(group, seq, IsTransactionState());
+        }
+        PG_CATCH();
+        {
+            ErrorData *edata = NULL;
+
+            MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+            edata = CopyErrorData();
+            if (!parallel_apply_can_retry(edata, inOrder)) {
+                FreeErrorData(edata);
+                PG_RE_THROW();
+            }
+            ereport(DEBUG1, (errmsg("logical replication parallel apply worker retries transaction finishing at "
+                "%X/%X in commit order: %s", (uint32)(txn->finalLsn >> 32), (uint32)txn->finalLsn, edata->message)));
+            FlushErrorState();
+            FreeErrorData(edata);
+            retry = true;
+        }
+        PG_END_TRY();
+
+        if (!retry)
+            break;
+
+        AbortCurrentTransaction();
+        logicalrep_relmap_forget_open();
+        stats->retries++;
+        (void)parallel_apply_wait_turn(group, seq, false);
+    }
+
+    /* Update origin state so we can restart streaming from correct position. */
+    u_sess->reporigin_cxt.originTs = commitTime;
+    u_sess->reporigin_cxt.originLsn = endLsn;
+
+    if (IsTransactionState()) {
+        CommitTransactionCommand();
+        pgstat_report_stat(false);
+        txn->localEnd = t_thrd.xlog_cxt.XactLastCommitEnd;
+    }
+    t_thrd.applyworker_cxt.inRemoteTransaction = false;
+
+    pfree(txn->msgs.data);
+    txn->msgs.data = NULL;
+    (void)pg_atomic_fetch_sub_u64(&group->pendingBytes, (int64)txn->size);
+
+    /* The leader may free the transaction as soon as it sees it committed. */
+    pg_write_barrier();
+    pg_atomic_write_u64(&group->committedSeq, seq);
+
+    SpinLockAcquire(&group->mutex);
+    member->curSeq = 0;
+    SpinLockRelease(&group->mutex);
+
+    for (int i = 0; i < group->maxWorkers; i++) {
+        PGPROC *proc = NULL;
+
+        if (i == member->idx)
+            continue;
+        SpinLockAcquire(&group->mutex);
+        proc = group->members[i].proc;
+        SpinLockRelease(&group->mutex);
+        if (proc != NULL)
+            SetLatch(&proc->procLatch);
+    }
+    SetLatch(&group->leaderProc->procLatch);
+
+    now = GetCurrentTimestamp();
+    t_thrd.applyworker_cxt.curWorker->last_lsn = endLsn;
+    t_thrd.applyworker_cxt.curWorker->last_send_time = commitTime;
+    t_thrd.applyworker_cxt.curWorker->last_recv_time = now;
+    stats->txns++;
+    stats->lag = (int64)((now - commitTime) / USECS_PER_MSEC);
+    pgstat_report_activity(STATE_IDLE, NULL);
+}
+
+/*
+ * Main loop of a parallel apply worker, which applies the transactions handed
+ * over by its leader apply worker.
+ */
+void ParallelApplyWorkerMain(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.curWorker->applyGroup;
+    ParallelApplyMember *member = &group->members[t_thrd.applyworker_cxt.curWorker->applyGroupIdx];
+    char originname[NAMEDATALEN];
+    RepOriginId originid;
+    int rc;
+
+    SpinLockAcquire(&group->mutex);
+    if (group->shutdown || group->failed) {
+        SpinLockRelease(&group->mutex);
+        proc_exit(0);
+    }
+    member->proc = t_thrd.proc;
+    SpinLockRelease(&group->mutex);
+
+    on_shmem_exit(ParallelApplyWorkerOnExit, PointerGetDatum(member));
+
+    /* Commit through the replication origin of the leader. */
+    StartTransactionCommand();
+    rc = sprintf_s(originname, sizeof(originname), "pg_%u", t_thrd.applyworker_cxt.mySubscription->oid);
+    securec_check_ss(rc, "", "");
+    originid = replorigin_by_name(originname, false);
+    replorigin_session_setup(originid, group->leaderPid);
+    u_sess->reporigin_cxt.originId = originid;
+    CommitTransactionCommand();
+
+    t_thrd.applyworker_cxt.messageContext = AllocSetContextCreate(t_thrd.applyworker_cxt.applyContext,
+        "ApplyMessageContext", ALLOCSET_DEFAULT_SIZES);
+    pgstat_report_activity(STATE_IDLE, NULL);
+
+    for (;;) {
+        ParallelApplyTxn *txn = parallel_apply_dequeue(group, member);
+
+        if (txn->isRelation) {
+            MemoryContextSwitchTo(t_thrd.applyworker_cxt.messageContext);
+            ApplyWorkerDispatchMessage(txn->msgs.data, txn->msgs.len);
+            MemoryContextReset(t_thrd.applyworker_cxt.messageContext);
+            pfree(txn->msgs.data);
+            pfree(txn);
+            continue;
+        }
+
+        parallel_apply_txn(group, member, txn);
+    }
+}
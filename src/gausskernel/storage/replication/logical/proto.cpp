@@ -120,10 +120,14 @@ void logicalrep_write_origin(StringInfo out, const char *origin, XLogRecPtr orig
 /*
  * Write INSERT to the output stream.
  */
-void logicalrep_write_insert(StringInfo out, Relation rel, HeapTuple newtuple, bool binary)
+void logicalrep_write_insert(StringInfo out, TransactionId xid, Relation rel, HeapTuple newtuple, bool binary)
 {
     pq_sendbyte(out, 'I'); /* action INSERT */
 
+    /* transaction ID (if not valid, we're not streaming) */
+    if (TransactionIdIsValid(xid))
+        pq_sendint64(out, xid);
+
     /* use Oid as relation identifier */
     pq_sendint32(out, RelationGetRelid(rel));
 
@@ -156,10 +160,15 @@ LogicalRepRelId logicalrep_read_insert(StringInfo in, LogicalRepTupleData *newtu
 /*
  * Write UPDATE to the output stream.
  */
-void logicalrep_write_update(StringInfo out, Relation rel, HeapTuple oldtuple, HeapTuple newtuple, bool binary)
+void logicalrep_write_update(StringInfo out, TransactionId xid, Relation rel, HeapTuple oldtuple,
+    HeapTuple newtuple, bool binary)
 {
     pq_sendbyte(out, 'U'); /* action UPDATE */
 
+    /* transaction ID (if not valid, we're not streaming) */
+    if (TransactionIdIsValid(xid))
+        pq_sendint64(out, xid);
+
     /* use Oid as relation identifier */
     pq_sendint32(out, RelationGetRelid(rel));
 
@@ -218,7 +227,7 @@ LogicalRepRelId logicalrep_read_update(StringInfo in, bool *has_oldtuple, Logica
 /*
  * Write DELETE to the output stream.
  */
-void logicalrep_write_delete(StringInfo out, Relation rel, HeapTuple oldtuple, bool binary)
+void logicalrep_write_delete(StringInfo out, TransactionId xid, Relation rel, HeapTuple oldtuple, bool binary)
 {
     char relreplident = RelationGetRelReplident(rel);
     Assert(relreplident == REPLICA_IDENTITY_DEFAULT ||
@@ -226,6 +235,10 @@ void logicalrep_write_delete(StringInfo out, Relation rel, HeapTuple oldtuple, b
 
     pq_sendbyte(out, 'D'); /* action DELETE */
 
+    /* transaction ID (if not valid, we're not streaming) */
+    if (TransactionIdIsValid(xid))
+        pq_sendint64(out, xid);
+
     /* use Oid as relation identifier */
     pq_sendint32(out, RelationGetRelid(rel));
 
@@ -263,12 +276,16 @@ LogicalRepRelId logicalrep_read_delete(StringInfo in, LogicalRepTupleData *oldtu
 /*
  * Write relation description to the output stream.
  */
-void logicalrep_write_rel(StringInfo out, Relation rel)
+void logicalrep_write_rel(StringInfo out, TransactionId xid, Relation rel)
 {
     char *relname;
 
     pq_sendbyte(out, 'R'); /* sending RELATION */
 
+    /* transaction ID (if not valid, we're not streaming) */
+    if (TransactionIdIsValid(xid))
+        pq_sendint64(out, xid);
+
     /* use Oid as relation identifier */
     pq_sendint32(out, RelationGetRelid(rel));
 
@@ -311,7 +328,7 @@ LogicalRepRelation *logicalrep_read_rel(StringInfo in)
  *
  * This function will always write base type info.
  */
-void logicalrep_write_typ(StringInfo out, Oid typoid)
+void logicalrep_write_typ(StringInfo out, TransactionId xid, Oid typoid)
 {
     Oid basetypoid = getBaseType(typoid);
     HeapTuple tup;
@@ -319,6 +336,10 @@ void logicalrep_write_typ(StringInfo out, Oid typoid)
 
     pq_sendbyte(out, 'Y'); /* sending TYPE */
 
+    /* transaction ID (if not valid, we're not streaming) */
+    if (TransactionIdIsValid(xid))
+        pq_sendint64(out, xid);
+
     tup = SearchSysCache1(TYPEOID, ObjectIdGetDatum(basetypoid));
     if (!HeapTupleIsValid(tup))
         elog(ERROR, "cache lookup failed for type %u", basetypoid);
@@ -608,6 +629,118 @@ static const char *logicalrep_read_namespace(StringInfo in)
     return nspname;
 }
 
+/*
+ * Write STREAM START to the output stream.
+ */
+void logicalrep_write_stream_start(StringInfo out, TransactionId xid, bool first_segment)
+{
+    pq_sendbyte(out, 's'); /* action STREAM START */
+
+    Assert(TransactionIdIsValid(xid));
+
+    /* transaction ID (we're starting to stream, so must be valid) */
+    pq_sendint64(out, xid);
+
+    /* 1 if this is the first streaming segment for this xid */
+    pq_sendbyte(out, first_segment ? 1 : 0);
+}
+
+/*
+ * Read STREAM START from the output stream.
+ */
+TransactionId logicalrep_read_stream_start(StringInfo in, bool *first_segment)
+{
+    TransactionId xid;
+
+    Assert(first_segment);
+
+    xid = pq_getmsgint64(in);
+    *first_segment = (pq_getmsgbyte(in) == 1);
+
+    return xid;
+}
+
+/*
+ * Write STREAM STOP to the output stream.
+ */
+void logicalrep_write_stream_stop(StringInfo out)
+{
+    pq_sendbyte(out, 'e'); /* action STREAM END */
+}
+
+/*
+ * Write STREAM COMMIT to the output stream.
+ */
+void logicalrep_write_stream_commit(StringInfo out, ReorderBufferTXN *txn, XLogRecPtr commit_lsn)
+{
+    uint8 flags = 0;
+
+    pq_sendbyte(out, 'c'); /* action STREAM COMMIT */
+
+    Assert(TransactionIdIsValid(txn->xid));
+
+    /* transaction ID */
+    pq_sendint64(out, txn->xid);
+
+    /* send the flags field (unused for now) */
+    pq_sendbyte(out, flags);
+
+    /* send fields */
+    pq_sendint64(out, commit_lsn);
+    pq_sendint64(out, txn->end_lsn);
+    pq_sendint64(out, txn->commit_time);
+}
+
+/*
+ * Read STREAM COMMIT from the output stream.
+ */
+TransactionId logicalrep_read_stream_commit(StringInfo in, LogicalRepCommitData *commit_data)
+{
+    TransactionId xid;
+    uint8 flags;
+
+    xid = pq_getmsgint64(in);
+
+    /* read flags (unused for now) */
+    flags = pq_getmsgbyte(in);
+    if (flags != 0) {
+        elog(ERROR, "unknown flags %u in commit message", flags);
+    }
+
+    /* read fields */
+    commit_data->commit_lsn = pq_getmsgint64(in);
+    commit_data->end_lsn = pq_getmsgint64(in);
+    commit_data->committime = pq_getmsgint64(in);
+
+    return xid;
+}
+
+/*
+ * Write STREAM ABORT to the output stream. Note that xid and subxid will be
+ * same for the top-level transaction abort.
+ */
+void logicalrep_write_stream_abort(StringInfo out, TransactionId xid, TransactionId subxid)
+{
+    pq_sendbyte(out, 'a'); /* action STREAM ABORT */
+
+    Assert(TransactionIdIsValid(xid) && TransactionIdIsValid(subxid));
+
+    /* transaction ID */
+    pq_sendint64(out, xid);
+    pq_sendint64(out, subxid);
+}
+
+/*
+ * Read STREAM ABORT from the output stream.
+ */
+void logicalrep_read_stream_abort(StringInfo in, TransactionId *xid, TransactionId *subxid)
+{
+    Assert(xid && subxid);
+
+    *xid = pq_getmsgint64(in);
+    *subxid = pq_getmsgint64(in);
+}
+
 /*
  * Write conninfo to the output stream.
  */
@@ -347,3 +347,37 @@ void logicalrep_rel_close(LogicalRepRelMapEntry *rel, LOCKMODE lockmode)
     rel->localrel = NULL;
 }
 
+
+/*
+ * Get the remote relation info sent by the publisher, NULL if no RELATION
+ * message was received for it yet.
+ */
+LogicalRepRelation *logicalrep_get_remoterel(LogicalRepRelId remoteid)
+{
+    LogicalRepRelMapEntry *entry;
+    bool found = false;
+
+    if (t_thrd.applyworker_cxt.logicalRepRelMap == NULL)
+        return NULL;
+
+    entry = (LogicalRepRelMapEntry *)hash_search(t_thrd.applyworker_cxt.logicalRepRelMap, (void *)&remoteid,
+                                                 HASH_FIND, &found);
+    return found ? &entry->remoterel : NULL;
+}
+
+/*
+ * Forget the relations left open by a change whose transaction was aborted.
+ * Transaction abort already released their relcache references and locks.
+ */
+void logicalrep_relmap_forget_open(void)
+{
+    HASH_SEQ_STATUS status;
+    LogicalRepRelMapEntry *entry;
+
+    if (t_thrd.applyworker_cxt.logicalRepRelMap == NULL)
+        return;
+
+    hash_seq_init(&status, t_thrd.applyworker_cxt.logicalRepRelMap);
+    while ((entry = (LogicalRepRelMapEntry *)hash_seq_search(&status)) != NULL)
+        entry->localrel = NULL;
+}
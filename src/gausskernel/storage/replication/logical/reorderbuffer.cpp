@@ -140,6 +140,16 @@ static void ReorderBufferRestoreCleanup(ReorderBuffer *rb, ReorderBufferTXN *txn
 static void ReorderBufferFreeSnap(ReorderBuffer *rb, Snapshot snap);
 static Snapshot ReorderBufferCopySnap(ReorderBuffer *rb, Snapshot orig_snap, ReorderBufferTXN *txn, CommandId cid);
 
+/*
+ * ---------------------------------------
+ * Streaming support functions
+ * ---------------------------------------
+ */
+static bool ReorderBufferCanStream(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
+static void ReorderBufferStreamTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
+static void ReorderBufferTruncateTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
+static void ReorderBufferStreamAbort(ReorderBuffer *rb, ReorderBufferTXN *txn);
+
 /* ---------------------------------------
  * toast reassembly support
  * ---------------------------------------
@@ -180,6 +190,7 @@ ReorderBuffer *ReorderBufferAllocate(void)
 
     buffer->by_txn_last_xid = InvalidTransactionId;
     buffer->by_txn_last_txn = NULL;
+    buffer->stream_min_xid = InvalidTransactionId;
 
     buffer->nr_cached_transactions = 0;
     buffer->nr_cached_changes = 0;
@@ -271,6 +282,11 @@ void ReorderBufferReturnTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
         txn->invalidations = NULL;
     }
 
+    if (txn->stream_snapshot != NULL) {
+        ReorderBufferFreeSnap(rb, txn->stream_snapshot);
+        txn->stream_snapshot = NULL;
+    }
+
     /* check whether to put into the slab cache */
     if (rb->nr_cached_transactions < g_max_cached_transactions) {
         rb->nr_cached_transactions++;
@@ -1303,6 +1319,451 @@ static void ReorderBufferFreeSnap(ReorderBuffer *rb, Snapshot snap)
         SnapBuildSnapDecRefcount(snap);
 }
 
+/*
+ * Hand one change of a transaction being replayed to the output plugin, or
+ * update the decoding state (snapshot, command id) it depends on.
+ *
+ * Changes of an in-progress transaction are sent through the stream
+ * callbacks when 'streaming' is set. Returns true if decoding of the
+ * transaction has to stop.
+ */
+static bool ReorderBufferProcessChange(ReorderBuffer *rb, ReorderBufferTXN *txn, ReorderBufferChange *change,
+    ReorderBufferIterTXNState *iterstate, volatile Snapshot *snapshot_now, volatile CommandId *command_id,
+    bool streaming)
+{
+    Relation relation = NULL;
+    Oid reloid;
+    Oid partitionReltoastrelid = InvalidOid;
+    bool isSegment = false;
+
+    switch (change->action) {
+        case REORDER_BUFFER_CHANGE_INSERT:
+        case REORDER_BUFFER_CHANGE_UPDATE:
+        case REORDER_BUFFER_CHANGE_DELETE:
+            u_sess->utils_cxt.HistoricSnapshot->snapshotcsn = change->data.tp.snapshotcsn;
+            Assert(*snapshot_now);
+
+            isSegment = IsSegmentFileNode(change->data.tp.relnode);
+            reloid = HeapGetRelid(change->data.tp.relnode.spcNode, change->data.tp.relnode.relNode,
+                partitionReltoastrelid, NULL, isSegment);
+            /*
+             * Catalog tuple without data, emitted while catalog was
+             * in the process of being rewritten.
+             */
+            if (reloid == InvalidOid && change->data.tp.newtuple == NULL && change->data.tp.oldtuple == NULL)
+                return false;
+            else if (reloid == InvalidOid) {
+                /*
+                 * description:
+                 * When we try to decode a table who is already dropped.
+                 * Maybe we could not find it relnode.In this time, we will undecode this log.
+                 * It will be solve when we use MVCC.
+                 */
+                ereport(DEBUG1, (errmodule(MOD_LOGICAL_DECODE),
+                    errmsg("could not lookup relation %s",
+                           relpathperm(change->data.tp.relnode, MAIN_FORKNUM))));
+                return false;
+            }
+
+            relation = RelationIdGetRelation(reloid);
+            if (relation == NULL) {
+                ereport(DEBUG1, (errmodule(MOD_LOGICAL_DECODE),
+                    errmsg("could open relation descriptor %s",
+                           relpathperm(change->data.tp.relnode, MAIN_FORKNUM))));
+                return false;
+            }
+
+            /*
+             * Do not decode private tables, otherwise there will be security problems.
+             */
+            if (is_role_independent(FindRoleid(reloid))) {
+                return false;
+            }
+
+            if (CSTORE_NAMESPACE == get_rel_namespace(RelationGetRelid(relation))) {
+                return false;
+            }
+
+            if (RelationIsLogicallyLogged(relation)) {
+                /*
+                 * For now ignore sequence changes entirely. Most of
+                 * the time they don't log changes using records we
+                 * understand, so it doesn't make sense to handle the
+                 * few cases we do.
+                 */
+                if (RELKIND_IS_SEQUENCE(relation->rd_rel->relkind)) {
+                } else if (!IsToastRelation(relation)) { /* user-triggered change */
+                    ReorderBufferToastReplace(rb, txn, relation, change, partitionReltoastrelid, false);
+                    if (streaming)
+                        rb->stream_change(rb, txn, relation, change);
+                    else
+                        rb->apply_change(rb, txn, relation, change);
+                    /*
+                     * Only clear reassembled toast chunks if we're
+                     * sure they're not required anymore. The creator
+                     * of the tuple tells us.
+                     */
+                    if (change->data.tp.clear_toast_afterwards)
+                        ReorderBufferToastReset(rb, txn);
+                } else if (change->action == REORDER_BUFFER_CHANGE_INSERT) {
+                    /* we're not interested in toast deletions
+                     *
+                     * Need to reassemble the full toasted Datum in
+                     * memory, to ensure the chunks don't get reused
+                     * till we're done remove it from the list of this
+                     * transaction's changes. Otherwise it will get
+                     * freed/reused while restoring spooled data from
+                     * disk.
+                     */
+                    dlist_delete(&change->node);
+                    ReorderBufferToastAppendChunk(rb, txn, relation, change, false);
+                }
+            }
+            RelationClose(relation);
+            break;
+        case REORDER_BUFFER_CHANGE_INTERNAL_SNAPSHOT:
+            /* get rid of the old */
+            TeardownHistoricSnapshot(false);
+
+            if ((*snapshot_now)->copied) {
+                ReorderBufferFreeSnap(rb, *snapshot_now);
+                *snapshot_now = NULL;
+                *snapshot_now = ReorderBufferCopySnap(rb, change->data.snapshot, txn, *command_id);
+            } else if (change->data.snapshot->copied) {
+                /*
+                 * Restored from disk, need to be careful not to double
+                 * free. We could introduce refcounting for that, but for
+                 * now this seems infrequent enough not to care.
+                 */
+                *snapshot_now = ReorderBufferCopySnap(rb, change->data.snapshot, txn, *command_id);
+            } else {
+                *snapshot_now = change->data.snapshot;
+            }
+
+            /* and continue with the new one */
+            SetupHistoricSnapshot(*snapshot_now, txn->tuplecid_hash);
+            break;
+
+        case REORDER_BUFFER_CHANGE_INTERNAL_COMMAND_ID:
+            Assert(change->data.command_id != InvalidCommandId);
+            if (change->data.command_id != FirstCommandId) {
+                LogicalDecodeReportLostChanges<ReorderBufferIterTXNState>(iterstate);
+                return true;
+            }
+            if (*command_id < change->data.command_id) {
+                *command_id = change->data.command_id;
+
+                if (!(*snapshot_now)->copied) {
+                    /* we don't use the global one anymore */
+                    *snapshot_now = ReorderBufferCopySnap(rb, *snapshot_now, txn, *command_id);
+                }
+
+                (*snapshot_now)->curcid = *command_id;
+
+                TeardownHistoricSnapshot(false);
+                SetupHistoricSnapshot(*snapshot_now, txn->tuplecid_hash);
+
+                /*
+                 * Every time the CommandId is incremented, we could
+                 * see new catalog contents, so execute all
+                 * invalidations.
+                 */
+                ReorderBufferExecuteInvalidations(rb, txn);
+            }
+
+            break;
+
+        case REORDER_BUFFER_CHANGE_INTERNAL_TUPLECID:
+            ereport(ERROR, (errmodule(MOD_LOGICAL_DECODE),
+                errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("tuplecid value in changequeue")));
+            break;
+        case REORDER_BUFFER_CHANGE_UINSERT:
+        case REORDER_BUFFER_CHANGE_UDELETE:
+        case REORDER_BUFFER_CHANGE_UUPDATE:
+            u_sess->utils_cxt.HistoricSnapshot->snapshotcsn = change->data.utp.snapshotcsn;
+            Assert(*snapshot_now);
+
+            reloid = HeapGetRelid(change->data.utp.relnode.spcNode, change->data.utp.relnode.relNode,
+                partitionReltoastrelid, NULL, false);
+            /*
+             * Catalog tuple without data, emitted while catalog was
+             * in the process of being rewritten.
+             */
+            if (reloid == InvalidOid && change->data.utp.newtuple == NULL && change->data.utp.oldtuple == NULL)
+                return false;
+            else if (reloid == InvalidOid) {
+                /*
+                 * description:
+                 * When we try to decode a table who is already dropped.
+                 * Maybe we could not find it relnode.In this time, we will undecode this log.
+                 * It will be solve when we use MVCC.
+                 */
+                ereport(DEBUG1, (errmodule(MOD_LOGICAL_DECODE),
+                    errmsg("could not lookup relation %s",
+                           relpathperm(change->data.utp.relnode, MAIN_FORKNUM))));
+                return false;
+            }
+
+            relation = RelationIdGetRelation(reloid);
+            if (relation == NULL) {
+                ereport(DEBUG1, (errmodule(MOD_LOGICAL_DECODE),
+                    errmsg("could open relation descriptor %s",
+                           relpathperm(change->data.utp.relnode, MAIN_FORKNUM))));
+                return false;
+            }
+
+            if (CSTORE_NAMESPACE == get_rel_namespace(RelationGetRelid(relation))) {
+                return false;
+            }
+
+            if (RelationIsLogicallyLogged(relation)) {
+                /*
+                 * For now ignore sequence changes entirely. Most of
+                 * the time they don't log changes using records we
+                 * understand, so it doesn't make sense to handle the
+                 * few cases we do.
+                 */
+                if (RELKIND_IS_SEQUENCE(relation->rd_rel->relkind)) {
+                } else if (!IsToastRelation(relation)) { /* user-triggered change */
+                    ReorderBufferToastReplace(rb, txn, relation, change, partitionReltoastrelid, true);
+                    if (streaming)
+                        rb->stream_change(rb, txn, relation, change);
+                    else
+                        rb->apply_change(rb, txn, relation, change);
+                    /*
+                     * Only clear reassembled toast chunks if we're
+                     * sure they're not required anymore. The creator
+                     * of the tuple tells us.
+                     */
+                    if (change->data.utp.clear_toast_afterwards)
+                        ReorderBufferToastReset(rb, txn);
+                } else if (change->action == REORDER_BUFFER_CHANGE_UINSERT) {
+                    /* we're not interested in toast deletions
+                     *
+                     * Need to reassemble the full toasted Datum in
+                     * memory, to ensure the chunks don't get reused
+                     * till we're done remove it from the list of this
+                     * transaction's changes. Otherwise it will get
+                     * freed/reused while restoring spooled data from
+                     * disk.
+                     */
+                    dlist_delete(&change->node);
+                    ReorderBufferToastAppendChunk(rb, txn, relation, change, true);
+                }
+            }
+            RelationClose(relation);
+            break;
+    }
+
+    return false;
+}
+
+/*
+ * Does the transaction have changes left that were not streamed yet?
+ */
+static bool ReorderBufferTXNHasChanges(ReorderBufferTXN *txn)
+{
+    dlist_iter iter;
+
+    if (txn->nentries > 0)
+        return true;
+
+    dlist_foreach(iter, &txn->subtxns)
+    {
+        ReorderBufferTXN *subtxn = dlist_container(ReorderBufferTXN, node, iter.cur);
+
+        if (subtxn->nentries > 0)
+            return true;
+    }
+    return false;
+}
+
+/*
+ * Can the changes queued so far for this toplevel transaction be streamed
+ * before it commits?
+ *
+ * Catalog-modifying transactions cannot, as we only learn about their cache
+ * invalidations from the commit record; nor can transactions that already
+ * spilled to disk, that started before we announced streaming, or that we
+ * might not be interested in at all.
+ */
+static bool ReorderBufferCanStream(LogicalDecodingContext *ctx, ReorderBufferTXN *txn)
+{
+    dlist_iter iter;
+
+    if (!ctx->streaming || txn->is_known_as_subxact || txn->base_snapshot == NULL)
+        return false;
+
+    /* its subxacts might still look like toplevel transactions to us */
+    if (TransactionIdPrecedes(txn->xid, ctx->reorder->stream_min_xid))
+        return false;
+
+    if (SnapBuildCurrentState(ctx->snapshot_builder) != SNAPBUILD_CONSISTENT ||
+        SnapBuildXactNeedsSkip(ctx->snapshot_builder, ctx->reader->EndRecPtr))
+        return false;
+
+    if (txn->has_catalog_changes || txn->serialized)
+        return false;
+
+    dlist_foreach(iter, &txn->subtxns)
+    {
+        ReorderBufferTXN *subtxn = dlist_container(ReorderBufferTXN, node, iter.cur);
+
+        if (subtxn->has_catalog_changes || subtxn->serialized)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Release the in-memory changes of a transaction and its subtransactions
+ * once they have been streamed.
+ */
+static void ReorderBufferTruncateTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
+{
+    dlist_mutable_iter iter;
+
+    dlist_foreach_modify(iter, &txn->subtxns)
+    {
+        ReorderBufferTXN *subtxn = dlist_container(ReorderBufferTXN, node, iter.cur);
+
+        ReorderBufferTruncateTXN(rb, subtxn);
+    }
+
+    dlist_foreach_modify(iter, &txn->changes)
+    {
+        ReorderBufferChange *change = dlist_container(ReorderBufferChange, node, iter.cur);
+
+        dlist_delete(&change->node);
+        ReorderBufferReturnChange(rb, change);
+    }
+    txn->nentries = 0;
+    txn->nentries_mem = 0;
+
+    /* rebuilt from the remaining tuplecids when decoding the next block */
+    if (txn->tuplecid_hash != NULL) {
+        hash_destroy(txn->tuplecid_hash);
+        txn->tuplecid_hash = NULL;
+    }
+}
+
+/*
+ * Send the changes queued for a toplevel transaction, in lsn order, as one
+ * block of a streamed transaction and release them.
+ *
+ * The snapshot and command id reached are kept in the transaction, so that
+ * the next block - possibly sent at commit - is decoded as if all changes
+ * had been replayed at once. Toast chunks not yet reassembled are kept as
+ * well.
+ */
+static void ReorderBufferStreamTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
+{
+    ReorderBufferIterTXNState *volatile iterstate = NULL;
+    ReorderBufferChange *change = NULL;
+
+    volatile CommandId command_id = FirstCommandId;
+    volatile Snapshot snapshot_now = txn->base_snapshot;
+    volatile bool txn_started = false;
+    volatile bool subtxn_started = false;
+    u_sess->attr.attr_common.extra_float_digits = LOGICAL_DECODE_EXTRA_FLOAT_DIGITS;
+
+    Assert(!txn->is_known_as_subxact);
+
+    if (txn->stream_snapshot != NULL) {
+        snapshot_now = txn->stream_snapshot;
+        command_id = txn->stream_command_id;
+        txn->stream_snapshot = NULL;
+    }
+
+    /* build data to be able to lookup the CommandIds of catalog tuples */
+    ReorderBufferBuildTupleCidHash(rb, txn);
+
+    /* setup the initial snapshot */
+    SetupHistoricSnapshot(snapshot_now, txn->tuplecid_hash);
+
+    PG_TRY();
+    {
+        /* see ReorderBufferCommit() */
+        if (IsTransactionOrTransactionBlock()) {
+            BeginInternalSubTransaction("stream");
+            subtxn_started = true;
+        } else {
+            StartTransactionCommand();
+            txn_started = true;
+        }
+
+        rb->stream_start(rb, txn);
+
+        iterstate = ReorderBufferIterTXNInit(rb, txn);
+        while ((change = ReorderBufferIterTXNNext(rb, iterstate))) {
+            if (ReorderBufferProcessChange(rb, txn, change, iterstate, &snapshot_now, &command_id, true))
+                break;
+        }
+
+        ReorderBufferIterTXNFinish(rb, iterstate);
+        iterstate = NULL;
+
+        rb->stream_stop(rb, txn);
+
+        /* this is just a sanity check against bad output plugin behaviour */
+        if (GetCurrentTransactionIdIfAny() != InvalidTransactionId)
+            ereport(ERROR, (errmodule(MOD_LOGICAL_DECODE), errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("output plugin used xid %lu", GetCurrentTransactionId())));
+
+        /* make sure there's no cache pollution */
+        ReorderBufferExecuteInvalidations(rb, txn);
+
+        TeardownHistoricSnapshot(false);
+
+        if (subtxn_started)
+            RollbackAndReleaseCurrentSubTransaction();
+        else if (txn_started)
+            AbortCurrentTransaction();
+
+        /* the snapshot may belong to a change released below, keep a copy */
+        txn->stream_snapshot = ReorderBufferCopySnap(rb, snapshot_now, txn, command_id);
+        txn->stream_command_id = command_id;
+        if (snapshot_now->copied)
+            ReorderBufferFreeSnap(rb, snapshot_now);
+
+        ReorderBufferTruncateTXN(rb, txn);
+        txn->streamed = true;
+    }
+    PG_CATCH();
+    {
+        if (iterstate != NULL)
+            ReorderBufferIterTXNFinish(rb, iterstate);
+
+        TeardownHistoricSnapshot(true);
+
+        if (snapshot_now != NULL && snapshot_now->copied)
+            ReorderBufferFreeSnap(rb, snapshot_now);
+
+        if (subtxn_started)
+            RollbackAndReleaseCurrentSubTransaction();
+        else if (txn_started)
+            AbortCurrentTransaction();
+
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+}
+
+/*
+ * Tell the output plugin that a streamed toplevel transaction, or a
+ * subtransaction of one, aborted, so the changes already sent are discarded.
+ */
+static void ReorderBufferStreamAbort(ReorderBuffer *rb, ReorderBufferTXN *txn)
+{
+    ReorderBufferTXN *toptxn = txn;
+
+    if (txn->is_known_as_subxact)
+        toptxn = ReorderBufferTXNByXid(rb, txn->toplevel_xid, false, NULL, InvalidXLogRecPtr, false);
+
+    if (toptxn != NULL && toptxn->streamed)
+        rb->stream_abort(rb, txn);
+}
+
 /*
  * Perform the replay of a transaction and its non-aborted subtransactions.
  *
@@ -1353,6 +1814,29 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
         return;
     }
 
+    /*
+     * Part of the transaction was already streamed: send the rest as a last
+     * block, then tell the subscriber to apply all of it.
+     */
+    if (txn->streamed) {
+        PG_TRY();
+        {
+            if (ReorderBufferTXNHasChanges(txn))
+                ReorderBufferStreamTXN(rb, txn);
+            rb->stream_commit(rb, txn, commit_lsn);
+        }
+        PG_CATCH();
+        {
+            ReorderBufferCleanupTXN(rb, txn);
+            PG_RE_THROW();
+        }
+        PG_END_TRY();
+
+        /* remove potential on-disk data, and deallocate */
+        ReorderBufferCleanupTXN(rb, txn);
+        return;
+    }
+
     snapshot_now = txn->base_snapshot;
 
     /* build data to be able to lookup the CommandIds of catalog tuples */
@@ -1387,228 +1871,8 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
 
         iterstate = ReorderBufferIterTXNInit(rb, txn);
         while ((change = ReorderBufferIterTXNNext(rb, iterstate))) {
-            Relation relation = NULL;
-            Oid reloid;
-            Oid partitionReltoastrelid = InvalidOid;
-            bool stopDecoding = false;
-            bool isSegment = false;
-
-            switch (change->action) {
-                case REORDER_BUFFER_CHANGE_INSERT:
-                case REORDER_BUFFER_CHANGE_UPDATE:
-                case REORDER_BUFFER_CHANGE_DELETE:
-                    u_sess->utils_cxt.HistoricSnapshot->snapshotcsn = change->data.tp.snapshotcsn;
-                    Assert(snapshot_now);
-
-                    isSegment = IsSegmentFileNode(change->data.tp.relnode);
-                    reloid = HeapGetRelid(change->data.tp.relnode.spcNode, change->data.tp.relnode.relNode,
-                        partitionReltoastrelid, NULL, isSegment);
-                    /*
-                     * Catalog tuple without data, emitted while catalog was
-                     * in the process of being rewritten.
-                     */
-                    if (reloid == InvalidOid && change->data.tp.newtuple == NULL && change->data.tp.oldtuple == NULL)
-                        continue;
-                    else if (reloid == InvalidOid) {
-                        /*
-                         * description:
-                         * When we try to decode a table who is already dropped.
-                         * Maybe we could not find it relnode.In this time, we will undecode this log.
-                         * It will be solve when we use MVCC.
-                         */
-                        ereport(DEBUG1, (errmodule(MOD_LOGICAL_DECODE),
-                            errmsg("could not lookup relation %s",
-                                   relpathperm(change->data.tp.relnode, MAIN_FORKNUM))));
-                        continue;
-                    }
-
-                    relation = RelationIdGetRelation(reloid);
-                    if (relation == NULL) {
-                        ereport(DEBUG1, (errmodule(MOD_LOGICAL_DECODE),
-                            errmsg("could open relation descriptor %s",
-                                   relpathperm(change->data.tp.relnode, MAIN_FORKNUM))));
-                        continue;
-                    }
-
-                    /*
-                     * Do not decode private tables, otherwise there will be security problems.
-                     */
-                    if (is_role_independent(FindRoleid(reloid))) {
-                        continue;
-                    }
-
-                    if (CSTORE_NAMESPACE == get_rel_namespace(RelationGetRelid(relation))) {
-                        continue;
-                    }
-
-                    if (RelationIsLogicallyLogged(relation)) {
-                        /*
-                         * For now ignore sequence changes entirely. Most of
-                         * the time they don't log changes using records we
-                         * understand, so it doesn't make sense to handle the
-                         * few cases we do.
-                         */
-                        if (RELKIND_IS_SEQUENCE(relation->rd_rel->relkind)) {
-                        } else if (!IsToastRelation(relation)) { /* user-triggered change */
-                            ReorderBufferToastReplace(rb, txn, relation, change, partitionReltoastrelid, false);
-                            rb->apply_change(rb, txn, relation, change);
-                            /*
-                             * Only clear reassembled toast chunks if we're
-                             * sure they're not required anymore. The creator
-                             * of the tuple tells us.
-                             */
-                            if (change->data.tp.clear_toast_afterwards)
-                                ReorderBufferToastReset(rb, txn);
-                        } else if (change->action == REORDER_BUFFER_CHANGE_INSERT) {
-                            /* we're not interested in toast deletions
-                             *
-                             * Need to reassemble the full toasted Datum in
-                             * memory, to ensure the chunks don't get reused
-                             * till we're done remove it from the list of this
-                             * transaction's changes. Otherwise it will get
-                             * freed/reused while restoring spooled data from
-                             * disk.
-                             */
-                            dlist_delete(&change->node);
-                            ReorderBufferToastAppendChunk(rb, txn, relation, change, false);
-                        }
-                    }
-                    RelationClose(relation);
-                    break;
-                case REORDER_BUFFER_CHANGE_INTERNAL_SNAPSHOT:
-                    /* get rid of the old */
-                    TeardownHistoricSnapshot(false);
-
-                    if (snapshot_now->copied) {
-                        ReorderBufferFreeSnap(rb, snapshot_now);
-                        snapshot_now = NULL;
-                        snapshot_now = ReorderBufferCopySnap(rb, change->data.snapshot, txn, command_id);
-                    } else if (change->data.snapshot->copied) {
-                        /*
-                         * Restored from disk, need to be careful not to double
-                         * free. We could introduce refcounting for that, but for
-                         * now this seems infrequent enough not to care.
-                         */
-                        snapshot_now = ReorderBufferCopySnap(rb, change->data.snapshot, txn, command_id);
-                    } else {
-                        snapshot_now = change->data.snapshot;
-                    }
-
-                    /* and continue with the new one */
-                    SetupHistoricSnapshot(snapshot_now, txn->tuplecid_hash);
-                    break;
-
-                case REORDER_BUFFER_CHANGE_INTERNAL_COMMAND_ID:
-                    Assert(change->data.command_id != InvalidCommandId);
-                    if (change->data.command_id != FirstCommandId) {
-                        LogicalDecodeReportLostChanges<ReorderBufferIterTXNState>(iterstate);
-                        stopDecoding = true;
-                        break;
-                    }
-                    if (command_id < change->data.command_id) {
-                        command_id = change->data.command_id;
-
-                        if (!snapshot_now->copied) {
-                            /* we don't use the global one anymore */
-                            snapshot_now = ReorderBufferCopySnap(rb, snapshot_now, txn, command_id);
-                        }
-
-                        snapshot_now->curcid = command_id;
-
-                        TeardownHistoricSnapshot(false);
-                        SetupHistoricSnapshot(snapshot_now, txn->tuplecid_hash);
-
-                        /*
-                         * Every time the CommandId is incremented, we could
-                         * see new catalog contents, so execute all
-                         * invalidations.
-                         */
-                        ReorderBufferExecuteInvalidations(rb, txn);
-                    }
-
-                    break;
-
-                case REORDER_BUFFER_CHANGE_INTERNAL_TUPLECID:
-                    ereport(ERROR, (errmodule(MOD_LOGICAL_DECODE),
-                        errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("tuplecid value in changequeue")));
-                    break;
-                case REORDER_BUFFER_CHANGE_UINSERT:
-                case REORDER_BUFFER_CHANGE_UDELETE:
-                case REORDER_BUFFER_CHANGE_UUPDATE:
-                    u_sess->utils_cxt.HistoricSnapshot->snapshotcsn = change->data.utp.snapshotcsn;
-                    Assert(snapshot_now);
-
-                    reloid = HeapGetRelid(change->data.utp.relnode.spcNode, change->data.utp.relnode.relNode,
-                        partitionReltoastrelid, NULL, false);
-                    /*
-                     * Catalog tuple without data, emitted while catalog was
-                     * in the process of being rewritten.
-                     */
-                    if (reloid == InvalidOid && change->data.utp.newtuple == NULL && change->data.utp.oldtuple == NULL)
-                        continue;
-                    else if (reloid == InvalidOid) {
-                        /*
-                         * description:
-                         * When we try to decode a table who is already dropped.
-                         * Maybe we could not find it relnode.In this time, we will undecode this log.
-                         * It will be solve when we use MVCC.
-                         */
-                        ereport(DEBUG1, (errmodule(MOD_LOGICAL_DECODE),
-                            errmsg("could not lookup relation %s",
-                                   relpathperm(change->data.utp.relnode, MAIN_FORKNUM))));
-                        continue;
-                    }
-
-                    relation = RelationIdGetRelation(reloid);
-                    if (relation == NULL) {
-                        ereport(DEBUG1, (errmodule(MOD_LOGICAL_DECODE),
-                            errmsg("could open relation descriptor %s",
-                                   relpathperm(change->data.utp.relnode, MAIN_FORKNUM))));
-                        continue;
-                    }
-
-                    if (CSTORE_NAMESPACE == get_rel_namespace(RelationGetRelid(relation))) {
-                        continue;
-                    }
-
-                    if (RelationIsLogicallyLogged(relation)) {
-                        /*
-                         * For now ignore sequence changes entirely. Most of
-                         * the time they don't log changes using records we
-                         * understand, so it doesn't make sense to handle the
-                         * few cases we do.
-                         */
-                        if (RELKIND_IS_SEQUENCE(relation->rd_rel->relkind)) {
-                        } else if (!IsToastRelation(relation)) { /* user-triggered change */
-                            ReorderBufferToastReplace(rb, txn, relation, change, partitionReltoastrelid, true);
-                            rb->apply_change(rb, txn, relation, change);
-                            /*
-                             * Only clear reassembled toast chunks if we're
-                             * sure they're not required anymore. The creator
-                             * of the tuple tells us.
-                             */
-                            if (change->data.utp.clear_toast_afterwards)
-                                ReorderBufferToastReset(rb, txn);
-                        } else if (change->action == REORDER_BUFFER_CHANGE_UINSERT) {
-                            /* we're not interested in toast deletions
-                             *
-                             * Need to reassemble the full toasted Datum in
-                             * memory, to ensure the chunks don't get reused
-                             * till we're done remove it from the list of this
-                             * transaction's changes. Otherwise it will get
-                             * freed/reused while restoring spooled data from
-                             * disk.
-                             */
-                            dlist_delete(&change->node);
-                            ReorderBufferToastAppendChunk(rb, txn, relation, change, true);
-                        }
-                    }
-                    RelationClose(relation);
-                    break;
-            }
-            if (stopDecoding) {
+            if (ReorderBufferProcessChange(rb, txn, change, iterstate, &snapshot_now, &command_id, false))
                 break;
-            }
         }
 
         ReorderBufferIterTXNFinish(rb, iterstate);
@@ -1699,6 +1963,9 @@ void ReorderBufferAbort(ReorderBuffer *rb, TransactionId xid, XLogRecPtr lsn)
     /* cosmetic... */
     txn->final_lsn = lsn;
 
+    /* let the subscriber discard what was streamed of it */
+    ReorderBufferStreamAbort(rb, txn);
+
     /* remove potential on-disk data, and deallocate */
     ReorderBufferCleanupTXN(rb, txn);
 }
@@ -1729,6 +1996,8 @@ void ReorderBufferAbortOld(ReorderBuffer *rb, TransactionId oldestRunningXid, XL
         if (TransactionIdPrecedes(txn->xid, oldestRunningXid)) {
             ereport(DEBUG2, (errmodule(MOD_LOGICAL_DECODE), errmsg("aborting old transaction %lu", txn->xid)));
 
+            ReorderBufferStreamAbort(rb, txn);
+
             /* remove potential on-disk data, and deallocate this tx */
             ReorderBufferCleanupTXN(rb, txn, lsn);
         } else
@@ -1784,6 +2053,9 @@ void ReorderBufferForget(ReorderBuffer *rb, TransactionId xid, XLogRecPtr lsn)
     } else
         Assert(txn->ninvalidations == 0);
 
+    /* a streamed transaction we are not interested in after all */
+    ReorderBufferStreamAbort(rb, txn);
+
     /* remove potential on-disk data, and deallocate */
     ReorderBufferCleanupTXN(rb, txn);
 }
@@ -2018,6 +2290,18 @@ static void ReorderBufferCheckSerializeTXN(LogicalDecodingContext *ctx, ReorderB
         (data != NULL && data->max_txn_in_memory > 0 && txn->size >= (Size)data->max_txn_in_memory * sizeMB) ||
         (data != NULL && data->max_reorderbuffer_in_memory > 0 &&
         ctx->reorder->size >= (Size)data->max_reorderbuffer_in_memory * sizeGB)) {
+        ReorderBufferTXN *toptxn = txn;
+
+        if (txn->is_known_as_subxact)
+            toptxn = ReorderBufferTXNByXid(ctx->reorder, txn->toplevel_xid, false, NULL, InvalidXLogRecPtr, false);
+
+        /* send the changes to the subscriber right away rather than to disk */
+        if (toptxn != NULL && ReorderBufferCanStream(ctx, toptxn)) {
+            ReorderBufferStreamTXN(ctx->reorder, toptxn);
+            Assert(txn->nentries_mem == 0);
+            return;
+        }
+
         ReorderBufferSerializeTXN(ctx->reorder, txn);
         Assert(txn->size == 0);
         Assert(txn->nentries_mem == 0);
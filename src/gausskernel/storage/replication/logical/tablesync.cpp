@@ -90,6 +90,18 @@
  *			-> set in catalog READY
  *			-> stop per-table filtering
  *			-> continue rep
+ *
+ *	  A large table can be copied by the sync worker together with up to
+ *	  max_parallel_sync_workers_per_table parallel sync workers.  The sync
+ *	  worker exports the snapshot of its slot and every worker imports it, so
+ *	  all of them see the same data.  The table is split by partition on the
+ *	  publisher, or else into one range of its integer primary key per worker,
+ *	  which the publisher can read through the key's index; tables with
+ *	  neither are copied by the sync worker alone.  Each worker commits its
+ *	  share locally on its own.  This is only done for tables that are
+ *	  empty locally, and a marker file in pg_logical lives until the copy has
+ *	  been committed as FINISHEDCOPY, so a restarted sync worker knows to
+ *	  truncate a partially copied table before copying it again.
  *-------------------------------------------------------------------------
  */
 
@@ -100,6 +112,7 @@
 
 #include "access/xact.h"
 
+#include "catalog/heap.h"
 #include "catalog/pg_subscription_rel.h"
 #include "catalog/pg_type.h"
 
@@ -111,14 +124,58 @@
 #include "replication/walreceiver.h"
 #include "replication/worker_internal.h"
 
+#include "storage/copydir.h"
 #include "storage/ipc.h"
 #include "storage/lmgr.h"
+#include "storage/smgr/fd.h"
 
 #include "utils/builtins.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "access/tableam.h"
+#include "commands/tablecmds.h"
 #include "libpq/libpq-fe.h"
+#include "nodes/makefuncs.h"
+#include "utils/atomic.h"
+#include "utils/int8.h"
+
+static const long PARALLEL_SYNC_NAPTIME = 10L; /* 10ms */
+static const int PARALLEL_SYNC_STOP_TIMEOUT = 10000; /* 10s */
+#define PARALLEL_SYNC_MARKER_DIR "pg_logical"
+
+/* A share of the table copied by one worker */
+typedef struct ParallelSyncRange {
+    int64 lower;       /* first key of the range, if hasLower */
+    int64 upper;       /* first key after the range, if hasUpper */
+    bool hasLower;
+    bool hasUpper;
+    NameData partName; /* partition on the publisher, if split by partition */
+} ParallelSyncRange;
+
+struct ParallelSyncGroup {
+    MemoryContext context;
+    Oid relid;
+    char slotName[NAMEDATALEN];
+    char snapshotName[NAMEDATALEN]; /* snapshot exported by the sync worker */
+    bool byPartition;
+    NameData keyName; /* primary key column on the publisher, if split by key */
+    bool binary;
+    pg_atomic_uint32 nextRange;
+    pg_atomic_uint64 rowsCopied;
+
+    /* protected by mutex */
+    slock_t mutex;
+    PGPROC *leaderProc;
+    int nranges; /* ranges can't be claimed before this is set */
+    int nstarted;
+    int nexited;
+    int nsucceeded;
+    bool closed; /* no further workers may join */
+    volatile bool shutdown;
+    volatile bool failed;
+
+    ParallelSyncRange ranges[FLEXIBLE_ARRAY_MEMBER];
+};
 
 static void finish_sync_worker(char *slotName = NULL);
 
@@ -514,11 +571,11 @@ static void process_syncing_tables_for_apply(XLogRecPtr current_lsn)
                  * worker for the table.
                  */
                 if (nsyncworkers < u_sess->attr.attr_storage.max_sync_workers_per_subscription) {
-                    logicalrep_worker_launch(t_thrd.applyworker_cxt.curWorker->dbid,
-                                             t_thrd.applyworker_cxt.mySubscription->oid,
-                                             t_thrd.applyworker_cxt.mySubscription->name,
-                                             t_thrd.applyworker_cxt.curWorker->userid,
-                                             rstate->relid);
+                    (void)logicalrep_worker_launch(t_thrd.applyworker_cxt.curWorker->dbid,
+                                                   t_thrd.applyworker_cxt.mySubscription->oid,
+                                                   t_thrd.applyworker_cxt.mySubscription->name,
+                                                   t_thrd.applyworker_cxt.curWorker->userid,
+                                                   rstate->relid, NULL, -1, NULL);
                 }
             }
         }
@@ -735,6 +792,615 @@ static void fetch_remote_table_info(char *nspname, char *relname, LogicalRepRela
     pfree(cmd.data);
 }
 
+static void parallel_sync_marker_path(char *path, size_t size, Oid subid, Oid relid)
+{
+    int rc = snprintf_s(path, size, size - 1, PARALLEL_SYNC_MARKER_DIR "/parallel_sync_%u_%u", subid, relid);
+    securec_check_ss(rc, "", "");
+}
+
+/*
+ * Durably note that parallel sync workers are going to commit parts of the
+ * table before the sync worker commits the FINISHEDCOPY state.
+ */
+static void parallel_sync_create_marker(Oid subid, Oid relid)
+{
+    char path[MAXPGPATH];
+    int fd;
+
+    parallel_sync_marker_path(path, sizeof(path), subid, relid);
+    fd = BasicOpenFile(path, O_CREAT | O_WRONLY | PG_BINARY, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+        ereport(ERROR, (errcode_for_file_access(), errmsg("could not create file \"%s\": %m", path)));
+    if (pg_fsync(fd) != 0) {
+        int save_errno = errno;
+
+        (void)close(fd);
+        errno = save_errno;
+        ereport(ERROR, (errcode_for_file_access(), errmsg("could not fsync file \"%s\": %m", path)));
+    }
+    (void)close(fd);
+    fsync_fname(PARALLEL_SYNC_MARKER_DIR, true);
+}
+
+static bool parallel_sync_marker_exists(Oid subid, Oid relid)
+{
+    char path[MAXPGPATH];
+    struct stat st;
+
+    parallel_sync_marker_path(path, sizeof(path), subid, relid);
+    if (stat(path, &st) != 0) {
+        if (errno != ENOENT)
+            ereport(ERROR, (errcode_for_file_access(), errmsg("could not stat file \"%s\": %m", path)));
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Remove the marker of a parallel copy, returns whether there was one.
+ */
+static bool parallel_sync_remove_marker(Oid subid, Oid relid)
+{
+    char path[MAXPGPATH];
+
+    parallel_sync_marker_path(path, sizeof(path), subid, relid);
+    if (unlink(path) != 0) {
+        if (errno != ENOENT)
+            ereport(ERROR, (errcode_for_file_access(), errmsg("could not remove file \"%s\": %m", path)));
+        return false;
+    }
+    fsync_fname(PARALLEL_SYNC_MARKER_DIR, true);
+    return true;
+}
+
+/*
+ * Throw away what an interrupted parallel copy of the table committed.
+ *
+ * The table was empty when the copy started, so truncating it restores the
+ * state the copy is retried from.
+ */
+static void parallel_sync_truncate_table(Oid relid)
+{
+    TruncateStmt *stmt = makeNode(TruncateStmt);
+    Relation rel;
+    char *qualname = NULL;
+
+    StartTransactionCommand();
+    rel = heap_open(relid, AccessExclusiveLock);
+    stmt->relations = list_make1(makeRangeVar(get_namespace_name(RelationGetNamespace(rel)),
+        pstrdup(RelationGetRelationName(rel)), -1));
+    stmt->behavior = DROP_RESTRICT;
+    stmt->restart_seqs = false;
+    qualname = quote_qualified_identifier(get_namespace_name(RelationGetNamespace(rel)),
+        RelationGetRelationName(rel));
+    heap_close(rel, NoLock);
+
+    ereport(LOG, (errmsg("logical replication table synchronization for subscription \"%s\" truncates "
+        "partially copied table \"%s\"", t_thrd.applyworker_cxt.mySubscription->name, qualname)));
+
+#ifdef PGXC
+    ExecuteTruncate(stmt, psprintf("TRUNCATE TABLE %s", qualname));
+#else
+    ExecuteTruncate(stmt);
+#endif
+    CommitTransactionCommand();
+}
+
+static void parallel_sync_wait(long timeout)
+{
+    int rc = WaitLatch(&t_thrd.proc->procLatch, WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH, timeout);
+    /* emergency bailout if postmaster has died */
+    if (rc & WL_POSTMASTER_DEATH)
+        proc_exit(1);
+
+    ResetLatch(&t_thrd.proc->procLatch);
+    CHECK_FOR_INTERRUPTS();
+}
+
+/*
+ * Release the parallel sync group of this sync worker, once none of its
+ * workers can look at it anymore.
+ */
+static void ParallelSyncLeaderOnExit(int code, Datum arg)
+{
+    ParallelSyncGroup *group = t_thrd.applyworker_cxt.parallelSyncGroup;
+    ApplyLauncherShmStruct *shm = t_thrd.applylauncher_cxt.applyLauncherShm;
+    int waited = 0;
+
+    if (group == NULL)
+        return;
+
+    SpinLockAcquire(&group->mutex);
+    group->closed = true;
+    if (group->nexited < group->nstarted)
+        group->shutdown = true;
+    SpinLockRelease(&group->mutex);
+
+    for (;;) {
+        int alive = 0;
+
+        (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+        for (int i = 0; i < g_instance.attr.attr_storage.max_logical_replication_workers; i++) {
+            LogicalRepWorker *worker = &shm->workers[i];
+
+            if (worker->syncGroup != group)
+                continue;
+            alive++;
+            if (worker->proc != NULL && waited % MSECS_PER_SEC == 0)
+                (void)gs_signal_send(worker->proc->pid, SIGTERM);
+        }
+        LWLockRelease(LogicalRepWorkerLock);
+
+        if (alive == 0)
+            break;
+
+        if (waited >= PARALLEL_SYNC_STOP_TIMEOUT) {
+            ereport(WARNING, (errmsg("%d logical replication parallel sync workers did not exit in time", alive)));
+            t_thrd.applyworker_cxt.parallelSyncGroup = NULL;
+            return;
+        }
+
+        pg_usleep(PARALLEL_SYNC_NAPTIME * USECS_PER_MSEC);
+        waited += PARALLEL_SYNC_NAPTIME;
+    }
+
+    MemoryContextDelete(group->context);
+    t_thrd.applyworker_cxt.parallelSyncGroup = NULL;
+}
+
+/*
+ * Copy the ranges of the table not claimed by another worker yet.
+ */
+static void parallel_sync_copy_ranges(ParallelSyncGroup *group, LogicalRepRelMapEntry *relmapentry,
+    List *attnamelist)
+{
+    LogicalRepRelation *lrel = &relmapentry->remoterel;
+    AdaptMem mem_info;
+    List *options = NIL;
+    StringInfoData cmd;
+    uint32 idx;
+
+    mem_info.max_mem = 0;
+    mem_info.work_mem = 0;
+    if (group->binary)
+        options = list_make1(makeDefElem("format", (Node *)makeString("binary")));
+
+    initStringInfo(&cmd);
+    while ((idx = pg_atomic_fetch_add_u32(&group->nextRange, 1)) < (uint32)group->nranges) {
+        ParallelSyncRange *range = &group->ranges[idx];
+        WalRcvExecResult *res;
+        CopyState cstate;
+        uint64 processed;
+
+        if (group->shutdown || group->failed)
+            ereport(ERROR, (errmsg("parallel copy of table \"%s.%s\" was canceled", lrel->nspname, lrel->relname)));
+
+        resetStringInfo(&cmd);
+        appendStringInfoString(&cmd, "COPY (SELECT ");
+        for (int i = 0; i < lrel->natts; i++) {
+            appendStringInfo(&cmd, "%s%s", i > 0 ? ", " : "", quote_identifier(lrel->attnames[i]));
+        }
+        appendStringInfo(&cmd, " FROM %s", quote_qualified_identifier(lrel->nspname, lrel->relname));
+        if (group->byPartition) {
+            appendStringInfo(&cmd, " PARTITION (%s)", quote_identifier(NameStr(range->partName)));
+        } else {
+            const char *key = quote_identifier(NameStr(group->keyName));
+
+            if (range->hasLower)
+                appendStringInfo(&cmd, " WHERE %s >= " INT64_FORMAT, key, range->lower);
+            if (range->hasUpper)
+                appendStringInfo(&cmd, " %s %s < " INT64_FORMAT, range->hasLower ? "AND" : "WHERE", key,
+                    range->upper);
+        }
+        appendStringInfoString(&cmd, ") TO STDOUT");
+        if (group->binary)
+            appendStringInfoString(&cmd, " WITH (FORMAT binary)");
+
+        res = (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_exec(cmd.data, 0, NULL);
+        if (res->status != WALRCV_OK_COPY_OUT)
+            ereport(ERROR, (errmsg("could not start initial contents copy for table \"%s.%s\": %s", lrel->nspname,
+                lrel->relname, res->err)));
+        walrcv_clear_result(res);
+
+        t_thrd.applyworker_cxt.copybuf = makeStringInfo();
+        cstate = BeginCopyFrom(relmapentry->localrel, NULL, attnamelist, options, &mem_info, (const char *)cmd.data,
+            copy_read_data);
+        processed = CopyFrom(cstate);
+        EndCopyFrom(cstate);
+        pg_atomic_fetch_add_u64(&group->rowsCopied, processed);
+    }
+    pfree(cmd.data);
+}
+
+/*
+ * Get the text of the only column of the only row of a query on the publisher.
+ */
+static char *fetch_remote_text(const char *query, const char *what)
+{
+    WalRcvExecResult *res;
+    TupleTableSlot *slot;
+    Oid textRow[1] = {TEXTOID};
+    bool isnull = false;
+    char *result = NULL;
+
+    res = (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_exec(query, 1, textRow);
+    if (res->status != WALRCV_OK_TUPLES)
+        ereport(ERROR, (errmsg("could not fetch %s from publisher: %s", what, res->err)));
+
+    slot = MakeSingleTupleTableSlot(res->tupledesc);
+    if (tuplestore_gettupleslot(res->tuplestore, true, false, slot)) {
+        Datum value = tableam_tslot_getattr(slot, 1, &isnull);
+        if (!isnull)
+            result = TextDatumGetCString(value);
+    }
+    if (result == NULL)
+        ereport(ERROR, (errmsg("could not fetch %s from publisher", what)));
+
+    ExecDropSingleTupleTableSlot(slot);
+    walrcv_clear_result(res);
+    return result;
+}
+
+/*
+ * Get the partitions of the table on the publisher, NIL if not partitioned.
+ */
+static List *fetch_remote_partitions(LogicalRepRelation *lrel)
+{
+    WalRcvExecResult *res;
+    StringInfoData cmd;
+    TupleTableSlot *slot;
+    Oid partRow[1] = {NAMEOID};
+    List *partitions = NIL;
+    bool isnull = false;
+
+    initStringInfo(&cmd);
+    appendStringInfo(&cmd,
+        "SELECT p.relname"
+        "  FROM pg_catalog.pg_partition p"
+        " WHERE p.parentid = %u"
+        "   AND p.parttype = 'p'"
+        " ORDER BY p.oid",
+        lrel->remoteid);
+    res = (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_exec(cmd.data, 1, partRow);
+    if (res->status != WALRCV_OK_TUPLES)
+        ereport(ERROR, (errmsg("could not fetch partitions of table \"%s.%s\" from publisher: %s", lrel->nspname,
+            lrel->relname, res->err)));
+
+    slot = MakeSingleTupleTableSlot(res->tupledesc);
+    while (tuplestore_gettupleslot(res->tuplestore, true, false, slot)) {
+        Datum value = tableam_tslot_getattr(slot, 1, &isnull);
+        Assert(!isnull);
+        partitions = lappend(partitions, pstrdup(NameStr(*DatumGetName(value))));
+        ExecClearTuple(slot);
+    }
+    ExecDropSingleTupleTableSlot(slot);
+    walrcv_clear_result(res);
+    pfree(cmd.data);
+
+    return partitions;
+}
+
+/*
+ * Get the primary key column of the table on the publisher, NULL unless the
+ * key is a single integer column.
+ */
+static char *fetch_remote_int_key(LogicalRepRelation *lrel)
+{
+    WalRcvExecResult *res;
+    StringInfoData cmd;
+    TupleTableSlot *slot;
+    Oid keyRow[1] = {NAMEOID};
+    char *keyName = NULL;
+    bool isnull = false;
+
+    initStringInfo(&cmd);
+    appendStringInfo(&cmd,
+        "SELECT a.attname"
+        "  FROM pg_catalog.pg_index i"
+        "  JOIN pg_catalog.pg_attribute a ON a.attrelid = i.indrelid AND a.attnum = i.indkey[0]"
+        " WHERE i.indrelid = %u"
+        "   AND i.indisprimary"
+        "   AND i.indnatts = 1"
+        "   AND a.atttypid IN (%u, %u, %u)",
+        lrel->remoteid, INT2OID, INT4OID, INT8OID);
+    res = (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_exec(cmd.data, 1, keyRow);
+    if (res->status != WALRCV_OK_TUPLES)
+        ereport(ERROR, (errmsg("could not fetch primary key of table \"%s.%s\" from publisher: %s", lrel->nspname,
+            lrel->relname, res->err)));
+
+    slot = MakeSingleTupleTableSlot(res->tupledesc);
+    if (tuplestore_gettupleslot(res->tuplestore, true, false, slot)) {
+        Datum value = tableam_tslot_getattr(slot, 1, &isnull);
+        Assert(!isnull);
+        keyName = pstrdup(NameStr(*DatumGetName(value)));
+    }
+    ExecDropSingleTupleTableSlot(slot);
+    walrcv_clear_result(res);
+    pfree(cmd.data);
+
+    return keyName;
+}
+
+/*
+ * Copy the table together with parallel sync workers, if it is worth it.
+ *
+ * Returns false if the caller is to copy the table alone.
+ */
+static bool copy_table_parallel(Relation rel, LogicalRepRelMapEntry *relmapentry, List *attnamelist)
+{
+    int maxWorkers = u_sess->attr.attr_storage.max_parallel_sync_workers_per_table;
+    LogicalRepWorker *leader = t_thrd.applyworker_cxt.curWorker;
+    Subscription *sub = t_thrd.applyworker_cxt.mySubscription;
+    LogicalRepRelation *lrel = &relmapentry->remoterel;
+    ParallelSyncGroup *group = NULL;
+    MemoryContext context;
+    StringInfoData cmd;
+    List *partitions = NIL;
+    ListCell *lc = NULL;
+    int64 tableBytes;
+    char *keyName = NULL;
+    int64 minKey = 0;
+    int64 maxKey = 0;
+    int nranges;
+    int npartitions = 0;
+    int nworkers = 0;
+    int nsucceeded;
+    bool failed = false;
+    int rc;
+
+    /*
+     * Parts of the table are committed by other workers before the copy as a
+     * whole is, so a failed copy has to be undone by truncating the table.
+     */
+    if (maxWorkers <= 0 || RELATION_IS_PARTITIONED(rel) || RelationGetNumberOfBlocks(rel) != 0 ||
+        heap_truncate_find_FKs(list_make1_oid(RelationGetRelid(rel))) != NIL)
+        return false;
+
+    initStringInfo(&cmd);
+    appendStringInfo(&cmd, "SELECT pg_catalog.pg_table_size(%u)::pg_catalog.text", lrel->remoteid);
+    tableBytes = DatumGetInt64(DirectFunctionCall1(int8in, CStringGetDatum(fetch_remote_text(cmd.data,
+        "table size"))));
+    if (tableBytes < (int64)u_sess->attr.attr_storage.min_parallel_sync_table_size * 1024) {
+        pfree(cmd.data);
+        return false;
+    }
+
+    partitions = fetch_remote_partitions(lrel);
+    if (list_length(partitions) > 1) {
+        nranges = list_length(partitions);
+    } else {
+        list_free_deep(partitions);
+        partitions = NIL;
+
+        /* Without partitions, only a key the publisher can read in ranges through its index will do. */
+        keyName = fetch_remote_int_key(lrel);
+        if (keyName == NULL) {
+            pfree(cmd.data);
+            return false;
+        }
+
+        resetStringInfo(&cmd);
+        appendStringInfo(&cmd, "SELECT COALESCE(pg_catalog.min(%s)::pg_catalog.int8, 0)::pg_catalog.text FROM %s",
+            quote_identifier(keyName), quote_qualified_identifier(lrel->nspname, lrel->relname));
+        minKey = DatumGetInt64(DirectFunctionCall1(int8in, CStringGetDatum(fetch_remote_text(cmd.data, "key range"))));
+        resetStringInfo(&cmd);
+        appendStringInfo(&cmd, "SELECT COALESCE(pg_catalog.max(%s)::pg_catalog.int8, 0)::pg_catalog.text FROM %s",
+            quote_identifier(keyName), quote_qualified_identifier(lrel->nspname, lrel->relname));
+        maxKey = DatumGetInt64(DirectFunctionCall1(int8in, CStringGetDatum(fetch_remote_text(cmd.data, "key range"))));
+
+        /* one range per worker and the sync worker itself, decided once they are started */
+        nranges = maxWorkers + 1;
+    }
+
+    context = AllocSetContextCreate(g_instance.instance_context, "ParallelSyncGroup", ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE, SHARED_CONTEXT);
+    group = (ParallelSyncGroup *)MemoryContextAllocZero(context,
+        offsetof(ParallelSyncGroup, ranges) + nranges * sizeof(ParallelSyncRange));
+    group->context = context;
+    group->relid = RelationGetRelid(rel);
+    ReplicationSlotNameForTablesync(sub->oid, leader->relid, group->slotName, NAMEDATALEN);
+    rc = strcpy_s(group->snapshotName, NAMEDATALEN,
+        fetch_remote_text("SELECT pg_catalog.pg_export_snapshot()", "exported snapshot"));
+    securec_check(rc, "", "");
+    group->byPartition = (partitions != NIL);
+    if (keyName != NULL)
+        (void)namestrcpy(&group->keyName, keyName);
+    group->binary = sub->binary;
+    pg_atomic_init_u32(&group->nextRange, 0);
+    pg_atomic_init_u64(&group->rowsCopied, 0);
+    SpinLockInit(&group->mutex);
+    group->leaderProc = t_thrd.proc;
+    foreach (lc, partitions) {
+        rc = strcpy_s(NameStr(group->ranges[npartitions++].partName), NAMEDATALEN, (char *)lfirst(lc));
+        securec_check(rc, "", "");
+    }
+
+    parallel_sync_create_marker(sub->oid, leader->relid);
+    t_thrd.applyworker_cxt.parallelSyncGroup = group;
+    on_shmem_exit(ParallelSyncLeaderOnExit, (Datum)0);
+
+    for (int i = 0; i < maxWorkers && i < nranges - 1; i++) {
+        if (!logicalrep_worker_launch(leader->dbid, sub->oid, sub->name, leader->userid, InvalidOid, NULL, -1, group))
+            break;
+        nworkers++;
+    }
+
+    if (nworkers == 0) {
+        ParallelSyncLeaderOnExit(0, (Datum)0);
+        (void)parallel_sync_remove_marker(sub->oid, leader->relid);
+        list_free_deep(partitions);
+        pfree(cmd.data);
+        return false;
+    }
+
+    if (!group->byPartition) {
+        /* unsigned, so that the whole int64 span can't overflow */
+        uint64 perRange;
+
+        nranges = nworkers + 1;
+        perRange = ((uint64)maxKey - (uint64)minKey) / (uint64)nranges;
+        for (int i = 0; i < nranges; i++) {
+            ParallelSyncRange *range = &group->ranges[i];
+
+            /* the first and the last range are open, so no key is missed */
+            range->hasLower = (i > 0);
+            range->lower = (int64)((uint64)minKey + perRange * (uint64)i);
+            range->hasUpper = (i < nranges - 1);
+            range->upper = (int64)((uint64)minKey + perRange * (uint64)(i + 1));
+        }
+    }
+
+    SpinLockAcquire(&group->mutex);
+    group->nranges = nranges;
+    SpinLockRelease(&group->mutex);
+
+    ereport(LOG, (errmsg("logical replication table synchronization for subscription \"%s\", table \"%s\" copies "
+        "%d %s with %d parallel sync workers", sub->name, RelationGetRelationName(rel), nranges,
+        group->byPartition ? "partitions" : "key ranges", nworkers)));
+
+    parallel_sync_copy_ranges(group, relmapentry, attnamelist);
+
+    /* wait for the workers to commit their share */
+    for (;;) {
+        bool done = false;
+
+        SpinLockAcquire(&group->mutex);
+        group->closed = true;
+        done = (group->nexited == group->nstarted);
+        nsucceeded = group->nsucceeded;
+        failed = group->failed || (done && nsucceeded < group->nstarted);
+        SpinLockRelease(&group->mutex);
+
+        if (failed)
+            ereport(ERROR, (errmsg("logical replication parallel sync worker for subscription \"%s\" exited "
+                "unexpectedly", sub->name)));
+        if (done)
+            break;
+
+        parallel_sync_wait(PARALLEL_SYNC_NAPTIME);
+    }
+
+    ereport(LOG, (errmsg("logical replication table synchronization for subscription \"%s\", table \"%s\" copied "
+        UINT64_FORMAT " rows with %d parallel sync workers", sub->name, RelationGetRelationName(rel),
+        pg_atomic_read_u64(&group->rowsCopied), nsucceeded)));
+
+    ParallelSyncLeaderOnExit(0, (Datum)0);
+    list_free_deep(partitions);
+    pfree(cmd.data);
+    return true;
+}
+
+static void ParallelSyncWorkerOnExit(int code, Datum arg)
+{
+    ParallelSyncGroup *group = t_thrd.applyworker_cxt.curWorker->syncGroup;
+    PGPROC *leader = NULL;
+
+    SpinLockAcquire(&group->mutex);
+    group->nexited++;
+    if (code != 0)
+        group->failed = true;
+    leader = group->leaderProc;
+    SpinLockRelease(&group->mutex);
+
+    SetLatch(&leader->procLatch);
+}
+
+/*
+ * Main routine of a parallel sync worker, which copies a share of a table
+ * for a table sync worker, under the snapshot exported by it.
+ */
+void ParallelSyncWorkerMain(void)
+{
+    ParallelSyncGroup *group = t_thrd.applyworker_cxt.curWorker->syncGroup;
+    LogicalRepRelMapEntry *relmapentry = NULL;
+    LogicalRepRelation lrel;
+    WalRcvExecResult *res;
+    StringInfoData cmd;
+    Relation rel;
+    PGPROC *leader = NULL;
+
+    SpinLockAcquire(&group->mutex);
+    if (group->shutdown || group->closed) {
+        SpinLockRelease(&group->mutex);
+        proc_exit(0);
+    }
+    group->nstarted++;
+    SpinLockRelease(&group->mutex);
+
+    on_shmem_exit(ParallelSyncWorkerOnExit, (Datum)0);
+
+    if (!AttemptConnectPublisher(t_thrd.applyworker_cxt.mySubscription->conninfo, group->slotName, true)) {
+        ereport(ERROR, (errmsg("could not connect to the publisher: %s",
+                               PQerrorMessage(t_thrd.libwalreceiver_cxt.streamConn))));
+    }
+
+    /* See the same data as the sync worker. */
+    res = (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_exec("BEGIN READ ONLY ISOLATION LEVEL "
+                                                           "REPEATABLE READ",
+                                                           0, NULL);
+    if (res->status != WALRCV_OK_COMMAND)
+        ereport(ERROR, (errmsg("table copy could not start transaction on publisher"),
+            errdetail("The error was: %s", res->err)));
+    walrcv_clear_result(res);
+
+    initStringInfo(&cmd);
+    appendStringInfo(&cmd, "SET TRANSACTION SNAPSHOT %s", quote_literal_cstr(group->snapshotName));
+    res = (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_exec(cmd.data, 0, NULL);
+    if (res->status != WALRCV_OK_COMMAND)
+        ereport(ERROR, (errmsg("table copy could not import snapshot on publisher"),
+            errdetail("The error was: %s", res->err)));
+    walrcv_clear_result(res);
+    pfree(cmd.data);
+
+    /* The sync worker hands out the ranges once it knows how many workers it got. */
+    for (;;) {
+        int nranges;
+
+        SpinLockAcquire(&group->mutex);
+        nranges = group->nranges;
+        SpinLockRelease(&group->mutex);
+        if (nranges > 0)
+            break;
+        if (group->shutdown || group->failed)
+            proc_exit(0);
+        parallel_sync_wait(PARALLEL_SYNC_NAPTIME);
+    }
+
+    pgstat_report_activity(STATE_RUNNING, NULL);
+
+    StartTransactionCommand();
+    rel = heap_open(group->relid, RowExclusiveLock);
+
+    fetch_remote_table_info(get_namespace_name(RelationGetNamespace(rel)), RelationGetRelationName(rel), &lrel);
+    logicalrep_relmap_update(&lrel);
+    relmapentry = logicalrep_rel_open(lrel.remoteid, NoLock);
+    Assert(rel == relmapentry->localrel);
+
+    PushActiveSnapshot(GetTransactionSnapshot());
+    parallel_sync_copy_ranges(group, relmapentry, make_copy_attnamelist(relmapentry));
+    PopActiveSnapshot();
+
+    logicalrep_rel_close(relmapentry, NoLock);
+    heap_close(rel, NoLock);
+
+    res = (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_exec("COMMIT", 0, NULL);
+    if (res->status != WALRCV_OK_COMMAND)
+        ereport(ERROR, (errmsg("table copy could not finish transaction on publisher"),
+            errdetail("The error was: %s", res->err)));
+    walrcv_clear_result(res);
+
+    CommitTransactionCommand();
+    pgstat_report_stat(false);
+
+    SpinLockAcquire(&group->mutex);
+    group->nsucceeded++;
+    leader = group->leaderProc;
+    SpinLockRelease(&group->mutex);
+    SetLatch(&leader->procLatch);
+
+    (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_disconnect();
+}
+
 /*
  * Copy existing data of a table from publisher.
  *
@@ -762,6 +1428,12 @@ static void copy_table(Relation rel)
     relmapentry = logicalrep_rel_open(lrel.remoteid, NoLock);
     Assert(rel == relmapentry->localrel);
 
+    attnamelist = make_copy_attnamelist(relmapentry);
+    if (copy_table_parallel(rel, relmapentry, attnamelist)) {
+        logicalrep_rel_close(relmapentry, NoLock);
+        return;
+    }
+
     /* Start copy on the publisher. */
     initStringInfo(&cmd);
     appendStringInfo(&cmd, "COPY %s TO STDOUT", quote_qualified_identifier(lrel.nspname, lrel.relname));
@@ -775,7 +1447,6 @@ static void copy_table(Relation rel)
     t_thrd.applyworker_cxt.copybuf = makeStringInfo();
 
     /* Create CopyState for ingestion of the data from publisher. */
-    attnamelist = make_copy_attnamelist(relmapentry);
     cstate = BeginCopyFrom(rel, NULL, attnamelist, NIL, &mem_info, (const char*)cmd.data, copy_read_data);
 
     /* Do the copy */
@@ -860,6 +1531,14 @@ char *LogicalRepSyncTableStart(XLogRecPtr *origin_startpos)
         StartTransactionCommand();
         ReplicationSlotDropAtPubNode(slotname, true);
         CommitTransactionCommand();
+
+        /* Parallel sync workers may have committed parts of the table. */
+        if (parallel_sync_marker_exists(t_thrd.applyworker_cxt.mySubscription->oid,
+                                        t_thrd.applyworker_cxt.curWorker->relid)) {
+            parallel_sync_truncate_table(t_thrd.applyworker_cxt.curWorker->relid);
+            (void)parallel_sync_remove_marker(t_thrd.applyworker_cxt.mySubscription->oid,
+                                              t_thrd.applyworker_cxt.curWorker->relid);
+        }
     } else if (t_thrd.applyworker_cxt.curWorker->relstate == SUBREL_STATE_FINISHEDCOPY) {
         /*
          * The COPY phase was previously done, but tablesync then crashed
@@ -872,12 +1551,16 @@ char *LogicalRepSyncTableStart(XLogRecPtr *origin_startpos)
          * time this tablesync was launched.
          */
         originid = replorigin_by_name(originname, false);
-        replorigin_session_setup(originid);
+        replorigin_session_setup(originid, 0);
         u_sess->reporigin_cxt.originId = originid;
         *origin_startpos = replorigin_session_get_progress(false);
 
         CommitTransactionCommand();
 
+        /* The copy is committed, whoever took part in it. */
+        (void)parallel_sync_remove_marker(t_thrd.applyworker_cxt.mySubscription->oid,
+                                          t_thrd.applyworker_cxt.curWorker->relid);
+
         goto copy_table_done;
     }
 
@@ -951,7 +1634,7 @@ char *LogicalRepSyncTableStart(XLogRecPtr *origin_startpos)
         replorigin_advance(originid, *origin_startpos, InvalidXLogRecPtr, true /* go backward */, true /* WAL log */);
         UnlockRelationOid(ReplicationOriginRelationId, RowExclusiveLock);
 
-        replorigin_session_setup(originid);
+        replorigin_session_setup(originid, 0);
         u_sess->reporigin_cxt.originId = originid;
     } else {
         ereport(ERROR,
@@ -986,6 +1669,9 @@ char *LogicalRepSyncTableStart(XLogRecPtr *origin_startpos)
 
     CommitTransactionCommand();
 
+    (void)parallel_sync_remove_marker(t_thrd.applyworker_cxt.mySubscription->oid,
+                                      t_thrd.applyworker_cxt.curWorker->relid);
+
 copy_table_done:
 
     ereport(DEBUG1, (errmsg("LogicalRepSyncTableStart: '%s' origin_startpos lsn %X/%X", originname,
@@ -75,6 +75,7 @@
 #include "rewrite/rewriteHandler.h"
 
 #include "storage/buf/bufmgr.h"
+#include "storage/buf/buffile.h"
 #include "storage/ipc.h"
 #include "storage/lmgr.h"
 #include "storage/proc.h"
@@ -108,8 +109,27 @@ typedef struct SlotErrCallbackArg {
     int remote_attnum;
 } SlotErrCallbackArg;
 
+/* Spool position of the first change of a subtransaction of a streamed transaction */
+typedef struct StreamSubXact {
+    TransactionId xid;
+    int fileno;
+    off_t offset;
+} StreamSubXact;
+
+/*
+ * Changes received so far for a streamed in-progress transaction. They are
+ * applied from the spool file once the transaction commits.
+ */
+typedef struct StreamXactEntry {
+    TransactionId xid;        /* toplevel xid, hash key */
+    BufFile *file;            /* spooled messages, each prefixed by its length */
+    List *subxacts;           /* StreamSubXact, in order of their first change */
+    TransactionId lastSubXid; /* xid of the last spooled change */
+} StreamXactEntry;
+
 static void send_feedback(XLogRecPtr recvpos, bool force, bool requestReply);
-static void store_flush_position(XLogRecPtr remote_lsn);
+static void store_flush_position(XLogRecPtr remote_lsn, XLogRecPtr local_lsn);
+static void parallel_apply_drain(void);
 static void reread_subscription(void);
 static void ApplyWorkerProcessMsg(char type, StringInfo s, XLogRecPtr *lastRcv);
 static void apply_dispatch(StringInfo s);
@@ -478,9 +498,33 @@ static void apply_handle_begin(StringInfo s)
     t_thrd.applyworker_cxt.remoteFinalLsn = begin_data.final_lsn;
     t_thrd.applyworker_cxt.curRemoteCsn = begin_data.csn;
 
+    /*
+     * Collect the changes for a parallel apply worker instead of applying them
+     * here, unless some table is syncing.
+     */
+    if (t_thrd.applyworker_cxt.parallelApplyGroup != NULL) {
+        if (t_thrd.applyworker_cxt.tableStatesValid && t_thrd.applyworker_cxt.tableStates == NIL)
+            ParallelApplyBeginTxn(begin_data.final_lsn, begin_data.csn);
+        else
+            parallel_apply_drain();
+    }
+
     pgstat_report_activity(STATE_RUNNING, NULL);
 }
 
+/*
+ * Table synchronization expects everything received so far to be applied, so
+ * let the parallel apply workers finish first while some table is syncing.
+ */
+static void process_syncing_tables_for_leader(XLogRecPtr current_lsn)
+{
+    if (t_thrd.applyworker_cxt.parallelApplyGroup != NULL &&
+        (!t_thrd.applyworker_cxt.tableStatesValid || t_thrd.applyworker_cxt.tableStates != NIL))
+        parallel_apply_drain();
+
+    process_syncing_tables(current_lsn);
+}
+
 /*
  * Handle COMMIT message.
  */
@@ -492,7 +536,9 @@ static void apply_handle_commit(StringInfo s)
 
     Assert(commit_data.commit_lsn == t_thrd.applyworker_cxt.remoteFinalLsn);
 
-    if (IsTransactionState()) {
+    if (ParallelApplyInTxn()) {
+        ParallelApplyCommitTxn(commit_data.end_lsn, commit_data.committime);
+    } else if (IsTransactionState()) {
         /*
          * Update origin state so we can restart streaming from correct
          * position in case of crash.
@@ -502,13 +548,13 @@ static void apply_handle_commit(StringInfo s)
 
         CommitTransactionCommand();
         pgstat_report_stat(false);
-        store_flush_position(commit_data.end_lsn);
+        store_flush_position(commit_data.end_lsn, t_thrd.xlog_cxt.XactLastCommitEnd);
     }
 
     t_thrd.applyworker_cxt.inRemoteTransaction = false;
 
     /* Process any tables that are being synchronized in parallel. */
-    process_syncing_tables(commit_data.end_lsn);
+    process_syncing_tables_for_leader(commit_data.end_lsn);
 
     pgstat_report_activity(STATE_IDLE, NULL);
 }
@@ -540,6 +586,10 @@ static void apply_handle_relation(StringInfo s)
 
     rel = logicalrep_read_rel(s);
     logicalrep_relmap_update(rel);
+
+    /* Every parallel apply worker keeps its own relation map. */
+    if (t_thrd.applyworker_cxt.parallelApplyGroup != NULL)
+        ParallelApplyAddRelation(s);
 }
 
 /*
@@ -554,6 +604,338 @@ static void apply_handle_type(StringInfo s)
     logicalrep_read_typ(s, &typ);
 }
 
+/*
+ * Find the spool of a streamed transaction, or start a new one if 'create'
+ * is set; a stale spool of the same transaction is thrown away then.
+ */
+static StreamXactEntry *stream_xact_lookup(TransactionId xid, bool create)
+{
+    StreamXactEntry *ent = NULL;
+    bool found = false;
+    MemoryContext oldctx;
+
+    if (t_thrd.applyworker_cxt.streamXacts == NULL) {
+        HASHCTL ctl;
+        int rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+        securec_check(rc, "", "");
+
+        if (!create)
+            return NULL;
+
+        ctl.keysize = sizeof(TransactionId);
+        ctl.entrysize = sizeof(StreamXactEntry);
+        ctl.hcxt = t_thrd.applyworker_cxt.applyContext;
+        t_thrd.applyworker_cxt.streamXacts = hash_create("logical replication streamed transactions", 16, &ctl,
+            HASH_ELEM | HASH_CONTEXT | HASH_BLOBS);
+    }
+
+    ent = (StreamXactEntry *)hash_search(t_thrd.applyworker_cxt.streamXacts, &xid,
+        create ? HASH_ENTER : HASH_FIND, &found);
+    if (!create)
+        return ent;
+
+    if (found) {
+        BufFileClose(ent->file);
+        list_free_deep(ent->subxacts);
+    }
+
+    /* the spool outlives the local transactions of the apply worker */
+    oldctx = MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+    ent->file = BufFileCreateTemp(true);
+    MemoryContextSwitchTo(oldctx);
+    ent->subxacts = NIL;
+    ent->lastSubXid = InvalidTransactionId;
+    return ent;
+}
+
+/*
+ * Throw away the spool of a streamed transaction.
+ */
+static void stream_xact_discard(StreamXactEntry *ent)
+{
+    TransactionId xid = ent->xid;
+
+    BufFileClose(ent->file);
+    list_free_deep(ent->subxacts);
+    (void)hash_search(t_thrd.applyworker_cxt.streamXacts, &xid, HASH_REMOVE, NULL);
+}
+
+static void stream_spool_write(BufFile *file, void *ptr, size_t size)
+{
+    if (BufFileWrite(file, ptr, size) != size)
+        ereport(ERROR, (errcode_for_file_access(),
+            errmsg("could not write to streamed transaction spool file: %m")));
+}
+
+static void stream_spool_read(BufFile *file, void *ptr, size_t size)
+{
+    if (BufFileRead(file, ptr, size) != size)
+        ereport(ERROR, (errcode_for_file_access(),
+            errmsg("could not read from streamed transaction spool file: %m")));
+}
+
+/*
+ * Spool a change received between STREAM START and STREAM STOP, instead of
+ * applying it.
+ *
+ * Returns false if the message is not part of a streamed transaction.
+ */
+static bool handle_streamed_change(char action, StringInfo s)
+{
+    StreamXactEntry *ent = NULL;
+    TransactionId xid;
+    int len;
+
+    if (!t_thrd.applyworker_cxt.inStreamedTransaction)
+        return false;
+
+    switch (action) {
+        case 'I':
+        case 'U':
+        case 'D':
+        case 'R':
+        case 'Y':
+            break;
+        default:
+            return false;
+    }
+
+    /* the (sub)transaction the change belongs to */
+    xid = pq_getmsgint64(s);
+
+    ent = stream_xact_lookup(t_thrd.applyworker_cxt.streamXid, false);
+    Assert(ent != NULL);
+
+    /* remember where the changes of a subtransaction start, in case it aborts */
+    if (xid != ent->xid && xid != ent->lastSubXid) {
+        ListCell *lc = NULL;
+        bool known = false;
+
+        foreach (lc, ent->subxacts) {
+            if (((StreamSubXact *)lfirst(lc))->xid == xid) {
+                known = true;
+                break;
+            }
+        }
+        if (!known) {
+            MemoryContext oldctx = MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+            StreamSubXact *subxact = (StreamSubXact *)palloc(sizeof(StreamSubXact));
+
+            subxact->xid = xid;
+            BufFileTell(ent->file, &subxact->fileno, &subxact->offset);
+            ent->subxacts = lappend(ent->subxacts, subxact);
+            MemoryContextSwitchTo(oldctx);
+        }
+    }
+    ent->lastSubXid = xid;
+
+    /* the message as it would have been sent outside a stream */
+    len = s->len - s->cursor + 1;
+    stream_spool_write(ent->file, &len, sizeof(len));
+    stream_spool_write(ent->file, &action, sizeof(action));
+    stream_spool_write(ent->file, &s->data[s->cursor], s->len - s->cursor);
+    s->cursor = s->len;
+
+    return true;
+}
+
+/*
+ * Handle STREAM START message.
+ */
+static void apply_handle_stream_start(StringInfo s)
+{
+    bool first_segment = false;
+    TransactionId xid;
+
+    if (t_thrd.applyworker_cxt.inStreamedTransaction || t_thrd.applyworker_cxt.inRemoteTransaction)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("STREAM START message sent out of order")));
+
+    xid = logicalrep_read_stream_start(s, &first_segment);
+    if (!TransactionIdIsValid(xid))
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+            errmsg("invalid transaction ID in streamed replication transaction")));
+
+    if (stream_xact_lookup(xid, first_segment) == NULL)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+            errmsg("STREAM START message for unknown transaction %lu", xid)));
+
+    t_thrd.applyworker_cxt.inStreamedTransaction = true;
+    t_thrd.applyworker_cxt.streamXid = xid;
+
+    pgstat_report_activity(STATE_RUNNING, NULL);
+}
+
+/*
+ * Handle STREAM STOP message.
+ */
+static void apply_handle_stream_stop(StringInfo s)
+{
+    if (!t_thrd.applyworker_cxt.inStreamedTransaction)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("STREAM STOP message without STREAM START")));
+
+    t_thrd.applyworker_cxt.inStreamedTransaction = false;
+    t_thrd.applyworker_cxt.streamXid = InvalidTransactionId;
+
+    pgstat_report_activity(STATE_IDLE, NULL);
+}
+
+/*
+ * Handle STREAM ABORT message.
+ *
+ * Either the whole spool is thrown away, or it is cut back to the first
+ * change of the aborted subtransaction: everything spooled after that
+ * belongs to it or to its own subtransactions.
+ */
+static void apply_handle_stream_abort(StringInfo s)
+{
+    TransactionId xid;
+    TransactionId subxid;
+    StreamXactEntry *ent = NULL;
+    ListCell *lc = NULL;
+    int nkeep = 0;
+
+    if (t_thrd.applyworker_cxt.inStreamedTransaction)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("STREAM ABORT message without STREAM STOP")));
+
+    logicalrep_read_stream_abort(s, &xid, &subxid);
+
+    /* nothing of it was spooled */
+    ent = stream_xact_lookup(xid, false);
+    if (ent == NULL)
+        return;
+
+    if (subxid == xid) {
+        stream_xact_discard(ent);
+        return;
+    }
+
+    foreach (lc, ent->subxacts) {
+        StreamSubXact *subxact = (StreamSubXact *)lfirst(lc);
+
+        if (subxact->xid == subxid) {
+            if (BufFileSeek(ent->file, subxact->fileno, subxact->offset, SEEK_SET) != 0)
+                ereport(ERROR, (errcode_for_file_access(),
+                    errmsg("could not seek in streamed transaction spool file: %m")));
+
+            while (list_length(ent->subxacts) > nkeep) {
+                pfree(llast(ent->subxacts));
+                ent->subxacts = list_truncate(ent->subxacts, list_length(ent->subxacts) - 1);
+            }
+            ent->lastSubXid = InvalidTransactionId;
+            break;
+        }
+        nkeep++;
+    }
+}
+
+/*
+ * Apply the spooled changes of a streamed transaction, up to the current
+ * spool position; anything after it was cut off by a subtransaction abort.
+ */
+static void stream_apply_spooled(StreamXactEntry *ent)
+{
+    int endFileno;
+    off_t endOffset;
+    int fileno;
+    off_t offset;
+    StringInfoData buf;
+    MemoryContext oldctx;
+    uint64 nchanges = 0;
+
+    BufFileTell(ent->file, &endFileno, &endOffset);
+    if (BufFileSeek(ent->file, 0, 0, SEEK_SET) != 0)
+        ereport(ERROR, (errcode_for_file_access(),
+            errmsg("could not seek in streamed transaction spool file: %m")));
+
+    oldctx = MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+    initStringInfo(&buf);
+    MemoryContextSwitchTo(oldctx);
+
+    for (;;) {
+        int len;
+
+        BufFileTell(ent->file, &fileno, &offset);
+        if (fileno > endFileno || (fileno == endFileno && offset >= endOffset))
+            break;
+
+        CHECK_FOR_INTERRUPTS();
+
+        stream_spool_read(ent->file, &len, sizeof(len));
+        if (len <= 0)
+            ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED),
+                errmsg("invalid message length %d in streamed transaction spool file", len)));
+
+        resetStringInfo(&buf);
+        enlargeStringInfo(&buf, len);
+        stream_spool_read(ent->file, buf.data, len);
+        buf.len = len;
+        buf.data[len] = '\0';
+        buf.cursor = 0;
+
+        MemoryContextSwitchTo(t_thrd.applyworker_cxt.messageContext);
+        apply_dispatch(&buf);
+        MemoryContextReset(t_thrd.applyworker_cxt.messageContext);
+        nchanges++;
+    }
+
+    pfree(buf.data);
+
+    ereport(DEBUG1, (errmsg("applied " UINT64_FORMAT " spooled messages of streamed transaction %lu",
+        nchanges, ent->xid)));
+}
+
+/*
+ * Handle STREAM COMMIT message.
+ */
+static void apply_handle_stream_commit(StringInfo s)
+{
+    TransactionId xid;
+    LogicalRepCommitData commit_data;
+    StreamXactEntry *ent = NULL;
+
+    if (t_thrd.applyworker_cxt.inStreamedTransaction)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("STREAM COMMIT message without STREAM STOP")));
+
+    xid = logicalrep_read_stream_commit(s, &commit_data);
+
+    ent = stream_xact_lookup(xid, false);
+    if (ent == NULL)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+            errmsg("STREAM COMMIT message for unknown transaction %lu", xid)));
+
+    /* transactions handed to the parallel apply workers committed before */
+    if (t_thrd.applyworker_cxt.parallelApplyGroup != NULL)
+        parallel_apply_drain();
+
+    t_thrd.applyworker_cxt.inRemoteTransaction = true;
+    t_thrd.applyworker_cxt.remoteFinalLsn = commit_data.commit_lsn;
+    t_thrd.applyworker_cxt.curRemoteCsn = InvalidCommitSeqNo;
+    pgstat_report_activity(STATE_RUNNING, NULL);
+
+    stream_apply_spooled(ent);
+
+    if (IsTransactionState()) {
+        /*
+         * Update origin state so we can restart streaming from correct
+         * position in case of crash.
+         */
+        u_sess->reporigin_cxt.originTs = commit_data.committime;
+        u_sess->reporigin_cxt.originLsn = commit_data.end_lsn;
+
+        CommitTransactionCommand();
+        pgstat_report_stat(false);
+        store_flush_position(commit_data.end_lsn, t_thrd.xlog_cxt.XactLastCommitEnd);
+    }
+
+    t_thrd.applyworker_cxt.inRemoteTransaction = false;
+    stream_xact_discard(ent);
+
+    /* Process any tables that are being synchronized in parallel. */
+    process_syncing_tables_for_leader(commit_data.end_lsn);
+
+    pgstat_report_activity(STATE_IDLE, NULL);
+}
+
 /*
  * Get replica identity index or if it is not defined a primary key.
  *
@@ -570,6 +952,26 @@ static Oid GetRelationIdentityOrPK(Relation rel)
     return idxoid;
 }
 
+/*
+ * Hand a change over to the parallel apply workers.
+ *
+ * Returns false if the change has to be applied here, either because we apply
+ * serially or because its transaction grew too large to be buffered; the
+ * latter is then applied here once the parallel apply workers are done.
+ */
+static bool parallel_apply_change(StringInfo s)
+{
+    if (!ParallelApplyInTxn())
+        return false;
+
+    if (ParallelApplyAddChange(s))
+        return true;
+
+    parallel_apply_drain();
+    ParallelApplySerializeTxn();
+    return false;
+}
+
 /*
  * Handle INSERT message.
  */
@@ -583,6 +985,9 @@ static void apply_handle_insert(StringInfo s)
     MemoryContext oldctx;
     FakeRelationPartition fakeRelInfo;
 
+    if (parallel_apply_change(s))
+        return;
+
     ensure_transaction();
 
     relid = logicalrep_read_insert(s, &newtup);
@@ -706,6 +1111,9 @@ static void apply_handle_update(StringInfo s)
     MemoryContext oldctx;
     FakeRelationPartition fakeRelInfo;
 
+    if (parallel_apply_change(s))
+        return;
+
     ensure_transaction();
 
     relid = logicalrep_read_update(s, &has_oldtup, &oldtup, &newtup);
@@ -824,6 +1232,9 @@ static void apply_handle_delete(StringInfo s)
     MemoryContext oldctx;
     FakeRelationPartition fakeRelInfo;
 
+    if (parallel_apply_change(s))
+        return;
+
     ensure_transaction();
 
     relid = logicalrep_read_delete(s, &oldtup);
@@ -896,6 +1307,10 @@ static void apply_dispatch(StringInfo s)
 {
     char action = pq_getmsgbyte(s);
 
+    /* changes of a streamed in-progress transaction are spooled */
+    if (handle_streamed_change(action, s))
+        return;
+
     switch (action) {
         /* BEGIN */
         case 'B':
@@ -932,12 +1347,42 @@ static void apply_dispatch(StringInfo s)
         case 'S':
             apply_handle_conninfo(s);
             break;
+        /* STREAM START */
+        case 's':
+            apply_handle_stream_start(s);
+            break;
+        /* STREAM END */
+        case 'e':
+            apply_handle_stream_stop(s);
+            break;
+        /* STREAM ABORT */
+        case 'a':
+            apply_handle_stream_abort(s);
+            break;
+        /* STREAM COMMIT */
+        case 'c':
+            apply_handle_stream_commit(s);
+            break;
         default:
             ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
                 errmsg("invalid logical replication message type \"%c\"", action)));
     }
 }
 
+/*
+ * Apply a protocol message buffered by the leader apply worker.
+ */
+void ApplyWorkerDispatchMessage(char *data, int len)
+{
+    StringInfoData s;
+
+    s.data = data;
+    s.len = len;
+    s.cursor = 0;
+    s.maxlen = -1;
+    apply_dispatch(&s);
+}
+
 /*
  * Figure out which write/flush positions to report to the walsender process.
  *
@@ -988,7 +1433,7 @@ static void get_flush_position(XLogRecPtr *write, XLogRecPtr *flush, bool *have_
 /*
  * Store current remote/local lsn pair in the tracking list.
  */
-static void store_flush_position(XLogRecPtr remote_lsn)
+static void store_flush_position(XLogRecPtr remote_lsn, XLogRecPtr local_lsn)
 {
     FlushPosition *flushpos;
 
@@ -997,13 +1442,38 @@ static void store_flush_position(XLogRecPtr remote_lsn)
 
     /* Track commit lsn  */
     flushpos = (FlushPosition *)palloc(sizeof(FlushPosition));
-    flushpos->local_end = t_thrd.xlog_cxt.XactLastCommitEnd;
+    flushpos->local_end = local_lsn;
     flushpos->remote_end = remote_lsn;
 
     dlist_push_tail(&t_thrd.applyworker_cxt.lsnMapping, &flushpos->node);
     MemoryContextSwitchTo(t_thrd.applyworker_cxt.messageContext);
 }
 
+/*
+ * Track the commits of the parallel apply workers, which happen in remote
+ * commit order, like our own.
+ */
+static void parallel_apply_collect(void)
+{
+    XLogRecPtr remoteEnd;
+    XLogRecPtr localEnd;
+
+    while (ParallelApplyPopCommitted(&remoteEnd, &localEnd)) {
+        MemoryContext oldctx = CurrentMemoryContext;
+        store_flush_position(remoteEnd, localEnd);
+        MemoryContextSwitchTo(oldctx);
+    }
+}
+
+/*
+ * Wait until the parallel apply workers committed everything handed to them.
+ */
+static void parallel_apply_drain(void)
+{
+    ParallelApplyWaitAll();
+    parallel_apply_collect();
+}
+
 
 /* Update statistics of the worker. */
 static void UpdateWorkerStats(XLogRecPtr last_lsn, TimestampTz send_time, bool reply)
@@ -1172,7 +1642,7 @@ static void LogicalRepApplyLoop(XLogRecPtr last_received)
                 reread_subscription();
 
             /* Process any table synchronization changes. */
-            process_syncing_tables(last_received);
+            process_syncing_tables_for_leader(last_received);
         }
 
         if (t_thrd.applyworker_cxt.got_SIGHUP) {
@@ -1201,6 +1671,9 @@ static void send_feedback(XLogRecPtr recvpos, bool force, bool requestReply)
     char replybuf[sizeof(StandbyReplyMessage) + 1] = {0};
     StandbyReplyMessage* replyMsg = (StandbyReplyMessage*)(replybuf + 1);
 
+    if (t_thrd.applyworker_cxt.parallelApplyGroup != NULL)
+        parallel_apply_collect();
+
     /*
      * If the user doesn't want status to be reported to the publisher, be
      * sure to exit before doing anything at all.
@@ -1214,6 +1687,10 @@ static void send_feedback(XLogRecPtr recvpos, bool force, bool requestReply)
 
     get_flush_position(&writepos, &flushpos, &have_pending_txes);
 
+    /* Transactions still applied by parallel apply workers are not flushed either. */
+    if (ParallelApplyHasPending())
+        have_pending_txes = true;
+
     /*
      * No outstanding transactions to flush, we can report the latest
      * received position. This is important for synchronous replication.
@@ -1349,7 +1826,8 @@ static void reread_subscription(void)
     * The launcher will start a new worker.
     */
     if (strcmp(newsub->name, t_thrd.applyworker_cxt.mySubscription->name) != 0 ||
-        newsub->binary != t_thrd.applyworker_cxt.mySubscription->binary) {
+        newsub->binary != t_thrd.applyworker_cxt.mySubscription->binary ||
+        newsub->stream != t_thrd.applyworker_cxt.mySubscription->stream) {
             ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" "
                 "will restart because of a parameter change", t_thrd.applyworker_cxt.mySubscription->name)));
             proc_exit(0);
@@ -1481,6 +1959,16 @@ void ApplyWorkerMain()
         /* Now we can allow interrupts again */
         RESUME_INTERRUPTS();
 
+        /*
+         * Transactions in the hands of parallel apply workers can't be matched
+         * with a restarted stream, so leave it to the launcher to start the
+         * leader and its parallel apply workers over. The same goes for a
+         * table copy shared with parallel sync workers.
+         */
+        if (AM_PARALLEL_APPLY_WORKER || t_thrd.applyworker_cxt.parallelApplyGroup != NULL ||
+            AM_PARALLEL_SYNC_WORKER || t_thrd.applyworker_cxt.parallelSyncGroup != NULL)
+            proc_exit(1);
+
         /*
          * Sleep at least 1 second after any error.  We don't want to be
          * filling the error logs as fast as we can.
@@ -1550,12 +2038,30 @@ void ApplyWorkerMain()
     if (AM_TABLESYNC_WORKER)
         ereport(LOG, (errmsg("logical replication table synchronization for subscription %s, table %s has started",
             t_thrd.applyworker_cxt.mySubscription->name, get_rel_name(t_thrd.applyworker_cxt.curWorker->relid))));
+    else if (AM_PARALLEL_APPLY_WORKER)
+        ereport(LOG, (errmsg("logical replication parallel apply worker %d for subscription \"%s\" has started",
+            t_thrd.applyworker_cxt.curWorker->applyGroupIdx, t_thrd.applyworker_cxt.mySubscription->name)));
+    else if (AM_PARALLEL_SYNC_WORKER)
+        ereport(LOG, (errmsg("logical replication parallel sync worker for subscription \"%s\" has started",
+            t_thrd.applyworker_cxt.mySubscription->name)));
     else
         ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" has started",
             t_thrd.applyworker_cxt.mySubscription->name)));
 
     CommitTransactionCommand();
 
+    /* Parallel apply workers get their changes from the leader, not the publisher. */
+    if (AM_PARALLEL_APPLY_WORKER) {
+        ParallelApplyWorkerMain();
+        proc_exit(0);
+    }
+
+    /* Parallel sync workers copy a share of the table of their table sync worker. */
+    if (AM_PARALLEL_SYNC_WORKER) {
+        ParallelSyncWorkerMain();
+        proc_exit(0);
+    }
+
     if (AM_TABLESYNC_WORKER) {
         char *syncslotname;
 
@@ -1578,11 +2084,14 @@ void ApplyWorkerMain()
         originid = replorigin_by_name(originname, true);
         if (!OidIsValid(originid))
             originid = replorigin_create(originname);
-        replorigin_session_setup(originid);
+        replorigin_session_setup(originid, 0);
         u_sess->reporigin_cxt.originId = originid;
         origin_startpos = replorigin_session_get_progress(false);
         CommitTransactionCommand();
 
+        /* Start the parallel apply workers, if configured. */
+        ParallelApplyStart();
+
         if (!AttemptConnectPublisher(t_thrd.applyworker_cxt.mySubscription->conninfo, myslotname, true)) {
             ereport(ERROR, (errcode(ERRCODE_CONNECTION_FAILURE), errmsg("Failed to connect to publisher.")));
         }
@@ -1612,6 +2121,18 @@ void ApplyWorkerMain()
     options.binary = t_thrd.applyworker_cxt.mySubscription->binary;
     options.useSnapshot = AM_TABLESYNC_WORKER;
 
+    /*
+     * With the streaming option the publisher sends large transactions while
+     * they are still in progress, rather than spilling them to disk until
+     * they commit. Only then ask for the protocol version that has it, so
+     * that publishers which predate it keep working. The table sync worker
+     * wants whole transactions to compare their csn.
+     */
+    if (t_thrd.applyworker_cxt.mySubscription->stream && !AM_TABLESYNC_WORKER) {
+        options.protoVersion = LOGICALREP_STREAM_PROTO_VERSION_NUM;
+        options.streaming = true;
+    }
+
     /* Start normal logical streaming replication. */
     (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_startstreaming(&options);
 
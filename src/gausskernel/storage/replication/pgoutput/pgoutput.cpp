@@ -43,6 +43,12 @@ static void pgoutput_abort_txn(LogicalDecodingContext* ctx, ReorderBufferTXN* tx
 static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, Relation rel,
     ReorderBufferChange *change);
 static bool pgoutput_origin_filter(LogicalDecodingContext *ctx, RepOriginId origin_id);
+static void pgoutput_stream_start(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
+static void pgoutput_stream_stop(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
+static void pgoutput_stream_abort(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
+static void pgoutput_stream_commit(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
+static void pgoutput_stream_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, Relation rel,
+    ReorderBufferChange *change);
 
 static List *LoadPublications(List *pubnames);
 static void publication_invalidation_cb(Datum arg, int cacheid, uint32 hashvalue);
@@ -53,11 +59,18 @@ static bool GetConninfo(StringInfoData* standbysInfo);
 typedef struct RelationSyncEntry {
     Oid relid;        /* relation oid */
     bool schema_sent; /* did we send the schema? */
+    /*
+     * Streamed transaction the schema was last sent in. The subscriber only
+     * applies it when that transaction commits, so schema_sent is not set
+     * until then.
+     */
+    TransactionId stream_schema_xid;
     bool replicate_valid;
     PublicationActions pubactions;
 } RelationSyncEntry;
 
 static void init_rel_sync_cache(MemoryContext decoding_context);
+static void cleanup_rel_sync_cache(TransactionId xid, bool is_commit);
 static RelationSyncEntry *get_rel_sync_entry(PGOutputData *data, Oid relid);
 static void rel_sync_cache_relation_cb(Datum arg, Oid relid);
 static void rel_sync_cache_publication_cb(Datum arg, int cacheid, uint32 hashvalue);
@@ -76,6 +89,13 @@ void _PG_output_plugin_init(OutputPluginCallbacks *cb)
     cb->abort_cb = pgoutput_abort_txn;
     cb->filter_by_origin_cb = pgoutput_origin_filter;
     cb->shutdown_cb = pgoutput_shutdown;
+
+    /* transaction streaming */
+    cb->stream_start_cb = pgoutput_stream_start;
+    cb->stream_stop_cb = pgoutput_stream_stop;
+    cb->stream_abort_cb = pgoutput_stream_abort;
+    cb->stream_commit_cb = pgoutput_stream_commit;
+    cb->stream_change_cb = pgoutput_stream_change;
 }
 
 static void parse_output_parameters(List *options, PGOutputData *data)
@@ -85,8 +105,10 @@ static void parse_output_parameters(List *options, PGOutputData *data)
     bool publication_names_given = false;
     bool binary_option_given = false;
     bool use_snapshot_given = false;
+    bool streaming_given = false;
 
     data->binary = false;
+    data->streaming = false;
 
     foreach (lc, options) {
         DefElem *defel = (DefElem *)lfirst(lc);
@@ -128,6 +150,12 @@ static void parse_output_parameters(List *options, PGOutputData *data)
             use_snapshot_given = true;
 
             t_thrd.walsender_cxt.isUseSnapshot = true;
+        } else if (strcmp(defel->defname, "streaming") == 0) {
+            if (streaming_given)
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("conflicting or redundant options")));
+            streaming_given = true;
+
+            data->streaming = defGetBoolean(defel);
         } else
             elog(ERROR, "unrecognized pgoutput option: %s", defel->defname);
     }
@@ -172,6 +200,22 @@ static void pgoutput_startup(LogicalDecodingContext *ctx, OutputPluginOptions *o
         if (list_length(data->publication_names) < 1)
             ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("publication_names parameter missing")));
 
+        /*
+         * Decide whether to enable streaming. It is disabled by default, in
+         * which case we just update the flag in decoding context. Otherwise
+         * we only allow it with sufficient version of the protocol, and when
+         * the output plugin supports it.
+         */
+        if (!data->streaming)
+            ctx->streaming = false;
+        else if (data->protocol_version < LOGICALREP_STREAM_PROTO_VERSION_NUM)
+            ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("requested proto_version=%d does not support streaming, need %d or higher",
+                data->protocol_version, LOGICALREP_STREAM_PROTO_VERSION_NUM)));
+        else if (!ctx->streaming)
+            ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("streaming requested, but not supported by output plugin")));
+
         /* Init publication state. */
         data->publications = NIL;
         t_thrd.publication_cxt.publications_valid = false;
@@ -183,6 +227,9 @@ static void pgoutput_startup(LogicalDecodingContext *ctx, OutputPluginOptions *o
 
         /* Initialize relation schema cache. */
         init_rel_sync_cache(THREAD_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_DEFAULT));
+    } else {
+        /* Disable the streaming during the slot initialization mode. */
+        ctx->streaming = false;
     }
 }
 
@@ -223,6 +270,8 @@ static void pgoutput_begin_txn(LogicalDecodingContext *ctx, ReorderBufferTXN *tx
     OutputPluginWrite(ctx, true);
 }
 
+static void MaybeSendConninfo(LogicalDecodingContext *ctx);
+
 /*
  * COMMIT callback
  */
@@ -232,10 +281,15 @@ static void pgoutput_commit_txn(LogicalDecodingContext *ctx, ReorderBufferTXN *t
     logicalrep_write_commit(ctx->out, txn, commit_lsn);
     OutputPluginWrite(ctx, true);
 
-    /*
-     * Send the newest connection information to the subscriber,
-     * when the connection information about the standby changes.
-     */
+    MaybeSendConninfo(ctx);
+}
+
+/*
+ * Send the newest connection information to the subscriber,
+ * when the connection information about the standby changes.
+ */
+static void MaybeSendConninfo(LogicalDecodingContext *ctx)
+{
     if ((t_thrd.publication_cxt.updateConninfoNeeded && ReplconninfoChanged()) ||
         t_thrd.publication_cxt.firstTimeSendConninfo) {
         StringInfoData standbysInfo;
@@ -281,11 +335,20 @@ static inline bool CheckAction(ReorderBufferChangeType type, PublicationActions
     return true;
 }
 
-static void MaybeSendSchema(LogicalDecodingContext *ctx, Relation relation, RelationSyncEntry *relentry)
+/*
+ * Send the relation schema, unless the subscriber already has it. Inside a
+ * streamed transaction 'topxid' is its toplevel xid and 'xid' is written
+ * with the messages.
+ */
+static void MaybeSendSchema(LogicalDecodingContext *ctx, Relation relation, RelationSyncEntry *relentry,
+    TransactionId topxid, TransactionId xid)
 {
     if (relentry->schema_sent) {
         return;
     }
+    if (TransactionIdIsValid(topxid) && relentry->stream_schema_xid == topxid) {
+        return;
+    }
 
     int i;
     TupleDesc desc = RelationGetDescr(relation);
@@ -304,22 +367,28 @@ static void MaybeSendSchema(LogicalDecodingContext *ctx, Relation relation, Rela
             continue;
 
         OutputPluginPrepareWrite(ctx, false);
-        logicalrep_write_typ(ctx->out, att->atttypid);
+        logicalrep_write_typ(ctx->out, xid, att->atttypid);
         OutputPluginWrite(ctx, false);
     }
 
     OutputPluginPrepareWrite(ctx, false);
-    logicalrep_write_rel(ctx->out, relation);
+    logicalrep_write_rel(ctx->out, xid, relation);
     OutputPluginWrite(ctx, false);
-    relentry->schema_sent = true;
+    if (TransactionIdIsValid(topxid))
+        relentry->stream_schema_xid = topxid;
+    else
+        relentry->schema_sent = true;
 }
 
 /*
- * Sends the decoded DML over wire.
+ * Sends the decoded DML over wire, with the (sub)transaction's xid if it is
+ * part of a streamed transaction.
  */
-static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, Relation relation,
-    ReorderBufferChange *change)
+static void pgoutput_change_common(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, Relation relation,
+    ReorderBufferChange *change, bool streaming)
 {
+    TransactionId topxid = InvalidTransactionId;
+    TransactionId xid = InvalidTransactionId;
     PGOutputData *data = (PGOutputData *)ctx->output_plugin_private;
     MemoryContext old;
     RelationSyncEntry *relentry;
@@ -336,24 +405,29 @@ static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn,
     /* Avoid leaking memory by using and resetting our own context */
     old = MemoryContextSwitchTo(data->common.context);
 
+    if (streaming) {
+        topxid = txn->xid;
+        xid = (change->txn != NULL) ? change->txn->xid : txn->xid;
+    }
+
     /*
      * Write the relation schema if the current schema haven't been sent yet.
      */
-    MaybeSendSchema(ctx, relation, relentry);
+    MaybeSendSchema(ctx, relation, relentry, topxid, xid);
 
     /* Send the data */
     switch (change->action) {
         case REORDER_BUFFER_CHANGE_INSERT:
             if (change->data.tp.newtuple != NULL) {
                 OutputPluginPrepareWrite(ctx, true);
-                logicalrep_write_insert(ctx->out, relation, &change->data.tp.newtuple->tuple, data->binary);
+                logicalrep_write_insert(ctx->out, xid, relation, &change->data.tp.newtuple->tuple, data->binary);
                 OutputPluginWrite(ctx, true);
             }
             break;
         case REORDER_BUFFER_CHANGE_UINSERT:
             if (change->data.utp.newtuple != NULL) {
                 OutputPluginPrepareWrite(ctx, true);
-                logicalrep_write_insert(ctx->out, relation,
+                logicalrep_write_insert(ctx->out, xid, relation,
                     (HeapTuple)(&change->data.utp.newtuple->tuple), data->binary);
                 OutputPluginWrite(ctx, true);
             }
@@ -363,7 +437,8 @@ static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn,
                 HeapTuple oldtuple = change->data.tp.oldtuple ? &change->data.tp.oldtuple->tuple : NULL;
 
                 OutputPluginPrepareWrite(ctx, true);
-                logicalrep_write_update(ctx->out, relation, oldtuple, &change->data.tp.newtuple->tuple, data->binary);
+                logicalrep_write_update(ctx->out, xid, relation, oldtuple, &change->data.tp.newtuple->tuple,
+                    data->binary);
                 OutputPluginWrite(ctx, true);
             }
             break;
@@ -374,7 +449,7 @@ static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn,
                     ((HeapTuple)(&change->data.utp.oldtuple->tuple)) : NULL;
 
                 OutputPluginPrepareWrite(ctx, true);
-                logicalrep_write_update(ctx->out, relation, oldtuple, (HeapTuple)(&change->data.utp.newtuple->tuple),
+                logicalrep_write_update(ctx->out, xid, relation, oldtuple, (HeapTuple)(&change->data.utp.newtuple->tuple),
                     data->binary);
                 OutputPluginWrite(ctx, true);
             }
@@ -383,7 +458,7 @@ static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn,
         case REORDER_BUFFER_CHANGE_DELETE:
             if (change->data.tp.oldtuple) {
                 OutputPluginPrepareWrite(ctx, true);
-                logicalrep_write_delete(ctx->out, relation, &change->data.tp.oldtuple->tuple, data->binary);
+                logicalrep_write_delete(ctx->out, xid, relation, &change->data.tp.oldtuple->tuple, data->binary);
                 OutputPluginWrite(ctx, true);
             } else
                 elog(DEBUG1, "didn't send DELETE change because of missing oldtuple");
@@ -391,7 +466,8 @@ static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn,
         case REORDER_BUFFER_CHANGE_UDELETE:
             if (change->data.utp.oldtuple) {
                 OutputPluginPrepareWrite(ctx, true);
-                logicalrep_write_delete(ctx->out, relation, (HeapTuple)(&change->data.utp.oldtuple->tuple), data->binary);
+                logicalrep_write_delete(ctx->out, xid, relation, (HeapTuple)(&change->data.utp.oldtuple->tuple),
+                    data->binary);
                 OutputPluginWrite(ctx, true);
             } else
                 elog(DEBUG1, "didn't send DELETE change because of missing oldtuple");
@@ -405,6 +481,72 @@ static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn,
     MemoryContextReset(data->common.context);
 }
 
+static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, Relation relation,
+    ReorderBufferChange *change)
+{
+    pgoutput_change_common(ctx, txn, relation, change, false);
+}
+
+/*
+ * START STREAM callback
+ */
+static void pgoutput_stream_start(LogicalDecodingContext *ctx, ReorderBufferTXN *txn)
+{
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_start(ctx->out, txn->xid, !txn->streamed);
+    OutputPluginWrite(ctx, true);
+}
+
+/*
+ * STOP STREAM callback
+ */
+static void pgoutput_stream_stop(LogicalDecodingContext *ctx, ReorderBufferTXN *txn)
+{
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_stop(ctx->out);
+    OutputPluginWrite(ctx, true);
+}
+
+/*
+ * Notify downstream to discard the streamed transaction (along with all
+ * it's subtransactions, if it's a toplevel transaction).
+ */
+static void pgoutput_stream_abort(LogicalDecodingContext *ctx, ReorderBufferTXN *txn)
+{
+    TransactionId topxid = txn->is_known_as_subxact ? txn->toplevel_xid : txn->xid;
+
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_abort(ctx->out, topxid, txn->xid);
+    OutputPluginWrite(ctx, true);
+
+    /* a schema sent in the discarded changes has to be sent again */
+    cleanup_rel_sync_cache(topxid, false);
+}
+
+/*
+ * Notify downstream to apply the streamed transaction (along with all
+ * it's subtransactions).
+ */
+static void pgoutput_stream_commit(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, XLogRecPtr commit_lsn)
+{
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_commit(ctx->out, txn, commit_lsn);
+    OutputPluginWrite(ctx, true);
+
+    cleanup_rel_sync_cache(txn->xid, true);
+
+    MaybeSendConninfo(ctx);
+}
+
+/*
+ * Sends a change of a streamed in-progress transaction over wire.
+ */
+static void pgoutput_stream_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, Relation relation,
+    ReorderBufferChange *change)
+{
+    pgoutput_change_common(ctx, txn, relation, change, true);
+}
+
 /*
  * Currently we always forward.
  */
@@ -587,6 +729,7 @@ static RelationSyncEntry *get_rel_sync_entry(PGOutputData *data, Oid relid)
 
     if (!found) {
         entry->schema_sent = false;
+        entry->stream_schema_xid = InvalidTransactionId;
     }
 
     return entry;
@@ -626,6 +769,29 @@ static void rel_sync_cache_relation_cb(Datum arg, Oid relid)
      */
     if (entry != NULL) {
         entry->schema_sent = false;
+        entry->stream_schema_xid = InvalidTransactionId;
+    }
+}
+
+/*
+ * A streamed transaction finished: once it committed the subscriber has the
+ * schemas sent in it, otherwise they have to be sent again.
+ */
+static void cleanup_rel_sync_cache(TransactionId xid, bool is_commit)
+{
+    HASH_SEQ_STATUS status;
+    RelationSyncEntry *entry;
+
+    Assert(t_thrd.publication_cxt.RelationSyncCache != NULL);
+
+    hash_seq_init(&status, t_thrd.publication_cxt.RelationSyncCache);
+    while ((entry = (RelationSyncEntry *)hash_seq_search(&status)) != NULL) {
+        if (entry->stream_schema_xid != xid)
+            continue;
+
+        if (is_commit)
+            entry->schema_sent = true;
+        entry->stream_schema_xid = InvalidTransactionId;
     }
 }
 
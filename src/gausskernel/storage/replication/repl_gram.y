@@ -95,6 +95,9 @@
 %token K_NEEDUPGRADEFILE
 %token K_WAL
 %token K_TABLESPACE_MAP
+%token K_INCREMENTAL
+%token K_PARALLEL
+%token K_PARALLEL_WORKER
 %token K_DATA
 %token K_START_REPLICATION
 %token K_FETCH_MOT_CHECKPOINT
@@ -230,7 +233,7 @@ identify_az:
 
 /*
  * BASE_BACKUP [LABEL '<label>'] [PROGRESS] [FAST] [WAL] [NOWAIT] [BUILDSTANDBY] [OBSMODE] [COPYSECUREFILE] 
- * [COPYUPGRADEFILE] [TABLESPACE_MAP]
+ * [COPYUPGRADEFILE] [TABLESPACE_MAP] [INCREMENTAL '<lsn>'] [PARALLEL <n>] [PARALLEL_WORKER '<lsn>']
  */
 base_backup:
 			K_BASE_BACKUP base_backup_opt_list
@@ -295,14 +298,29 @@ base_backup_opt:
 			          $$ = makeDefElem("tablespace_map",
 				                   (Node *)makeInteger(TRUE));
 				}
+			| K_INCREMENTAL SCONST
+				{
+				  $$ = makeDefElem("incremental",
+						   (Node *)makeString($2));
+				}
+			| K_PARALLEL ICONST
+				{
+				  $$ = makeDefElem("parallel",
+						   (Node *)makeInteger($2));
+				}
+			| K_PARALLEL_WORKER SCONST
+				{
+				  $$ = makeDefElem("parallel_worker",
+						   (Node *)makeString($2));
+				}
 			;
 
 /*
  * START_REPLICATION %X/%X
- * START_REPLICATION [SLOT slot] [PHYSICAL] %X/%X
+ * START_REPLICATION [SLOT slot] [PHYSICAL] %X/%X [options]
  */
 start_replication:
-			K_START_REPLICATION opt_slot opt_physical RECPTR
+			K_START_REPLICATION opt_slot opt_physical RECPTR plugin_options
 				{
 					StartReplicationCmd *cmd;
 
@@ -310,6 +328,7 @@ start_replication:
 					cmd->kind = REPLICATION_KIND_PHYSICAL;
  					cmd->slotname = $2;
  					cmd->startpoint = $4;
+					cmd->options = $5;
 
 					$$ = (Node *) cmd;
 				}
@@ -653,6 +653,11 @@ void ReplicationSlotRelease(void)
         return;
     }
 
+    if (slot->streaming) {
+        slot->streaming = false;
+        (void)pg_atomic_sub_fetch_u32(&t_thrd.slot_cxt.ReplicationSlotCtl->nstreaming, 1);
+    }
+
     if (GET_SLOT_PERSISTENCY(slot->data) == RS_EPHEMERAL) {
         /*
          * Delete the slot. There is no !PANIC case where this is allowed to
@@ -694,6 +699,34 @@ void ReplicationSlotRelease(void)
     LWLockRelease(ProcArrayLock);
 }
 
+/*
+ * Announce that the decoder of the acquired slot streams in-progress
+ * transactions. Until the slot is released, backends log the assignment of
+ * each subtransaction right away, see AssignTransactionId().
+ */
+void ReplicationSlotMarkStreaming(void)
+{
+    ReplicationSlot *slot = t_thrd.slot_cxt.MyReplicationSlot;
+
+    Assert(slot != NULL && slot->active);
+    if (slot->streaming)
+        return;
+
+    slot->streaming = true;
+    (void)pg_atomic_add_fetch_u32(&t_thrd.slot_cxt.ReplicationSlotCtl->nstreaming, 1);
+}
+
+/*
+ * Is any decoder streaming in-progress transactions?
+ */
+bool ReplicationSlotsStreaming(void)
+{
+    if (t_thrd.slot_cxt.ReplicationSlotCtl == NULL)
+        return false;
+
+    return pg_atomic_read_u32(&t_thrd.slot_cxt.ReplicationSlotCtl->nstreaming) > 0;
+}
+
 /*
  * Permanently drop replication slot identified by the passed in name.
  */
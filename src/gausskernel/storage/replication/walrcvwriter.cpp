@@ -54,6 +54,24 @@ static volatile TimeLineID recvFileTLI = 0;
 static volatile XLogSegNo recvSegNo = 0;
 static volatile uint32 recvOff = 0;
 
+/*
+ * Received WAL is written as it arrives but fsynced in groups. recvWriteUpto
+ * is the end of what has been written to recvFile, recvUnflushedBytes how
+ * much of it still needs the fsync and recvPendingSince the receipt time of
+ * its oldest byte. Like recvFile they are protected by WALWriteLock.
+ */
+static volatile XLogRecPtr recvWriteUpto = InvalidXLogRecPtr;
+static volatile uint64 recvUnflushedBytes = 0;
+static volatile TimestampTz recvPendingSince = 0;
+
+/*
+ * While more data keeps arriving, the writer flushes once this much is
+ * unflushed or the oldest unflushed byte was received this long ago. It
+ * always flushes when it has caught up with the receiver.
+ */
+#define WALRCV_FLUSH_BATCH_BYTES (1024 * 1024)
+#define WALRCV_FLUSH_BATCH_DELAY_MS 1
+
 #define MAX_DUMMY_DATA_FILE (RELSEG_SIZE * BLCKSZ)
 
 /* max dummy data write file (default: 1GB) */
@@ -67,6 +85,7 @@ static void WSDataRcvWriteOnDummyStandby(const char *buf, uint32 nbytes);
 static void walrcvWriterSigHupHandler(SIGNAL_ARGS);
 static void walrcvWriterQuickDie(SIGNAL_ARGS);
 static void reqShutdownHandler(SIGNAL_ARGS);
+static void XLogWalRcvFlush(WalRcvCtlBlock *walrcb);
 
 void SetWalRcvWriterPID(ThreadId tid)
 {
@@ -135,8 +154,6 @@ static void XLogWalRcvWrite(WalRcvCtlBlock *walrcb, char *buf, Size nbytes, XLog
 
     while (nbytes > 0) {
         int segbytes;
-        /* use volatile pointer to prevent code rearrangement */
-        volatile WalRcvData *walrcv = t_thrd.walreceiverfuncs_cxt.WalRcv;
 
         if (recvFile < 0 || !XLByteInSeg(recptr, recvSegNo)) {
             bool use_existent = false;
@@ -148,6 +165,8 @@ static void XLogWalRcvWrite(WalRcvCtlBlock *walrcb, char *buf, Size nbytes, XLog
             if (recvFile >= 0) {
                 char xlogfname[MAXFNAMELEN];
 
+                XLogWalRcvFlush(walrcb);
+
                 /*
                  * XLOG segment files will be re-read by recovery in startup
                  * process soon, so we don't advise the OS to release cache
@@ -220,31 +239,15 @@ static void XLogWalRcvWrite(WalRcvCtlBlock *walrcb, char *buf, Size nbytes, XLog
         nbytes -= byteswritten;
         buf += byteswritten;
 
-        issue_xlog_fsync(recvFile, recvSegNo);
-
+        /* the fsync is left to XLogWalRcvFlush */
+        recvWriteUpto = recptr;
+        recvUnflushedBytes += byteswritten;
         t_thrd.walrcvwriter_cxt.walStreamWrite = recptr;
 
         SpinLockAcquire(&walrcb->mutex);
-        walrcb->writePtr = walrcb->flushPtr = recptr;
+        walrcb->writePtr = recptr;
         SpinLockRelease(&walrcb->mutex);
 
-        /* Update shared-memory status */
-        SpinLockAcquire(&walrcv->mutex);
-        if (XLByteLT(walrcv->receivedUpto, t_thrd.walrcvwriter_cxt.walStreamWrite)) {
-            walrcv->latestChunkStart = walrcv->receivedUpto;
-            walrcv->receivedUpto = t_thrd.walrcvwriter_cxt.walStreamWrite;
-        }
-        SpinLockRelease(&walrcv->mutex);
-
-#ifdef ENABLE_MULTIPLE_NODES
-        WakeUpBarrierPreParseBackend();
-
-#endif
-        /* Signal the startup process and walsender that new WAL has arrived */
-        WakeupRecovery();
-        if (AllowCascadeReplication())
-            WalSndWakeup();
-
         /* Report XLOG streaming progress in PS display */
         if (u_sess->attr.attr_common.update_process_title) {
             char activitymsg[50];
@@ -259,6 +262,61 @@ static void XLogWalRcvWrite(WalRcvCtlBlock *walrcb, char *buf, Size nbytes, XLog
         ereport(DEBUG2, (errmsg("write xlog done: start %X/%X %lu bytes", (uint32)(recptr >> 32), (uint32)recptr,
                                 write_bytes)));
     }
+}
+
+/*
+ * Flush the XLOG written so far to disk and tell the startup process and
+ * cascaded walsenders about it. Caller must hold WALWriteLock.
+ */
+static void XLogWalRcvFlush(WalRcvCtlBlock *walrcb)
+{
+    /* use volatile pointer to prevent code rearrangement */
+    volatile WalRcvData *walrcv = t_thrd.walreceiverfuncs_cxt.WalRcv;
+    XLogRecPtr flushUpto = recvWriteUpto;
+
+    if (recvUnflushedBytes == 0 || recvFile < 0) {
+        return;
+    }
+
+    issue_xlog_fsync(recvFile, recvSegNo);
+
+    if (recvPendingSince != 0) {
+        uint64 waited = (uint64)(GetCurrentTimestamp() - recvPendingSince) / WALRCV_FLUSH_HIST_UNIT;
+        int bucket = 0;
+        while (waited != 0 && bucket < WALRCV_FLUSH_HIST_BUCKETS - 1) {
+            waited >>= 1;
+            bucket++;
+        }
+        walrcv->flushLatencyHist[bucket]++;
+    }
+    walrcv->flushCount++;
+    walrcv->flushBytes += recvUnflushedBytes;
+    recvUnflushedBytes = 0;
+    recvPendingSince = 0;
+
+    if (walrcb != NULL) {
+        SpinLockAcquire(&walrcb->mutex);
+        walrcb->flushPtr = flushUpto;
+        SpinLockRelease(&walrcb->mutex);
+    }
+
+    /* Update shared-memory status */
+    SpinLockAcquire(&walrcv->mutex);
+    if (XLByteLT(walrcv->receivedUpto, flushUpto)) {
+        walrcv->latestChunkStart = walrcv->receivedUpto;
+        walrcv->receivedUpto = flushUpto;
+    }
+    SpinLockRelease(&walrcv->mutex);
+
+#ifdef ENABLE_MULTIPLE_NODES
+    WakeUpBarrierPreParseBackend();
+
+#endif
+    /* Signal the startup process and walsender that new WAL has arrived */
+    WakeupRecovery();
+    if (AllowCascadeReplication())
+        WalSndWakeup();
+
 #ifndef ENABLE_MULTIPLE_NODES
     if (g_instance.attr.attr_storage.dcf_attr.enable_dcf) {
         UpdateRecordIdxState();
@@ -266,11 +324,38 @@ static void XLogWalRcvWrite(WalRcvCtlBlock *walrcb, char *buf, Size nbytes, XLog
 #endif
 }
 
+/*
+ * Is it time to flush a batch while more received data is waiting?
+ */
+static bool WalRcvFlushDue(void)
+{
+    if (recvUnflushedBytes >= WALRCV_FLUSH_BATCH_BYTES) {
+        return true;
+    }
+    return recvPendingSince != 0 &&
+           TimestampDifferenceExceeds(recvPendingSince, GetCurrentTimestamp(), WALRCV_FLUSH_BATCH_DELAY_MS);
+}
+
+static void WalRcvFlushWritten(void)
+{
+    if (recvUnflushedBytes == 0) {
+        return;
+    }
+
+    START_CRIT_SECTION();
+    LWLockAcquire(WALWriteLock, LW_EXCLUSIVE);
+    XLogWalRcvFlush(getCurrentWalRcvCtlBlock());
+    LWLockRelease(WALWriteLock);
+    END_CRIT_SECTION();
+}
+
 void WalRcvXLogClose(void)
 {
     LWLockAcquire(WALWriteLock, LW_EXCLUSIVE);
 
     if (recvFile >= 0) {
+        XLogWalRcvFlush(getCurrentWalRcvCtlBlock());
+
         /*
          * XLOG segment files will be re-read by recovery in startup
          * process soon, so we don't advise the OS to release cache
@@ -566,6 +651,7 @@ int walRcvWrite(WalRcvCtlBlock *walrcb)
     XLogRecPtr startptr;
     int64 recBufferSize = g_instance.attr.attr_storage.WalReceiverBufSize * 1024;
     int nbytes = 0;
+    TimestampTz latestRecvTime;
 
     if (walrcb == NULL)
         return 0;
@@ -586,6 +672,10 @@ int walRcvWrite(WalRcvCtlBlock *walrcb)
     walwriteoffset = walrcb->walWriteOffset;
     walrecvbuf = walrcb->walReceiverBuffer;
     startptr = walrcb->walStart;
+    latestRecvTime = walrcb->latestRecvTime;
+    if (recvPendingSince == 0) {
+        recvPendingSince = walrcb->oldestRecvTime;
+    }
     SpinLockRelease(&walrcb->mutex);
 
     nbytes = (walfreeoffset < walwriteoffset) ? (recBufferSize - walwriteoffset) : (walfreeoffset - walwriteoffset);
@@ -599,6 +689,18 @@ int walRcvWrite(WalRcvCtlBlock *walrcb)
     walrcb->walWriteOffset += nbytes;
     walrcb->walStart = startptr;
 
+    /*
+     * If we took everything that was buffered, whatever the receiver added
+     * since arrived after latestRecvTime. Start the next batch there rather
+     * than at the receipt time of data that is already written, or every
+     * later flush would look as slow as the first one after the buffer was
+     * last empty. After a wrap-around write the oldest remaining data is
+     * still from before latestRecvTime, so oldestRecvTime stays.
+     */
+    if (walrcb->walWriteOffset == walfreeoffset) {
+        walrcb->oldestRecvTime = latestRecvTime;
+    }
+
     if (walrcb->walWriteOffset == recBufferSize) {
         walrcb->walWriteOffset = 0;
         if (walrcb->walFreeOffset == recBufferSize) {
@@ -636,6 +738,7 @@ int WSWalRcvWrite(WalRcvCtlBlock *walrcb, char *buf, Size nbytes, XLogRecPtr sta
     LWLockAcquire(WALWriteLock, LW_EXCLUSIVE);
 
     XLogWalRcvWrite(walrcb, buf, nbytes, start_ptr);
+    XLogWalRcvFlush(walrcb);
 
     LWLockRelease(WALWriteLock);
     END_CRIT_SECTION();
@@ -832,8 +935,18 @@ void walrcvWriterMain(void)
             ProcessConfigFile(PGC_SIGHUP);
         }
 
-        while (!t_thrd.walrcvwriter_cxt.shutdownRequested && WalDataRcvWrite() > 0)
-            ;
+        while (!t_thrd.walrcvwriter_cxt.shutdownRequested && WalDataRcvWrite() > 0) {
+            /* more data keeps coming, so flush only in batches */
+            if (WalRcvFlushDue()) {
+                WalRcvFlushWritten();
+            }
+        }
+
+        /*
+         * Caught up with the receiver: flush now, as the primary may be
+         * waiting for this flush to acknowledge a synchronous commit.
+         */
+        WalRcvFlushWritten();
 
         if (t_thrd.walrcvwriter_cxt.shutdownRequested) {
             ereport(LOG, (errmsg("walrcvwriter thread shut down")));
@@ -46,6 +46,7 @@
 #include "access/xlog_internal.h"
 #include "access/xlog.h"
 #include "access/multi_redo_api.h"
+#include "catalog/pg_type.h"
 
 #include "funcapi.h"
 #include "nodes/execnodes.h"
@@ -67,6 +68,7 @@
 #include "storage/procarray.h"
 #include "storage/xlog_share_storage/xlog_share_storage.h"
 #include "utils/guc.h"
+#include "utils/array.h"
 #include "utils/builtins.h"
 #include "utils/guc.h"
 #include "utils/ps_status.h"
@@ -81,6 +83,7 @@
 #include "utils/distribute_test.h"
 
 #include "lz4.h"
+#include "zstd.h"
 
 bool wal_catchup = false;
 
@@ -179,6 +182,8 @@ const WalReceiverFunc WalReceiverFuncTable[] = {
 static void EnableWalRcvImmediateExit(void);
 static void DisableWalRcvImmediateExit(void);
 static void WalRcvDie(int code, Datum arg);
+static void XLogStreamDecompressionReport(void);
+static void XLogStreamDecompressionFree(void);
 static void XLogWalRcvDataPageReplication(char *buf, Size len);
 static void XLogWalRcvProcessMsg(unsigned char type, char *buf, Size len);
 static void XLogWalRcvSendHSFeedback(void);
@@ -561,6 +566,10 @@ void WalReceiverMain(void)
 
     /* Initialise to a sanish value */
     walrcv->lastMsgSendTime = walrcv->lastMsgReceiptTime = walrcv->latestWalEndTime = GetCurrentTimestamp();
+    walrcv->walCompression = WAL_COMPRESSION_NONE;
+    walrcv->walDecompressRawBytes = 0;
+    walrcv->walDecompressBytes = 0;
+    walrcv->walDecompressTime = 0;
 
     walrcv->walRcvCtlBlock = t_thrd.walreceiver_cxt.walRcvCtlBlock;
     if(walrcv->conn_target != REPCONNTARGET_OBS) {
@@ -911,6 +920,7 @@ static void WalRcvDie(int code, Datum arg)
         ereport(LOG, (errmsg("set local_redo_finish_status to false in WalRcvDie")));
     }
     walRcvDataCleanup();
+    XLogStreamDecompressionFree();
 
     LWLockAcquire(WALWriteLock, LW_EXCLUSIVE);
     SpinLockAcquire(&walrcv->mutex);
@@ -1090,6 +1100,14 @@ static void XLogWalRcvProcessMsg(unsigned char type, char *buf, Size len)
             XLogWalRcvReceive(t_thrd.libwalreceiver_cxt.decompressBuf, decompressedSize, msghdr.dataStart);
             break;
         }
+        case 'z': /* Stream compressed WAL records */
+        {
+            WalDataMessageHeader msghdr;
+            XLogWalRecordsPreProcess(&buf, &len, &msghdr);
+            Size decompressedSize = (Size)XLogStreamDecompression(buf, len, msghdr.dataStart);
+            XLogWalRcvReceive(t_thrd.libwalreceiver_cxt.decompressBuf, decompressedSize, msghdr.dataStart);
+            break;
+        }
         case 'd': /* Data page replication for the logical xlog */
         {
             XLogWalRcvDataPageReplication(buf, len);
@@ -1221,6 +1239,129 @@ int XLogDecompression(const char *buf, Size len, XLogRecPtr dataStart)
     return decompressedSize;
 }
 
+/*
+ * Decompress a 'z' message into decompressBuf, continuing the stream of the
+ * previous 'z' message unless the sender started over.  See walprotocol.h.
+ */
+int XLogStreamDecompression(const char *buf, Size len, XLogRecPtr dataStart)
+{
+    knl_t_libwalreceiver_context *cxt = &t_thrd.libwalreceiver_cxt;
+    char *decompressBuff = cxt->decompressBuf;
+    const int maxBlockSize = g_instance.attr.attr_storage.WalReceiverBufSize * 1024;
+    int decompressedSize = -1;
+    char flags;
+    TimestampTz start;
+    errno_t errorno = EOK;
+
+    if (decompressBuff == NULL) {
+        cxt->decompressBuf = (char *)palloc0(maxBlockSize);
+        decompressBuff = cxt->decompressBuf;
+    }
+    if (len < 1 || cxt->walCompression == WAL_COMPRESSION_NONE) {
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+                        errmsg_internal("invalid compressed WAL message received from primary")));
+    }
+
+    flags = buf[0];
+    buf++;
+    len--;
+    if (flags & WAL_COMPRESSION_RESET) {
+        cxt->walDecompressDictSize = 0;
+        if (cxt->walDecompressStream != NULL) {
+            (void)ZSTD_DCtx_reset((ZSTD_DCtx *)cxt->walDecompressStream, ZSTD_reset_session_only);
+        }
+        cxt->walDecompressReady = true;
+    } else if (!cxt->walDecompressReady) {
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+                        errmsg_internal("compressed WAL stream at %X/%X does not start with a reset",
+                                        (uint32)(dataStart >> 32), (uint32)dataStart)));
+    }
+
+    start = GetCurrentTimestamp();
+    if (cxt->walCompression == WAL_COMPRESSION_LZ4) {
+        if (cxt->walDecompressDict == NULL) {
+            cxt->walDecompressDict = (char *)palloc(WAL_COMPRESSION_LZ4_DICT_SIZE);
+        }
+        decompressedSize = LZ4_decompress_safe_usingDict(buf, decompressBuff, (int)len, maxBlockSize,
+                                                         cxt->walDecompressDict, cxt->walDecompressDictSize);
+        /* keep the last 64kB of the stream, as LZ4_saveDict does on the sender */
+        if (decompressedSize >= WAL_COMPRESSION_LZ4_DICT_SIZE) {
+            errorno = memcpy_s(cxt->walDecompressDict, WAL_COMPRESSION_LZ4_DICT_SIZE,
+                               decompressBuff + decompressedSize - WAL_COMPRESSION_LZ4_DICT_SIZE,
+                               WAL_COMPRESSION_LZ4_DICT_SIZE);
+            securec_check(errorno, "\0", "\0");
+            cxt->walDecompressDictSize = WAL_COMPRESSION_LZ4_DICT_SIZE;
+        } else if (decompressedSize > 0) {
+            int keep = Min(cxt->walDecompressDictSize, WAL_COMPRESSION_LZ4_DICT_SIZE - decompressedSize);
+            if (keep > 0) {
+                errorno = memmove_s(cxt->walDecompressDict, WAL_COMPRESSION_LZ4_DICT_SIZE,
+                                    cxt->walDecompressDict + cxt->walDecompressDictSize - keep, keep);
+                securec_check(errorno, "\0", "\0");
+            }
+            errorno = memcpy_s(cxt->walDecompressDict + keep, WAL_COMPRESSION_LZ4_DICT_SIZE - keep,
+                               decompressBuff, decompressedSize);
+            securec_check(errorno, "\0", "\0");
+            cxt->walDecompressDictSize = keep + decompressedSize;
+        }
+    } else {
+        ZSTD_DCtx *dctx = (ZSTD_DCtx *)cxt->walDecompressStream;
+        if (dctx == NULL) {
+            dctx = ZSTD_createDCtx();
+            if (dctx == NULL) {
+                ereport(ERROR, (errcode(ERRCODE_OUT_OF_MEMORY), errmsg("out of memory")));
+            }
+            cxt->walDecompressStream = dctx;
+        }
+        ZSTD_inBuffer in = {buf, len, 0};
+        ZSTD_outBuffer out = {decompressBuff, (size_t)maxBlockSize, 0};
+        while (in.pos < in.size) {
+            size_t ret = ZSTD_decompressStream(dctx, &out, &in);
+            if (ZSTD_isError(ret) || (out.pos == out.size && in.pos < in.size)) {
+                break;
+            }
+        }
+        if (in.pos == in.size) {
+            decompressedSize = (int)out.pos;
+        }
+    }
+    cxt->walDecompressTime += (uint64)(GetCurrentTimestamp() - start);
+
+    if (decompressedSize <= 0) {
+        ereport(ERROR, (errmsg("[DecompressFailed] startPtr %X/%X, compressedSize: %ld, decompressSize: %d",
+                               (uint32)(dataStart >> 32), (uint32)dataStart, len, decompressedSize)));
+    }
+    cxt->walDecompressRawBytes += (uint64)decompressedSize;
+    cxt->walDecompressBytes += (uint64)(1 + len);
+    XLogStreamDecompressionReport();
+    return decompressedSize;
+}
+
+/*
+ * Publish the decompression counters in WalRcv, for pg_stat_get_wal_receiver().
+ */
+static void XLogStreamDecompressionReport(void)
+{
+    knl_t_libwalreceiver_context *cxt = &t_thrd.libwalreceiver_cxt;
+    /* use volatile pointer to prevent code rearrangement */
+    volatile WalRcvData *walrcv = t_thrd.walreceiverfuncs_cxt.WalRcv;
+
+    SpinLockAcquire(&walrcv->mutex);
+    walrcv->walCompression = cxt->walCompression;
+    walrcv->walDecompressRawBytes = cxt->walDecompressRawBytes;
+    walrcv->walDecompressBytes = cxt->walDecompressBytes;
+    walrcv->walDecompressTime = cxt->walDecompressTime;
+    SpinLockRelease(&walrcv->mutex);
+}
+
+static void XLogStreamDecompressionFree(void)
+{
+    if (t_thrd.libwalreceiver_cxt.walDecompressStream != NULL) {
+        (void)ZSTD_freeDCtx((ZSTD_DCtx *)t_thrd.libwalreceiver_cxt.walDecompressStream);
+        t_thrd.libwalreceiver_cxt.walDecompressStream = NULL;
+    }
+    pfree_ext(t_thrd.libwalreceiver_cxt.walDecompressDict);
+}
+
 void WSDataRcvCheck(char *data_buf, Size nbytes)
 {
     errno_t errorno = EOK;
@@ -1394,6 +1535,7 @@ void XLogWalRcvReceive(char *buf, Size nbytes, XLogRecPtr recptr)
     char *walrecvbuf = NULL;
     XLogRecPtr startptr;
     int recBufferSize = g_instance.attr.attr_storage.WalReceiverBufSize * 1024;
+    TimestampTz receiptTime = GetCurrentTimestamp();
 
     while (nbytes > 0) {
         int segbytes;
@@ -1405,6 +1547,7 @@ void XLogWalRcvReceive(char *buf, Size nbytes, XLogRecPtr recptr)
             t_thrd.walreceiver_cxt.walRcvCtlBlock->walWriteOffset) {
             // no data to be flushed
             t_thrd.walreceiver_cxt.walRcvCtlBlock->walStart = recptr;
+            t_thrd.walreceiver_cxt.walRcvCtlBlock->oldestRecvTime = receiptTime;
         } else if (t_thrd.walreceiver_cxt.walRcvCtlBlock->walFreeOffset == recBufferSize &&
                    t_thrd.walreceiver_cxt.walRcvCtlBlock->walWriteOffset > 0) {
             t_thrd.walreceiver_cxt.walRcvCtlBlock->walFreeOffset = 0;
@@ -1499,6 +1642,7 @@ void XLogWalRcvReceive(char *buf, Size nbytes, XLogRecPtr recptr)
             t_thrd.walreceiver_cxt.walRcvCtlBlock->walFreeOffset = 0;
         }
         t_thrd.walreceiver_cxt.walRcvCtlBlock->receivePtr = recptr;
+        t_thrd.walreceiver_cxt.walRcvCtlBlock->latestRecvTime = receiptTime;
         SpinLockRelease(&t_thrd.walreceiver_cxt.walRcvCtlBlock->mutex);
     }
 
@@ -2173,7 +2317,7 @@ int GetSyncPercent(XLogRecPtr startLsn, XLogRecPtr totalLsn, XLogRecPtr hasCompl
  */
 Datum pg_stat_get_wal_receiver(PG_FUNCTION_ARGS)
 {
-#define PG_STAT_GET_WAL_RECEIVER_COLS 15
+#define PG_STAT_GET_WAL_RECEIVER_COLS 22
     ReturnSetInfo *rsinfo = (ReturnSetInfo *)fcinfo->resultinfo;
     TupleDesc tupdesc = NULL;
     Tuplestorestate *tupstore = NULL;
@@ -2206,6 +2350,11 @@ Datum pg_stat_get_wal_receiver(PG_FUNCTION_ARGS)
     char remoteip[IP_LEN] = {0};
     int localport = 0;
     int remoteport = 0;
+    int compression;
+    uint64 decompressRawBytes;
+    uint64 decompressBytes;
+    uint64 decompressTime;
+    Datum flushHist[WALRCV_FLUSH_HIST_BUCKETS];
     Datum values[PG_STAT_GET_WAL_RECEIVER_COLS];
     bool nulls[PG_STAT_GET_WAL_RECEIVER_COLS];
     errno_t rc = EOK;
@@ -2269,6 +2418,10 @@ Datum pg_stat_get_wal_receiver(PG_FUNCTION_ARGS)
     rcvWrite = walrcv->receiver_write_location;
     rcvFlush = walrcv->receiver_flush_location;
     syncStart = walrcv->syncPercentCountStart;
+    compression = walrcv->walCompression;
+    decompressRawBytes = walrcv->walDecompressRawBytes;
+    decompressBytes = walrcv->walDecompressBytes;
+    decompressTime = walrcv->walDecompressTime;
 
     if (IS_SHARED_STORAGE_MODE) {
         XLogRecPtr sendLocFix = rcvReceived;
@@ -2380,6 +2533,25 @@ Datum pg_stat_get_wal_receiver(PG_FUNCTION_ARGS)
                         remoteport);
         securec_check_ss(rc, "\0", "\0");
         values[14] = CStringGetTextDatum(location);
+
+        /* compression, raw_bytes, compressed_bytes, decompress_time */
+        values[15] = CStringGetTextDatum(compression == WAL_COMPRESSION_LZ4 ? "lz4" :
+                                         (compression == WAL_COMPRESSION_ZSTD ? "zstd" : "off"));
+        values[16] = Int64GetDatum((int64)decompressRawBytes);
+        values[17] = Int64GetDatum((int64)decompressBytes);
+        values[18] = Int64GetDatum((int64)decompressTime);
+
+        /*
+         * flush_count, flush_bytes, flush_latency_hist. The walrcvwriter
+         * updates them under WALWriteLock, a torn read only skews one bucket.
+         */
+        values[19] = Int64GetDatum((int64)walrcv->flushCount);
+        values[20] = Int64GetDatum((int64)walrcv->flushBytes);
+        for (int i = 0; i < WALRCV_FLUSH_HIST_BUCKETS; i++) {
+            flushHist[i] = Int64GetDatum((int64)walrcv->flushLatencyHist[i]);
+        }
+        values[21] = PointerGetDatum(
+            construct_array(flushHist, WALRCV_FLUSH_HIST_BUCKETS, INT8OID, sizeof(int64), FLOAT8PASSBYVAL, 'd'));
     }
     tuplestore_putvalues(tupstore, tupdesc, values, nulls);
 
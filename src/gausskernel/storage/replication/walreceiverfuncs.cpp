@@ -90,7 +90,8 @@ bool walRcvCtlBlockIsEmpty(void)
     bool retState = false;
 
     SpinLockAcquire(&walrcb->mutex);
-    if (walrcb->walFreeOffset == walrcb->walWriteOffset) {
+    /* written but not yet flushed data is not done either */
+    if (walrcb->walFreeOffset == walrcb->walWriteOffset && XLByteEQ(walrcb->writePtr, walrcb->flushPtr)) {
         retState = true;
     }
 
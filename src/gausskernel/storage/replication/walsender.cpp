@@ -112,6 +112,7 @@
 #include "utils/distribute_test.h"
 #include "gs_bbox.h"
 #include "lz4.h"
+#include "zstd.h"
 
 #define InvalidPid ((ThreadId)(-1))
 
@@ -220,6 +221,10 @@ static void WalSndWriteData(LogicalDecodingContext *ctx, XLogRecPtr lsn, Transac
 static XLogRecPtr WalSndWaitForWal(XLogRecPtr loc);
 
 static void XLogRead(char *buf, XLogRecPtr startptr, Size count);
+static void WalSndParseCompressionOption(List *options);
+static void XLogStreamCompression(int *compressedSize, XLogRecPtr startPtr, Size nbytes);
+static void WalSndReportCompression(void);
+static void WalSndFreeCompression(void);
 
 static void SetWalSndPeerMode(ServerMode mode);
 static void SetWalSndPeerDbstate(DbState state);
@@ -1181,6 +1186,8 @@ static void StartReplication(StartReplicationCmd *cmd)
                             (errmsg("cannot use a logical replication slot for physical replication"))));
     }
 
+    WalSndParseCompressionOption(cmd->options);
+
     /*
      * When we first start replication the standby will be behind the primary.
      * For some applications, for example, synchronous replication, it is
@@ -4536,6 +4543,10 @@ static void InitWalSnd(void)
             walsnd->lastWriteChangeTime = 0;
             walsnd->lastFlushChangeTime = 0;
             walsnd->lastApplyChangeTime = 0;
+            walsnd->walCompression = WAL_COMPRESSION_NONE;
+            walsnd->walCompressRawBytes = 0;
+            walsnd->walCompressBytes = 0;
+            walsnd->walCompressTime = 0;
             SpinLockRelease(&walsnd->mutex);
             /* don't need the lock anymore */
             OwnLatch((Latch *)&walsnd->latch);
@@ -4587,6 +4598,8 @@ static void WalSndKill(int code, Datum arg)
     /* Clean the connection for advance logical replication slot. */
     CloseLogicalAdvanceConnect();
 
+    WalSndFreeCompression();
+
     /*
      * Clear MyWalSnd first; then disown the latch.  This is so that signal
      * handlers won't try to touch the latch after it's no longer ours.
@@ -5240,6 +5253,8 @@ static void XLogSendPhysical(void)
         AM_WAL_HADR_DNCN_SENDER) {
         t_thrd.walsender_cxt.output_xlog_message[0] = 'C';
         XLogCompression(&compressedSize, startptr, nbytes);
+    } else if (t_thrd.walsender_cxt.walCompression != WAL_COMPRESSION_NONE) {
+        XLogStreamCompression(&compressedSize, startptr, nbytes);
     } else {
         XLogRead(t_thrd.walsender_cxt.output_xlog_message + 1 + sizeof(WalDataMessageHeader), startptr, nbytes);
         ereport(DEBUG5, (errmsg("conninfo:(%s,%d) start: %X/%X, end: %X/%X, %lu bytes",
@@ -5279,7 +5294,7 @@ static void XLogSendPhysical(void)
     securec_check(errorno, "\0", "\0");
     LogCtrlSleep();
 
-    if (t_thrd.walsender_cxt.output_xlog_message[0] == 'C') {
+    if (t_thrd.walsender_cxt.output_xlog_message[0] == 'C' || t_thrd.walsender_cxt.output_xlog_message[0] == 'z') {
         (void)pq_putmessage_noblock('d', t_thrd.walsender_cxt.output_xlog_message,
                                     1 + sizeof(WalDataMessageHeader) + compressedSize);
     } else {
@@ -5364,6 +5379,176 @@ void XLogCompression(int* compressedSize, XLogRecPtr startPtr, Size nbytes)
 
 }
 
+/*
+ * Parse the options of a physical START_REPLICATION command.  The only one is
+ * "compression", with which the standby asks for 'z' messages.
+ */
+static void WalSndParseCompressionOption(List *options)
+{
+    ListCell *lc = NULL;
+
+    WalSndFreeCompression();
+    t_thrd.walsender_cxt.walCompression = WAL_COMPRESSION_NONE;
+    foreach (lc, options) {
+        DefElem *elem = (DefElem *)lfirst(lc);
+        const char *value = (elem->arg != NULL) ? strVal(elem->arg) : NULL;
+
+        if (strcmp(elem->defname, "compression") != 0) {
+            ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR),
+                            errmsg("unrecognized START_REPLICATION option \"%s\"", elem->defname)));
+        }
+
+        if (value == NULL || pg_strcasecmp(value, "off") == 0) {
+            t_thrd.walsender_cxt.walCompression = WAL_COMPRESSION_NONE;
+        } else if (pg_strcasecmp(value, "lz4") == 0) {
+            t_thrd.walsender_cxt.walCompression = WAL_COMPRESSION_LZ4;
+        } else if (pg_strcasecmp(value, "zstd") == 0) {
+            t_thrd.walsender_cxt.walCompression = WAL_COMPRESSION_ZSTD;
+        } else {
+            ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                            errmsg("unrecognized WAL compression algorithm \"%s\"", value)));
+        }
+    }
+
+    t_thrd.walsender_cxt.walCompressReset = true;
+    t_thrd.walsender_cxt.walCompressRawBytes = 0;
+    t_thrd.walsender_cxt.walCompressBytes = 0;
+    t_thrd.walsender_cxt.walCompressTime = 0;
+    WalSndReportCompression();
+
+    if (t_thrd.walsender_cxt.walCompression != WAL_COMPRESSION_NONE) {
+        ereport(LOG, (errmsg("streaming WAL with %s compression",
+                             (t_thrd.walsender_cxt.walCompression == WAL_COMPRESSION_LZ4) ? "lz4" : "zstd")));
+    }
+}
+
+/*
+ * Compress nbytes of WAL from startPtr into a 'z' message, continuing the
+ * stream of the previous 'z' message unless a new segment begins.  Falls back
+ * to a plain 'w' message if the data doesn't compress, and *compressedSize
+ * then stays 0.
+ */
+static void XLogStreamCompression(int *compressedSize, XLogRecPtr startPtr, Size nbytes)
+{
+    char *msgData = t_thrd.walsender_cxt.output_xlog_message + 1 + sizeof(WalDataMessageHeader);
+    char *xlogReadBuf = t_thrd.walsender_cxt.xlogReadBuf;
+    int capacity = (int)nbytes - 1;
+    int size = 0;
+    char flags = 0;
+    XLogSegNo segno;
+    TimestampTz start;
+    errno_t errorno = EOK;
+
+    if (xlogReadBuf == NULL) {
+        t_thrd.walsender_cxt.xlogReadBuf = (char *)palloc(1 + sizeof(WalDataMessageHeader) +
+            (int)WS_MAX_SEND_SIZE);
+        xlogReadBuf = t_thrd.walsender_cxt.xlogReadBuf;
+    }
+    XLogRead(xlogReadBuf, startPtr, nbytes);
+
+    XLByteToSeg(startPtr, segno);
+    if (segno != t_thrd.walsender_cxt.walCompressSegNo) {
+        t_thrd.walsender_cxt.walCompressSegNo = segno;
+        t_thrd.walsender_cxt.walCompressReset = true;
+    }
+
+    start = GetCurrentTimestamp();
+    if (t_thrd.walsender_cxt.walCompression == WAL_COMPRESSION_LZ4) {
+        LZ4_stream_t *stream = (LZ4_stream_t *)t_thrd.walsender_cxt.walCompressStream;
+
+        if (stream == NULL) {
+            stream = (LZ4_stream_t *)palloc0(sizeof(LZ4_stream_t));
+            t_thrd.walsender_cxt.walCompressStream = stream;
+            t_thrd.walsender_cxt.walCompressDict = (char *)palloc(WAL_COMPRESSION_LZ4_DICT_SIZE);
+        }
+        if (t_thrd.walsender_cxt.walCompressReset) {
+            LZ4_resetStream(stream);
+            flags |= WAL_COMPRESSION_RESET;
+        }
+        if (capacity > 0) {
+            size = LZ4_compress_fast_continue(stream, xlogReadBuf, msgData + 1, (int)nbytes, capacity, 1);
+        }
+        /* xlogReadBuf is overwritten by the next read, keep the dictionary elsewhere */
+        (void)LZ4_saveDict(stream, t_thrd.walsender_cxt.walCompressDict, WAL_COMPRESSION_LZ4_DICT_SIZE);
+    } else {
+        ZSTD_CCtx *cctx = (ZSTD_CCtx *)t_thrd.walsender_cxt.walCompressStream;
+
+        if (cctx == NULL) {
+            cctx = ZSTD_createCCtx();
+            if (cctx == NULL) {
+                ereport(ERROR, (errcode(ERRCODE_OUT_OF_MEMORY), errmsg("out of memory")));
+            }
+            (void)ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, 1);
+            t_thrd.walsender_cxt.walCompressStream = cctx;
+        }
+        if (t_thrd.walsender_cxt.walCompressReset) {
+            (void)ZSTD_CCtx_reset(cctx, ZSTD_reset_session_only);
+            flags |= WAL_COMPRESSION_RESET;
+        }
+        if (capacity > 0) {
+            ZSTD_inBuffer in = {xlogReadBuf, nbytes, 0};
+            ZSTD_outBuffer out = {msgData + 1, (size_t)capacity, 0};
+            size_t remaining = ZSTD_compressStream2(cctx, &out, &in, ZSTD_e_flush);
+            /* all of it must be flushed, else the data doesn't compress */
+            if (!ZSTD_isError(remaining) && remaining == 0 && in.pos == in.size) {
+                size = (int)out.pos;
+            }
+        }
+    }
+    t_thrd.walsender_cxt.walCompressTime += (uint64)(GetCurrentTimestamp() - start);
+
+    if (size <= 0) {
+        /* the receiver won't see this data in its stream, so start over */
+        t_thrd.walsender_cxt.walCompressReset = true;
+        t_thrd.walsender_cxt.output_xlog_message[0] = 'w';
+        errorno = memcpy_s(msgData, nbytes, xlogReadBuf, nbytes);
+        securec_check(errorno, "\0", "\0");
+        size = (int)nbytes - 1;
+    } else {
+        t_thrd.walsender_cxt.walCompressReset = false;
+        t_thrd.walsender_cxt.output_xlog_message[0] = 'z';
+        msgData[0] = flags;
+        *compressedSize = 1 + size;
+    }
+    t_thrd.walsender_cxt.walCompressRawBytes += nbytes;
+    t_thrd.walsender_cxt.walCompressBytes += (uint64)(1 + size);
+    WalSndReportCompression();
+}
+
+/*
+ * Publish the compression counters in our WalSnd slot, for
+ * pg_stat_get_wal_sender_compression().
+ */
+static void WalSndReportCompression(void)
+{
+    /* use volatile pointer to prevent code rearrangement */
+    volatile WalSnd *walsnd = t_thrd.walsender_cxt.MyWalSnd;
+
+    if (walsnd == NULL) {
+        return;
+    }
+    SpinLockAcquire(&walsnd->mutex);
+    walsnd->walCompression = t_thrd.walsender_cxt.walCompression;
+    walsnd->walCompressRawBytes = t_thrd.walsender_cxt.walCompressRawBytes;
+    walsnd->walCompressBytes = t_thrd.walsender_cxt.walCompressBytes;
+    walsnd->walCompressTime = t_thrd.walsender_cxt.walCompressTime;
+    SpinLockRelease(&walsnd->mutex);
+}
+
+static void WalSndFreeCompression(void)
+{
+    if (t_thrd.walsender_cxt.walCompressStream == NULL) {
+        return;
+    }
+    if (t_thrd.walsender_cxt.walCompression == WAL_COMPRESSION_ZSTD) {
+        (void)ZSTD_freeCCtx((ZSTD_CCtx *)t_thrd.walsender_cxt.walCompressStream);
+    } else {
+        pfree(t_thrd.walsender_cxt.walCompressStream);
+        pfree_ext(t_thrd.walsender_cxt.walCompressDict);
+    }
+    t_thrd.walsender_cxt.walCompressStream = NULL;
+}
+
 /*
  * Request walsenders to reload the currently-open WAL file
  */
@@ -5581,6 +5766,10 @@ void WalSndShmemInit(void)
         t_thrd.walsender_cxt.WalSndCtl->out_keep_sync_window = false;
         t_thrd.walsender_cxt.WalSndCtl->demotion = NoDemote;
         SpinLockInit(&t_thrd.walsender_cxt.WalSndCtl->mutex);
+        SpinLockInit(&t_thrd.walsender_cxt.WalSndCtl->parallelBackup.mutex);
+        for (i = 0; i < PARALLEL_BACKUP_BUCKETS; i++) {
+            pg_atomic_init_u32(&t_thrd.walsender_cxt.WalSndCtl->parallelBackup.owner[i], 0);
+        }
     }
 }
 
@@ -6468,6 +6657,71 @@ Datum pg_stat_get_wal_senders(PG_FUNCTION_ARGS)
     return (Datum)0;
 }
 
+/*
+ * Returns the WAL compression of each walsender: the algorithm asked for by
+ * the standby, the bytes of WAL streamed, the bytes sent for them and the
+ * microseconds spent compressing.
+ */
+Datum pg_stat_get_wal_sender_compression(PG_FUNCTION_ARGS)
+{
+#define PG_STAT_GET_WAL_SENDER_COMPRESSION_COLS 6
+
+    TupleDesc tupdesc;
+    Tuplestorestate *tupstore = BuildTupleResult(fcinfo, &tupdesc);
+    bool details = superuser() || (isOperatoradmin(GetUserId()) && u_sess->attr.attr_security.operation_mode) ||
+                   isMonitoradmin(GetUserId());
+
+    for (int i = 0; i < g_instance.attr.attr_storage.max_wal_senders; i++) {
+        /* use volatile pointer to prevent code rearrangement */
+        volatile WalSnd *walsnd = &t_thrd.walsender_cxt.WalSndCtl->walsnds[i];
+        Datum values[PG_STAT_GET_WAL_SENDER_COMPRESSION_COLS];
+        bool nulls[PG_STAT_GET_WAL_SENDER_COMPRESSION_COLS];
+        ThreadId pid;
+        int lwpId;
+        int compression;
+        uint64 rawBytes;
+        uint64 compressedBytes;
+        uint64 compressTime;
+        errno_t rc;
+
+        SpinLockAcquire(&walsnd->mutex);
+        pid = walsnd->pid;
+        lwpId = walsnd->lwpId;
+        compression = walsnd->walCompression;
+        rawBytes = walsnd->walCompressRawBytes;
+        compressedBytes = walsnd->walCompressBytes;
+        compressTime = walsnd->walCompressTime;
+        SpinLockRelease(&walsnd->mutex);
+
+        if (pid == 0 || lwpId == 0) {
+            continue;
+        }
+
+        rc = memset_s(nulls, sizeof(nulls), 0, sizeof(nulls));
+        securec_check(rc, "\0", "\0");
+        values[0] = Int64GetDatum(pid);
+        values[1] = Int32GetDatum(lwpId);
+        if (!details) {
+            /* as in pg_stat_get_wal_senders, others only see that it is a walsender */
+            rc = memset_s(&nulls[2], PG_STAT_GET_WAL_SENDER_COMPRESSION_COLS - 2, true,
+                          PG_STAT_GET_WAL_SENDER_COMPRESSION_COLS - 2);
+            securec_check(rc, "\0", "\0");
+        } else {
+            values[2] = CStringGetTextDatum(compression == WAL_COMPRESSION_LZ4 ? "lz4" :
+                                            (compression == WAL_COMPRESSION_ZSTD ? "zstd" : "off"));
+            values[3] = Int64GetDatum((int64)rawBytes);
+            values[4] = Int64GetDatum((int64)compressedBytes);
+            values[5] = Int64GetDatum((int64)compressTime);
+        }
+        tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+    }
+
+    /* clean up and return the tuplestore */
+    tuplestore_donestoring(tupstore);
+
+    return (Datum)0;
+}
+
 /*
  * Send a keepalive message to standby.
  *
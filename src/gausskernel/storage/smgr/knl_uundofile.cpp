@@ -536,7 +536,11 @@ void PrefetchUndoFile(SMgrRelation reln, ForkNumber forknum, BlockNumber blockNu
     off_t seekpos;
     uint32 undoFileBlocks = UNDO_FILE_BLOCK(reln->smgr_rnode.node.dbNode);
 
-    state = OpenUndoFile(reln, forknum, blockNum, EXTENSION_FAIL);
+    /* Prefetch is only a hint, the segment may have been recycled meanwhile. */
+    state = OpenUndoFile(reln, forknum, blockNum, EXTENSION_RETURN_NULL);
+    if (state == NULL) {
+        return;
+    }
     seekpos = (off_t)BLCKSZ * (blockNum % undoFileBlocks);
 
     Assert(seekpos < (off_t)(undoFileBlocks * BLCKSZ));
@@ -115,6 +115,7 @@ static MdfdVec *mdopen(SMgrRelation reln, ForkNumber forknum, ExtensionBehavior
 static MdfdVec *_fdvec_alloc(void);
 static char *_mdfd_segpath(const SMgrRelation reln, ForkNumber forknum, BlockNumber segno);
 static MdfdVec *_mdfd_openseg(SMgrRelation reln, ForkNumber forkno, BlockNumber segno, int oflags);
+static MdfdVec *_mdfd_getseg_noextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blkno);
 static BlockNumber _mdnblocks(SMgrRelation reln, ForkNumber forknum, const MdfdVec *seg);
 static void register_dirty_segment(SMgrRelation reln, ForkNumber forknum, const MdfdVec *seg);
 static void register_unlink_segment(RelFileNodeBackend rnode, ForkNumber forknum, BlockNumber segno);
@@ -827,7 +828,16 @@ void mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum)
     off_t seekpos;
     MdfdVec *v = NULL;
 
-    v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+    /*
+     * Redo prefetches blocks of files that later records create, extend or
+     * drop.  Don't complain about missing files, and don't create segments
+     * the way _mdfd_getseg does in recovery.
+     */
+    if (t_thrd.xlog_cxt.InRecovery) {
+        v = _mdfd_getseg_noextend(reln, forknum, blocknum);
+    } else {
+        v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+    }
     if (v == NULL) {
         return;
     }
@@ -1818,6 +1828,24 @@ static MdfdVec *_mdfd_openseg(SMgrRelation reln, ForkNumber forknum, BlockNumber
     return v;
 }
 
+/*
+ *  _mdfd_getseg_noextend() -- Find the segment of the relation holding the
+ *      specified block if it exists, else return NULL.
+ */
+static MdfdVec *_mdfd_getseg_noextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blkno)
+{
+    MdfdVec *v = mdopen(reln, forknum, EXTENSION_RETURN_NULL);
+    BlockNumber targetseg = blkno / ((BlockNumber)RELSEG_SIZE);
+
+    for (BlockNumber nextsegno = 1; v != NULL && nextsegno <= targetseg; nextsegno++) {
+        if (v->mdfd_chain == NULL) {
+            v->mdfd_chain = _mdfd_openseg(reln, forknum, nextsegno, 0);
+        }
+        v = v->mdfd_chain;
+    }
+    return v;
+}
+
 /*
  *  _mdfd_getseg() -- Find the segment of the relation holding the
  *      specified block.
@@ -185,6 +185,12 @@ struct PageRedoWorker {
     HTAB *badPageHashTbl;
     char page[BLCKSZ];
     XLogBlockDataParse *curRedoBlockState;
+
+    /* Block prefetch of the batch redo thread, see BatchRedoPrefetchBlocks. */
+    BufferTag *prefetchRecent;
+    pg_atomic_uint64 prefetchCount;
+    pg_atomic_uint64 prefetchSkipCount;
+    pg_atomic_uint64 prefetchLsn;
 };
 
 
@@ -213,6 +219,7 @@ void WaitPageRedoWorkerReachLastMark(PageRedoWorker *worker);
 
 /* Redo processing. */
 void AddPageRedoItem(PageRedoWorker *worker, void *item);
+void AddPageRedoItems(PageRedoWorker *worker, void **items, uint32 num);
 
 void UpdatePageRedoWorkerStandbyState(PageRedoWorker *worker, HotStandbyState newState);
 
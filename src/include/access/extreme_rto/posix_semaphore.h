@@ -37,6 +37,7 @@ typedef struct {
 void PosixSemaphoreInit(PosixSemaphore *sem, unsigned int initValue);
 void PosixSemaphoreDestroy(PosixSemaphore *sem);
 void PosixSemaphoreWait(PosixSemaphore *sem);
+bool PosixSemaphoreTimedWait(PosixSemaphore *sem, long timeoutUs);
 void PosixSemaphorePost(PosixSemaphore *sem);
 }  // namespace extreme_rto
 #endif
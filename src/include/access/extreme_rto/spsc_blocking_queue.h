@@ -29,11 +29,19 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 #include "access/parallel_recovery/posix_semaphore.h"
+#include "access/extreme_rto/posix_semaphore.h"
 
 
 namespace extreme_rto {
 typedef void (*CallBackFunc)();
 
+/*
+ * Log2 buckets of the queue histograms.  Bucket 0 counts empty queues (or
+ * waits under 16us), bucket k counts [2^(k-1), 2^k) queued elements (or
+ * multiples of 16us waited); the last bucket is open-ended.
+ */
+const uint32 SPSC_QUEUE_HIST_BUCKETS = 8;
+
 struct SPSCBlockingQueue {
     pg_atomic_uint32 writeHead; /* Array index for the next write. */
     pg_atomic_uint32 readTail;  /* Array index for the next read. */
@@ -43,6 +51,12 @@ struct SPSCBlockingQueue {
     pg_atomic_uint64 totalCnt;
     CallBackFunc callBackFunc;
     uint64 lastTotalCnt;
+    uint32 spinLimit;                  /* consumer spins before sleeping, adapted */
+    pg_atomic_uint32 consumerWaiting;  /* consumer is (about to be) asleep on wakeup */
+    PosixSemaphore wakeup;             /* posted by the producer to end such a sleep */
+    pg_atomic_uint64 depthHist[SPSC_QUEUE_HIST_BUCKETS];    /* queue depth seen by put */
+    pg_atomic_uint64 idleWaitHist[SPSC_QUEUE_HIST_BUCKETS]; /* consumer sleeps on empty queue */
+    pg_atomic_uint64 fullWaitHist[SPSC_QUEUE_HIST_BUCKETS]; /* producer stalls on full queue */
     void *buffer[1]; /* Queue buffer, the actual size is capacity. */
 };
 
@@ -50,6 +64,7 @@ SPSCBlockingQueue *SPSCBlockingQueueCreate(uint32 capacity, CallBackFunc func =
 void SPSCBlockingQueueDestroy(SPSCBlockingQueue *queue);
 
 bool SPSCBlockingQueuePut(SPSCBlockingQueue *queue, void *element);
+void SPSCBlockingQueuePutN(SPSCBlockingQueue *queue, void **elements, uint32 n);
 void *SPSCBlockingQueueTake(SPSCBlockingQueue *queue);
 bool SPSCBlockingQueueIsEmpty(SPSCBlockingQueue *queue);
 void *SPSCBlockingQueueTop(SPSCBlockingQueue *queue);
@@ -58,5 +73,6 @@ void DumpQueue(const SPSCBlockingQueue *queue);
 uint32 SPSCGetQueueCount(SPSCBlockingQueue *queue);
 bool SPSCBlockingQueueGetAll(SPSCBlockingQueue *queue, void ***eleArry, uint32 *eleNum);
 void SPSCBlockingQueuePopN(SPSCBlockingQueue *queue, uint32 n);
+void SPSCGetQueueHistogram(SPSCBlockingQueue *queue, uint64 *depthHist, uint64 *idleWaitHist, uint64 *fullWaitHist);
 }  // namespace extreme_rto
 #endif
@@ -50,6 +50,8 @@ typedef enum RedoWorkerWaitSyncStats {
 } RedoWorkerWaitSyncStats;
 
 /* Redo statistics */
+#define REDO_QUEUE_HIST_BUCKETS 8
+
 typedef struct RedoWorkerStatsData {
     uint32 id;              /* Worker id. */
     uint32 queue_usage;     /* queue usage */
@@ -57,6 +59,13 @@ typedef struct RedoWorkerStatsData {
     /* XLogRecPtr head_ptr; do not try to get head_ptr and tail_ptr, */
     /* XLogRecPtr tail_ptr; because the memory of redoItem maybe be freed already */
     uint64 redo_rec_count;
+    uint64 prefetch_count;      /* blocks prefetched ahead of redo */
+    uint64 prefetch_skip_count; /* block references that needed no prefetch */
+    XLogRecPtr prefetch_ptr;    /* end of the last record looked ahead at */
+    /* log2 histograms summed over the queues of the pipeline, see spsc_blocking_queue.h */
+    uint64 queue_depth_hist[REDO_QUEUE_HIST_BUCKETS];
+    uint64 queue_idle_wait_hist[REDO_QUEUE_HIST_BUCKETS];
+    uint64 queue_full_wait_hist[REDO_QUEUE_HIST_BUCKETS];
 } RedoWorkerStatsData;
 
 extern const RedoStatsViewObj g_redoViewArr[REDO_VIEW_COL_SIZE];
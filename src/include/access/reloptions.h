@@ -278,6 +278,7 @@ extern int8 heaprel_get_compression_from_modes(int16 modes);
 extern bool get_crossbucket_option(List **options_ptr, bool stmtoptgpi = false, char *accessmethod = NULL,
     int *crossbucketopt = NULL);
 extern bool is_contain_crossbucket(List *defList);
+extern bool is_contain_tree_flavor(List *defList);
 extern bool is_cstore_option(char relkind, Datum reloptions);
 
 extern void CheckGetServerIpAndPort(const char* Address, List** AddrList, bool IsCheck, int real_addr_max);
@@ -57,6 +57,9 @@ typedef enum {
     SLRU_MAX_FAILED  // used to initialize slru_errcause
 } SlruErrorCause;
 
+/* Number of slots in one bank of an SLRU, see num_banks */
+#define SLRU_BANK_SIZE 16
+
 /*
  * Shared-memory state
  */
@@ -66,6 +69,14 @@ typedef struct SlruSharedData {
     /* Number of buffers managed by this SLRU structure */
     int num_slots;
 
+    /*
+     * The slots are split into num_banks banks of about SLRU_BANK_SIZE
+     * slots.  A page can only live in the bank SlruPageBank() picks for it,
+     * so looking a page up or choosing a victim scans one bank instead of
+     * every slot.
+     */
+    int num_banks;
+
     /*
      * Arrays holding info for each buffer slot.  Page number is undefined
      * when status is EMPTY, as is page_lru_count.
@@ -77,6 +88,20 @@ typedef struct SlruSharedData {
     int* page_lru_count;
     LWLock** buffer_locks;
 
+    /*
+     * page_generation[slotno] is odd while the slot is being given a new
+     * page and even once the page contents are in place, so that
+     * SimpleLruReadEntry_NoLock can tell whether what it read without the
+     * control lock still belongs to the page it was after.
+     */
+    volatile uint64* page_generation;
+
+    /*
+     * page_slot_hint[pageno % num_slots] is the slot that last held pageno.
+     * Hints are only ever checked against page_number, never trusted.
+     */
+    volatile int* page_slot_hint;
+
     /*
      * Optional array of WAL flush LSNs associated with entries in the SLRU
      * pages.  If not zero/NULL, we must flush WAL before writing pages (true
@@ -136,6 +161,12 @@ typedef struct SlruCtlData {
      */
     bool do_fsync;
 
+    /*
+     * Wait event reported while a page is read in, so that misses can be told
+     * apart per SLRU.  SimpleLruInit sets the generic WAIT_EVENT_SLRU_READ.
+     */
+    uint32 read_wait_event;
+
     /*
      * Dir is set during SimpleLruInit and does not change thereafter. Since
      * it's always the same, it doesn't need to be in shared memory.
@@ -152,6 +183,7 @@ extern int SimpleLruZeroPage(SlruCtl ctl, int64 pageno, bool* pbZeroPage = NULL)
 extern int SimpleLruReadPage(SlruCtl ctl, int64 pageno, bool write_ok, TransactionId xid);
 extern int SimpleLruReadPage_ReadOnly(SlruCtl ctl, int64 pageno, TransactionId xid);
 extern int SimpleLruReadPage_ReadOnly_Locked(SlruCtl ctl, int64 pageno, TransactionId xid);
+extern bool SimpleLruReadEntry_NoLock(SlruCtl ctl, int64 pageno, int offset, uint64* value);
 extern void SimpleLruWritePage(SlruCtl ctl, int slotno);
 extern int SimpleLruFlush(SlruCtl ctl, bool checkpoint);
 extern void SimpleLruTruncate(SlruCtl ctl, int64 cutoffPage, int partitionNum);
@@ -0,0 +1,51 @@
+/* -------------------------------------------------------------------------
+ *
+ * toast_compression.h
+ *	  Functions for toast compression.
+ *
+ * A compressed varlena keeps its uncompressed size in va_rawsize, which is
+ * always below 1GB.  The top two bits of that word name the method that
+ * compressed the data; values written before the method was selectable
+ * have zero there, which is pglz.
+ *
+ * Portions Copyright (c) 2021, openGauss Contributors
+ *
+ * src/include/access/toast_compression.h
+ *
+ * -------------------------------------------------------------------------
+ */
+#ifndef TOAST_COMPRESSION_H
+#define TOAST_COMPRESSION_H
+
+#include "utils/relcache.h"
+
+typedef enum ToastCompressionId {
+    TOAST_PGLZ_COMPRESSION_ID = 0,
+    TOAST_LZ4_COMPRESSION_ID = 1,
+    TOAST_ZSTD_COMPRESSION_ID = 2,
+    TOAST_INVALID_COMPRESSION_ID = 3
+} ToastCompressionId;
+
+#define TOAST_COMPRESSION_ID_BITS 2
+#define TOAST_RAWSIZE_BITS (32 - TOAST_COMPRESSION_ID_BITS)
+#define TOAST_RAWSIZE_MASK ((1U << TOAST_RAWSIZE_BITS) - 1)
+
+/* method that compressed an inline-compressed varlena */
+#define TOAST_COMPRESS_METHOD(PTR) \
+    ((ToastCompressionId)(((varattrib_4b*)(PTR))->va_compressed.va_rawsize >> TOAST_RAWSIZE_BITS))
+#define TOAST_COMPRESS_SET_SIZE_AND_METHOD(PTR, len, method) \
+    (((varattrib_4b*)(PTR))->va_compressed.va_rawsize = (uint32)(len) | ((uint32)(method) << TOAST_RAWSIZE_BITS))
+
+/* the attribute option ALTER TABLE ... SET COMPRESSION is recorded as */
+#define TOAST_COMPRESSION_OPTION "toast_compression"
+
+extern ToastCompressionId CompressionNameToId(const char* name);
+extern const char* CompressionIdToName(ToastCompressionId cmid);
+extern ToastCompressionId GetDefaultToastCompression(void);
+extern ToastCompressionId GetAttributeToastCompression(Relation rel, int attnum);
+
+extern struct varlena* toast_compress_with_method(struct varlena* value, ToastCompressionId cmid);
+extern void toast_decompress_datum_into(const struct varlena* attr, struct varlena* result);
+extern struct varlena* toast_decompress_datum(const struct varlena* attr);
+
+#endif /* TOAST_COMPRESSION_H */
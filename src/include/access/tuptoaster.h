@@ -14,6 +14,7 @@
 #define TUPTOASTER_H
 
 #include "access/htup.h"
+#include "access/toast_compression.h"
 #include "utils/relcache.h"
 
 /*
@@ -252,10 +253,11 @@ extern int64 calculate_huge_length(text* t);
 /* ----------
  * toast_compress_datum -
  *
- *	Create a compressed version of a varlena datum, if possible
+ *	Create a compressed version of a varlena datum, if possible, using
+ *	method cmid or default_toast_compression if that is invalid
  * ----------
  */
-extern Datum toast_compress_datum(Datum value);
+extern Datum toast_compress_datum(Datum value, ToastCompressionId cmid = TOAST_INVALID_COMPRESSION_ID);
 
 /* ----------
  * toast_raw_datum_size -
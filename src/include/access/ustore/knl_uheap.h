@@ -35,6 +35,20 @@
  */
 #define MIN_SAVING_LEN 3
 
+/*
+ * An inplace update whose changed bytes are scattered over the tuple (say a
+ * counter and a timestamp column) can store just the changed byte ranges in
+ * undo and WAL, instead of everything between the common prefix and suffix.
+ * Each range costs a UHeapDeltaRange header, so ranges closer together than
+ * that are merged.
+ */
+#define UHEAP_DELTA_MAX_RANGES 8
+
+typedef struct UHeapDeltaRange {
+    uint16 off; /* offset from the end of the common prefix */
+    uint16 len;
+} UHeapDeltaRange;
+
 typedef struct UHeapWALInfo {
     Oid relOid;
     Oid partitionOid;
@@ -108,6 +122,9 @@ TM_Result UHeapUpdate(Relation relation, Relation parentRelation, ItemPointer ot
     Snapshot crosscheck, Snapshot snapshot, bool wait, TupleTableSlot **oldslot, TM_FailureData *tmfd,
     bool *indexkey_update_flag, Bitmapset **modifiedIdxAttrs, bool allow_inplace_update = true);
 extern void PutLinkUpdateTuple(Page page, Item item, RowPtr *lp, Size size);
+extern int UHeapComputeDeltaRanges(const char *oldp, const char *newp, int len, UHeapDeltaRange *ranges,
+    int *encodedSize);
+extern char *UHeapApplyDeltaRanges(char *dst, int len, char *delta, char **data);
 
 TM_Result UHeapLockTuple(Relation relation, UHeapTuple tuple, Buffer* buffer,
                            CommandId cid, LockTupleMode mode, LockWaitPolicy waitPolicy, TM_FailureData *tmfd,
@@ -35,7 +35,10 @@ typedef struct RollbackRequestsHashEntry {
     UndoRecPtr endUndoPtr;
     Oid dbid;
     UndoSlotPtr slotPtr;
-    bool launched;
+    bool launched;        /* all parts have been handed to undo workers */
+    int nparts;           /* number of undo workers applying this request */
+    uint32 partsLaunched; /* bitmap of parts picked up by an undo worker */
+    uint32 partsDone;     /* bitmap of parts applied completely */
 } RollbackRequestsHashEntry;
 
 typedef struct UndoRecInfo {
@@ -61,13 +64,14 @@ Size AsyncRollbackRequestsHashSize(void);
 Size AsyncRollbackHashShmemSize(void);
 void AsyncRollbackHashShmemInit(void);
 
-RollbackRequestsHashEntry *GetNextRollbackRequest();
+RollbackRequestsHashEntry *GetNextRollbackRequest(int *partIdx);
 bool IsRollbackRequestHashFull();
 bool AddRollbackRequest(TransactionId xid, UndoRecPtr fromAddr, UndoRecPtr toAddr, Oid dbid, UndoSlotPtr slotPtr);
 bool RemoveRollbackRequest(TransactionId xid, UndoRecPtr startAddr, ThreadId pid);
-void ReportFailedRollbackRequest(TransactionId xid, UndoRecPtr fromAddr, UndoRecPtr toAddr, Oid dbid);
+void ReportFailedRollbackRequest(TransactionId xid, UndoRecPtr fromAddr, UndoRecPtr toAddr, Oid dbid, int partIdx);
+bool FinishRollbackRequestPart(TransactionId xid, UndoRecPtr startAddr, int partIdx);
 void ExecuteUndoActions(TransactionId fullXid, UndoRecPtr fromUrecptr, UndoRecPtr toUrecptr, UndoSlotPtr slotPtr,
-    bool nopartial);
+    bool nopartial, int partIdx = 0, int nparts = 1);
 void ExecuteUndoActionsPage(UndoRecPtr urp, Relation relation, Buffer buf, TransactionId xid);
 int UHeapUndoActions(URecVector *urecvector, int startIdx, int endIdx, TransactionId xid, Oid reloid, Oid partitionoid,
     BlockNumber blkno, bool isFullChain, int preRetCode, Oid *preReloid, Oid *prePartitionoid);
@@ -20,12 +20,27 @@
 
 #define MAX_UNDO_WORKERS 100
 
+/*
+ * A large rollback request can be split into up to MAX_UNDO_APPLY_PARTS parts,
+ * each applied by its own undo worker. Every part reads the whole undo chain
+ * but only applies the records of the heap blocks it owns, blocks being dealt
+ * out to parts in ranges of UNDO_APPLY_PART_BLOCKS, so all undo of one page is
+ * still applied by one worker in the original order.
+ */
+#define MAX_UNDO_APPLY_PARTS 16
+#define UNDO_APPLY_PART_BLOCKS 64
+
+/* Rollback requests with less undo than this are never split. */
+const uint64 UNDO_APPLY_PART_MIN_SIZE = 16 * 1024 * 1024;
+
 typedef struct UndoWorkInfoData {
     TransactionId xid;
     UndoRecPtr startUndoPtr;
     UndoRecPtr endUndoPtr;
     Oid dbid;
     UndoSlotPtr slotPtr;
+    int partIdx;
+    int nparts;
 } UndoWorkInfoData;
 
 typedef UndoWorkInfoData *UndoWorkInfo;
@@ -35,6 +50,11 @@ typedef struct UndoWorkerItem {
     TransactionId xid;
     UndoRecPtr startUndoPtr;
     TimestampTz rollbackStartTime;
+    int partIdx;
+    int nparts;
+    /* undo records and blocks applied so far, shown by gs_stat_undo_rollback() */
+    uint64 undoRecords;
+    uint64 undoBlocks;
 } UndoWorkerItem;
 
 /* -------------
@@ -66,6 +86,15 @@ extern void UndoWorkerMain();
 #endif
 
 bool IsUndoWorkerProcess(void);
+void UndoWorkerReportProgress(uint64 undoRecords, uint64 undoBlocks);
+
+static inline bool UndoApplyPartOwnsBlock(Oid relfilenode, BlockNumber blkno, int partIdx, int nparts)
+{
+    if (nparts <= 1) {
+        return true;
+    }
+    return (int)((relfilenode + blkno / UNDO_APPLY_PART_BLOCKS) % (uint32)nparts) == partIdx;
+}
 
 /* shared memory specific */
 extern Size UndoWorkerShmemSize(void);
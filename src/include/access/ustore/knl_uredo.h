@@ -123,6 +123,7 @@ typedef struct XlUHeapInsert {
 #define XLZ_NON_INPLACE_UPDATE (1 << 2)
 #define XLZ_HAS_UPDATE_UNDOTUPLE (1 << 3)
 #define XLZ_LINK_UPDATE (1 << 4)
+#define XLZ_UPDATE_DELTA_FROM_OLD (1 << 5)
 
 /* size=24 alignment=8 */
 typedef struct XlUHeapUpdate {
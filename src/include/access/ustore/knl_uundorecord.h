@@ -136,6 +136,12 @@ typedef struct {
 
 #define SIZE_OF_UNDO_RECORD_PAYLOAD (offsetof(UndoRecordPayload, payloadlen) + sizeof(UndoRecordSize))
 
+/* Upper bound of the on-disk size of an UNDO_MULTI_INSERT record, payload is an offset range. */
+#define UNDO_MULTI_INSERT_RECORD_MAXSIZE                                                                  \
+    (SIZE_OF_UNDO_RECORD_HEADER + SIZE_OF_UNDO_RECORD_BLOCK + sizeof(UndoRecordSize) +                    \
+        SIZE_OF_UNDO_RECORD_TRANSACTION + SIZE_OF_UNDO_RECORD_PARTITION + SIZE_OF_UNDO_RECORD_TABLESPACE + \
+        SIZE_OF_UNDO_RECORD_PAYLOAD + 2 * sizeof(OffsetNumber))
+
 class UndoRecord : public BaseObject {
 public:
     StringInfoData rawdata_;
@@ -390,6 +396,13 @@ UndoTraversalState FetchUndoRecord(__inout UndoRecord *urec, _in_ SatisfyUndoRec
     _in_ BlockNumber blkno, _in_ OffsetNumber offset, _in_ TransactionId xid, bool isNeedByPass,
     TransactionId *lastXid);
 
+/*
+ * Start reading the undo block holding urp in the background. Used by undo
+ * chain traversals which learn the next record before they are done with the
+ * current one. No-op unless effective_io_concurrency is set.
+ */
+void PrefetchUndoRecord(_in_ UndoRecPtr urp);
+
 /*
  * Example: satisfied callback function.
  */
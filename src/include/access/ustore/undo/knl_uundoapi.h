@@ -31,6 +31,8 @@ void RollbackIfUndoExceeds(TransactionId xid, uint64 size);
 UndoRecPtr AllocateUndoSpace(TransactionId xid, UndoPersistence upersistence, uint64 size,
     bool needSwitch, XlogUndoMeta *xlundometa);
 
+void ReserveUndoSpace(UndoPersistence upersistence, uint64 size);
+
 void UndoRecycleMain();
 
 bool IsSkipInsertUndo(UndoRecPtr urp);
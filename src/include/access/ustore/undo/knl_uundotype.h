@@ -61,6 +61,9 @@ const int PAGES_READ_NUM = 1024 * 16;
 /* Size of an undo log segment file in bytes. */
 #define UNDO_LOG_SEGMENT_SIZE ((size_t)BLCKSZ * UNDOSEG_SIZE)
 
+/* Max segments pre-extended at once for bulk undo allocation. */
+#define UNDO_RESERVE_MAX_SEGMENTS 16
+
 /* Number of blocks of BLCKSZ in an undo meta segment file. */
 #define UNDO_META_SEG_SIZE 4
 
@@ -259,6 +262,7 @@ typedef struct MiniSlot {
 
 #define UREC_INPLACE_UPDATE_XOR_PREFIX 0x01
 #define UREC_INPLACE_UPDATE_XOR_SUFFIX 0x02
+#define UREC_INPLACE_UPDATE_XOR_DELTA 0x04
 
 #define UNDODEBUGINFO , __FUNCTION__, __LINE__
 #define UNDODEBUGSTR "[%s:%d]"
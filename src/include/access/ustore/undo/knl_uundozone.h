@@ -279,11 +279,12 @@ public:
         }
         return ((allocateTSlotPtr_ - recycleTSlotPtr_) / BLCKSZ);
     }
-    bool CheckNeedSwitch(UndoRecordSize size);
+    bool CheckNeedSwitch(uint64 size);
     UndoRecordState CheckUndoRecordValid(UndoLogOffset offset, bool checkForceRecycle, TransactionId *lastXid);
     bool CheckRecycle(UndoRecPtr starturp, UndoRecPtr endurp);
 
     UndoRecPtr AllocateSpace(uint64 size);
+    bool ReserveSpace(uint64 size);
     void ReleaseSpace(UndoRecPtr starturp, UndoRecPtr endurp, int *forceRecycleSize);
     UndoRecPtr AllocateSlotSpace(void);
     void ReleaseSlotSpace(UndoRecPtr starturp, UndoRecPtr endurp, int *forceRecycleSize);
@@ -302,6 +303,9 @@ public:
     static void RecoveryUndoZone(int fd);
 
 private:
+    /* Extend the undo log so that newInsert is backed by a segment file. */
+    void ExtendSpace(UndoLogOffset newInsert);
+
     static const uint32 UNDO_ZONE_ATTACHED = 1;
     static const uint32 UNDO_ZONE_DETACHED = 0;
     pg_atomic_uint32 attached_;
@@ -636,6 +636,9 @@ typedef struct XLogCtlData {
     bool walrcv_reply_dueto_commit;
 
     slock_t info_lck; /* locks shared variables shown above */
+
+    /* lowest PGPROC->replayWaitLSN of backends waiting for replay, PG_UINT64_MAX if none */
+    pg_atomic_uint64 minReplayWaitLSN;
 } XLogCtlData;
 
 /* Xlog flush statistics*/
@@ -700,6 +703,7 @@ extern bool SSModifySharedLunAllowed(void);
 extern void GetXLogReceiptTime(TimestampTz* rtime, bool* fromStream);
 extern XLogRecPtr GetXLogReplayRecPtr(TimeLineID* targetTLI, XLogRecPtr* ReplayReadPtr = NULL);
 extern void SetXLogReplayRecPtr(XLogRecPtr readRecPtr, XLogRecPtr endRecPtr);
+extern void WaitForXLogReplay(XLogRecPtr targetLSN, int timeoutMs);
 extern void DumpXlogCtl();
 
 extern void CheckRecoveryConsistency(void);
@@ -797,6 +801,7 @@ extern XLogRecPtr do_pg_start_backup(const char* backupidstr, bool fast, char**
     char** tblspcmapfile, List** tablespaces, bool infotbssize, bool needtblspcmapfile);
 extern XLogRecPtr StandbyDoStartBackup(const char* backupidstr, char** labelFile, char** tblSpcMapFile,
     List** tableSpaces, DIR* tblSpcDir, bool infoTbsSize);
+extern void CollectTableSpace(DIR* tblspcdir, List** tablespaces, StringInfo tblspc_mapfbuf, bool infotbssize);
 extern void set_start_backup_flag(bool startFlag);
 extern bool get_startBackup_flag(void);
 extern bool check_roach_start_backup(const char *slotName);
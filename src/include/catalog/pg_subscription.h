@@ -52,13 +52,14 @@ CATALOG(pg_subscription,6126) BKI_SHARED_RELATION BKI_ROWTYPE_OID(6128) BKI_SCHE
     text subpublications[1]; /* List of publications subscribed to */
     bool subbinary;          /* True if the subscription wants the
                               * publisher to send data in binary */
+    bool substream;          /* Stream in-progress transactions */
 #endif
 }
 FormData_pg_subscription;
 
 typedef FormData_pg_subscription *Form_pg_subscription;
 
-#define Natts_pg_subscription 9
+#define Natts_pg_subscription 10
 #define Anum_pg_subscription_subdbid 1
 #define Anum_pg_subscription_subname 2
 #define Anum_pg_subscription_subowner 3
@@ -68,6 +69,7 @@ typedef FormData_pg_subscription *Form_pg_subscription;
 #define Anum_pg_subscription_subsynccommit 7
 #define Anum_pg_subscription_subpublications 8
 #define Anum_pg_subscription_subbinary 9
+#define Anum_pg_subscription_substream 10
 
 
 typedef struct Subscription {
@@ -81,6 +83,7 @@ typedef struct Subscription {
     char *synccommit;   /* Synchronous commit setting for worker */
     List *publications; /* List of publication names to subscribe to */
     bool binary;        /* Indicates if the subscription wants data in binary format */
+    bool stream;        /* Allow streaming in-progress transactions */
 } Subscription;
 
 
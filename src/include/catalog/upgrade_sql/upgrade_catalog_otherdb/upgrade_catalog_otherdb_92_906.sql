@@ -0,0 +1,40 @@
+-- WAL stream compression and walreceiver flush counters
+DROP FUNCTION IF EXISTS pg_catalog.pg_stat_get_wal_receiver(OUT receiver_pid integer, OUT local_role text, OUT peer_role text, OUT peer_state text, OUT state text, OUT sender_sent_location text, OUT sender_write_location text, OUT sender_flush_location text, OUT sender_replay_location text, OUT receiver_received_location text, OUT receiver_write_location text, OUT receiver_flush_location text, OUT receiver_replay_location text, OUT sync_percent text, OUT channel text) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3819;
+CREATE OR REPLACE FUNCTION pg_catalog.pg_stat_get_wal_receiver(OUT receiver_pid integer, OUT local_role text, OUT peer_role text, OUT peer_state text, OUT state text, OUT sender_sent_location text, OUT sender_write_location text, OUT sender_flush_location text, OUT sender_replay_location text, OUT receiver_received_location text, OUT receiver_write_location text, OUT receiver_flush_location text, OUT receiver_replay_location text, OUT sync_percent text, OUT channel text, OUT compression text, OUT raw_bytes bigint, OUT compressed_bytes bigint, OUT decompress_time bigint, OUT flush_count bigint, OUT flush_bytes bigint, OUT flush_latency_hist bigint[]) RETURNS SETOF record LANGUAGE INTERNAL STABLE ROWS 10 AS 'pg_stat_get_wal_receiver';
+comment on function PG_CATALOG.pg_stat_get_wal_receiver() is 'statistics: information about WAL receiver';
+
+DROP FUNCTION IF EXISTS pg_catalog.pg_stat_get_wal_sender_compression(OUT pid bigint, OUT sender_pid integer, OUT compression text, OUT raw_bytes bigint, OUT compressed_bytes bigint, OUT compress_time bigint) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 9290;
+CREATE OR REPLACE FUNCTION pg_catalog.pg_stat_get_wal_sender_compression(OUT pid bigint, OUT sender_pid integer, OUT compression text, OUT raw_bytes bigint, OUT compressed_bytes bigint, OUT compress_time bigint) RETURNS SETOF record LANGUAGE INTERNAL STABLE ROWS 10 AS 'pg_stat_get_wal_sender_compression';
+comment on function PG_CATALOG.pg_stat_get_wal_sender_compression() is 'statistics: WAL compression of currently active replication';
+
+-- progress of asynchronous rollbacks split across undo workers
+DROP FUNCTION IF EXISTS pg_catalog.gs_stat_undo_rollback(OUT pid bigint, OUT xid xid, OUT part integer, OUT nparts integer, OUT undo_records bigint, OUT undo_blocks bigint, OUT start_time timestamp with time zone) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 9291;
+CREATE OR REPLACE FUNCTION pg_catalog.gs_stat_undo_rollback(OUT pid bigint, OUT xid xid, OUT part integer, OUT nparts integer, OUT undo_records bigint, OUT undo_blocks bigint, OUT start_time timestamp with time zone) RETURNS SETOF record LANGUAGE INTERNAL VOLATILE ROWS 10 AS 'gs_stat_undo_rollback';
+comment on function PG_CATALOG.gs_stat_undo_rollback() is 'statistics: progress of asynchronous rollbacks applied by undo workers';
+
+-- counters of subscription parallel apply workers
+DROP FUNCTION IF EXISTS pg_catalog.pg_stat_get_parallel_apply(IN subid oid, OUT subid oid, OUT pid integer, OUT worker_index integer, OUT transactions bigint, OUT dependency_waits bigint, OUT dependency_wait_time bigint, OUT commit_order_wait_time bigint, OUT retries bigint, OUT apply_lag bigint) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 9292;
+CREATE OR REPLACE FUNCTION pg_catalog.pg_stat_get_parallel_apply(IN subid oid, OUT subid oid, OUT pid integer, OUT worker_index integer, OUT transactions bigint, OUT dependency_waits bigint, OUT dependency_wait_time bigint, OUT commit_order_wait_time bigint, OUT retries bigint, OUT apply_lag bigint) RETURNS SETOF record LANGUAGE INTERNAL STABLE ROWS 10 AS 'pg_stat_get_parallel_apply';
+comment on function PG_CATALOG.pg_stat_get_parallel_apply(oid) is 'statistics: information about parallel apply workers of subscriptions';
+
+-- fast-path relation lock counters
+DROP FUNCTION IF EXISTS pg_catalog.gs_stat_fastpath_locks(OUT pid bigint, OUT slots_used integer, OUT fastpath_grants bigint, OUT group_full bigint, OUT transferred bigint) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 9293;
+CREATE OR REPLACE FUNCTION pg_catalog.gs_stat_fastpath_locks(OUT pid bigint, OUT slots_used integer, OUT fastpath_grants bigint, OUT group_full bigint, OUT transferred bigint) RETURNS SETOF record LANGUAGE INTERNAL VOLATILE ROWS 100 AS 'gs_stat_fastpath_locks';
+comment on function PG_CATALOG.gs_stat_fastpath_locks() is 'statistics: fast-path relation lock usage per backend';
+
+-- block prefetch of extreme RTO redo
+DROP FUNCTION IF EXISTS pg_catalog.local_redo_prefetch_stat(OUT worker_id integer, OUT prefetch_count bigint, OUT prefetch_skip_count bigint, OUT prefetch_ptr bigint, OUT prefetch_depth bigint) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 9294;
+CREATE OR REPLACE FUNCTION pg_catalog.local_redo_prefetch_stat(OUT worker_id integer, OUT prefetch_count bigint, OUT prefetch_skip_count bigint, OUT prefetch_ptr bigint, OUT prefetch_depth bigint) RETURNS SETOF record LANGUAGE INTERNAL VOLATILE ROWS 10 AS 'local_redo_prefetch_stat';
+comment on function PG_CATALOG.local_redo_prefetch_stat() is 'statistics: block prefetch of extreme RTO redo pipelines';
+
+-- queue histograms of extreme RTO redo
+DROP FUNCTION IF EXISTS pg_catalog.local_redo_queue_stat(OUT worker_id integer, OUT queue_depth_hist bigint[], OUT idle_wait_hist bigint[], OUT full_wait_hist bigint[]) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 9295;
+CREATE OR REPLACE FUNCTION pg_catalog.local_redo_queue_stat(OUT worker_id integer, OUT queue_depth_hist bigint[], OUT idle_wait_hist bigint[], OUT full_wait_hist bigint[]) RETURNS SETOF record LANGUAGE INTERNAL VOLATILE ROWS 10 AS 'local_redo_queue_stat';
+comment on function PG_CATALOG.local_redo_queue_stat() is 'statistics: queue histograms of extreme RTO redo pipelines';
@@ -197,6 +197,7 @@ typedef struct CopyStateData {
     bool freeze;
     bool header_line;     /* CSV header line? */
     bool force_quote_all; /* FORCE QUOTE *? */
+    int parallel_workers; /* COPY FROM workers requested by PARALLEL, 0 if none */
     bool without_escaping;
     List *trans_expr_list;  /* list of information for each transformed column */
     TupleDesc trans_tupledesc;  /* tuple desc after exec transform expression */
@@ -381,6 +382,9 @@ typedef struct InsertCopyLogInfoData {
 
 typedef struct InsertCopyLogInfoData* LogInsertState;
 
+/* upper bound of COPY FROM ... PARALLEL, same as the parallel_workers reloption */
+#define MAX_COPY_PARALLEL_WORKERS 32
+
 #define IS_CSV(cstate) ((cstate)->fileformat == FORMAT_CSV)
 #define IS_BINARY(cstate) ((cstate)->fileformat == FORMAT_BINARY)
 #define IS_FIXED(cstate) ((cstate)->fileformat == FORMAT_FIXED)
@@ -0,0 +1,161 @@
+/* -------------------------------------------------------------------------
+ *
+ * copy_scan.h
+ *	  Vectorized search for structural characters in COPY text/CSV input.
+ *
+ * The COPY line reader and attribute splitters look at their input one
+ * byte at a time, but almost every byte is ordinary data that they just
+ * pass along.  A CopyScanSet names the few bytes a scanner has to act on
+ * (newlines, delimiter, quote, escape, ...) and, optionally, every byte
+ * with the high bit set so that multibyte characters of encodings that
+ * embed ASCII in trailing bytes are still handled as a unit.
+ * CopyScanPlain() returns the length of the run of ordinary bytes at the
+ * start of a buffer, classifying COPY_SCAN_BLOCK bytes per step into a
+ * bitmask on x86-64 (SSE2) and aarch64 (NEON), so the caller can consume
+ * that run in one go and resume its byte loop on the interesting one.
+ *
+ * Portions Copyright (c) 2021, openGauss Contributors
+ *
+ * src/include/commands/copy_scan.h
+ *
+ * -------------------------------------------------------------------------
+ */
+#ifndef COPY_SCAN_H
+#define COPY_SCAN_H
+
+#include "port/pg_bitutils.h"
+
+#if defined(_M_AMD64) || defined(_M_X64) || defined(__amd64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define COPY_SCAN_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define COPY_SCAN_NEON
+#endif
+
+#define COPY_SCAN_MAX_CHARS 6
+#define COPY_SCAN_BLOCK 64 /* bytes classified per step */
+
+typedef struct CopyScanSet {
+    int nchars;
+    bool highbit; /* bytes >= 0x80 are structural too */
+    char chars[COPY_SCAN_MAX_CHARS];
+#if defined(COPY_SCAN_SSE2)
+    __m128i vchars[COPY_SCAN_MAX_CHARS];
+#elif defined(COPY_SCAN_NEON)
+    uint8x16_t vchars[COPY_SCAN_MAX_CHARS];
+#endif
+} CopyScanSet;
+
+static inline void CopyScanInit(CopyScanSet* set, bool highbit)
+{
+    set->nchars = 0;
+    set->highbit = highbit;
+}
+
+static inline void CopyScanAddChar(CopyScanSet* set, char c)
+{
+    for (int i = 0; i < set->nchars; i++) {
+        if (set->chars[i] == c)
+            return;
+    }
+    Assert(set->nchars < COPY_SCAN_MAX_CHARS);
+    set->chars[set->nchars] = c;
+#if defined(COPY_SCAN_SSE2)
+    set->vchars[set->nchars] = _mm_set1_epi8(c);
+#elif defined(COPY_SCAN_NEON)
+    set->vchars[set->nchars] = vdupq_n_u8((uint8)c);
+#endif
+    set->nchars++;
+}
+
+static inline bool CopyScanIsStructural(const CopyScanSet* set, char c)
+{
+    if (set->highbit && IS_HIGHBIT_SET(c))
+        return true;
+    for (int i = 0; i < set->nchars; i++) {
+        if (set->chars[i] == c)
+            return true;
+    }
+    return false;
+}
+
+#if defined(COPY_SCAN_SSE2)
+/* Returns a vector whose bytes have the high bit set where v is structural */
+static inline __m128i CopyScanMatch16(const CopyScanSet* set, __m128i v)
+{
+    __m128i hit = set->highbit ? v : _mm_setzero_si128();
+
+    for (int i = 0; i < set->nchars; i++)
+        hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, set->vchars[i]));
+    return hit;
+}
+
+static inline uint64 CopyScanMask16(const CopyScanSet* set, const char* p)
+{
+    return (uint64)(uint32)_mm_movemask_epi8(CopyScanMatch16(set, _mm_loadu_si128((const __m128i*)p)));
+}
+#elif defined(COPY_SCAN_NEON)
+/* Returns a vector that is 0xFF where v is structural and 0 elsewhere */
+static inline uint8x16_t CopyScanMatch16(const CopyScanSet* set, uint8x16_t v)
+{
+    uint8x16_t hit = set->highbit ? vcgeq_u8(v, vdupq_n_u8(0x80)) : vdupq_n_u8(0);
+
+    for (int i = 0; i < set->nchars; i++)
+        hit = vorrq_u8(hit, vceqq_u8(v, set->vchars[i]));
+    return hit;
+}
+
+/* NEON has no movemask; narrow each byte of the match vector to a nibble */
+static inline uint64 CopyScanNibbles16(uint8x16_t hit)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+}
+#endif
+
+/*
+ * Returns the number of leading bytes of buf[0 .. len) that are not in set,
+ * which is len if none of them is.
+ */
+static inline int CopyScanPlain(const CopyScanSet* set, const char* buf, int len)
+{
+    int pos = 0;
+
+#if defined(COPY_SCAN_SSE2)
+    while (len - pos >= COPY_SCAN_BLOCK) {
+        const char* p = buf + pos;
+        uint64 mask = CopyScanMask16(set, p) | (CopyScanMask16(set, p + 16) << 16) |
+                      (CopyScanMask16(set, p + 32) << 32) | (CopyScanMask16(set, p + 48) << 48);
+
+        if (mask != 0)
+            return pos + pg_rightmost_one_pos64(mask);
+        pos += COPY_SCAN_BLOCK;
+    }
+#elif defined(COPY_SCAN_NEON)
+    while (len - pos >= COPY_SCAN_BLOCK) {
+        const uint8* p = (const uint8*)buf + pos;
+        uint8x16_t hit[4];
+
+        hit[0] = CopyScanMatch16(set, vld1q_u8(p));
+        hit[1] = CopyScanMatch16(set, vld1q_u8(p + 16));
+        hit[2] = CopyScanMatch16(set, vld1q_u8(p + 32));
+        hit[3] = CopyScanMatch16(set, vld1q_u8(p + 48));
+        if (vmaxvq_u8(vorrq_u8(vorrq_u8(hit[0], hit[1]), vorrq_u8(hit[2], hit[3]))) != 0) {
+            for (int i = 0; i < 4; i++) {
+                uint64 nibbles = CopyScanNibbles16(hit[i]);
+
+                if (nibbles != 0)
+                    return pos + i * 16 + pg_rightmost_one_pos64(nibbles) / 4;
+            }
+        }
+        pos += COPY_SCAN_BLOCK;
+    }
+#endif
+
+    /* tail shorter than a block, or no vector support */
+    while (pos < len && !CopyScanIsStructural(set, buf[pos]))
+        pos++;
+    return pos;
+}
+
+#endif /* COPY_SCAN_H */
@@ -150,10 +150,13 @@ typedef struct knl_instance_attr_storage {
     int NPcaBuffers;
     int NSegBuffers;
     int cstore_buffers;
+    int clog_buffers;
+    int csnlog_buffers;
     int MaxSendSize;
     int max_prepared_xacts;
     int max_locks_per_xact;
     int max_predicate_locks_per_xact;
+    int lwlock_max_spins;
     int64 walwriter_sleep_threshold;
     int num_xloginsert_locks;
     int walwriter_cpu_bind;
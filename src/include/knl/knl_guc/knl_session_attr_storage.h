@@ -63,6 +63,7 @@ typedef struct knl_session_attr_storage {
     bool fullPageWrites;
     bool Log_connections;
     bool autovacuum_start_daemon;
+    bool recovery_prefetch;
 #ifdef LOCK_DEBUG
     bool Trace_locks;
     bool Trace_userlocks;
@@ -101,10 +102,12 @@ typedef struct knl_session_attr_storage {
     int LockWaitUpdateTimeout;
     int max_standby_archive_delay;
     int max_standby_streaming_delay;
+    int standby_read_lsn_timeout;
     int wal_receiver_status_interval;
     int wal_receiver_timeout;
     int wal_receiver_connect_timeout;
     int wal_receiver_connect_retries;
+    int wal_receiver_compression;
     int basebackup_timeout;
     int max_loaded_cudesc;
     int num_temp_buffers;
@@ -187,6 +190,7 @@ typedef struct knl_session_attr_storage {
     char* XLogArchiveCommand;
     char* XLogArchiveDest;
     char* default_tablespace;
+    int default_toast_compression;
     char* temp_tablespaces;
     char* XactIsoLevel_string;
     char* SyncRepStandbyNames;
@@ -240,6 +244,7 @@ typedef struct knl_session_attr_storage {
     /* for undo */
     int undo_space_limit_size;
     int undo_limit_size_transaction;
+    int max_undo_workers_per_rollback;
 
     bool enable_recyclebin;
     int recyclebin_retention_time;
@@ -259,8 +264,12 @@ typedef struct knl_session_attr_storage {
     knl_session_attr_dcf dcf_attr;
     int catchup2normal_wait_time;
     int max_sync_workers_per_subscription;
+    int max_parallel_apply_workers_per_subscription;
+    int max_parallel_sync_workers_per_table;
+    int min_parallel_sync_table_size;
 
     char* logical_decode_options_default_str;
+    char* standby_read_lsn;
     void* logical_decode_options_default;
 
     int logical_sender_timeout;
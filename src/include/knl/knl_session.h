@@ -430,8 +430,6 @@ typedef struct knl_u_parser_context {
 
     void* param_info;
 
-    StringInfo param_message;
-
     MemoryContext ddl_pbe_context;
 
     bool in_package_function_compile;
@@ -655,6 +653,9 @@ typedef struct knl_u_utils_context {
     /* Current xact's exported snapshots (a list of ExportedSnapshot structs) */
     List* exportedSnapshots;
 
+    /* XLogRecPtr the next snapshot on hot standby must wait for, see standby_read_lsn */
+    uint64 standbyReadLSN;
+
     uint8_t g_output_version; /* Set the default output schema. */
 
     int XactIsoLevel;
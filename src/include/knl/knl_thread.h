@@ -2154,6 +2154,17 @@ typedef struct knl_t_basebackup_context {
     char g_xlog_location[MAXPGPATH];
 
     char* buf_block;
+
+    /* changed blocks of an incremental backup, keyed by relation fork */
+    struct HTAB* incremental_blocks;
+    /* tablespace oid of the directory currently being sent */
+    Oid send_spcnode;
+    uint64 incremental_blocks_sent;
+    uint64 incremental_blocks_skipped;
+
+    /* stream id within a parallel base backup: 0 if not parallel, 1 for the main stream */
+    int parallel_backup_id;
+    XLogRecPtr parallel_backup_start;
 } knl_t_basebackup_context;
 
 typedef struct knl_t_datarcvwriter_context {
@@ -2183,6 +2194,15 @@ typedef struct knl_t_libwalreceiver_context {
     char* shared_storage_buf;
     char* shared_storage_read_buf;
     char* decompressBuf;
+    /* streaming decompression of 'z' messages, see walprotocol.h */
+    int walCompression;
+    void* walDecompressStream; /* ZSTD_DCtx */
+    char* walDecompressDict;   /* LZ4 dictionary: tail of the decompressed stream */
+    int walDecompressDictSize;
+    bool walDecompressReady;   /* got the reset message of the current stream */
+    uint64 walDecompressRawBytes;
+    uint64 walDecompressBytes;
+    uint64 walDecompressTime;  /* in microseconds */
     XLogReaderState* xlogreader;
     LibpqrcvConnectParam connect_param;
 } knl_t_libwalreceiver_context;
@@ -2439,6 +2459,16 @@ typedef struct knl_t_walsender_context {
     char *xlogReadBuf;
     char *compressBuf;
 
+    /* streaming compression of 'z' messages, see walprotocol.h */
+    int walCompression;         /* WalCompressionAlgorithm asked for by the standby */
+    void *walCompressStream;    /* LZ4_stream_t or ZSTD_CCtx */
+    char *walCompressDict;      /* LZ4 dictionary kept between messages */
+    bool walCompressReset;      /* the next 'z' message starts over */
+    XLogSegNo walCompressSegNo; /* segment of the last 'z' message */
+    uint64 walCompressRawBytes;
+    uint64 walCompressBytes;
+    uint64 walCompressTime;     /* in microseconds */
+
     /* flag set in WalSndCheckTimeout */
     bool isWalSndSendTimeoutMessage;
 
@@ -3333,6 +3363,15 @@ typedef struct knl_t_apply_worker_context {
     List *tableStates;
     XLogRecPtr remoteFinalLsn;
     CommitSeqNo curRemoteCsn;
+    /* parallel apply group led by this apply worker, NULL if applying serially */
+    ParallelApplyGroup *parallelApplyGroup;
+    /* workers helping this table sync worker copy the table, NULL if copying alone */
+    ParallelSyncGroup *parallelSyncGroup;
+    /* between STREAM START and STREAM STOP of the in-progress transaction streamXid */
+    bool inStreamedTransaction;
+    TransactionId streamXid;
+    /* spool files of streamed transactions not committed yet, by toplevel xid */
+    HTAB *streamXacts;
 } knl_t_apply_worker_context;
 
 typedef struct knl_t_publication_context {
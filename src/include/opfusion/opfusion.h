@@ -58,6 +58,17 @@ extern void AtEOXact_OpfusionReuse();
  * Local variables be saved into struct OpFusionLocaleVariable, and we access the local variables
  * from object m_local, and m_local's context is under session context.
  */
+/*
+ * Input and receive function of one bind parameter, indexed by its format
+ * code (0 text, 1 binary).  Runs of Bind messages for the same statement
+ * look these up once instead of once per message.
+ */
+typedef struct OpFusionParamIO {
+    bool valid[2];
+    Oid ioparam[2];
+    FmgrInfo func[2];
+} OpFusionParamIO;
+
 class OpFusion : public BaseObject {
 public:
     OpFusion(MemoryContext context, CachedPlanSource* psrc, List* plantree_list);
@@ -262,6 +273,9 @@ public:
         ResourceOwner m_resOwner;
 
         bool m_has_init_param;
+
+        /* per-parameter I/O functions kept across binds, see updatePreAllocParamter */
+        struct OpFusionParamIO* m_paramIO;
     };
 
     OpFusionLocaleVariable m_local;
@@ -133,6 +133,7 @@ PG_KEYWORD("compatible_illegal_chars", COMPATIBLE_ILLEGAL_CHARS, UNRESERVED_KEYW
 PG_KEYWORD("complete", COMPLETE, UNRESERVED_KEYWORD)
 PG_KEYWORD("completion", COMPLETION, UNRESERVED_KEYWORD)
 PG_KEYWORD("compress", COMPRESS, UNRESERVED_KEYWORD)
+PG_KEYWORD("compression", COMPRESSION, UNRESERVED_KEYWORD)
 PG_KEYWORD("concurrently", CONCURRENTLY, TYPE_FUNC_NAME_KEYWORD)
 PG_KEYWORD("condition", CONDITION, UNRESERVED_KEYWORD)
 PG_KEYWORD("configuration", CONFIGURATION, UNRESERVED_KEYWORD)
@@ -1232,6 +1232,7 @@ typedef enum WaitState {
     STATE_WAIT_SYNC_BGWORKERS,
     STATE_STANDBY_READ_RECOVERY_CONFLICT,
     STATE_STANDBY_GET_SNAPSHOT,
+    STATE_WAIT_XLOG_REPLAY,
     STATE_WAIT_NUM  // MUST be last, DO NOT use this value.
 } WaitState;
 
@@ -1303,6 +1304,8 @@ typedef enum WaitEventIO {
     WAIT_EVENT_SLRU_READ,
     WAIT_EVENT_SLRU_SYNC,
     WAIT_EVENT_SLRU_WRITE,
+    WAIT_EVENT_CLOG_READ,
+    WAIT_EVENT_CSNLOG_READ,
     WAIT_EVENT_TWOPHASE_FILE_READ,
     WAIT_EVENT_TWOPHASE_FILE_SYNC,
     WAIT_EVENT_TWOPHASE_FILE_WRITE,
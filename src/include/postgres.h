@@ -396,7 +396,8 @@ typedef enum {
 #define VARDATA_1B(PTR) (((varattrib_1b*)(PTR))->va_data)
 #define VARDATA_1B_E(PTR) (((varattrib_1b_e*)(PTR))->va_data)
 
-#define VARRAWSIZE_4B_C(PTR) (((varattrib_4b*)(PTR))->va_compressed.va_rawsize)
+/* the top two bits of va_rawsize name the compression method, see access/toast_compression.h */
+#define VARRAWSIZE_4B_C(PTR) (((varattrib_4b*)(PTR))->va_compressed.va_rawsize & 0x3FFFFFFF)
 
 /* Externally visible macros */
 
@@ -0,0 +1,46 @@
+/* -------------------------------------------------------------------------
+ *
+ * incremental_backup.h
+ *	  On-disk format of the per-relation files sent by an incremental
+ *	  base backup, shared by the walsender and gs_basebackup.
+ *
+ * An incremental base backup replaces each unchanged or partially changed
+ * relation segment "<name>" with a member called "INCREMENTAL.<name>" laid
+ * out as
+ *
+ *	  IncrementalFileHeader
+ *	  BlockNumber blocks[nblocks]	(segment-relative, ascending)
+ *	  char pages[nblocks][BLCKSZ]
+ *
+ * Applying it to the prior backup truncates the segment to truncBlocks
+ * blocks and overwrites the listed blocks with the carried images. A segment
+ * the prior backup lacks was created after the incremental backup started;
+ * it is created zero-filled and WAL replay fills it in.
+ *
+ * The backup_label of an incremental backup carries an extra line with the
+ * incremental start location, which has to be the START WAL LOCATION of the
+ * prior backup it is applied to.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * IDENTIFICATION
+ *	  src/include/replication/incremental_backup.h
+ *
+ * -------------------------------------------------------------------------
+ */
+#ifndef INCREMENTAL_BACKUP_H
+#define INCREMENTAL_BACKUP_H
+
+#define INCREMENTAL_PREFIX "INCREMENTAL."
+#define INCREMENTAL_PREFIX_LEN (sizeof(INCREMENTAL_PREFIX) - 1)
+#define INCREMENTAL_MAGIC 0x49434231 /* "ICB1" */
+#define INCREMENTAL_LABEL_LINE "INCREMENTAL FROM LOCATION: "
+
+typedef struct IncrementalFileHeader {
+    uint32 magic;
+    uint32 nblocks;     /* number of block images carried */
+    uint32 truncBlocks; /* segment length in blocks at backup time */
+    uint32 reserved;
+} IncrementalFileHeader;
+
+#endif /* INCREMENTAL_BACKUP_H */
@@ -32,6 +32,7 @@ typedef struct LibpqrcvConnectParam {
     XLogRecPtr startpoint;
     char* slotname;
     int channel_identifier;
+    int compression;        /* WalCompressionAlgorithm asked for physical streaming */
 
     /* for logical replication slot */
     bool logical;
@@ -39,6 +40,7 @@ typedef struct LibpqrcvConnectParam {
     List *publicationNames; /* String list of publications */
     bool binary;            /* Ask publisher to use binary */
     bool useSnapshot;       /* Use snapshot or not */
+    bool streaming;         /* Ask publisher to stream in-progress transactions */
 }LibpqrcvConnectParam;
 
 /*
@@ -65,6 +65,13 @@ typedef struct LogicalDecodingContext {
      */
     bool fast_forward;
 
+    /*
+     * Does the output plugin support streaming of in-progress transactions,
+     * and did the client ask for it?  Large transactions are then sent before
+     * their commit instead of being spilled to disk.
+     */
+    bool streaming;
+
     OutputPluginCallbacks callbacks;
     OutputPluginOptions options;
 
@@ -39,6 +39,8 @@ typedef struct LogicalRepRelMapEntry
 extern void logicalrep_relmap_update(LogicalRepRelation *remoterel);
 extern LogicalRepRelMapEntry *logicalrep_rel_open(LogicalRepRelId remoteid, LOCKMODE lockmode);
 extern void logicalrep_rel_close(LogicalRepRelMapEntry *rel, LOCKMODE lockmode);
+extern LogicalRepRelation *logicalrep_get_remoterel(LogicalRepRelId remoteid);
+extern void logicalrep_relmap_forget_open(void);
 
 #endif   /* LOGICALRELATION_H */
 
@@ -86,7 +86,7 @@ extern void replorigin_advance(RepOriginId node, XLogRecPtr remote_commit, XLogR
     bool wal_log);
 
 extern void replorigin_session_advance(XLogRecPtr remote_commit, XLogRecPtr local_commit);
-extern void replorigin_session_setup(RepOriginId node);
+extern void replorigin_session_setup(RepOriginId node, ThreadId acquiredBy);
 extern XLogRecPtr replorigin_session_get_progress(bool flush);
 
 /* Checkpoint/Startup integration */
@@ -78,6 +78,34 @@ typedef void (*LogicalDecodeAbortCB)(struct LogicalDecodingContext* ctx, Reorder
  */
 typedef void (*LogicalDecodePrepareCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
 
+/*
+ * Called when starting to stream a block of changes of an in-progress
+ * transaction, before its commit record has been decoded.
+ */
+typedef void (*LogicalDecodeStreamStartCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+
+/*
+ * Called when a block of streamed changes of an in-progress transaction ends.
+ */
+typedef void (*LogicalDecodeStreamStopCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+
+/*
+ * Called to discard the changes streamed for an aborted (sub)transaction.
+ */
+typedef void (*LogicalDecodeStreamAbortCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+
+/*
+ * Called to apply the changes streamed for a now committed transaction.
+ */
+typedef void (*LogicalDecodeStreamCommitCB)(
+    struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
+
+/*
+ * Callback for every individual change of a streamed in-progress transaction.
+ */
+typedef void (*LogicalDecodeStreamChangeCB)(
+    struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn, Relation relation, ReorderBufferChange* change);
+
 /*
  * Called to shutdown an output plugin.
  */
@@ -100,6 +128,12 @@ typedef struct OutputPluginCallbacks {
     LogicalDecodePrepareCB prepare_cb;
     LogicalDecodeShutdownCB shutdown_cb;
     LogicalDecodeFilterByOriginCB filter_by_origin_cb;
+    /* streaming of in-progress transactions, all or none must be set */
+    LogicalDecodeStreamStartCB stream_start_cb;
+    LogicalDecodeStreamStopCB stream_stop_cb;
+    LogicalDecodeStreamAbortCB stream_abort_cb;
+    LogicalDecodeStreamCommitCB stream_commit_cb;
+    LogicalDecodeStreamChangeCB stream_change_cb;
 } OutputPluginCallbacks;
 
 typedef struct ParallelOutputPluginCallbacks {
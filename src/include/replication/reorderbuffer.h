@@ -294,6 +294,15 @@ typedef struct ReorderBufferTXN {
      */
     dlist_node node;
     Size size;
+
+    /*
+     * Have changes of this toplevel transaction been streamed to the output
+     * plugin before its commit?  If so, the snapshot and command id needed
+     * to decode the next block of changes are kept here.
+     */
+    bool streamed;
+    Snapshot stream_snapshot;
+    CommandId stream_command_id;
 } ReorderBufferTXN;
 
 /* so we can define the callbacks used inside struct ReorderBuffer itself */
@@ -315,6 +324,20 @@ typedef void (*ReorderBufferAbortCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
 /* prepare callback signature */
 typedef void (*ReorderBufferPrepareCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
 
+/* start/stop streaming a block of changes of an in-progress transaction */
+typedef void (*ReorderBufferStreamStartCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
+typedef void (*ReorderBufferStreamStopCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
+
+/* discard the streamed changes of an aborted (sub)transaction */
+typedef void (*ReorderBufferStreamAbortCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
+
+/* the streamed transaction committed */
+typedef void (*ReorderBufferStreamCommitCB)(ReorderBuffer* rb, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
+
+/* change of a streamed in-progress transaction */
+typedef void (*ReorderBufferStreamChangeCB)(
+    ReorderBuffer* rb, ReorderBufferTXN* txn, Relation relation, ReorderBufferChange* change);
+
 
 struct ReorderBuffer {
     /*
@@ -353,6 +376,21 @@ struct ReorderBuffer {
     ReorderBufferAbortCB abort;
     ReorderBufferPrepareCB prepare;
 
+    /*
+     * Callbacks to be called when streaming in-progress transactions.
+     */
+    ReorderBufferStreamStartCB stream_start;
+    ReorderBufferStreamStopCB stream_stop;
+    ReorderBufferStreamAbortCB stream_abort;
+    ReorderBufferStreamCommitCB stream_commit;
+    ReorderBufferStreamChangeCB stream_change;
+
+    /*
+     * Oldest toplevel xid that may be streamed. Older transactions may have
+     * subxacts whose assignment was never logged.
+     */
+    TransactionId stream_min_xid;
+
     /*
      * Pointer that will be passed untouched to the callbacks.
      */
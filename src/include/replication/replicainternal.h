@@ -213,6 +213,16 @@ typedef enum replauthmode{
     REPL_AUTH_UUID /* uuid auth */
 } ReplAuthMode;
 
+/*
+ * streaming compression of physical WAL replication; the data sender, which
+ * ships pages and CUs written without WAL, still sends them as they are
+ */
+typedef enum WalCompressionAlgorithm {
+    WAL_COMPRESSION_NONE = 0, /* ship WAL records as they are */
+    WAL_COMPRESSION_LZ4,
+    WAL_COMPRESSION_ZSTD
+} WalCompressionAlgorithm;
+
 extern bool data_catchup;
 extern bool wal_catchup;
 extern BuildMode build_mode;
@@ -174,6 +174,9 @@ typedef struct ReplicationSlot {
     bool is_recovery;
     char* extra_content;
     TimestampTz last_xmin_change_time;
+
+    /* does the active decoder stream in-progress transactions */
+    bool streaming;
 } ReplicationSlot;
 
 typedef struct ArchiveSlotConfig {
@@ -218,6 +221,9 @@ typedef struct ArchiveSlotConfig {
  * Shared memory control area for all of replication slots.
  */
 typedef struct ReplicationSlotCtlData {
+    /* number of active slots whose decoder streams in-progress transactions */
+    pg_atomic_uint32 nstreaming;
+
     ReplicationSlot replication_slots[1];
 } ReplicationSlotCtlData;
 /*
@@ -274,6 +280,8 @@ extern bool IsReplicationSlotActive(const char *name);
 extern bool IsLogicalReplicationSlot(const char *name);
 bool ReplicationSlotFind(const char* name);
 extern void ReplicationSlotRelease(void);
+extern void ReplicationSlotMarkStreaming(void);
+extern bool ReplicationSlotsStreaming(void);
 extern void ReplicationSlotSave(void);
 extern void ReplicationSlotMarkDirty(void);
 extern void CreateSlotOnDisk(ReplicationSlot* slot);
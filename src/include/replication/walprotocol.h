@@ -111,6 +111,21 @@ typedef struct {
     bool catchup;
 } WalDataMessageHeader;
 
+/*
+ * Streamed compressed WAL records (message type 'z'), sent instead of 'w' when
+ * the standby asked for it with the "compression" option of START_REPLICATION.
+ * The header is followed by one flag byte and the compressed data.  Unlike 'C',
+ * each message is compressed against what was sent before it, so the receiver
+ * must decompress the messages in order.  The sender starts over with an empty
+ * dictionary at each WAL segment, and sets WAL_COMPRESSION_RESET to tell the
+ * receiver to do the same.  Messages that don't compress are sent as 'w', and
+ * the next 'z' message starts over too.
+ */
+#define WAL_COMPRESSION_RESET 0x01
+
+/* LZ4 references at most the last 64kB of the stream */
+#define WAL_COMPRESSION_LZ4_DICT_SIZE (64 * 1024)
+
 /*
  * Header for a data replication message (message type 'd').  This is wrapped within
  * a CopyData message at the FE/BE protocol level.
@@ -41,6 +41,10 @@
 #define IS_PAUSE_BY_TARGET_BARRIER 0x00000001
 #define IS_CANCEL_LOG_CTRL 0x00000010
 
+/* receive-to-flush latency histogram: <64us, 64us, 128us .. 64ms+ */
+#define WALRCV_FLUSH_HIST_BUCKETS 12
+#define WALRCV_FLUSH_HIST_UNIT 64
+
 #ifdef ENABLE_MULTIPLE_NODES
 #define AM_HADR_CN_WAL_RECEIVER (t_thrd.postmaster_cxt.HaShmData->is_cross_region && \
             t_thrd.postmaster_cxt.HaShmData->current_mode == STANDBY_MODE && IS_PGXC_COORDINATOR)
@@ -101,6 +105,8 @@ typedef struct WalRcvCtlBlock {
     XLogRecPtr walStart;
     int64 walWriteOffset;
     int64 walFreeOffset;
+    TimestampTz oldestRecvTime; /* receipt time of the oldest data in the buffer */
+    TimestampTz latestRecvTime; /* receipt time of the newest data in the buffer */
     bool walIsWriting;
     slock_t mutex;
 
@@ -194,6 +200,15 @@ typedef struct WalRcvData {
     /* recvwriter write queue position (local queue) */
     DataQueuePtr local_write_pos;
 
+    /*
+     * WAL compression asked of the primary, the bytes decompressed from 'z'
+     * messages, the bytes received for them and microseconds spent on it.
+     */
+    int walCompression;
+    uint64 walDecompressRawBytes;
+    uint64 walDecompressBytes;
+    uint64 walDecompressTime;
+
     int dummyStandbySyncPercent;
     /* Flag if failed to connect to dummy when failover */
     bool dummyStandbyConnectFailed;
@@ -234,6 +249,15 @@ typedef struct WalRcvData {
     struct ArchiveSlotConfig *archive_slot;
     uint32 rcvDoneFromShareStorage;
     uint32 shareStorageTerm;
+
+    /*
+     * Time from receipt of the oldest byte of a flush batch to the end of its
+     * fsync, one count per flush, in log2 buckets of WALRCV_FLUSH_HIST_UNIT
+     * us. Only updated with WALWriteLock held.
+     */
+    uint64 flushLatencyHist[WALRCV_FLUSH_HIST_BUCKETS];
+    uint64 flushCount;
+    uint64 flushBytes;
 } WalRcvData;
 
 typedef struct WalReceiverFunc {
@@ -327,6 +351,7 @@ extern bool HasBuildReason();
 extern void GetMinLsnRecordsFromHadrCascadeStandby(void);
 extern void XLogWalRecordsPreProcess(char **buf, Size *len, WalDataMessageHeader *msghdr);
 extern int XLogDecompression(const char *buf, Size len, XLogRecPtr dataStart);
+extern int XLogStreamDecompression(const char *buf, Size len, XLogRecPtr dataStart);
 void GetPasswordForHadrStreamingReplication(char user[], char password[]);
 extern char* remove_ipv6_zone(char* addr_src, char* addr_dest, int len);
 
@@ -60,6 +60,7 @@ extern bool IsAllBuildSenderExit();
 extern bool WalSegmemtRemovedhappened;
 extern AlarmCheckResult WalSegmentsRemovedChecker(Alarm* alarm, AlarmAdditionalParam* additionalParam);
 extern Datum pg_stat_get_wal_senders(PG_FUNCTION_ARGS);
+extern Datum pg_stat_get_wal_sender_compression(PG_FUNCTION_ARGS);
 extern Datum get_paxos_replication_info(PG_FUNCTION_ARGS);
 extern Datum gs_paxos_stat_replication(PG_FUNCTION_ARGS);
 extern Tuplestorestate* BuildTupleResult(FunctionCallInfo fcinfo, TupleDesc* tupdesc);
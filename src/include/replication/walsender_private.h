@@ -117,6 +117,15 @@ typedef struct WalSnd {
     ReplConnInfo wal_sender_channel;
     int channel_get_replc;
 
+    /*
+     * WAL compression negotiated with the standby and the bytes read from WAL,
+     * bytes sent for them and microseconds spent compressing since then.
+     */
+    int walCompression;
+    uint64 walCompressRawBytes;
+    uint64 walCompressBytes;
+    uint64 walCompressTime;
+
     /* Protects shared variables shown above. */
     slock_t mutex;
 
@@ -165,6 +174,25 @@ typedef struct WalSnd {
 extern THR_LOCAL WalSnd* MyWalSnd;
 
 /* There is one WalSndCtl struct for the whole database cluster */
+/*
+ * Coordination of a base backup sent over several connections. Each stream
+ * walks the whole data directory and sends only the relation files whose
+ * path hashes to a bucket it owns; buckets go to whichever stream reaches
+ * them first. The main stream waits for the helpers before ending the backup.
+ */
+#define PARALLEL_BACKUP_BUCKETS 16384
+
+typedef struct ParallelBackupCtl {
+    slock_t mutex;
+    bool inUse;
+    XLogRecPtr startptr; /* start location identifying the backup, invalid until ready */
+    int nhelpers;        /* helper streams the main stream waits for */
+    int attached;
+    int finished;
+    bool failed;
+    pg_atomic_uint32 owner[PARALLEL_BACKUP_BUCKETS]; /* stream id owning each bucket, 0 if none */
+} ParallelBackupCtl;
+
 typedef struct WalSndCtlData {
     /*
      * Synchronous replication queue with one queue per request type.
@@ -222,6 +250,8 @@ typedef struct WalSndCtlData {
     /* Protects shared variables of all walsnds. */
     slock_t mutex;
 
+    ParallelBackupCtl parallelBackup;
+
     WalSnd walsnds[FLEXIBLE_ARRAY_MEMBER]; /* VARIABLE LENGTH ARRAY */
 } WalSndCtlData;
 
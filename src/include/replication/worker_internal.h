@@ -13,8 +13,27 @@
 #define WORKER_INTERNAL_H
 
 #include "catalog/pg_subscription.h"
+#include "lib/stringinfo.h"
 #include "storage/lock/lock.h"
 
+/* Shared state of a leader apply worker and its parallel apply workers. */
+typedef struct ParallelApplyGroup ParallelApplyGroup;
+/* Shared state of a table sync worker and the workers helping it copy the table. */
+typedef struct ParallelSyncGroup ParallelSyncGroup;
+
+/*
+ * Counters of a parallel apply worker, written by the worker only and shown by
+ * pg_stat_get_parallel_apply().  Times are in milliseconds.
+ */
+typedef struct ParallelApplyStats {
+    uint64 txns;
+    uint64 depWaits;
+    uint64 depWaitTime;
+    uint64 orderWaitTime;
+    uint64 retries;
+    int64 lag; /* from remote commit to local commit of the last transaction */
+} ParallelApplyStats;
+
 typedef struct LogicalRepWorker
 {
     /* Increased everytime the slot is tabken by new worker */
@@ -40,6 +59,14 @@ typedef struct LogicalRepWorker
 
     TimestampTz workerLaunchTime;
 
+    /* Used for parallel apply, NULL and -1 unless this is a parallel apply worker. */
+    ParallelApplyGroup *applyGroup;
+    int applyGroupIdx;
+    ParallelApplyStats applyStats;
+
+    /* Used for parallel initial copy, NULL unless this is a parallel sync worker. */
+    ParallelSyncGroup *syncGroup;
+
     /* Stats. */
     XLogRecPtr last_lsn;
     TimestampTz last_send_time;
@@ -59,7 +86,8 @@ typedef struct ApplyLauncherShmStruct {
 extern void logicalrep_worker_attach();
 extern LogicalRepWorker *logicalrep_worker_find(Oid subid, Oid relid, bool only_running);
 extern List *logicalrep_workers_find(Oid subid, bool only_running);
-extern void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid);
+extern bool logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid,
+    ParallelApplyGroup *applyGroup, int applyGroupIdx, ParallelSyncGroup *syncGroup);
 extern void logicalrep_worker_stop(Oid subid, Oid relid);
 extern void logicalrep_worker_wakeup(Oid subid, Oid relid);
 extern void logicalrep_worker_wakeup_ptr(LogicalRepWorker *worker);
@@ -72,7 +100,24 @@ extern List* ConninfoToDefList(const char *conn);
 extern char *LogicalRepSyncTableStart(XLogRecPtr *origin_startpos);
 void process_syncing_tables(XLogRecPtr current_lsn);
 void invalidate_syncing_table_states(Datum arg, int cacheid, uint32 hashvalue);
+extern void ParallelSyncWorkerMain(void);
+
+extern void ApplyWorkerDispatchMessage(char *data, int len);
+
+extern void ParallelApplyStart(void);
+extern bool ParallelApplyInTxn(void);
+extern void ParallelApplyBeginTxn(XLogRecPtr finalLsn, CommitSeqNo csn);
+extern bool ParallelApplyAddChange(StringInfo s);
+extern void ParallelApplyAddRelation(StringInfo s);
+extern void ParallelApplyCommitTxn(XLogRecPtr endLsn, TimestampTz commitTime);
+extern void ParallelApplySerializeTxn(void);
+extern bool ParallelApplyPopCommitted(XLogRecPtr *remoteEnd, XLogRecPtr *localEnd);
+extern bool ParallelApplyHasPending(void);
+extern void ParallelApplyWaitAll(void);
+extern void ParallelApplyWorkerMain(void);
 
 #define AM_TABLESYNC_WORKER (OidIsValid(t_thrd.applyworker_cxt.curWorker->relid))
+#define AM_PARALLEL_APPLY_WORKER (t_thrd.applyworker_cxt.curWorker->applyGroup != NULL)
+#define AM_PARALLEL_SYNC_WORKER (t_thrd.applyworker_cxt.curWorker->syncGroup != NULL)
 
 #endif /* WORKER_INTERNAL_H */
@@ -263,6 +263,7 @@ void shared_buffer_write_error_callback(void *arg);
  * prototypes for functions in bufmgr.c
  */
 extern void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum);
+extern bool PrefetchBufferWithoutRelcache(const RelFileNode &rnode, ForkNumber forkNum, BlockNumber blockNum);
 extern void PageRangePrefetch(
     Relation reln, ForkNumber forkNum, BlockNumber blockNum, int32 n, uint32 flags, uint32 col);
 extern void PageListPrefetch(
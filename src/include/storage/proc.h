@@ -77,6 +77,16 @@ struct XidCache {
  */
 #define FP_LOCK_SLOTS_PER_BACKEND ((uint32)g_instance.attr.attr_storage.num_internal_lock_partitions[FASTPATH_PART])
 #define FP_LOCK_SLOTS_PER_LOCKBIT 20
+
+/*
+ * The slots are split into groups of FP_LOCK_SLOTS_PER_GROUP, the last one
+ * taking the remainder, and a relation's lock can only be kept in the group
+ * its tag hashes to.  Finding or releasing it then scans one group instead of
+ * every slot, so FASTPATH_PART can be raised to thousands for queries over
+ * many partitions.  With the default number of slots there is one group.
+ */
+#define FP_LOCK_SLOTS_PER_GROUP 16
+#define FP_LOCK_GROUPS_PER_BACKEND Max(FP_LOCK_SLOTS_PER_BACKEND / FP_LOCK_SLOTS_PER_GROUP, 1)
 #define FP_LOCKBIT_NUM (((FP_LOCK_SLOTS_PER_BACKEND - 1) / FP_LOCK_SLOTS_PER_LOCKBIT) + 1)
 #define FAST_PATH_SET_LOCKBITS_ZERO(proc)                       \
     do {                                                        \
@@ -188,6 +198,9 @@ struct PGPROC {
     SHM_QUEUE syncRepLinks; /* list link if process is in syncrep queue */
     XLogRecPtr syncSetConfirmedLSN;     /* set confirmed LSN for SyncRepWaitForLSN */
 
+    /* waiting on hot standby for redo to replay up to this LSN, see WaitForXLogReplay */
+    XLogRecPtr replayWaitLSN;
+
     XLogRecPtr waitPaxosLSN;    /* waiting for this LSN or higher on paxos callback */
     int syncPaxosState;  /* wait state for sync paxos, reuse syncRepState defines */
     SHM_QUEUE syncPaxosLinks;  /* list link if process is in syncpaxos queue */
@@ -276,6 +289,13 @@ struct PGPROC {
     bool fpVXIDLock;                                /* are we holding a fast-path VXID lock? */
     LocalTransactionId fpLocalTransactionId;        /* lxid for fast-path VXID
                                                      * lock */
+    /*
+     * Fast-path counters, only written by this backend while holding
+     * backendLock and reported by gs_stat_fastpath_locks().
+     */
+    uint64 fpGrants;        /* relation locks granted through the fast path */
+    uint64 fpGroupFull;     /* eligible locks whose slot group was full */
+    uint64 fpTransferred;   /* fast-path locks of others moved to the main table */
     /* The proc which block cur proc */
     PROCLOCK* blockProcLock;
 
@@ -1455,6 +1455,7 @@ extern Datum show_all_settings(PG_FUNCTION_ARGS);
 
 /* lockfuncs.c */
 extern Datum pg_lock_status(PG_FUNCTION_ARGS);
+extern Datum gs_stat_fastpath_locks(PG_FUNCTION_ARGS);
 extern Datum pg_advisory_lock_int8(PG_FUNCTION_ARGS);
 extern Datum pg_advisory_xact_lock_int8(PG_FUNCTION_ARGS);
 extern Datum pg_advisory_lock_shared_int8(PG_FUNCTION_ARGS);
@@ -1479,6 +1480,8 @@ extern Datum pg_advisory_unlock_all(PG_FUNCTION_ARGS);
 
 /* pgstatfuncs.cpp */
 extern Datum gs_stack(PG_FUNCTION_ARGS);
+extern Datum local_redo_prefetch_stat(PG_FUNCTION_ARGS);
+extern Datum local_redo_queue_stat(PG_FUNCTION_ARGS);
 
 /* txid.c */
 extern Datum txid_snapshot_in(PG_FUNCTION_ARGS);
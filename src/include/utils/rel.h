@@ -387,6 +387,7 @@ typedef struct StdRdOptions {
     char* storage_type; /*table access method kind */
     char* orientation; /* row-store or column-store */
     char        *indexsplit; /* page split method */
+    char* tree_flavor; /* index tree of a MOT index: masstree or art */
     char* ttl; /* time to live for tsdb data management */
     char* period; /* partition range for tsdb data management */
     char* partition_interval; /* partition interval for streaming contquery table */
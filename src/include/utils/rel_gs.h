@@ -159,6 +159,9 @@ typedef struct RelationMetaData {
 #define INDEXSPLIT_OPT_DEFAULT     "default"
 #define INDEXSPLIT_OPT_INSERTPT    "insertpt"
 
+#define TREE_FLAVOR_OPT_MASSTREE   "masstree"
+#define TREE_FLAVOR_OPT_ART        "art"
+
 #define TIME_ONE_DAY "1 DAY"
 #define TIME_ONE_WEEK "1 WEEK"
 #define TIME_ONE_MONTH "1 MONTH"
@@ -0,0 +1,364 @@
+/*
+ * src/test/examples/testlibpq5.c
+ *
+ *
+ * testlibpq5.c
+ *		Test pipelined Bind/Execute runs on one prepared statement, with
+ *		parameters switching between text and binary format.
+ *
+ * libpq sends one query at a time, so after connecting this program writes
+ * the extended query protocol messages to the socket itself: one Parse, then
+ * batches of up to 1000 Bind/Execute pairs followed by a single Sync, and
+ * reads the replies of a batch only after sending all of it.  A simple
+ * INSERT like this one runs through OpFusion, which keeps the parameter
+ * input and receive functions from one Bind to the next; rows are bound all
+ * as text, all as binary, or mixed, in turn.  The connection must not use
+ * SSL.
+ *
+ * Before running this, populate a database with the following command
+ * (provided in src/test/examples/testlibpq5.sql):
+ *
+ * CREATE TABLE test5 (i int4, t text, n int8);
+ *
+ * testlibpq5 [conninfo [nrows]] inserts nrows rows (3000 by default) and
+ * then checks them.  The expected output is:
+ *
+ * inserted 3000 rows in 3 batches
+ * rows bound as text, binary and mixed are identical
+ *
+ * With a larger nrows it also prints the insert rate, for benchmarking.
+ */
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include "libpq-fe.h"
+
+/* for ntohl/htonl */
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#define BATCH_ROWS 1000
+#define DEFAULT_ROWS 3000
+
+typedef struct {
+    char* data;
+    size_t len;
+    size_t size;
+} MsgBuf;
+
+static void exit_nicely(PGconn* conn)
+{
+    PQfinish(conn);
+    exit(1);
+}
+
+static void buf_put(MsgBuf* buf, const void* data, size_t len)
+{
+    if (buf->len + len > buf->size) {
+        while (buf->len + len > buf->size)
+            buf->size *= 2;
+        buf->data = (char*)realloc(buf->data, buf->size);
+        if (buf->data == NULL) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+    memcpy(buf->data + buf->len, data, len);
+    buf->len += len;
+}
+
+static void buf_put_int16(MsgBuf* buf, int val)
+{
+    uint16_t n16 = htons((uint16_t)val);
+    buf_put(buf, &n16, sizeof(n16));
+}
+
+static void buf_put_int32(MsgBuf* buf, int val)
+{
+    uint32_t n32 = htonl((uint32_t)val);
+    buf_put(buf, &n32, sizeof(n32));
+}
+
+static void buf_put_str(MsgBuf* buf, const char* str)
+{
+    buf_put(buf, str, strlen(str) + 1);
+}
+
+/* start a message, its length is filled in by msg_end */
+static size_t msg_start(MsgBuf* buf, char type)
+{
+    size_t start;
+
+    buf_put(buf, &type, 1);
+    start = buf->len;
+    buf_put_int32(buf, 0);
+    return start;
+}
+
+static void msg_end(MsgBuf* buf, size_t start)
+{
+    uint32_t n32 = htonl((uint32_t)(buf->len - start));
+    memcpy(buf->data + start, &n32, sizeof(n32));
+}
+
+/*
+ * Bind row 'row' as: all text (row % 3 == 0), all binary (row % 3 == 1), or
+ * i and n binary with t text (row % 3 == 2), then Execute it.
+ */
+static void put_bind_execute(MsgBuf* buf, int row)
+{
+    char text[3][32];
+    int mode = row % 3;
+    int64_t nval = (int64_t)row * 1000000007LL;
+    size_t start;
+
+    snprintf(text[0], sizeof(text[0]), "%d", row);
+    snprintf(text[1], sizeof(text[1]), "row %d", row);
+    snprintf(text[2], sizeof(text[2]), "%lld", (long long)nval);
+
+    start = msg_start(buf, 'B');
+    buf_put_str(buf, "");   /* unnamed portal */
+    buf_put_str(buf, "s5"); /* statement */
+    buf_put_int16(buf, 3);  /* parameter format codes */
+    buf_put_int16(buf, mode == 0 ? 0 : 1);
+    buf_put_int16(buf, mode == 1 ? 1 : 0);
+    buf_put_int16(buf, mode == 0 ? 0 : 1);
+    buf_put_int16(buf, 3); /* parameter values */
+    if (mode == 0) {
+        buf_put_int32(buf, (int)strlen(text[0]));
+        buf_put(buf, text[0], strlen(text[0]));
+    } else {
+        buf_put_int32(buf, 4);
+        buf_put_int32(buf, row);
+    }
+    /* the binary representation of TEXT is the text itself */
+    buf_put_int32(buf, (int)strlen(text[1]));
+    buf_put(buf, text[1], strlen(text[1]));
+    if (mode == 0) {
+        buf_put_int32(buf, (int)strlen(text[2]));
+        buf_put(buf, text[2], strlen(text[2]));
+    } else {
+        /* INT8 goes in network byte order, high half first */
+        buf_put_int32(buf, 8);
+        buf_put_int32(buf, (int)(uint32_t)((uint64_t)nval >> 32));
+        buf_put_int32(buf, (int)(uint32_t)nval);
+    }
+    buf_put_int16(buf, 0); /* result formats */
+    msg_end(buf, start);
+
+    start = msg_start(buf, 'E');
+    buf_put_str(buf, "");
+    buf_put_int32(buf, 0);
+    msg_end(buf, start);
+}
+
+static void send_all(PGconn* conn, MsgBuf* buf)
+{
+    size_t sent = 0;
+
+    while (sent < buf->len) {
+        ssize_t rc = send(PQsocket(conn), buf->data + sent, buf->len - sent, 0);
+        if (rc < 0) {
+            perror("send");
+            exit_nicely(conn);
+        }
+        sent += (size_t)rc;
+    }
+    buf->len = 0;
+}
+
+static void recv_exact(PGconn* conn, char* data, size_t len)
+{
+    size_t got = 0;
+
+    while (got < len) {
+        ssize_t rc = recv(PQsocket(conn), data + got, len - got, 0);
+        if (rc <= 0) {
+            fprintf(stderr, "connection lost while reading replies\n");
+            exit_nicely(conn);
+        }
+        got += (size_t)rc;
+    }
+}
+
+/*
+ * Read replies up to ReadyForQuery and return the number of
+ * CommandComplete messages. Any ErrorResponse is fatal.
+ */
+static int read_replies(PGconn* conn)
+{
+    int completed = 0;
+
+    for (;;) {
+        char type;
+        uint32_t n32;
+        size_t len;
+        char* body = NULL;
+
+        recv_exact(conn, &type, 1);
+        recv_exact(conn, (char*)&n32, sizeof(n32));
+        len = ntohl(n32) - sizeof(n32);
+        body = (char*)malloc(len + 1);
+        if (body == NULL) {
+            fprintf(stderr, "out of memory\n");
+            exit_nicely(conn);
+        }
+        recv_exact(conn, body, len);
+        body[len] = '\0';
+
+        if (type == 'E') {
+            /* fields are a type byte and a string each, print the message */
+            char* field = body;
+            while (*field != '\0' && field < body + len) {
+                if (*field == 'M')
+                    fprintf(stderr, "pipelined insert failed: %s\n", field + 1);
+                field += strlen(field) + 1;
+            }
+            free(body);
+            exit_nicely(conn);
+        }
+        if (type == 'C') {
+            if (strcmp(body, "INSERT 0 1") != 0) {
+                fprintf(stderr, "unexpected command tag \"%s\"\n", body);
+                free(body);
+                exit_nicely(conn);
+            }
+            completed++;
+        }
+        free(body);
+        if (type == 'Z')
+            return completed;
+    }
+}
+
+static PGresult* exec_ok(PGconn* conn, const char* query, ExecStatusType status)
+{
+    PGresult* res = PQexec(conn, query);
+
+    if (PQresultStatus(res) != status) {
+        fprintf(stderr, "%s failed: %s", query, PQerrorMessage(conn));
+        PQclear(res);
+        exit_nicely(conn);
+    }
+    return res;
+}
+
+int main(int argc, char** argv)
+{
+    const char* conninfo = NULL;
+    PGconn* conn = NULL;
+    PGresult* res = NULL;
+    MsgBuf buf;
+    int nrows = DEFAULT_ROWS;
+    int row;
+    int batches = 0;
+    int inserted = 0;
+    size_t start;
+    struct timeval begin, end;
+    double secs;
+
+    if (argc > 1)
+        conninfo = argv[1];
+    else
+        conninfo = "dbname = postgres";
+    if (argc > 2)
+        nrows = atoi(argv[2]);
+
+    /* Make a connection to the database */
+    conn = PQconnectdb(conninfo);
+
+    /* Check to see that the backend connection was successfully made */
+    if (PQstatus(conn) != CONNECTION_OK) {
+        fprintf(stderr, "Connection to database failed: %s", PQerrorMessage(conn));
+        exit_nicely(conn);
+    }
+    if (PQgetssl(conn) != NULL) {
+        fprintf(stderr, "this test writes protocol messages itself, connect with sslmode=disable\n");
+        exit_nicely(conn);
+    }
+
+    PQclear(exec_ok(conn, "TRUNCATE test5", PGRES_COMMAND_OK));
+
+    buf.size = 8192;
+    buf.len = 0;
+    buf.data = (char*)malloc(buf.size);
+    if (buf.data == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit_nicely(conn);
+    }
+
+    (void)gettimeofday(&begin, NULL);
+
+    /* Parse with explicit parameter types, so that binary values are safe */
+    start = msg_start(&buf, 'P');
+    buf_put_str(&buf, "s5");
+    buf_put_str(&buf, "INSERT INTO test5 VALUES ($1, $2, $3)");
+    buf_put_int16(&buf, 3);
+    buf_put_int32(&buf, 23); /* int4 */
+    buf_put_int32(&buf, 25); /* text */
+    buf_put_int32(&buf, 20); /* int8 */
+    msg_end(&buf, start);
+
+    for (row = 1; row <= nrows;) {
+        int last = row + BATCH_ROWS - 1;
+
+        if (last > nrows)
+            last = nrows;
+        for (; row <= last; row++)
+            put_bind_execute(&buf, row);
+        start = msg_start(&buf, 'S');
+        msg_end(&buf, start);
+
+        send_all(conn, &buf);
+        inserted += read_replies(conn);
+        batches++;
+    }
+
+    (void)gettimeofday(&end, NULL);
+    free(buf.data);
+
+    printf("inserted %d rows in %d batches\n", inserted, batches);
+    if (inserted != nrows)
+        exit_nicely(conn);
+    if (nrows > DEFAULT_ROWS) {
+        secs = (end.tv_sec - begin.tv_sec) + (end.tv_usec - begin.tv_usec) / 1000000.0;
+        printf("%.0f rows/s\n", secs > 0 ? nrows / secs : 0.0);
+    }
+
+    /* every row must hold the same values whichever format it was bound in */
+    res = exec_ok(conn,
+        "SELECT i % 3, count(*) FROM test5 "
+        "WHERE t <> 'row ' || i OR n <> i::int8 * 1000000007 OR i IS NULL OR t IS NULL OR n IS NULL "
+        "GROUP BY 1 ORDER BY 1",
+        PGRES_TUPLES_OK);
+    if (PQntuples(res) != 0) {
+        fprintf(stderr, "%s rows bound in mode %s differ\n", PQgetvalue(res, 0, 1), PQgetvalue(res, 0, 0));
+        PQclear(res);
+        exit_nicely(conn);
+    }
+    PQclear(res);
+
+    res = exec_ok(conn, "SELECT count(DISTINCT i), min(i), max(i) FROM test5", PGRES_TUPLES_OK);
+    if (atoi(PQgetvalue(res, 0, 0)) != nrows || atoi(PQgetvalue(res, 0, 1)) != 1 ||
+        atoi(PQgetvalue(res, 0, 2)) != nrows) {
+        fprintf(stderr, "rows are missing or duplicated\n");
+        PQclear(res);
+        exit_nicely(conn);
+    }
+    PQclear(res);
+    printf("rows bound as text, binary and mixed are identical\n");
+
+    /* close the connection to the database and cleanup */
+    PQfinish(conn);
+
+    return 0;
+}
@@ -0,0 +1 @@
+CREATE TABLE test5 (i int4, t text, n int8);
@@ -0,0 +1,88 @@
+#!/bin/sh
+# fast-path locks of a scan over hundreds of partitions spread over 16 slot groups, and a strong lock moves them out
+
+source ./standby_env.sh
+
+reader_query="select count(*) from fastpath_parts; select pg_sleep(60);"
+
+function restart_primary_with()
+{
+gs_guc set -D $primary_data_dir -c "num_internal_lock_partitions='FASTPATH_PART=$1'"
+stop_primary
+start_primary
+check_instance
+}
+
+function query_primary_value()
+{
+gsql -d $db -p $dn1_primary_port -t -A -c "$1"
+}
+
+function wait_for_value()
+{
+for i in $(seq 1 30); do
+    if [ "$(query_primary_value "$1")" = "$2" ]; then
+        return 0
+    fi
+    sleep 1
+done
+echo "$3 $failed_keyword"
+exit 1
+}
+
+function test_1()
+{
+check_instance
+restart_primary_with 256
+
+partitions=""
+for i in $(seq 1 300); do
+    partitions="$partitions, PARTITION p$i VALUES LESS THAN ($((i * 10)))"
+done
+query_primary_value "DROP TABLE if exists fastpath_parts; CREATE TABLE fastpath_parts(a int) PARTITION BY RANGE (a) (${partitions#, });"
+query_primary_value "INSERT INTO fastpath_parts SELECT i FROM generate_series(0, 2999) i;"
+
+# a reader holding AccessShareLock on the table and all 300 partitions
+gsql -d $db -p $dn1_primary_port -c "begin; $reader_query commit;" > /dev/null 2>&1 &
+wait_for_value "select count(*) from pg_stat_activity where query like '%pg_sleep(60)%' and pid <> pg_backend_pid();" "1" "reader did not start"
+reader=`query_primary_value "select pid from pg_stat_activity where query like '%pg_sleep(60)%' and pid <> pg_backend_pid();"`
+wait_for_value "select count(*) >= 300 from pg_locks where pid = $reader and locktype = 'partition';" "t" "reader did not lock the partitions"
+
+fastpath=`query_primary_value "select count(*) from pg_locks where pid = $reader and locktype in ('relation', 'partition') and fastpath;"`
+if [ $fastpath -le 20 -o $fastpath -gt 256 ]; then
+    echo "reader holds $fastpath fast-path locks with 256 slots $failed_keyword"
+    exit 1
+fi
+stat=`query_primary_value "select slots_used || '|' || (group_full > 0) from gs_stat_fastpath_locks() where pid = $reader;"`
+if [ "$stat" != "$fastpath|t" ]; then
+    echo "reader fast-path counters are '$stat' with $fastpath fast-path locks $failed_keyword"
+    exit 1
+fi
+echo "reader holds $fastpath fast-path locks"
+
+# a strong lock on the table moves the reader's table lock to the main lock table
+gsql -d $db -p $dn1_primary_port -c "begin; lock table fastpath_parts in access exclusive mode; commit;" > /dev/null 2>&1 &
+wait_for_value "select count(*) from pg_locks where relation = 'fastpath_parts'::regclass and locktype = 'relation' and not granted;" "1" "locker does not wait for the reader"
+wait_for_value "select count(*) from pg_locks where pid = $reader and locktype = 'relation' and relation = 'fastpath_parts'::regclass and not fastpath;" "1" "reader's table lock was not transferred"
+wait_for_value "select count(*) > 0 from gs_stat_fastpath_locks() where transferred > 0;" "t" "transfer was not counted"
+
+left=`query_primary_value "select count(*) from pg_locks where pid = $reader and locktype in ('relation', 'partition') and fastpath;"`
+if [ $left -ne $((fastpath - 1)) ]; then
+    echo "reader holds $left fast-path locks after the transfer instead of $((fastpath - 1)) $failed_keyword"
+    exit 1
+fi
+
+query_primary_value "select pg_cancel_backend($reader);"
+wait
+wait_for_value "select count(*) from pg_locks where relation = 'fastpath_parts'::regclass;" "0" "locks were not released"
+echo "all of success"
+}
+
+function tear_down()
+{
+query_primary_value "DROP TABLE if exists fastpath_parts;"
+restart_primary_with 20
+}
+
+test_1
+tear_down
@@ -0,0 +1,136 @@
+#!/bin/sh
+# merge an incremental base backup into the full one it is based on, start it and compare with the primary
+
+source ./standby_env.sh
+
+full_dir="$data_dir/backup_full"
+inc_dir="$data_dir/backup_inc"
+ddl_flag="$data_dir/backup_inc_ddl"
+
+function start_backup_copy()
+{
+# run the backup on its own port, without replication peers
+sed -i '/^replconninfo/d' $1/postgresql.conf
+echo "port = $dn_temp_port" >> $1/postgresql.conf
+$bin_dir/gaussdb --single_node -p $dn_temp_port -D $1 > ./results/gaussdb_backup.log 2>&1 &
+for i in $(seq 1 120); do
+    if [ "$(gsql -d $db -p $dn_temp_port -t -A -c "select pg_is_in_recovery();" 2>/dev/null)" = "f" ]; then
+        return 0
+    fi
+    sleep 1
+done
+echo "backup copy did not start $failed_keyword"
+exit 1
+}
+
+function table_digest()
+{
+gsql -d $db -p $1 -t -A -c "select count(*), md5(coalesce(string_agg(t::text, ',' order by t::text), '')) from $2 t;"
+}
+
+function check_same_table()
+{
+if [ "$(table_digest $dn1_primary_port $1)" = "$(table_digest $dn_temp_port $1)" ]; then
+    echo "$1 is the same in the merged backup"
+else
+    echo "$1 differs in the merged backup $failed_keyword"
+    exit 1
+fi
+}
+
+function test_1()
+{
+check_instance
+rm -rf $full_dir $inc_dir $ddl_flag
+
+gs_guc reload -D $primary_data_dir -c "enable_cbm_tracking=on"
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists inc_keep, inc_dml, inc_trunc, inc_drop;
+    CREATE TABLE inc_keep(id int primary key, val text);
+    CREATE TABLE inc_dml(id int primary key, val text);
+    CREATE TABLE inc_trunc(id int, val text);
+    CREATE TABLE inc_drop(id int, val text);
+    INSERT INTO inc_keep SELECT i, md5(i::text) FROM generate_series(1, 100000) i;
+    INSERT INTO inc_dml SELECT i, md5(i::text) FROM generate_series(1, 100000) i;
+    INSERT INTO inc_trunc SELECT i, md5(i::text) FROM generate_series(1, 10000) i;
+    INSERT INTO inc_drop SELECT i, md5(i::text) FROM generate_series(1, 10000) i;
+    checkpoint;"
+
+gs_basebackup -D $full_dir -p $dn1_primary_port -X stream
+if [ $? -ne 0 ]; then
+    echo "full backup failed $failed_keyword"
+    exit 1
+fi
+start_lsn=`sed -n 's/^START WAL LOCATION: \([0-9A-F]*\/[0-9A-F]*\) .*/\1/p' $full_dir/backup_label`
+
+gsql -d $db -p $dn1_primary_port -c "UPDATE inc_dml SET val = 'updated' WHERE id % 7 = 0;
+    DELETE FROM inc_dml WHERE id % 11 = 0;
+    INSERT INTO inc_dml SELECT i, md5(i::text) FROM generate_series(100001, 120000) i;
+    TRUNCATE inc_trunc;
+    INSERT INTO inc_trunc SELECT i, 'after truncate' FROM generate_series(1, 500) i;
+    DROP TABLE inc_drop;
+    CREATE TABLE inc_new(id int primary key, val text);
+    INSERT INTO inc_new SELECT i, md5(i::text) FROM generate_series(1, 20000) i;"
+
+# relations created while the incremental backup runs are not in its changed block map
+touch $ddl_flag
+(i=0; while [ -f $ddl_flag ]; do
+    gsql -d $db -p $dn1_primary_port -c "CREATE TABLE inc_during_$i AS SELECT generate_series(1, 1000) a;" > /dev/null 2>&1
+    i=`expr $i + 1`
+done) &
+ddl_pid=$!
+
+gs_basebackup -D $inc_dir -p $dn1_primary_port -X stream --incremental=$start_lsn
+result=$?
+rm -f $ddl_flag
+wait $ddl_pid
+if [ $result -ne 0 ]; then
+    echo "incremental backup failed $failed_keyword"
+    exit 1
+fi
+if [ $(find $inc_dir -name 'INCREMENTAL.*' | wc -l) -eq 0 ]; then
+    echo "incremental backup sent every file whole $failed_keyword"
+    exit 1
+fi
+
+gs_basebackup -D $full_dir --apply-incremental=$inc_dir
+if [ $? -ne 0 ]; then
+    echo "merging the incremental backup failed $failed_keyword"
+    exit 1
+fi
+
+# the merged backup now starts where the incremental one does, so the same merge must be refused
+if gs_basebackup -D $full_dir --apply-incremental=$inc_dir; then
+    echo "incremental backup was merged into the wrong base $failed_keyword"
+    exit 1
+fi
+
+start_backup_copy $full_dir
+for table in inc_keep inc_dml inc_trunc inc_new; do
+    check_same_table $table
+done
+for table in `gsql -d $db -p $dn_temp_port -t -A -c "select relname from pg_class where relname like 'inc_during_%';"`; do
+    check_same_table $table
+done
+if [ $(gsql -d $db -p $dn_temp_port -t -A -c "select count(*) from pg_class where relname = 'inc_drop';") -ne 0 ]; then
+    echo "dropped table is back in the merged backup $failed_keyword"
+    exit 1
+fi
+gsql -d $db -p $dn_temp_port -c "vacuum analyze inc_dml; select count(*) from inc_new where id between 100 and 200;"
+if [ $? -ne 0 ]; then
+    echo "merged backup is not usable $failed_keyword"
+    exit 1
+fi
+echo "all of success"
+}
+
+function tear_down()
+{
+gs_ctl stop -D $full_dir -m fast
+rm -rf $full_dir $inc_dir $ddl_flag
+gs_guc reload -D $primary_data_dir -c "enable_cbm_tracking=off"
+gsql -d $db -p $dn1_primary_port -t -A -c "select 'DROP TABLE ' || relname || ';' from pg_class where relname like 'inc_during_%';" | gsql -d $db -p $dn1_primary_port
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists inc_keep, inc_dml, inc_trunc, inc_drop, inc_new;"
+}
+
+test_1
+tear_down
@@ -0,0 +1,117 @@
+#!/bin/sh
+# take a base backup over several connections while the primary is written to, start it and compare
+# with the primary; an interrupted parallel backup must not block the next one
+
+source ./standby_env.sh
+
+backup_dir="$data_dir/backup_parallel"
+dml_flag="$data_dir/backup_parallel_dml"
+
+function start_backup_copy()
+{
+# run the backup on its own port, without replication peers
+sed -i '/^replconninfo/d' $1/postgresql.conf
+echo "port = $dn_temp_port" >> $1/postgresql.conf
+$bin_dir/gaussdb --single_node -p $dn_temp_port -D $1 > ./results/gaussdb_backup.log 2>&1 &
+for i in $(seq 1 120); do
+    if [ "$(gsql -d $db -p $dn_temp_port -t -A -c "select pg_is_in_recovery();" 2>/dev/null)" = "f" ]; then
+        return 0
+    fi
+    sleep 1
+done
+echo "backup copy did not start $failed_keyword"
+exit 1
+}
+
+function table_digest()
+{
+gsql -d $db -p $1 -t -A -c "select count(*), md5(coalesce(string_agg(t::text, ',' order by t::text), '')) from $2 t;"
+}
+
+function check_same_table()
+{
+if [ "$(table_digest $dn1_primary_port $1)" = "$(table_digest $dn_temp_port $1)" ]; then
+    echo "$1 is the same in the parallel backup"
+else
+    echo "$1 differs in the parallel backup $failed_keyword"
+    exit 1
+fi
+}
+
+function test_1()
+{
+check_instance
+rm -rf $backup_dir $dml_flag
+
+# enough relation files for every connection to get a share
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists par_big, par_dml;
+    CREATE TABLE par_big(id int primary key, val text);
+    CREATE TABLE par_dml(id int, val text);
+    INSERT INTO par_big SELECT i, repeat(md5(i::text), 4) FROM generate_series(1, 300000) i;
+    INSERT INTO par_dml SELECT i, md5(i::text) FROM generate_series(1, 10000) i;"
+for i in $(seq 1 20); do
+    gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists par_small_$i; CREATE TABLE par_small_$i AS SELECT generate_series(1, 5000) a;" > /dev/null
+done
+gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+# the main connection goes away half way; the helpers must give up and the backup slot must be
+# freed, or the next parallel backup is refused
+gs_basebackup -D $backup_dir -p $dn1_primary_port -X stream -j 4 > ./results/parallel_basebackup.log 2>&1 &
+backup_pid=$!
+sleep 1
+kill -9 $backup_pid
+wait $backup_pid
+sleep 3
+rm -rf $backup_dir
+
+# writes keep going while the backup is sent, WAL replay makes the copy consistent
+touch $dml_flag
+(i=0; while [ -f $dml_flag ]; do
+    gsql -d $db -p $dn1_primary_port -c "UPDATE par_dml SET val = 'updated $i' WHERE id % 97 = $i % 97; INSERT INTO par_dml VALUES (10000 + $i, 'inserted');" > /dev/null 2>&1
+    i=`expr $i + 1`
+done) &
+dml_pid=$!
+
+gs_basebackup -D $backup_dir -p $dn1_primary_port -X stream -j 4
+result=$?
+rm -f $dml_flag
+wait $dml_pid
+if [ $result -ne 0 ]; then
+    echo "parallel backup failed $failed_keyword"
+    exit 1
+fi
+
+start_backup_copy $backup_dir
+for table in par_big `seq -f "par_small_%g" 1 20`; do
+    check_same_table $table
+done
+# par_dml went on changing after the backup ended, check it is consistent in itself
+if [ "$(gsql -d $db -p $dn_temp_port -t -A -c "select count(*), count(distinct id) from par_dml where id <= 10000;")" != "10000|10000" ]; then
+    echo "par_dml lost or duplicated rows in the parallel backup $failed_keyword"
+    exit 1
+fi
+gsql -d $db -p $dn_temp_port -c "vacuum analyze par_big; select count(*) from par_big where id between 100 and 200;"
+if [ $? -ne 0 ]; then
+    echo "parallel backup is not usable $failed_keyword"
+    exit 1
+fi
+if [ "$(gsql -d $db -p $dn_temp_port -t -A -c "select count(*) from par_big where id between 100 and 200;")" != "101" ]; then
+    echo "index of par_big is wrong in the parallel backup $failed_keyword"
+    exit 1
+fi
+echo "all of success"
+}
+
+function tear_down()
+{
+rm -f $dml_flag
+gs_ctl stop -D $backup_dir -m fast
+rm -rf $backup_dir
+for i in $(seq 1 20); do
+    gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists par_small_$i;" > /dev/null
+done
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists par_big, par_dml;"
+}
+
+test_1
+tear_down
@@ -0,0 +1,119 @@
+#!/bin/sh
+# crash recovery with extreme RTO replays the same WAL into the same tables whether the batch redo
+# threads prefetch blocks or not
+
+source ./standby_env.sh
+
+copy_dir="$data_dir/datanode1_prefetch_off"
+tables="pf_heap pf_ustore pf_trunc pf_new"
+
+function set_recovery()
+{
+# $1 data directory, $2 recovery_parse_workers, $3 hot_standby, $4 recovery_prefetch
+gs_guc set -Z datanode -D $1 -c "recovery_parse_workers = $2"
+gs_guc set -Z datanode -D $1 -c "recovery_redo_workers = 1"
+gs_guc set -Z datanode -D $1 -c "hot_standby = $3"
+gs_guc set -Z datanode -D $1 -c "recovery_prefetch = $4"
+}
+
+function table_digest()
+{
+gsql -d $db -p $1 -t -A -c "select count(*), md5(coalesce(string_agg(t::text, ',' order by t::text), '')) from $2 t;"
+}
+
+function start_copy()
+{
+# replay the copy on its own port, without replication peers
+sed -i '/^replconninfo/d' $copy_dir/postgresql.conf
+echo "port = $dn_temp_port" >> $copy_dir/postgresql.conf
+$bin_dir/gaussdb --single_node -p $dn_temp_port -D $copy_dir > ./results/gaussdb_prefetch_off.log 2>&1 &
+for i in $(seq 1 120); do
+    if [ "$(gsql -d $db -p $dn_temp_port -t -A -c "select pg_is_in_recovery();" 2>/dev/null)" = "f" ]; then
+        return 0
+    fi
+    sleep 1
+done
+echo "copy without prefetch did not start $failed_keyword"
+exit 1
+}
+
+function test_1()
+{
+check_instance
+rm -rf $copy_dir
+stop_primary
+set_recovery $primary_data_dir 2 off on
+start_primary
+
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists pf_heap, pf_ustore, pf_trunc, pf_drop, pf_new;
+    CREATE TABLE pf_heap(id int primary key, val text);
+    CREATE TABLE pf_ustore(id int, val text) with (storage_type=ustore);
+    CREATE TABLE pf_trunc(id int, val text);
+    CREATE TABLE pf_drop(id int, val text);
+    INSERT INTO pf_heap SELECT i, md5(i::text) FROM generate_series(1, 200000) i;
+    INSERT INTO pf_ustore SELECT i, md5(i::text) FROM generate_series(1, 100000) i;
+    INSERT INTO pf_trunc SELECT i, md5(i::text) FROM generate_series(1, 20000) i;
+    INSERT INTO pf_drop SELECT i, md5(i::text) FROM generate_series(1, 20000) i;
+    checkpoint;"
+
+# each page is changed more than once after the checkpoint, so most block references carry no
+# full-page image and their blocks are read from disk during replay
+for round in 1 2 3; do
+    gsql -d $db -p $dn1_primary_port -c "UPDATE pf_heap SET val = val || '$round' WHERE id % 13 = $round;
+        UPDATE pf_ustore SET val = '$round' || val WHERE id % 7 = $round;
+        DELETE FROM pf_heap WHERE id % 101 = $round;
+        INSERT INTO pf_heap SELECT i, 'round $round' FROM generate_series(200000 + $round * 1000, 200999 + $round * 1000) i;"
+done
+# dropped and truncated files must be closed by the lookahead stage before they are unlinked
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE pf_drop;
+    TRUNCATE pf_trunc;
+    INSERT INTO pf_trunc SELECT i, 'after truncate' FROM generate_series(1, 5000) i;
+    CREATE TABLE pf_new AS SELECT i AS id, md5(i::text) AS val FROM generate_series(1, 20000) i;
+    UPDATE pf_new SET val = 'updated' WHERE id % 3 = 0;"
+before=`for table in $tables; do echo "$table $(table_digest $dn1_primary_port $table)"; done`
+
+kill_primary
+cp -r $primary_data_dir $copy_dir
+set_recovery $copy_dir 2 off off
+touch ./results/recovery_prefetch_start
+start_primary
+start_copy
+
+for table in $tables; do
+    on="`table_digest $dn1_primary_port $table`"
+    off="`table_digest $dn_temp_port $table`"
+    if [ "$on" != "$off" -o "$table $on" != "`echo "$before" | grep "^$table "`" ]; then
+        echo "$table differs after recovery: prefetch on '$on', off '$off' $failed_keyword"
+        exit 1
+    fi
+    echo "$table is the same after recovery with and without prefetch"
+done
+if [ $(gsql -d $db -p $dn_temp_port -t -A -c "select count(*) from pg_class where relname = 'pf_drop';") -ne 0 ]; then
+    echo "dropped table is back after recovery $failed_keyword"
+    exit 1
+fi
+
+# the batch redo threads log what they prefetched when they exit
+if [ $(find $primary_data_dir/pg_log ./results/gaussdb.log -type f -newer ./results/recovery_prefetch_start 2>/dev/null | xargs grep -h "batch redo worker id .* prefetched [1-9]" | wc -l) -eq 0 ]; then
+    echo "recovery with prefetch on prefetched no blocks $failed_keyword"
+    exit 1
+fi
+if [ $(grep -c "prefetched [0-9]* blocks" ./results/gaussdb_prefetch_off.log) -ne 0 ]; then
+    echo "recovery with prefetch off prefetched blocks $failed_keyword"
+    exit 1
+fi
+echo "all of success"
+}
+
+function tear_down()
+{
+gs_ctl stop -D $copy_dir -m fast
+rm -rf $copy_dir ./results/recovery_prefetch_start
+stop_primary
+set_recovery $primary_data_dir 1 on off
+start_primary
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists pf_heap, pf_ustore, pf_trunc, pf_drop, pf_new;"
+}
+
+test_1
+tear_down
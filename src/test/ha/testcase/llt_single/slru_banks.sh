@@ -0,0 +1,92 @@
+#!/bin/sh
+# visibility checks through a small, banked CSNLOG/CLOG cache on the standby, with lock-free reads of committed CSNs
+
+source ./standby_env.sh
+
+function restart_standby_with()
+{
+gs_guc set -D $standby_data_dir -c "csnlog_buffers=$1" -c "clog_buffers=$1"
+stop_standby
+start_standby
+}
+
+function table_digest()
+{
+gsql -d $db -p $1 -t -A -c "select count(*), sum(id) from slru_banks;"
+}
+
+function wait_standby_same()
+{
+for i in $(seq 1 120); do
+    if [ "$(table_digest $dn1_primary_port)" = "$(table_digest $dn1_standby_port)" ]; then
+        return 0
+    fi
+    sleep 1
+done
+echo "standby sees other rows than the primary $failed_keyword"
+exit 1
+}
+
+function slru_reads()
+{
+gsql -d $db -p $dn1_standby_port -t -A -c "select coalesce(sum(wait), 0) from pg_catalog.get_instr_wait_event(NULL) where event in ('CLOGRead', 'CSNLOGRead');"
+}
+
+function test_1()
+{
+check_instance
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists slru_banks; CREATE TABLE slru_banks(id int) WITH (autovacuum_enabled = false);"
+
+# one subtransaction per row spreads the rows over tens of CSNLOG pages,
+# every seventh one rolls back
+gsql -d $db -p $dn1_primary_port -c "
+DECLARE
+BEGIN
+    FOR i IN 1..60000 LOOP
+        BEGIN
+            INSERT INTO slru_banks VALUES (i);
+            IF i % 7 = 0 THEN
+                RAISE EXCEPTION 'roll back %', i;
+            END IF;
+        EXCEPTION WHEN OTHERS THEN
+            NULL;
+        END;
+    END LOOP;
+END;
+/"
+wait_catchup_finish
+
+# a cold cache of 32 slots per partition, i.e. two banks
+restart_standby_with 32
+wait_standby_same
+
+count=`gsql -d $db -p $dn1_standby_port -t -A -c "select count(*) from slru_banks;"`
+if [ "$count" != "51429" ]; then
+    echo "standby sees $count rows instead of 51429 $failed_keyword"
+    exit 1
+fi
+
+# the second pass finds the pages cached and takes the lock-free path
+wait_standby_same
+
+for i in $(seq 1 30); do
+    if [ $(slru_reads) -gt 0 ]; then
+        break
+    fi
+    sleep 1
+done
+if [ $(slru_reads) -le 0 ]; then
+    echo "no CLOGRead or CSNLOGRead waits were recorded $failed_keyword"
+    exit 1
+fi
+echo "all of success"
+}
+
+function tear_down()
+{
+restart_standby_with 0
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists slru_banks;"
+}
+
+test_1
+tear_down
@@ -0,0 +1,87 @@
+#!/bin/sh
+# a standby session with standby_read_lsn set to a primary commit location waits for its replay,
+# and fails once standby_read_lsn_timeout is up while replay is paused
+
+source ./standby_env.sh
+
+function insert_on_primary()
+{
+# insert a row and return the location right after its commit
+gsql -d $db -p $dn1_primary_port -t -A -c "INSERT INTO read_lsn VALUES ($1);" > /dev/null
+gsql -d $db -p $dn1_primary_port -t -A -c "select pg_current_xlog_location();"
+}
+
+function replay()
+{
+gsql -d $db -p $dn1_standby_port -t -A -c "select pg_xlog_replay_$1();" > /dev/null
+}
+
+function test_1()
+{
+check_instance
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists read_lsn; CREATE TABLE read_lsn(id int);"
+wait_catchup_finish
+
+# the session waits while replay is paused, and sees the row once it is resumed
+replay pause
+lsn=`insert_on_primary 1`
+gsql -d $db -p $dn1_standby_port -t -A -q > ./results/standby_read_lsn.log 2>&1 <<EOF &
+set standby_read_lsn_timeout = '60s';
+set standby_read_lsn = '$lsn';
+select 'rows', count(*) from read_lsn where id = 1;
+EOF
+reader_pid=$!
+sleep 3
+if [ $(gsql -d $db -p $dn1_standby_port -t -A -c "select count(*) from pg_thread_wait_status where wait_status = 'wait wal replay';") -ne 1 ]; then
+    echo "standby session is not waiting for replay of $lsn $failed_keyword"
+    exit 1
+fi
+if [ $(gsql -d $db -p $dn1_standby_port -t -A -c "select count(*) from read_lsn where id = 1;") -ne 0 ]; then
+    echo "replay was not paused $failed_keyword"
+    exit 1
+fi
+replay resume
+wait $reader_pid
+if [ "$(grep '^rows' ./results/standby_read_lsn.log)" != "rows|1" ]; then
+    echo "standby session did not see the row committed at $lsn $failed_keyword"
+    cat ./results/standby_read_lsn.log
+    exit 1
+fi
+
+# with replay paused the wait times out; the next query of the session does not wait again
+replay pause
+lsn=`insert_on_primary 2`
+gsql -d $db -p $dn1_standby_port -t -A -q > ./results/standby_read_lsn.log 2>&1 <<EOF
+set standby_read_lsn_timeout = '2s';
+set standby_read_lsn = '$lsn';
+select 'rows', count(*) from read_lsn;
+select 'after timeout', count(*) from read_lsn;
+EOF
+replay resume
+if [ $(grep -c "timed out waiting for replay of WAL up to $lsn" ./results/standby_read_lsn.log) -ne 1 ]; then
+    echo "standby session did not time out waiting for $lsn $failed_keyword"
+    cat ./results/standby_read_lsn.log
+    exit 1
+fi
+if [ $(grep -c '^rows' ./results/standby_read_lsn.log) -ne 0 -o "$(grep '^after timeout' ./results/standby_read_lsn.log)" != "after timeout|1" ]; then
+    echo "standby session read wrong rows around the timeout $failed_keyword"
+    cat ./results/standby_read_lsn.log
+    exit 1
+fi
+
+# on the primary the setting costs nothing
+if [ "$(gsql -d $db -p $dn1_primary_port -t -A -c "set standby_read_lsn = 'FFFFFFFF/0'; set standby_read_lsn_timeout = 0; select count(*) from read_lsn;" | tail -1)" != "2" ]; then
+    echo "standby_read_lsn made the primary wait $failed_keyword"
+    exit 1
+fi
+echo "all of success"
+}
+
+function tear_down()
+{
+replay resume
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists read_lsn;"
+}
+
+test_1
+tear_down
@@ -0,0 +1,93 @@
+#!/bin/sh
+# asynchronous rollback of a large ustore transaction split across undo workers
+
+source ./standby_env.sh
+
+function wait_activity()
+{
+# $1: pattern of the pg_stat_activity query text, $2: expected count, 0 or "any"
+wait_count "select count(*) from pg_stat_activity where query like '$1';" $2
+}
+
+function wait_rollback()
+{
+# $1: condition on gs_stat_undo_rollback(), $2: expected count, 0 or "any"
+wait_count "select count(*) from gs_stat_undo_rollback() where $1;" $2
+}
+
+function wait_count()
+{
+for i in $(seq 1 300); do
+    cnt=`gsql -d $db -p $dn1_primary_port -t -A -c "$1"`
+    if [ "$2" = "any" ] && [ -n "$cnt" ] && [ "$cnt" -gt 0 ]; then
+        return 0
+    fi
+    if [ "$2" = "0" ] && [ "$cnt" = "0" ]; then
+        return 0
+    fi
+    sleep 1
+done
+return 1
+}
+
+function test_1()
+{
+check_instance
+
+gs_guc reload -D $primary_data_dir -c "max_undo_workers_per_rollback=4"
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists split_rb; CREATE TABLE split_rb(id int, pad text) with (storage_type=ustore);"
+gsql -d $db -p $dn1_primary_port -c "INSERT INTO split_rb SELECT i, repeat('a', 100) FROM generate_series(1, 600000) i; checkpoint;"
+
+# old row versions of 600000 rows make well over 3 * 16MB of undo, enough for 4 parts
+gsql -d $db -p $dn1_primary_port -c "start transaction; UPDATE split_rb SET pad = repeat('b', 100); checkpoint; select pg_sleep(600);" &
+if ! wait_activity '%pg_sleep(600)%' any; then
+    echo "large update did not finish $failed_keyword"
+    exit 1
+fi
+
+# leave the update to be rolled back by undo workers after restart
+kill_primary
+start_primary_as_pending
+notify_primary_as_primary
+sleep 3
+
+# cancel one part while it is applied, only that part must be retried
+if wait_rollback "part = 1 and nparts = 4 and undo_records > 0" any; then
+    gsql -d $db -p $dn1_primary_port -c "select * from gs_stat_undo_rollback();"
+    gsql -d $db -p $dn1_primary_port -c "select pg_cancel_backend(pid) from gs_stat_undo_rollback() where part = 1;"
+else
+    echo "rollback was not split into 4 parts $failed_keyword"
+    exit 1
+fi
+
+if ! wait_rollback "true" 0; then
+    echo "split rollback did not finish $failed_keyword"
+    exit 1
+fi
+sleep 5
+
+if [ $(gsql -d $db -p $dn1_primary_port -t -A -c "select count(*) from split_rb where pad = repeat('a', 100);") -eq 600000 ]; then
+    echo "all of success"
+else
+    echo "split rollback restored wrong rows $failed_keyword"
+    exit 1
+fi
+
+# the last part marked the transaction rolled back, so its undo can be recycled and the table vacuumed
+gsql -d $db -p $dn1_primary_port -c "vacuum split_rb; checkpoint;"
+if [ $(gsql -d $db -p $dn1_primary_port -t -A -c "select count(*) from split_rb;") -eq 600000 ]; then
+    echo "all of success"
+else
+    echo "split_rb changed after vacuum $failed_keyword"
+    exit 1
+fi
+}
+
+function tear_down()
+{
+gs_guc reload -D $primary_data_dir -c "max_undo_workers_per_rollback=1"
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists split_rb;"
+}
+
+test_1
+tear_down
@@ -0,0 +1,88 @@
+#!/bin/sh
+# replay ustore inplace updates logged as changed byte ranges on the standby, read their old
+# versions from undo with an old standby snapshot, and replay their rollback
+
+source ./standby_env.sh
+
+function table_digest()
+{
+gsql -d $db -p $1 -t -A -c "select count(*), sum(c1), sum(c3), sum(c5), md5(string_agg(c1 || ',' || c2 || ',' || c3 || ',' || c4 || ',' || c5, ';' order by c3)) from xor_delta;"
+}
+
+function wait_standby_same()
+{
+for i in $(seq 1 120); do
+    if [ "$(table_digest $dn1_primary_port)" = "$(table_digest $dn1_standby_port)" ]; then
+        return 0
+    fi
+    sleep 1
+done
+echo "standby differs from primary after $1 $failed_keyword"
+exit 1
+}
+
+function test_1()
+{
+check_instance
+gs_guc reload -D $primary_data_dir -c "undo_retention_time=600"
+gs_guc reload -D $standby_data_dir -c "hot_standby_feedback=on"
+
+# counters at both ends and in the middle, 200 bytes of text between them
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists xor_delta; CREATE TABLE xor_delta(c1 int, c2 text, c3 int, c4 text, c5 int) with (storage_type=ustore);"
+gsql -d $db -p $dn1_primary_port -c "INSERT INTO xor_delta SELECT i, repeat(md5(i::text), 6), i, repeat(md5((-i)::text), 6), i FROM generate_series(1, 2000) i;"
+wait_catchup_finish
+wait_standby_same "insert"
+old_sums=`gsql -d $db -p $dn1_standby_port -t -A -c "select count(*), sum(c1), sum(c3), sum(c5) from xor_delta;"`
+start_lsn=`gsql -d $db -p $dn1_primary_port -t -A -c "select pg_current_xlog_location();"`
+
+# a standby cursor whose snapshot predates the updates below, fetched after they are replayed
+gsql -d $db -p $dn1_standby_port -t -A -q > ./results/xor_delta_cursor.log 2>&1 <<EOF &
+start transaction;
+declare c cursor for select count(*), sum(c1), sum(c3), sum(c5) from xor_delta;
+select pg_sleep(20);
+fetch all from c;
+commit;
+EOF
+cursor_pid=$!
+sleep 3
+
+gsql -d $db -p $dn1_primary_port -c "UPDATE xor_delta SET c1 = c1 + 100000, c3 = c3 + 1, c5 = c5 * 2;"
+gsql -d $db -p $dn1_primary_port -c "UPDATE xor_delta SET c1 = c1 + 100000, c5 = c5 + 1 WHERE c3 % 3 = 0;"
+wait_catchup_finish
+wait_standby_same "commit"
+
+wait $cursor_pid
+snapshot_sums=`grep '|' ./results/xor_delta_cursor.log`
+if [ "$snapshot_sums" != "$old_sums" ]; then
+    echo "old standby snapshot read '$snapshot_sums' instead of '$old_sums' $failed_keyword"
+    cat ./results/xor_delta_cursor.log
+    exit 1
+fi
+
+# the rollback rebuilds old tuples from the delta undo; its undo actions are replayed too
+committed=`table_digest $dn1_primary_port`
+gsql -d $db -p $dn1_primary_port -c "start transaction; UPDATE xor_delta SET c1 = c1 - 7, c5 = c5 - 7 WHERE c3 % 2 = 0; UPDATE xor_delta SET c3 = c3 + 7 WHERE c3 % 5 = 0; rollback;"
+wait_catchup_finish
+wait_standby_same "rollback"
+if [ "`table_digest $dn1_primary_port`" != "$committed" ]; then
+    echo "rollback did not restore the committed rows $failed_keyword"
+    exit 1
+fi
+
+end_lsn=`gsql -d $db -p $dn1_primary_port -t -A -c "select pg_current_xlog_location();"`
+if [ $(pg_xlogdump -p $primary_data_dir/pg_xlog -s $start_lsn -e $end_lsn 2>/dev/null | grep -c "delta ranges") -eq 0 ]; then
+    echo "no inplace update was logged as changed byte ranges $failed_keyword"
+    exit 1
+fi
+echo "all of success"
+}
+
+function tear_down()
+{
+gs_guc reload -D $primary_data_dir -c "undo_retention_time=0"
+gs_guc reload -D $standby_data_dir -c "hot_standby_feedback=off"
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists xor_delta;"
+}
+
+test_1
+tear_down
@@ -0,0 +1,91 @@
+#!/bin/sh
+# vacuum freezes pages it prunes anyway, and the standby replays the same tuples; indexes are vacuumed in parallel
+
+source ./standby_env.sh
+
+function tuple_digest()
+{
+gsql -d $db -p $1 -t -A -c "select count(*), md5(string_agg(ctid::text || ':' || xmin::text || ':' || a || ':' || b, ',' order by ctid)) from $2;"
+}
+
+function wait_standby_same()
+{
+for i in $(seq 1 120); do
+    if [ "$(tuple_digest $dn1_primary_port $1)" = "$(tuple_digest $dn1_standby_port $1)" ]; then
+        return 0
+    fi
+    sleep 1
+done
+echo "standby tuples of $1 differ from primary $failed_keyword"
+exit 1
+}
+
+function test_1()
+{
+check_instance
+# room for HOT updates, so pruning leaves only redirects and live tuples
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists eager_freeze; CREATE TABLE eager_freeze(a int, b int) WITH (fillfactor = 50, autovacuum_enabled = false);"
+gsql -d $db -p $dn1_primary_port -c "INSERT INTO eager_freeze SELECT i, 0 FROM generate_series(1, 20000) i;"
+gsql -d $db -p $dn1_primary_port -c "UPDATE eager_freeze SET b = 1;"
+
+verbose=`gsql -d $db -p $dn1_primary_port -c "VACUUM VERBOSE eager_freeze;" 2>&1`
+echo "$verbose" | grep "froze all row versions in [1-9][0-9]* pages that were being modified anyway"
+if [ $? -ne 0 ]; then
+    echo "vacuum did not freeze pages eagerly: $verbose $failed_keyword"
+    exit 1
+fi
+
+frozen=`gsql -d $db -p $dn1_primary_port -t -A -c "select count(*) from eager_freeze where xmin::text = '2';"`
+if [ $frozen -ne 20000 ]; then
+    echo "only $frozen of 20000 rows are frozen $failed_keyword"
+    exit 1
+fi
+
+wait_catchup_finish
+wait_standby_same eager_freeze
+echo "standby replayed the eager freeze"
+}
+
+function test_2()
+{
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists parallel_vacuum; CREATE TABLE parallel_vacuum(a int, b int) WITH (parallel_workers = 2, autovacuum_enabled = false);"
+gsql -d $db -p $dn1_primary_port -c "CREATE INDEX parallel_vacuum_a ON parallel_vacuum(a); CREATE INDEX parallel_vacuum_b ON parallel_vacuum(b); CREATE INDEX parallel_vacuum_ab ON parallel_vacuum(a, b);"
+gsql -d $db -p $dn1_primary_port -c "INSERT INTO parallel_vacuum SELECT i, i % 100 FROM generate_series(1, 200000) i;"
+gsql -d $db -p $dn1_primary_port -c "DELETE FROM parallel_vacuum WHERE a % 3 = 0;"
+
+verbose=`gsql -d $db -p $dn1_primary_port -c "VACUUM VERBOSE parallel_vacuum;" 2>&1`
+for idx in parallel_vacuum_a parallel_vacuum_b parallel_vacuum_ab; do
+    echo "$verbose" | grep "scanned index \"$idx\" to remove 66666 row versions"
+    if [ $? -ne 0 ]; then
+        echo "index $idx was not vacuumed: $verbose $failed_keyword"
+        exit 1
+    fi
+done
+
+for idx in parallel_vacuum_a parallel_vacuum_b parallel_vacuum_ab; do
+    tuples=`gsql -d $db -p $dn1_primary_port -t -A -c "select reltuples from pg_class where relname = '$idx';"`
+    if [ "$tuples" != "133334" ]; then
+        echo "index $idx has $tuples tuples after vacuum $failed_keyword"
+        exit 1
+    fi
+done
+
+count=`gsql -d $db -p $dn1_primary_port -q -t -A -c "set enable_seqscan = off; set enable_bitmapscan = off; select count(*) from parallel_vacuum where b < 100;"`
+if [ "$count" != "133334" ]; then
+    echo "index scan finds $count rows after parallel vacuum $failed_keyword"
+    exit 1
+fi
+
+wait_catchup_finish
+wait_standby_same parallel_vacuum
+echo "all of success"
+}
+
+function tear_down()
+{
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists eager_freeze; DROP TABLE if exists parallel_vacuum;"
+}
+
+test_1
+test_2
+tear_down
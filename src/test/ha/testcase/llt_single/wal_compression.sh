@@ -0,0 +1,93 @@
+#!/bin/sh
+# stream WAL to the standby with lz4 and zstd compression and check that it catches up and the counters advance
+
+source ./standby_env.sh
+
+function restart_standby_with()
+{
+gs_guc set -D $standby_data_dir -c "wal_receiver_compression=$1"
+stop_standby
+start_standby
+}
+
+function table_digest()
+{
+gsql -d $db -p $1 -t -A -c "select count(*), md5(coalesce(string_agg(t::text, ',' order by t::text), '')) from wal_compress t;"
+}
+
+function wait_standby_same()
+{
+for i in $(seq 1 120); do
+    if [ "$(table_digest $dn1_primary_port)" = "$(table_digest $dn1_standby_port)" ]; then
+        return 0
+    fi
+    sleep 1
+done
+echo "standby did not catch up with $1 compression $failed_keyword"
+exit 1
+}
+
+function receiver_stat()
+{
+gsql -d $db -p $dn1_standby_port -t -A -c "select compression, raw_bytes, compressed_bytes from pg_stat_get_wal_receiver();"
+}
+
+function sender_stat()
+{
+gsql -d $db -p $dn1_primary_port -t -A -c "select compression, raw_bytes, compressed_bytes from pg_stat_get_wal_sender_compression() where compression <> 'off';"
+}
+
+function check_counters()
+{
+# $1 algorithm, $2 counters before, $3 counters after, $4 side
+algo=`echo $3 | awk -F'|' '{print $1}'`
+raw_before=`echo $2 | awk -F'|' '{print $2}'`
+raw=`echo $3 | awk -F'|' '{print $2}'`
+sent=`echo $3 | awk -F'|' '{print $3}'`
+if [ "$algo" != "$1" ]; then
+    echo "$4 reports compression '$algo' instead of $1 $failed_keyword"
+    exit 1
+fi
+if [ ${raw:-0} -le ${raw_before:-0} -o ${sent:-0} -le 0 -o ${sent:-0} -ge ${raw:-0} ]; then
+    echo "$4 $1 counters did not advance: before $2, after $3 $failed_keyword"
+    exit 1
+fi
+echo "$4 $1 counters: $3"
+}
+
+function test_1()
+{
+check_instance
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists wal_compress; CREATE TABLE wal_compress(id int, val text);"
+
+for algo in lz4 zstd; do
+    restart_standby_with $algo
+    gsql -d $db -p $dn1_primary_port -c "INSERT INTO wal_compress SELECT i, repeat(md5(i::text), 4) FROM generate_series(1, 100000) i;"
+    wait_catchup_finish
+    wait_standby_same $algo
+    rcv_before=`receiver_stat`
+    snd_before=`sender_stat`
+    check_counters $algo "" "$rcv_before" receiver
+    check_counters $algo "" "$snd_before" sender
+
+    gsql -d $db -p $dn1_primary_port -c "UPDATE wal_compress SET val = upper(val) WHERE id % 3 = 0; DELETE FROM wal_compress WHERE id % 7 = 0;"
+    wait_standby_same $algo
+    check_counters $algo "$rcv_before" "`receiver_stat`" receiver
+    check_counters $algo "$snd_before" "`sender_stat`" sender
+done
+
+if [ $(gsql -d $db -p $dn1_primary_port -t -A -c "select count(*) from pg_stat_activity where query like 'WAL compression%';") -ne 0 ]; then
+    echo "WAL compression is still reported as activity $failed_keyword"
+    exit 1
+fi
+echo "all of success"
+}
+
+function tear_down()
+{
+restart_standby_with off
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists wal_compress;"
+}
+
+test_1
+tear_down
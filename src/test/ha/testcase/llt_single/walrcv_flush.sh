@@ -0,0 +1,84 @@
+#!/bin/sh
+# stream small commits and a bulk load to the standby and check the walreceiver flush columns
+
+source ./standby_env.sh
+
+function receiver_flush()
+{
+gsql -d $db -p $dn1_standby_port -t -A -c "select flush_count, flush_bytes, receiver_flush_location, array_length(flush_latency_hist, 1), (select sum(h) from unnest(flush_latency_hist) h), flush_latency_hist[array_upper(flush_latency_hist, 1)] from pg_stat_get_wal_receiver();"
+}
+
+function field()
+{
+echo $1 | awk -F'|' -v n=$2 '{print $n}'
+}
+
+function check_flush()
+{
+# $1 columns before, $2 columns after, $3 phase
+count=$(( $(field "$2" 1) - $(field "$1" 1) ))
+bytes=$(( $(field "$2" 2) - $(field "$1" 2) ))
+hist=$(( $(field "$2" 5) - $(field "$1" 5) ))
+slow=$(( $(field "$2" 6) - $(field "$1" 6) ))
+wal=$(gsql -d $db -p $dn1_standby_port -t -A -c "select pg_xlog_location_diff('$(field "$2" 3)', '$(field "$1" 3)')::bigint;")
+
+if [ "$(field "$2" 4)" != "12" ]; then
+    echo "$3: flush_latency_hist has $(field "$2" 4) buckets $failed_keyword"
+    exit 1
+fi
+if [ $count -le 0 -o $hist -ne $count ]; then
+    echo "$3: $count flushes but $hist histogram counts $failed_keyword"
+    exit 1
+fi
+# every received byte is fsynced once, whatever the batching
+if [ $bytes -lt $(( wal * 99 / 100 )) -o $bytes -gt $(( wal * 101 / 100 )) ]; then
+    echo "$3: flushed $bytes bytes for $wal bytes of WAL $failed_keyword"
+    exit 1
+fi
+# each batch is timed from its own oldest byte, not from when the buffer was last empty
+if [ $(( slow * 2 )) -ge $count ]; then
+    echo "$3: $slow of $count flushes took 64ms or more $failed_keyword"
+    exit 1
+fi
+echo "$3: $count flushes, $bytes bytes, $slow slow"
+}
+
+function test_1()
+{
+check_instance
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists walrcv_flush; CREATE TABLE walrcv_flush(id int, val text);"
+wait_catchup_finish
+
+# many small synchronous commits from several sessions
+before=`receiver_flush`
+for s in 1 2 3 4; do
+    seq 1 500 | sed "s/.*/INSERT INTO walrcv_flush VALUES(&, 'session $s');/" | gsql -d $db -p $dn1_primary_port -q > /dev/null &
+done
+wait
+wait_catchup_finish
+check_flush "$before" "`receiver_flush`" "small commits"
+
+# one long stream that never lets the receive buffer run empty
+before=`receiver_flush`
+gsql -d $db -p $dn1_primary_port -c "INSERT INTO walrcv_flush SELECT i, repeat(md5(i::text), 8) FROM generate_series(1, 300000) i;"
+wait_catchup_finish
+check_flush "$before" "`receiver_flush`" "bulk load"
+
+if [ $(gsql -d $db -p $dn1_standby_port -t -A -c "select count(*) from walrcv_flush;") -ne 302000 ]; then
+    echo "standby row count is wrong $failed_keyword"
+    exit 1
+fi
+if [ $(gsql -d $db -p $dn1_standby_port -t -A -c "select count(*) from local_redo_stat() where worker_info like '%walrcv_flush%';") -ne 0 ]; then
+    echo "walreceiver flushes are still reported in worker_info $failed_keyword"
+    exit 1
+fi
+echo "all of success"
+}
+
+function tear_down()
+{
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists walrcv_flush;"
+}
+
+test_1
+tear_down
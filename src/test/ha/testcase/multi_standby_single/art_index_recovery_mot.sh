@@ -0,0 +1,99 @@
+#!/bin/sh
+# ART indexes of MOT tables come back from checkpoint and redo after a restart
+
+source ./util.sh
+
+function check_art_data()
+{
+  port=$1
+  result=`gsql -d $db -p $port -m -t -A -c "select count(*), sum(k) from art_int;"`
+  if [ "$result" = "$2" ]; then
+    echo "check art_int on port $port success"
+  else
+    echo "check art_int on port $port $failed_keyword: $result"
+    exit 1
+  fi
+
+  # point get, forward and reverse range scans on the primary key, and the secondary index
+  result=`gsql -d $db -p $port -m -t -A -c "select string_agg(k::text, ',') from (select k from art_int where k = 300
+    union all (select k from art_int where k > 252 and k < 515 order by k)
+    union all (select k from art_int where k > 252 and k < 515 order by k desc)) t;"`
+  if [ "$result" = "$3" ]; then
+    echo "check art_int scans on port $port success"
+  else
+    echo "check art_int scans on port $port $failed_keyword: $result"
+    exit 1
+  fi
+
+  result=`gsql -d $db -p $port -m -t -A -c "select count(*), min(k), max(k) from art_int where v = 3;"`
+  if [ "$result" = "$4" ]; then
+    echo "check art_int secondary index on port $port success"
+  else
+    echo "check art_int secondary index on port $port $failed_keyword: $result"
+    exit 1
+  fi
+
+  result=`gsql -d $db -p $port -m -t -A -c "select count(*) from art_str where k >= 'tenant-0001/customer/000100' and k < 'tenant-0001/customer/000200';
+    select k from art_str order by k desc limit 1;
+    select k from art_str where v = 510;"`
+  if [ "$result" = "$5" ]; then
+    echo "check art_str on port $port success"
+  else
+    echo "check art_str on port $port $failed_keyword: $result"
+    exit 1
+  fi
+}
+
+function test_1()
+{
+  set_default
+  check_instance_multi_standby
+
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists art_int; DROP FOREIGN TABLE if exists art_str;
+    CREATE FOREIGN TABLE art_int (k int not null, v int not null, primary key (k) with (tree_flavor = 'art')) SERVER mot_server;
+    CREATE INDEX art_int_v ON art_int (v) with (tree_flavor = 'art');
+    CREATE FOREIGN TABLE art_str (k varchar(64) not null, v int not null, primary key (k) with (tree_flavor = 'art')) SERVER mot_server;
+    CREATE INDEX art_str_v ON art_str (v) with (tree_flavor = 'art');"
+
+  gsql -d $db -p $dn1_primary_port -c "insert into art_int values (generate_series(1,1000), generate_series(1,1000) % 10);
+    insert into art_str values ('tenant-0001/customer/' || lpad(generate_series(1,500)::text, 6, '0'), generate_series(1,500));
+    insert into art_str values ('tenant-0002/customer/' || lpad(generate_series(1,20)::text, 6, '0'), generate_series(501,520));"
+
+  # the rows above come back from the checkpoint, the changes below from redo
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+  gsql -d $db -p $dn1_primary_port -c "delete from art_int where k between 256 and 511 and k <> 300;
+    insert into art_int values (generate_series(1001,1100), generate_series(1001,1100) % 10);
+    delete from art_str where k >= 'tenant-0002' and k <> 'tenant-0002/customer/000010';"
+
+  int_scans="300,253,254,255,300,512,513,514,514,513,512,300,255,254,253"
+  str_rows="100
+tenant-0002/customer/000010
+tenant-0002/customer/000010"
+
+  wait_catchup_finish
+  check_art_data $dn1_primary_port "845|507674" $int_scans "85|3|1093" "$str_rows"
+  check_art_data $dn1_standby_port "845|507674" $int_scans "85|3|1093" "$str_rows"
+
+  kill_primary
+  start_primary
+  check_art_data $dn1_primary_port "845|507674" $int_scans "85|3|1093" "$str_rows"
+
+  # a clean restart right after a checkpoint, so that the indexes are rebuilt from it alone
+  gsql -d $db -p $dn1_primary_port -c "insert into art_int values (400, 3); checkpoint;"
+  stop_primary
+  start_primary
+  check_art_data $dn1_primary_port "846|508074" "300,253,254,255,300,400,512,513,514,514,513,512,400,300,255,254,253" "86|3|1093" "$str_rows"
+
+  wait_catchup_finish
+  check_art_data $dn1_standby_port "846|508074" "300,253,254,255,300,400,512,513,514,514,513,512,400,300,255,254,253" "86|3|1093" "$str_rows"
+}
+
+function tear_down()
+{
+  set_default
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists art_int; DROP FOREIGN TABLE if exists art_str;"
+}
+
+test_1
+tear_down
@@ -0,0 +1,107 @@
+#!/bin/sh
+# MOT checkpoint links the data files of tables unchanged since the previous checkpoint, and both
+# kinds of tables come back after a restart
+
+source ./util.sh
+
+function set_reuse()
+{
+  sed -i '/^checkpoint_reuse_unchanged_tables/d' $primary_data_dir/mot.conf
+  echo "checkpoint_reuse_unchanged_tables = $1" >> $primary_data_dir/mot.conf
+  stop_primary
+  start_primary
+}
+
+function checkpoint_files()
+{
+  # name and inode of each table data file in the current checkpoint directory
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+  cp_dir=`ls -d $primary_data_dir/chkpt_* | sort -t_ -k2 -n | tail -1`
+  for f in $cp_dir/tab_*.cp; do
+    echo "`basename $f` `stat -c %i $f`"
+  done | sort
+}
+
+function check_tables()
+{
+  result=`gsql -d $db -p $1 -m -t -A -c "select count(*), sum(k), sum(v) from mot_unchanged;"`
+  if [ "$result" != "5000|12502500|25005000" ]; then
+    echo "mot_unchanged on port $1 after $2 $failed_keyword: $result"
+    exit 1
+  fi
+  result=`gsql -d $db -p $1 -m -t -A -c "select count(*), sum(k), sum(v) from mot_changed;"`
+  if [ "$result" != "$3" ]; then
+    echo "mot_changed on port $1 after $2 $failed_keyword: $result"
+    exit 1
+  fi
+  echo "check tables on port $1 after $2 success"
+}
+
+function test_1()
+{
+  set_default
+  check_instance_multi_standby
+  set_reuse true
+
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists mot_unchanged; DROP FOREIGN TABLE if exists mot_changed;
+    CREATE FOREIGN TABLE mot_unchanged (k int not null, v int not null, pad varchar(100), primary key (k)) SERVER mot_server;
+    insert into mot_unchanged select i, i * 2, repeat('u', 100) from generate_series(1, 5000) i;"
+  unchanged_files=`checkpoint_files`
+
+  gsql -d $db -p $dn1_primary_port -c "CREATE FOREIGN TABLE mot_changed (k int not null, v int not null, pad varchar(100), primary key (k)) SERVER mot_server;
+    insert into mot_changed select i, i, repeat('c', 100) from generate_series(1, 5000) i;"
+  files_before=`checkpoint_files`
+  changed_names=`echo "$files_before" | awk '{print $1}' | grep -vxF "$(echo "$unchanged_files" | awk '{print $1}')"`
+
+  gsql -d $db -p $dn1_primary_port -c "update mot_changed set v = v + 1 where k <= 100;
+    insert into mot_changed select i, i, repeat('c', 100) from generate_series(5001, 6000) i;"
+  files_after=`checkpoint_files`
+
+  # the unchanged table keeps its files, the changed table gets new ones
+  for name in `echo "$unchanged_files" | awk '{print $1}'`; do
+    if [ "`echo "$files_before" | grep "^$name "`" != "`echo "$files_after" | grep "^$name "`" ]; then
+      echo "data file $name of the unchanged table was rewritten $failed_keyword"
+      exit 1
+    fi
+  done
+  if [ -z "$changed_names" ]; then
+    echo "no data file of the changed table in the checkpoint $failed_keyword"
+    exit 1
+  fi
+  for name in $changed_names; do
+    if [ "`echo "$files_before" | grep "^$name "`" = "`echo "$files_after" | grep "^$name "`" ]; then
+      echo "data file $name of the changed table was reused $failed_keyword"
+      exit 1
+    fi
+  done
+  echo "checkpoint reused the unchanged table only"
+
+  changed_rows="6000|18003000|18003100"
+  check_tables $dn1_primary_port "checkpoint" $changed_rows
+
+  # recovery from the checkpoint alone
+  stop_primary
+  start_primary
+  check_tables $dn1_primary_port "restart" $changed_rows
+
+  # a checkpoint that reuses both tables, then redo on top of it
+  checkpoint_files > /dev/null
+  gsql -d $db -p $dn1_primary_port -c "delete from mot_changed where k > 5500;"
+  kill_primary
+  start_primary
+  check_tables $dn1_primary_port "crash" "5500|15127750|15127850"
+
+  wait_catchup_finish
+  check_tables $dn1_standby_port "catchup" "5500|15127750|15127850"
+}
+
+function tear_down()
+{
+  set_reuse false
+  set_default
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists mot_unchanged; DROP FOREIGN TABLE if exists mot_changed;"
+}
+
+test_1
+tear_down
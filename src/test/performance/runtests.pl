@@ -64,7 +64,65 @@ $DBNAME = 'perftest';
 	'slcsimple T', '8192 random INDEX scans on SIMPLE (1 xact)',
 
 	# SELECT * FROM simple ORDER BY justint
-	'orbsimple', 'ORDER BY SIMPLE',);
+	'orbsimple', 'ORDER BY SIMPLE',
+	'crtwide.ntm', 'Create WIDE table (no timing)',
+
+	# COPY FROM of 20000 rows with 64 columns each
+	'copywidecsv', 'COPY CSV INTO WIDE',
+	'copywidetxt', 'COPY TEXT INTO WIDE',
+	'drpwide.ntm', 'Drop WIDE table (no timing)',
+
+	# large SELECTs sent to the client, small and buffer-sized rows
+	'slcmanyrows', 'SELECT 1000000 small rows',
+	'slcbigrows',  'SELECT 20000 64kB rows',
+
+	# 4096 rows of 32kB compressible text, then detoast them all, per method
+	'crttoastpglz.ntm', 'Create pglz TOAST table (no timing)',
+	'instoast',         'INSERT compressible text (pglz)',
+	'slctoast',         'Detoast compressible text (pglz)',
+	'drptoast.ntm',     'Drop TOAST table (no timing)',
+	'crttoastlz4.ntm',  'Create lz4 TOAST table (no timing)',
+	'instoast',         'INSERT compressible text (lz4)',
+	'slctoast',         'Detoast compressible text (lz4)',
+	'drptoast.ntm',     'Drop TOAST table (no timing)',
+	'crttoastzstd.ntm', 'Create zstd TOAST table (no timing)',
+	'instoast',         'INSERT compressible text (zstd)',
+	'slctoast',         'Detoast compressible text (zstd)',
+	'drptoast.ntm',     'Drop TOAST table (no timing)',
+
+	# pgbench -S at 1 to 512 sessions, bound by snapshot acquisition
+	'crtpgbench.ntm', 'Create pgbench tables (no timing)',
+	'slcsnapscale',   'Read-only pgbench scaling to 512 sessions',
+	'drppgbench.ntm', 'Drop pgbench tables (no timing)',
+
+	# pgbench -N at 64 to 512 sessions, LWLock spinning off and on
+	'crtpgbench.ntm', 'Create pgbench tables (no timing)',
+	'updlwlockscale', 'Write pgbench at 512 sessions by lwlock_max_spins',
+	'drppgbench.ntm', 'Drop pgbench tables (no timing)',
+
+	# MOT primary key on Masstree, then on ART: 1000000 random inserts,
+	# point gets at 8 sessions, forward and reverse range scans
+	'crtmotmasstree.ntm', 'Create MOT table on Masstree (no timing)',
+	'insmot',             'INSERT 1000000 random keys (Masstree)',
+	'slcmot',             'Point gets at 8 sessions (Masstree)',
+	'scnmot',             'Range scans (Masstree)',
+	'drpmot.ntm',         'Drop MOT table (no timing)',
+	'crtmotart.ntm',      'Create MOT table on ART (no timing)',
+	'insmot',             'INSERT 1000000 random keys (ART)',
+	'slcmot',             'Point gets at 8 sessions (ART)',
+	'scnmot',             'Range scans (ART)',
+	'drpmot.ntm',         'Drop MOT table (no timing)',
+
+	# ustore inplace updates of 1, 2 and all 32 columns, with the WAL and
+	# undo bytes written per row
+	'crtwideustore.ntm', 'Create WIDE ustore table (no timing)',
+	'updwideustore',     'UPDATE WIDE ustore rows',
+	'drpwideustore.ntm', 'Drop WIDE ustore table (no timing)',
+
+	# 200000 INSERTs pipelined as Bind/Execute pairs, 1000 per Sync
+	'crtpipeline.ntm', 'Create pipeline table (no timing)',
+	'inspipeline',     '200000 pipelined INSERTs (1000 per Sync)',
+	'drppipeline.ntm', 'Drop pipeline table (no timing)',);
 
 #
 # It seems that nothing below need to be changed
@@ -228,3 +228,36 @@ DROP TABLE x;
 DROP TABLE y;
 DROP FUNCTION fn_x_before();
 DROP FUNCTION fn_x_after();
+
+-- PARALLEL hands lines to bgworkers but reports errors like a serial COPY
+CREATE TABLE parallel_copy (a int, b text);
+COPY parallel_copy FROM stdin WITH (parallel 2);
+1	one
+2	two
+3	three
+\.
+SELECT * FROM parallel_copy ORDER BY a;
+COPY parallel_copy FROM stdin WITH (parallel 2);
+4	four
+five	five
+\.
+SELECT count(*) FROM parallel_copy;
+COPY parallel_copy FROM stdin WITH (parallel 0);
+COPY parallel_copy TO stdout WITH (parallel 2);
+DROP TABLE parallel_copy;
+
+-- fields longer than a scan block, with quoting and escapes past it
+CREATE TABLE wide_copy (a int, b text, c text);
+COPY wide_copy FROM stdin CSV;
+1,"xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx""yyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyy",zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz
+2,"xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
+yyyyyyyyyy",tail
+\.
+COPY wide_copy FROM stdin;
+3	xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx\tyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyy	zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz\\
+\.
+SELECT a, length(b) AS blen, length(c) AS clen, right(c, 1) AS clast,
+       b IN (repeat('x', 70) || '"' || repeat('y', 70), repeat('x', 70) || E'\n' || repeat('y', 10),
+             repeat('x', 70) || E'\t' || repeat('y', 70)) AS b_ok
+FROM wide_copy ORDER BY a;
+DROP TABLE wide_copy;
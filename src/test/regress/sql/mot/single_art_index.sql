@@ -0,0 +1,70 @@
+--
+-- MOT indexes built on the ART tree flavor
+--
+
+-- integer keys, the primary and a secondary index both on ART
+create foreign table art_int (k int not null, v int not null, primary key (k) with (tree_flavor = 'art'));
+create index art_int_v on art_int (v) with (tree_flavor = 'art');
+select relname, reloptions from pg_class where relname in ('art_int_pkey', 'art_int_v') order by relname;
+
+insert into art_int values (generate_series(1,1000), generate_series(1,1000) % 10);
+
+select k, v from art_int where k = 500;
+select k, v from art_int where k = 1001;
+select count(*), min(k), max(k) from art_int where v = 3;
+select count(*), min(k), max(k) from art_int where v between 3 and 4;
+
+-- forward and reverse range scans
+select k from art_int where k >= 250 and k < 256 order by k;
+select k from art_int where k > 250 and k <= 256 order by k desc;
+select k from art_int where k >= 995 order by k desc;
+select k from art_int where k < 4 order by k;
+
+-- keys 256 to 511 hang off one inner node, delete them down to a single child
+delete from art_int where k between 256 and 511 and k <> 300;
+select count(*) from art_int;
+select k, v from art_int where k = 300;
+select k, v from art_int where k = 301;
+select k from art_int where k > 252 and k < 515 order by k;
+select k from art_int where k > 252 and k < 515 order by k desc;
+select count(*), min(k), max(k) from art_int where v = 0 and k between 250 and 520;
+
+-- and then to none, and grow it again
+delete from art_int where k = 300;
+select count(*) from art_int where k between 256 and 511;
+insert into art_int values (400, 0);
+select k from art_int where k > 254 and k < 513 order by k desc;
+
+-- long keys that share a prefix of more than 8 bytes
+create foreign table art_str (k varchar(64) not null, v int not null, primary key (k) with (tree_flavor = 'art'));
+create index art_str_v on art_str (v) with (tree_flavor = 'art');
+insert into art_str values ('tenant-0001/customer/' || lpad(generate_series(1,500)::text, 6, '0'), generate_series(1,500));
+insert into art_str values ('tenant-0002/customer/' || lpad(generate_series(1,20)::text, 6, '0'), generate_series(501,520));
+insert into art_str values ('tenant-0001/customer', 0);
+
+select k, v from art_str where k = 'tenant-0001/customer/000250';
+select k, v from art_str where k = 'tenant-0001/customer';
+select k, v from art_str where k = 'tenant-0001/customer/00025';
+select k from art_str where v = 510;
+select k from art_str where k >= 'tenant-0001/customer/000100' and k < 'tenant-0001/customer/000105' order by k;
+select k from art_str where k > 'tenant-0001/customer/000495' and k < 'tenant-0002' order by k desc;
+select k from art_str where k < 'tenant-0001/customer/000003' order by k;
+select count(*) from art_str where k >= 'tenant-0002';
+
+-- leave a single key under the second prefix
+delete from art_str where k >= 'tenant-0002' and k <> 'tenant-0002/customer/000007';
+select k, v from art_str where k >= 'tenant-0002' order by k;
+select k from art_str order by k desc limit 3;
+select k, v from art_str where k = 'tenant-0002/customer/000008';
+update art_str set v = 1000 where k = 'tenant-0002/customer/000007';
+select k from art_str where v = 1000;
+
+-- the option is checked, and cannot be changed afterwards
+create index art_int_bad on art_int (v, k) with (tree_flavor = 'btree');
+alter index art_int_v set (tree_flavor = 'masstree');
+create table art_heap (a int);
+create index art_heap_a on art_heap (a) with (tree_flavor = 'art');
+drop table art_heap;
+
+drop foreign table art_int;
+drop foreign table art_str;
@@ -87,6 +87,19 @@ commit;
 select * from t4 order by c1 limit 10;
 select /*+ indexonlyscan(t4) */ sum(c1), count(*) from t4 union select /*+ tablescan(t4) */ sum(c1),count(*) from t4;
 
+-- Test inplace updates that change columns far apart in a wide row
+drop table if exists t7;
+create table t7(c1 int, c2 text, c3 int, c4 text, c5 int) with (storage_type=USTORE);
+insert into t7 values(generate_series(1,5,1), repeat('a', 100), 100, repeat('b', 100), 1000);
+start transaction;
+update t7 set c1 = c1 + 10, c5 = c5 + 1 where c1 < 3;
+update t7 set c3 = c3 + 1, c5 = c5 + 1 where c1 > 10;
+select c1, length(c2), c3, length(c4), c5 from t7 order by c1;
+rollback;
+select c1, length(c2), c3, length(c4), c5 from t7 order by c1;
+update t7 set c1 = c1 + 10, c3 = c3 + 1, c5 = c5 + 1 where c1 < 3;
+select c1, length(c2), c3, length(c4), c5 from t7 order by c1;
+
 -- Test updates involving mixed table types
 drop table if exists t5;
 drop table if exists t6;
@@ -101,4 +114,5 @@ drop table t1;
 drop table t3;
 drop table t4;
 drop table t5;
-drop table t6;
\ No newline at end of file
+drop table t6;
+drop table t7;
\ No newline at end of file
@@ -0,0 +1,151 @@
+#!/bin/sh
+
+source $1/env_utils.sh $1 $2
+
+case_db="parallel_apply_db"
+
+function check_log() {
+	content=$(tail -n +$2 $1)
+	if [[ "$content" =~ "$3" ]]; then
+		echo "check $4 success"
+	else
+		echo "$failed_keyword when check $4"
+		exit 1
+	fi
+}
+
+function check_same_data() {
+	pub_data=$(exec_sql $case_db $pub_node1_port "$1")
+	sub_data=$(exec_sql $case_db $sub_node1_port "$1")
+	if [ "$pub_data" = "$sub_data" ]; then
+		echo "check $2 success"
+	else
+		echo "$failed_keyword when check $2"
+		exit 1
+	fi
+}
+
+function check_sub_value() {
+	result=$(exec_sql $case_db $sub_node1_port "$1")
+	if [ "$result" = "$2" ]; then
+		echo "check $3 success"
+	else
+		echo "$failed_keyword when check $3, got $result"
+		exit 1
+	fi
+}
+
+function test_1() {
+	echo "create database and tables."
+	exec_sql $db $pub_node1_port "CREATE DATABASE $case_db"
+	exec_sql $db $sub_node1_port "CREATE DATABASE $case_db"
+
+	gs_guc reload -D $data_dir/sub_datanode1 -c "max_parallel_apply_workers_per_subscription = 2"
+
+	ddl="CREATE TABLE tab_1 (a int primary key, b int);
+	CREATE TABLE tab_2 (a int primary key, b text)"
+	exec_sql $case_db $pub_node1_port "$ddl"
+	exec_sql $case_db $sub_node1_port "$ddl"
+
+	logfile=$(get_log_file "sub_datanode1")
+	location=$(awk 'END{print NR}' $logfile)
+
+	# Setup logical replication, without table sync workers so that the
+	# parallel apply workers fit into max_logical_replication_workers
+	echo "create publication and subscription."
+	publisher_connstr="port=$pub_node1_port host=$g_local_ip dbname=$case_db user=$username password=$passwd"
+	exec_sql $case_db $pub_node1_port "CREATE PUBLICATION tap_pub FOR ALL TABLES"
+	exec_sql $case_db $sub_node1_port "CREATE SUBSCRIPTION tap_sub CONNECTION '$publisher_connstr' PUBLICATION tap_pub WITH (copy_data = false)"
+
+	poll_query_until $case_db $sub_node1_port "SELECT count(*) FROM pg_stat_subscription WHERE subname = 'tap_sub' AND pid IS NOT NULL" "3" "Timed out while waiting for parallel apply workers to start"
+	check_log $logfile $location "subscription \"tap_sub\" started 2 parallel apply workers" "parallel apply workers are started"
+
+	# independent transactions, and transactions that depend on an earlier
+	# one through the key they touch
+	for i in $(seq 1 50); do
+		exec_sql $case_db $pub_node1_port "INSERT INTO tab_1 VALUES ($i, 0)"
+		exec_sql $case_db $pub_node1_port "INSERT INTO tab_2 VALUES ($i, 'v$i')"
+		exec_sql $case_db $pub_node1_port "UPDATE tab_1 SET b = b + $i WHERE a <= $i"
+	done
+	exec_sql $case_db $pub_node1_port "DELETE FROM tab_2 WHERE a % 3 = 0"
+	exec_sql $case_db $pub_node1_port "UPDATE tab_2 SET a = a + 1000 WHERE a % 3 = 1"
+
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+
+	check_same_data "SELECT a, b FROM tab_1 ORDER BY a" "tab_1 is applied in parallel"
+	check_same_data "SELECT a, b FROM tab_2 ORDER BY a" "tab_2 is applied in parallel"
+}
+
+function test_2() {
+	logfile=$(get_log_file "sub_datanode1")
+	location=$(awk 'END{print NR}' $logfile)
+
+	# a local row makes a parallel apply worker fail in commit order, which
+	# takes down the whole group
+	exec_sql $case_db $sub_node1_port "INSERT INTO tab_1 VALUES (100, -1)"
+	for i in $(seq 51 100); do
+		exec_sql $case_db $pub_node1_port "INSERT INTO tab_1 VALUES ($i, $i)"
+	done
+
+	poll_query_until $case_db $sub_node1_port "SELECT count(*) FROM tab_1 WHERE a BETWEEN 51 AND 99" "49" "Timed out while waiting for transactions before the failure to be applied"
+	check_log $logfile $location "duplicate key value violates unique constraint" "parallel apply worker fails"
+	check_log $logfile $location "parallel apply worker for subscription \"tap_sub\" exited unexpectedly" "leader notices failed worker"
+
+	location=$(awk 'END{print NR}' $logfile)
+
+	# once the conflict is gone, the restarted group applies the rest
+	exec_sql $case_db $sub_node1_port "DELETE FROM tab_1 WHERE a = 100"
+	exec_sql $case_db $pub_node1_port "INSERT INTO tab_2 SELECT i, 'w' || i FROM generate_series(2001, 2010) i"
+
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+
+	check_same_data "SELECT a, b FROM tab_1 ORDER BY a" "tab_1 is applied after worker failure"
+	check_same_data "SELECT a, b FROM tab_2 ORDER BY a" "tab_2 is applied after worker failure"
+	check_log $logfile $location "subscription \"tap_sub\" started 2 parallel apply workers" "parallel apply workers are restarted"
+}
+
+function test_3() {
+	# a unique index that only exists on the subscriber is a dependency the
+	# leader can't see, so a transaction applied out of order hits it and
+	# has to be retried
+	exec_sql $case_db $sub_node1_port "CREATE UNIQUE INDEX tab_2_b_idx ON tab_2 (b)"
+
+	exec_sql $case_db $sub_node1_port "ALTER SUBSCRIPTION tap_sub SET (enabled = false)"
+	poll_query_until $case_db $sub_node1_port "SELECT count(*) FROM pg_stat_subscription WHERE subname = 'tap_sub' AND pid IS NOT NULL" "0" "Timed out while waiting for apply workers to stop"
+
+	for i in $(seq 1 50); do
+		exec_sql $case_db $pub_node1_port "INSERT INTO tab_2 VALUES (3000 + $i, 'u$i')"
+		exec_sql $case_db $pub_node1_port "DELETE FROM tab_2 WHERE a = 3000 + $i"
+		exec_sql $case_db $pub_node1_port "INSERT INTO tab_2 VALUES (4000 + $i, 'u$i')"
+	done
+
+	# the whole backlog arrives at once when the subscription comes back
+	exec_sql $case_db $sub_node1_port "ALTER SUBSCRIPTION tap_sub SET (enabled = true)"
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+
+	check_same_data "SELECT a, b FROM tab_2 ORDER BY a" "tab_2 is applied with hidden dependencies"
+
+	subid="(SELECT oid FROM pg_subscription WHERE subname = 'tap_sub')"
+	check_sub_value "SELECT count(*) FROM pg_stat_get_parallel_apply($subid)" "2" "parallel apply workers are reported"
+	check_sub_value "SELECT sum(transactions) >= 150 FROM pg_stat_get_parallel_apply($subid)" "t" "applied transactions are counted"
+	check_sub_value "SELECT count(*) FROM pg_stat_get_parallel_apply($subid) WHERE transactions > 0 AND apply_lag IS NULL" "0" "apply lag is reported"
+	check_sub_value "SELECT sum(retries) > 0 FROM pg_stat_get_parallel_apply($subid)" "t" "retries are counted"
+	check_sub_value "SELECT count(*) FROM pg_stat_get_parallel_apply($subid) WHERE dependency_waits = 0 AND dependency_wait_time > 0" "0" "dependency waits are counted"
+}
+
+function tear_down() {
+	exec_sql $case_db $sub_node1_port "DROP SUBSCRIPTION IF EXISTS tap_sub"
+	exec_sql $case_db $pub_node1_port "DROP PUBLICATION IF EXISTS tap_pub"
+
+	exec_sql $db $sub_node1_port "DROP DATABASE $case_db"
+	exec_sql $db $pub_node1_port "DROP DATABASE $case_db"
+
+	gs_guc reload -D $data_dir/sub_datanode1 -c "max_parallel_apply_workers_per_subscription = 0"
+
+	echo "tear down"
+}
+
+test_1
+test_2
+test_3
+tear_down
@@ -0,0 +1,124 @@
+#!/bin/sh
+
+source $1/env_utils.sh $1 $2
+
+case_db="parallel_sync_db"
+
+function check_log() {
+	content=$(tail -n +$2 $1)
+	if [[ "$content" =~ "$3" ]]; then
+		echo "check $4 success"
+	else
+		echo "$failed_keyword when check $4"
+		exit 1
+	fi
+}
+
+function test_1() {
+	echo "create database and tables."
+	exec_sql $db $pub_node1_port "CREATE DATABASE $case_db"
+	exec_sql $db $sub_node1_port "CREATE DATABASE $case_db"
+
+	# copy every table with two parallel sync workers, however small, one
+	# table at a time so that they fit into max_logical_replication_workers
+	gs_guc reload -D $data_dir/sub_datanode1 -c "max_sync_workers_per_subscription = 1"
+	gs_guc reload -D $data_dir/sub_datanode1 -c "max_parallel_sync_workers_per_table = 2"
+	gs_guc reload -D $data_dir/sub_datanode1 -c "min_parallel_sync_table_size = 0"
+
+	exec_sql $case_db $pub_node1_port "CREATE TABLE tab_key (a int primary key, b text)"
+	exec_sql $case_db $pub_node1_port "INSERT INTO tab_key SELECT i, md5(i::text) FROM generate_series(1, 100000) i"
+	exec_sql $case_db $pub_node1_port "CREATE TABLE tab_part (a int primary key, b text) PARTITION BY RANGE (a)
+		(PARTITION p1 VALUES LESS THAN (30000), PARTITION p2 VALUES LESS THAN (60000),
+		PARTITION p3 VALUES LESS THAN (MAXVALUE))"
+	exec_sql $case_db $pub_node1_port "INSERT INTO tab_part SELECT i, md5(i::text) FROM generate_series(1, 100000) i"
+
+	exec_sql $case_db $sub_node1_port "CREATE TABLE tab_key (a int primary key, b text)"
+	exec_sql $case_db $sub_node1_port "CREATE TABLE tab_part (a int primary key, b text)"
+
+	logfile=$(get_log_file "sub_datanode1")
+	location=$(awk 'END{print NR}' $logfile)
+
+	# Setup logical replication
+	echo "create publication and subscription."
+	publisher_connstr="port=$pub_node1_port host=$g_local_ip dbname=$case_db user=$username password=$passwd"
+	exec_sql $case_db $pub_node1_port "CREATE PUBLICATION tap_pub FOR ALL TABLES"
+	exec_sql $case_db $sub_node1_port "CREATE SUBSCRIPTION tap_sub CONNECTION '$publisher_connstr' PUBLICATION tap_pub"
+
+	wait_for_subscription_sync $case_db $sub_node1_port
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT count(*), count(DISTINCT a), sum(a) FROM tab_key")" = "100000|100000|5000050000" ]; then
+		echo "check table copied in key ranges success"
+	else
+		echo "$failed_keyword when check table copied in key ranges"
+		exit 1
+	fi
+	check_log $logfile $location "table \"tab_key\" copies 3 key ranges with 2 parallel sync workers" "tab_key is split by key"
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT count(*), count(DISTINCT a), sum(a) FROM tab_part")" = "100000|100000|5000050000" ]; then
+		echo "check table copied by partition success"
+	else
+		echo "$failed_keyword when check table copied by partition"
+		exit 1
+	fi
+	check_log $logfile $location "table \"tab_part\" copies 3 partitions with 2 parallel sync workers" "tab_part is split by partition"
+
+	# changes made after the snapshot are replicated on top of the copy
+	exec_sql $case_db $pub_node1_port "DELETE FROM tab_key WHERE a > 99000"
+	exec_sql $case_db $pub_node1_port "INSERT INTO tab_part VALUES (100001, 'new')"
+
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT (SELECT count(*) FROM tab_key), (SELECT count(*) FROM tab_part)")" = "99000|100001" ]; then
+		echo "check changes after parallel copy are replicated success"
+	else
+		echo "$failed_keyword when check changes after parallel copy are replicated"
+		exit 1
+	fi
+}
+
+function test_2() {
+	# one share of the copy fails, after the others have been committed
+	exec_sql $case_db $pub_node1_port "CREATE TABLE tab_fail (a int primary key, b text)"
+	exec_sql $case_db $pub_node1_port "INSERT INTO tab_fail SELECT i, md5(i::text) FROM generate_series(1, 100000) i"
+	exec_sql $case_db $sub_node1_port "CREATE TABLE tab_fail (a int primary key, b text, CONSTRAINT no_90000 CHECK (a <> 90000))"
+
+	logfile=$(get_log_file "sub_datanode1")
+	location=$(awk 'END{print NR}' $logfile)
+
+	exec_sql $case_db $sub_node1_port "ALTER SUBSCRIPTION tap_sub REFRESH PUBLICATION"
+
+	poll_query_until $case_db $sub_node1_port "SELECT srsubstate FROM pg_subscription_rel WHERE srrelid = 'tab_fail'::regclass" "d" "Timed out while waiting for subscriber to start sync"
+	poll_query_until $case_db $sub_node1_port "SELECT count(*) > 0 FROM tab_fail" "t" "Timed out while waiting for a share of the copy to be committed"
+	check_log $logfile $location "violates check constraint \"no_90000\"" "parallel copy fails"
+
+	# the sync worker restarts in DATASYNC and copies the table again
+	exec_sql $case_db $sub_node1_port "ALTER TABLE tab_fail DROP CONSTRAINT no_90000"
+
+	wait_for_subscription_sync $case_db $sub_node1_port
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT count(*), count(DISTINCT a), sum(a) FROM tab_fail")" = "100000|100000|5000050000" ]; then
+		echo "check table copied again after failure success"
+	else
+		echo "$failed_keyword when check table copied again after failure"
+		exit 1
+	fi
+	check_log $logfile $location "truncates partially copied table" "partial copy is thrown away"
+}
+
+function tear_down() {
+	exec_sql $case_db $sub_node1_port "DROP SUBSCRIPTION IF EXISTS tap_sub"
+	exec_sql $case_db $pub_node1_port "DROP PUBLICATION IF EXISTS tap_pub"
+
+	exec_sql $db $sub_node1_port "DROP DATABASE $case_db"
+	exec_sql $db $pub_node1_port "DROP DATABASE $case_db"
+
+	gs_guc reload -D $data_dir/sub_datanode1 -c "max_sync_workers_per_subscription = 2"
+	gs_guc reload -D $data_dir/sub_datanode1 -c "max_parallel_sync_workers_per_table = 0"
+	gs_guc reload -D $data_dir/sub_datanode1 -c "min_parallel_sync_table_size = 1GB"
+
+	echo "tear down"
+}
+
+test_1
+test_2
+tear_down
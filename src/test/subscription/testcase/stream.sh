@@ -0,0 +1,129 @@
+#!/bin/sh
+
+source $1/env_utils.sh $1 $2
+
+case_db="stream_db"
+
+function check_streamed() {
+	content=$(tail -n +$2 $1)
+	if [[ "$content" =~ "spooled messages of streamed transaction" ]]; then
+		echo "check $3 was streamed success"
+	else
+		echo "$failed_keyword when check $3 was streamed"
+		exit 1
+	fi
+}
+
+function test_1() {
+	echo "create database and tables."
+	exec_sql $db $pub_node1_port "CREATE DATABASE $case_db"
+	exec_sql $db $sub_node1_port "CREATE DATABASE $case_db"
+
+	# the apply worker reports each streamed transaction it applies at DEBUG1
+	restart_guc "sub_datanode1" "log_min_messages = debug1"
+
+	ddl="CREATE TABLE test_tab (a int primary key, b varchar);
+	CREATE TABLE test_tab2 (a int primary key, b varchar)"
+	exec_sql $case_db $pub_node1_port "$ddl"
+	exec_sql $case_db $sub_node1_port "$ddl"
+
+	# Setup logical replication
+	echo "create publication and subscription."
+	publisher_connstr="port=$pub_node1_port host=$g_local_ip dbname=$case_db user=$username password=$passwd"
+	exec_sql $case_db $pub_node1_port "CREATE PUBLICATION tap_pub FOR ALL TABLES"
+	exec_sql $case_db $sub_node1_port "CREATE SUBSCRIPTION tap_sub CONNECTION '$publisher_connstr' PUBLICATION tap_pub WITH (streaming = true)"
+
+	wait_for_subscription_sync $case_db $sub_node1_port
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT substream FROM pg_subscription WHERE subname = 'tap_sub'")" = "t" ]; then
+		echo "check streaming option is set success"
+	else
+		echo "$failed_keyword when check streaming option is set"
+		exit 1
+	fi
+
+	logfile=$(get_log_file "sub_datanode1")
+	location=$(awk 'END{print NR}' $logfile)
+
+	# more changes than max_changes_in_memory, so the transaction is streamed
+	# before it commits, together with the schema of test_tab
+	exec_sql $case_db $pub_node1_port "INSERT INTO test_tab SELECT i, md5(i::text) FROM generate_series(1, 5000) i"
+
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT count(*), count(DISTINCT b) FROM test_tab")" = "5000|5000" ]; then
+		echo "check streamed transaction is replicated success"
+	else
+		echo "$failed_keyword when check streamed transaction is replicated"
+		exit 1
+	fi
+	check_streamed $logfile $location "large transaction"
+
+	location=$(awk 'END{print NR}' $logfile)
+
+	# a rolled back subtransaction is cut out of the spool, also when it was
+	# streamed already
+	exec_sql $case_db $pub_node1_port "BEGIN;
+	INSERT INTO test_tab SELECT i, md5(i::text) FROM generate_series(5001, 8000) i;
+	SAVEPOINT s1;
+	INSERT INTO test_tab SELECT i, md5(i::text) FROM generate_series(8001, 11000) i;
+	SAVEPOINT s2;
+	INSERT INTO test_tab SELECT i, md5(i::text) FROM generate_series(11001, 12000) i;
+	ROLLBACK TO s1;
+	INSERT INTO test_tab SELECT i, md5(i::text) FROM generate_series(12001, 14000) i;
+	COMMIT;"
+
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT count(*), sum(CASE WHEN a BETWEEN 8001 AND 12000 THEN 1 ELSE 0 END), max(a) FROM test_tab")" = "10000|0|14000" ]; then
+		echo "check subtransaction abort in streamed transaction success"
+	else
+		echo "$failed_keyword when check subtransaction abort in streamed transaction"
+		exit 1
+	fi
+	check_streamed $logfile $location "transaction with aborted subtransaction"
+
+	# a streamed transaction that aborts takes the schema of test_tab2 with
+	# it, so the publisher has to send it again for the next change
+	exec_sql $case_db $pub_node1_port "BEGIN;
+	INSERT INTO test_tab2 SELECT i, md5(i::text) FROM generate_series(1, 5000) i;
+	ROLLBACK;"
+	exec_sql $case_db $pub_node1_port "INSERT INTO test_tab2 VALUES (1, 'one')"
+
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT a, b FROM test_tab2")" = "1|one" ]; then
+		echo "check schema is sent again after streamed abort success"
+	else
+		echo "$failed_keyword when check schema is sent again after streamed abort"
+		exit 1
+	fi
+
+	# without the option, large transactions are only sent at commit
+	exec_sql $case_db $sub_node1_port "ALTER SUBSCRIPTION tap_sub SET (streaming = false)"
+	exec_sql $case_db $pub_node1_port "INSERT INTO test_tab2 SELECT i, md5(i::text) FROM generate_series(2, 5001) i"
+
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT count(*) FROM test_tab2")" = "5001" ]; then
+		echo "check large transaction is replicated without streaming success"
+	else
+		echo "$failed_keyword when check large transaction is replicated without streaming"
+		exit 1
+	fi
+}
+
+function tear_down() {
+	exec_sql $case_db $sub_node1_port "DROP SUBSCRIPTION IF EXISTS tap_sub"
+	exec_sql $case_db $pub_node1_port "DROP PUBLICATION IF EXISTS tap_pub"
+
+	exec_sql $db $sub_node1_port "DROP DATABASE $case_db"
+	exec_sql $db $pub_node1_port "DROP DATABASE $case_db"
+
+	restart_guc "sub_datanode1" "log_min_messages = warning"
+
+	echo "tear down"
+}
+
+test_1
+tear_down
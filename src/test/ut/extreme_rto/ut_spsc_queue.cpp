@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ut_spsc_queue.cpp
+ *       Stress the spin-then-sleep wait of the extreme RTO SPSC queue: a
+ *       producer alternates bursts that fill the queue with idle gaps that
+ *       put the consumer to sleep, and the consumer must see every element,
+ *       in order, and be woken by the producer rather than by its timeout.
+ *
+ * IDENTIFICATION
+ *        src/test/ut/extreme_rto/ut_spsc_queue.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "ut_spsc_queue.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <thread>
+
+#include "postgres.h"
+#include "knl/knl_variable.h"
+#include "utils/memutils.h"
+#include "access/extreme_rto/spsc_blocking_queue.h"
+
+using namespace extreme_rto;
+
+GUNIT_TEST_REGISTRATION(ut_spsc_queue, TestBurstsAndIdle)
+GUNIT_TEST_REGISTRATION(ut_spsc_queue, TestWakeup)
+
+static const uintptr_t QUEUE_END = UINTPTR_MAX;
+
+void ut_spsc_queue::SetUp()
+{
+    MemoryContextInit();
+    knl_thread_init(PAGEREDO);
+}
+
+void ut_spsc_queue::TearDown() {}
+
+/*
+ * Take elements 1, 2, ... until QUEUE_END with each of the ways the redo
+ * threads consume a queue, in turn. Returns the number of elements taken out
+ * of order, 0 when all is well.
+ */
+static uint64 ConsumeInOrder(SPSCBlockingQueue *queue, uint64 *taken)
+{
+    uint64 expected = 1;
+    uint64 misordered = 0;
+
+    for (uint32 round = 0;; round++) {
+        void **elements = NULL;
+        uint32 num = 0;
+        uintptr_t value;
+
+        switch (round % 3) {
+            case 0:
+                value = (uintptr_t)SPSCBlockingQueueTake(queue);
+                elements = (void **)&value;
+                num = 1;
+                break;
+            case 1:
+                value = (uintptr_t)SPSCBlockingQueueTop(queue);
+                elements = (void **)&value;
+                num = 1;
+                break;
+            default:
+                (void)SPSCBlockingQueueGetAll(queue, &elements, &num);
+                break;
+        }
+
+        bool end = false;
+        for (uint32 i = 0; i < num; i++) {
+            if ((uintptr_t)elements[i] == QUEUE_END) {
+                end = true;
+                break;
+            }
+            if ((uintptr_t)elements[i] != expected) {
+                misordered++;
+            }
+            expected = (uintptr_t)elements[i] + 1;
+        }
+
+        if (round % 3 == 1) {
+            SPSCBlockingQueuePop(queue);
+        } else if (round % 3 == 2) {
+            SPSCBlockingQueuePopN(queue, num);
+        }
+        if (end) {
+            break;
+        }
+    }
+    *taken = expected - 1;
+    return misordered;
+}
+
+static uint64 HistTotal(const uint64 *hist)
+{
+    uint64 total = 0;
+    for (uint32 i = 0; i < SPSC_QUEUE_HIST_BUCKETS; i++) {
+        total += hist[i];
+    }
+    return total;
+}
+
+/* TestBurstsAndIdle */
+void ut_spsc_queue::TestBurstsAndIdle()
+{
+    const uint32 capacity = 256;
+    const uint32 rounds = 300;
+    const uint32 maxBurst = 600;
+    SPSCBlockingQueue *queue = SPSCBlockingQueueCreate(capacity);
+    void **batch = (void **)palloc(sizeof(void *) * maxBurst);
+    uint64 taken = 0;
+    uint64 misordered = 0;
+    uint64 puts = 0;
+    uintptr_t next = 1;
+
+    srandom(20201);
+    std::thread consumer([&]() { misordered = ConsumeInOrder(queue, &taken); });
+
+    for (uint32 round = 0; round < rounds; round++) {
+        uint32 burst = (uint32)(random() % maxBurst) + 1;
+
+        if (round % 2 == 0) {
+            for (uint32 i = 0; i < burst; i++) {
+                (void)SPSCBlockingQueuePut(queue, (void *)next++);
+            }
+            puts += burst;
+        } else {
+            for (uint32 i = 0; i < burst; i++) {
+                batch[i] = (void *)next++;
+            }
+            SPSCBlockingQueuePutN(queue, batch, burst);
+            /* PutN publishes at most capacity - 1 elements at a time */
+            puts += (burst + capacity - 2) / (capacity - 1);
+        }
+        /* long enough gaps for the consumer to give up spinning and sleep */
+        if (round % 4 == 3) {
+            (void)usleep((useconds_t)(random() % 3000));
+        }
+    }
+    (void)SPSCBlockingQueuePut(queue, (void *)QUEUE_END);
+    puts++;
+    consumer.join();
+
+    uint64 depthHist[SPSC_QUEUE_HIST_BUCKETS] = {0};
+    uint64 idleWaitHist[SPSC_QUEUE_HIST_BUCKETS] = {0};
+    uint64 fullWaitHist[SPSC_QUEUE_HIST_BUCKETS] = {0};
+    SPSCGetQueueHistogram(queue, depthHist, idleWaitHist, fullWaitHist);
+
+    ASSERT_EQ(0UL, misordered);
+    ASSERT_EQ((uint64)(next - 1), taken);
+    ASSERT_TRUE(SPSCBlockingQueueIsEmpty(queue));
+    ASSERT_EQ(puts, HistTotal(depthHist));
+    /* the consumer slept in the gaps, and the producer waited for room in the bursts */
+    ASSERT_GT(HistTotal(idleWaitHist), 0UL);
+    ASSERT_GT(HistTotal(fullWaitHist), 0UL);
+    ASSERT_GE(queue->spinLimit, 0x3FU);
+    ASSERT_LE(queue->spinLimit, 0xFFFFU);
+
+    pfree(batch);
+    SPSCBlockingQueueDestroy(queue);
+}
+
+/* TestWakeup */
+void ut_spsc_queue::TestWakeup()
+{
+    const uint32 iterations = 500;
+    const uint32 longWaitBucket = 4; /* 128us and up, the sleep timeout is 200us or 1ms */
+    SPSCBlockingQueue *queue = SPSCBlockingQueueCreate(16);
+    uint64 taken = 0;
+    uint64 misordered = 0;
+
+    std::thread consumer([&]() { misordered = ConsumeInOrder(queue, &taken); });
+
+    for (uintptr_t i = 1; i <= iterations; i++) {
+        /* put each element while the consumer is asleep on the empty queue */
+        while (pg_atomic_read_u32(&queue->consumerWaiting) == 0) {
+            (void)usleep(10);
+        }
+        (void)usleep(20);
+        (void)SPSCBlockingQueuePut(queue, (void *)i);
+    }
+    (void)SPSCBlockingQueuePut(queue, (void *)QUEUE_END);
+    consumer.join();
+
+    uint64 depthHist[SPSC_QUEUE_HIST_BUCKETS] = {0};
+    uint64 idleWaitHist[SPSC_QUEUE_HIST_BUCKETS] = {0};
+    uint64 fullWaitHist[SPSC_QUEUE_HIST_BUCKETS] = {0};
+    SPSCGetQueueHistogram(queue, depthHist, idleWaitHist, fullWaitHist);
+    uint64 longWaits = 0;
+    for (uint32 i = longWaitBucket; i < SPSC_QUEUE_HIST_BUCKETS; i++) {
+        longWaits += idleWaitHist[i];
+    }
+
+    ASSERT_EQ(0UL, misordered);
+    ASSERT_EQ((uint64)iterations, taken);
+    ASSERT_GE(HistTotal(idleWaitHist), (uint64)iterations);
+    /* a sleep ended by the producer's post is short; a lost wake-up runs into the timeout */
+    ASSERT_LT(longWaits, (uint64)iterations / 10);
+    /* after sleeping on every element, the consumer spins as little as it may */
+    ASSERT_EQ(0x3FU, queue->spinLimit);
+
+    SPSCBlockingQueueDestroy(queue);
+}
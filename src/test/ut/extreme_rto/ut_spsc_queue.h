@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * IDENTIFICATION
+ *        src/test/ut/extreme_rto/ut_spsc_queue.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef UT_SPSC_QUEUE_H
+#define UT_SPSC_QUEUE_H
+
+#include "gunit_test.h"
+
+class ut_spsc_queue : public testing::Test {
+    GUNIT_TEST_SUITE(ut_spsc_queue);
+
+   public:
+    virtual void SetUp();
+
+    virtual void TearDown();
+
+   public:
+    void TestBurstsAndIdle();
+    void TestWakeup();
+};
+
+#endif